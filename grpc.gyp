@@ -215,6 +215,8 @@
         'test/core/end2end/tests/filter_latency.cc',
         'test/core/end2end/tests/filter_status_code.cc',
         'test/core/end2end/tests/graceful_server_shutdown.cc',
+        'test/core/end2end/tests/hedging_server_pushback.cc',
+        'test/core/end2end/tests/hedging_throttled.cc',
         'test/core/end2end/tests/high_initial_seqno.cc',
         'test/core/end2end/tests/hpack_size.cc',
         'test/core/end2end/tests/idempotent_request.cc',
@@ -329,6 +331,8 @@
         'test/core/end2end/tests/filter_latency.cc',
         'test/core/end2end/tests/filter_status_code.cc',
         'test/core/end2end/tests/graceful_server_shutdown.cc',
+        'test/core/end2end/tests/hedging_server_pushback.cc',
+        'test/core/end2end/tests/hedging_throttled.cc',
         'test/core/end2end/tests/high_initial_seqno.cc',
         'test/core/end2end/tests/hpack_size.cc',
         'test/core/end2end/tests/idempotent_request.cc',
@@ -461,6 +465,7 @@
         'src/core/lib/gprpp/global_config_env.cc',
         'src/core/lib/gprpp/host_port.cc',
         'src/core/lib/gprpp/mpscq.cc',
+        'src/core/lib/gprpp/rcu_ptr.cc',
         'src/core/lib/gprpp/stat_posix.cc',
         'src/core/lib/gprpp/stat_windows.cc',
         'src/core/lib/gprpp/status_helper.cc',
@@ -509,11 +514,15 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_channel_secure.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+        'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
+        'src/core/ext/filters/client_channel/lb_policy/pick_random.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
         'src/core/ext/filters/client_channel/lb_policy/xds/xds_cluster_impl.cc',
@@ -589,6 +598,7 @@
         'src/core/ext/transport/chttp2/transport/hpack_parser_table.cc',
         'src/core/ext/transport/chttp2/transport/hpack_utils.cc',
         'src/core/ext/transport/chttp2/transport/http2_settings.cc',
+        'src/core/ext/transport/chttp2/transport/huffman_decoder.cc',
         'src/core/ext/transport/chttp2/transport/huffsyms.cc',
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
@@ -689,6 +699,7 @@
         'src/core/ext/upb-generated/xds/core/v3/resource_locator.upb.c',
         'src/core/ext/upb-generated/xds/core/v3/resource_name.upb.c',
         'src/core/ext/upb-generated/xds/data/orca/v3/orca_load_report.upb.c',
+        'src/core/ext/upb-generated/xds/service/orca/v3/orca.upb.c',
         'src/core/ext/upb-generated/xds/type/v3/typed_struct.upb.c',
         'src/core/ext/upbdefs-generated/envoy/admin/v3/config_dump.upbdefs.c',
         'src/core/ext/upbdefs-generated/envoy/annotations/deprecation.upbdefs.c',
@@ -823,6 +834,12 @@
         'src/core/lib/event_engine/channel_args_endpoint_config.cc',
         'src/core/lib/event_engine/event_engine.cc',
         'src/core/lib/event_engine/event_engine_factory.cc',
+        'src/core/lib/event_engine/memory_allocator.cc',
+        'src/core/lib/event_engine/posix_engine/event_poller.cc',
+        'src/core/lib/event_engine/posix_engine/posix_endpoint.cc',
+        'src/core/lib/event_engine/posix_engine/posix_engine.cc',
+        'src/core/lib/event_engine/posix_engine/thread_pool.cc',
+        'src/core/lib/event_engine/posix_engine/timer_manager.cc',
         'src/core/lib/event_engine/sockaddr.cc',
         'src/core/lib/http/format_request.cc',
         'src/core/lib/http/httpcli.cc',
@@ -843,6 +860,7 @@
         'src/core/lib/iomgr/ev_apple.cc',
         'src/core/lib/iomgr/ev_epoll1_linux.cc',
         'src/core/lib/iomgr/ev_epollex_linux.cc',
+        'src/core/lib/iomgr/ev_io_uring_linux.cc',
         'src/core/lib/iomgr/ev_poll_posix.cc',
         'src/core/lib/iomgr/ev_posix.cc',
         'src/core/lib/iomgr/ev_windows.cc',
@@ -916,6 +934,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
         'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -984,6 +1003,7 @@
         'src/core/lib/security/transport/tsi_error.cc',
         'src/core/lib/security/util/json_util.cc',
         'src/core/lib/slice/b64.cc',
+        'src/core/lib/slice/b64_simd.cc',
         'src/core/lib/slice/percent_encoding.cc',
         'src/core/lib/slice/slice.cc',
         'src/core/lib/slice/slice_api.cc',
@@ -1172,10 +1192,14 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_channel.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+        'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
+        'src/core/ext/filters/client_channel/lb_policy/pick_random.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy_registry.cc',
         'src/core/ext/filters/client_channel/local_subchannel_pool.cc',
@@ -1243,6 +1267,7 @@
         'src/core/ext/transport/chttp2/transport/hpack_parser_table.cc',
         'src/core/ext/transport/chttp2/transport/hpack_utils.cc',
         'src/core/ext/transport/chttp2/transport/http2_settings.cc',
+        'src/core/ext/transport/chttp2/transport/huffman_decoder.cc',
         'src/core/ext/transport/chttp2/transport/huffsyms.cc',
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
@@ -1255,6 +1280,7 @@
         'src/core/ext/upb-generated/src/proto/grpc/lb/v1/load_balancer.upb.c',
         'src/core/ext/upb-generated/validate/validate.upb.c',
         'src/core/ext/upb-generated/xds/data/orca/v3/orca_load_report.upb.c',
+        'src/core/ext/upb-generated/xds/service/orca/v3/orca.upb.c',
         'src/core/lib/address_utils/parse_address.cc',
         'src/core/lib/address_utils/sockaddr_utils.cc',
         'src/core/lib/backoff/backoff.cc',
@@ -1282,6 +1308,12 @@
         'src/core/lib/event_engine/channel_args_endpoint_config.cc',
         'src/core/lib/event_engine/event_engine.cc',
         'src/core/lib/event_engine/event_engine_factory.cc',
+        'src/core/lib/event_engine/memory_allocator.cc',
+        'src/core/lib/event_engine/posix_engine/event_poller.cc',
+        'src/core/lib/event_engine/posix_engine/posix_endpoint.cc',
+        'src/core/lib/event_engine/posix_engine/posix_engine.cc',
+        'src/core/lib/event_engine/posix_engine/thread_pool.cc',
+        'src/core/lib/event_engine/posix_engine/timer_manager.cc',
         'src/core/lib/event_engine/sockaddr.cc',
         'src/core/lib/http/format_request.cc',
         'src/core/lib/http/httpcli.cc',
@@ -1301,6 +1333,7 @@
         'src/core/lib/iomgr/ev_apple.cc',
         'src/core/lib/iomgr/ev_epoll1_linux.cc',
         'src/core/lib/iomgr/ev_epollex_linux.cc',
+        'src/core/lib/iomgr/ev_io_uring_linux.cc',
         'src/core/lib/iomgr/ev_poll_posix.cc',
         'src/core/lib/iomgr/ev_posix.cc',
         'src/core/lib/iomgr/ev_windows.cc',
@@ -1374,6 +1407,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
         'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -1386,6 +1420,7 @@
         'src/core/lib/json/json_writer.cc',
         'src/core/lib/security/authorization/authorization_policy_provider_null_vtable.cc',
         'src/core/lib/slice/b64.cc',
+        'src/core/lib/slice/b64_simd.cc',
         'src/core/lib/slice/percent_encoding.cc',
         'src/core/lib/slice/slice.cc',
         'src/core/lib/slice/slice_api.cc',
@@ -1518,6 +1553,7 @@
         'src/cpp/server/server_context.cc',
         'src/cpp/server/server_credentials.cc',
         'src/cpp/server/server_posix.cc',
+        'src/cpp/server/work_stealing_thread_pool.cc',
         'src/cpp/server/xds_server_credentials.cc',
         'src/cpp/thread_manager/thread_manager.cc',
         'src/cpp/util/byte_buffer_cc.cc',
@@ -1642,6 +1678,7 @@
         'src/cpp/server/server_context.cc',
         'src/cpp/server/server_credentials.cc',
         'src/cpp/server/server_posix.cc',
+        'src/cpp/server/work_stealing_thread_pool.cc',
         'src/cpp/thread_manager/thread_manager.cc',
         'src/cpp/util/byte_buffer_cc.cc',
         'src/cpp/util/status.cc',
@@ -34,7 +34,9 @@ namespace experimental {
 class SliceBuffer {
  public:
   SliceBuffer() { abort(); }
-  explicit SliceBuffer(grpc_slice_buffer*) { abort(); }
+  /// Wrap \a slice_buffer without taking ownership of it.
+  explicit SliceBuffer(grpc_slice_buffer* slice_buffer)
+      : slice_buffer_(slice_buffer) {}
 
   grpc_slice_buffer* RawSliceBuffer() { return slice_buffer_; }
 
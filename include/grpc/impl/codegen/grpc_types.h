@@ -231,6 +231,15 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** Upper bound on how long a write may be held back so that frames from other
+    streams can be coalesced into the same syscall. The actual hold tracks the
+    observed write completion time, ends early once 32 more writes were
+    initiated, and is skipped once 64KiB or 32 frames are pending. While it
+    holds, the transport keeps running its other work and then yields back to
+    the held write, so the hold also costs CPU time. Int valued,
+    microseconds, at most 1000. Defaults to 0 (disabled). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_BUDGET_US \
+  "grpc.http2.write_coalescing_budget_us"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -349,6 +358,24 @@ typedef struct {
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* TCP RX Zerocopy enable state: zero is disabled, non-zero is enabled. When
+   enabled, reads of large amounts of queued data map the received pages into
+   the process with TCP_ZEROCOPY_RECEIVE instead of copying them, falling back
+   to copying where the kernel does not support it or the data is not page
+   aligned. The mapped slices are read-only. By default, it is disabled. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_rx_zerocopy_enabled"
+/* TCP RX Zerocopy receive threshold: only map received data if at least this
+   many bytes are queued on the socket. By default, this is set to 64KB. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_rx_zerocopy_recv_bytes_threshold"
+/* If set to non zero, writes issued while a poller thread runs the callbacks
+   of a polling round are sent together at the end of the round, with a single
+   io_uring submission where the kernel allows it, instead of one sendmsg per
+   connection. Useful for servers that write to many connections at once.
+   By default, it is disabled. */
+#define GRPC_ARG_TCP_WRITE_BATCHING_ENABLED \
+  "grpc.experimental.tcp_write_batching_enabled"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -372,6 +399,11 @@ typedef struct {
    over to the next priority. Default value is 10 seconds. */
 #define GRPC_ARG_PRIORITY_FAILOVER_TIMEOUT_MS \
   "grpc.priority_failover_timeout_ms"
+/* Upper bound in bytes on the size of the RLS LB policy's cache. Larger
+   cacheSizeBytes values in the policy's configuration are reduced to it.
+   Default value is 5MiB. */
+#define GRPC_ARG_RLS_MAX_CACHE_SIZE_BYTES \
+  "grpc.experimental.rls_max_cache_size_bytes"
 /** If non-zero, grpc server's cronet compression workaround will be enabled */
 #define GRPC_ARG_WORKAROUND_CRONET_COMPRESSION \
   "grpc.workaround.cronet_compression"
@@ -389,21 +421,26 @@ typedef struct {
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
     NOTE: Transparent retries are not yet implemented.  When they are
           implemented, they will also be enabled by this arg.
-    NOTE: Hedging functionality is not yet implemented, so those
-          fields in the service config will currently be ignored.  See
-          also the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below.
+    NOTE: The hedgingPolicy field in the service config is ignored
+          unless the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below is
+          also set.
  */
 #define GRPC_ARG_ENABLE_RETRIES "grpc.enable_retries"
 /** Enables hedging functionality, as described in:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    Default is currently false, since this functionality is not yet
-    fully implemented.
+    When set, a hedgingPolicy in the service config sends up to
+    maxAttempts copies of the RPC, each hedgingDelay after the previous
+    one, and cancels the others once one of them is committed.
+    Default is currently false.
     NOTE: This channel arg is experimental and will eventually be removed.
-          Once hedging functionality has been implemented and proves stable,
-          this arg will be removed, and the hedging functionality will
-          be enabled via the GRPC_ARG_ENABLE_RETRIES arg above. */
+          Once hedging functionality proves stable, this arg will be
+          removed, and the hedging functionality will be enabled via the
+          GRPC_ARG_ENABLE_RETRIES arg above. */
 #define GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING "grpc.experimental.enable_hedging"
-/** Per-RPC retry buffer size, in bytes. Default is 256 KiB. */
+/** Per-RPC retry buffer size, in bytes. Default is 256 KiB.
+    If GRPC_ARG_RESOURCE_QUOTA is also set, the buffered data is charged
+    to the resource quota, and a call stops being retried when the quota
+    cannot cover it. */
 #define GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE "grpc.per_rpc_retry_buffer_size"
 /** Channel arg that carries the bridged objective c object for custom metrics
  * logging filter. */
@@ -437,6 +474,25 @@ typedef struct {
 /** If set, uses a local subchannel pool within the channel. Otherwise, uses the
  * global subchannel pool. */
 #define GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL "grpc.use_local_subchannel_pool"
+/** Maximum number of connections that a subchannel opens to its address, and
+ * spreads calls over by the number of calls in flight on each. More than one
+ * connection lifts the limits of a single HTTP/2 connection, such as the
+ * peer's MAX_CONCURRENT_STREAMS, for a busy backend. Int valued, defaults
+ * to 1. */
+#define GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS \
+  "grpc.experimental.subchannel_max_connections"
+/** Number of connections that a subchannel keeps open to its address while
+ * connected, up to GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS. If it is lower, the
+ * subchannel opens more connections while every connection has
+ * GRPC_ARG_SUBCHANNEL_TARGET_CALLS_PER_CONNECTION calls in flight, and closes
+ * them once the calls fit on the others at half that number. Int valued,
+ * defaults to 1. */
+#define GRPC_ARG_SUBCHANNEL_MIN_CONNECTIONS \
+  "grpc.experimental.subchannel_min_connections"
+/** Number of calls in flight on every one of a subchannel's connections at
+ * which it opens another one. Int valued, defaults to 100. */
+#define GRPC_ARG_SUBCHANNEL_TARGET_CALLS_PER_CONNECTION \
+  "grpc.experimental.subchannel_target_calls_per_connection"
 /** gRPC Objective-C channel pooling domain string. */
 #define GRPC_ARG_CHANNEL_POOL_DOMAIN "grpc.channel_pooling_domain"
 /** gRPC Objective-C channel pooling id. */
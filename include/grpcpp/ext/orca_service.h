@@ -0,0 +1,89 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_EXT_ORCA_SERVICE_H
+#define GRPCPP_EXT_ORCA_SERVICE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include <grpcpp/impl/codegen/service_type.h>
+#include <grpcpp/impl/codegen/sync.h>
+
+namespace grpc {
+namespace experimental {
+
+// A service that streams this server's load to clients as out-of-band ORCA
+// load reports (xds.service.orca.v3.OpenRcaService), for load-aware LB
+// policies such as weighted_round_robin_experimental with
+// enableOobLoadReport.  To enable it, register an instance with the
+// ServerBuilder; the binary must be built with the grpcpp_orca_service
+// library.
+//
+// CPU and memory utilization are sampled from the system each time a report
+// is sent.  The request rate and any named utilizations are set by the
+// application, and are reported as last set.
+class OrcaService : public Service {
+ public:
+  struct Options {
+    // Minimum interval between reports on a stream.  Clients that ask for a
+    // shorter interval get this one.
+    int64_t min_report_interval_ms = 1000;
+
+    Options& set_min_report_interval_ms(int64_t interval_ms) {
+      min_report_interval_ms = interval_ms;
+      return *this;
+    }
+  };
+
+  explicit OrcaService(Options options);
+
+  // Sets the requests per second reported to clients.
+  void SetRequestsPerSecond(uint64_t requests_per_second);
+
+  // Sets, or deletes, an application-specific utilization reported to
+  // clients, as a fraction of the resource available.
+  void SetNamedUtilization(const std::string& name, double utilization);
+  void DeleteNamedUtilization(const std::string& name);
+
+ private:
+  class Reactor;
+
+  // Returns the current load as a serialized OrcaLoadReport.
+  std::string GetSerializedLoadReport();
+
+  const int64_t min_report_interval_ms_;
+
+  grpc::internal::Mutex mu_;
+  uint64_t requests_per_second_ ABSL_GUARDED_BY(mu_) = 0;
+  std::map<std::string, double> named_utilization_ ABSL_GUARDED_BY(mu_);
+  // CPU time counters at the previous sample, and the utilization computed
+  // from them, which is reported again when no time has elapsed since.
+  uint64_t last_cpu_busy_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t last_cpu_total_ ABSL_GUARDED_BY(mu_) = 0;
+  double cpu_utilization_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_EXT_ORCA_SERVICE_H
@@ -39,7 +39,7 @@ std::map<absl::string_view, double> ParseMap(
     const auto* entry = entry_func(msg, &i);
     if (entry == nullptr) break;
     upb_strview key_view = key_func(entry);
-    char* key = static_cast<char*>(arena->Alloc(key_view.size));
+    char* key = static_cast<char*>(arena->Alloc(key_view.size, 1));
     memcpy(key, key_view.data, key_view.size);
     result[absl::string_view(key, key_view.size)] = value_func(entry);
   }
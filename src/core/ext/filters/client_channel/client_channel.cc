@@ -52,6 +52,7 @@
 #include "src/core/ext/filters/client_channel/resolver_result_parsing.h"
 #include "src/core/ext/filters/client_channel/retry_filter.h"
 #include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface_internal.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 #include "src/core/ext/service_config/service_config.h"
 #include "src/core/ext/service_config/service_config_call_data.h"
@@ -106,7 +107,9 @@ class ClientChannel::CallData {
       grpc_call_element* elem, grpc_transport_stream_op_batch* batch);
   static void SetPollent(grpc_call_element* elem, grpc_polling_entity* pollent);
 
-  // Invoked by channel for queued calls when name resolution is completed.
+  // Applies the service config to the call, or queues the call until the
+  // channel has a resolver result.  Takes ClientChannel::resolution_mu_
+  // only if there is no result yet.
   static void CheckResolution(void* arg, grpc_error_handle error);
   // Helper function for applying the service config to a call while
   // holding ClientChannel::resolution_mu_.
@@ -158,12 +161,13 @@ class ClientChannel::CallData {
   void PendingBatchesResume(grpc_call_element* elem);
 
   // Applies service config to the call.  Must be invoked once we know
-  // that the resolver has returned results to the channel.
+  // that the resolver has returned results to the channel, with the
+  // resulting state, which the caller must keep alive.
   // If an error is returned, the error indicates the status with which
   // the call should be failed.
-  grpc_error_handle ApplyServiceConfigToCallLocked(
-      grpc_call_element* elem, grpc_metadata_batch* initial_metadata)
-      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::resolution_mu_);
+  grpc_error_handle ApplyServiceConfigToCall(
+      grpc_call_element* elem, grpc_metadata_batch* initial_metadata,
+      const ResolverDataPlaneState& state);
   // Invoked when the resolver result is applied to the caller, on both
   // success or failure.
   static void ResolutionDone(void* arg, grpc_error_handle error);
@@ -203,9 +207,10 @@ class ClientChannel::CallData {
 
   grpc_closure resolution_done_closure_;
 
+  // Set either before the call is first queued, without holding
+  // ClientChannel::resolution_mu_, or while holding it.
+  bool service_config_applied_ = false;
   // Accessed while holding ClientChannel::resolution_mu_.
-  bool service_config_applied_ ABSL_GUARDED_BY(&ClientChannel::resolution_mu_) =
-      false;
   bool queued_pending_resolver_result_
       ABSL_GUARDED_BY(&ClientChannel::resolution_mu_) = false;
   ClientChannel::ResolverQueuedCall resolver_queued_call_
@@ -530,6 +535,10 @@ class ClientChannel::SubchannelWrapper : public SubchannelInterface {
     return subchannel_->connected_subchannel();
   }
 
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel_for_call() const {
+    return subchannel_->ConnectedSubchannelForCall();
+  }
+
   void AttemptToConnect() override { subchannel_->AttemptToConnect(); }
 
   void ResetBackoff() override { subchannel_->ResetBackoff(); }
@@ -538,6 +547,15 @@ class ClientChannel::SubchannelWrapper : public SubchannelInterface {
     return subchannel_->channel_args();
   }
 
+  void AddDataWatcher(std::unique_ptr<DataWatcherInterface> watcher) override
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(chand_->work_serializer_) {
+    std::unique_ptr<InternalSubchannelDataWatcherInterface> internal_watcher(
+        static_cast<InternalSubchannelDataWatcherInterface*>(
+            watcher.release()));
+    internal_watcher->SetSubchannel(subchannel_.get());
+    data_watchers_.push_back(std::move(internal_watcher));
+  }
+
   void ThrottleKeepaliveTime(int new_keepalive_time) {
     subchannel_->ThrottleKeepaliveTime(new_keepalive_time);
   }
@@ -674,6 +692,8 @@ class ClientChannel::SubchannelWrapper : public SubchannelInterface {
   // corresponding WrapperWatcher to cancel on the underlying subchannel.
   std::map<ConnectivityStateWatcherInterface*, WatcherWrapper*> watcher_map_
       ABSL_GUARDED_BY(&ClientChannel::work_serializer_);
+  std::vector<std::unique_ptr<InternalSubchannelDataWatcherInterface>>
+      data_watchers_ ABSL_GUARDED_BY(&ClientChannel::work_serializer_);
 };
 
 //
@@ -1490,20 +1510,22 @@ void ClientChannel::UpdateServiceConfigInDataPlaneLocked() {
       DynamicFilters::Create(new_args, std::move(filters));
   GPR_ASSERT(dynamic_filters != nullptr);
   grpc_channel_args_destroy(new_args);
+  auto state = absl::make_unique<ResolverDataPlaneState>();
+  state->service_config = std::move(service_config);
+  state->config_selector = std::move(config_selector);
+  state->dynamic_filters = std::move(dynamic_filters);
   // Grab data plane lock to update service config.
   //
   // We defer unreffing the old values (and deallocating memory) until
   // after releasing the lock to keep the critical section small.
+  std::unique_ptr<ResolverDataPlaneState> old_state;
   {
     MutexLock lock(&resolution_mu_);
     GRPC_ERROR_UNREF(resolver_transient_failure_error_);
     resolver_transient_failure_error_ = GRPC_ERROR_NONE;
     // Update service config.
-    received_service_config_data_ = true;
     // Old values will be unreffed after lock is released.
-    service_config_.swap(service_config);
-    config_selector_.swap(config_selector);
-    dynamic_filters_.swap(dynamic_filters);
+    old_state = resolver_data_plane_state_.Exchange(std::move(state));
     // Process calls that were queued waiting for the resolver result.
     for (ResolverQueuedCall* call = resolver_queued_calls_; call != nullptr;
          call = call->next) {
@@ -1524,8 +1546,10 @@ void ClientChannel::UpdateServiceConfigInDataPlaneLocked() {
       }
     }
   }
-  // Old values will be unreffed after lock is released when they go out
-  // of scope.
+  // Calls may still be applying the old values without holding the lock.
+  // Wait for them before the old values are unreffed when they go out of
+  // scope.
+  resolver_data_plane_state_.Synchronize();
 }
 
 void ClientChannel::CreateResolverLocked() {
@@ -1576,17 +1600,13 @@ void ClientChannel::UpdateStateAndPickerLocked(
     saved_config_selector_.reset();
     // Acquire resolution lock to update config selector and associated state.
     // To minimize lock contention, we wait to unref these objects until
-    // after we release the lock.
-    RefCountedPtr<ServiceConfig> service_config_to_unref;
-    RefCountedPtr<ConfigSelector> config_selector_to_unref;
-    RefCountedPtr<DynamicFilters> dynamic_filters_to_unref;
+    // after we release the lock and calls still using them are done.
+    std::unique_ptr<ResolverDataPlaneState> state_to_unref;
     {
       MutexLock lock(&resolution_mu_);
-      received_service_config_data_ = false;
-      service_config_to_unref = std::move(service_config_);
-      config_selector_to_unref = std::move(config_selector_);
-      dynamic_filters_to_unref = std::move(dynamic_filters_);
+      state_to_unref = resolver_data_plane_state_.Exchange(nullptr);
     }
+    resolver_data_plane_state_.Synchronize();
   }
   // Update connectivity state.
   state_tracker_.SetState(state, status, reason);
@@ -1602,8 +1622,9 @@ void ClientChannel::UpdateStateAndPickerLocked(
   {
     MutexLock lock(&data_plane_mu_);
     // Swap out the picker.
-    // Note: Original value will be destroyed after the lock is released.
-    picker_.swap(picker);
+    // Note: Original value will be destroyed after the lock is released,
+    // once no call can still be using it.
+    picker = picker_.Exchange(std::move(picker));
     // Re-process queued picks.
     for (LbQueuedCall* call = lb_queued_calls_; call != nullptr;
          call = call->next) {
@@ -1622,6 +1643,9 @@ void ClientChannel::UpdateStateAndPickerLocked(
       }
     }
   }
+  // Calls may still be picking with the old picker without holding the
+  // lock.  Wait for them before it is destroyed.
+  picker_.Synchronize();
 }
 
 namespace {
@@ -1665,7 +1689,7 @@ grpc_error_handle ClientChannel::DoPingLocked(grpc_transport_op* op) {
   LoadBalancingPolicy::PickResult result;
   {
     MutexLock lock(&data_plane_mu_);
-    result = picker_->Pick(LoadBalancingPolicy::PickArgs());
+    result = picker_.get()->Pick(LoadBalancingPolicy::PickArgs());
   }
   return HandlePickResult<grpc_error_handle>(
       &result,
@@ -2187,14 +2211,15 @@ void ClientChannel::CallData::MaybeAddCallToResolverQueuedCallsLocked(
   resolver_call_canceller_ = new ResolverQueuedCallCanceller(elem);
 }
 
-grpc_error_handle ClientChannel::CallData::ApplyServiceConfigToCallLocked(
-    grpc_call_element* elem, grpc_metadata_batch* initial_metadata) {
+grpc_error_handle ClientChannel::CallData::ApplyServiceConfigToCall(
+    grpc_call_element* elem, grpc_metadata_batch* initial_metadata,
+    const ResolverDataPlaneState& state) {
   ClientChannel* chand = static_cast<ClientChannel*>(elem->channel_data);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: applying service config to call",
             chand, this);
   }
-  ConfigSelector* config_selector = chand->config_selector_.get();
+  ConfigSelector* config_selector = state.config_selector.get();
   if (config_selector != nullptr) {
     // Use the ConfigSelector to determine the config for the call.
     ConfigSelector::CallConfig call_config =
@@ -2242,7 +2267,7 @@ grpc_error_handle ClientChannel::CallData::ApplyServiceConfigToCallLocked(
       }
     }
     // Set the dynamic filter stack.
-    dynamic_filters_ = chand->dynamic_filters_;
+    dynamic_filters_ = state.dynamic_filters;
   }
   return GRPC_ERROR_NONE;
 }
@@ -2303,8 +2328,23 @@ void ClientChannel::CallData::CheckResolution(void* arg,
   grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
   CallData* calld = static_cast<CallData*>(elem->call_data);
   ClientChannel* chand = static_cast<ClientChannel*>(elem->channel_data);
-  bool resolution_complete;
+  bool resolution_complete = false;
   {
+    // Once the channel has a resolver result, the service config can be
+    // applied without taking the resolution mutex.
+    RcuPtr<ResolverDataPlaneState>::ReadLock state(
+        &chand->resolver_data_plane_state_);
+    if (GPR_LIKELY(state.get() != nullptr)) {
+      calld->service_config_applied_ = true;
+      error = calld->ApplyServiceConfigToCall(
+          elem,
+          calld->pending_batches_[0]
+              ->payload->send_initial_metadata.send_initial_metadata,
+          *state.get());
+      resolution_complete = true;
+    }
+  }
+  if (!resolution_complete) {
     MutexLock lock(&chand->resolution_mu_);
     resolution_complete = calld->CheckResolutionLocked(elem, &error);
   }
@@ -2350,7 +2390,9 @@ bool ClientChannel::CallData::CheckResolutionLocked(grpc_call_element* elem,
       send_initial_metadata.send_initial_metadata_flags;
   // If we don't yet have a resolver result, we need to queue the call
   // until we get one.
-  if (GPR_UNLIKELY(!chand->received_service_config_data_)) {
+  const ResolverDataPlaneState* state =
+      chand->resolver_data_plane_state_.get();
+  if (GPR_UNLIKELY(state == nullptr)) {
     // If the resolver returned transient failure before returning the
     // first service config, fail any non-wait_for_ready calls.
     grpc_error_handle resolver_error = chand->resolver_transient_failure_error_;
@@ -2370,7 +2412,7 @@ bool ClientChannel::CallData::CheckResolutionLocked(grpc_call_element* elem,
   // Apply service config to call if not yet applied.
   if (GPR_LIKELY(!service_config_applied_)) {
     service_config_applied_ = true;
-    *error = ApplyServiceConfigToCallLocked(elem, initial_metadata_batch);
+    *error = ApplyServiceConfigToCall(elem, initial_metadata_batch, *state);
   }
   MaybeRemoveCallFromResolverQueuedCallsLocked(elem);
   return true;
@@ -2542,6 +2584,9 @@ ClientChannel::LoadBalancedCall::~LoadBalancedCall() {
   grpc_slice_unref_internal(path_);
   GRPC_ERROR_UNREF(cancel_error_);
   GRPC_ERROR_UNREF(failure_error_);
+  if (picked_connected_subchannel_ != nullptr) {
+    picked_connected_subchannel_->CallFinished();
+  }
   if (backend_metric_data_ != nullptr) {
     backend_metric_data_->LoadBalancingPolicy::BackendMetricAccessor::
         BackendMetricData::~BackendMetricData();
@@ -2778,6 +2823,13 @@ void ClientChannel::LoadBalancedCall::StartTransportStreamOpBatch(
       gpr_log(GPR_INFO, "chand=%p lb_call=%p: recording cancel_error=%s",
               chand_, this, grpc_error_std_string(cancel_error_).c_str());
     }
+    // If the pick is queued, remove it.  Our call combiner cancellation
+    // closure may have been replaced by that of another LB call on the
+    // same call (e.g., a hedged attempt), so it cannot be relied on here.
+    {
+      MutexLock lock(&chand_->data_plane_mu_);
+      MaybeRemoveCallFromLbQueuedCallsLocked();
+    }
     // Fail all pending batches.
     PendingBatchesFail(GRPC_ERROR_REF(cancel_error_), NoYieldCallCombiner);
     // Note: This will release the call combiner.
@@ -2924,11 +2976,11 @@ void ClientChannel::LoadBalancedCall::CreateSubchannelCall() {
 
 // A class to handle the call combiner cancellation callback for a
 // queued pick.
-// TODO(roth): When we implement hedging support, we won't be able to
-// register a call combiner cancellation closure for each LB pick,
-// because there may be multiple LB picks happening in parallel.
-// Instead, we will probably need to maintain a list in the CallData
-// object of pending LB picks to be cancelled when the closure runs.
+// Note that with hedging, several LB calls on the same call may have
+// queued picks at once, and each one replaces the previous call
+// combiner cancellation closure.  The retry filter therefore cancels
+// each hedged attempt with a cancel_stream op, which also removes the
+// attempt's queued pick.
 class ClientChannel::LoadBalancedCall::LbQueuedCallCanceller {
  public:
   explicit LbQueuedCallCanceller(RefCountedPtr<LoadBalancedCall> lb_call)
@@ -3019,10 +3071,24 @@ void ClientChannel::LoadBalancedCall::PickDone(void* arg,
 void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
                                                      grpc_error_handle error) {
   auto* self = static_cast<LoadBalancedCall*>(arg);
+  ClientChannel* chand = self->chand_;
   bool pick_complete;
   {
-    MutexLock lock(&self->chand_->data_plane_mu_);
-    pick_complete = self->PickSubchannelLocked(&error);
+    RcuPtr<LoadBalancingPolicy::SubchannelPicker>::ReadLock picker(
+        &chand->picker_);
+    pick_complete = self->PickSubchannelImpl(picker.get(), &error);
+    if (!pick_complete) {
+      // The call needs to wait for a new picker.  Pickers are replaced
+      // while holding the data plane mutex, which is also held while
+      // re-processing queued calls, so if the picker has not changed
+      // yet, queueing the call now cannot miss the next one.
+      MutexLock lock(&chand->data_plane_mu_);
+      if (chand->picker_.get() == picker.get()) {
+        self->MaybeAddCallToLbQueuedCallsLocked();
+      } else {
+        pick_complete = self->PickSubchannelLocked(&error);
+      }
+    }
   }
   if (pick_complete) {
     PickDone(self, error);
@@ -3032,6 +3098,16 @@ void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
 
 bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
     grpc_error_handle* error) {
+  if (PickSubchannelImpl(chand_->picker_.get(), error)) {
+    MaybeRemoveCallFromLbQueuedCallsLocked();
+    return true;
+  }
+  MaybeAddCallToLbQueuedCallsLocked();
+  return false;
+}
+
+bool ClientChannel::LoadBalancedCall::PickSubchannelImpl(
+    LoadBalancingPolicy::SubchannelPicker* picker, grpc_error_handle* error) {
   GPR_ASSERT(connected_subchannel_ == nullptr);
   GPR_ASSERT(subchannel_call_ == nullptr);
   // Grab initial metadata.
@@ -3048,93 +3124,84 @@ bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
   pick_args.call_state = &lb_call_state;
   Metadata initial_metadata(this, initial_metadata_batch);
   pick_args.initial_metadata = &initial_metadata;
-  auto result = chand_->picker_->Pick(pick_args);
+  auto result = picker->Pick(pick_args);
   return HandlePickResult<bool>(
       &result,
       // CompletePick
-      [this](LoadBalancingPolicy::PickResult::Complete* complete_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
-              gpr_log(GPR_INFO,
-                      "chand=%p lb_call=%p: LB pick succeeded: subchannel=%p",
-                      chand_, this, complete_pick->subchannel.get());
-            }
-            GPR_ASSERT(complete_pick->subchannel != nullptr);
-            // Grab a ref to the connected subchannel while we're still
-            // holding the data plane mutex.
-            SubchannelWrapper* subchannel = static_cast<SubchannelWrapper*>(
-                complete_pick->subchannel.get());
-            connected_subchannel_ = subchannel->connected_subchannel();
-            // If the subchannel has no connected subchannel (e.g., if the
-            // subchannel has moved out of state READY but the LB policy hasn't
-            // yet seen that change and given us a new picker), then just
-            // queue the pick.  We'll try again as soon as we get a new picker.
-            if (connected_subchannel_ == nullptr) {
-              if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
-                gpr_log(GPR_INFO,
-                        "chand=%p lb_call=%p: subchannel returned by LB picker "
-                        "has no connected subchannel; queueing pick",
-                        chand_, this);
-              }
-              MaybeAddCallToLbQueuedCallsLocked();
-              return false;
-            }
-            lb_subchannel_call_tracker_ =
-                std::move(complete_pick->subchannel_call_tracker);
-            if (lb_subchannel_call_tracker_ != nullptr) {
-              lb_subchannel_call_tracker_->Start();
-            }
-            MaybeRemoveCallFromLbQueuedCallsLocked();
-            return true;
-          },
+      [this](LoadBalancingPolicy::PickResult::Complete* complete_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
+          gpr_log(GPR_INFO,
+                  "chand=%p lb_call=%p: LB pick succeeded: subchannel=%p",
+                  chand_, this, complete_pick->subchannel.get());
+        }
+        GPR_ASSERT(complete_pick->subchannel != nullptr);
+        // Grab a ref to the connected subchannel while the picker (and
+        // therefore the subchannel) is still known to be alive.
+        SubchannelWrapper* subchannel = static_cast<SubchannelWrapper*>(
+            complete_pick->subchannel.get());
+        connected_subchannel_ = subchannel->connected_subchannel_for_call();
+        // If the subchannel has no connected subchannel (e.g., if the
+        // subchannel has moved out of state READY but the LB policy hasn't
+        // yet seen that change and given us a new picker), then just
+        // queue the pick.  We'll try again as soon as we get a new picker.
+        if (connected_subchannel_ == nullptr) {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
+            gpr_log(GPR_INFO,
+                    "chand=%p lb_call=%p: subchannel returned by LB picker "
+                    "has no connected subchannel; queueing pick",
+                    chand_, this);
+          }
+          return false;
+        }
+        picked_connected_subchannel_ = connected_subchannel_;
+        lb_subchannel_call_tracker_ =
+            std::move(complete_pick->subchannel_call_tracker);
+        if (lb_subchannel_call_tracker_ != nullptr) {
+          lb_subchannel_call_tracker_->Start();
+        }
+        return true;
+      },
       // QueuePick
-      [this](LoadBalancingPolicy::PickResult::Queue* /*queue_pick*/)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick queued", chand_,
-                      this);
-            }
-            MaybeAddCallToLbQueuedCallsLocked();
-            return false;
-          },
+      [this](LoadBalancingPolicy::PickResult::Queue* /*queue_pick*/) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick queued", chand_,
+                  this);
+        }
+        return false;
+      },
       // FailPick
       [this, send_initial_metadata_flags,
-       &error](LoadBalancingPolicy::PickResult::Fail* fail_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick failed: %s",
-                      chand_, this, fail_pick->status.ToString().c_str());
-            }
-            // If wait_for_ready is false, then the error indicates the RPC
-            // attempt's final status.
-            if ((send_initial_metadata_flags &
-                 GRPC_INITIAL_METADATA_WAIT_FOR_READY) == 0) {
-              grpc_error_handle lb_error =
-                  absl_status_to_grpc_error(fail_pick->status);
-              *error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
-                  "Failed to pick subchannel", &lb_error, 1);
-              GRPC_ERROR_UNREF(lb_error);
-              MaybeRemoveCallFromLbQueuedCallsLocked();
-              return true;
-            }
-            // If wait_for_ready is true, then queue to retry when we get a new
-            // picker.
-            MaybeAddCallToLbQueuedCallsLocked();
-            return false;
-          },
+       &error](LoadBalancingPolicy::PickResult::Fail* fail_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick failed: %s",
+                  chand_, this, fail_pick->status.ToString().c_str());
+        }
+        // If wait_for_ready is false, then the error indicates the RPC
+        // attempt's final status.
+        if ((send_initial_metadata_flags &
+             GRPC_INITIAL_METADATA_WAIT_FOR_READY) == 0) {
+          grpc_error_handle lb_error =
+              absl_status_to_grpc_error(fail_pick->status);
+          *error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+              "Failed to pick subchannel", &lb_error, 1);
+          GRPC_ERROR_UNREF(lb_error);
+          return true;
+        }
+        // If wait_for_ready is true, then queue to retry when we get a new
+        // picker.
+        return false;
+      },
       // DropPick
-      [this, &error](LoadBalancingPolicy::PickResult::Drop* drop_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick dropped: %s",
-                      chand_, this, drop_pick->status.ToString().c_str());
-            }
-            *error =
-                grpc_error_set_int(absl_status_to_grpc_error(drop_pick->status),
-                                   GRPC_ERROR_INT_LB_POLICY_DROP, 1);
-            MaybeRemoveCallFromLbQueuedCallsLocked();
-            return true;
-          });
+      [this, &error](LoadBalancingPolicy::PickResult::Drop* drop_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_routing_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick dropped: %s",
+                  chand_, this, drop_pick->status.ToString().c_str());
+        }
+        *error =
+            grpc_error_set_int(absl_status_to_grpc_error(drop_pick->status),
+                               GRPC_ERROR_INT_LB_POLICY_DROP, 1);
+        return true;
+      });
 }
 
 }  // namespace grpc_core
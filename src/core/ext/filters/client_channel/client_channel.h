@@ -43,6 +43,7 @@
 #include "src/core/ext/service_config/service_config_parser.h"
 #include "src/core/lib/channel/call_tracer.h"
 #include "src/core/lib/channel/context.h"
+#include "src/core/lib/gprpp/rcu_ptr.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/error.h"
@@ -198,6 +199,13 @@ class ClientChannel {
     LoadBalancedCall* lb_call;
     LbQueuedCall* next = nullptr;
   };
+  // The parts of the resolver result that calls use, published together
+  // so that calls can read them without taking resolution_mu_.
+  struct ResolverDataPlaneState {
+    RefCountedPtr<ServiceConfig> service_config;
+    RefCountedPtr<ConfigSelector> config_selector;
+    RefCountedPtr<DynamicFilters> dynamic_filters;
+  };
 
   ClientChannel(grpc_channel_element_args* args, grpc_error_handle* error);
   ~ClientChannel();
@@ -290,19 +298,17 @@ class ClientChannel {
   // Data from service config.
   grpc_error_handle resolver_transient_failure_error_
       ABSL_GUARDED_BY(resolution_mu_) = GRPC_ERROR_NONE;
-  bool received_service_config_data_ ABSL_GUARDED_BY(resolution_mu_) = false;
-  RefCountedPtr<ServiceConfig> service_config_ ABSL_GUARDED_BY(resolution_mu_);
-  RefCountedPtr<ConfigSelector> config_selector_
-      ABSL_GUARDED_BY(resolution_mu_);
-  RefCountedPtr<DynamicFilters> dynamic_filters_
-      ABSL_GUARDED_BY(resolution_mu_);
+  // Null until the first service config is received.  Read by calls
+  // without holding resolution_mu_; replaced only while holding it.
+  RcuPtr<ResolverDataPlaneState> resolver_data_plane_state_;
 
   //
   // Fields used in the data plane.  Guarded by data_plane_mu_.
   //
   mutable Mutex data_plane_mu_;
-  std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
-      ABSL_GUARDED_BY(data_plane_mu_);
+  // Read by calls without holding data_plane_mu_; replaced only while
+  // holding it.
+  RcuPtr<LoadBalancingPolicy::SubchannelPicker> picker_;
   // Linked list of calls queued waiting for LB pick.
   LbQueuedCall* lb_queued_calls_ ABSL_GUARDED_BY(data_plane_mu_) = nullptr;
 
@@ -377,7 +383,9 @@ class ClientChannel::LoadBalancedCall
 
   void StartTransportStreamOpBatch(grpc_transport_stream_op_batch* batch);
 
-  // Invoked by channel for queued LB picks when the picker is updated.
+  // Performs the initial LB pick for the call.  The pick runs without
+  // the data plane mutex; the mutex is taken only if the call has to be
+  // queued for a new picker.
   static void PickSubchannel(void* arg, grpc_error_handle error);
   // Helper function for performing an LB pick while holding the data plane
   // mutex.  Returns true if the pick is complete, in which case the caller
@@ -435,6 +443,11 @@ class ClientChannel::LoadBalancedCall
   void CreateSubchannelCall();
   // Invoked when a pick is completed, on both success or failure.
   static void PickDone(void* arg, grpc_error_handle error);
+  // Performs an LB pick with picker, which the caller must keep alive.
+  // Returns true if the pick is complete, or false if the call needs to
+  // wait for a new picker, in which case the caller must queue it.
+  bool PickSubchannelImpl(LoadBalancingPolicy::SubchannelPicker* picker,
+                          grpc_error_handle* error);
   // Removes the call from the channel's list of queued picks if present.
   void MaybeRemoveCallFromLbQueuedCallsLocked()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_);
@@ -478,6 +491,8 @@ class ClientChannel::LoadBalancedCall
       ABSL_GUARDED_BY(&ClientChannel::data_plane_mu_) = nullptr;
 
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
+  // The connection the pick counted this call on, if any.
+  RefCountedPtr<ConnectedSubchannel> picked_connected_subchannel_;
   const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData*
       backend_metric_data_ = nullptr;
   std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
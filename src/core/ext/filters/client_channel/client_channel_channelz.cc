@@ -43,9 +43,20 @@ void SubchannelNode::UpdateConnectivityState(grpc_connectivity_state state) {
   connectivity_state_.store(state, std::memory_order_relaxed);
 }
 
-void SubchannelNode::SetChildSocket(RefCountedPtr<SocketNode> socket) {
+void SubchannelNode::AddChildSocket(RefCountedPtr<SocketNode> socket) {
+  if (socket == nullptr) return;
   MutexLock lock(&socket_mu_);
-  child_socket_ = std::move(socket);
+  child_sockets_.push_back(std::move(socket));
+}
+
+void SubchannelNode::RemoveChildSocket(SocketNode* socket) {
+  MutexLock lock(&socket_mu_);
+  for (auto it = child_sockets_.begin(); it != child_sockets_.end(); ++it) {
+    if (it->get() == socket) {
+      child_sockets_.erase(it);
+      return;
+    }
+  }
 }
 
 Json SubchannelNode::RenderJson() {
@@ -75,20 +86,22 @@ Json SubchannelNode::RenderJson() {
        }},
       {"data", std::move(data)},
   };
-  // Populate the child socket.
-  RefCountedPtr<SocketNode> child_socket;
+  // Populate the child sockets, one for each of the subchannel's
+  // connections.
+  std::vector<RefCountedPtr<SocketNode>> child_sockets;
   {
     MutexLock lock(&socket_mu_);
-    child_socket = child_socket_;
+    child_sockets = child_sockets_;
   }
-  if (child_socket != nullptr && child_socket->uuid() != 0) {
-    object["socketRef"] = Json::Array{
-        Json::Object{
-            {"socketId", std::to_string(child_socket->uuid())},
-            {"name", child_socket->name()},
-        },
-    };
+  Json::Array socket_refs;
+  for (const auto& child_socket : child_sockets) {
+    if (child_socket->uuid() == 0) continue;
+    socket_refs.emplace_back(Json::Object{
+        {"socketId", std::to_string(child_socket->uuid())},
+        {"name", child_socket->name()},
+    });
   }
+  if (!socket_refs.empty()) object["socketRef"] = std::move(socket_refs);
   return object;
 }
 
@@ -22,6 +22,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <string>
+#include <vector>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
@@ -39,10 +40,11 @@ class SubchannelNode : public BaseNode {
   // Sets the subchannel's connectivity state without health checking.
   void UpdateConnectivityState(grpc_connectivity_state state);
 
-  // Used when the subchannel's child socket changes. This should be set when
-  // the subchannel's transport is created and set to nullptr when the
-  // subchannel unrefs the transport.
-  void SetChildSocket(RefCountedPtr<SocketNode> socket);
+  // Used when the subchannel's child sockets change. A socket should be added
+  // when the subchannel creates a transport, and removed when the subchannel
+  // unrefs the transport.
+  void AddChildSocket(RefCountedPtr<SocketNode> socket);
+  void RemoveChildSocket(SocketNode* socket);
 
   Json RenderJson() override;
 
@@ -63,7 +65,8 @@ class SubchannelNode : public BaseNode {
  private:
   std::atomic<grpc_connectivity_state> connectivity_state_{GRPC_CHANNEL_IDLE};
   Mutex socket_mu_;
-  RefCountedPtr<SocketNode> child_socket_ ABSL_GUARDED_BY(socket_mu_);
+  std::vector<RefCountedPtr<SocketNode>> child_sockets_
+      ABSL_GUARDED_BY(socket_mu_);
   std::string target_;
   CallCountingHelper call_counter_;
   ChannelTrace trace_;
@@ -19,6 +19,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
 #include <functional>
 #include <iterator>
 
@@ -266,9 +267,10 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
   /// updates, connectivity state notifications, etc); the latter should
   /// live in the LB policy object itself.
   ///
-  /// Currently, pickers are always accessed from within the
-  /// client_channel data plane mutex, so they do not have to be
-  /// thread-safe.
+  /// The client channel calls Pick() concurrently from any number of
+  /// threads, without holding a lock, so pickers must be thread-safe.
+  /// Pick() must not block, since the channel waits for picks in
+  /// progress before destroying a picker it has replaced.
   class SubchannelPicker {
    public:
     SubchannelPicker() = default;
@@ -397,7 +399,7 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
 
    private:
     RefCountedPtr<LoadBalancingPolicy> parent_;
-    bool exit_idle_called_ = false;
+    std::atomic<bool> exit_idle_called_{false};
   };
 
   // A picker that returns PickResult::Fail for all picks.
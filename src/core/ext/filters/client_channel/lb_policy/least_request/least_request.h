@@ -0,0 +1,43 @@
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_LEAST_REQUEST_LEAST_REQUEST_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_LEAST_REQUEST_LEAST_REQUEST_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/json/json.h"
+
+namespace grpc_core {
+
+// Default and maximum number of READY subchannels sampled per pick. Larger
+// values are clamped to the maximum, as in Envoy.
+constexpr uint32_t kLeastRequestDefaultChoiceCount = 2;
+constexpr uint32_t kLeastRequestMaxChoiceCount = 10;
+
+// Helper Parsing method to parse least request policy configs; for example,
+// choice count validity.
+void ParseLeastRequestLbConfig(const Json& json, uint32_t* choice_count,
+                               std::vector<grpc_error_handle>* error_list);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_LEAST_REQUEST_LEAST_REQUEST_H
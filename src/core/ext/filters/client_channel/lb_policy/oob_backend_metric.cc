@@ -0,0 +1,929 @@
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+
+#include "google/protobuf/duration.upb.h"
+#include "upb/upb.hpp"
+#include "xds/service/orca/v3/orca.upb.h"
+
+#include "src/core/ext/filters/client_channel/backend_metric.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface_internal.h"
+#include "src/core/lib/backoff/backoff.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/arena.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/polling_entity.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/byte_stream.h"
+#include "src/core/lib/transport/error_utils.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/static_metadata.h"
+#include "src/core/lib/transport/status_metadata.h"
+#include "src/core/lib/transport/transport.h"
+
+#define ORCA_INITIAL_CONNECT_BACKOFF_SECONDS 1
+#define ORCA_RECONNECT_BACKOFF_MULTIPLIER 1.6
+#define ORCA_RECONNECT_MAX_BACKOFF_SECONDS 120
+#define ORCA_RECONNECT_JITTER 0.2
+
+namespace grpc_core {
+
+TraceFlag grpc_orca_client_trace(false, "orca_client");
+
+namespace {
+
+constexpr char kOrcaProducerType[] = "orca";
+constexpr char kOrcaStreamMethod[] =
+    "/xds.service.orca.v3.OpenRcaService/StreamCoreMetrics";
+
+class OrcaWatcher;
+
+//
+// OrcaProducer
+//
+
+// Runs the ORCA stream of one subchannel on behalf of all of its watchers.
+// Strong refs are held by the watchers; the producer is orphaned when the
+// last of them goes away.  Weak refs are held by the connectivity watcher
+// and by the stream client, which may outlive the orphaning briefly.
+class OrcaProducer : public Subchannel::DataProducerInterface {
+ public:
+  explicit OrcaProducer(RefCountedPtr<Subchannel> subchannel);
+  ~OrcaProducer() override;
+
+  const char* type() const override { return kOrcaProducerType; }
+
+  // Starts watching the subchannel's connectivity state.  Must be called
+  // once, after the producer has been registered with the subchannel.
+  void Start();
+
+  void Orphan() override;
+
+  void AddWatcher(OrcaWatcher* watcher);
+  void RemoveWatcher(OrcaWatcher* watcher);
+
+ private:
+  class ConnectivityWatcher;
+  class OrcaStreamClient;
+
+  void OnConnectivityStateChange(grpc_connectivity_state state);
+  void NotifyWatchers(
+      const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData&
+          backend_metric_data);
+
+  WeakRefCountedPtr<OrcaProducer> WeakRefAsOrcaProducer() {
+    return WeakRefCountedPtr<OrcaProducer>(
+        static_cast<OrcaProducer*>(WeakRef().release()));
+  }
+
+  // (Re)starts the stream with the current report interval if the
+  // subchannel is connected.
+  void MaybeStartStreamLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  RefCountedPtr<Subchannel> subchannel_;
+  grpc_pollset_set* interested_parties_;
+  // Owned by the subchannel.
+  ConnectivityWatcher* connectivity_watcher_ = nullptr;
+
+  Mutex mu_;
+  bool shutting_down_ ABSL_GUARDED_BY(mu_) = false;
+  std::set<OrcaWatcher*> watchers_ ABSL_GUARDED_BY(mu_);
+  grpc_millis report_interval_ ABSL_GUARDED_BY(mu_) = GRPC_MILLIS_INF_FUTURE;
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel_
+      ABSL_GUARDED_BY(mu_);
+  OrphanablePtr<OrcaStreamClient> stream_client_ ABSL_GUARDED_BY(mu_);
+};
+
+//
+// OrcaWatcher
+//
+
+class OrcaWatcher : public InternalSubchannelDataWatcherInterface {
+ public:
+  OrcaWatcher(grpc_millis report_interval,
+              std::unique_ptr<OobBackendMetricWatcher> watcher)
+      : report_interval_(report_interval), watcher_(std::move(watcher)) {}
+
+  ~OrcaWatcher() override {
+    if (producer_ != nullptr) producer_->RemoveWatcher(this);
+  }
+
+  grpc_millis report_interval() const { return report_interval_; }
+  OobBackendMetricWatcher* watcher() const { return watcher_.get(); }
+
+  void SetSubchannel(Subchannel* subchannel) override {
+    bool created = false;
+    // The producer registered for the subchannel may be in the middle of
+    // being orphaned, in which case it is replaced with a new one.
+    subchannel->GetOrAddDataProducer(
+        kOrcaProducerType,
+        [&](Subchannel::DataProducerInterface** producer) {
+          if (*producer != nullptr) {
+            producer_.reset(static_cast<OrcaProducer*>(
+                (*producer)->RefIfNonZero().release()));
+          }
+          if (producer_ == nullptr) {
+            producer_ = MakeRefCounted<OrcaProducer>(subchannel->Ref());
+            *producer = producer_.get();
+            created = true;
+          }
+        });
+    // Watching the subchannel takes its lock, which is held while the
+    // callback above runs.
+    if (created) producer_->Start();
+    producer_->AddWatcher(this);
+  }
+
+ private:
+  const grpc_millis report_interval_;
+  std::unique_ptr<OobBackendMetricWatcher> watcher_;
+  RefCountedPtr<OrcaProducer> producer_;
+};
+
+//
+// OrcaProducer::ConnectivityWatcher
+//
+
+class OrcaProducer::ConnectivityWatcher
+    : public Subchannel::ConnectivityStateWatcherInterface {
+ public:
+  explicit ConnectivityWatcher(WeakRefCountedPtr<OrcaProducer> producer)
+      : producer_(std::move(producer)) {}
+
+  void OnConnectivityStateChange() override {
+    producer_->OnConnectivityStateChange(PopConnectivityStateChange().state);
+  }
+
+  grpc_pollset_set* interested_parties() override {
+    return producer_->interested_parties_;
+  }
+
+ private:
+  WeakRefCountedPtr<OrcaProducer> producer_;
+};
+
+//
+// OrcaProducer::OrcaStreamClient
+//
+
+// Runs the StreamCoreMetrics call on one connection, retrying with backoff
+// if it fails.  Modeled on HealthCheckClient.
+class OrcaProducer::OrcaStreamClient
+    : public InternallyRefCounted<OrcaStreamClient> {
+ public:
+  OrcaStreamClient(WeakRefCountedPtr<OrcaProducer> producer,
+                   RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+                   grpc_millis report_interval);
+  ~OrcaStreamClient() override;
+
+  void Orphan() override;
+
+ private:
+  // Contains a call to the backend and all the data related to the call.
+  class CallState : public Orphanable {
+   public:
+    explicit CallState(RefCountedPtr<OrcaStreamClient> stream_client);
+    ~CallState() override;
+
+    void Orphan() override;
+
+    void StartCall() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&OrcaStreamClient::mu_);
+
+   private:
+    void Cancel();
+
+    void StartBatch(grpc_transport_stream_op_batch* batch);
+    static void StartBatchInCallCombiner(void* arg, grpc_error_handle error);
+
+    void CallEndedLocked(bool retry)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(stream_client_->mu_);
+
+    static void OnComplete(void* arg, grpc_error_handle error);
+    static void RecvInitialMetadataReady(void* arg, grpc_error_handle error);
+    static void RecvMessageReady(void* arg, grpc_error_handle error);
+    static void RecvTrailingMetadataReady(void* arg, grpc_error_handle error);
+    static void StartCancel(void* arg, grpc_error_handle error);
+    static void OnCancelComplete(void* arg, grpc_error_handle error);
+
+    static void OnByteStreamNext(void* arg, grpc_error_handle error);
+    void ContinueReadingRecvMessage();
+    grpc_error_handle PullSliceFromRecvMessage();
+    void DoneReadingRecvMessage(grpc_error_handle error);
+
+    static void AfterCallStackDestruction(void* arg, grpc_error_handle error);
+
+    RefCountedPtr<OrcaStreamClient> stream_client_;
+    grpc_polling_entity pollent_;
+
+    Arena* arena_;
+    CallCombiner call_combiner_;
+    grpc_call_context_element context_[GRPC_CONTEXT_COUNT] = {};
+
+    // The streaming call to the backend. Always non-null.
+    // Refs are tracked manually; when the last ref is released, the
+    // CallState object will be automatically destroyed.
+    SubchannelCall* call_;
+
+    grpc_transport_stream_op_batch_payload payload_;
+    grpc_transport_stream_op_batch batch_;
+    grpc_transport_stream_op_batch recv_message_batch_;
+    grpc_transport_stream_op_batch recv_trailing_metadata_batch_;
+
+    grpc_closure on_complete_;
+
+    // send_initial_metadata
+    grpc_metadata_batch send_initial_metadata_;
+    grpc_linked_mdelem path_metadata_storage_;
+
+    // send_message
+    ManualConstructor<SliceBufferByteStream> send_message_;
+
+    // send_trailing_metadata
+    grpc_metadata_batch send_trailing_metadata_;
+
+    // recv_initial_metadata
+    grpc_metadata_batch recv_initial_metadata_;
+    grpc_closure recv_initial_metadata_ready_;
+
+    // recv_message
+    OrphanablePtr<ByteStream> recv_message_;
+    grpc_closure recv_message_ready_;
+    grpc_slice_buffer recv_message_buffer_;
+    std::atomic<bool> seen_response_{false};
+
+    // True if the cancel_stream batch has been started.
+    std::atomic<bool> cancelled_{false};
+
+    // recv_trailing_metadata
+    grpc_metadata_batch recv_trailing_metadata_;
+    grpc_transport_stream_stats collect_stats_;
+    grpc_closure recv_trailing_metadata_ready_;
+
+    // Closure for call stack destruction.
+    grpc_closure after_call_stack_destruction_;
+  };
+
+  void StartCallLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  void StartRetryTimerLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  static void OnRetryTimer(void* arg, grpc_error_handle error);
+
+  WeakRefCountedPtr<OrcaProducer> producer_;
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
+  const grpc_millis report_interval_;
+
+  Mutex mu_;
+  bool shutting_down_ ABSL_GUARDED_BY(mu_) = false;
+
+  // The data associated with the current call.  It holds a ref to this
+  // OrcaStreamClient object.
+  OrphanablePtr<CallState> call_state_ ABSL_GUARDED_BY(mu_);
+
+  // Call retry state.
+  BackOff retry_backoff_ ABSL_GUARDED_BY(mu_);
+  grpc_timer retry_timer_ ABSL_GUARDED_BY(mu_);
+  grpc_closure retry_timer_callback_ ABSL_GUARDED_BY(mu_);
+  bool retry_timer_callback_pending_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+//
+// OrcaProducer
+//
+
+OrcaProducer::OrcaProducer(RefCountedPtr<Subchannel> subchannel)
+    : subchannel_(std::move(subchannel)),
+      interested_parties_(grpc_pollset_set_create()) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO, "OrcaProducer %p: created for subchannel %p", this,
+            subchannel_.get());
+  }
+}
+
+OrcaProducer::~OrcaProducer() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO, "OrcaProducer %p: destroying", this);
+  }
+  grpc_pollset_set_destroy(interested_parties_);
+}
+
+void OrcaProducer::Start() {
+  auto connectivity_watcher =
+      MakeRefCounted<ConnectivityWatcher>(WeakRefAsOrcaProducer());
+  connectivity_watcher_ = connectivity_watcher.get();
+  subchannel_->WatchConnectivityState(GRPC_CHANNEL_IDLE,
+                                      /*health_check_service_name=*/
+                                      absl::nullopt,
+                                      std::move(connectivity_watcher));
+}
+
+void OrcaProducer::Orphan() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO, "OrcaProducer %p: shutting down", this);
+  }
+  {
+    MutexLock lock(&mu_);
+    shutting_down_ = true;
+    stream_client_.reset();
+    connected_subchannel_.reset();
+  }
+  subchannel_->CancelConnectivityStateWatch(absl::nullopt,
+                                            connectivity_watcher_);
+  subchannel_->RemoveDataProducer(this);
+}
+
+void OrcaProducer::AddWatcher(OrcaWatcher* watcher) {
+  MutexLock lock(&mu_);
+  watchers_.insert(watcher);
+  if (watcher->report_interval() < report_interval_) {
+    report_interval_ = watcher->report_interval();
+    MaybeStartStreamLocked();
+  }
+}
+
+void OrcaProducer::RemoveWatcher(OrcaWatcher* watcher) {
+  MutexLock lock(&mu_);
+  watchers_.erase(watcher);
+  // The producer is about to be orphaned.
+  if (watchers_.empty()) return;
+  grpc_millis report_interval = GRPC_MILLIS_INF_FUTURE;
+  for (OrcaWatcher* w : watchers_) {
+    report_interval = std::min(report_interval, w->report_interval());
+  }
+  if (report_interval != report_interval_) {
+    report_interval_ = report_interval;
+    MaybeStartStreamLocked();
+  }
+}
+
+void OrcaProducer::MaybeStartStreamLocked() {
+  if (connected_subchannel_ == nullptr) return;
+  stream_client_ = MakeOrphanable<OrcaStreamClient>(
+      WeakRefAsOrcaProducer(), connected_subchannel_, report_interval_);
+}
+
+void OrcaProducer::OnConnectivityStateChange(grpc_connectivity_state state) {
+  MutexLock lock(&mu_);
+  if (shutting_down_) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO, "OrcaProducer %p: subchannel state %s", this,
+            ConnectivityStateName(state));
+  }
+  if (state == GRPC_CHANNEL_READY) {
+    connected_subchannel_ = subchannel_->connected_subchannel();
+    if (!watchers_.empty()) MaybeStartStreamLocked();
+  } else {
+    stream_client_.reset();
+    connected_subchannel_.reset();
+  }
+}
+
+void OrcaProducer::NotifyWatchers(
+    const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData&
+        backend_metric_data) {
+  MutexLock lock(&mu_);
+  for (OrcaWatcher* watcher : watchers_) {
+    watcher->watcher()->OnBackendMetricReport(backend_metric_data);
+  }
+}
+
+//
+// OrcaProducer::OrcaStreamClient
+//
+
+OrcaProducer::OrcaStreamClient::OrcaStreamClient(
+    WeakRefCountedPtr<OrcaProducer> producer,
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    grpc_millis report_interval)
+    : InternallyRefCounted<OrcaStreamClient>(
+          GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace) ? "OrcaStreamClient"
+                                                          : nullptr),
+      producer_(std::move(producer)),
+      connected_subchannel_(std::move(connected_subchannel)),
+      report_interval_(report_interval),
+      retry_backoff_(
+          BackOff::Options()
+              .set_initial_backoff(ORCA_INITIAL_CONNECT_BACKOFF_SECONDS * 1000)
+              .set_multiplier(ORCA_RECONNECT_BACKOFF_MULTIPLIER)
+              .set_jitter(ORCA_RECONNECT_JITTER)
+              .set_max_backoff(ORCA_RECONNECT_MAX_BACKOFF_SECONDS * 1000)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO,
+            "OrcaStreamClient %p: created for producer %p, report interval "
+            "%" PRId64 "ms",
+            this, producer_.get(), report_interval_);
+  }
+  GRPC_CLOSURE_INIT(&retry_timer_callback_, OnRetryTimer, this,
+                    grpc_schedule_on_exec_ctx);
+  MutexLock lock(&mu_);
+  StartCallLocked();
+}
+
+OrcaProducer::OrcaStreamClient::~OrcaStreamClient() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO, "OrcaStreamClient %p: destroying", this);
+  }
+}
+
+void OrcaProducer::OrcaStreamClient::Orphan() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO, "OrcaStreamClient %p: shutting down", this);
+  }
+  {
+    MutexLock lock(&mu_);
+    shutting_down_ = true;
+    call_state_.reset();
+    if (retry_timer_callback_pending_) {
+      grpc_timer_cancel(&retry_timer_);
+    }
+  }
+  Unref(DEBUG_LOCATION, "orphan");
+}
+
+void OrcaProducer::OrcaStreamClient::StartCallLocked() {
+  if (shutting_down_) return;
+  GPR_ASSERT(call_state_ == nullptr);
+  call_state_ = MakeOrphanable<CallState>(Ref());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO, "OrcaStreamClient %p: created CallState %p", this,
+            call_state_.get());
+  }
+  call_state_->StartCall();
+}
+
+void OrcaProducer::OrcaStreamClient::StartRetryTimerLocked() {
+  grpc_millis next_try = retry_backoff_.NextAttemptTime();
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO,
+            "OrcaStreamClient %p: call lost; will retry in %" PRId64 "ms",
+            this, std::max<grpc_millis>(0, next_try - ExecCtx::Get()->Now()));
+  }
+  // Ref for callback, tracked manually.
+  Ref(DEBUG_LOCATION, "orca_retry_timer").release();
+  retry_timer_callback_pending_ = true;
+  grpc_timer_init(&retry_timer_, next_try, &retry_timer_callback_);
+}
+
+void OrcaProducer::OrcaStreamClient::OnRetryTimer(void* arg,
+                                                  grpc_error_handle error) {
+  OrcaStreamClient* self = static_cast<OrcaStreamClient*>(arg);
+  {
+    MutexLock lock(&self->mu_);
+    self->retry_timer_callback_pending_ = false;
+    if (!self->shutting_down_ && error == GRPC_ERROR_NONE &&
+        self->call_state_ == nullptr) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+        gpr_log(GPR_INFO, "OrcaStreamClient %p: restarting call", self);
+      }
+      self->StartCallLocked();
+    }
+  }
+  self->Unref(DEBUG_LOCATION, "orca_retry_timer");
+}
+
+//
+// protobuf helpers
+//
+
+void EncodeRequest(grpc_millis report_interval,
+                   ManualConstructor<SliceBufferByteStream>* send_message) {
+  upb::Arena arena;
+  xds_service_orca_v3_OrcaLoadReportRequest* request =
+      xds_service_orca_v3_OrcaLoadReportRequest_new(arena.ptr());
+  google_protobuf_Duration* interval =
+      xds_service_orca_v3_OrcaLoadReportRequest_mutable_report_interval(
+          request, arena.ptr());
+  google_protobuf_Duration_set_seconds(interval,
+                                       report_interval / GPR_MS_PER_SEC);
+  google_protobuf_Duration_set_nanos(
+      interval, static_cast<int32_t>(report_interval % GPR_MS_PER_SEC) *
+                    GPR_NS_PER_MS);
+  size_t buf_length;
+  char* buf = xds_service_orca_v3_OrcaLoadReportRequest_serialize(
+      request, arena.ptr(), &buf_length);
+  grpc_slice request_slice = GRPC_SLICE_MALLOC(buf_length);
+  memcpy(GRPC_SLICE_START_PTR(request_slice), buf, buf_length);
+  grpc_slice_buffer slice_buffer;
+  grpc_slice_buffer_init(&slice_buffer);
+  grpc_slice_buffer_add(&slice_buffer, request_slice);
+  send_message->Init(&slice_buffer, 0);
+  grpc_slice_buffer_destroy_internal(&slice_buffer);
+}
+
+//
+// OrcaProducer::OrcaStreamClient::CallState
+//
+
+OrcaProducer::OrcaStreamClient::CallState::CallState(
+    RefCountedPtr<OrcaStreamClient> stream_client)
+    : stream_client_(std::move(stream_client)),
+      pollent_(grpc_polling_entity_create_from_pollset_set(
+          stream_client_->producer_->interested_parties_)),
+      arena_(Arena::Create(
+          stream_client_->connected_subchannel_->GetInitialCallSizeEstimate())),
+      payload_(context_),
+      send_initial_metadata_(arena_),
+      send_trailing_metadata_(arena_),
+      recv_initial_metadata_(arena_),
+      recv_trailing_metadata_(arena_) {}
+
+OrcaProducer::OrcaStreamClient::CallState::~CallState() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO, "OrcaStreamClient %p: destroying CallState %p",
+            stream_client_.get(), this);
+  }
+  for (size_t i = 0; i < GRPC_CONTEXT_COUNT; i++) {
+    if (context_[i].destroy != nullptr) {
+      context_[i].destroy(context_[i].value);
+    }
+  }
+  // Unset the call combiner cancellation closure.  This has the
+  // effect of scheduling the previously set cancellation closure, if
+  // any, so that it can release any internal references it may be
+  // holding to the call stack.
+  call_combiner_.SetNotifyOnCancel(nullptr);
+  arena_->Destroy();
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::Orphan() {
+  call_combiner_.Cancel(GRPC_ERROR_CANCELLED);
+  Cancel();
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::StartCall() {
+  const grpc_slice path = grpc_slice_from_static_string(kOrcaStreamMethod);
+  SubchannelCall::Args args = {
+      stream_client_->connected_subchannel_,
+      &pollent_,
+      path,
+      gpr_get_cycle_counter(),  // start_time
+      GRPC_MILLIS_INF_FUTURE,   // deadline
+      arena_,
+      context_,
+      &call_combiner_,
+  };
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  call_ = SubchannelCall::Create(std::move(args), &error).release();
+  // Register after-destruction callback.
+  GRPC_CLOSURE_INIT(&after_call_stack_destruction_, AfterCallStackDestruction,
+                    this, grpc_schedule_on_exec_ctx);
+  call_->SetAfterCallStackDestroy(&after_call_stack_destruction_);
+  // Check if creation failed.
+  if (error != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR,
+            "OrcaStreamClient %p CallState %p: error creating ORCA stream "
+            "on subchannel (%s); will retry",
+            stream_client_.get(), this, grpc_error_std_string(error).c_str());
+    GRPC_ERROR_UNREF(error);
+    CallEndedLocked(/*retry=*/true);
+    return;
+  }
+  // Initialize payload and batch.
+  payload_.context = context_;
+  batch_.payload = &payload_;
+  // on_complete callback takes ref, handled manually.
+  call_->Ref(DEBUG_LOCATION, "on_complete").release();
+  batch_.on_complete = GRPC_CLOSURE_INIT(&on_complete_, OnComplete, this,
+                                         grpc_schedule_on_exec_ctx);
+  // Add send_initial_metadata op.
+  error = grpc_metadata_batch_add_head(
+      &send_initial_metadata_, &path_metadata_storage_,
+      grpc_mdelem_from_slices(GRPC_MDSTR_PATH, path), GRPC_BATCH_PATH);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  payload_.send_initial_metadata.send_initial_metadata =
+      &send_initial_metadata_;
+  payload_.send_initial_metadata.send_initial_metadata_flags = 0;
+  payload_.send_initial_metadata.peer_string = nullptr;
+  batch_.send_initial_metadata = true;
+  // Add send_message op.
+  EncodeRequest(stream_client_->report_interval_, &send_message_);
+  payload_.send_message.send_message.reset(send_message_.get());
+  batch_.send_message = true;
+  // Add send_trailing_metadata op.
+  payload_.send_trailing_metadata.send_trailing_metadata =
+      &send_trailing_metadata_;
+  batch_.send_trailing_metadata = true;
+  // Add recv_initial_metadata op.
+  payload_.recv_initial_metadata.recv_initial_metadata =
+      &recv_initial_metadata_;
+  payload_.recv_initial_metadata.recv_flags = nullptr;
+  payload_.recv_initial_metadata.trailing_metadata_available = nullptr;
+  payload_.recv_initial_metadata.peer_string = nullptr;
+  // recv_initial_metadata_ready callback takes ref, handled manually.
+  call_->Ref(DEBUG_LOCATION, "recv_initial_metadata_ready").release();
+  payload_.recv_initial_metadata.recv_initial_metadata_ready =
+      GRPC_CLOSURE_INIT(&recv_initial_metadata_ready_, RecvInitialMetadataReady,
+                        this, grpc_schedule_on_exec_ctx);
+  batch_.recv_initial_metadata = true;
+  // Add recv_message op.
+  payload_.recv_message.recv_message = &recv_message_;
+  payload_.recv_message.call_failed_before_recv_message = nullptr;
+  // recv_message callback takes ref, handled manually.
+  call_->Ref(DEBUG_LOCATION, "recv_message_ready").release();
+  payload_.recv_message.recv_message_ready = GRPC_CLOSURE_INIT(
+      &recv_message_ready_, RecvMessageReady, this, grpc_schedule_on_exec_ctx);
+  batch_.recv_message = true;
+  // Start batch.
+  StartBatch(&batch_);
+  // Initialize recv_trailing_metadata batch.
+  recv_trailing_metadata_batch_.payload = &payload_;
+  // Add recv_trailing_metadata op.
+  payload_.recv_trailing_metadata.recv_trailing_metadata =
+      &recv_trailing_metadata_;
+  payload_.recv_trailing_metadata.collect_stats = &collect_stats_;
+  // This callback signals the end of the call, so it relies on the
+  // initial ref instead of taking a new ref.  When it's invoked, the
+  // initial ref is released.
+  payload_.recv_trailing_metadata.recv_trailing_metadata_ready =
+      GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready_,
+                        RecvTrailingMetadataReady, this,
+                        grpc_schedule_on_exec_ctx);
+  recv_trailing_metadata_batch_.recv_trailing_metadata = true;
+  // Start recv_trailing_metadata batch.
+  StartBatch(&recv_trailing_metadata_batch_);
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::StartBatchInCallCombiner(
+    void* arg, grpc_error_handle /*error*/) {
+  grpc_transport_stream_op_batch* batch =
+      static_cast<grpc_transport_stream_op_batch*>(arg);
+  SubchannelCall* call =
+      static_cast<SubchannelCall*>(batch->handler_private.extra_arg);
+  call->StartTransportStreamOpBatch(batch);
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::StartBatch(
+    grpc_transport_stream_op_batch* batch) {
+  batch->handler_private.extra_arg = call_;
+  GRPC_CLOSURE_INIT(&batch->handler_private.closure, StartBatchInCallCombiner,
+                    batch, grpc_schedule_on_exec_ctx);
+  GRPC_CALL_COMBINER_START(&call_combiner_, &batch->handler_private.closure,
+                           GRPC_ERROR_NONE, "start_subchannel_batch");
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::AfterCallStackDestruction(
+    void* arg, grpc_error_handle /*error*/) {
+  delete static_cast<CallState*>(arg);
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::OnCancelComplete(
+    void* arg, grpc_error_handle /*error*/) {
+  CallState* self = static_cast<CallState*>(arg);
+  GRPC_CALL_COMBINER_STOP(&self->call_combiner_, "orca_cancel");
+  self->call_->Unref(DEBUG_LOCATION, "cancel");
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::StartCancel(
+    void* arg, grpc_error_handle /*error*/) {
+  CallState* self = static_cast<CallState*>(arg);
+  auto* batch = grpc_make_transport_stream_op(
+      GRPC_CLOSURE_CREATE(OnCancelComplete, self, grpc_schedule_on_exec_ctx));
+  batch->cancel_stream = true;
+  batch->payload->cancel_stream.cancel_error = GRPC_ERROR_CANCELLED;
+  self->call_->StartTransportStreamOpBatch(batch);
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::Cancel() {
+  bool expected = false;
+  if (cancelled_.compare_exchange_strong(expected, true,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+    call_->Ref(DEBUG_LOCATION, "cancel").release();
+    GRPC_CALL_COMBINER_START(
+        &call_combiner_,
+        GRPC_CLOSURE_CREATE(StartCancel, this, grpc_schedule_on_exec_ctx),
+        GRPC_ERROR_NONE, "orca_cancel");
+  }
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::OnComplete(
+    void* arg, grpc_error_handle /*error*/) {
+  CallState* self = static_cast<CallState*>(arg);
+  GRPC_CALL_COMBINER_STOP(&self->call_combiner_, "on_complete");
+  self->send_initial_metadata_.Clear();
+  self->send_trailing_metadata_.Clear();
+  self->call_->Unref(DEBUG_LOCATION, "on_complete");
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::RecvInitialMetadataReady(
+    void* arg, grpc_error_handle /*error*/) {
+  CallState* self = static_cast<CallState*>(arg);
+  GRPC_CALL_COMBINER_STOP(&self->call_combiner_, "recv_initial_metadata_ready");
+  self->recv_initial_metadata_.Clear();
+  self->call_->Unref(DEBUG_LOCATION, "recv_initial_metadata_ready");
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::DoneReadingRecvMessage(
+    grpc_error_handle error) {
+  recv_message_.reset();
+  if (error != GRPC_ERROR_NONE) {
+    GRPC_ERROR_UNREF(error);
+    Cancel();
+    grpc_slice_buffer_destroy_internal(&recv_message_buffer_);
+    call_->Unref(DEBUG_LOCATION, "recv_message_ready");
+    return;
+  }
+  // The parsed report points into a scratch arena, which is released
+  // once the watchers have seen it.
+  grpc_slice serialized_load_report;
+  if (recv_message_buffer_.count == 1) {
+    serialized_load_report =
+        grpc_slice_ref_internal(recv_message_buffer_.slices[0]);
+  } else {
+    serialized_load_report = GRPC_SLICE_MALLOC(recv_message_buffer_.length);
+    grpc_slice_buffer_move_first_into_buffer(
+        &recv_message_buffer_, recv_message_buffer_.length,
+        GRPC_SLICE_START_PTR(serialized_load_report));
+  }
+  Arena* arena = Arena::Create(1024);
+  const auto* backend_metric_data =
+      ParseBackendMetricData(serialized_load_report, arena);
+  if (backend_metric_data != nullptr) {
+    stream_client_->producer_->NotifyWatchers(*backend_metric_data);
+  } else {
+    gpr_log(GPR_ERROR,
+            "OrcaStreamClient %p CallState %p: cannot parse load report",
+            stream_client_.get(), this);
+  }
+  arena->Destroy();
+  grpc_slice_unref_internal(serialized_load_report);
+  seen_response_.store(true, std::memory_order_release);
+  grpc_slice_buffer_destroy_internal(&recv_message_buffer_);
+  // Start another recv_message batch.
+  // This re-uses the ref we're holding.
+  // Note: Can't just reuse batch_ here, since we don't know that all
+  // callbacks from the original batch have completed yet.
+  recv_message_batch_.payload = &payload_;
+  payload_.recv_message.recv_message = &recv_message_;
+  payload_.recv_message.call_failed_before_recv_message = nullptr;
+  payload_.recv_message.recv_message_ready = GRPC_CLOSURE_INIT(
+      &recv_message_ready_, RecvMessageReady, this, grpc_schedule_on_exec_ctx);
+  recv_message_batch_.recv_message = true;
+  StartBatch(&recv_message_batch_);
+}
+
+grpc_error_handle
+OrcaProducer::OrcaStreamClient::CallState::PullSliceFromRecvMessage() {
+  grpc_slice slice;
+  grpc_error_handle error = recv_message_->Pull(&slice);
+  if (error == GRPC_ERROR_NONE) {
+    grpc_slice_buffer_add(&recv_message_buffer_, slice);
+  }
+  return error;
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::ContinueReadingRecvMessage() {
+  while (recv_message_->Next(SIZE_MAX, &recv_message_ready_)) {
+    grpc_error_handle error = PullSliceFromRecvMessage();
+    if (error != GRPC_ERROR_NONE) {
+      DoneReadingRecvMessage(error);
+      return;
+    }
+    if (recv_message_buffer_.length == recv_message_->length()) {
+      DoneReadingRecvMessage(GRPC_ERROR_NONE);
+      break;
+    }
+  }
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::OnByteStreamNext(
+    void* arg, grpc_error_handle error) {
+  CallState* self = static_cast<CallState*>(arg);
+  if (error != GRPC_ERROR_NONE) {
+    self->DoneReadingRecvMessage(GRPC_ERROR_REF(error));
+    return;
+  }
+  error = self->PullSliceFromRecvMessage();
+  if (error != GRPC_ERROR_NONE) {
+    self->DoneReadingRecvMessage(error);
+    return;
+  }
+  if (self->recv_message_buffer_.length == self->recv_message_->length()) {
+    self->DoneReadingRecvMessage(GRPC_ERROR_NONE);
+  } else {
+    self->ContinueReadingRecvMessage();
+  }
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::RecvMessageReady(
+    void* arg, grpc_error_handle /*error*/) {
+  CallState* self = static_cast<CallState*>(arg);
+  GRPC_CALL_COMBINER_STOP(&self->call_combiner_, "recv_message_ready");
+  if (self->recv_message_ == nullptr) {
+    self->call_->Unref(DEBUG_LOCATION, "recv_message_ready");
+    return;
+  }
+  grpc_slice_buffer_init(&self->recv_message_buffer_);
+  // A report with every field unset is an empty message, and an empty byte
+  // stream must not be read from.
+  if (self->recv_message_->length() == 0) {
+    self->DoneReadingRecvMessage(GRPC_ERROR_NONE);
+    return;
+  }
+  GRPC_CLOSURE_INIT(&self->recv_message_ready_, OnByteStreamNext, self,
+                    grpc_schedule_on_exec_ctx);
+  self->ContinueReadingRecvMessage();
+  // Ref will continue to be held until we finish draining the byte stream.
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::RecvTrailingMetadataReady(
+    void* arg, grpc_error_handle error) {
+  CallState* self = static_cast<CallState*>(arg);
+  GRPC_CALL_COMBINER_STOP(&self->call_combiner_,
+                          "recv_trailing_metadata_ready");
+  // Get call status.
+  grpc_status_code status = GRPC_STATUS_UNKNOWN;
+  if (error != GRPC_ERROR_NONE) {
+    grpc_error_get_status(error, GRPC_MILLIS_INF_FUTURE, &status,
+                          nullptr /* slice */, nullptr /* http_error */,
+                          nullptr /* error_string */);
+  } else if (self->recv_trailing_metadata_.legacy_index()->named.grpc_status !=
+             nullptr) {
+    status = grpc_get_status_code_from_metadata(
+        self->recv_trailing_metadata_.legacy_index()->named.grpc_status->md);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace)) {
+    gpr_log(GPR_INFO,
+            "OrcaStreamClient %p CallState %p: ORCA stream ended with "
+            "status %d",
+            self->stream_client_.get(), self, status);
+  }
+  // Clean up.
+  self->recv_trailing_metadata_.Clear();
+  // For status UNIMPLEMENTED, the backend does not serve ORCA; stop asking.
+  // The LB policies fall back to whatever data they have without it.
+  bool retry = true;
+  if (status == GRPC_STATUS_UNIMPLEMENTED) {
+    gpr_log(GPR_ERROR,
+            "OrcaStreamClient %p: ORCA StreamCoreMetrics method returned "
+            "UNIMPLEMENTED; no out-of-band load reports will be received",
+            self->stream_client_.get());
+    retry = false;
+  }
+  MutexLock lock(&self->stream_client_->mu_);
+  self->CallEndedLocked(retry);
+}
+
+void OrcaProducer::OrcaStreamClient::CallState::CallEndedLocked(bool retry) {
+  // If this CallState is still in use, this call ended because of a failure,
+  // so we need to stop using it and optionally create a new one.
+  // Otherwise, we have deliberately ended this call, and no further action
+  // is required.
+  if (this == stream_client_->call_state_.get()) {
+    stream_client_->call_state_.reset();
+    if (retry) {
+      GPR_ASSERT(!stream_client_->shutting_down_);
+      if (seen_response_.load(std::memory_order_acquire)) {
+        // If the call fails after we've gotten a successful response, reset
+        // the backoff and restart the call immediately.
+        stream_client_->retry_backoff_.Reset();
+        stream_client_->StartCallLocked();
+      } else {
+        // If the call failed without receiving any messages, retry later.
+        stream_client_->StartRetryTimerLocked();
+      }
+    }
+  }
+  // When the last ref to the call stack goes away, the CallState object
+  // will be automatically destroyed.
+  call_->Unref(DEBUG_LOCATION, "call_ended");
+}
+
+}  // namespace
+
+std::unique_ptr<SubchannelInterface::DataWatcherInterface>
+MakeOobBackendMetricWatcher(grpc_millis report_interval,
+                            std::unique_ptr<OobBackendMetricWatcher> watcher) {
+  return absl::make_unique<OrcaWatcher>(report_interval, std::move(watcher));
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,60 @@
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OOB_BACKEND_METRIC_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OOB_BACKEND_METRIC_H
+
+#include <grpc/support/port_platform.h>
+
+#include <memory>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+// Interface for LB policies to access out-of-band backend metric data from
+// a subchannel.  The data is streamed by the backend over an ORCA
+// (xds.service.orca.v3.OpenRcaService) StreamCoreMetrics call, so that it
+// keeps arriving while the LB policy sends no calls to the backend.
+// Only one stream is opened per subchannel, however many channels and
+// watchers ask for it; it runs while the subchannel is READY.
+class OobBackendMetricWatcher {
+ public:
+  virtual ~OobBackendMetricWatcher() = default;
+
+  // Invoked with each load report received from the backend.  May be
+  // invoked from any thread, not in the LB policy's WorkSerializer, so
+  // implementations must do their own synchronization, and must copy
+  // anything they need out of backend_metric_data before returning.
+  virtual void OnBackendMetricReport(
+      const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData&
+          backend_metric_data) = 0;
+};
+
+// Returns a data watcher to be passed to
+// SubchannelInterface::AddDataWatcher() that delivers the subchannel's
+// out-of-band backend metrics to watcher.  The backend is asked to report
+// every report_interval; when a subchannel has several watchers, it
+// reports at the shortest interval any of them asks for.
+std::unique_ptr<SubchannelInterface::DataWatcherInterface>
+MakeOobBackendMetricWatcher(grpc_millis report_interval,
+                            std::unique_ptr<OobBackendMetricWatcher> watcher);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OOB_BACKEND_METRIC_H
@@ -0,0 +1,54 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/pick_random.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gpr/tls.h"
+
+namespace grpc_core {
+
+namespace {
+
+// State of this thread's xorshift64 generator; zero until first used.
+GPR_THREAD_LOCAL(uint64_t) g_pick_random_state;
+
+}  // namespace
+
+uint64_t PickRandom() {
+  uint64_t x = g_pick_random_state;
+  if (GPR_UNLIKELY(x == 0)) {
+    // First use on this thread: seed from the clock and the stack address,
+    // which differ between threads started at the same time.
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    x = (static_cast<uint64_t>(now.tv_sec) << 32) ^
+        static_cast<uint64_t>(now.tv_nsec) ^
+        static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&now));
+    if (x == 0) x = 1;
+  }
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  g_pick_random_state = x;
+  return x;
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,36 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_PICK_RANDOM_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_PICK_RANDOM_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+namespace grpc_core {
+
+// Returns a pseudo-random number for choices made on every call, such as
+// picks and drops. Pickers and config selectors run concurrently, so unlike
+// rand() this keeps its generator per thread and never takes a lock. The
+// numbers are not suitable for anything that must be unpredictable.
+uint64_t PickRandom();
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_PICK_RANDOM_H
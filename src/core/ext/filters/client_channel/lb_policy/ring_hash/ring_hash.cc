@@ -16,11 +16,22 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <map>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
 #define XXH_INLINE_ALL
 #include "xxhash.h"
 
@@ -33,6 +44,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/transport/connectivity_state.h"
@@ -45,11 +57,9 @@ const char* kRequestRingHashAttribute = "request_ring_hash";
 TraceFlag grpc_lb_ring_hash_trace(false, "ring_hash_lb");
 
 // Helper Parser method
-void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
-                           size_t* max_ring_size,
+void ParseRingHashLbConfig(const Json& json, RingHashLbParams* params,
                            std::vector<grpc_error_handle>* error_list) {
-  *min_ring_size = 1024;
-  *max_ring_size = 8388608;
+  *params = RingHashLbParams();
   if (json.type() != Json::Type::OBJECT) {
     error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "ring_hash_experimental should be of type object"));
@@ -62,7 +72,7 @@ void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
       error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
           "field:min_ring_size error: should be of type number"));
     } else {
-      *min_ring_size = gpr_parse_nonnegative_int(
+      params->min_ring_size = gpr_parse_nonnegative_int(
           ring_hash_it->second.string_value().c_str());
     }
   }
@@ -72,35 +82,430 @@ void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
       error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
           "field:max_ring_size error: should be of type number"));
     } else {
-      *max_ring_size = gpr_parse_nonnegative_int(
+      params->max_ring_size = gpr_parse_nonnegative_int(
           ring_hash_it->second.string_value().c_str());
     }
   }
-  if (*min_ring_size == 0 || *min_ring_size > 8388608 || *max_ring_size == 0 ||
-      *max_ring_size > 8388608 || *min_ring_size > *max_ring_size) {
+  if (params->min_ring_size == 0 || params->min_ring_size > 8388608 ||
+      params->max_ring_size == 0 || params->max_ring_size > 8388608 ||
+      params->min_ring_size > params->max_ring_size) {
     error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "field:max_ring_size and or min_ring_size error: "
         "values need to be in the range of 1 to 8388608 "
         "and max_ring_size cannot be smaller than "
         "min_ring_size"));
   }
+  ring_hash_it = ring_hash.find("lookup_table");
+  if (ring_hash_it != ring_hash.end()) {
+    if (ring_hash_it->second.type() != Json::Type::STRING) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:lookup_table error: should be of type string"));
+    } else if (ring_hash_it->second.string_value() == "ring") {
+      params->lookup_table = RingHashLbParams::LookupTable::kRing;
+    } else if (ring_hash_it->second.string_value() == "maglev") {
+      params->lookup_table = RingHashLbParams::LookupTable::kMaglev;
+    } else {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:lookup_table error: should be \"ring\" or \"maglev\""));
+    }
+  }
+  ring_hash_it = ring_hash.find("maglev_table_size");
+  if (ring_hash_it != ring_hash.end()) {
+    if (ring_hash_it->second.type() != Json::Type::NUMBER) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:maglev_table_size error: should be of type number"));
+    } else {
+      const int value = gpr_parse_nonnegative_int(
+          ring_hash_it->second.string_value().c_str());
+      bool prime = value >= 2;
+      for (int i = 2; prime && i <= value / i; ++i) {
+        if (value % i == 0) prime = false;
+      }
+      if (!prime ||
+          static_cast<size_t>(value) > kRingHashMaxMaglevTableSize) {
+        error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:maglev_table_size error: should be a prime number no "
+            "larger than 5000011"));
+      } else {
+        params->maglev_table_size = value;
+      }
+    }
+  }
+  ring_hash_it = ring_hash.find("hash_balance_factor");
+  if (ring_hash_it != ring_hash.end()) {
+    if (ring_hash_it->second.type() != Json::Type::NUMBER) {
+      error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:hash_balance_factor error: should be of type number"));
+    } else {
+      const int value = gpr_parse_nonnegative_int(
+          ring_hash_it->second.string_value().c_str());
+      if (value < 100) {
+        error_list->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:hash_balance_factor error: should be an integer of at "
+            "least 100"));
+      } else {
+        params->hash_balance_factor = value;
+      }
+    }
+  }
+}
+
+//
+// RingHashTable
+//
+
+namespace {
+
+// A point on a ring, while the ring is being built.
+struct RingPoint {
+  uint64_t hash;
+  uint32_t endpoint;
+
+  bool operator<(const RingPoint& other) const { return hash < other.hash; }
+};
+
+// Appends the points of the endpoint at the given index with point numbers
+// from begin to end.  Each point's hash is that of "<address>_<number>".
+void AddRingPoints(const std::string& address, uint32_t index, uint32_t begin,
+                   uint32_t end, std::vector<RingPoint>* points) {
+  absl::InlinedVector<char, 196> hash_key_buffer;
+  hash_key_buffer.assign(address.begin(), address.end());
+  hash_key_buffer.emplace_back('_');
+  auto offset_start = hash_key_buffer.end();
+  for (uint32_t count = begin; count < end; ++count) {
+    const std::string count_str = absl::StrCat(count);
+    hash_key_buffer.insert(offset_start, count_str.begin(), count_str.end());
+    absl::string_view hash_key(hash_key_buffer.data(), hash_key_buffer.size());
+    const uint64_t hash = XXH64(hash_key.data(), hash_key.size(), 0);
+    points->push_back({hash, index});
+    hash_key_buffer.erase(offset_start, hash_key_buffer.end());
+  }
+}
+
+}  // namespace
+
+std::vector<uint32_t> RingHashTable::RingPointCounts(
+    const std::vector<Endpoint>& endpoints, size_t min_ring_size,
+    size_t max_ring_size) {
+  // Find the sum of the weights, then normalize them and find the smallest.
+  uint64_t sum = 0;
+  for (const Endpoint& endpoint : endpoints) sum += endpoint.weight;
+  std::vector<double> normalized_weights;
+  normalized_weights.reserve(endpoints.size());
+  double min_normalized_weight = 1.0;
+  for (const Endpoint& endpoint : endpoints) {
+    normalized_weights.push_back(static_cast<double>(endpoint.weight) / sum);
+    min_normalized_weight =
+        std::min(normalized_weights.back(), min_normalized_weight);
+  }
+  // Scale up the number of hashes per host such that the least-weighted host
+  // gets a whole number of hashes on the ring. Other hosts might not end up
+  // with whole numbers, and that's fine (the ring-building algorithm below can
+  // handle this). This preserves the original implementation's behavior: when
+  // weights aren't provided, all hosts should get an equal number of hashes. In
+  // the case where this number exceeds the max_ring_size, it's scaled back down
+  // to fit.
+  const double scale = std::min(
+      std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
+      static_cast<double>(max_ring_size));
+  // Walk through the (host, weight) pairs, giving each host (scale * weight)
+  // hashes. Since these aren't necessarily whole numbers, we maintain running
+  // sums -- current_hashes and target_hashes -- which allows us to populate the
+  // ring in a mostly stable way.
+  std::vector<uint32_t> counts;
+  counts.reserve(endpoints.size());
+  double current_hashes = 0.0;
+  double target_hashes = 0.0;
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    target_hashes += scale * normalized_weights[i];
+    uint32_t count = 0;
+    while (current_hashes < target_hashes) {
+      ++count;
+      ++current_hashes;
+    }
+    counts.push_back(count);
+  }
+  return counts;
+}
+
+RingHashTable RingHashTable::BuildRing(const std::vector<Endpoint>& endpoints,
+                                       size_t min_ring_size,
+                                       size_t max_ring_size) {
+  RingHashTable table;
+  table.point_counts_ =
+      RingPointCounts(endpoints, min_ring_size, max_ring_size);
+  size_t ring_size = 0;
+  for (uint32_t count : table.point_counts_) ring_size += count;
+  // Reserve memory for the entire ring up front.
+  std::vector<RingPoint> points;
+  points.reserve(ring_size);
+  table.addresses_.reserve(endpoints.size());
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    AddRingPoints(endpoints[i].address, i, 0, table.point_counts_[i],
+                  &points);
+    table.addresses_.push_back(endpoints[i].address);
+  }
+  std::sort(points.begin(), points.end());
+  table.hashes_.reserve(points.size());
+  table.endpoints_.reserve(points.size());
+  for (const RingPoint& point : points) {
+    table.hashes_.push_back(point.hash);
+    table.endpoints_.push_back(point.endpoint);
+  }
+  return table;
+}
+
+RingHashTable RingHashTable::UpdateRing(const RingHashTable& ring,
+                                        const std::vector<Endpoint>& endpoints,
+                                        size_t min_ring_size,
+                                        size_t max_ring_size) {
+  // Points of different endpoints with the same address would have the same
+  // hashes, which this cannot tell apart.
+  absl::flat_hash_map<absl::string_view, uint32_t> new_indexes;
+  new_indexes.reserve(endpoints.size());
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    if (!new_indexes.emplace(endpoints[i].address, i).second) {
+      return BuildRing(endpoints, min_ring_size, max_ring_size);
+    }
+  }
+  RingHashTable table;
+  table.point_counts_ =
+      RingPointCounts(endpoints, min_ring_size, max_ring_size);
+  table.addresses_.reserve(endpoints.size());
+  for (const Endpoint& endpoint : endpoints) {
+    table.addresses_.push_back(endpoint.address);
+  }
+  // Point n of an endpoint has the same hash on every ring, so an endpoint
+  // that keeps at least as many points keeps all of its old ones, and only
+  // needs its new ones hashed.  One that loses points has them all
+  // recomputed, since the old ring does not record which are which.
+  constexpr uint32_t kRemoved = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> kept_index(ring.addresses_.size(), kRemoved);
+  std::vector<uint32_t> first_new_point(endpoints.size(), 0);
+  std::vector<bool> in_old_ring(endpoints.size(), false);
+  for (size_t i = 0; i < ring.addresses_.size(); ++i) {
+    auto it = new_indexes.find(ring.addresses_[i]);
+    if (it == new_indexes.end()) continue;
+    if (in_old_ring[it->second]) {
+      return BuildRing(endpoints, min_ring_size, max_ring_size);
+    }
+    in_old_ring[it->second] = true;
+    if (table.point_counts_[it->second] < ring.point_counts_[i]) continue;
+    kept_index[i] = it->second;
+    first_new_point[it->second] = ring.point_counts_[i];
+  }
+  std::vector<RingPoint> new_points;
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    AddRingPoints(endpoints[i].address, i, first_new_point[i],
+                  table.point_counts_[i], &new_points);
+  }
+  std::sort(new_points.begin(), new_points.end());
+  // Merge the kept points, which are still in order, with the new ones.
+  const size_t ring_size = ring.size() + new_points.size();
+  table.hashes_.reserve(ring_size);
+  table.endpoints_.reserve(ring_size);
+  auto new_point = new_points.begin();
+  for (size_t slot = 0; slot < ring.size(); ++slot) {
+    const uint32_t index = kept_index[ring.endpoints_[slot]];
+    if (index == kRemoved) continue;
+    const uint64_t hash = ring.hashes_[slot];
+    for (; new_point != new_points.end() && new_point->hash < hash;
+         ++new_point) {
+      table.hashes_.push_back(new_point->hash);
+      table.endpoints_.push_back(new_point->endpoint);
+    }
+    table.hashes_.push_back(hash);
+    table.endpoints_.push_back(index);
+  }
+  for (; new_point != new_points.end(); ++new_point) {
+    table.hashes_.push_back(new_point->hash);
+    table.endpoints_.push_back(new_point->endpoint);
+  }
+  return table;
+}
+
+RingHashTable RingHashTable::BuildMaglev(
+    const std::vector<Endpoint>& endpoints, size_t table_size) {
+  RingHashTable table;
+  if (endpoints.empty()) return table;
+  // Each endpoint's preference list is the permutation of the slots
+  // (offset + next * skip) % table_size, for next = 0, 1, ...; skip is never
+  // 0, and table_size is prime, so this visits every slot.
+  struct BuildEntry {
+    uint64_t offset;
+    uint64_t skip;
+    uint64_t next = 0;
+    uint64_t weight;
+    uint64_t target_weight = 0;
+  };
+  std::vector<BuildEntry> entries;
+  entries.reserve(endpoints.size());
+  uint64_t max_weight = 0;
+  for (const Endpoint& endpoint : endpoints) {
+    BuildEntry entry;
+    entry.offset = XXH64(endpoint.address.data(), endpoint.address.size(), 0) %
+                   table_size;
+    entry.skip = XXH64(endpoint.address.data(), endpoint.address.size(), 1) %
+                     (table_size - 1) +
+                 1;
+    entry.weight = endpoint.weight;
+    max_weight = std::max(max_weight, entry.weight);
+    entries.push_back(entry);
+  }
+  // Endpoints take turns claiming the next free slot in their permutation.
+  // An endpoint of the largest weight takes a turn in every round, and one of
+  // a third of that weight in every third round.
+  constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  table.endpoints_.assign(table_size, kEmpty);
+  size_t filled = 0;
+  for (uint64_t round = 1; filled < table_size; ++round) {
+    for (size_t i = 0; i < entries.size() && filled < table_size; ++i) {
+      BuildEntry& entry = entries[i];
+      if (round * entry.weight < entry.target_weight) continue;
+      entry.target_weight += max_weight;
+      uint64_t slot;
+      do {
+        slot = (entry.offset + entry.skip * entry.next) % table_size;
+        ++entry.next;
+      } while (table.endpoints_[slot] != kEmpty);
+      table.endpoints_[slot] = static_cast<uint32_t>(i);
+      ++filled;
+    }
+  }
+  return table;
+}
+
+intptr_t RingHashEndpointCapacity(uint32_t hash_balance_factor,
+                                  intptr_t total_calls_in_flight,
+                                  size_t num_ready) {
+  const uint64_t total = std::max<intptr_t>(total_calls_in_flight, 0);
+  const uint64_t denominator = 100 * static_cast<uint64_t>(num_ready);
+  return (hash_balance_factor * (total + 1) + denominator - 1) / denominator;
+}
+
+size_t RingHashTable::FindSlot(uint64_t hash) const {
+  if (hashes_.empty()) return hash % endpoints_.size();
+  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
+  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
+  // for lowp, highp, and first_index. Do not change them!
+  int64_t lowp = 0;
+  int64_t highp = hashes_.size();
+  int64_t first_index = 0;
+  while (true) {
+    first_index = (lowp + highp) / 2;
+    if (first_index == static_cast<int64_t>(hashes_.size())) {
+      first_index = 0;
+      break;
+    }
+    uint64_t midval = hashes_[first_index];
+    uint64_t midval1 = first_index == 0 ? 0 : hashes_[first_index - 1];
+    if (hash <= midval && hash > midval1) {
+      break;
+    }
+    if (midval < hash) {
+      lowp = first_index + 1;
+    } else {
+      highp = first_index - 1;
+    }
+    if (lowp > highp) {
+      first_index = 0;
+      break;
+    }
+  }
+  return first_index;
+}
+
+size_t RingHashTable::MemoryUsage() const {
+  size_t bytes = sizeof(*this) + hashes_.capacity() * sizeof(uint64_t) +
+                 endpoints_.capacity() * sizeof(uint32_t) +
+                 addresses_.capacity() * sizeof(std::string) +
+                 point_counts_.capacity() * sizeof(uint32_t);
+  for (const std::string& address : addresses_) bytes += address.capacity();
+  return bytes;
 }
 
 namespace {
 
 constexpr char kRingHash[] = "ring_hash_experimental";
 
+//
+// SharedRingHashTable
+//
+
+// An immutable lookup table, shared by every ring_hash policy in the process
+// whose config and endpoints give the same key, so that channels to the same
+// backends build it only once.  Cached only while some policy holds a ref.
+class SharedRingHashTable : public RefCounted<SharedRingHashTable> {
+ public:
+  SharedRingHashTable(std::string key, RingHashTable table)
+      : key_(std::move(key)), table_(std::move(table)) {}
+  ~SharedRingHashTable() override;
+
+  // Returns the cached table for key, or null.
+  static RefCountedPtr<SharedRingHashTable> Get(const std::string& key);
+  // Caches table under key, unless another policy has cached one for the
+  // same key since Get() missed; returns the cached table.
+  static RefCountedPtr<SharedRingHashTable> Add(std::string key,
+                                                RingHashTable table);
+
+  const RingHashTable& table() const { return table_; }
+
+ private:
+  const std::string key_;
+  const RingHashTable table_;
+};
+
+Mutex* g_table_cache_mu = nullptr;
+std::map<std::string, SharedRingHashTable*>* g_table_cache
+    ABSL_GUARDED_BY(*g_table_cache_mu) = nullptr;
+
+SharedRingHashTable::~SharedRingHashTable() {
+  MutexLock lock(g_table_cache_mu);
+  // A table that has just lost its last ref may already have been replaced
+  // by one that Add() cached under the same key.
+  auto it = g_table_cache->find(key_);
+  if (it != g_table_cache->end() && it->second == this) {
+    g_table_cache->erase(it);
+  }
+}
+
+RefCountedPtr<SharedRingHashTable> SharedRingHashTable::Get(
+    const std::string& key) {
+  MutexLock lock(g_table_cache_mu);
+  auto it = g_table_cache->find(key);
+  if (it == g_table_cache->end()) return nullptr;
+  return it->second->RefIfNonZero();
+}
+
+RefCountedPtr<SharedRingHashTable> SharedRingHashTable::Add(
+    std::string key, RingHashTable table) {
+  MutexLock lock(g_table_cache_mu);
+  SharedRingHashTable*& entry = (*g_table_cache)[key];
+  if (entry != nullptr) {
+    RefCountedPtr<SharedRingHashTable> cached = entry->RefIfNonZero();
+    if (cached != nullptr) return cached;
+  }
+  auto shared =
+      MakeRefCounted<SharedRingHashTable>(std::move(key), std::move(table));
+  entry = shared.get();
+  return shared;
+}
+
 class RingHashLbConfig : public LoadBalancingPolicy::Config {
  public:
-  RingHashLbConfig(size_t min_ring_size, size_t max_ring_size)
-      : min_ring_size_(min_ring_size), max_ring_size_(max_ring_size) {}
+  explicit RingHashLbConfig(const RingHashLbParams& params)
+      : params_(params) {}
   const char* name() const override { return kRingHash; }
-  size_t min_ring_size() const { return min_ring_size_; }
-  size_t max_ring_size() const { return max_ring_size_; }
+  size_t min_ring_size() const { return params_.min_ring_size; }
+  size_t max_ring_size() const { return params_.max_ring_size; }
+  RingHashLbParams::LookupTable lookup_table() const {
+    return params_.lookup_table;
+  }
+  size_t maglev_table_size() const { return params_.maglev_table_size; }
+  uint32_t hash_balance_factor() const { return params_.hash_balance_factor; }
 
  private:
-  size_t min_ring_size_;
-  size_t max_ring_size_;
+  RingHashLbParams params_;
 };
 
 //
@@ -121,10 +526,25 @@ class RingHash : public LoadBalancingPolicy {
   // Forward declaration.
   class RingHashSubchannelList;
 
+  // Number of calls in flight, on one subchannel or on all of them. Shared
+  // by the pickers and the calls' trackers, since calls may outlive both the
+  // subchannel list and the picker that started them.
+  class OutstandingCalls : public RefCounted<OutstandingCalls> {
+   public:
+    void Increment() { count_.fetch_add(1, std::memory_order_relaxed); }
+    void Decrement() { count_.fetch_sub(1, std::memory_order_relaxed); }
+    intptr_t Load() const { return count_.load(std::memory_order_relaxed); }
+
+   private:
+    std::atomic<intptr_t> count_{0};
+  };
+
   // Data for a particular subchannel in a subchannel list.
   // This subclass adds the following functionality:
   // - Tracks the previous connectivity state of the subchannel, so that
   //   we know how many subchannels are in each state.
+  // - Owns the subchannel's count of calls in flight, used when loads are
+  //   bounded.
   class RingHashSubchannelData
       : public SubchannelData<RingHashSubchannelList, RingHashSubchannelData> {
    public:
@@ -134,12 +554,16 @@ class RingHash : public LoadBalancingPolicy {
         const ServerAddress& address,
         RefCountedPtr<SubchannelInterface> subchannel)
         : SubchannelData(subchannel_list, address, std::move(subchannel)),
-          address_(address) {}
+          address_(address),
+          outstanding_calls_(MakeRefCounted<OutstandingCalls>()) {}
 
     grpc_connectivity_state connectivity_state() const {
       return last_connectivity_state_;
     }
     const ServerAddress& address() const { return address_; }
+    const RefCountedPtr<OutstandingCalls>& outstanding_calls() const {
+      return outstanding_calls_;
+    }
 
     bool seen_failure_since_ready() const { return seen_failure_since_ready_; }
 
@@ -157,6 +581,7 @@ class RingHash : public LoadBalancingPolicy {
     ServerAddress address_;
     grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_SHUTDOWN;
     bool seen_failure_since_ready_ = false;
+    RefCountedPtr<OutstandingCalls> outstanding_calls_;
   };
 
   // A list of subchannels.
@@ -193,7 +618,14 @@ class RingHash : public LoadBalancingPolicy {
     // Transient Failure.
     bool UpdateRingHashConnectivityStateLocked();
 
+    // The lookup table for the subchannels in this list.
+    const RefCountedPtr<SharedRingHashTable>& table() const { return table_; }
+    void set_table(RefCountedPtr<SharedRingHashTable> table) {
+      table_ = std::move(table);
+    }
+
    private:
+    RefCountedPtr<SharedRingHashTable> table_;
     size_t num_idle_ = 0;
     size_t num_ready_ = 0;
     size_t num_connecting_ = 0;
@@ -208,10 +640,45 @@ class RingHash : public LoadBalancingPolicy {
     PickResult Pick(PickArgs args) override;
 
    private:
-    struct RingEntry {
-      uint64_t hash;
+    struct Endpoint {
       RefCountedPtr<SubchannelInterface> subchannel;
       grpc_connectivity_state connectivity_state;
+      RefCountedPtr<OutstandingCalls> outstanding_calls;
+    };
+
+    // Counts the call as in flight on the picked subchannel, and in the
+    // policy's total, from the time it starts until it finishes, or is
+    // destroyed without finishing.
+    class CallTracker : public SubchannelCallTrackerInterface {
+     public:
+      CallTracker(RefCountedPtr<OutstandingCalls> outstanding_calls,
+                  RefCountedPtr<OutstandingCalls> total_outstanding_calls)
+          : outstanding_calls_(std::move(outstanding_calls)),
+            total_outstanding_calls_(std::move(total_outstanding_calls)) {}
+      ~CallTracker() override {
+        if (started_) Decrement();
+      }
+
+      void Start() override {
+        outstanding_calls_->Increment();
+        total_outstanding_calls_->Increment();
+        started_ = true;
+      }
+
+      void Finish(FinishArgs /*args*/) override {
+        if (started_) Decrement();
+        started_ = false;
+      }
+
+     private:
+      void Decrement() {
+        outstanding_calls_->Decrement();
+        total_outstanding_calls_->Decrement();
+      }
+
+      RefCountedPtr<OutstandingCalls> outstanding_calls_;
+      RefCountedPtr<OutstandingCalls> total_outstanding_calls_;
+      bool started_ = false;
     };
 
     // A fire-and-forget class that schedules subchannel connection attempts
@@ -229,7 +696,7 @@ class RingHash : public LoadBalancingPolicy {
       }
 
       void Orphan() override {
-        // Hop into ExecCtx, so that we're not holding the data plane mutex
+        // Hop into ExecCtx, so that we're not inside the data plane pick
         // while we run control-plane code.
         ExecCtx::Run(DEBUG_LOCATION, &closure_, GRPC_ERROR_NONE);
       }
@@ -254,19 +721,40 @@ class RingHash : public LoadBalancingPolicy {
       absl::InlinedVector<RefCountedPtr<SubchannelInterface>, 10> subchannels_;
     };
 
+    // Returns a pick of the READY endpoint in the given slot, or, if loads
+    // are bounded and that endpoint is at capacity, of the first READY
+    // endpoint after it that is not.
+    PickResult PickReady(size_t slot);
+
     RefCountedPtr<RingHash> parent_;
 
-    // A ring of subchannels.
-    std::vector<RingEntry> ring_;
+    std::vector<Endpoint> endpoints_;
+    // Maps request hashes to endpoints_.
+    RefCountedPtr<SharedRingHashTable> shared_table_;
+    const RingHashTable& table_;
+    // Bound on calls in flight per endpoint, as a percentage of the average
+    // over READY endpoints; 0 if loads are not bounded.
+    const uint32_t hash_balance_factor_;
+    size_t num_ready_ = 0;
+    RefCountedPtr<OutstandingCalls> total_outstanding_calls_;
   };
 
   void ShutdownLocked() override;
 
+  // Returns the lookup table for subchannel_list_, from the process-wide
+  // cache if another policy has built it; otherwise builds it, from
+  // old_table if that is a ring with the same sizes.
+  RefCountedPtr<SharedRingHashTable> GetTableLocked(
+      const RingHashLbConfig* old_config, const RingHashTable* old_table);
+
   // Current config from resolver.
   RefCountedPtr<RingHashLbConfig> config_;
 
   // list of subchannels.
   OrphanablePtr<RingHashSubchannelList> subchannel_list_;
+  // Calls in flight on all subchannels, for bounded loads.
+  RefCountedPtr<OutstandingCalls> total_outstanding_calls_ =
+      MakeRefCounted<OutstandingCalls>();
   // indicating if we are shutting down.
   bool shutdown_ = false;
 };
@@ -277,108 +765,51 @@ class RingHash : public LoadBalancingPolicy {
 
 RingHash::Picker::Picker(RefCountedPtr<RingHash> parent,
                          RingHashSubchannelList* subchannel_list)
-    : parent_(std::move(parent)) {
+    : parent_(std::move(parent)),
+      shared_table_(subchannel_list->table()),
+      table_(shared_table_->table()),
+      hash_balance_factor_(parent_->config_->hash_balance_factor()),
+      total_outstanding_calls_(parent_->total_outstanding_calls_) {
   size_t num_subchannels = subchannel_list->num_subchannels();
-  // Store the weights while finding the sum.
-  struct AddressWeight {
-    std::string address;
-    // Default weight is 1 for the cases where a weight is not provided,
-    // each occurrence of the address will be counted a weight value of 1.
-    uint32_t weight = 1;
-    double normalized_weight;
-  };
-  std::vector<AddressWeight> address_weights;
-  size_t sum = 0;
-  address_weights.reserve(num_subchannels);
+  endpoints_.reserve(num_subchannels);
   for (size_t i = 0; i < num_subchannels; ++i) {
     RingHashSubchannelData* sd = subchannel_list->subchannel(i);
-    const ServerAddressWeightAttribute* weight_attribute = static_cast<
-        const ServerAddressWeightAttribute*>(sd->address().GetAttribute(
-        ServerAddressWeightAttribute::kServerAddressWeightAttributeKey));
-    AddressWeight address_weight;
-    address_weight.address =
-        grpc_sockaddr_to_string(&sd->address().address(), false);
-    if (weight_attribute != nullptr) {
-      GPR_ASSERT(weight_attribute->weight() != 0);
-      address_weight.weight = weight_attribute->weight();
-    }
-    sum += address_weight.weight;
-    address_weights.push_back(std::move(address_weight));
-  }
-  // Calculating normalized weights and find min and max.
-  double min_normalized_weight = 1.0;
-  double max_normalized_weight = 0.0;
-  for (auto& address : address_weights) {
-    address.normalized_weight = static_cast<double>(address.weight) / sum;
-    min_normalized_weight =
-        std::min(address.normalized_weight, min_normalized_weight);
-    max_normalized_weight =
-        std::max(address.normalized_weight, max_normalized_weight);
+    const grpc_connectivity_state state =
+        sd->subchannel()->CheckConnectivityState();
+    if (state == GRPC_CHANNEL_READY) ++num_ready_;
+    endpoints_.push_back(
+        {sd->subchannel()->Ref(), state, sd->outstanding_calls()});
   }
-  // Scale up the number of hashes per host such that the least-weighted host
-  // gets a whole number of hashes on the ring. Other hosts might not end up
-  // with whole numbers, and that's fine (the ring-building algorithm below can
-  // handle this). This preserves the original implementation's behavior: when
-  // weights aren't provided, all hosts should get an equal number of hashes. In
-  // the case where this number exceeds the max_ring_size, it's scaled back down
-  // to fit.
-  const size_t min_ring_size = parent_->config_->min_ring_size();
-  const size_t max_ring_size = parent_->config_->max_ring_size();
-  const double scale = std::min(
-      std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
-      static_cast<double>(max_ring_size));
-  // Reserve memory for the entire ring up front.
-  const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
-  // Populate the hash ring by walking through the (host, weight) pairs in
-  // normalized_host_weights, and generating (scale * weight) hashes for each
-  // host. Since these aren't necessarily whole numbers, we maintain running
-  // sums -- current_hashes and target_hashes -- which allows us to populate the
-  // ring in a mostly stable way.
-  absl::InlinedVector<char, 196> hash_key_buffer;
-  double current_hashes = 0.0;
-  double target_hashes = 0.0;
-  uint64_t min_hashes_per_host = ring_size;
-  uint64_t max_hashes_per_host = 0;
-  for (size_t i = 0; i < num_subchannels; ++i) {
-    const std::string& address_string = address_weights[i].address;
-    hash_key_buffer.assign(address_string.begin(), address_string.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
-    target_hashes += scale * address_weights[i].normalized_weight;
-    size_t count = 0;
-    auto current_state =
-        subchannel_list->subchannel(i)->subchannel()->CheckConnectivityState();
-    while (current_hashes < target_hashes) {
-      const std::string count_str = absl::StrCat(count);
-      hash_key_buffer.insert(offset_start, count_str.begin(), count_str.end());
-      absl::string_view hash_key(hash_key_buffer.data(),
-                                 hash_key_buffer.size());
-      const uint64_t hash = XXH64(hash_key.data(), hash_key.size(), 0);
-      ring_.push_back({hash,
-                       subchannel_list->subchannel(i)->subchannel()->Ref(),
-                       current_state});
-      ++count;
-      ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
-    }
-    min_hashes_per_host =
-        std::min(static_cast<uint64_t>(i), min_hashes_per_host);
-    max_hashes_per_host =
-        std::max(static_cast<uint64_t>(i), max_hashes_per_host);
-  }
-  std::sort(ring_.begin(), ring_.end(),
-            [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
-              return lhs.hash < rhs.hash;
-            });
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
     gpr_log(GPR_INFO,
             "[RH %p picker %p] created picker from subchannel_list=%p "
-            "with %" PRIuPTR " ring entries",
-            parent_.get(), this, subchannel_list, ring_.size());
+            "with %" PRIuPTR " table entries, hash_balance_factor=%u",
+            parent_.get(), this, subchannel_list, table_.size(),
+            hash_balance_factor_);
   }
 }
 
+RingHash::PickResult RingHash::Picker::PickReady(size_t slot) {
+  if (hash_balance_factor_ == 0) {
+    return PickResult::Complete(endpoints_[table_.endpoint(slot)].subchannel);
+  }
+  // The counts are read without synchronization, so the bound is only
+  // approximate under concurrent picks.
+  const intptr_t capacity = RingHashEndpointCapacity(
+      hash_balance_factor_, total_outstanding_calls_->Load(), num_ready_);
+  size_t picked_slot = table_.FindSlotFrom(slot, [&](uint32_t index) {
+    const Endpoint& candidate = endpoints_[index];
+    return candidate.connectivity_state == GRPC_CHANNEL_READY &&
+           candidate.outstanding_calls->Load() < capacity;
+  });
+  if (picked_slot == table_.size()) picked_slot = slot;
+  const Endpoint& picked = endpoints_[table_.endpoint(picked_slot)];
+  return PickResult::Complete(
+      picked.subchannel,
+      absl::make_unique<CallTracker>(picked.outstanding_calls,
+                                     total_outstanding_calls_));
+}
+
 RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
   auto hash =
       args.call_state->ExperimentalGetCallAttribute(kRequestRingHashAttribute);
@@ -387,33 +818,9 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
     return PickResult::Fail(
         absl::InternalError("xds ring hash value is not a number"));
   }
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
-  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
-  // for lowp, highp, and first_index. Do not change them!
-  int64_t lowp = 0;
-  int64_t highp = ring_.size();
-  int64_t first_index = 0;
-  while (true) {
-    first_index = (lowp + highp) / 2;
-    if (first_index == static_cast<int64_t>(ring_.size())) {
-      first_index = 0;
-      break;
-    }
-    uint64_t midval = ring_[first_index].hash;
-    uint64_t midval1 = first_index == 0 ? 0 : ring_[first_index - 1].hash;
-    if (h <= midval && h > midval1) {
-      break;
-    }
-    if (midval < h) {
-      lowp = first_index + 1;
-    } else {
-      highp = first_index - 1;
-    }
-    if (lowp > highp) {
-      first_index = 0;
-      break;
-    }
-  }
+  const size_t first_slot = table_.FindSlot(h);
+  const uint32_t first_index = table_.endpoint(first_slot);
+  const Endpoint& first = endpoints_[first_index];
   OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
   auto ScheduleSubchannelConnectionAttempt =
       [&](RefCountedPtr<SubchannelInterface> subchannel) {
@@ -423,30 +830,32 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
         }
         subchannel_connection_attempter->AddSubchannel(std::move(subchannel));
       };
-  switch (ring_[first_index].connectivity_state) {
+  switch (first.connectivity_state) {
     case GRPC_CHANNEL_READY:
-      return PickResult::Complete(ring_[first_index].subchannel);
+      return PickReady(first_slot);
     case GRPC_CHANNEL_IDLE:
-      ScheduleSubchannelConnectionAttempt(ring_[first_index].subchannel);
+      ScheduleSubchannelConnectionAttempt(first.subchannel);
       ABSL_FALLTHROUGH_INTENDED;
     case GRPC_CHANNEL_CONNECTING:
       return PickResult::Queue();
     default:  // GRPC_CHANNEL_TRANSIENT_FAILURE
       break;
   }
-  ScheduleSubchannelConnectionAttempt(ring_[first_index].subchannel);
+  ScheduleSubchannelConnectionAttempt(first.subchannel);
   // Loop through remaining subchannels to find one in READY.
   // On the way, we make sure the right set of connection attempts
   // will happen.
   bool found_second_subchannel = false;
   bool found_first_non_failed = false;
-  for (size_t i = 1; i < ring_.size(); ++i) {
-    const RingEntry& entry = ring_[(first_index + i) % ring_.size()];
-    if (entry.subchannel == ring_[first_index].subchannel) {
+  for (size_t i = 1; i < table_.size(); ++i) {
+    const size_t slot = (first_slot + i) % table_.size();
+    const uint32_t index = table_.endpoint(slot);
+    if (index == first_index) {
       continue;
     }
+    const Endpoint& entry = endpoints_[index];
     if (entry.connectivity_state == GRPC_CHANNEL_READY) {
-      return PickResult::Complete(entry.subchannel);
+      return PickReady(slot);
     }
     if (!found_second_subchannel) {
       switch (entry.connectivity_state) {
@@ -684,11 +1093,87 @@ void RingHash::ShutdownLocked() {
 
 void RingHash::ResetBackoffLocked() { subchannel_list_->ResetBackoffLocked(); }
 
+RefCountedPtr<SharedRingHashTable> RingHash::GetTableLocked(
+    const RingHashLbConfig* old_config, const RingHashTable* old_table) {
+  const bool maglev =
+      config_->lookup_table() == RingHashLbParams::LookupTable::kMaglev;
+  std::vector<RingHashTable::Endpoint> endpoints;
+  endpoints.reserve(subchannel_list_->num_subchannels());
+  std::string key =
+      maglev ? absl::StrCat("maglev/", config_->maglev_table_size())
+             : absl::StrCat("ring/", config_->min_ring_size(), "/",
+                            config_->max_ring_size());
+  for (size_t i = 0; i < subchannel_list_->num_subchannels(); ++i) {
+    const ServerAddress& address = subchannel_list_->subchannel(i)->address();
+    const ServerAddressWeightAttribute* weight_attribute = static_cast<
+        const ServerAddressWeightAttribute*>(address.GetAttribute(
+        ServerAddressWeightAttribute::kServerAddressWeightAttributeKey));
+    RingHashTable::Endpoint endpoint;
+    endpoint.address = grpc_sockaddr_to_string(&address.address(), false);
+    // Default weight is 1 for the cases where a weight is not provided,
+    // each occurrence of the address will be counted a weight value of 1.
+    if (weight_attribute != nullptr) {
+      GPR_ASSERT(weight_attribute->weight() != 0);
+      endpoint.weight = weight_attribute->weight();
+    }
+    absl::StrAppend(&key, ",", endpoint.address, "/", endpoint.weight);
+    endpoints.push_back(std::move(endpoint));
+  }
+  const char* table_name = maglev ? "Maglev table" : "ring";
+  RefCountedPtr<SharedRingHashTable> table = SharedRingHashTable::Get(key);
+  if (table != nullptr) {
+    std::string message = absl::StrFormat(
+        "ring_hash: using %s of %" PRIuPTR
+        " entries (%" PRIuPTR " bytes) already built by another channel",
+        table_name, table->table().size(), table->table().MemoryUsage());
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+      gpr_log(GPR_INFO, "[RH %p] %s", this, message.c_str());
+    }
+    channel_control_helper()->AddTraceEvent(ChannelControlHelper::TRACE_INFO,
+                                            message);
+    return table;
+  }
+  const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  const char* how = "built";
+  RingHashTable built;
+  if (maglev) {
+    built = RingHashTable::BuildMaglev(endpoints, config_->maglev_table_size());
+  } else if (old_table != nullptr && old_config != nullptr &&
+             old_config->lookup_table() ==
+                 RingHashLbParams::LookupTable::kRing &&
+             old_config->min_ring_size() == config_->min_ring_size() &&
+             old_config->max_ring_size() == config_->max_ring_size()) {
+    built = RingHashTable::UpdateRing(*old_table, endpoints,
+                                      config_->min_ring_size(),
+                                      config_->max_ring_size());
+    how = "updated";
+  } else {
+    built = RingHashTable::BuildRing(endpoints, config_->min_ring_size(),
+                                     config_->max_ring_size());
+  }
+  const double elapsed_ms = gpr_timespec_to_micros(gpr_time_sub(
+                                gpr_now(GPR_CLOCK_MONOTONIC), start)) /
+                            1000;
+  table = SharedRingHashTable::Add(std::move(key), std::move(built));
+  std::string message = absl::StrFormat(
+      "ring_hash: %s %s of %" PRIuPTR " entries (%" PRIuPTR
+      " bytes) for %" PRIuPTR " endpoints in %.3f ms",
+      how, table_name, table->table().size(), table->table().MemoryUsage(),
+      endpoints.size(), elapsed_ms);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
+    gpr_log(GPR_INFO, "[RH %p] %s", this, message.c_str());
+  }
+  channel_control_helper()->AddTraceEvent(ChannelControlHelper::TRACE_INFO,
+                                          message);
+  return table;
+}
+
 void RingHash::UpdateLocked(UpdateArgs args) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
     gpr_log(GPR_INFO, "[RR %p] received update with %" PRIuPTR " addresses",
             this, args.addresses.size());
   }
+  RefCountedPtr<RingHashLbConfig> old_config = std::move(config_);
   config_ = std::move(args.config);
   // Filter out any address with weight 0.
   ServerAddressList addresses;
@@ -701,6 +1186,9 @@ void RingHash::UpdateLocked(UpdateArgs args) {
       addresses.push_back(std::move(address));
     }
   }
+  // Keep the old table until the new one is built, to build it from.
+  RefCountedPtr<SharedRingHashTable> old_table;
+  if (subchannel_list_ != nullptr) old_table = subchannel_list_->table();
   subchannel_list_ = MakeOrphanable<RingHashSubchannelList>(
       this, &grpc_lb_ring_hash_trace, std::move(addresses), *args.args);
   if (subchannel_list_->num_subchannels() == 0) {
@@ -710,6 +1198,9 @@ void RingHash::UpdateLocked(UpdateArgs args) {
         GRPC_CHANNEL_TRANSIENT_FAILURE, status,
         absl::make_unique<TransientFailurePicker>(status));
   } else {
+    subchannel_list_->set_table(
+        GetTableLocked(old_config.get(),
+                       old_table == nullptr ? nullptr : &old_table->table()));
     // Start watching the new list.
     subchannel_list_->StartWatchingLocked();
   }
@@ -730,12 +1221,11 @@ class RingHashFactory : public LoadBalancingPolicyFactory {
 
   RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
       const Json& json, grpc_error_handle* error) const override {
-    size_t min_ring_size;
-    size_t max_ring_size;
+    RingHashLbParams params;
     std::vector<grpc_error_handle> error_list;
-    ParseRingHashLbConfig(json, &min_ring_size, &max_ring_size, &error_list);
+    ParseRingHashLbConfig(json, &params, &error_list);
     if (error_list.empty()) {
-      return MakeRefCounted<RingHashLbConfig>(min_ring_size, max_ring_size);
+      return MakeRefCounted<RingHashLbConfig>(params);
     } else {
       *error = GRPC_ERROR_CREATE_FROM_VECTOR(
           "ring_hash_experimental LB policy config", &error_list);
@@ -747,11 +1237,16 @@ class RingHashFactory : public LoadBalancingPolicyFactory {
 }  // namespace
 
 void GrpcLbPolicyRingHashInit() {
+  g_table_cache_mu = new Mutex();
+  g_table_cache = new std::map<std::string, SharedRingHashTable*>();
   grpc_core::LoadBalancingPolicyRegistry::Builder::
       RegisterLoadBalancingPolicyFactory(
           absl::make_unique<grpc_core::RingHashFactory>());
 }
 
-void GrpcLbPolicyRingHashShutdown() {}
+void GrpcLbPolicyRingHashShutdown() {
+  delete g_table_cache;
+  delete g_table_cache_mu;
+}
 
 }  // namespace grpc_core
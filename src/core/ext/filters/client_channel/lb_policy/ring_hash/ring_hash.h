@@ -19,19 +19,121 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
 #include <stdlib.h>
 
+#include <string>
+#include <vector>
+
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/json/json.h"
 
 namespace grpc_core {
 extern const char* kRequestRingHashAttribute;
 
+// Default size of a Maglev lookup table, and the largest one allowed; both
+// are prime, as the table size must be.
+constexpr size_t kRingHashDefaultMaglevTableSize = 65537;
+constexpr size_t kRingHashMaxMaglevTableSize = 5000011;
+
+// ring_hash policy configs.
+struct RingHashLbParams {
+  // Which structure maps request hashes to endpoints: a ketama ring, which
+  // is searched in O(log n), or a Maglev table, which is indexed directly.
+  enum class LookupTable { kRing, kMaglev };
+
+  size_t min_ring_size = 1024;
+  size_t max_ring_size = 8388608;
+  LookupTable lookup_table = LookupTable::kRing;
+  size_t maglev_table_size = kRingHashDefaultMaglevTableSize;
+  // If non-zero, bounds each endpoint's calls in flight to this percentage
+  // of the average over READY endpoints ("consistent hashing with bounded
+  // loads"); picks that would exceed it move on to the next endpoint.  At
+  // least 100.
+  uint32_t hash_balance_factor = 0;
+};
+
 // Helper Parsing method to parse ring hash policy configs; for example, ring
 // hash size validity.
-void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
-                           size_t* max_ring_size,
+void ParseRingHashLbConfig(const Json& json, RingHashLbParams* params,
                            std::vector<grpc_error_handle>* error_list);
+
+// Returns the number of calls in flight, counting a new one, that each READY
+// endpoint may have when loads are bounded: ceil(c * (m + 1) / n), for m
+// calls in flight on n READY endpoints and c the balance factor in percent
+// (Mirrokni et al., "Consistent Hashing with Bounded Loads").
+intptr_t RingHashEndpointCapacity(uint32_t hash_balance_factor,
+                                  intptr_t total_calls_in_flight,
+                                  size_t num_ready);
+
+// Maps request hashes to endpoints, identified by their index in the list
+// the table was built from.  A pick starts at the slot FindSlot() returns
+// and, if that slot's endpoint cannot take the call, moves on to the
+// following slots, wrapping around.
+class RingHashTable {
+ public:
+  struct Endpoint {
+    std::string address;
+    uint32_t weight = 1;
+  };
+
+  // Builds a ketama ring on which each endpoint has a number of points
+  // proportional to its weight, scaled so that the lightest endpoint has a
+  // whole number of them, within min_ring_size and max_ring_size.
+  static RingHashTable BuildRing(const std::vector<Endpoint>& endpoints,
+                                 size_t min_ring_size, size_t max_ring_size);
+
+  // Returns the ring BuildRing(endpoints, min_ring_size, max_ring_size)
+  // would, given a ring built by it from another list of endpoints with the
+  // same sizes.  The points of endpoints in both lists are kept, so only
+  // new points are hashed and sorted, and the rest merged in linear time.
+  static RingHashTable UpdateRing(const RingHashTable& ring,
+                                  const std::vector<Endpoint>& endpoints,
+                                  size_t min_ring_size, size_t max_ring_size);
+
+  // Builds a Maglev lookup table (Eisenbud et al., NSDI 2016) of table_size
+  // slots, which must be prime, filled from each endpoint's permutation of
+  // the slots in turns proportional to its weight.
+  static RingHashTable BuildMaglev(const std::vector<Endpoint>& endpoints,
+                                   size_t table_size);
+
+  // An empty table.
+  RingHashTable() = default;
+
+  size_t size() const { return endpoints_.size(); }
+  size_t FindSlot(uint64_t hash) const;
+  // Returns the first slot, starting at slot and wrapping around, whose
+  // endpoint satisfies predicate, or size() if there is none.
+  template <typename Predicate>
+  size_t FindSlotFrom(size_t slot, Predicate predicate) const {
+    for (size_t i = 0; i < endpoints_.size(); ++i) {
+      const size_t candidate = (slot + i) % endpoints_.size();
+      if (predicate(endpoints_[candidate])) return candidate;
+    }
+    return endpoints_.size();
+  }
+  uint32_t endpoint(size_t slot) const { return endpoints_[slot]; }
+
+  // Bytes of memory the table holds.
+  size_t MemoryUsage() const;
+
+ private:
+  // Returns the number of points each endpoint gets on a ring.
+  static std::vector<uint32_t> RingPointCounts(
+      const std::vector<Endpoint>& endpoints, size_t min_ring_size,
+      size_t max_ring_size);
+
+  // The hash of each point, in increasing order, for a ring; empty for a
+  // Maglev table.  Kept apart from endpoints_ so that the binary search
+  // only touches the hashes.
+  std::vector<uint64_t> hashes_;
+  std::vector<uint32_t> endpoints_;
+  // For a ring, the address of each endpoint and its number of points, for
+  // UpdateRing().
+  std::vector<std::string> addresses_;
+  std::vector<uint32_t> point_counts_;
+};
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H
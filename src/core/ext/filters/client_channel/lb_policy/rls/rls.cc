@@ -22,9 +22,11 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <limits.h>
 #include <stdlib.h>
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <list>
@@ -58,6 +60,7 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
 #include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/rcu_ptr.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -98,6 +101,8 @@ const double kDefaultThrottleRatioForSuccesses = 2.0;
 const int kDefaultThrottlePaddings = 8;
 const grpc_millis kCacheCleanupTimerInterval = 60 * GPR_MS_PER_SEC;
 const int64_t kMaxCacheSizeBytes = 5 * 1024 * 1024;
+const size_t kNumCacheShards = 16;
+const size_t kMinCacheShardBuckets = 16;
 
 // Parsed RLS LB policy configuration.
 class RlsLbConfig : public LoadBalancingPolicy::Config {
@@ -237,8 +242,9 @@ class RlsLb : public LoadBalancingPolicy {
 
     const std::string& target() const { return target_; }
 
-    PickResult Pick(PickArgs args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
-      return picker_->Pick(args);
+    // Must be called in a read section of RlsLb::rcu_readers_.
+    PickResult Pick(PickArgs args) {
+      return picker_.load(std::memory_order_acquire)->Pick(args);
     }
 
     // Updates for the child policy are handled in two phases:
@@ -263,6 +269,10 @@ class RlsLb : public LoadBalancingPolicy {
     // Does not take ownership of channel_args.
     void MaybeFinishUpdate() ABSL_LOCKS_EXCLUDED(&RlsLb::mu_);
 
+    // Replaces the picker, retiring the previous one.
+    void SetPicker(std::unique_ptr<SubchannelPicker> picker)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
     void ExitIdleLocked() {
       if (child_policy_ != nullptr) child_policy_->ExitIdleLocked();
     }
@@ -275,9 +285,8 @@ class RlsLb : public LoadBalancingPolicy {
     // reports TRANSIENT_FAILURE, the function will always return
     // TRANSIENT_FAILURE state instead of the actual state of the child policy
     // until the child policy reports another READY state.
-    grpc_connectivity_state connectivity_state() const
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
-      return connectivity_state_;
+    grpc_connectivity_state connectivity_state() const {
+      return connectivity_state_.load(std::memory_order_relaxed);
     }
 
    private:
@@ -313,14 +322,17 @@ class RlsLb : public LoadBalancingPolicy {
     OrphanablePtr<ChildPolicyHandler> child_policy_;
     RefCountedPtr<LoadBalancingPolicy::Config> pending_config_;
 
-    grpc_connectivity_state connectivity_state_ ABSL_GUARDED_BY(&RlsLb::mu_) =
-        GRPC_CHANNEL_IDLE;
-    std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
-        ABSL_GUARDED_BY(&RlsLb::mu_);
+    // Written under RlsLb::mu_ and read by pickers without it.
+    std::atomic<grpc_connectivity_state> connectivity_state_{
+        GRPC_CHANNEL_IDLE};
+    // Owned.  Replaced under RlsLb::mu_, retiring the previous picker, and
+    // read by pickers in read sections of RlsLb::rcu_readers_.
+    std::atomic<LoadBalancingPolicy::SubchannelPicker*> picker_{nullptr};
   };
 
-  // A picker that uses the cache and the request map in the LB policy
-  // (synchronized via a mutex) to determine how to route requests.
+  // A picker that uses the cache and the request map in the LB policy to
+  // determine how to route requests.  Requests whose cache entry has data
+  // that does not need refreshing yet are routed without taking the mutex.
   class Picker : public LoadBalancingPolicy::SubchannelPicker {
    public:
     explicit Picker(RefCountedPtr<RlsLb> lb_policy);
@@ -334,13 +346,28 @@ class RlsLb : public LoadBalancingPolicy {
     RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
   };
 
-  // An LRU cache with adjustable size.
+  // A cache with adjustable size, evicting approximately the least recently
+  // used entries (CLOCK).
+  //
+  // Pickers look up entries without taking RlsLb::mu_, in read sections of
+  // RlsLb::rcu_readers_.  The hash table, the entry list and the size are
+  // modified only in the WorkSerializer; anything unlinked from the table is
+  // retired and destroyed by RlsLb::ReclaimLocked() once no picker can still
+  // be using it.
   class Cache {
    public:
-    using Iterator = std::list<RequestKey>::iterator;
-
     class Entry : public InternallyRefCounted<Entry> {
      public:
+      // The results of the entry's last successful RLS response.  Published
+      // to pickers, which read it without holding RlsLb::mu_, so never
+      // modified.
+      struct Data {
+        std::vector<RefCountedPtr<ChildPolicyWrapper>> child_policy_wrappers;
+        std::string header_data;
+        grpc_millis data_expiration_time;
+        grpc_millis stale_time;
+      };
+
       Entry(RefCountedPtr<RlsLb> lb_policy, const RequestKey& key);
 
       // Notify the entry when it's evicted from the cache. Performs shut down.
@@ -349,6 +376,13 @@ class RlsLb : public LoadBalancingPolicy {
       // annotations for this particular caller.
       void Orphan() override ABSL_NO_THREAD_SAFETY_ANALYSIS;
 
+      const RequestKey& key() const { return key_; }
+
+      // Returns the data of the last successful RLS response, or null if
+      // there was none.  Pickers must be in a read section of
+      // RlsLb::rcu_readers_.
+      const Data* data() const { return data_.load(std::memory_order_acquire); }
+
       const absl::Status& status() const
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
         return status_;
@@ -361,33 +395,29 @@ class RlsLb : public LoadBalancingPolicy {
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
         return backoff_expiration_time_;
       }
-      grpc_millis data_expiration_time() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
-        return data_expiration_time_;
-      }
-      const std::string& header_data() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
-        return header_data_;
+      grpc_millis data_expiration_time() const {
+        const Data* data = this->data();
+        return data == nullptr ? GRPC_MILLIS_INF_PAST
+                               : data->data_expiration_time;
       }
-      grpc_millis stale_time() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
-        return stale_time_;
+      std::string header_data() const {
+        const Data* data = this->data();
+        return data == nullptr ? "" : data->header_data;
       }
-      grpc_millis min_expiration_time() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
-        return min_expiration_time_;
+      grpc_millis stale_time() const {
+        const Data* data = this->data();
+        return data == nullptr ? GRPC_MILLIS_INF_PAST : data->stale_time;
       }
+      grpc_millis min_expiration_time() const { return min_expiration_time_; }
 
       std::unique_ptr<BackOff> TakeBackoffState()
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
         return std::move(backoff_state_);
       }
 
-      // Cache size of entry.
-      size_t Size() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
-
-      // Pick subchannel for request based on the entry's state.
-      PickResult Pick(PickArgs args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      // Pick subchannel for request based on the given data of the entry.
+      // Must be called in a read section of RlsLb::rcu_readers_.
+      PickResult Pick(const Data& data, PickArgs args);
 
       // If the cache entry is in backoff state, resets the backoff and, if
       // applicable, its backoff timer. The method does not update the LB
@@ -399,7 +429,7 @@ class RlsLb : public LoadBalancingPolicy {
 
       // Check if the entry can be evicted from the cache, i.e. the
       // min_expiration_time_ has passed.
-      bool CanEvict() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      bool CanEvict() const;
 
       // Updates the entry upon reception of a new RLS response.
       // Returns a list of child policy wrappers on which FinishUpdate()
@@ -408,10 +438,25 @@ class RlsLb : public LoadBalancingPolicy {
           ResponseInfo response, std::unique_ptr<BackOff> backoff_state)
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
-      // Moves entry to the end of the LRU list.
-      void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      // Marks the entry as used since the CLOCK hand last passed it.  Only
+      // writes to the entry if it is not marked yet, so that pickers on
+      // different CPUs do not keep taking its cache line from each other.
+      void MarkUsed() {
+        if (!used_.load(std::memory_order_relaxed)) {
+          used_.store(true, std::memory_order_relaxed);
+        }
+      }
+
+      // Clears the mark set by MarkUsed(), returning whether it was set.
+      bool ClearUsed() {
+        if (!used_.load(std::memory_order_relaxed)) return false;
+        used_.store(false, std::memory_order_relaxed);
+        return true;
+      }
 
      private:
+      friend class Cache;
+
       class BackoffTimer : public InternallyRefCounted<BackoffTimer> {
        public:
         BackoffTimer(RefCountedPtr<Entry> entry, grpc_millis backoff_time);
@@ -431,6 +476,7 @@ class RlsLb : public LoadBalancingPolicy {
       };
 
       RefCountedPtr<RlsLb> lb_policy_;
+      const RequestKey key_;
 
       bool is_shutdown_ ABSL_GUARDED_BY(&RlsLb::mu_) = false;
 
@@ -443,65 +489,114 @@ class RlsLb : public LoadBalancingPolicy {
           GRPC_MILLIS_INF_PAST;
       OrphanablePtr<BackoffTimer> backoff_timer_;
 
-      // RLS response states
-      std::vector<RefCountedPtr<ChildPolicyWrapper>> child_policy_wrappers_
-          ABSL_GUARDED_BY(&RlsLb::mu_);
-      std::string header_data_ ABSL_GUARDED_BY(&RlsLb::mu_);
-      grpc_millis data_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_) =
-          GRPC_MILLIS_INF_PAST;
-      grpc_millis stale_time_ ABSL_GUARDED_BY(&RlsLb::mu_) =
-          GRPC_MILLIS_INF_PAST;
+      // RLS response states.  Owned.  Replaced under RlsLb::mu_, retiring
+      // the previous data.
+      std::atomic<const Data*> data_{nullptr};
+
+      const grpc_millis min_expiration_time_;
+
+      // Set by pickers, cleared by the CLOCK hand.
+      std::atomic<bool> used_{true};
+      // The entry's position in the cache's CLOCK list.
+      std::list<OrphanablePtr<Entry>>::iterator clock_position_;
+    };
 
-      grpc_millis min_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_);
-      Cache::Iterator lru_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
+    // A link in a chain of a shard's hash table.  Only next may change once
+    // the node is published.
+    struct Node {
+      Node(size_t hash, Entry* entry) : hash(hash), entry(entry) {}
+
+      const size_t hash;
+      Entry* const entry;
+      std::atomic<Node*> next{nullptr};
+    };
+
+    // A shard's hash table.  The number of buckets is a power of two.  The
+    // table is replaced as a whole, with new nodes, when it grows.
+    struct Table {
+      explicit Table(size_t num_buckets);
+      // Deletes the nodes still linked into the table.
+      ~Table();
+
+      std::atomic<Node*>& bucket(size_t hash) {
+        return buckets[(hash / kNumCacheShards) & (num_buckets - 1)];
+      }
+
+      const size_t num_buckets;
+      std::unique_ptr<std::atomic<Node*>[]> buckets;
     };
 
     explicit Cache(RlsLb* lb_policy);
+    ~Cache();
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
-    // not found, nullptr is returned. Otherwise, the entry is considered
-    // recently used and its order in the LRU list of the cache is updated.
-    Entry* Find(const RequestKey& key)
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+    // not found, nullptr is returned. Otherwise, the entry is marked as
+    // recently used.  Pickers must be in a read section of
+    // RlsLb::rcu_readers_, and must not use the entry after leaving it.
+    Entry* Find(const RequestKey& key);
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
     // not found, an entry is created, inserted in the cache, and returned to
     // the caller. Otherwise, the entry found is returned to the caller. The
-    // entry returned to the user is considered recently used and its order in
-    // the LRU list of the cache is updated.
+    // entry returned to the user is marked as recently used.  If the cache
+    // grows beyond its size limit, schedules an eviction pass.
     Entry* FindOrInsert(const RequestKey& key)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
     // Resizes the cache. If the new cache size is greater than the current size
-    // of the cache, do nothing. Otherwise, evict the oldest entries that
-    // exceed the new size limit of the cache.
-    void Resize(size_t bytes) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+    // of the cache, do nothing. Otherwise, evict entries until the cache fits
+    // the new size limit.
+    void Resize(size_t bytes);
+
+    // Evicts entries while the cache is larger than its size limit.
+    void MaybeShrinkSize() { MaybeShrinkSize(size_limit_); }
 
     // Resets backoff of all the cache entries.
     void ResetAllBackoff() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
-    // Shutdown the cache; clean-up and orphan all the stored cache entries.
-    void Shutdown() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+    // Shutdown the cache; retire all the stored cache entries.
+    void Shutdown();
 
    private:
+    // Each shard's table holds the keys with the same hash modulo
+    // kNumCacheShards, so that growing one moves only a fraction of the
+    // entries at a time.
+    struct Shard {
+      // Owned.
+      std::atomic<Table*> table{nullptr};
+      size_t num_entries = 0;
+    };
+
     static void OnCleanupTimer(void* arg, grpc_error_handle error);
 
     // Returns the entry size for a given key.
     static size_t EntrySizeForKey(const RequestKey& key);
 
-    // Evicts oversized cache elements when the current size is greater than
-    // the specified limit.
-    void MaybeShrinkSize(size_t bytes)
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+    Entry* Find(const RequestKey& key, size_t hash);
+
+    // Links a new entry into its shard's table.
+    void Link(size_t hash, Entry* entry);
+
+    // Unlinks the entry at the given position from its shard's table and the
+    // CLOCK list, and retires it.  Returns the next position.
+    std::list<OrphanablePtr<Entry>>::iterator Remove(
+        std::list<OrphanablePtr<Entry>>::iterator it);
+
+    // Evicts entries when the current size is greater than the specified
+    // limit, sweeping the CLOCK hand over them: entries used since the hand
+    // last passed them get another round, and entries that cannot be evicted
+    // yet are skipped.
+    void MaybeShrinkSize(size_t bytes);
 
     RlsLb* lb_policy_;
 
-    size_t size_limit_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
-    size_t size_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
+    size_t size_limit_ = 0;
+    size_t size_ = 0;
 
-    std::list<RequestKey> lru_list_ ABSL_GUARDED_BY(&RlsLb::mu_);
-    std::unordered_map<RequestKey, OrphanablePtr<Entry>, absl::Hash<RequestKey>>
-        map_ ABSL_GUARDED_BY(&RlsLb::mu_);
+    Shard shards_[kNumCacheShards];
+    // Owns the entries, in the order in which the CLOCK hand visits them.
+    std::list<OrphanablePtr<Entry>> clock_;
+    std::list<OrphanablePtr<Entry>>::iterator clock_hand_;
     grpc_timer cleanup_timer_;
     grpc_closure timer_callback_;
   };
@@ -650,13 +745,26 @@ class RlsLb : public LoadBalancingPolicy {
   // Updates the picker in the work serializer.
   void UpdatePickerLocked() ABSL_LOCKS_EXCLUDED(&mu_);
 
+  // Schedules ReclaimLocked() on the ExecCtx, so it's safe to invoke this
+  // while holding the lock.  Does nothing if it is already scheduled.
+  void ReclaimAsync();
+  // Hops into work serializer and calls ReclaimLocked().
+  static void ReclaimCallback(void* arg, grpc_error_handle error);
+  // Evicts entries from the cache while it is over its size limit, then
+  // destroys the retired objects once no picker can still be using them.
+  void ReclaimLocked() ABSL_LOCKS_EXCLUDED(&mu_);
+
   // The name of the server for the channel.
   std::string server_name_;
 
+  // Read sections of pickers, which use the cache's hash table, the data of
+  // its entries and the pickers of the child policies without holding mu_.
+  RcuReaders rcu_readers_;
+
   // Mutex to guard LB policy state that is accessed by the picker.
   Mutex mu_;
   bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
-  Cache cache_ ABSL_GUARDED_BY(mu_);
+  Cache cache_;
   // Maps an RLS request key to an RlsRequest object that represents a pending
   // RLS request.
   std::unordered_map<RequestKey, OrphanablePtr<RlsRequest>,
@@ -668,7 +776,26 @@ class RlsLb : public LoadBalancingPolicy {
   // request_map_ will continue to use the previous channel.
   OrphanablePtr<RlsChannel> rls_channel_ ABSL_GUARDED_BY(mu_);
 
+  // Objects unlinked from the state that pickers read without holding mu_,
+  // to be destroyed by ReclaimLocked() once no picker can still be using
+  // them.  Destroying them must not retire anything else.
+  struct Retired {
+    std::vector<OrphanablePtr<Cache::Entry>> entries;
+    std::vector<std::unique_ptr<const Cache::Entry::Data>> entry_data;
+    std::vector<std::unique_ptr<Cache::Node>> nodes;
+    std::vector<std::unique_ptr<Cache::Table>> tables;
+    std::vector<std::unique_ptr<SubchannelPicker>> pickers;
+
+    bool empty() const {
+      return entries.empty() && entry_data.empty() && nodes.empty() &&
+             tables.empty() && pickers.empty();
+    }
+  };
+
   // Accessed only from within WorkSerializer.
+  // Objects retired since the last ReclaimLocked().
+  Retired retired_;
+  bool reclaim_pending_ = false;
   ServerAddressList addresses_;
   const grpc_channel_args* channel_args_ = nullptr;
   RefCountedPtr<RlsLbConfig> config_;
@@ -687,7 +814,7 @@ RlsLb::ChildPolicyWrapper::ChildPolicyWrapper(RefCountedPtr<RlsLb> lb_policy,
                                                      : nullptr),
       lb_policy_(lb_policy),
       target_(std::move(target)),
-      picker_(absl::make_unique<QueuePicker>(std::move(lb_policy))) {
+      picker_(new QueuePicker(std::move(lb_policy))) {
   lb_policy_->child_policy_map_.emplace(target_, this);
 }
 
@@ -703,7 +830,9 @@ void RlsLb::ChildPolicyWrapper::Orphan() {
                                      lb_policy_->interested_parties());
     child_policy_.reset();
   }
-  picker_.reset();
+  // The wrapper is no longer referenced by any cache entry or picker, so no
+  // pick can still be using its picker.
+  delete picker_.exchange(nullptr, std::memory_order_relaxed);
 }
 
 grpc_error_handle InsertOrUpdateChildPolicyField(const std::string& field,
@@ -767,8 +896,8 @@ void RlsLb::ChildPolicyWrapper::StartUpdate() {
               child_policy_config.Dump().c_str());
     }
     pending_config_.reset();
-    picker_ = absl::make_unique<TransientFailurePicker>(
-        grpc_error_to_absl_status(error));
+    SetPicker(absl::make_unique<TransientFailurePicker>(
+        grpc_error_to_absl_status(error)));
     GRPC_ERROR_UNREF(error);
     child_policy_.reset();
   }
@@ -810,6 +939,16 @@ void RlsLb::ChildPolicyWrapper::MaybeFinishUpdate() {
   child_policy_->UpdateLocked(std::move(update_args));
 }
 
+void RlsLb::ChildPolicyWrapper::SetPicker(
+    std::unique_ptr<SubchannelPicker> picker) {
+  std::unique_ptr<SubchannelPicker> old_picker(
+      picker_.exchange(picker.release(), std::memory_order_acq_rel));
+  if (old_picker != nullptr) {
+    lb_policy_->retired_.pickers.push_back(std::move(old_picker));
+    lb_policy_->ReclaimAsync();
+  }
+}
+
 //
 // RlsLb::ChildPolicyWrapper::ChildPolicyHelper
 //
@@ -843,14 +982,14 @@ void RlsLb::ChildPolicyWrapper::ChildPolicyHelper::UpdateState(
   {
     MutexLock lock(&wrapper_->lb_policy_->mu_);
     if (wrapper_->is_shutdown_) return;
-    if (wrapper_->connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+    if (wrapper_->connectivity_state() == GRPC_CHANNEL_TRANSIENT_FAILURE &&
         state != GRPC_CHANNEL_READY) {
       return;
     }
-    wrapper_->connectivity_state_ = state;
+    wrapper_->connectivity_state_.store(state, std::memory_order_relaxed);
     GPR_DEBUG_ASSERT(picker != nullptr);
     if (picker != nullptr) {
-      wrapper_->picker_ = std::move(picker);
+      wrapper_->SetPicker(std::move(picker));
     }
   }
   wrapper_->lb_policy_->UpdatePickerLocked();
@@ -978,13 +1117,27 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
             lb_policy_.get(), this, key.ToString().c_str());
   }
   grpc_millis now = ExecCtx::Get()->Now();
+  RcuReaders::ReadSection read_section(&lb_policy_->rcu_readers_);
+  // Check if there's a cache entry.
+  Cache::Entry* entry = lb_policy_->cache_.Find(key);
+  // If the entry has data that does not need to be refreshed yet, no RLS
+  // request is needed, so the pick uses only state that is published to
+  // pickers.  This is the case for most picks.
+  if (entry != nullptr) {
+    const Cache::Entry::Data* data = entry->data();
+    if (data != nullptr && data->stale_time >= now) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+        gpr_log(GPR_INFO, "[rlslb %p] picker=%p: using cache entry %p",
+                lb_policy_.get(), this, entry);
+      }
+      return entry->Pick(*data, args);
+    }
+  }
   MutexLock lock(&lb_policy_->mu_);
   if (lb_policy_->is_shutdown_) {
     return PickResult::Fail(
         absl::UnavailableError("LB policy already shut down"));
   }
-  // Check if there's a cache entry.
-  Cache::Entry* entry = lb_policy_->cache_.Find(key);
   // If there is no cache entry, or if the cache entry is not in backoff
   // and has a stale time in the past, and there is not already a
   // pending RLS request for this key, then try to start a new RLS request.
@@ -1023,12 +1176,13 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
   // If the cache entry exists, see if it has usable data.
   if (entry != nullptr) {
     // If the entry has non-expired data, use it.
-    if (entry->data_expiration_time() >= now) {
+    const Cache::Entry::Data* data = entry->data();
+    if (data != nullptr && data->data_expiration_time >= now) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
         gpr_log(GPR_INFO, "[rlslb %p] picker=%p: using cache entry %p",
                 lb_policy_.get(), this, entry);
       }
-      return entry->Pick(args);
+      return entry->Pick(*data, args);
     }
     // If the entry is in backoff, then use the default target if set,
     // or else fail the pick.
@@ -1093,7 +1247,7 @@ void RlsLb::Cache::Entry::BackoffTimer::OnBackoffTimer(
                     self->entry_->lb_policy_.get(), self->entry_.get(),
                     self->entry_->is_shutdown_
                         ? "(shut down)"
-                        : self->entry_->lru_iterator_->ToString().c_str(),
+                        : self->entry_->key_.ToString().c_str(),
                     self->armed_);
           }
           bool cancelled = !self->armed_;
@@ -1125,43 +1279,37 @@ RlsLb::Cache::Entry::Entry(RefCountedPtr<RlsLb> lb_policy,
     : InternallyRefCounted<Entry>(
           GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace) ? "CacheEntry" : nullptr),
       lb_policy_(std::move(lb_policy)),
+      key_(key),
       backoff_state_(MakeCacheEntryBackoff()),
-      min_expiration_time_(ExecCtx::Get()->Now() + kMinExpirationTime),
-      lru_iterator_(lb_policy_->cache_.lru_list_.insert(
-          lb_policy_->cache_.lru_list_.end(), key)) {}
+      min_expiration_time_(ExecCtx::Get()->Now() + kMinExpirationTime) {}
 
 void RlsLb::Cache::Entry::Orphan() {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO, "[rlslb %p] cache entry=%p %s: cache entry evicted",
-            lb_policy_.get(), this, lru_iterator_->ToString().c_str());
+            lb_policy_.get(), this, key_.ToString().c_str());
   }
   is_shutdown_ = true;
-  lb_policy_->cache_.lru_list_.erase(lru_iterator_);
-  lru_iterator_ = lb_policy_->cache_.lru_list_.end();  // Just in case.
   backoff_state_.reset();
   if (backoff_timer_ != nullptr) {
     backoff_timer_.reset();
     lb_policy_->UpdatePickerAsync();
   }
-  child_policy_wrappers_.clear();
+  // The entry was retired before being orphaned, so no picker can still be
+  // using its data.
+  delete data_.exchange(nullptr, std::memory_order_relaxed);
   Unref(DEBUG_LOCATION, "Orphan");
 }
 
-size_t RlsLb::Cache::Entry::Size() const {
-  // lru_iterator_ is not valid once we're shut down.
-  GPR_ASSERT(!is_shutdown_);
-  return lb_policy_->cache_.EntrySizeForKey(*lru_iterator_);
-}
-
-LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
-  for (const auto& child_policy_wrapper : child_policy_wrappers_) {
+LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(const Data& data,
+                                                          PickArgs args) {
+  for (const auto& child_policy_wrapper : data.child_policy_wrappers) {
     if (child_policy_wrapper->connectivity_state() ==
         GRPC_CHANNEL_TRANSIENT_FAILURE) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
         gpr_log(GPR_INFO,
                 "[rlslb %p] cache entry=%p %s: target %s in state "
                 "TRANSIENT_FAILURE; skipping",
-                lb_policy_.get(), this, lru_iterator_->ToString().c_str(),
+                lb_policy_.get(), this, key_.ToString().c_str(),
                 child_policy_wrapper->target().c_str());
       }
       continue;
@@ -1172,15 +1320,15 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
           GPR_INFO,
           "[rlslb %p] cache entry=%p %s: target %s in state %s; "
           "delegating",
-          lb_policy_.get(), this, lru_iterator_->ToString().c_str(),
+          lb_policy_.get(), this, key_.ToString().c_str(),
           child_policy_wrapper->target().c_str(),
           ConnectivityStateName(child_policy_wrapper->connectivity_state()));
     }
     // Add header data.
-    if (!header_data_.empty()) {
-      char* copied_header_data =
-          static_cast<char*>(args.call_state->Alloc(header_data_.length() + 1));
-      strcpy(copied_header_data, header_data_.c_str());
+    if (!data.header_data.empty()) {
+      char* copied_header_data = static_cast<char*>(
+          args.call_state->Alloc(data.header_data.length() + 1));
+      strcpy(copied_header_data, data.header_data.c_str());
       args.initial_metadata->Add(kRlsHeaderKey, copied_header_data);
     }
     return child_policy_wrapper->Pick(args);
@@ -1190,7 +1338,7 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
     gpr_log(GPR_INFO,
             "[rlslb %p] cache entry=%p %s: no healthy target found; "
             "failing pick",
-            lb_policy_.get(), this, lru_iterator_->ToString().c_str());
+            lb_policy_.get(), this, key_.ToString().c_str());
   }
   return PickResult::Fail(
       absl::UnavailableError("all RLS targets unreachable"));
@@ -1203,7 +1351,7 @@ void RlsLb::Cache::Entry::ResetBackoff() {
 
 bool RlsLb::Cache::Entry::ShouldRemove() const {
   grpc_millis now = ExecCtx::Get()->Now();
-  return data_expiration_time_ < now && backoff_expiration_time_ < now;
+  return data_expiration_time() < now && backoff_expiration_time_ < now;
 }
 
 bool RlsLb::Cache::Entry::CanEvict() const {
@@ -1211,17 +1359,10 @@ bool RlsLb::Cache::Entry::CanEvict() const {
   return min_expiration_time_ < now;
 }
 
-void RlsLb::Cache::Entry::MarkUsed() {
-  auto& lru_list = lb_policy_->cache_.lru_list_;
-  auto new_it = lru_list.insert(lru_list.end(), *lru_iterator_);
-  lru_list.erase(lru_iterator_);
-  lru_iterator_ = new_it;
-}
-
 std::vector<RlsLb::ChildPolicyWrapper*>
 RlsLb::Cache::Entry::OnRlsResponseLocked(
     ResponseInfo response, std::unique_ptr<BackOff> backoff_state) {
-  // Move the entry to the end of the LRU list.
+  // Give the entry another round before the CLOCK hand evicts it.
   MarkUsed();
   // If the request failed, store the failed status and update the
   // backoff state.
@@ -1241,73 +1382,110 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
     return {};
   }
   // Request succeeded, so store the result.
-  header_data_ = std::move(response.header_data);
+  auto data = absl::make_unique<Data>();
+  data->header_data = std::move(response.header_data);
   grpc_millis now = ExecCtx::Get()->Now();
-  data_expiration_time_ = now + lb_policy_->config_->max_age();
-  stale_time_ = now + lb_policy_->config_->stale_age();
+  data->data_expiration_time = now + lb_policy_->config_->max_age();
+  data->stale_time = now + lb_policy_->config_->stale_age();
   status_ = absl::OkStatus();
   backoff_state_.reset();
   backoff_time_ = GRPC_MILLIS_INF_PAST;
   backoff_expiration_time_ = GRPC_MILLIS_INF_PAST;
   // Check if we need to update this list of targets.
-  bool targets_changed = [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
-    if (child_policy_wrappers_.size() != response.targets.size()) return true;
+  const Data* old_data = data_.load(std::memory_order_relaxed);
+  const size_t num_old_targets =
+      old_data == nullptr ? 0 : old_data->child_policy_wrappers.size();
+  bool targets_changed = [&]() {
+    if (num_old_targets != response.targets.size()) return true;
     for (size_t i = 0; i < response.targets.size(); ++i) {
-      if (child_policy_wrappers_[i]->target() != response.targets[i]) {
+      if (old_data->child_policy_wrappers[i]->target() !=
+          response.targets[i]) {
         return true;
       }
     }
     return false;
   }();
-  if (!targets_changed) {
-    // Targets didn't change, so we're not updating the list of child
-    // policies.  Return a new picker so that any queued requests can be
-    // re-processed.
-    lb_policy_->UpdatePickerAsync();
-    return {};
-  }
-  // Target list changed, so update it.
-  std::set<absl::string_view> old_targets;
-  for (RefCountedPtr<ChildPolicyWrapper>& child_policy_wrapper :
-       child_policy_wrappers_) {
-    old_targets.emplace(child_policy_wrapper->target());
-  }
-  bool update_picker = false;
+  // If the targets didn't change, we're not updating the list of child
+  // policies, but return a new picker so that any queued requests can be
+  // re-processed.
+  bool update_picker = true;
   std::vector<ChildPolicyWrapper*> child_policies_to_finish_update;
-  std::vector<RefCountedPtr<ChildPolicyWrapper>> new_child_policy_wrappers;
-  new_child_policy_wrappers.reserve(response.targets.size());
-  for (std::string& target : response.targets) {
-    auto it = lb_policy_->child_policy_map_.find(target);
-    if (it == lb_policy_->child_policy_map_.end()) {
-      auto new_child = MakeRefCounted<ChildPolicyWrapper>(
-          lb_policy_->Ref(DEBUG_LOCATION, "ChildPolicyWrapper"), target);
-      new_child->StartUpdate();
-      child_policies_to_finish_update.push_back(new_child.get());
-      new_child_policy_wrappers.emplace_back(std::move(new_child));
-    } else {
-      new_child_policy_wrappers.emplace_back(
-          it->second->Ref(DEBUG_LOCATION, "CacheEntry"));
-      // If the target already existed but was not previously used for
-      // this key, then we'll need to update the picker, since we
-      // didn't actually create a new child policy, which would have
-      // triggered an RLS picker update when it returned its first picker.
-      if (old_targets.find(target) == old_targets.end()) {
-        update_picker = true;
+  if (!targets_changed) {
+    data->child_policy_wrappers = old_data->child_policy_wrappers;
+  } else {
+    // Target list changed, so update it.
+    update_picker = false;
+    std::set<absl::string_view> old_targets;
+    for (size_t i = 0; i < num_old_targets; ++i) {
+      old_targets.emplace(old_data->child_policy_wrappers[i]->target());
+    }
+    data->child_policy_wrappers.reserve(response.targets.size());
+    for (std::string& target : response.targets) {
+      auto it = lb_policy_->child_policy_map_.find(target);
+      if (it == lb_policy_->child_policy_map_.end()) {
+        auto new_child = MakeRefCounted<ChildPolicyWrapper>(
+            lb_policy_->Ref(DEBUG_LOCATION, "ChildPolicyWrapper"), target);
+        new_child->StartUpdate();
+        child_policies_to_finish_update.push_back(new_child.get());
+        data->child_policy_wrappers.emplace_back(std::move(new_child));
+      } else {
+        data->child_policy_wrappers.emplace_back(
+            it->second->Ref(DEBUG_LOCATION, "CacheEntry"));
+        // If the target already existed but was not previously used for
+        // this key, then we'll need to update the picker, since we
+        // didn't actually create a new child policy, which would have
+        // triggered an RLS picker update when it returned its first picker.
+        if (old_targets.find(target) == old_targets.end()) {
+          update_picker = true;
+        }
       }
     }
   }
-  child_policy_wrappers_ = std::move(new_child_policy_wrappers);
+  // Publish the new data.  Pickers may still be using the old data.
+  std::unique_ptr<const Data> retired_data(
+      data_.exchange(data.release(), std::memory_order_acq_rel));
+  if (retired_data != nullptr) {
+    lb_policy_->retired_.entry_data.push_back(std::move(retired_data));
+    lb_policy_->ReclaimAsync();
+  }
   if (update_picker) {
     lb_policy_->UpdatePickerAsync();
   }
   return child_policies_to_finish_update;
 }
 
+//
+// RlsLb::Cache::Table
+//
+
+RlsLb::Cache::Table::Table(size_t num_buckets)
+    : num_buckets(num_buckets), buckets(new std::atomic<Node*>[num_buckets]) {
+  for (size_t i = 0; i < num_buckets; ++i) {
+    buckets[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+RlsLb::Cache::Table::~Table() {
+  for (size_t i = 0; i < num_buckets; ++i) {
+    Node* node = buckets[i].load(std::memory_order_relaxed);
+    while (node != nullptr) {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      delete node;
+      node = next;
+    }
+  }
+}
+
 //
 // RlsLb::Cache
 //
 
-RlsLb::Cache::Cache(RlsLb* lb_policy) : lb_policy_(lb_policy) {
+RlsLb::Cache::Cache(RlsLb* lb_policy)
+    : lb_policy_(lb_policy), clock_hand_(clock_.end()) {
+  for (Shard& shard : shards_) {
+    shard.table.store(new Table(kMinCacheShardBuckets),
+                      std::memory_order_relaxed);
+  }
   grpc_millis now = ExecCtx::Get()->Now();
   lb_policy_->Ref(DEBUG_LOCATION, "CacheCleanupTimer").release();
   GRPC_CLOSURE_INIT(&timer_callback_, OnCleanupTimer, this, nullptr);
@@ -1315,36 +1493,52 @@ RlsLb::Cache::Cache(RlsLb* lb_policy) : lb_policy_(lb_policy) {
                   &timer_callback_);
 }
 
+RlsLb::Cache::~Cache() {
+  for (Shard& shard : shards_) {
+    delete shard.table.load(std::memory_order_relaxed);
+  }
+}
+
 RlsLb::Cache::Entry* RlsLb::Cache::Find(const RequestKey& key) {
-  auto it = map_.find(key);
-  if (it == map_.end()) return nullptr;
-  it->second->MarkUsed();
-  return it->second.get();
+  return Find(key, absl::Hash<RequestKey>()(key));
+}
+
+RlsLb::Cache::Entry* RlsLb::Cache::Find(const RequestKey& key, size_t hash) {
+  Table* table =
+      shards_[hash % kNumCacheShards].table.load(std::memory_order_acquire);
+  for (Node* node = table->bucket(hash).load(std::memory_order_acquire);
+       node != nullptr; node = node->next.load(std::memory_order_acquire)) {
+    if (node->hash == hash && node->entry->key() == key) {
+      node->entry->MarkUsed();
+      return node->entry;
+    }
+  }
+  return nullptr;
 }
 
 RlsLb::Cache::Entry* RlsLb::Cache::FindOrInsert(const RequestKey& key) {
-  auto it = map_.find(key);
-  // If not found, create new entry.
-  if (it == map_.end()) {
-    size_t entry_size = EntrySizeForKey(key);
-    MaybeShrinkSize(size_limit_ - std::min(size_limit_, entry_size));
-    Entry* entry =
-        new Entry(lb_policy_->Ref(DEBUG_LOCATION, "CacheEntry"), key);
-    map_.emplace(key, OrphanablePtr<Entry>(entry));
-    size_ += entry_size;
+  const size_t hash = absl::Hash<RequestKey>()(key);
+  Entry* entry = Find(key, hash);
+  // Entry found, so use it.
+  if (entry != nullptr) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
-      gpr_log(GPR_INFO, "[rlslb %p] key=%s: cache entry added, entry=%p",
-              lb_policy_, key.ToString().c_str(), entry);
+      gpr_log(GPR_INFO, "[rlslb %p] key=%s: found cache entry %p", lb_policy_,
+              key.ToString().c_str(), entry);
     }
     return entry;
   }
-  // Entry found, so use it.
+  // If not found, create new entry.  It goes just behind the CLOCK hand, so
+  // that the hand reaches it last.
+  entry = new Entry(lb_policy_->Ref(DEBUG_LOCATION, "CacheEntry"), key);
+  entry->clock_position_ = clock_.emplace(clock_hand_, entry);
+  Link(hash, entry);
+  size_ += EntrySizeForKey(key);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
-    gpr_log(GPR_INFO, "[rlslb %p] key=%s: found cache entry %p", lb_policy_,
-            key.ToString().c_str(), it->second.get());
+    gpr_log(GPR_INFO, "[rlslb %p] key=%s: cache entry added, entry=%p",
+            lb_policy_, key.ToString().c_str(), entry);
   }
-  it->second->MarkUsed();
-  return it->second.get();
+  if (size_ > size_limit_) lb_policy_->ReclaimAsync();
+  return entry;
 }
 
 void RlsLb::Cache::Resize(size_t bytes) {
@@ -1353,19 +1547,20 @@ void RlsLb::Cache::Resize(size_t bytes) {
             lb_policy_, bytes);
   }
   size_limit_ = bytes;
-  MaybeShrinkSize(size_limit_);
+  if (size_ > size_limit_) lb_policy_->ReclaimAsync();
 }
 
 void RlsLb::Cache::ResetAllBackoff() {
-  for (auto& p : map_) {
-    p.second->ResetBackoff();
+  for (auto& entry : clock_) {
+    entry->ResetBackoff();
   }
   lb_policy_->UpdatePickerAsync();
 }
 
 void RlsLb::Cache::Shutdown() {
-  map_.clear();
-  lru_list_.clear();
+  for (auto it = clock_.begin(); it != clock_.end();) {
+    it = Remove(it);
+  }
   grpc_timer_cancel(&cleanup_timer_);
 }
 
@@ -1382,15 +1577,16 @@ void RlsLb::Cache::OnCleanupTimer(void* arg, grpc_error_handle error) {
         if (error == GRPC_ERROR_CANCELLED) return;
         MutexLock lock(&lb_policy->mu_);
         if (lb_policy->is_shutdown_) return;
-        for (auto it = cache->map_.begin(); it != cache->map_.end();) {
-          if (GPR_UNLIKELY(it->second->ShouldRemove() &&
-                           it->second->CanEvict())) {
-            cache->size_ -= it->second->Size();
-            it = cache->map_.erase(it);
+        bool removed = false;
+        for (auto it = cache->clock_.begin(); it != cache->clock_.end();) {
+          if (GPR_UNLIKELY((*it)->ShouldRemove() && (*it)->CanEvict())) {
+            it = cache->Remove(it);
+            removed = true;
           } else {
             ++it;
           }
         }
+        if (removed) lb_policy->ReclaimAsync();
         grpc_millis now = ExecCtx::Get()->Now();
         lb_policy.release();
         grpc_timer_init(&cache->cleanup_timer_,
@@ -1401,27 +1597,86 @@ void RlsLb::Cache::OnCleanupTimer(void* arg, grpc_error_handle error) {
 }
 
 size_t RlsLb::Cache::EntrySizeForKey(const RequestKey& key) {
-  // Key is stored twice, once in LRU list and again in the cache map.
-  return (key.Size() * 2) + sizeof(Entry);
+  // The key is stored in the entry, which is linked into its shard's table
+  // by a node.
+  return key.Size() + sizeof(Entry) + sizeof(Node);
+}
+
+void RlsLb::Cache::Link(size_t hash, Entry* entry) {
+  Shard& shard = shards_[hash % kNumCacheShards];
+  Table* table = shard.table.load(std::memory_order_relaxed);
+  if (shard.num_entries >= table->num_buckets) {
+    // Grow the table.  The new table is complete before it is published, so
+    // pickers find every entry in whichever table they see.
+    Table* new_table = new Table(table->num_buckets * 2);
+    for (size_t i = 0; i < table->num_buckets; ++i) {
+      for (Node* node = table->buckets[i].load(std::memory_order_relaxed);
+           node != nullptr; node = node->next.load(std::memory_order_relaxed)) {
+        Node* new_node = new Node(node->hash, node->entry);
+        std::atomic<Node*>& bucket = new_table->bucket(node->hash);
+        new_node->next.store(bucket.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+        bucket.store(new_node, std::memory_order_relaxed);
+      }
+    }
+    shard.table.store(new_table, std::memory_order_release);
+    lb_policy_->retired_.tables.emplace_back(table);
+    lb_policy_->ReclaimAsync();
+    table = new_table;
+  }
+  Node* node = new Node(hash, entry);
+  std::atomic<Node*>& bucket = table->bucket(hash);
+  node->next.store(bucket.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
+  bucket.store(node, std::memory_order_release);
+  ++shard.num_entries;
+}
+
+std::list<OrphanablePtr<RlsLb::Cache::Entry>>::iterator RlsLb::Cache::Remove(
+    std::list<OrphanablePtr<Entry>>::iterator it) {
+  Entry* entry = it->get();
+  const size_t hash = absl::Hash<RequestKey>()(entry->key());
+  Shard& shard = shards_[hash % kNumCacheShards];
+  std::atomic<Node*>* link =
+      &shard.table.load(std::memory_order_relaxed)->bucket(hash);
+  Node* node = link->load(std::memory_order_relaxed);
+  while (node->entry != entry) {
+    link = &node->next;
+    node = link->load(std::memory_order_relaxed);
+  }
+  // Pickers that have reached the node can still follow its next link.
+  link->store(node->next.load(std::memory_order_relaxed),
+              std::memory_order_release);
+  lb_policy_->retired_.nodes.emplace_back(node);
+  --shard.num_entries;
+  size_ -= EntrySizeForKey(entry->key());
+  const bool at_hand = it == clock_hand_;
+  lb_policy_->retired_.entries.push_back(std::move(*it));
+  auto next = clock_.erase(it);
+  if (at_hand) clock_hand_ = next;
+  return next;
 }
 
 void RlsLb::Cache::MaybeShrinkSize(size_t bytes) {
-  while (size_ > bytes) {
-    auto lru_it = lru_list_.begin();
-    if (GPR_UNLIKELY(lru_it == lru_list_.end())) break;
-    auto map_it = map_.find(*lru_it);
-    GPR_ASSERT(map_it != map_.end());
-    if (!map_it->second->CanEvict()) break;
+  // The hand passes each entry at most twice: once to clear its mark, and
+  // once to evict it.
+  size_t steps = 2 * clock_.size();
+  while (size_ > bytes && steps-- > 0) {
+    if (clock_hand_ == clock_.end()) clock_hand_ = clock_.begin();
+    Entry* entry = clock_hand_->get();
+    if (entry->ClearUsed() || !entry->CanEvict()) {
+      ++clock_hand_;
+      continue;
+    }
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
-      gpr_log(GPR_INFO, "[rlslb %p] LRU eviction: removing entry %p %s",
-              lb_policy_, map_it->second.get(), lru_it->ToString().c_str());
+      gpr_log(GPR_INFO, "[rlslb %p] CLOCK eviction: removing entry %p %s",
+              lb_policy_, entry, entry->key().ToString().c_str());
     }
-    size_ -= map_it->second->Size();
-    map_.erase(map_it);
+    clock_hand_ = Remove(clock_hand_);
   }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO,
-            "[rlslb %p] LRU pass complete: desired size=%" PRIuPTR
+            "[rlslb %p] CLOCK pass complete: desired size=%" PRIuPTR
             " size=%" PRIuPTR,
             lb_policy_, bytes, size_);
   }
@@ -1922,10 +2177,12 @@ void RlsLb::UpdateLocked(UpdateArgs args) {
                                      config_->lookup_service(), channel_args_);
     }
     // Resize cache if needed.
-    if (old_config == nullptr ||
-        config_->cache_size_bytes() != old_config->cache_size_bytes()) {
-      cache_.Resize(config_->cache_size_bytes());
-    }
+    const int64_t cache_size_bytes = std::min<int64_t>(
+        config_->cache_size_bytes(),
+        grpc_channel_args_find_integer(
+            channel_args_, GRPC_ARG_RLS_MAX_CACHE_SIZE_BYTES,
+            {static_cast<int>(kMaxCacheSizeBytes), 1, INT_MAX}));
+    cache_.Resize(cache_size_bytes);
     // Start update of child policies if needed.
     if (update_child_policies) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
@@ -1988,16 +2245,21 @@ void RlsLb::ShutdownLocked() {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO, "[rlslb %p] policy shutdown", this);
   }
-  MutexLock lock(&mu_);
-  is_shutdown_ = true;
-  config_.reset(DEBUG_LOCATION, "ShutdownLocked");
-  if (channel_args_ != nullptr) {
-    grpc_channel_args_destroy(channel_args_);
+  {
+    MutexLock lock(&mu_);
+    is_shutdown_ = true;
+    config_.reset(DEBUG_LOCATION, "ShutdownLocked");
+    if (channel_args_ != nullptr) {
+      grpc_channel_args_destroy(channel_args_);
+    }
+    cache_.Shutdown();
+    request_map_.clear();
+    rls_channel_.reset();
+    default_child_policy_.reset();
   }
-  cache_.Shutdown();
-  request_map_.clear();
-  rls_channel_.reset();
-  default_child_policy_.reset();
+  // Destroy the cache entries now rather than in a callback, since they hold
+  // refs to the policy.
+  ReclaimLocked();
 }
 
 void RlsLb::UpdatePickerAsync() {
@@ -2023,6 +2285,42 @@ void RlsLb::UpdatePickerCallback(void* arg, grpc_error_handle /*error*/) {
       DEBUG_LOCATION);
 }
 
+void RlsLb::ReclaimAsync() {
+  if (reclaim_pending_) return;
+  reclaim_pending_ = true;
+  ExecCtx::Run(
+      DEBUG_LOCATION,
+      GRPC_CLOSURE_CREATE(ReclaimCallback,
+                          Ref(DEBUG_LOCATION, "ReclaimCallback").release(),
+                          grpc_schedule_on_exec_ctx),
+      GRPC_ERROR_NONE);
+}
+
+void RlsLb::ReclaimCallback(void* arg, grpc_error_handle /*error*/) {
+  auto* rls_lb = static_cast<RlsLb*>(arg);
+  rls_lb->work_serializer()->Run(
+      [rls_lb]() {
+        RefCountedPtr<RlsLb> lb_policy(rls_lb);
+        lb_policy->ReclaimLocked();
+        lb_policy.reset(DEBUG_LOCATION, "ReclaimCallback");
+      },
+      DEBUG_LOCATION);
+}
+
+void RlsLb::ReclaimLocked() {
+  reclaim_pending_ = false;
+  cache_.MaybeShrinkSize();
+  if (retired_.empty()) return;
+  Retired retired;
+  std::swap(retired, retired_);
+  // Wait for the pickers that may still be using the retired objects.  This
+  // must not hold the lock, which pickers take inside their read sections.
+  rcu_readers_.Synchronize();
+  // Orphaning the cache entries requires the lock.
+  MutexLock lock(&mu_);
+  retired = Retired();
+}
+
 void RlsLb::UpdatePickerLocked() {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO, "[rlslb %p] updating picker", this);
@@ -2359,10 +2657,6 @@ RlsLbConfig::RouteLookupConfig ParseRouteLookupConfig(
     error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
         "field:cacheSizeBytes error:must be greater than 0"));
   }
-  // Clamp cacheSizeBytes to the max allowed value.
-  if (route_lookup_config.cache_size_bytes > kMaxCacheSizeBytes) {
-    route_lookup_config.cache_size_bytes = kMaxCacheSizeBytes;
-  }
   // Parse defaultTarget.
   if (ParseJsonObjectField(json, "defaultTarget",
                            &route_lookup_config.default_target, &error_list,
@@ -29,6 +29,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <atomic>
+
 #include <grpc/support/alloc.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
@@ -160,7 +162,8 @@ class RoundRobin : public LoadBalancingPolicy {
     // Using pointer value only, no ref held -- do not dereference!
     RoundRobin* parent_;
 
-    size_t last_picked_index_;
+    // Picks run concurrently, so each claims an index with fetch_add().
+    std::atomic<size_t> last_picked_index_;
     absl::InlinedVector<RefCountedPtr<SubchannelInterface>, 10> subchannels_;
   };
 
@@ -195,25 +198,27 @@ RoundRobin::Picker::Picker(RoundRobin* parent,
   // the picker, see https://github.com/grpc/grpc-go/issues/2580.
   // TODO(roth): rand(3) is not thread-safe.  This should be replaced with
   // something better as part of https://github.com/grpc/grpc/issues/17891.
-  last_picked_index_ = rand() % subchannels_.size();
+  const size_t last_picked_index = rand() % subchannels_.size();
+  last_picked_index_.store(last_picked_index, std::memory_order_relaxed);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] created picker from subchannel_list=%p "
             "with %" PRIuPTR " READY subchannels; last_picked_index_=%" PRIuPTR,
             parent_, this, subchannel_list, subchannels_.size(),
-            last_picked_index_);
+            last_picked_index);
   }
 }
 
 RoundRobin::PickResult RoundRobin::Picker::Pick(PickArgs /*args*/) {
-  last_picked_index_ = (last_picked_index_ + 1) % subchannels_.size();
+  const size_t index =
+      (last_picked_index_.fetch_add(1, std::memory_order_relaxed) + 1) %
+      subchannels_.size();
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
-            parent_, this, last_picked_index_,
-            subchannels_[last_picked_index_].get());
+            parent_, this, index, subchannels_[index].get());
   }
-  return PickResult::Complete(subchannels_[last_picked_index_]);
+  return PickResult::Complete(subchannels_[index]);
 }
 
 //
@@ -0,0 +1,884 @@
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Weighted Round Robin Policy.
+//
+// Like round_robin, but each READY subchannel is picked in proportion to a
+// weight derived from the load it reports in its responses' backend metrics
+// (ORCA): its QPS divided by its CPU utilization. A backend's weight is only
+// used once it has been reporting for blackoutPeriod, and is dropped once it
+// has not reported for weightExpirationPeriod. Subchannels without a usable
+// weight get the mean of the others' weights.
+//
+// With enableOobLoadReport, the load is instead taken from an out-of-band
+// ORCA stream that each backend sends every oobReportingPeriod, so that
+// backends get a weight before, and regardless of, the calls sent to them.
+//
+// Every weightUpdatePeriod the policy turns the current weights into an
+// earliest-deadline-first (EDF) schedule and hands it to a new picker, which
+// replays it: picks claim the next slot with a single fetch_add(), so they
+// never take a lock.
+
+#include <grpc/support/port_platform.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <queue>
+#include <vector>
+
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/transport/connectivity_state.h"
+#include "src/core/lib/transport/error_utils.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_weighted_round_robin_trace(false, "weighted_round_robin_lb");
+
+namespace {
+
+constexpr char kWeightedRoundRobin[] = "weighted_round_robin_experimental";
+
+constexpr grpc_millis kDefaultBlackoutPeriod = 10 * GPR_MS_PER_SEC;
+constexpr grpc_millis kDefaultWeightExpirationPeriod = 180 * GPR_MS_PER_SEC;
+constexpr grpc_millis kDefaultWeightUpdatePeriod = GPR_MS_PER_SEC;
+constexpr grpc_millis kMinWeightUpdatePeriod = 100;
+constexpr grpc_millis kDefaultOobReportingPeriod = 10 * GPR_MS_PER_SEC;
+
+// Weights are scaled so that the largest becomes this, which bounds an EDF
+// schedule to this many slots per subchannel. Weights smaller than 1/100th
+// of the largest are rounded up to it.
+constexpr uint64_t kMaxScheduleWeight = 100;
+
+class WeightedRoundRobinConfig : public LoadBalancingPolicy::Config {
+ public:
+  WeightedRoundRobinConfig(grpc_millis blackout_period,
+                           grpc_millis weight_expiration_period,
+                           grpc_millis weight_update_period,
+                           bool enable_oob_load_report,
+                           grpc_millis oob_reporting_period)
+      : blackout_period_(blackout_period),
+        weight_expiration_period_(weight_expiration_period),
+        weight_update_period_(weight_update_period),
+        enable_oob_load_report_(enable_oob_load_report),
+        oob_reporting_period_(oob_reporting_period) {}
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  grpc_millis blackout_period() const { return blackout_period_; }
+  grpc_millis weight_expiration_period() const {
+    return weight_expiration_period_;
+  }
+  grpc_millis weight_update_period() const { return weight_update_period_; }
+  bool enable_oob_load_report() const { return enable_oob_load_report_; }
+  grpc_millis oob_reporting_period() const { return oob_reporting_period_; }
+
+ private:
+  grpc_millis blackout_period_;
+  grpc_millis weight_expiration_period_;
+  grpc_millis weight_update_period_;
+  bool enable_oob_load_report_;
+  grpc_millis oob_reporting_period_;
+};
+
+uint64_t Gcd(uint64_t a, uint64_t b) {
+  while (b != 0) {
+    const uint64_t r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+// Returns one period of the EDF schedule for the given (positive) weights,
+// as indexes into weights. Each index appears in proportion to its weight,
+// and the appearances of each index are spread evenly over the period.
+std::vector<uint32_t> BuildEdfSchedule(const std::vector<double>& weights) {
+  const double max_weight = *std::max_element(weights.begin(), weights.end());
+  std::vector<uint64_t> scaled(weights.size());
+  uint64_t gcd = 0;
+  for (size_t i = 0; i < weights.size(); ++i) {
+    scaled[i] = std::max<uint64_t>(
+        1, std::llround(weights[i] * kMaxScheduleWeight / max_weight));
+    gcd = Gcd(gcd, scaled[i]);
+  }
+  uint64_t period = 0;
+  for (uint64_t& weight : scaled) {
+    weight /= gcd;
+    period += weight;
+  }
+  // The k-th deadline of index i is k / scaled[i]. Compare deadlines by
+  // cross-multiplying, which is exact, so that each index appears exactly
+  // scaled[i] times in the period.
+  struct Entry {
+    uint64_t k;
+    uint32_t index;
+  };
+  auto later = [&scaled](const Entry& a, const Entry& b) {
+    const uint64_t a_deadline = a.k * scaled[b.index];
+    const uint64_t b_deadline = b.k * scaled[a.index];
+    if (a_deadline != b_deadline) return a_deadline > b_deadline;
+    return a.index > b.index;
+  };
+  std::priority_queue<Entry, std::vector<Entry>, decltype(later)> queue(later);
+  for (uint32_t i = 0; i < scaled.size(); ++i) queue.push(Entry{1, i});
+  std::vector<uint32_t> schedule;
+  schedule.reserve(period);
+  for (uint64_t i = 0; i < period; ++i) {
+    Entry entry = queue.top();
+    queue.pop();
+    schedule.push_back(entry.index);
+    ++entry.k;
+    queue.push(entry);
+  }
+  return schedule;
+}
+
+//
+// weighted_round_robin LB policy
+//
+
+class WeightedRoundRobin : public LoadBalancingPolicy {
+ public:
+  explicit WeightedRoundRobin(Args args);
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~WeightedRoundRobin() override;
+
+  // Forward declaration.
+  class WeightedRoundRobinSubchannelList;
+
+  // The load-derived weight of a backend. Kept per address rather than per
+  // subchannel, so that it survives address list updates, and shared with
+  // the pickers and the calls' trackers, which may outlive the policy's
+  // subchannel lists.
+  class SubchannelWeight : public RefCounted<SubchannelWeight> {
+   public:
+    // Records a load report from the backend.
+    void MaybeUpdateWeight(double qps, double cpu_utilization);
+
+    // Returns the weight to schedule the backend with, or 0 if it has no
+    // usable weight at time now.
+    double GetWeight(grpc_millis now, grpc_millis weight_expiration_period,
+                     grpc_millis blackout_period);
+
+   private:
+    Mutex mu_;
+    double weight_ ABSL_GUARDED_BY(mu_) = 0;
+    // When the current run of reports started, for the blackout period.
+    grpc_millis non_empty_since_ ABSL_GUARDED_BY(mu_) = GRPC_MILLIS_INF_FUTURE;
+    grpc_millis last_update_time_ ABSL_GUARDED_BY(mu_) = GRPC_MILLIS_INF_PAST;
+  };
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the weight of the subchannel's address.
+  class WeightedRoundRobinSubchannelData
+      : public SubchannelData<WeightedRoundRobinSubchannelList,
+                              WeightedRoundRobinSubchannelData> {
+   public:
+    WeightedRoundRobinSubchannelData(
+        SubchannelList<WeightedRoundRobinSubchannelList,
+                       WeightedRoundRobinSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)),
+          address_(grpc_sockaddr_to_string(&address.address(), false)),
+          weight_(static_cast<WeightedRoundRobin*>(subchannel_list->policy())
+                      ->GetOrCreateWeightLocked(address_)) {
+      const WeightedRoundRobinConfig* config =
+          static_cast<WeightedRoundRobin*>(subchannel_list->policy())
+              ->config_.get();
+      if (config->enable_oob_load_report() && this->subchannel() != nullptr) {
+        this->subchannel()->AddDataWatcher(MakeOobBackendMetricWatcher(
+            config->oob_reporting_period(),
+            absl::make_unique<OobWatcher>(weight_)));
+      }
+    }
+
+    grpc_connectivity_state connectivity_state() const {
+      return last_connectivity_state_;
+    }
+
+    const std::string& address() const { return address_; }
+    const RefCountedPtr<SubchannelWeight>& weight() const { return weight_; }
+
+    // Performs connectivity state updates that need to be done both when we
+    // first start watching and when a watcher notification is received.
+    void UpdateConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    // Feeds the backend's out-of-band load reports into its weight.
+    class OobWatcher : public OobBackendMetricWatcher {
+     public:
+      explicit OobWatcher(RefCountedPtr<SubchannelWeight> weight)
+          : weight_(std::move(weight)) {}
+
+      void OnBackendMetricReport(
+          const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData&
+              backend_metric_data) override {
+        weight_->MaybeUpdateWeight(
+            static_cast<double>(backend_metric_data.requests_per_second),
+            backend_metric_data.cpu_utilization);
+      }
+
+     private:
+      RefCountedPtr<SubchannelWeight> weight_;
+    };
+
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    bool seen_failure_since_ready_ = false;
+    // The address the weight is kept under.
+    const std::string address_;
+    RefCountedPtr<SubchannelWeight> weight_;
+  };
+
+  // A list of subchannels.
+  class WeightedRoundRobinSubchannelList
+      : public SubchannelList<WeightedRoundRobinSubchannelList,
+                              WeightedRoundRobinSubchannelData> {
+   public:
+    WeightedRoundRobinSubchannelList(WeightedRoundRobin* policy,
+                                     TraceFlag* tracer,
+                                     ServerAddressList addresses,
+                                     const grpc_channel_args& args)
+        : SubchannelList(policy, tracer, std::move(addresses),
+                         policy->channel_control_helper(), args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~WeightedRoundRobinSubchannelList() override {
+      WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked();
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // If this subchannel list is the policy's current subchannel list,
+    // updates the policy's connectivity state based on the subchannel
+    // list's state counters.
+    void MaybeUpdateWeightedRoundRobinConnectivityStateLocked();
+
+    // Updates the policy's overall state based on the counters of
+    // subchannels in each state.
+    void UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked();
+
+   private:
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(WeightedRoundRobin* parent,
+           WeightedRoundRobinSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    struct ReadySubchannel {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<SubchannelWeight> weight;
+    };
+
+    // Feeds the load reported in each call's trailers into the weight of
+    // the backend that served it.
+    class CallTracker : public SubchannelCallTrackerInterface {
+     public:
+      explicit CallTracker(RefCountedPtr<SubchannelWeight> weight)
+          : weight_(std::move(weight)) {}
+
+      void Start() override {}
+
+      void Finish(FinishArgs args) override {
+        const auto* backend_metric_data =
+            args.backend_metric_accessor->GetBackendMetricData();
+        if (backend_metric_data != nullptr) {
+          weight_->MaybeUpdateWeight(
+              static_cast<double>(backend_metric_data->requests_per_second),
+              backend_metric_data->cpu_utilization);
+        }
+      }
+
+     private:
+      RefCountedPtr<SubchannelWeight> weight_;
+    };
+
+    // Using pointer value only, no ref held -- do not dereference!
+    WeightedRoundRobin* parent_;
+
+    std::vector<ReadySubchannel> subchannels_;
+    // One period of the EDF schedule, as indexes into subchannels_. Empty
+    // if fewer than two subchannels have a usable weight, in which case
+    // picks are plain round robin.
+    std::vector<uint32_t> schedule_;
+    // Picks run concurrently, so each claims a slot with fetch_add().
+    std::atomic<size_t> next_;
+    // Whether the weights come from the out-of-band stream rather than
+    // from the calls' trailers.
+    bool oob_load_report_;
+  };
+
+  void ShutdownLocked() override;
+
+  // Returns the weight of address, creating it if needed.
+  RefCountedPtr<SubchannelWeight> GetOrCreateWeightLocked(
+      const std::string& address);
+  // Forgets the weights of addresses in neither subchannel list.
+  void PruneWeightsLocked();
+
+  // Refreshes the picker's schedule from the latest weights every
+  // weightUpdatePeriod while the policy is READY.
+  void MaybeStartWeightUpdateTimerLocked();
+  static void OnWeightUpdateTimer(void* arg, grpc_error_handle error);
+  void OnWeightUpdateTimerLocked(grpc_error_handle error);
+
+  RefCountedPtr<WeightedRoundRobinConfig> config_;
+  std::map<std::string, RefCountedPtr<SubchannelWeight>> weights_;
+  /** list of subchannels */
+  OrphanablePtr<WeightedRoundRobinSubchannelList> subchannel_list_;
+  /** Latest version of the subchannel list.
+   * Subchannel connectivity callbacks will only promote updated subchannel
+   * lists if they equal \a latest_pending_subchannel_list. In other words,
+   * racing callbacks that reference outdated subchannel lists won't perform any
+   * update. */
+  OrphanablePtr<WeightedRoundRobinSubchannelList>
+      latest_pending_subchannel_list_;
+  grpc_timer weight_update_timer_;
+  grpc_closure on_weight_update_timer_;
+  bool weight_update_timer_pending_ = false;
+  /** are we shutting down? */
+  bool shutdown_ = false;
+};
+
+//
+// WeightedRoundRobin::SubchannelWeight
+//
+
+void WeightedRoundRobin::SubchannelWeight::MaybeUpdateWeight(
+    double qps, double cpu_utilization) {
+  // Reports without load carry no information about the backend's capacity.
+  if (qps <= 0 || cpu_utilization <= 0) return;
+  const double weight = qps / cpu_utilization;
+  const grpc_millis now = ExecCtx::Get()->Now();
+  MutexLock lock(&mu_);
+  if (non_empty_since_ == GRPC_MILLIS_INF_FUTURE) non_empty_since_ = now;
+  last_update_time_ = now;
+  weight_ = weight;
+}
+
+double WeightedRoundRobin::SubchannelWeight::GetWeight(
+    grpc_millis now, grpc_millis weight_expiration_period,
+    grpc_millis blackout_period) {
+  MutexLock lock(&mu_);
+  if (last_update_time_ == GRPC_MILLIS_INF_PAST) return 0;
+  // A backend that stopped reporting must sit out a new blackout period
+  // once it resumes.
+  if (now - last_update_time_ >= weight_expiration_period) {
+    non_empty_since_ = GRPC_MILLIS_INF_FUTURE;
+    return 0;
+  }
+  if (blackout_period > 0 && now - non_empty_since_ < blackout_period) {
+    return 0;
+  }
+  return weight_;
+}
+
+//
+// WeightedRoundRobin::Picker
+//
+
+WeightedRoundRobin::Picker::Picker(
+    WeightedRoundRobin* parent,
+    WeightedRoundRobinSubchannelList* subchannel_list)
+    : parent_(parent),
+      oob_load_report_(parent->config_->enable_oob_load_report()) {
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    WeightedRoundRobinSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      subchannels_.push_back(
+          ReadySubchannel{sd->subchannel()->Ref(), sd->weight()});
+    }
+  }
+  const WeightedRoundRobinConfig* config = parent->config_.get();
+  const grpc_millis now = ExecCtx::Get()->Now();
+  std::vector<double> weights;
+  weights.reserve(subchannels_.size());
+  double weight_sum = 0;
+  size_t num_weighted = 0;
+  for (const ReadySubchannel& subchannel : subchannels_) {
+    const double weight = subchannel.weight->GetWeight(
+        now, config->weight_expiration_period(), config->blackout_period());
+    if (weight > 0) {
+      weight_sum += weight;
+      ++num_weighted;
+    }
+    weights.push_back(weight);
+  }
+  if (num_weighted >= 2) {
+    const double mean_weight = weight_sum / num_weighted;
+    for (double& weight : weights) {
+      if (weight <= 0) weight = mean_weight;
+    }
+    schedule_ = BuildEdfSchedule(weights);
+  }
+  // Start at a random slot, so that channels built at the same time do not
+  // all pick the same backends in lockstep (see
+  // https://github.com/grpc/grpc-go/issues/2580).
+  // TODO(roth): rand(3) is not thread-safe.  This should be replaced with
+  // something better as part of https://github.com/grpc/grpc/issues/17891.
+  next_.store(static_cast<size_t>(rand()), std::memory_order_relaxed);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels (%" PRIuPTR
+            " weighted); schedule period %" PRIuPTR,
+            parent_, this, subchannel_list, subchannels_.size(), num_weighted,
+            schedule_.size());
+  }
+}
+
+WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
+    PickArgs /*args*/) {
+  const size_t slot = next_.fetch_add(1, std::memory_order_relaxed);
+  const size_t index = schedule_.empty()
+                           ? slot % subchannels_.size()
+                           : schedule_[slot % schedule_.size()];
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
+            parent_, this, index, subchannels_[index].subchannel.get());
+  }
+  if (oob_load_report_) {
+    return PickResult::Complete(subchannels_[index].subchannel);
+  }
+  return PickResult::Complete(
+      subchannels_[index].subchannel,
+      absl::make_unique<CallTracker>(subchannels_[index].weight));
+}
+
+//
+// WeightedRoundRobin
+//
+
+WeightedRoundRobin::WeightedRoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  GRPC_CLOSURE_INIT(&on_weight_update_timer_, &OnWeightUpdateTimer, this,
+                    grpc_schedule_on_exec_ctx);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+  }
+}
+
+WeightedRoundRobin::~WeightedRoundRobin() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Destroying Weighted Round Robin policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void WeightedRoundRobin::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  if (weight_update_timer_pending_) {
+    grpc_timer_cancel(&weight_update_timer_);
+    weight_update_timer_pending_ = false;
+  }
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+  weights_.clear();
+}
+
+void WeightedRoundRobin::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+RefCountedPtr<WeightedRoundRobin::SubchannelWeight>
+WeightedRoundRobin::GetOrCreateWeightLocked(const std::string& address) {
+  RefCountedPtr<SubchannelWeight>& weight = weights_[address];
+  if (weight == nullptr) weight = MakeRefCounted<SubchannelWeight>();
+  return weight;
+}
+
+void WeightedRoundRobin::PruneWeightsLocked() {
+  std::map<std::string, RefCountedPtr<SubchannelWeight>> weights;
+  for (WeightedRoundRobinSubchannelList* list :
+       {subchannel_list_.get(), latest_pending_subchannel_list_.get()}) {
+    if (list == nullptr) continue;
+    for (size_t i = 0; i < list->num_subchannels(); ++i) {
+      WeightedRoundRobinSubchannelData* sd = list->subchannel(i);
+      weights.emplace(sd->address(), sd->weight());
+    }
+  }
+  weights_ = std::move(weights);
+}
+
+void WeightedRoundRobin::MaybeStartWeightUpdateTimerLocked() {
+  if (weight_update_timer_pending_ || shutdown_) return;
+  Ref(DEBUG_LOCATION, "OnWeightUpdateTimer").release();
+  weight_update_timer_pending_ = true;
+  grpc_timer_init(&weight_update_timer_,
+                  ExecCtx::Get()->Now() + config_->weight_update_period(),
+                  &on_weight_update_timer_);
+}
+
+void WeightedRoundRobin::OnWeightUpdateTimer(void* arg,
+                                             grpc_error_handle error) {
+  WeightedRoundRobin* self = static_cast<WeightedRoundRobin*>(arg);
+  (void)GRPC_ERROR_REF(error);  // ref owned by lambda
+  self->work_serializer()->Run(
+      [self, error]() { self->OnWeightUpdateTimerLocked(error); },
+      DEBUG_LOCATION);
+}
+
+void WeightedRoundRobin::OnWeightUpdateTimerLocked(grpc_error_handle error) {
+  if (error == GRPC_ERROR_NONE && weight_update_timer_pending_ && !shutdown_) {
+    weight_update_timer_pending_ = false;
+    // Reports a picker with a fresh schedule, and restarts the timer if the
+    // policy is still READY.
+    if (subchannel_list_ != nullptr) {
+      subchannel_list_->MaybeUpdateWeightedRoundRobinConnectivityStateLocked();
+    }
+  }
+  Unref(DEBUG_LOCATION, "OnWeightUpdateTimer");
+  GRPC_ERROR_UNREF(error);
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    StartWatchingLocked() {
+  if (num_subchannels() == 0) return;
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->subchannel()->AttemptToConnect();
+    }
+  }
+  // Now set the LB policy's state based on the subchannels' states.
+  UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked();
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                              grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+// Sets the policy's connectivity state and generates a new picker based
+// on the current subchannel list.  The aggregation rules are the same as
+// round_robin's.
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    MaybeUpdateWeightedRoundRobinConnectivityStateLocked() {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  if (num_ready_ > 0) {
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, absl::Status(), absl::make_unique<Picker>(p, this));
+    p->MaybeStartWeightUpdateTimerLocked();
+  } else if (num_connecting_ > 0) {
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    absl::Status status =
+        absl::UnavailableError("connections to all backends failing");
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+  }
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelList::
+    UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked() {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // If we have at least one READY subchannel, then swap to the new list.
+  // Also, if all of the subchannels are in TRANSIENT_FAILURE, then we know
+  // we've tried all of them and failed, so we go ahead and swap over
+  // anyway; this may cause the channel to go from READY to TRANSIENT_FAILURE,
+  // but we are doing what the control plane told us to do.
+  if (num_ready_ > 0 || num_transient_failure_ == num_subchannels()) {
+    if (p->subchannel_list_.get() != this) {
+      // Promote this list to p->subchannel_list_.
+      // This list must be p->latest_pending_subchannel_list_, because
+      // any previous update would have been shut down already and
+      // therefore we would not be receiving a notification for them.
+      GPR_ASSERT(p->latest_pending_subchannel_list_.get() == this);
+      GPR_ASSERT(!shutting_down());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+        const size_t old_num_subchannels =
+            p->subchannel_list_ != nullptr
+                ? p->subchannel_list_->num_subchannels()
+                : 0;
+        gpr_log(GPR_INFO,
+                "[WRR %p] phasing out subchannel list %p (size %" PRIuPTR
+                ") in favor of %p (size %" PRIuPTR ")",
+                p, p->subchannel_list_.get(), old_num_subchannels, this,
+                num_subchannels());
+      }
+      p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+      p->PruneWeightsLocked();
+    }
+  }
+  // Update the policy's connectivity state if needed.
+  MaybeUpdateWeightedRoundRobinConnectivityStateLocked();
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    UpdateConnectivityStateLocked(grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[WRR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        ConnectivityStateName(last_connectivity_state_),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Decide what state to report for aggregation purposes.
+  // If we haven't seen a failure since the last time we were in state
+  // READY, then we report the state change as-is.  However, once we do see
+  // a failure, we report TRANSIENT_FAILURE and do not report any subsequent
+  // state changes until we go back into state READY.
+  if (!seen_failure_since_ready_) {
+    if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      seen_failure_since_ready_ = true;
+    }
+    subchannel_list()->UpdateStateCountersLocked(last_connectivity_state_,
+                                                 connectivity_state);
+  } else {
+    if (connectivity_state == GRPC_CHANNEL_READY) {
+      seen_failure_since_ready_ = false;
+      subchannel_list()->UpdateStateCountersLocked(
+          GRPC_CHANNEL_TRANSIENT_FAILURE, connectivity_state);
+    }
+  }
+  // Record last seen connectivity state.
+  last_connectivity_state_ = connectivity_state;
+}
+
+void WeightedRoundRobin::WeightedRoundRobinSubchannelData::
+    ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE, re-resolve.
+  // Only do this if we've started watching, not at startup time.
+  // Otherwise, if the subchannel was already in state TRANSIENT_FAILURE
+  // when the subchannel list was created, we'd wind up in a constant
+  // loop of re-resolution.
+  // Also attempt to reconnect.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p has gone into TRANSIENT_FAILURE. "
+              "Requesting re-resolution",
+              p, subchannel());
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->AttemptToConnect();
+  }
+  // Update state counters.
+  UpdateConnectivityStateLocked(connectivity_state);
+  // Update overall state and renew notification.
+  subchannel_list()
+      ->UpdateWeightedRoundRobinStateFromSubchannelStateCountsLocked();
+}
+
+void WeightedRoundRobin::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] received update with %" PRIuPTR " addresses",
+            this, args.addresses.size());
+  }
+  config_ = std::move(args.config);
+  // Replace latest_pending_subchannel_list_.
+  if (latest_pending_subchannel_list_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_weighted_round_robin_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Shutting down previous pending subchannel list %p",
+              this, latest_pending_subchannel_list_.get());
+    }
+  }
+  // The new list picks up the weights of the addresses it shares with the
+  // current one.
+  latest_pending_subchannel_list_ =
+      MakeOrphanable<WeightedRoundRobinSubchannelList>(
+          this, &grpc_lb_weighted_round_robin_trace, std::move(args.addresses),
+          *args.args);
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    // If the new list is empty, immediately promote the new list to the
+    // current list and transition to TRANSIENT_FAILURE.
+    absl::Status status = absl::UnavailableError("Empty update");
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  } else if (subchannel_list_ == nullptr) {
+    // If there is no current list, immediately promote the new list to
+    // the current list and start watching it.
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    subchannel_list_->StartWatchingLocked();
+  } else {
+    // Start watching the pending list.  It will get swapped into the
+    // current list when it reports READY.
+    latest_pending_subchannel_list_->StartWatchingLocked();
+  }
+  PruneWeightsLocked();
+}
+
+//
+// factory
+//
+
+class WeightedRoundRobinFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<WeightedRoundRobin>(std::move(args));
+  }
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    std::vector<grpc_error_handle> error_list;
+    grpc_millis blackout_period = kDefaultBlackoutPeriod;
+    grpc_millis weight_expiration_period = kDefaultWeightExpirationPeriod;
+    grpc_millis weight_update_period = kDefaultWeightUpdatePeriod;
+    bool enable_oob_load_report = false;
+    grpc_millis oob_reporting_period = kDefaultOobReportingPeriod;
+    if (json.type() != Json::Type::OBJECT) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "weighted_round_robin_experimental should be of type object"));
+    } else {
+      ParseJsonObjectFieldAsDuration(json.object_value(), "blackoutPeriod",
+                                     &blackout_period, &error_list,
+                                     /*required=*/false);
+      ParseJsonObjectFieldAsDuration(
+          json.object_value(), "weightExpirationPeriod",
+          &weight_expiration_period, &error_list, /*required=*/false);
+      ParseJsonObjectFieldAsDuration(json.object_value(), "weightUpdatePeriod",
+                                     &weight_update_period, &error_list,
+                                     /*required=*/false);
+      ParseJsonObjectField(json.object_value(), "enableOobLoadReport",
+                           &enable_oob_load_report, &error_list,
+                           /*required=*/false);
+      ParseJsonObjectFieldAsDuration(json.object_value(), "oobReportingPeriod",
+                                     &oob_reporting_period, &error_list,
+                                     /*required=*/false);
+    }
+    if (error_list.empty()) {
+      return MakeRefCounted<WeightedRoundRobinConfig>(
+          blackout_period, weight_expiration_period,
+          std::max(weight_update_period, kMinWeightUpdatePeriod),
+          enable_oob_load_report, oob_reporting_period);
+    } else {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "weighted_round_robin_experimental LB policy config", &error_list);
+      return nullptr;
+    }
+  }
+};
+
+}  // namespace
+
+void GrpcLbPolicyWeightedRoundRobinInit() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          absl::make_unique<grpc_core::WeightedRoundRobinFactory>());
+}
+
+void GrpcLbPolicyWeightedRoundRobinShutdown() {}
+
+}  // namespace grpc_core
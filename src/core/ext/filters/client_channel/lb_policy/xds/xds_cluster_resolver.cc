@@ -28,6 +28,7 @@
 #include "src/core/ext/filters/client_channel/lb_policy.h"
 #include "src/core/ext/filters/client_channel/lb_policy/address_filtering.h"
 #include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
+#include "src/core/ext/filters/client_channel/lb_policy/least_request/least_request.h"
 #include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds.h"
 #include "src/core/ext/filters/client_channel/lb_policy/xds/xds_channel_args.h"
@@ -876,7 +877,25 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
                          .discovery_mechanism->override_child_policy();
     } else {
       const auto& xds_lb_policy = config_->xds_lb_policy().object_value();
-      if (xds_lb_policy.find("ROUND_ROBIN") != xds_lb_policy.end()) {
+      auto least_request_it = xds_lb_policy.find("LEAST_REQUEST");
+      if (xds_lb_policy.find("ROUND_ROBIN") != xds_lb_policy.end() ||
+          least_request_it != xds_lb_policy.end()) {
+        // Both policies pick endpoints within each locality, so they only
+        // differ in the child policy of each weighted target.
+        Json endpoint_picking_policy;
+        if (least_request_it != xds_lb_policy.end()) {
+          endpoint_picking_policy = Json::Array{
+              Json::Object{
+                  {"least_request_experimental", least_request_it->second},
+              },
+          };
+        } else {
+          endpoint_picking_policy = Json::Array{
+              Json::Object{
+                  {"round_robin", Json::Object()},
+              },
+          };
+        }
         const auto& localities = priority_list_[priority].localities;
         Json::Object weighted_targets;
         for (const auto& p : localities) {
@@ -897,12 +916,7 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
           weighted_targets[locality_name->AsHumanReadableString()] =
               Json::Object{
                   {"weight", locality.lb_weight},
-                  {"childPolicy",
-                   Json::Array{
-                       Json::Object{
-                           {"round_robin", Json::Object()},
-                       },
-                   }},
+                  {"childPolicy", endpoint_picking_policy},
               };
         }
         // Construct locality-picking policy.
@@ -1203,10 +1217,15 @@ class XdsClusterResolverLbFactory : public LoadBalancingPolicyFactory {
           policy_it = policy.find("RING_HASH");
           if (policy_it != policy.end()) {
             xds_lb_policy = array[i];
-            size_t min_ring_size;
-            size_t max_ring_size;
-            ParseRingHashLbConfig(policy_it->second, &min_ring_size,
-                                  &max_ring_size, &error_list);
+            RingHashLbParams params;
+            ParseRingHashLbConfig(policy_it->second, &params, &error_list);
+          }
+          policy_it = policy.find("LEAST_REQUEST");
+          if (policy_it != policy.end()) {
+            xds_lb_policy = array[i];
+            uint32_t choice_count;
+            ParseLeastRequestLbConfig(policy_it->second, &choice_count,
+                                      &error_list);
           }
         }
       }
@@ -26,6 +26,7 @@
 #include "xxhash.h"
 
 #include "src/core/ext/filters/client_channel/config_selector.h"
+#include "src/core/ext/filters/client_channel/lb_policy/pick_random.h"
 #include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
 #include "src/core/ext/filters/client_channel/resolver_registry.h"
 #include "src/core/ext/xds/xds_channel_args.h"
@@ -646,7 +647,7 @@ absl::optional<uint64_t> HeaderHashHelper(
 
 bool UnderFraction(const uint32_t fraction_per_million) {
   // Generate a random number in [0, 1000000).
-  const uint32_t random_number = rand() % 1000000;
+  const uint32_t random_number = PickRandom() % 1000000;
   return random_number < fraction_per_million;
 }
 
@@ -686,7 +687,7 @@ ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
       method_config = entry.method_config;
     } else {
       const uint32_t key =
-          rand() %
+          PickRandom() %
           entry.weighted_cluster_state[entry.weighted_cluster_state.size() - 1]
               .range_end;
       // Find the index in weighted clusters corresponding to key.
@@ -742,12 +743,7 @@ ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     }
     if (!hash.has_value()) {
       // If there is no hash, we just choose a random value as a default.
-      // We cannot directly use the result of rand() as the hash value,
-      // since it is a 32-bit number and not a 64-bit number and will
-      // therefore not be evenly distributed.
-      uint32_t upper = rand();
-      uint32_t lower = rand();
-      hash = (static_cast<uint64_t>(upper) << 32) | lower;
+      hash = PickRandom();
     }
     CallConfig call_config;
     if (method_config != nullptr) {
@@ -758,7 +754,7 @@ ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     call_config.call_attributes[kXdsClusterAttribute] = it->first;
     std::string hash_string = absl::StrCat(hash.value());
     char* hash_value =
-        static_cast<char*>(args.arena->Alloc(hash_string.size() + 1));
+        static_cast<char*>(args.arena->Alloc(hash_string.size() + 1, 1));
     memcpy(hash_value, hash_string.c_str(), hash_string.size());
     hash_value[hash_string.size()] = '\0';
     call_config.call_attributes[kRequestRingHashAttribute] = hash_value;
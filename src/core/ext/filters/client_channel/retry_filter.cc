@@ -18,6 +18,8 @@
 
 #include "src/core/ext/filters/client_channel/retry_filter.h"
 
+#include <algorithm>
+
 #include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/strip.h"
@@ -35,6 +37,7 @@
 #include "src/core/lib/channel/status_util.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/polling_entity.h"
+#include "src/core/lib/iomgr/resource_quota.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/error_utils.h"
@@ -85,10 +88,17 @@
 // When constructing the "child" batches, we compare the state in the
 // CallAttempt object against the state in the CallData object to see
 // which batches need to be sent on the LB call for a given attempt.
+//
+// When the method has a hedging policy instead of a retry policy, we
+// start a new call attempt every hedgingDelay, up to maxAttempts, without
+// waiting for the earlier ones to fail.  All attempts in flight are kept
+// in CallData, and batches from the surface are started on each of them.
+// The first attempt to commit wins, and the others are cancelled.  Since
+// attempts read the cached send ops concurrently, the cache is filled
+// eagerly and kept until the call is destroyed.
 
 // TODO(roth): In subsequent PRs:
 // - add support for transparent retries (including initial metadata)
-// - implement hedging
 
 // By default, we buffer 256 KiB per RPC for retries.
 // TODO(roth): Do we have any data to suggest a better value?
@@ -148,6 +158,15 @@ class RetryFilter {
       : client_channel_(grpc_channel_args_find_pointer<ClientChannel>(
             args, GRPC_ARG_CLIENT_CHANNEL)),
         per_rpc_retry_buffer_size_(GetMaxPerRpcRetryBufferSize(args)) {
+    // If the application configured a resource quota, charge the data
+    // buffered for retries to it.
+    grpc_resource_quota* resource_quota =
+        grpc_resource_quota_from_channel_args(args, /*create=*/false);
+    if (resource_quota != nullptr) {
+      resource_user_ =
+          grpc_resource_user_create(resource_quota, "retry_filter");
+      grpc_resource_quota_unref_internal(resource_quota);
+    }
     // Get retry throttling parameters from service config.
     auto* service_config = grpc_channel_args_find_pointer<ServiceConfig>(
         args, GRPC_ARG_SERVICE_CONFIG_OBJ);
@@ -177,8 +196,13 @@ class RetryFilter {
         server_name, config->max_milli_tokens(), config->milli_token_ratio());
   }
 
+  ~RetryFilter() {
+    if (resource_user_ != nullptr) grpc_resource_user_unref(resource_user_);
+  }
+
   ClientChannel* client_channel_;
   size_t per_rpc_retry_buffer_size_;
+  grpc_resource_user* resource_user_ = nullptr;
   RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_;
 };
 
@@ -206,6 +230,10 @@ class RetryFilter::CallData {
     grpc_transport_stream_op_batch* batch = nullptr;
     // Indicates whether payload for send ops has been cached in CallData.
     bool send_ops_cached = false;
+    // Bytes reserved from the resource quota for the batch's send ops.
+    // Handed over to CallData when the send ops are cached.
+    size_t send_initial_metadata_reserved_bytes = 0;
+    size_t send_message_reserved_bytes = 0;
   };
 
   // State associated with each call attempt.
@@ -216,10 +244,19 @@ class RetryFilter::CallData {
 
     bool lb_call_committed() const { return lb_call_committed_; }
 
+    // Returns the number of send ops started on this call attempt.
+    size_t num_started_send_ops() const {
+      return started_send_initial_metadata_ + started_send_message_count_ +
+             started_send_trailing_metadata_;
+    }
+
     // Constructs and starts whatever batches are needed on this call
     // attempt.
     void StartRetriableBatches();
 
+    // Adds whatever batches are needed on this attempt to closures.
+    void AddRetriableBatches(CallCombinerClosureList* closures);
+
     // Frees cached send ops that have already been completed after
     // committing the call.
     void FreeCachedSendOpDataAfterCommit();
@@ -227,6 +264,10 @@ class RetryFilter::CallData {
     // Cancels the call attempt.
     void CancelFromSurface(grpc_transport_stream_op_batch* cancel_batch);
 
+    // Abandons a hedged call attempt that lost to another one, adding a
+    // batch to closures to cancel it.
+    void AbandonAndCancel(CallCombinerClosureList* closures);
+
    private:
     // State used for starting a retryable batch on the call attempt's LB call.
     // This provides its own grpc_transport_stream_op_batch and other data
@@ -334,7 +375,7 @@ class RetryFilter::CallData {
       void Commit() override {
         call_attempt_->lb_call_committed_ = true;
         auto* calld = call_attempt_->calld_;
-        if (calld->retry_committed_) {
+        if (calld->retry_committed_ && !call_attempt_->abandoned_) {
           auto* service_config_call_data =
               static_cast<ClientChannelServiceConfigCallData*>(
                   calld->call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA]
@@ -380,9 +421,6 @@ class RetryFilter::CallData {
     // Adds batches for pending batches to closures.
     void AddBatchesForPendingBatches(CallCombinerClosureList* closures);
 
-    // Adds whatever batches are needed on this attempt to closures.
-    void AddRetriableBatches(CallCombinerClosureList* closures);
-
     // Returns true if any send op in the batch was not yet started on this
     // attempt.
     bool PendingBatchContainsUnstartedSendOps(PendingBatch* pending);
@@ -401,6 +439,13 @@ class RetryFilter::CallData {
                      grpc_mdelem* server_pushback_md,
                      grpc_millis* server_pushback_ms);
 
+    // Hedging counterpart of ShouldRetry().  Returns true if this attempt
+    // should be abandoned in favor of other hedged attempts, either ones
+    // already in flight or ones yet to be started.
+    bool ShouldHedge(grpc_status_code status, bool is_lb_drop,
+                     grpc_mdelem* server_pushback_md,
+                     grpc_millis* server_pushback_ms);
+
     // Abandons the call attempt.  Unrefs any deferred batches.
     void Abandon();
 
@@ -409,6 +454,8 @@ class RetryFilter::CallData {
     void MaybeCancelPerAttemptRecvTimer();
 
     CallData* calld_;
+    // The number of attempts started on the call before this one.
+    const int num_previous_attempts_;
     AttemptDispatchController attempt_dispatch_controller_;
     OrphanablePtr<ClientChannel::LoadBalancedCall> lb_call_;
     bool lb_call_committed_ = false;
@@ -505,16 +552,34 @@ class RetryFilter::CallData {
   void FreeCachedSendTrailingMetadata();
   void FreeAllCachedSendOpData();
 
+  // Returns *reserved_bytes to the resource quota and resets it to 0.
+  void ReleaseRetryBufferReservation(size_t* reserved_bytes);
+
+  bool hedging() const {
+    return retry_policy_ != nullptr && retry_policy_->hedging();
+  }
+
   // Commits the call so that no further retry attempts will be performed.
+  // When hedging, also cancels all call attempts other than call_attempt.
   void RetryCommit(CallAttempt* call_attempt);
 
-  // Starts a timer to retry after appropriate back-off.
-  // If server_pushback_ms is -1, retry_backoff_ is used.
-  void StartRetryTimer(grpc_millis server_pushback_ms);
+  // Drops the failed call_attempt and starts a timer for the next attempt.
+  // If server_pushback_ms is -1, retry_backoff_ is used when retrying and
+  // the next hedged attempt starts right away when hedging.
+  void StartRetryTimer(CallAttempt* call_attempt,
+                       grpc_millis server_pushback_ms);
+
+  // Starts the next call attempt at next_attempt_time, replacing any
+  // pending retry timer.
+  void ArmRetryTimer(grpc_millis next_attempt_time);
+  void CancelRetryTimer();
 
   static void OnRetryTimer(void* arg, grpc_error_handle error);
   static void OnRetryTimerLocked(void* arg, grpc_error_handle error);
 
+  // Returns true if another hedged attempt may be started.
+  bool CanStartHedgedAttempt();
+
   OrphanablePtr<ClientChannel::LoadBalancedCall> CreateLoadBalancedCall(
       ConfigSelector::CallDispatchController* call_dispatch_controller);
 
@@ -537,10 +602,8 @@ class RetryFilter::CallData {
 
   RefCountedPtr<CallStackDestructionBarrier> call_stack_destruction_barrier_;
 
-  // TODO(roth): As part of implementing hedging, we will need to maintain a
-  // list of all pending attempts, so that we can cancel them all if the call
-  // gets cancelled.
-  RefCountedPtr<CallAttempt> call_attempt_;
+  // The call attempts in flight.  There is at most one unless hedging.
+  absl::InlinedVector<RefCountedPtr<CallAttempt>, 1> call_attempts_;
 
   // LB call used when we've committed to a call attempt and the retry
   // state for that attempt is no longer needed.  This provides a fast
@@ -560,16 +623,28 @@ class RetryFilter::CallData {
 
   // Retry state.
   bool retry_committed_ : 1;
-  bool retry_timer_pending_ : 1;
+  // Set when throttling or server push-back rules out further hedged
+  // attempts.
+  bool hedging_stopped_ : 1;
+  int num_attempts_started_ = 0;
   int num_attempts_completed_ = 0;
-  grpc_timer retry_timer_;
-  grpc_closure retry_closure_;
+  // Timer for starting the next call attempt, or null if none is pending.
+  // A new one is allocated for each use, since the callback of a
+  // cancelled timer may still be pending when the next one is started.
+  struct RetryTimer {
+    CallData* calld;
+    grpc_timer timer;
+    grpc_closure closure;
+  };
+  RetryTimer* retry_timer_ = nullptr;
 
   // Cached data for retrying send ops.
   // send_initial_metadata
   bool seen_send_initial_metadata_ = false;
   grpc_metadata_batch send_initial_metadata_{arena_};
   uint32_t send_initial_metadata_flags_;
+  // Bytes reserved from the resource quota for send_initial_metadata_.
+  size_t send_initial_metadata_reserved_bytes_ = 0;
   // TODO(roth): As part of implementing hedging, we'll probably need to
   // have the LB call set a value in CallAttempt and then propagate it
   // from CallAttempt to the parent call when we commit.  Otherwise, we
@@ -586,11 +661,11 @@ class RetryFilter::CallData {
   // Note: We inline the cache for the first 3 send_message ops and use
   // dynamic allocation after that.  This number was essentially picked
   // at random; it could be changed in the future to tune performance.
-  // TODO(roth): As part of implementing hedging, we may need some
-  // synchronization here, since ByteStreamCache does not provide any
-  // synchronization, so it's not safe to have multiple
-  // CachingByteStreams read from the same ByteStreamCache concurrently.
+  // When hedging, each cache is filled as soon as it is created, so that
+  // the attempts can read it concurrently.
   absl::InlinedVector<ByteStreamCache*, 3> send_messages_;
+  // Bytes reserved from the resource quota for each of send_messages_.
+  absl::InlinedVector<size_t, 3> send_message_reserved_bytes_;
   // send_trailing_metadata
   bool seen_send_trailing_metadata_ = false;
   grpc_metadata_batch send_trailing_metadata_{arena_};
@@ -657,6 +732,7 @@ RetryFilter::CallData::CallAttempt::CallAttempt(CallData* calld)
     : RefCounted(GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace) ? "CallAttempt"
                                                            : nullptr),
       calld_(calld),
+      num_previous_attempts_(calld->num_attempts_started_),
       attempt_dispatch_controller_(this),
       batch_payload_(calld->call_context_),
       started_send_initial_metadata_(false),
@@ -706,10 +782,9 @@ RetryFilter::CallData::CallAttempt::~CallAttempt() {
 }
 
 void RetryFilter::CallData::CallAttempt::FreeCachedSendOpDataAfterCommit() {
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // When hedging, abandoned attempts may still be reading this data, so
+  // it is kept until the call is destroyed.
+  if (calld_->hedging()) return;
   if (completed_send_initial_metadata_) {
     calld_->FreeCachedSendInitialMetadata();
   }
@@ -750,11 +825,10 @@ bool RetryFilter::CallData::CallAttempt::HaveSendOpsToReplay() {
 
 void RetryFilter::CallData::CallAttempt::MaybeSwitchToFastPath() {
   // If we're not yet committed, we can't switch yet.
-  // TODO(roth): As part of implementing hedging, this logic needs to
-  // check that *this* call attempt is the one that we've committed to.
-  // Might need to replace abandoned_ with an enum indicating whether we're
-  // in flight, abandoned, or the winning call attempt.
   if (!calld_->retry_committed_) return;
+  // Once committed, the only attempt that is not abandoned is the one
+  // that we've committed to.
+  if (abandoned_) return;
   // If we've already switched to fast path, there's nothing to do here.
   if (calld_->committed_call_ != nullptr) return;
   // If the perAttemptRecvTimeout timer is pending, we can't switch yet.
@@ -772,7 +846,7 @@ void RetryFilter::CallData::CallAttempt::MaybeSwitchToFastPath() {
             calld_->chand_, calld_, this);
   }
   calld_->committed_call_ = std::move(lb_call_);
-  calld_->call_attempt_.reset(DEBUG_LOCATION, "MaybeSwitchToFastPath");
+  calld_->call_attempts_.clear();
 }
 
 // If there are any cached send ops that need to be replayed on the
@@ -1063,6 +1137,22 @@ void RetryFilter::CallData::CallAttempt::CancelFromSurface(
   lb_call_->StartTransportStreamOpBatch(cancel_batch);
 }
 
+void RetryFilter::CallData::CallAttempt::AbandonAndCancel(
+    CallCombinerClosureList* closures) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p attempt=%p: cancelling losing hedged attempt",
+            calld_->chand_, calld_, this);
+  }
+  MaybeCancelPerAttemptRecvTimer();
+  Abandon();
+  AddBatchForCancelOp(
+      grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                             "another hedged attempt was committed"),
+                         GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED),
+      closures);
+}
+
 bool RetryFilter::CallData::CallAttempt::ShouldRetry(
     absl::optional<grpc_status_code> status, bool is_lb_drop,
     grpc_mdelem* server_pushback_md, grpc_millis* server_pushback_ms) {
@@ -1169,6 +1259,70 @@ bool RetryFilter::CallData::CallAttempt::ShouldRetry(
   return true;
 }
 
+bool RetryFilter::CallData::CallAttempt::ShouldHedge(
+    grpc_status_code status, bool is_lb_drop, grpc_mdelem* server_pushback_md,
+    grpc_millis* server_pushback_ms) {
+  // LB drops always inhibit hedging.
+  if (is_lb_drop) return false;
+  if (GPR_LIKELY(status == GRPC_STATUS_OK)) {
+    if (calld_->retry_throttle_data_ != nullptr) {
+      calld_->retry_throttle_data_->RecordSuccess();
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p attempt=%p: call succeeded",
+              calld_->chand_, calld_, this);
+    }
+    return false;
+  }
+  // A fatal status is returned to the application right away, even if
+  // other attempts are still in flight.
+  if (!calld_->retry_policy_->non_fatal_status_codes().Contains(status)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: status %s not configured as "
+              "non-fatal",
+              calld_->chand_, calld_, this, grpc_status_code_to_string(status));
+    }
+    return false;
+  }
+  // Record the failure.  If hedging is throttled, we stop starting new
+  // attempts, but the ones already in flight may still succeed.
+  if (calld_->retry_throttle_data_ != nullptr &&
+      !calld_->retry_throttle_data_->RecordFailure()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p attempt=%p: hedging throttled",
+              calld_->chand_, calld_, this);
+    }
+    calld_->hedging_stopped_ = true;
+  }
+  // Check whether the call is committed.
+  if (calld_->retry_committed_) return false;
+  // Check server push-back.  A valid value replaces the hedging delay
+  // for the next attempt; any other value stops hedging.
+  if (server_pushback_md != nullptr) {
+    uint32_t ms;
+    if (!grpc_parse_slice_to_uint32(GRPC_MDVALUE(*server_pushback_md), &ms)) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p attempt=%p: server push-back stops "
+                "hedging",
+                calld_->chand_, calld_, this);
+      }
+      calld_->hedging_stopped_ = true;
+    } else {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p attempt=%p: server push-back: next hedged "
+                "attempt in %u ms",
+                calld_->chand_, calld_, this, ms);
+      }
+      *server_pushback_ms = static_cast<grpc_millis>(ms);
+    }
+  }
+  // Abandon this attempt if another one may still succeed.
+  return calld_->call_attempts_.size() > 1 || calld_->CanStartHedgedAttempt();
+}
+
 void RetryFilter::CallData::CallAttempt::Abandon() {
   abandoned_ = true;
   // Unref batches for deferred completion callbacks that will now never
@@ -1240,7 +1394,7 @@ void RetryFilter::CallData::CallAttempt::OnPerAttemptRecvTimerLocked(
       // Mark current attempt as abandoned.
       call_attempt->Abandon();
       // We are retrying.  Start backoff timer.
-      calld->StartRetryTimer(/*server_pushback_ms=*/-1);
+      calld->StartRetryTimer(call_attempt, /*server_pushback_ms=*/-1);
     } else {
       // Not retrying, so commit the call.
       calld->RetryCommit(call_attempt);
@@ -1310,10 +1464,9 @@ RetryFilter::CallData::CallAttempt::BatchData::~BatchData() {
 void RetryFilter::CallData::CallAttempt::BatchData::
     FreeCachedSendOpDataForCompletedBatch() {
   auto* calld = call_attempt_->calld_;
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // When hedging, abandoned attempts may still be reading this data, so
+  // it is kept until the call is destroyed.
+  if (calld->hedging()) return;
   if (batch_.send_initial_metadata) {
     calld->FreeCachedSendInitialMetadata();
   }
@@ -1700,10 +1853,15 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
   }
   // Check if we should retry.
   grpc_millis server_pushback_ms = -1;
-  if (call_attempt->ShouldRetry(status, is_lb_drop, server_pushback_md,
-                                &server_pushback_ms)) {
+  const bool retry =
+      calld->hedging()
+          ? call_attempt->ShouldHedge(status, is_lb_drop, server_pushback_md,
+                                      &server_pushback_ms)
+          : call_attempt->ShouldRetry(status, is_lb_drop, server_pushback_md,
+                                      &server_pushback_ms);
+  if (retry) {
     // Start retry timer.
-    calld->StartRetryTimer(server_pushback_ms);
+    calld->StartRetryTimer(call_attempt, server_pushback_ms);
     // Cancel call attempt.
     CallCombinerClosureList closures;
     call_attempt->AddBatchForCancelOp(
@@ -1746,8 +1904,14 @@ void RetryFilter::CallData::CallAttempt::BatchData::
                batch_.send_trailing_metadata == batch->send_trailing_metadata;
       });
   // If batch_data is a replay batch, then there will be no pending
-  // batch to complete.
-  if (pending == nullptr) {
+  // batch to complete.  The same goes for a send_message op that is not
+  // the one in the pending batch, which can happen when another attempt
+  // has already completed it and the surface has sent the next message.
+  if (pending == nullptr ||
+      (batch_.send_message &&
+       (!pending->send_ops_cached ||
+        call_attempt_->completed_send_message_count_ !=
+            calld->send_messages_.size()))) {
     GRPC_ERROR_UNREF(error);
     return;
   }
@@ -1909,10 +2073,11 @@ void RetryFilter::CallData::CallAttempt::BatchData::
     call_attempt_->send_initial_metadata_.Remove(
         GRPC_BATCH_GRPC_PREVIOUS_RPC_ATTEMPTS);
   }
-  if (GPR_UNLIKELY(calld->num_attempts_completed_ > 0)) {
+  if (GPR_UNLIKELY(call_attempt_->num_previous_attempts_ > 0)) {
     grpc_mdelem retry_md = grpc_mdelem_create(
         GRPC_MDSTR_GRPC_PREVIOUS_RPC_ATTEMPTS,
-        *retry_count_strings[calld->num_attempts_completed_ - 1], nullptr);
+        *retry_count_strings[call_attempt_->num_previous_attempts_ - 1],
+        nullptr);
     grpc_error_handle error = grpc_metadata_batch_add_tail(
         &call_attempt_->send_initial_metadata_,
         &call_attempt_->retry_attempts_metadata_, retry_md,
@@ -2103,10 +2268,17 @@ RetryFilter::CallData::CallData(RetryFilter* chand,
       pending_send_message_(false),
       pending_send_trailing_metadata_(false),
       retry_committed_(false),
-      retry_timer_pending_(false) {}
+      hedging_stopped_(false) {}
 
 RetryFilter::CallData::~CallData() {
   grpc_slice_unref_internal(path_);
+  // When hedging, cached send ops are not freed as attempts complete them.
+  if (hedging()) FreeAllCachedSendOpData();
+  // Return the reservations for cached send ops that no attempt completed.
+  ReleaseRetryBufferReservation(&send_initial_metadata_reserved_bytes_);
+  for (size_t& reserved_bytes : send_message_reserved_bytes_) {
+    ReleaseRetryBufferReservation(&reserved_bytes);
+  }
   // Make sure there are no remaining pending batches.
   for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
     GPR_ASSERT(pending_batches_[i].batch == nullptr);
@@ -2131,30 +2303,21 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     }
     // If we have a current call attempt, commit the call, then send
     // the cancellation down to that attempt.  When the call fails, it
-    // will not be retried, because we have committed it here.
-    if (call_attempt_ != nullptr) {
-      RetryCommit(call_attempt_.get());
-      // TODO(roth): When implementing hedging, this will get more
-      // complex, because instead of just passing the batch down to a
-      // single call attempt, we'll need to cancel multiple call
-      // attempts and wait for the cancellation on_complete from each call
-      // attempt before we propagate the on_complete from this batch
-      // back to the surface.
+    // will not be retried, because we have committed it here.  When
+    // hedging, committing also cancels all of the other attempts.
+    if (!call_attempts_.empty()) {
+      CallAttempt* call_attempt = call_attempts_.front().get();
+      RetryCommit(call_attempt);
       // Note: This will release the call combiner.
-      call_attempt_->CancelFromSurface(batch);
+      call_attempt->CancelFromSurface(batch);
       return;
     }
     // Save cancel_error in case subsequent batches are started.
     GRPC_ERROR_UNREF(cancelled_from_surface_);
     cancelled_from_surface_ = GRPC_ERROR_REF(cancel_error);
     // Cancel retry timer.
-    if (retry_timer_pending_) {
-      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
-        gpr_log(GPR_INFO, "chand=%p calld=%p: cancelling retry timer", chand_,
-                this);
-      }
-      retry_timer_pending_ = false;  // Lame timer callback.
-      grpc_timer_cancel(&retry_timer_);
+    if (retry_timer_ != nullptr) {
+      CancelRetryTimer();
       FreeAllCachedSendOpData();
     }
     // Fail pending batches.
@@ -2166,15 +2329,16 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
   }
   // Add the batch to the pending list.
   PendingBatch* pending = PendingBatchesAdd(batch);
-  // If the timer is pending, yield the call combiner and wait for it to
-  // run, since we don't want to start another call attempt until it does.
-  if (retry_timer_pending_) {
+  // If the timer is pending with no attempt in flight, yield the call
+  // combiner and wait for it to run, since we don't want to start another
+  // call attempt until it does.
+  if (call_attempts_.empty() && retry_timer_ != nullptr) {
     GRPC_CALL_COMBINER_STOP(call_combiner_,
                             "added pending batch while retry timer pending");
     return;
   }
   // If we do not yet have a call attempt, create one.
-  if (call_attempt_ == nullptr) {
+  if (call_attempts_.empty()) {
     // If we were previously cancelled from the surface, cancel this
     // batch instead of creating a call attempt.
     if (cancelled_from_surface_ != GRPC_ERROR_NONE) {
@@ -2204,7 +2368,7 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     // We also skip this optimization if perAttemptRecvTimeout is set in the
     // retry policy, because we need the code in CallAttempt to handle
     // the associated timer.
-    if (num_attempts_completed_ == 0 && retry_committed_ &&
+    if (num_attempts_started_ == 0 && retry_committed_ &&
         (retry_policy_ == nullptr ||
          !retry_policy_->per_attempt_recv_timeout().has_value())) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -2232,12 +2396,26 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     CreateCallAttempt();
     return;
   }
-  // Send batches to call attempt.
+  // Send batches to call attempts.
+  if (call_attempts_.size() == 1) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p",
+              chand_, this, call_attempts_.front().get());
+    }
+    call_attempts_.front()->StartRetriableBatches();
+    return;
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
-    gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p", chand_,
-            this, call_attempt_.get());
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: starting batch on %" PRIuPTR " attempts",
+            chand_, this, call_attempts_.size());
   }
-  call_attempt_->StartRetriableBatches();
+  CallCombinerClosureList closures;
+  for (auto& call_attempt : call_attempts_) {
+    call_attempt->AddRetriableBatches(&closures);
+  }
+  // Note: This will yield the call combiner.
+  closures.RunClosures(call_combiner_);
 }
 
 OrphanablePtr<ClientChannel::LoadBalancedCall>
@@ -2257,8 +2435,15 @@ RetryFilter::CallData::CreateLoadBalancedCall(
 }
 
 void RetryFilter::CallData::CreateCallAttempt() {
-  call_attempt_ = MakeRefCounted<CallAttempt>(this);
-  call_attempt_->StartRetriableBatches();
+  call_attempts_.emplace_back(MakeRefCounted<CallAttempt>(this));
+  CallAttempt* call_attempt = call_attempts_.back().get();
+  ++num_attempts_started_;
+  // When hedging, schedule the next attempt.
+  if (hedging() && !retry_committed_ && !hedging_stopped_ &&
+      num_attempts_started_ < retry_policy_->max_attempts()) {
+    ArmRetryTimer(ExecCtx::Get()->Now() + retry_policy_->hedging_delay());
+  }
+  call_attempt->StartRetriableBatches();
 }
 
 //
@@ -2278,12 +2463,27 @@ void RetryFilter::CallData::MaybeCacheSendOpsForBatch(PendingBatch* pending) {
     send_initial_metadata_flags_ =
         batch->payload->send_initial_metadata.send_initial_metadata_flags;
     peer_string_ = batch->payload->send_initial_metadata.peer_string;
+    send_initial_metadata_reserved_bytes_ =
+        pending->send_initial_metadata_reserved_bytes;
+    pending->send_initial_metadata_reserved_bytes = 0;
   }
   // Set up cache for send_message ops.
   if (batch->send_message) {
     ByteStreamCache* cache = arena_->New<ByteStreamCache>(
         std::move(batch->payload->send_message.send_message));
+    // Hedged attempts read the message concurrently, so cache it up front
+    // when the stream allows; any rest is cached as the attempts read it.
+    if (hedging() && !cache->Fill() &&
+        GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: send_message not fully available, caching "
+              "it lazily",
+              chand_, this);
+    }
     send_messages_.push_back(cache);
+    send_message_reserved_bytes_.push_back(
+        pending->send_message_reserved_bytes);
+    pending->send_message_reserved_bytes = 0;
   }
   // Save metadata batch for send_trailing_metadata ops.
   if (batch->send_trailing_metadata) {
@@ -2300,6 +2500,7 @@ void RetryFilter::CallData::FreeCachedSendInitialMetadata() {
             chand_, this);
   }
   send_initial_metadata_.Clear();
+  ReleaseRetryBufferReservation(&send_initial_metadata_reserved_bytes_);
 }
 
 void RetryFilter::CallData::FreeCachedSendMessage(size_t idx) {
@@ -2309,6 +2510,7 @@ void RetryFilter::CallData::FreeCachedSendMessage(size_t idx) {
             this, idx);
   }
   send_messages_[idx]->Destroy();
+  ReleaseRetryBufferReservation(&send_message_reserved_bytes_[idx]);
 }
 
 void RetryFilter::CallData::FreeCachedSendTrailingMetadata() {
@@ -2331,6 +2533,19 @@ void RetryFilter::CallData::FreeAllCachedSendOpData() {
   }
 }
 
+void RetryFilter::CallData::ReleaseRetryBufferReservation(
+    size_t* reserved_bytes) {
+  if (*reserved_bytes == 0) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: releasing %" PRIuPTR
+            " bytes reserved for retries",
+            chand_, this, *reserved_bytes);
+  }
+  grpc_resource_user_free(chand_->resource_user_, *reserved_bytes);
+  *reserved_bytes = 0;
+}
+
 //
 // pending_batches management
 //
@@ -2363,22 +2578,24 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
   // Also check if the batch takes us over the retry buffer limit.
   // Note: We don't check the size of trailing metadata here, because
   // gRPC clients do not send trailing metadata.
+  size_t send_initial_metadata_bytes = 0;
+  size_t send_message_bytes = 0;
   if (batch->send_initial_metadata) {
     pending_send_initial_metadata_ = true;
-    bytes_buffered_for_retry_ += batch->payload->send_initial_metadata
-                                     .send_initial_metadata->TransportSize();
+    send_initial_metadata_bytes =
+        batch->payload->send_initial_metadata.send_initial_metadata
+            ->TransportSize();
   }
   if (batch->send_message) {
     pending_send_message_ = true;
-    bytes_buffered_for_retry_ +=
-        batch->payload->send_message.send_message->length();
+    send_message_bytes = batch->payload->send_message.send_message->length();
   }
+  const size_t batch_bytes = send_initial_metadata_bytes + send_message_bytes;
   if (batch->send_trailing_metadata) {
     pending_send_trailing_metadata_ = true;
   }
-  // TODO(roth): When we implement hedging, if there are currently attempts
-  // in flight, we will need to pick the one on which the max number of send
-  // ops have already been sent, and we commit to that attempt.
+  bytes_buffered_for_retry_ += batch_bytes;
+  bool commit = false;
   if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
                    chand_->per_rpc_retry_buffer_size_)) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -2386,7 +2603,35 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
               "chand=%p calld=%p: exceeded retry buffer size, committing",
               chand_, this);
     }
-    RetryCommit(call_attempt_.get());
+    commit = true;
+  } else if (chand_->resource_user_ != nullptr && retry_policy_ != nullptr &&
+             !retry_committed_ && batch_bytes > 0) {
+    // Under memory pressure, give up on retries rather than buffer more
+    // data for them.
+    if (grpc_resource_user_safe_alloc(chand_->resource_user_, batch_bytes)) {
+      pending->send_initial_metadata_reserved_bytes =
+          send_initial_metadata_bytes;
+      pending->send_message_reserved_bytes = send_message_bytes;
+    } else {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p: resource quota exhausted, committing",
+                chand_, this);
+      }
+      commit = true;
+    }
+  }
+  if (GPR_UNLIKELY(commit)) {
+    // If there are hedged attempts in flight, commit to the one that has
+    // started the most send ops.
+    CallAttempt* call_attempt = nullptr;
+    for (auto& attempt : call_attempts_) {
+      if (call_attempt == nullptr || attempt->num_started_send_ops() >
+                                         call_attempt->num_started_send_ops()) {
+        call_attempt = attempt.get();
+      }
+    }
+    RetryCommit(call_attempt);
   }
   return pending;
 }
@@ -2401,6 +2646,9 @@ void RetryFilter::CallData::PendingBatchClear(PendingBatch* pending) {
   if (pending->batch->send_trailing_metadata) {
     pending_send_trailing_metadata_ = false;
   }
+  // Send ops that were never cached no longer need their reservation.
+  ReleaseRetryBufferReservation(&pending->send_initial_metadata_reserved_bytes);
+  ReleaseRetryBufferReservation(&pending->send_message_reserved_bytes);
   pending->batch = nullptr;
 }
 
@@ -2494,6 +2742,9 @@ void RetryFilter::CallData::RetryCommit(CallAttempt* call_attempt) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: committing retries", chand_, this);
   }
+  // Nothing more will be buffered for retries.  Whatever is still cached
+  // is freed, and its reservation returned, as soon as the committed
+  // attempt no longer needs it.
   if (call_attempt != nullptr) {
     // If the call attempt's LB call has been committed, inform the call
     // dispatch controller that the call has been committed.
@@ -2509,15 +2760,72 @@ void RetryFilter::CallData::RetryCommit(CallAttempt* call_attempt) {
     }
     // Free cached send ops.
     call_attempt->FreeCachedSendOpDataAfterCommit();
+    // When hedging, cancel the other attempts and stop starting new ones.
+    if (hedging()) {
+      CancelRetryTimer();
+      CallCombinerClosureList closures;
+      for (auto& attempt : call_attempts_) {
+        if (attempt.get() != call_attempt) attempt->AbandonAndCancel(&closures);
+      }
+      call_attempts_.erase(
+          std::remove_if(call_attempts_.begin(), call_attempts_.end(),
+                         [call_attempt](const RefCountedPtr<CallAttempt>& a) {
+                           return a.get() != call_attempt;
+                         }),
+          call_attempts_.end());
+      closures.RunClosuresWithoutYielding(call_combiner_);
+    }
   }
 }
 
-void RetryFilter::CallData::StartRetryTimer(grpc_millis server_pushback_ms) {
-  // Reset call attempt.
-  call_attempt_.reset(DEBUG_LOCATION, "StartRetryTimer");
+bool RetryFilter::CallData::CanStartHedgedAttempt() {
+  if (retry_committed_ || hedging_stopped_ ||
+      num_attempts_started_ >= retry_policy_->max_attempts()) {
+    return false;
+  }
+  if (retry_throttle_data_ != nullptr &&
+      !retry_throttle_data_->RetriesAllowed()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: hedging throttled", chand_, this);
+    }
+    return false;
+  }
+  auto* service_config_call_data =
+      static_cast<ClientChannelServiceConfigCallData*>(
+          call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value);
+  if (!service_config_call_data->call_dispatch_controller()->ShouldRetry()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p: call dispatch controller denied hedging",
+              chand_, this);
+    }
+    return false;
+  }
+  return true;
+}
+
+void RetryFilter::CallData::StartRetryTimer(CallAttempt* call_attempt,
+                                            grpc_millis server_pushback_ms) {
+  // Drop the call attempt.
+  call_attempts_.erase(
+      std::remove_if(call_attempts_.begin(), call_attempts_.end(),
+                     [call_attempt](const RefCountedPtr<CallAttempt>& a) {
+                       return a.get() == call_attempt;
+                     }),
+      call_attempts_.end());
   // Compute backoff delay.
   grpc_millis next_attempt_time;
-  if (server_pushback_ms >= 0) {
+  if (hedging()) {
+    // The next hedged attempt does not need to wait out the rest of the
+    // hedging delay, since this one has already failed.  If no more
+    // attempts can be started, leave the ones in flight to finish.
+    if (hedging_stopped_ ||
+        num_attempts_started_ >= retry_policy_->max_attempts()) {
+      return;
+    }
+    next_attempt_time =
+        ExecCtx::Get()->Now() + std::max<grpc_millis>(server_pushback_ms, 0);
+  } else if (server_pushback_ms >= 0) {
     next_attempt_time = ExecCtx::Get()->Now() + server_pushback_ms;
     retry_backoff_.Reset();
   } else {
@@ -2528,25 +2836,52 @@ void RetryFilter::CallData::StartRetryTimer(grpc_millis server_pushback_ms) {
             "chand=%p calld=%p: retrying failed call in %" PRId64 " ms", chand_,
             this, next_attempt_time - ExecCtx::Get()->Now());
   }
-  // Schedule retry after computed delay.
-  GRPC_CLOSURE_INIT(&retry_closure_, OnRetryTimer, this, nullptr);
+  ArmRetryTimer(next_attempt_time);
+}
+
+void RetryFilter::CallData::ArmRetryTimer(grpc_millis next_attempt_time) {
+  CancelRetryTimer();
+  retry_timer_ = arena_->New<RetryTimer>();
+  retry_timer_->calld = this;
+  GRPC_CLOSURE_INIT(&retry_timer_->closure, OnRetryTimer, retry_timer_,
+                    nullptr);
   GRPC_CALL_STACK_REF(owning_call_, "OnRetryTimer");
-  retry_timer_pending_ = true;
-  grpc_timer_init(&retry_timer_, next_attempt_time, &retry_closure_);
+  grpc_timer_init(&retry_timer_->timer, next_attempt_time,
+                  &retry_timer_->closure);
+}
+
+void RetryFilter::CallData::CancelRetryTimer() {
+  if (retry_timer_ == nullptr) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO, "chand=%p calld=%p: cancelling retry timer", chand_,
+            this);
+  }
+  grpc_timer_cancel(&retry_timer_->timer);
+  retry_timer_ = nullptr;  // Lame timer callback.
 }
 
 void RetryFilter::CallData::OnRetryTimer(void* arg, grpc_error_handle error) {
-  auto* calld = static_cast<CallData*>(arg);
-  GRPC_CLOSURE_INIT(&calld->retry_closure_, OnRetryTimerLocked, calld, nullptr);
-  GRPC_CALL_COMBINER_START(calld->call_combiner_, &calld->retry_closure_,
-                           GRPC_ERROR_REF(error), "retry timer fired");
+  auto* retry_timer = static_cast<RetryTimer*>(arg);
+  GRPC_CLOSURE_INIT(&retry_timer->closure, OnRetryTimerLocked, retry_timer,
+                    nullptr);
+  GRPC_CALL_COMBINER_START(retry_timer->calld->call_combiner_,
+                           &retry_timer->closure, GRPC_ERROR_REF(error),
+                           "retry timer fired");
 }
 
 void RetryFilter::CallData::OnRetryTimerLocked(void* arg,
                                                grpc_error_handle error) {
-  auto* calld = static_cast<CallData*>(arg);
-  if (error == GRPC_ERROR_NONE && calld->retry_timer_pending_) {
-    calld->retry_timer_pending_ = false;
+  auto* retry_timer = static_cast<RetryTimer*>(arg);
+  auto* calld = retry_timer->calld;
+  bool start_attempt = false;
+  if (error == GRPC_ERROR_NONE && calld->retry_timer_ == retry_timer) {
+    calld->retry_timer_ = nullptr;
+    // A hedged attempt is only started if nothing has ruled it out since
+    // the timer was started.
+    start_attempt =
+        calld->call_attempts_.empty() || calld->CanStartHedgedAttempt();
+  }
+  if (start_attempt) {
     calld->CreateCallAttempt();
   } else {
     GRPC_CALL_COMBINER_STOP(calld->call_combiner_, "retry timer cancelled");
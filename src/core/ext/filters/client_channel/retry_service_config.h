@@ -56,6 +56,14 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
         retryable_status_codes_(retryable_status_codes),
         per_attempt_recv_timeout_(per_attempt_recv_timeout) {}
 
+  // Constructs a hedging policy.
+  RetryMethodConfig(int max_attempts, grpc_millis hedging_delay,
+                    StatusCodeSet non_fatal_status_codes)
+      : max_attempts_(max_attempts),
+        retryable_status_codes_(non_fatal_status_codes),
+        hedging_(true),
+        hedging_delay_(hedging_delay) {}
+
   int max_attempts() const { return max_attempts_; }
   grpc_millis initial_backoff() const { return initial_backoff_; }
   grpc_millis max_backoff() const { return max_backoff_; }
@@ -67,6 +75,14 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
     return per_attempt_recv_timeout_;
   }
 
+  // True for a hedgingPolicy, in which case the backoff and
+  // per-attempt timeout fields are unset.
+  bool hedging() const { return hedging_; }
+  grpc_millis hedging_delay() const { return hedging_delay_; }
+  StatusCodeSet non_fatal_status_codes() const {
+    return retryable_status_codes_;
+  }
+
  private:
   int max_attempts_ = 0;
   grpc_millis initial_backoff_ = 0;
@@ -74,6 +90,8 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   float backoff_multiplier_ = 0;
   StatusCodeSet retryable_status_codes_;
   absl::optional<grpc_millis> per_attempt_recv_timeout_;
+  bool hedging_ = false;
+  grpc_millis hedging_delay_ = 0;
 };
 
 class RetryServiceConfigParser : public ServiceConfigParser::Parser {
@@ -83,14 +83,16 @@ DebugOnlyTraceFlag grpc_trace_subchannel_refcount(false, "subchannel_refcount");
 
 ConnectedSubchannel::ConnectedSubchannel(
     grpc_channel_stack* channel_stack, const grpc_channel_args* args,
-    RefCountedPtr<channelz::SubchannelNode> channelz_subchannel)
+    RefCountedPtr<channelz::SubchannelNode> channelz_subchannel,
+    RefCountedPtr<channelz::SocketNode> socket_node)
     : RefCounted<ConnectedSubchannel>(
           GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel_refcount)
               ? "ConnectedSubchannel"
               : nullptr),
       channel_stack_(channel_stack),
       args_(grpc_channel_args_copy(args)),
-      channelz_subchannel_(std::move(channelz_subchannel)) {}
+      channelz_subchannel_(std::move(channelz_subchannel)),
+      socket_node_(std::move(socket_node)) {}
 
 ConnectedSubchannel::~ConnectedSubchannel() {
   grpc_channel_args_destroy(args_);
@@ -312,10 +314,18 @@ class Subchannel::ConnectedSubchannelStateWatcher
                                  const absl::Status& status) override {
     Subchannel* c = subchannel_.get();
     MutexLock lock(&c->mu_);
+    if (c->connected_subchannel_watcher_ != this) {
+      // An extra connection, or one that is already gone.
+      if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+          new_state == GRPC_CHANNEL_SHUTDOWN) {
+        RemoveExtraConnectionLocked(c);
+      }
+      return;
+    }
     switch (new_state) {
       case GRPC_CHANNEL_TRANSIENT_FAILURE:
       case GRPC_CHANNEL_SHUTDOWN: {
-        if (!c->disconnected_ && c->connected_subchannel_ != nullptr) {
+        if (!c->disconnected_) {
           if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
             gpr_log(GPR_INFO,
                     "subchannel %p %s: Connected subchannel %p has gone into "
@@ -324,10 +334,15 @@ class Subchannel::ConnectedSubchannelStateWatcher
                     c->connected_subchannel_.get(),
                     ConnectivityStateName(new_state));
           }
-          c->connected_subchannel_.reset();
           if (c->channelz_node() != nullptr) {
-            c->channelz_node()->SetChildSocket(nullptr);
+            c->channelz_node()->RemoveChildSocket(
+                c->connected_subchannel_->socket_node().get());
           }
+          c->connected_subchannel_.reset();
+          c->connected_subchannel_watcher_ = nullptr;
+          // Calls are spread over the other connections only while this one
+          // is up.
+          c->RemoveExtraConnectionsLocked();
           // We need to construct our own status if the underlying state was
           // shutdown since the accompanying status will be StatusCode::OK
           // otherwise.
@@ -339,6 +354,7 @@ class Subchannel::ConnectedSubchannelStateWatcher
                   : status);
           c->backoff_begun_ = false;
           c->backoff_.Reset();
+          c->next_extra_connection_attempt_ = 0;
         }
         break;
       }
@@ -352,6 +368,25 @@ class Subchannel::ConnectedSubchannelStateWatcher
     }
   }
 
+  void RemoveExtraConnectionLocked(Subchannel* c)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Subchannel::mu_) {
+    for (auto it = c->extra_connections_.begin();
+         it != c->extra_connections_.end(); ++it) {
+      if (it->watcher != this) continue;
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+        gpr_log(GPR_INFO,
+                "subchannel %p %s: extra connection %p has disconnected", c,
+                c->key_.ToString().c_str(), it->connected_subchannel.get());
+      }
+      if (c->channelz_node() != nullptr) {
+        c->channelz_node()->RemoveChildSocket(
+            it->connected_subchannel->socket_node().get());
+      }
+      c->extra_connections_.erase(it);
+      return;
+    }
+  }
+
   WeakRefCountedPtr<Subchannel> subchannel_;
 };
 
@@ -667,6 +702,16 @@ Subchannel::Subchannel(SubchannelKey key,
   } else {
     args_ = grpc_channel_args_copy(args);
   }
+  // Size of the connection pool.
+  max_connections_ = grpc_channel_args_find_integer(
+      args_, GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS, {1, 1, INT_MAX});
+  min_connections_ = std::min<size_t>(
+      max_connections_,
+      grpc_channel_args_find_integer(
+          args_, GRPC_ARG_SUBCHANNEL_MIN_CONNECTIONS, {1, 1, INT_MAX}));
+  target_calls_per_connection_ = grpc_channel_args_find_integer(
+      args_, GRPC_ARG_SUBCHANNEL_TARGET_CALLS_PER_CONNECTION,
+      {100, 1, INT_MAX});
   // Initialize channelz.
   const bool channelz_enabled = grpc_channel_args_find_bool(
       args_, GRPC_ARG_ENABLE_CHANNELZ, GRPC_ENABLE_CHANNELZ_DEFAULT);
@@ -796,6 +841,7 @@ void Subchannel::AttemptToConnect() {
 void Subchannel::ResetBackoff() {
   MutexLock lock(&mu_);
   backoff_.Reset();
+  next_extra_connection_attempt_ = 0;
   if (have_retry_alarm_) {
     retry_immediately_ = true;
     grpc_timer_cancel(&retry_alarm_);
@@ -817,9 +863,28 @@ void Subchannel::Orphan() {
   disconnected_ = true;
   connector_.reset();
   connected_subchannel_.reset();
+  connected_subchannel_watcher_ = nullptr;
+  extra_connections_.clear();
   health_watcher_map_.ShutdownLocked();
 }
 
+void Subchannel::GetOrAddDataProducer(
+    const char* type,
+    std::function<void(DataProducerInterface**)> get_or_add) {
+  MutexLock lock(&mu_);
+  auto it = data_producer_map_.emplace(type, nullptr).first;
+  get_or_add(&it->second);
+  if (it->second == nullptr) data_producer_map_.erase(it);
+}
+
+void Subchannel::RemoveDataProducer(DataProducerInterface* data_producer) {
+  MutexLock lock(&mu_);
+  auto it = data_producer_map_.find(data_producer->type());
+  if (it != data_producer_map_.end() && it->second == data_producer) {
+    data_producer_map_.erase(it);
+  }
+}
+
 namespace {
 
 // Returns a string indicating the subchannel's connectivity state change to
@@ -924,15 +989,19 @@ void Subchannel::OnRetryAlarm(void* arg, grpc_error_handle error) {
 }
 
 void Subchannel::ContinueConnectingLocked() {
+  next_attempt_deadline_ = backoff_.NextAttemptTime();
+  SetConnectivityStateLocked(GRPC_CHANNEL_CONNECTING, absl::Status());
+  StartConnectLocked(next_attempt_deadline_);
+}
+
+void Subchannel::StartConnectLocked(grpc_millis deadline) {
   SubchannelConnector::Args args;
   args.address = &address_for_connect_;
   args.interested_parties = pollset_set_;
   const grpc_millis min_deadline =
       min_connect_timeout_ms_ + ExecCtx::Get()->Now();
-  next_attempt_deadline_ = backoff_.NextAttemptTime();
-  args.deadline = std::max(next_attempt_deadline_, min_deadline);
+  args.deadline = std::max(deadline, min_deadline);
   args.channel_args = args_;
-  SetConnectivityStateLocked(GRPC_CHANNEL_CONNECTING, absl::Status());
   connector_->Connect(args, &connecting_result_, &on_connecting_finished_);
 }
 
@@ -943,9 +1012,32 @@ void Subchannel::OnConnectingFinished(void* arg, grpc_error_handle error) {
   {
     MutexLock lock(&c->mu_);
     c->connecting_ = false;
-    if (c->connecting_result_.transport != nullptr &&
-        c->PublishTransportLocked()) {
-      // Do nothing, transport was published.
+    const bool connecting_extra = c->connecting_extra_;
+    c->connecting_extra_ = false;
+    if (connecting_extra && c->connected_subchannel_ != nullptr) {
+      if (c->connecting_result_.transport != nullptr &&
+          c->PublishTransportLocked()) {
+        c->backoff_.Reset();
+      } else {
+        // A failed extra connection is retried once calls need it again,
+        // but not before the subchannel's backoff allows.
+        c->next_extra_connection_attempt_ = c->backoff_.NextAttemptTime();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+          gpr_log(GPR_INFO,
+                  "subchannel %p %s: extra connect failed, not retrying for "
+                  "%" PRId64 " milliseconds: %s",
+                  c.get(), c->key_.ToString().c_str(),
+                  c->next_extra_connection_attempt_ - ExecCtx::Get()->Now(),
+                  grpc_error_std_string(error).c_str());
+        }
+      }
+    } else if (c->connecting_result_.transport != nullptr &&
+               c->PublishTransportLocked()) {
+      // Do nothing, transport was published.  If the connection was started
+      // as an extra one, it replaces the connection that was lost meanwhile.
+    } else if (connecting_extra) {
+      // The connection that was lost meanwhile must still be replaced.
+      c->MaybeStartConnectingLocked();
     } else if (!c->disconnected_) {
       gpr_log(GPR_INFO, "subchannel %p %s: connect failed: %s", c.get(),
               c->key_.ToString().c_str(), grpc_error_std_string(error).c_str());
@@ -1000,22 +1092,130 @@ bool Subchannel::PublishTransportLocked() {
     return false;
   }
   // Publish.
-  connected_subchannel_.reset(
-      new ConnectedSubchannel(stk, args_, channelz_node_));
+  if (channelz_node_ != nullptr) channelz_node_->AddChildSocket(socket);
+  auto connected_subchannel = MakeRefCounted<ConnectedSubchannel>(
+      stk, args_, channelz_node_, std::move(socket));
+  // Start watching connected subchannel.
+  auto watcher = MakeOrphanable<ConnectedSubchannelStateWatcher>(
+      WeakRef(DEBUG_LOCATION, "state_watcher"));
+  ConnectedSubchannelStateWatcher* watcher_ptr = watcher.get();
+  connected_subchannel->StartWatch(pollset_set_, std::move(watcher));
+  if (connected_subchannel_ != nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+      gpr_log(GPR_INFO, "subchannel %p %s: new extra connection at %p", this,
+              key_.ToString().c_str(), connected_subchannel.get());
+    }
+    extra_connections_.push_back(
+        {std::move(connected_subchannel), watcher_ptr});
+    MaybeAddConnectionLocked();
+    return true;
+  }
+  connected_subchannel_ = std::move(connected_subchannel);
+  connected_subchannel_watcher_ = watcher_ptr;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
     gpr_log(GPR_INFO, "subchannel %p %s: new connected subchannel at %p", this,
             key_.ToString().c_str(), connected_subchannel_.get());
   }
-  if (channelz_node_ != nullptr) {
-    channelz_node_->SetChildSocket(std::move(socket));
-  }
-  // Start watching connected subchannel.
-  connected_subchannel_->StartWatch(
-      pollset_set_, MakeOrphanable<ConnectedSubchannelStateWatcher>(
-                        WeakRef(DEBUG_LOCATION, "state_watcher")));
   // Report initial state.
   SetConnectivityStateLocked(GRPC_CHANNEL_READY, absl::Status());
+  MaybeAddConnectionLocked();
   return true;
 }
 
+RefCountedPtr<ConnectedSubchannel> Subchannel::ConnectedSubchannelForCall() {
+  MutexLock lock(&mu_);
+  if (connected_subchannel_ == nullptr) return nullptr;
+  if (max_connections_ == 1) {
+    connected_subchannel_->calls_in_flight_.fetch_add(
+        1, std::memory_order_relaxed);
+    return connected_subchannel_;
+  }
+  ConnectedSubchannel* least_loaded = connected_subchannel_.get();
+  size_t least_calls = least_loaded->calls_in_flight();
+  for (const auto& connection : extra_connections_) {
+    const size_t calls = connection.connected_subchannel->calls_in_flight();
+    if (calls < least_calls) {
+      least_loaded = connection.connected_subchannel.get();
+      least_calls = calls;
+    }
+  }
+  // Count the call before deciding whether to resize the pool, and before
+  // the next pick looks for the least loaded connection.
+  least_loaded->calls_in_flight_.fetch_add(1, std::memory_order_relaxed);
+  RefCountedPtr<ConnectedSubchannel> result = least_loaded->Ref();
+  MaybeAddConnectionLocked();
+  MaybeRemoveConnectionLocked();
+  return result;
+}
+
+void Subchannel::MaybeAddConnectionLocked() {
+  if (disconnected_ || connecting_ || connected_subchannel_ == nullptr) return;
+  const size_t num_connections = 1 + extra_connections_.size();
+  if (num_connections >= max_connections_) return;
+  if (ExecCtx::Get()->Now() < next_extra_connection_attempt_) return;
+  // Above the minimum, only add a connection once every connection has
+  // reached its target number of calls.
+  if (num_connections >= min_connections_) {
+    if (connected_subchannel_->calls_in_flight() <
+        target_calls_per_connection_) {
+      return;
+    }
+    for (const auto& connection : extra_connections_) {
+      if (connection.connected_subchannel->calls_in_flight() <
+          target_calls_per_connection_) {
+        return;
+      }
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO, "subchannel %p %s: adding connection %" PRIuPTR, this,
+            key_.ToString().c_str(), num_connections + 1);
+  }
+  connecting_ = true;
+  connecting_extra_ = true;
+  WeakRef(DEBUG_LOCATION, "connecting")
+      .release();  // ref held by pending connect
+  StartConnectLocked(0);
+}
+
+void Subchannel::MaybeRemoveConnectionLocked() {
+  if (extra_connections_.size() + 1 <= min_connections_) return;
+  // Only remove a connection once the calls would fit on the others at half
+  // their target, so that the pool does not keep growing and shrinking
+  // around one size.
+  size_t calls = connected_subchannel_->calls_in_flight();
+  for (const auto& connection : extra_connections_) {
+    calls += connection.connected_subchannel->calls_in_flight();
+  }
+  if (calls * 2 > extra_connections_.size() * target_calls_per_connection_) {
+    return;
+  }
+  for (auto it = extra_connections_.begin(); it != extra_connections_.end();
+       ++it) {
+    if (it->connected_subchannel->calls_in_flight() != 0) continue;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+      gpr_log(GPR_INFO, "subchannel %p %s: removing idle connection %p", this,
+              key_.ToString().c_str(), it->connected_subchannel.get());
+    }
+    if (channelz_node_ != nullptr) {
+      channelz_node_->RemoveChildSocket(
+          it->connected_subchannel->socket_node().get());
+    }
+    extra_connections_.erase(it);
+    return;
+  }
+}
+
+void Subchannel::RemoveExtraConnectionsLocked() {
+  if (channelz_node_ != nullptr) {
+    for (const auto& connection : extra_connections_) {
+      channelz_node_->RemoveChildSocket(
+          connection.connected_subchannel->socket_node().get());
+    }
+  }
+  // Calls still in flight on these connections keep them open until they
+  // finish.
+  extra_connections_.clear();
+}
+
 }  // namespace grpc_core
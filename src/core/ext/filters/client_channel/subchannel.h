@@ -19,7 +19,11 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
 #include <deque>
+#include <functional>
+#include <map>
+#include <vector>
 
 #include "src/core/ext/filters/client_channel/client_channel_channelz.h"
 #include "src/core/ext/filters/client_channel/connector.h"
@@ -45,7 +49,8 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
  public:
   ConnectedSubchannel(
       grpc_channel_stack* channel_stack, const grpc_channel_args* args,
-      RefCountedPtr<channelz::SubchannelNode> channelz_subchannel);
+      RefCountedPtr<channelz::SubchannelNode> channelz_subchannel,
+      RefCountedPtr<channelz::SocketNode> socket_node = nullptr);
   ~ConnectedSubchannel() override;
 
   void StartWatch(grpc_pollset_set* interested_parties,
@@ -58,15 +63,34 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
   channelz::SubchannelNode* channelz_subchannel() const {
     return channelz_subchannel_.get();
   }
+  const RefCountedPtr<channelz::SocketNode>& socket_node() const {
+    return socket_node_;
+  }
 
   size_t GetInitialCallSizeEstimate() const;
 
+  // Returns the number of calls that Subchannel::ConnectedSubchannelForCall()
+  // picked this connection for and that have not finished yet.
+  size_t calls_in_flight() const {
+    return calls_in_flight_.load(std::memory_order_relaxed);
+  }
+  // Must be called once for each call this connection was picked for, when
+  // the call is done with it, whether or not it was started.
+  void CallFinished() {
+    calls_in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
  private:
+  friend class Subchannel;
+
   grpc_channel_stack* channel_stack_;
   grpc_channel_args* args_;
   // ref counted pointer to the channelz node in this connected subchannel's
   // owning subchannel.
   RefCountedPtr<channelz::SubchannelNode> channelz_subchannel_;
+  // The channelz node of the connection's socket, if any.
+  RefCountedPtr<channelz::SocketNode> socket_node_;
+  std::atomic<size_t> calls_in_flight_{0};
 };
 
 // Implements the interface of RefCounted<>.
@@ -184,6 +208,18 @@ class Subchannel : public DualRefCounted<Subchannel> {
         ABSL_GUARDED_BY(&mu_);
   };
 
+  // A base class for producers of subchannel-specific data, such as the
+  // out-of-band backend metric stream.  A producer is shared by all of the
+  // channels using the subchannel, and goes away when the last one stops
+  // watching its data.
+  class DataProducerInterface : public DualRefCounted<DataProducerInterface> {
+   public:
+    // A unique identifier for the implementation.  Producers are looked up
+    // by the address of this string rather than its contents, so all
+    // instances of an implementation must return the same string instance.
+    virtual const char* type() const = 0;
+  };
+
   // Creates a subchannel.
   static RefCountedPtr<Subchannel> Create(
       OrphanablePtr<SubchannelConnector> connector,
@@ -231,12 +267,24 @@ class Subchannel : public DualRefCounted<Subchannel> {
       const absl::optional<std::string>& health_check_service_name,
       ConnectivityStateWatcherInterface* watcher) ABSL_LOCKS_EXCLUDED(mu_);
 
+  // Returns the connection whose state the subchannel reports, or null if
+  // the subchannel is not READY.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel()
       ABSL_LOCKS_EXCLUDED(mu_) {
     MutexLock lock(&mu_);
     return connected_subchannel_;
   }
 
+  // Returns the connection to start a new call on, or null if the subchannel
+  // is not READY.  If the subchannel keeps more than one connection (see
+  // GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS), this is the one with the fewest
+  // calls in flight, and the pool of connections is grown or shrunk to
+  // follow the number of calls in flight.  The call is counted on the
+  // returned connection right away, so that concurrent picks see it; the
+  // caller must call CallFinished() on the connection once the call is done.
+  RefCountedPtr<ConnectedSubchannel> ConnectedSubchannelForCall()
+      ABSL_LOCKS_EXCLUDED(mu_);
+
   // Attempt to connect to the backend.  Has no effect if already connected.
   void AttemptToConnect() ABSL_LOCKS_EXCLUDED(mu_);
 
@@ -246,6 +294,19 @@ class Subchannel : public DualRefCounted<Subchannel> {
   // Tears down any existing connection, and arranges for destruction
   void Orphan() override ABSL_LOCKS_EXCLUDED(mu_);
 
+  // Invokes get_or_add with a pointer to the data producer registered for
+  // type, which is null if there is none, while holding the subchannel's
+  // lock.  The callback may register a new producer by setting the pointer.
+  // It must not call back into the subchannel.
+  void GetOrAddDataProducer(
+      const char* type,
+      std::function<void(DataProducerInterface**)> get_or_add)
+      ABSL_LOCKS_EXCLUDED(mu_);
+  // Unregisters data_producer, if it is still the producer registered for
+  // its type.
+  void RemoveDataProducer(DataProducerInterface* data_producer)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
  private:
   // A linked list of ConnectivityStateWatcherInterfaces that are monitoring
   // the subchannel's state.
@@ -310,6 +371,14 @@ class Subchannel : public DualRefCounted<Subchannel> {
 
   class ConnectedSubchannelStateWatcher;
 
+  // A connection in addition to connected_subchannel_, with the watcher of
+  // its state.  The watcher identifies the connection to its callbacks,
+  // since it lives until they are done.
+  struct ExtraConnection {
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+    ConnectedSubchannelStateWatcher* watcher;
+  };
+
   class AsyncWatcherNotifierLocked;
 
   // Sets the subchannel's connectivity state to \a state.
@@ -322,10 +391,17 @@ class Subchannel : public DualRefCounted<Subchannel> {
   static void OnRetryAlarm(void* arg, grpc_error_handle error)
       ABSL_LOCKS_EXCLUDED(mu_);
   void ContinueConnectingLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void StartConnectLocked(grpc_millis deadline)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   static void OnConnectingFinished(void* arg, grpc_error_handle error)
       ABSL_LOCKS_EXCLUDED(mu_);
   bool PublishTransportLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Methods for the connections in addition to connected_subchannel_.
+  void MaybeAddConnectionLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void MaybeRemoveConnectionLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void RemoveExtraConnectionsLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // The subchannel pool this subchannel is in.
   RefCountedPtr<SubchannelPoolInterface> subchannel_pool_;
   // Subchannel key that identifies this subchannel in the subchannel pool.
@@ -339,6 +415,11 @@ class Subchannel : public DualRefCounted<Subchannel> {
   grpc_pollset_set* pollset_set_;
   // Channelz tracking.
   RefCountedPtr<channelz::SubchannelNode> channelz_node_;
+  // Bounds on the number of connections, and the number of calls in flight
+  // on every connection at which another one is added.
+  size_t min_connections_;
+  size_t max_connections_;
+  size_t target_calls_per_connection_;
 
   // Connection state.
   OrphanablePtr<SubchannelConnector> connector_;
@@ -348,9 +429,16 @@ class Subchannel : public DualRefCounted<Subchannel> {
   // Protects the other members.
   Mutex mu_;
 
-  // Active connection, or null.
+  // Active connection, or null, and the watcher of its state.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_ ABSL_GUARDED_BY(mu_);
+  ConnectedSubchannelStateWatcher* connected_subchannel_watcher_
+      ABSL_GUARDED_BY(mu_) = nullptr;
+  // Connections that calls are spread over in addition to
+  // connected_subchannel_.  Only kept while connected_subchannel_ is set.
+  std::vector<ExtraConnection> extra_connections_ ABSL_GUARDED_BY(mu_);
   bool connecting_ ABSL_GUARDED_BY(mu_) = false;
+  // Whether the connection attempt in progress is for an extra connection.
+  bool connecting_extra_ ABSL_GUARDED_BY(mu_) = false;
   bool disconnected_ ABSL_GUARDED_BY(mu_) = false;
 
   // Connectivity state tracking.
@@ -366,6 +454,9 @@ class Subchannel : public DualRefCounted<Subchannel> {
   grpc_millis next_attempt_deadline_ ABSL_GUARDED_BY(mu_);
   grpc_millis min_connect_timeout_ms_ ABSL_GUARDED_BY(mu_);
   bool backoff_begun_ ABSL_GUARDED_BY(mu_) = false;
+  // No extra connection is attempted before this time, which backoff_ sets
+  // after an extra connection attempt fails.
+  grpc_millis next_extra_connection_attempt_ ABSL_GUARDED_BY(mu_) = 0;
 
   // Retry alarm.
   grpc_timer retry_alarm_ ABSL_GUARDED_BY(mu_);
@@ -375,6 +466,10 @@ class Subchannel : public DualRefCounted<Subchannel> {
   bool retry_immediately_ ABSL_GUARDED_BY(mu_) = false;
   // Keepalive time period (-1 for unset)
   int keepalive_time_ ABSL_GUARDED_BY(mu_) = -1;
+
+  // Data producers, keyed by the address of their type string.  Not owned.
+  std::map<const char*, DataProducerInterface*> data_producer_map_
+      ABSL_GUARDED_BY(mu_);
 };
 
 }  // namespace grpc_core
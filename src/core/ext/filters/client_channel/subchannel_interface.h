@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <memory>
+
 #include <grpc/impl/codegen/connectivity_state.h>
 #include <grpc/impl/codegen/grpc_types.h>
 
@@ -47,6 +49,15 @@ class SubchannelInterface : public RefCounted<SubchannelInterface> {
     virtual grpc_pollset_set* interested_parties() = 0;
   };
 
+  // Opaque interface for watching data of different types for this
+  // subchannel, such as out-of-band backend metrics.  Instances are
+  // created by the code that produces the data (see for example
+  // lb_policy/oob_backend_metric.h) and registered with AddDataWatcher().
+  class DataWatcherInterface {
+   public:
+    virtual ~DataWatcherInterface() = default;
+  };
+
   explicit SubchannelInterface(const char* trace = nullptr)
       : RefCounted<SubchannelInterface>(trace) {}
 
@@ -89,6 +100,11 @@ class SubchannelInterface : public RefCounted<SubchannelInterface> {
 
   // TODO(roth): Need a better non-grpc-specific abstraction here.
   virtual const grpc_channel_args* channel_args() = 0;
+
+  // Registers a new data watcher.  The watcher will be destroyed when the
+  // subchannel is destroyed.
+  virtual void AddDataWatcher(
+      std::unique_ptr<DataWatcherInterface> watcher) = 0;
 };
 
 // A class that delegates to another subchannel, to be used in cases
@@ -120,6 +136,9 @@ class DelegatingSubchannel : public SubchannelInterface {
   const grpc_channel_args* channel_args() override {
     return wrapped_subchannel_->channel_args();
   }
+  void AddDataWatcher(std::unique_ptr<DataWatcherInterface> watcher) override {
+    wrapped_subchannel_->AddDataWatcher(std::move(watcher));
+  }
 
  private:
   RefCountedPtr<SubchannelInterface> wrapped_subchannel_;
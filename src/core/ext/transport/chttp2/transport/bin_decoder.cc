@@ -24,6 +24,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/slice/b64_simd.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 
@@ -112,6 +113,15 @@ bool grpc_base64_decode_partial(struct grpc_base64_decode_context* ctx) {
     return false;
   }
 
+  // Process whole vectors of input in bulk where the CPU allows. Padding and
+  // invalid characters are left to the loops below.
+  const size_t bulk = grpc_core::Base64DecodeBulk(
+      ctx->input_cur, static_cast<size_t>(ctx->input_end - ctx->input_cur),
+      ctx->output_cur, static_cast<size_t>(ctx->output_end - ctx->output_cur),
+      grpc_core::Base64Alphabet::kStandard);
+  ctx->input_cur += bulk;
+  ctx->output_cur += bulk / 4 * 3;
+
   // Process a block of 4 input characters and 3 output bytes
   while (ctx->input_end >= ctx->input_cur + 4 &&
          ctx->output_end >= ctx->output_cur + 3) {
@@ -22,9 +22,12 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/support/log.h>
 
 #include "src/core/ext/transport/chttp2/transport/huffsyms.h"
+#include "src/core/lib/slice/b64_simd.h"
 
 static const char alphabet[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -58,8 +61,13 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   char* out = reinterpret_cast<char*> GRPC_SLICE_START_PTR(output);
   size_t i;
 
-  /* encode full triplets */
-  for (i = 0; i < input_triplets; i++) {
+  /* encode full triplets, in bulk where the CPU allows */
+  i = grpc_core::Base64EncodeBulk(in, input_length, out,
+                                  grpc_core::Base64Alphabet::kStandard) /
+      3;
+  in += 3 * i;
+  out += 4 * i;
+  for (; i < input_triplets; i++) {
     out[0] = alphabet[in[0] >> 2];
     out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
     out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
@@ -92,13 +100,56 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   return output;
 }
 
+struct huff_out {
+  uint64_t temp;
+  uint32_t temp_length;
+  uint8_t* out;
+};
+
+/* Codes are at most 30 bits long (22 for a pair of base64 symbols), so with
+   fewer than 32 bits pending the accumulator never overflows, and whole 32 bit
+   words can be written out at once. */
+static void enc_flush_some(huff_out* out) {
+  if (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    const uint32_t word = static_cast<uint32_t>(out->temp >> out->temp_length);
+    out->out[0] = static_cast<uint8_t>(word >> 24);
+    out->out[1] = static_cast<uint8_t>(word >> 16);
+    out->out[2] = static_cast<uint8_t>(word >> 8);
+    out->out[3] = static_cast<uint8_t>(word);
+    out->out += 4;
+  }
+}
+
+static void enc_add_bits(huff_out* out, uint32_t bits, uint32_t length) {
+  out->temp = (out->temp << length) | bits;
+  out->temp_length += length;
+  enc_flush_some(out);
+}
+
+/* write out any remaining bits, padding the last byte with the EOS prefix */
+static void enc_finish(huff_out* out) {
+  while (out->temp_length >= 8) {
+    out->temp_length -= 8;
+    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
+  }
+  if (out->temp_length) {
+    /* NB: the following integer arithmetic operation needs to be in its
+     * expanded form due to the "integral promotion" performed (see section
+     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
+     * is then required to avoid the compiler warning */
+    *out->out++ = static_cast<uint8_t>(
+        static_cast<uint8_t>(out->temp << (8u - out->temp_length)) |
+        static_cast<uint8_t>(0xffu >> out->temp_length));
+    out->temp_length = 0;
+  }
+}
+
 grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   size_t nbits;
   const uint8_t* in;
-  uint8_t* out;
   grpc_slice output;
-  uint32_t temp = 0;
-  uint32_t temp_length = 0;
+  huff_out out;
 
   nbits = 0;
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
@@ -107,64 +158,37 @@ grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   }
 
   output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
-  out = GRPC_SLICE_START_PTR(output);
+  out.temp = 0;
+  out.temp_length = 0;
+  out.out = GRPC_SLICE_START_PTR(output);
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
        ++in) {
-    int sym = *in;
-    temp <<= grpc_chttp2_huffsyms[sym].length;
-    temp |= grpc_chttp2_huffsyms[sym].bits;
-    temp_length += grpc_chttp2_huffsyms[sym].length;
-
-    while (temp_length > 8) {
-      temp_length -= 8;
-      *out++ = static_cast<uint8_t>(temp >> temp_length);
-    }
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[*in];
+    enc_add_bits(&out, sym.bits, sym.length);
   }
+  enc_finish(&out);
 
-  if (temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out++ =
-        static_cast<uint8_t>(static_cast<uint8_t>(temp << (8u - temp_length)) |
-                             static_cast<uint8_t>(0xffu >> temp_length));
-  }
-
-  GPR_ASSERT(out == GRPC_SLICE_END_PTR(output));
+  GPR_ASSERT(out.out == GRPC_SLICE_END_PTR(output));
 
   return output;
 }
 
-struct huff_out {
-  uint32_t temp;
-  uint32_t temp_length;
-  uint8_t* out;
-};
-static void enc_flush_some(huff_out* out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
-  }
-}
-
 static void enc_add2(huff_out* out, uint8_t a, uint8_t b) {
   b64_huff_sym sa = huff_alphabet[a];
   b64_huff_sym sb = huff_alphabet[b];
-  out->temp = (out->temp << (sa.length + sb.length)) |
-              (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits;
-  out->temp_length +=
-      static_cast<uint32_t>(sa.length) + static_cast<uint32_t>(sb.length);
-  enc_flush_some(out);
+  enc_add_bits(out, (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits,
+               static_cast<uint32_t>(sa.length) +
+                   static_cast<uint32_t>(sb.length));
 }
 
 static void enc_add1(huff_out* out, uint8_t a) {
   b64_huff_sym sa = huff_alphabet[a];
-  out->temp = (out->temp << sa.length) | sa.bits;
-  out->temp_length += sa.length;
-  enc_flush_some(out);
+  enc_add_bits(out, sa.bits, sa.length);
 }
 
+/* input bytes split into symbols per bulk call */
+static constexpr size_t kBulkChunk = 192;
+
 grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     const grpc_slice& input) {
   size_t input_length = GRPC_SLICE_LENGTH(input);
@@ -183,8 +207,23 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
   out.temp_length = 0;
   out.out = start_out;
 
-  /* encode full triplets */
-  for (i = 0; i < input_triplets; i++) {
+  /* split full triplets into base64 symbols in bulk where the CPU allows, a
+     chunk at a time, and Huffman code them */
+  i = 0;
+  while (true) {
+    uint8_t syms[kBulkChunk / 3 * 4];
+    const size_t n = grpc_core::Base64SplitBulk(
+        in, std::min(input_length - 3 * i, kBulkChunk), syms);
+    if (n == 0) break;
+    for (size_t j = 0; j < n / 3 * 4; j += 2) {
+      enc_add2(&out, syms[j], syms[j + 1]);
+    }
+    in += n;
+    i += n / 3;
+  }
+
+  /* encode the remaining full triplets */
+  for (; i < input_triplets; i++) {
     const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
     const uint8_t high_to_low = in[1] >> 4;
     enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
@@ -213,15 +252,7 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     }
   }
 
-  if (out.temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out.out++ = static_cast<uint8_t>(
-        static_cast<uint8_t>(out.temp << (8u - out.temp_length)) |
-        static_cast<uint8_t>(0xffu >> out.temp_length));
-  }
+  enc_finish(&out);
 
   GPR_ASSERT(out.out <= GRPC_SLICE_END_PTR(output));
   GRPC_SLICE_SET_LENGTH(output, out.out - start_out);
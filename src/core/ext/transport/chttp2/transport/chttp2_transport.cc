@@ -104,6 +104,8 @@ static void write_action_begin_locked(void* t, grpc_error_handle error);
 static void write_action(void* t, grpc_error_handle error);
 static void write_action_end(void* t, grpc_error_handle error);
 static void write_action_end_locked(void* t, grpc_error_handle error);
+static void write_coalescing_yield(grpc_chttp2_transport* t);
+static void write_coalescing_release_locked(void* t, grpc_error_handle error);
 
 static void read_action(void* t, grpc_error_handle error);
 static void read_action_locked(void* t, grpc_error_handle error);
@@ -303,6 +305,10 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
       t->write_buffer_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
           &channel_args->args[i], {0, 0, MAX_WRITE_BUFFER_SIZE}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_BUDGET_US)) {
+      t->write_coalescing_budget_us = grpc_channel_arg_get_integer(
+          &channel_args->args[i], {0, 0, 1000});
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
@@ -930,6 +936,8 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
       break;
   }
+  // A held write that has gathered enough company is sent right away.
+  if (t->write_coalescing_holding) ++t->write_coalescing_joined;
 }
 
 void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
@@ -959,6 +967,21 @@ static void write_action_begin_locked(void* gt,
   } else {
     r = grpc_chttp2_begin_write(t);
   }
+  if (r.writing && !r.partial) {
+    const int64_t hold_us = grpc_chttp2_write_coalescing_hold_us(t);
+    if (hold_us > 0) {
+      // Leave the gathered frames in outbuf: write_coalescing_release_locked
+      // gathers whatever else became writable and sends it all at once.
+      GRPC_STATS_INC_HTTP2_WRITES_COALESCED();
+      t->write_coalescing_holding = true;
+      t->write_coalescing_joined = 0;
+      t->write_coalescing_hold_until =
+          gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                       gpr_time_from_micros(hold_us, GPR_TIMESPAN));
+      write_coalescing_yield(t);
+      return;
+    }
+  }
   if (r.writing) {
     if (r.partial) {
       GRPC_STATS_INC_HTTP2_PARTIAL_WRITES();
@@ -993,6 +1016,7 @@ static void write_action(void* gt, grpc_error_handle /*error*/) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   void* cl = t->cl;
   t->cl = nullptr;
+  grpc_chttp2_write_coalescing_note_write_started(t);
   grpc_endpoint_write(
       t->ep, &t->outbuf,
       GRPC_CLOSURE_INIT(&t->write_action_end_locked, write_action_end, t,
@@ -1012,6 +1036,7 @@ static void write_action_end(void* tp, grpc_error_handle error) {
 static void write_action_end_locked(void* tp, grpc_error_handle error) {
   GPR_TIMER_SCOPE("terminate_writing_with_lock", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  grpc_chttp2_write_coalescing_note_write_finished(t);
 
   bool closed = false;
   if (error != GRPC_ERROR_NONE) {
@@ -1058,6 +1083,35 @@ static void write_action_end_locked(void* tp, grpc_error_handle error) {
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "writing");
 }
 
+// Timers only have millisecond resolution, so a held write waits by going to
+// the back of the combiner queue instead: whatever other threads queued in the
+// meantime (new messages on other streams, reads, ...) runs first.
+static void write_coalescing_yield(grpc_chttp2_transport* t) {
+  t->combiner->Run(
+      GRPC_CLOSURE_INIT(&t->write_coalescing_release_locked,
+                        write_coalescing_release_locked, t, nullptr),
+      GRPC_ERROR_NONE);
+}
+
+// Keep yielding until the hold expires, enough writes joined the held one, or
+// the transport is waiting on this write to close. Then gather and send.
+static void write_coalescing_release_locked(void* tp,
+                                            grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  GPR_ASSERT(t->write_coalescing_holding);
+  if (t->write_coalescing_joined < GRPC_CHTTP2_WRITE_COALESCING_MAX_FRAMES &&
+      t->close_transport_on_writes_finished == GRPC_ERROR_NONE &&
+      gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC),
+                   t->write_coalescing_hold_until) < 0) {
+    write_coalescing_yield(t);
+    return;
+  }
+  t->write_coalescing_holding = false;
+  t->write_coalescing_released = true;
+  write_action_begin_locked(t, GRPC_ERROR_NONE);
+  t->write_coalescing_released = false;
+}
+
 // Dirties an HTTP2 setting to be sent out next time a writing path occurs.
 // If the change needs to occur immediately, manually initiate a write.
 static void queue_setting_update(grpc_chttp2_transport* t,
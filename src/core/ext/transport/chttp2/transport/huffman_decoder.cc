@@ -0,0 +1,86 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/huffman_decoder.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+const HuffmanDecoder::Tables& HuffmanDecoder::GetTables() {
+  static const Tables* tables = BuildTables();
+  return *tables;
+}
+
+HuffmanDecoder::Tables* HuffmanDecoder::BuildTables() {
+  Tables* t = new Tables;
+  memset(t, 0, sizeof(*t));
+  // The HPACK code is canonical: codes of one length are consecutive and
+  // ordered by symbol, so sorting symbols by (length, code) is enough to
+  // decode a code of known length by subtraction.
+  for (uint16_t i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) t->symbols[i] = i;
+  std::sort(t->symbols, t->symbols + GRPC_CHTTP2_NUM_HUFFSYMS,
+            [](uint16_t a, uint16_t b) {
+              const grpc_chttp2_huffsym& x = grpc_chttp2_huffsyms[a];
+              const grpc_chttp2_huffsym& y = grpc_chttp2_huffsyms[b];
+              if (x.length != y.length) return x.length < y.length;
+              return x.bits < y.bits;
+            });
+  for (uint16_t i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[t->symbols[i]];
+    GPR_ASSERT(sym.length <= kMaxCodeLength);
+    if (t->count[sym.length] == 0) {
+      t->first_code[sym.length] = sym.bits;
+      t->offset[sym.length] = i;
+    }
+    GPR_ASSERT(sym.bits == t->first_code[sym.length] + t->count[sym.length]);
+    t->count[sym.length]++;
+  }
+  // Single symbol entries: every index whose leading bits are a short code.
+  for (int s = 0; s < GRPC_CHTTP2_NUM_HUFFSYMS; s++) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[s];
+    if (sym.length > kLookupBits) continue;
+    const int spare = kLookupBits - static_cast<int>(sym.length);
+    const uint32_t entry = static_cast<uint32_t>(s) | (sym.length << 16) |
+                           (sym.length << 21) | (1u << 26);
+    for (uint32_t i = sym.bits << spare; i < (sym.bits + 1) << spare; i++) {
+      t->fast[i] = entry;
+    }
+  }
+  // Pair up with a second symbol wherever it fits in the remaining bits.
+  for (uint32_t i = 0; i < (1u << kLookupBits); i++) {
+    const uint32_t entry = t->fast[i];
+    if (EntryCount(entry) != 1) continue;
+    const int first_length = EntryFirstLength(entry);
+    const int spare = kLookupBits - first_length;
+    const uint32_t rest = (i << first_length) & kLookupMask;
+    const uint32_t second = t->fast[rest];
+    if (EntryCount(second) == 0) continue;
+    const int second_length = EntryFirstLength(second);
+    if (second_length > spare) continue;
+    t->fast[i] = (entry & 0xff) | ((second & 0xff) << 8) |
+                 (static_cast<uint32_t>(first_length) << 16) |
+                 (static_cast<uint32_t>(first_length + second_length) << 21) |
+                 (2u << 26);
+  }
+  return t;
+}
+
+}  // namespace grpc_core
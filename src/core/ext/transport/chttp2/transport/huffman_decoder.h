@@ -0,0 +1,123 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HUFFMAN_DECODER_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HUFFMAN_DECODER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
+
+namespace grpc_core {
+
+// Decoder for the HPACK static huffman code (RFC 7541 appendix B).
+// Input is shifted into a 64 bit buffer, and each step looks up the next
+// kLookupBits bits in a table that yields up to two complete symbols at once.
+// Codes longer than kLookupBits (control characters and most non-ASCII bytes)
+// fall back to a canonical code search that walks one code length at a time.
+class HuffmanDecoder {
+ public:
+  static constexpr int kLookupBits = 12;
+
+  // Decode length bytes starting at p, calling output(uint8_t) for each
+  // decoded byte. EOS symbols are dropped and trailing bits that do not form
+  // a complete code are treated as padding, matching the previous nibble at a
+  // time decoder.
+  template <typename Out>
+  static void Decode(const uint8_t* p, size_t length, Out output) {
+    const Tables& tables = GetTables();
+    const uint8_t* const end = p + length;
+    uint64_t bits = 0;
+    int nbits = 0;
+    while (true) {
+      while (nbits <= 56 && p != end) {
+        bits = (bits << 8) | *p++;
+        nbits += 8;
+      }
+      if (nbits == 0) return;
+      uint32_t peek;
+      if (GPR_LIKELY(nbits >= kLookupBits)) {
+        peek = static_cast<uint32_t>(bits >> (nbits - kLookupBits));
+      } else {
+        // Pad with ones (the EOS prefix) so padding never decodes to a
+        // symbol that ends past the available bits.
+        peek = static_cast<uint32_t>(bits << (kLookupBits - nbits)) |
+               ((1u << (kLookupBits - nbits)) - 1);
+      }
+      const uint32_t entry = tables.fast[peek & kLookupMask];
+      const int count = EntryCount(entry);
+      if (GPR_LIKELY(count != 0)) {
+        const int first_length = EntryFirstLength(entry);
+        if (first_length > nbits) return;
+        output(static_cast<uint8_t>(entry));
+        const int total_length = EntryTotalLength(entry);
+        if (count == 2 && total_length <= nbits) {
+          output(static_cast<uint8_t>(entry >> 8));
+          nbits -= total_length;
+        } else {
+          nbits -= first_length;
+        }
+        continue;
+      }
+      // Slow path: the next code is longer than kLookupBits.
+      int length_bits = kLookupBits + 1;
+      for (;; ++length_bits) {
+        if (length_bits > nbits || length_bits > kMaxCodeLength) return;
+        const uint32_t code =
+            static_cast<uint32_t>(bits >> (nbits - length_bits)) &
+            ((1u << length_bits) - 1);
+        const uint32_t index = code - tables.first_code[length_bits];
+        if (index < tables.count[length_bits]) {
+          const uint16_t sym =
+              tables.symbols[tables.offset[length_bits] + index];
+          if (sym < 256) output(static_cast<uint8_t>(sym));
+          nbits -= length_bits;
+          break;
+        }
+      }
+    }
+  }
+
+ private:
+  static constexpr int kMaxCodeLength = 30;
+  static constexpr uint32_t kLookupMask = (1u << kLookupBits) - 1;
+
+  // A fast table entry packs: first symbol (bits 0-7), second symbol
+  // (bits 8-15), length of the first code (bits 16-20), combined length of
+  // both codes (bits 21-25) and the number of symbols (bits 26-27). A count
+  // of zero means the next code is longer than kLookupBits.
+  static int EntryCount(uint32_t entry) { return entry >> 26; }
+  static int EntryFirstLength(uint32_t entry) { return (entry >> 16) & 0x1f; }
+  static int EntryTotalLength(uint32_t entry) { return (entry >> 21) & 0x1f; }
+
+  struct Tables {
+    uint32_t fast[1 << kLookupBits];
+    // Canonical code layout, indexed by code length.
+    uint32_t first_code[kMaxCodeLength + 1];
+    uint16_t count[kMaxCodeLength + 1];
+    uint16_t offset[kMaxCodeLength + 1];
+    // Symbols ordered by (code length, code).
+    uint16_t symbols[GRPC_CHTTP2_NUM_HUFFSYMS];
+  };
+
+  static const Tables& GetTables();
+  static Tables* BuildTables();
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HUFFMAN_DECODER_H
@@ -497,6 +497,25 @@ struct grpc_chttp2_transport {
    * thereby reducing the number of induced frames. */
   uint32_t num_pending_induced_frames = 0;
   bool reading_paused_on_pending_induced_frames = false;
+
+  /** Adaptive write coalescing (GRPC_ARG_HTTP2_WRITE_COALESCING_BUDGET_US):
+      small writes on a busy connection may be held back briefly so that
+      frames from other streams share their syscall */
+  /** the longest a write may be held back, in microseconds; 0 disables */
+  int64_t write_coalescing_budget_us = 0;
+  /** moving average of how long the endpoint takes to complete a write */
+  double write_completion_us = 0;
+  /** when the in-flight write was handed to the endpoint */
+  gpr_timespec write_started_at;
+  /** is a gathered write being held back on the combiner? */
+  bool write_coalescing_holding = false;
+  /** when the held write has to be sent */
+  gpr_timespec write_coalescing_hold_until;
+  /** was the write about to be gathered already held back once? */
+  bool write_coalescing_released = false;
+  /** writes initiated while the current one was held back */
+  uint32_t write_coalescing_joined = 0;
+  grpc_closure write_coalescing_release_locked;
 };
 
 typedef enum {
@@ -701,6 +720,16 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     grpc_chttp2_transport* t);
 void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error);
 
+/** Should the write just gathered by grpc_chttp2_begin_write be held back to
+    coalesce with frames from other streams? Returns how long to hold it, in
+    microseconds, or 0 to send it now. */
+int64_t grpc_chttp2_write_coalescing_hold_us(grpc_chttp2_transport* t);
+/** Update the write completion time estimate used to size the hold. */
+void grpc_chttp2_write_coalescing_note_write_started(grpc_chttp2_transport* t);
+void grpc_chttp2_write_coalescing_note_write_finished(grpc_chttp2_transport* t);
+/** Stop holding a write once this many more writes were initiated. */
+#define GRPC_CHTTP2_WRITE_COALESCING_MAX_FRAMES 32
+
 /** Process one slice of incoming data; return 1 if the connection is still
     viable after reading, or 0 if the connection should be torn down */
 grpc_error_handle grpc_chttp2_perform_read(grpc_chttp2_transport* t,
@@ -22,19 +22,91 @@
 
 #include <string.h>
 
+#include <utility>
+
+#include "absl/container/inlined_vector.h"
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+/* Smallest power of two that is at least n. */
+static size_t round_up_to_power_of_two(size_t n) {
+  size_t out = 2;
+  while (out < n) out *= 2;
+  return out;
+}
+
+/* Right shift that keeps log2(capacity) bits of a 32 bit hash. */
+static uint8_t hash_shift_for(size_t capacity) {
+  uint8_t shift = 32;
+  while ((size_t{1} << (32 - shift)) < capacity) shift--;
+  return shift;
+}
+
+/* Fibonacci hashing: ids are allocated sequentially, and placing consecutive
+   ids in consecutive slots would make every new stream probe through the
+   cluster left by long lived ones. */
+static size_t home_slot(const grpc_chttp2_stream_map* map, uint32_t key) {
+  return static_cast<uint32_t>((key >> map->key_shift) * 0x9e3779b9u) >>
+         map->hash_shift;
+}
+
+/* How far the entry in slot is from its home slot. */
+static size_t probe_distance(const grpc_chttp2_stream_map* map, size_t slot) {
+  return (slot - home_slot(map, map->keys[slot])) & (map->capacity - 1);
+}
+
+/* Robin Hood insertion: an entry further from its home slot takes over the
+   slot of one closer to its own, so that each probe sequence stays short and
+   lookups and deletions can stop early. */
+static void insert(grpc_chttp2_stream_map* map, uint32_t key, void* value) {
+  const size_t mask = map->capacity - 1;
+  size_t slot = home_slot(map, key);
+  size_t distance = 0;
+  while (map->keys[slot] != 0) {
+    const size_t slot_distance = probe_distance(map, slot);
+    if (slot_distance < distance) {
+      std::swap(key, map->keys[slot]);
+      std::swap(value, map->values[slot]);
+      distance = slot_distance;
+    }
+    slot = (slot + 1) & mask;
+    distance++;
+  }
+  map->keys[slot] = key;
+  map->values[slot] = value;
+}
+
+/* Move all entries into a table of new_capacity slots. */
+static void rehash(grpc_chttp2_stream_map* map, size_t new_capacity) {
+  uint32_t* old_keys = map->keys;
+  void** old_values = map->values;
+  size_t old_capacity = map->capacity;
+  map->keys =
+      static_cast<uint32_t*>(gpr_zalloc(sizeof(uint32_t) * new_capacity));
+  map->values = static_cast<void**>(gpr_malloc(sizeof(void*) * new_capacity));
+  map->capacity = new_capacity;
+  map->hash_shift = hash_shift_for(new_capacity);
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old_keys[i] != 0) insert(map, old_keys[i], old_values[i]);
+  }
+  gpr_free(old_keys);
+  gpr_free(old_values);
+}
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
   GPR_DEBUG_ASSERT(initial_capacity > 1);
+  map->capacity = round_up_to_power_of_two(initial_capacity);
   map->keys =
-      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * initial_capacity));
+      static_cast<uint32_t*>(gpr_zalloc(sizeof(uint32_t) * map->capacity));
   map->values =
-      static_cast<void**>(gpr_malloc(sizeof(void*) * initial_capacity));
+      static_cast<void**>(gpr_malloc(sizeof(void*) * map->capacity));
+  map->hash_shift = hash_shift_for(map->capacity);
   map->count = 0;
-  map->free = 0;
-  map->capacity = initial_capacity;
+  map->last_key = 0;
+  map->key_shift = 1;
+  map->generation = 0;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
@@ -42,136 +114,118 @@ void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
   gpr_free(map->values);
 }
 
-static size_t compact(uint32_t* keys, void** values, size_t count) {
-  size_t i, out;
-
-  for (i = 0, out = 0; i < count; i++) {
-    if (values[i]) {
-      keys[out] = keys[i];
-      values[out] = values[i];
-      out++;
-    }
-  }
-
-  return out;
-}
-
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-
-  // The first assertion ensures that the table is monotonically increasing.
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
+  // The first assertion ensures that keys are monotonically increasing, and
+  // therefore that the key is not already in the map.
+  GPR_ASSERT(map->last_key < key);
   GPR_DEBUG_ASSERT(value);
-  // Asserting that the key is not already in the map can be a debug assertion.
-  // Why: we're already checking that the map elements are monotonically
-  // increasing. If we re-add a key, i.e. if the key is already present, then
-  // either it is the most recently added key in the map (in which case the
-  // first assertion fails due to key == last_key) or there is a more recently
-  // added (larger) key at the end of the map: in which case the first assertion
-  // still fails due to key < last_key.
-  GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
+  const bool parity_changed =
+      map->last_key != 0 && ((map->last_key ^ key) & 1) != 0;
+  map->last_key = key;
 
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
-    } else {
-      /* resize when less than 25% of the table is free, because compaction
-         won't help much */
-      map->capacity = capacity = 2 * capacity;
-      map->keys = keys = static_cast<uint32_t*>(
-          gpr_realloc(keys, capacity * sizeof(uint32_t)));
-      map->values = values =
-          static_cast<void**>(gpr_realloc(values, capacity * sizeof(void*)));
-    }
+  /* keep the table at most 3/4 full */
+  if ((map->count + 1) * 4 > map->capacity * 3) {
+    rehash(map, 2 * map->capacity);
+  }
+  /* keys of both parities would share home slots: spread them out instead */
+  if (parity_changed && map->key_shift != 0) {
+    map->key_shift = 0;
+    rehash(map, map->capacity);
   }
 
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  insert(map, key, value);
+  map->count++;
+  map->generation++;
 }
 
-template <bool strict_find>
-static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
-  size_t min_idx = 0;
-  size_t max_idx = map->count;
-  size_t mid_idx;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-  uint32_t mid_key;
-
-  GPR_DEBUG_ASSERT(!strict_find || max_idx > 0);
-  if (!strict_find && max_idx == 0) return nullptr;
-
-  while (min_idx < max_idx) {
-    /* find the midpoint, avoiding overflow */
-    mid_idx = min_idx + ((max_idx - min_idx) / 2);
-    mid_key = keys[mid_idx];
-
-    if (mid_key < key) {
-      min_idx = mid_idx + 1;
-    } else if (mid_key > key) {
-      max_idx = mid_idx;
-    } else /* mid_key == key */
-    {
-      return &values[mid_idx];
-    }
+static size_t find(grpc_chttp2_stream_map* map, uint32_t key) {
+  const size_t mask = map->capacity - 1;
+  size_t slot = home_slot(map, key);
+  for (size_t distance = 0; map->keys[slot] != 0; distance++) {
+    if (map->keys[slot] == key) return slot;
+    /* the key would have displaced any entry closer to its home slot */
+    if (probe_distance(map, slot) < distance) break;
+    slot = (slot + 1) & mask;
   }
-
-  GPR_DEBUG_ASSERT(!strict_find);
-  return nullptr;
+  return map->capacity;
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<true>(map, key);
-  GPR_DEBUG_ASSERT(pvalue != nullptr);
-  void* out = *pvalue;
-  GPR_DEBUG_ASSERT(out != nullptr);
-  *pvalue = nullptr;
-  map->free++;
-  /* recognize complete emptyness and ensure we can skip
-     defragmentation later */
-  if (map->free == map->count) {
-    map->free = map->count = 0;
+  if (key == 0) return nullptr;
+  size_t slot = find(map, key);
+  if (slot == map->capacity) return nullptr;
+  void* out = map->values[slot];
+  map->count--;
+  map->generation++;
+  /* Backward shift deletion: move the following entries back by one slot,
+     up to the first one that is already in its home slot. */
+  const size_t mask = map->capacity - 1;
+  size_t hole = slot;
+  size_t next = (hole + 1) & mask;
+  while (map->keys[next] != 0 && probe_distance(map, next) != 0) {
+    map->keys[hole] = map->keys[next];
+    map->values[hole] = map->values[next];
+    hole = next;
+    next = (next + 1) & mask;
   }
+  map->keys[hole] = 0;
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
   return out;
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<false>(map, key);
-  return pvalue != nullptr ? *pvalue : nullptr;
+  if (key == 0) return nullptr;
+  size_t slot = find(map, key);
+  return slot != map->capacity ? map->values[slot] : nullptr;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
-  return map->count - map->free;
+  return map->count;
 }
 
 void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
-  if (map->count == map->free) {
+  if (map->count == 0) {
     return nullptr;
   }
-  if (map->free != 0) {
-    map->count = compact(map->keys, map->values, map->count);
-    map->free = 0;
-    GPR_ASSERT(map->count > 0);
+  const size_t mask = map->capacity - 1;
+  size_t slot = static_cast<size_t>(rand()) & mask;
+  while (map->keys[slot] == 0) {
+    slot = (slot + 1) & mask;
   }
-  return map->values[(static_cast<size_t>(rand())) % map->count];
+  return map->values[slot];
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
                                      void* user_data) {
-  size_t i;
-
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
-      f(user_data, map->keys[i], map->values[i]);
+  /* The callback may add or delete entries, moving others around the table,
+     so visit a snapshot of the entries. Once the map changes, each entry is
+     looked up again before it is visited. Keys added meanwhile are larger
+     than any in the snapshot: pick them up in another round. The snapshot
+     lives on the stack unless the map is large. */
+  struct entry {
+    uint32_t key;
+    void* value;
+  };
+  absl::InlinedVector<entry, 64> entries;
+  uint32_t visited = 0;
+  while (map->count != 0 && map->last_key > visited) {
+    const uint32_t last_key = map->last_key;
+    const uint32_t generation = map->generation;
+    entries.clear();
+    for (size_t i = 0; i < map->capacity; i++) {
+      if (map->keys[i] > visited) {
+        entries.push_back({map->keys[i], map->values[i]});
+      }
+    }
+    for (const entry& e : entries) {
+      void* value = map->generation == generation
+                        ? e.value
+                        : grpc_chttp2_stream_map_find(map, e.key);
+      if (value != nullptr) f(user_data, e.key, value);
     }
+    visited = last_key;
   }
 }
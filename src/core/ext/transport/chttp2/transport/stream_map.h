@@ -25,16 +25,26 @@
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
+   Represented as an open addressed hash table with Robin Hood linear probing,
+   keeping keys and values in separate arrays so that probes only touch the
+   keys. Stream ids on a connection all have the same parity, so keys are
+   halved before hashing unless keys of both parities are added.
    Adds are restricted to strictly higher keys than previously seen (this is
-   guaranteed by http2). */
+   guaranteed by http2). Key 0 is never a valid stream id and marks an empty
+   slot. */
 struct grpc_chttp2_stream_map {
   uint32_t* keys;
   void** values;
   size_t count;
-  size_t free;
+  /* number of slots, a power of two */
   size_t capacity;
+  uint32_t last_key;
+  /* keys are shifted right by this much before hashing */
+  uint8_t key_shift;
+  /* hashes are shifted right by this much to index the table */
+  uint8_t hash_shift;
+  /* bumped on every add and delete */
+  uint32_t generation;
 };
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
@@ -58,7 +68,8 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map);
 /* How many (populated) entries are in the stream map? */
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map);
 
-/* Callback on each stream */
+/* Callback on each stream, in no particular order. The callback may add and
+   delete entries: added entries are visited too, deleted ones are skipped. */
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
@@ -20,6 +20,8 @@
 
 #include <limits.h>
 
+#include <algorithm>
+
 #include <grpc/support/log.h>
 
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
@@ -192,6 +194,45 @@ static uint32_t target_write_size(grpc_chttp2_transport* /*t*/) {
   return 1024 * 1024;
 }
 
+/* Writes at least this large already amortize their syscall well, so holding
+   them back to coalesce with more frames gains little. */
+#define WRITE_COALESCING_MAX_BYTES (64 * 1024)
+/* Weight of the newest sample in the write completion time average. */
+#define WRITE_COMPLETION_EWMA_WEIGHT 0.125
+
+int64_t grpc_chttp2_write_coalescing_hold_us(grpc_chttp2_transport* t) {
+  if (t->write_coalescing_budget_us == 0) return 0;
+  /* a write that was held back once is sent with whatever joined it */
+  if (t->write_coalescing_released) return 0;
+  if (t->outbuf.length >= WRITE_COALESCING_MAX_BYTES ||
+      t->outbuf.count >= GRPC_CHTTP2_WRITE_COALESCING_MAX_FRAMES) {
+    return 0;
+  }
+  /* with a single stream there is nothing to coalesce with */
+  if (grpc_chttp2_stream_map_size(&t->stream_map) < 2) {
+    return 0;
+  }
+  /* Hold for about as long as a write takes to complete: that is what another
+     stream would wait if it just missed this write, so the added latency is
+     bounded by the cost it saves. */
+  return std::min(t->write_coalescing_budget_us,
+                  static_cast<int64_t>(t->write_completion_us));
+}
+
+void grpc_chttp2_write_coalescing_note_write_started(grpc_chttp2_transport* t) {
+  if (t->write_coalescing_budget_us == 0) return;
+  t->write_started_at = gpr_now(GPR_CLOCK_MONOTONIC);
+}
+
+void grpc_chttp2_write_coalescing_note_write_finished(
+    grpc_chttp2_transport* t) {
+  if (t->write_coalescing_budget_us == 0) return;
+  const double sample_us = gpr_timespec_to_micros(
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), t->write_started_at));
+  t->write_completion_us +=
+      WRITE_COMPLETION_EWMA_WEIGHT * (sample_us - t->write_completion_us);
+}
+
 // Returns true if initial_metadata contains only default headers.
 static bool is_default_initial_metadata(grpc_metadata_batch* initial_metadata) {
   return initial_metadata->default_count() ==
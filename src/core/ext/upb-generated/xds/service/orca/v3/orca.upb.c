@@ -0,0 +1,33 @@
+/* This file was generated by upbc (the upb compiler) from the input
+ * file:
+ *
+ *     xds/service/orca/v3/orca.proto
+ *
+ * Do not edit -- your changes will be discarded when the file is
+ * regenerated. */
+
+#include <stddef.h>
+#include "upb/msg_internal.h"
+#include "xds/service/orca/v3/orca.upb.h"
+#include "xds/data/orca/v3/orca_load_report.upb.h"
+#include "google/protobuf/duration.upb.h"
+
+#include "upb/port_def.inc"
+
+static const upb_msglayout *const xds_service_orca_v3_OrcaLoadReportRequest_submsgs[1] = {
+  &google_protobuf_Duration_msginit,
+};
+
+static const upb_msglayout_field xds_service_orca_v3_OrcaLoadReportRequest__fields[2] = {
+  {1, UPB_SIZE(4, 8), 1, 0, 11, _UPB_MODE_SCALAR},
+  {2, UPB_SIZE(8, 16), 0, 0, 9, _UPB_MODE_ARRAY},
+};
+
+const upb_msglayout xds_service_orca_v3_OrcaLoadReportRequest_msginit = {
+  &xds_service_orca_v3_OrcaLoadReportRequest_submsgs[0],
+  &xds_service_orca_v3_OrcaLoadReportRequest__fields[0],
+  UPB_SIZE(16, 24), 2, false, 2, 255,
+};
+
+#include "upb/port_undef.inc"
+
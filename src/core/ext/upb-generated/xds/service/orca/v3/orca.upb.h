@@ -0,0 +1,90 @@
+/* This file was generated by upbc (the upb compiler) from the input
+ * file:
+ *
+ *     xds/service/orca/v3/orca.proto
+ *
+ * Do not edit -- your changes will be discarded when the file is
+ * regenerated. */
+
+#ifndef XDS_SERVICE_ORCA_V3_ORCA_PROTO_UPB_H_
+#define XDS_SERVICE_ORCA_V3_ORCA_PROTO_UPB_H_
+
+#include "upb/msg_internal.h"
+#include "upb/decode.h"
+#include "upb/decode_fast.h"
+#include "upb/encode.h"
+
+#include "upb/port_def.inc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct xds_service_orca_v3_OrcaLoadReportRequest;
+typedef struct xds_service_orca_v3_OrcaLoadReportRequest xds_service_orca_v3_OrcaLoadReportRequest;
+extern const upb_msglayout xds_service_orca_v3_OrcaLoadReportRequest_msginit;
+struct google_protobuf_Duration;
+extern const upb_msglayout google_protobuf_Duration_msginit;
+
+
+/* xds.service.orca.v3.OrcaLoadReportRequest */
+
+UPB_INLINE xds_service_orca_v3_OrcaLoadReportRequest *xds_service_orca_v3_OrcaLoadReportRequest_new(upb_arena *arena) {
+  return (xds_service_orca_v3_OrcaLoadReportRequest *)_upb_msg_new(&xds_service_orca_v3_OrcaLoadReportRequest_msginit, arena);
+}
+UPB_INLINE xds_service_orca_v3_OrcaLoadReportRequest *xds_service_orca_v3_OrcaLoadReportRequest_parse(const char *buf, size_t size,
+                        upb_arena *arena) {
+  xds_service_orca_v3_OrcaLoadReportRequest *ret = xds_service_orca_v3_OrcaLoadReportRequest_new(arena);
+  if (!ret) return NULL;
+  if (!upb_decode(buf, size, ret, &xds_service_orca_v3_OrcaLoadReportRequest_msginit, arena)) return NULL;
+  return ret;
+}
+UPB_INLINE xds_service_orca_v3_OrcaLoadReportRequest *xds_service_orca_v3_OrcaLoadReportRequest_parse_ex(const char *buf, size_t size,
+                           const upb_extreg *extreg, int options,
+                           upb_arena *arena) {
+  xds_service_orca_v3_OrcaLoadReportRequest *ret = xds_service_orca_v3_OrcaLoadReportRequest_new(arena);
+  if (!ret) return NULL;
+  if (!_upb_decode(buf, size, ret, &xds_service_orca_v3_OrcaLoadReportRequest_msginit, extreg, options, arena)) {
+    return NULL;
+  }
+  return ret;
+}
+UPB_INLINE char *xds_service_orca_v3_OrcaLoadReportRequest_serialize(const xds_service_orca_v3_OrcaLoadReportRequest *msg, upb_arena *arena, size_t *len) {
+  return upb_encode(msg, &xds_service_orca_v3_OrcaLoadReportRequest_msginit, arena, len);
+}
+
+UPB_INLINE bool xds_service_orca_v3_OrcaLoadReportRequest_has_report_interval(const xds_service_orca_v3_OrcaLoadReportRequest *msg) { return _upb_hasbit(msg, 1); }
+UPB_INLINE const struct google_protobuf_Duration* xds_service_orca_v3_OrcaLoadReportRequest_report_interval(const xds_service_orca_v3_OrcaLoadReportRequest *msg) { return *UPB_PTR_AT(msg, UPB_SIZE(4, 8), const struct google_protobuf_Duration*); }
+UPB_INLINE upb_strview const* xds_service_orca_v3_OrcaLoadReportRequest_request_cost_names(const xds_service_orca_v3_OrcaLoadReportRequest *msg, size_t *len) { return (upb_strview const*)_upb_array_accessor(msg, UPB_SIZE(8, 16), len); }
+
+UPB_INLINE void xds_service_orca_v3_OrcaLoadReportRequest_set_report_interval(xds_service_orca_v3_OrcaLoadReportRequest *msg, struct google_protobuf_Duration* value) {
+  _upb_sethas(msg, 1);
+  *UPB_PTR_AT(msg, UPB_SIZE(4, 8), struct google_protobuf_Duration*) = value;
+}
+UPB_INLINE struct google_protobuf_Duration* xds_service_orca_v3_OrcaLoadReportRequest_mutable_report_interval(xds_service_orca_v3_OrcaLoadReportRequest *msg, upb_arena *arena) {
+  struct google_protobuf_Duration* sub = (struct google_protobuf_Duration*)xds_service_orca_v3_OrcaLoadReportRequest_report_interval(msg);
+  if (sub == NULL) {
+    sub = (struct google_protobuf_Duration*)_upb_msg_new(&google_protobuf_Duration_msginit, arena);
+    if (!sub) return NULL;
+    xds_service_orca_v3_OrcaLoadReportRequest_set_report_interval(msg, sub);
+  }
+  return sub;
+}
+UPB_INLINE upb_strview* xds_service_orca_v3_OrcaLoadReportRequest_mutable_request_cost_names(xds_service_orca_v3_OrcaLoadReportRequest *msg, size_t *len) {
+  return (upb_strview*)_upb_array_mutable_accessor(msg, UPB_SIZE(8, 16), len);
+}
+UPB_INLINE upb_strview* xds_service_orca_v3_OrcaLoadReportRequest_resize_request_cost_names(xds_service_orca_v3_OrcaLoadReportRequest *msg, size_t len, upb_arena *arena) {
+  return (upb_strview*)_upb_array_resize_accessor2(msg, UPB_SIZE(8, 16), len, UPB_SIZE(3, 4), arena);
+}
+UPB_INLINE bool xds_service_orca_v3_OrcaLoadReportRequest_add_request_cost_names(xds_service_orca_v3_OrcaLoadReportRequest *msg, upb_strview val, upb_arena *arena) {
+  return _upb_array_append_accessor2(msg, UPB_SIZE(8, 16), UPB_SIZE(3, 4), &val,
+      arena);
+}
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#include "upb/port_undef.inc"
+
+#endif  /* XDS_SERVICE_ORCA_V3_ORCA_PROTO_UPB_H_ */
@@ -0,0 +1,53 @@
+/* This file was generated by upbc (the upb compiler) from the input
+ * file:
+ *
+ *     xds/service/orca/v3/orca.proto
+ *
+ * Do not edit -- your changes will be discarded when the file is
+ * regenerated. */
+
+#include "upb/def.h"
+#include "xds/service/orca/v3/orca.upbdefs.h"
+
+extern upb_def_init xds_data_orca_v3_orca_load_report_proto_upbdefinit;
+extern upb_def_init google_protobuf_duration_proto_upbdefinit;
+extern const upb_msglayout xds_service_orca_v3_OrcaLoadReportRequest_msginit;
+
+static const upb_msglayout *layouts[1] = {
+  &xds_service_orca_v3_OrcaLoadReportRequest_msginit,
+};
+
+static const char descriptor[484] = {'\n', '\036', 'x', 'd', 's', '/', 's', 'e', 'r', 'v', 'i', 'c', 'e', '/', 'o', 'r', 'c', 'a', '/', 'v', '3', '/', 'o', 'r', 'c', 
+'a', '.', 'p', 'r', 'o', 't', 'o', '\022', '\023', 'x', 'd', 's', '.', 's', 'e', 'r', 'v', 'i', 'c', 'e', '.', 'o', 'r', 'c', 'a', 
+'.', 'v', '3', '\032', '\'', 'x', 'd', 's', '/', 'd', 'a', 't', 'a', '/', 'o', 'r', 'c', 'a', '/', 'v', '3', '/', 'o', 'r', 'c', 
+'a', '_', 'l', 'o', 'a', 'd', '_', 'r', 'e', 'p', 'o', 'r', 't', '.', 'p', 'r', 'o', 't', 'o', '\032', '\036', 'g', 'o', 'o', 'g', 
+'l', 'e', '/', 'p', 'r', 'o', 't', 'o', 'b', 'u', 'f', '/', 'd', 'u', 'r', 'a', 't', 'i', 'o', 'n', '.', 'p', 'r', 'o', 't', 
+'o', '\"', '\211', '\001', '\n', '\025', 'O', 'r', 'c', 'a', 'L', 'o', 'a', 'd', 'R', 'e', 'p', 'o', 'r', 't', 'R', 'e', 'q', 'u', 'e', 
+'s', 't', '\022', 'B', '\n', '\017', 'r', 'e', 'p', 'o', 'r', 't', '_', 'i', 'n', 't', 'e', 'r', 'v', 'a', 'l', '\030', '\001', ' ', '\001', 
+'(', '\013', '2', '\031', '.', 'g', 'o', 'o', 'g', 'l', 'e', '.', 'p', 'r', 'o', 't', 'o', 'b', 'u', 'f', '.', 'D', 'u', 'r', 'a', 
+'t', 'i', 'o', 'n', 'R', '\016', 'r', 'e', 'p', 'o', 'r', 't', 'I', 'n', 't', 'e', 'r', 'v', 'a', 'l', '\022', ',', '\n', '\022', 'r', 
+'e', 'q', 'u', 'e', 's', 't', '_', 'c', 'o', 's', 't', '_', 'n', 'a', 'm', 'e', 's', '\030', '\002', ' ', '\003', '(', '\t', 'R', '\020', 
+'r', 'e', 'q', 'u', 'e', 's', 't', 'C', 'o', 's', 't', 'N', 'a', 'm', 'e', 's', '2', 'u', '\n', '\016', 'O', 'p', 'e', 'n', 'R', 
+'c', 'a', 'S', 'e', 'r', 'v', 'i', 'c', 'e', '\022', 'c', '\n', '\021', 'S', 't', 'r', 'e', 'a', 'm', 'C', 'o', 'r', 'e', 'M', 'e', 
+'t', 'r', 'i', 'c', 's', '\022', '*', '.', 'x', 'd', 's', '.', 's', 'e', 'r', 'v', 'i', 'c', 'e', '.', 'o', 'r', 'c', 'a', '.', 
+'v', '3', '.', 'O', 'r', 'c', 'a', 'L', 'o', 'a', 'd', 'R', 'e', 'p', 'o', 'r', 't', 'R', 'e', 'q', 'u', 'e', 's', 't', '\032', 
+' ', '.', 'x', 'd', 's', '.', 'd', 'a', 't', 'a', '.', 'o', 'r', 'c', 'a', '.', 'v', '3', '.', 'O', 'r', 'c', 'a', 'L', 'o', 
+'a', 'd', 'R', 'e', 'p', 'o', 'r', 't', '0', '\001', 'B', 'Y', '\n', '\036', 'c', 'o', 'm', '.', 'g', 'i', 't', 'h', 'u', 'b', '.', 
+'x', 'd', 's', '.', 's', 'e', 'r', 'v', 'i', 'c', 'e', '.', 'o', 'r', 'c', 'a', '.', 'v', '3', 'B', '\t', 'O', 'r', 'c', 'a', 
+'P', 'r', 'o', 't', 'o', 'P', '\001', 'Z', '*', 'g', 'i', 't', 'h', 'u', 'b', '.', 'c', 'o', 'm', '/', 'c', 'n', 'c', 'f', '/', 
+'x', 'd', 's', '/', 'g', 'o', '/', 'x', 'd', 's', '/', 's', 'e', 'r', 'v', 'i', 'c', 'e', '/', 'o', 'r', 'c', 'a', '/', 'v', 
+'3', 'b', '\006', 'p', 'r', 'o', 't', 'o', '3', 
+};
+
+static upb_def_init *deps[3] = {
+  &xds_data_orca_v3_orca_load_report_proto_upbdefinit,
+  &google_protobuf_duration_proto_upbdefinit,
+  NULL
+};
+
+upb_def_init xds_service_orca_v3_orca_proto_upbdefinit = {
+  deps,
+  layouts,
+  "xds/service/orca/v3/orca.proto",
+  UPB_STRVIEW_INIT(descriptor, 484)
+};
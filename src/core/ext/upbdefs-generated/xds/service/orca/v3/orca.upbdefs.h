@@ -0,0 +1,35 @@
+/* This file was generated by upbc (the upb compiler) from the input
+ * file:
+ *
+ *     xds/service/orca/v3/orca.proto
+ *
+ * Do not edit -- your changes will be discarded when the file is
+ * regenerated. */
+
+#ifndef XDS_SERVICE_ORCA_V3_ORCA_PROTO_UPBDEFS_H_
+#define XDS_SERVICE_ORCA_V3_ORCA_PROTO_UPBDEFS_H_
+
+#include "upb/def.h"
+#include "upb/port_def.inc"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "upb/def.h"
+
+#include "upb/port_def.inc"
+
+extern upb_def_init xds_service_orca_v3_orca_proto_upbdefinit;
+
+UPB_INLINE const upb_msgdef *xds_service_orca_v3_OrcaLoadReportRequest_getmsgdef(upb_symtab *s) {
+  _upb_symtab_loaddefinit(s, &xds_service_orca_v3_orca_proto_upbdefinit);
+  return upb_symtab_lookupmsg(s, "xds.service.orca.v3.OrcaLoadReportRequest");
+}
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#include "upb/port_undef.inc"
+
+#endif  /* XDS_SERVICE_ORCA_V3_ORCA_PROTO_UPBDEFS_H_ */
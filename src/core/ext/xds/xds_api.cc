@@ -91,6 +91,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy/pick_random.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/gpr/env.h"
 #include "src/core/lib/gpr/string.h"
@@ -741,6 +742,8 @@ std::string XdsApi::CdsUpdate::ToString() const {
   if (lb_policy == "RING_HASH") {
     contents.push_back(absl::StrCat("min_ring_size=", min_ring_size));
     contents.push_back(absl::StrCat("max_ring_size=", max_ring_size));
+  } else if (lb_policy == "LEAST_REQUEST") {
+    contents.push_back(absl::StrCat("choice_count=", choice_count));
   }
   contents.push_back(
       absl::StrFormat("max_concurrent_requests=%d", max_concurrent_requests));
@@ -787,7 +790,7 @@ bool XdsApi::EdsUpdate::DropConfig::ShouldDrop(
   for (size_t i = 0; i < drop_category_list_.size(); ++i) {
     const auto& drop_category = drop_category_list_[i];
     // Generate a random number in [0, 1000000).
-    const uint32_t random = static_cast<uint32_t>(rand()) % 1000000;
+    const uint32_t random = PickRandom() % 1000000;
     if (random < drop_category.parts_per_million) {
       *category_name = &drop_category.name;
       return true;
@@ -3234,6 +3237,25 @@ grpc_error_handle CdsResourceParse(
             "ring hash lb config has invalid hash function."));
       }
     }
+  } else if (envoy_config_cluster_v3_Cluster_lb_policy(cluster) ==
+             envoy_config_cluster_v3_Cluster_LEAST_REQUEST) {
+    cds_update->lb_policy = "LEAST_REQUEST";
+    // Record least request lb config
+    auto* least_request_config =
+        envoy_config_cluster_v3_Cluster_least_request_lb_config(cluster);
+    if (least_request_config != nullptr) {
+      const google_protobuf_UInt32Value* choice_count =
+          envoy_config_cluster_v3_Cluster_LeastRequestLbConfig_choice_count(
+              least_request_config);
+      if (choice_count != nullptr) {
+        cds_update->choice_count =
+            google_protobuf_UInt32Value_value(choice_count);
+        if (cds_update->choice_count < 2) {
+          errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "choice_count must be at least 2."));
+        }
+      }
+    }
   } else {
     errors.push_back(
         GRPC_ERROR_CREATE_FROM_STATIC_STRING("LB policy is not supported."));
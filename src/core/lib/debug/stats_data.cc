@@ -29,6 +29,8 @@
 const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "client_calls_created",
     "server_calls_created",
+    "arena_pool_hits",
+    "arena_pool_misses",
     "cqs_created",
     "client_channels_created",
     "client_subchannels_created",
@@ -48,6 +50,10 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "syscall_read",
     "tcp_backup_pollers_created",
     "tcp_backup_poller_polls",
+    "tcp_read_buffer_slab_hits",
+    "tcp_read_buffer_slab_misses",
+    "tcp_batched_writes",
+    "tcp_batched_write_syscalls",
     "http2_op_batches",
     "http2_op_cancel",
     "http2_op_send_initial_metadata",
@@ -84,6 +90,7 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "http2_initiate_write_due_to_ping_response",
     "http2_initiate_write_due_to_force_rst_stream",
     "http2_spurious_writes_begun",
+    "http2_writes_coalesced",
     "hpack_recv_indexed",
     "hpack_recv_lithdr_incidx",
     "hpack_recv_lithdr_incidx_v",
@@ -129,6 +136,8 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
 const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
     "Number of server side calls created by this process",
+    "Number of call arenas created from memory recycled by the arena pool",
+    "Number of poolable call arenas that had to be allocated",
     "Number of completion queues created",
     "Number of client channels created",
     "Number of client subchannels created",
@@ -157,6 +166,11 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
     "Number of times a backup poller has been created (this can be expensive)",
     "Number of polls performed on the backup poller",
+    "Number of read buffers reused from the read buffer slab",
+    "Number of slab sized read buffers that had to be allocated",
+    "Number of writes sent through a poller write batch",
+    "Number of syscalls that sent batched writes; tcp_batched_writes divided "
+    "by this gives writes per syscall",
     "Number of batches received by HTTP2 transport",
     "Number of cancelations received by HTTP2 transport",
     "Number of batches containing send initial metadata",
@@ -198,6 +212,7 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of HTTP2 writes initiated due to 'ping_response'",
     "Number of HTTP2 writes initiated due to 'force_rst_stream'",
     "Number of HTTP2 writes initiated with nothing to write",
+    "Number of HTTP2 writes delayed to coalesce frames from other streams",
     "Number of HPACK indexed fields received",
     "Number of HPACK literal headers received with incremental indexing",
     "Number of HPACK literal headers received with incremental indexing and "
@@ -30,6 +30,8 @@
 typedef enum {
   GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED,
   GRPC_STATS_COUNTER_SERVER_CALLS_CREATED,
+  GRPC_STATS_COUNTER_ARENA_POOL_HITS,
+  GRPC_STATS_COUNTER_ARENA_POOL_MISSES,
   GRPC_STATS_COUNTER_CQS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_SUBCHANNELS_CREATED,
@@ -49,6 +51,10 @@ typedef enum {
   GRPC_STATS_COUNTER_SYSCALL_READ,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS,
+  GRPC_STATS_COUNTER_TCP_READ_BUFFER_SLAB_HITS,
+  GRPC_STATS_COUNTER_TCP_READ_BUFFER_SLAB_MISSES,
+  GRPC_STATS_COUNTER_TCP_BATCHED_WRITES,
+  GRPC_STATS_COUNTER_TCP_BATCHED_WRITE_SYSCALLS,
   GRPC_STATS_COUNTER_HTTP2_OP_BATCHES,
   GRPC_STATS_COUNTER_HTTP2_OP_CANCEL,
   GRPC_STATS_COUNTER_HTTP2_OP_SEND_INITIAL_METADATA,
@@ -85,6 +91,7 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_PING_RESPONSE,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_FORCE_RST_STREAM,
   GRPC_STATS_COUNTER_HTTP2_SPURIOUS_WRITES_BEGUN,
+  GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED,
   GRPC_STATS_COUNTER_HPACK_RECV_INDEXED,
   GRPC_STATS_COUNTER_HPACK_RECV_LITHDR_INCIDX,
   GRPC_STATS_COUNTER_HPACK_RECV_LITHDR_INCIDX_V,
@@ -182,6 +189,10 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED)
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_CALLS_CREATED)
+#define GRPC_STATS_INC_ARENA_POOL_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_ARENA_POOL_HITS)
+#define GRPC_STATS_INC_ARENA_POOL_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_ARENA_POOL_MISSES)
 #define GRPC_STATS_INC_CQS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQS_CREATED)
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED() \
@@ -220,6 +231,14 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED)
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS)
+#define GRPC_STATS_INC_TCP_READ_BUFFER_SLAB_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_READ_BUFFER_SLAB_HITS)
+#define GRPC_STATS_INC_TCP_READ_BUFFER_SLAB_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_READ_BUFFER_SLAB_MISSES)
+#define GRPC_STATS_INC_TCP_BATCHED_WRITES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BATCHED_WRITES)
+#define GRPC_STATS_INC_TCP_BATCHED_WRITE_SYSCALLS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BATCHED_WRITE_SYSCALLS)
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_OP_BATCHES)
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL() \
@@ -313,6 +332,8 @@ typedef enum {
       GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_FORCE_RST_STREAM)
 #define GRPC_STATS_INC_HTTP2_SPURIOUS_WRITES_BEGUN() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_SPURIOUS_WRITES_BEGUN)
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED)
 #define GRPC_STATS_INC_HPACK_RECV_INDEXED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_RECV_INDEXED)
 #define GRPC_STATS_INC_HPACK_RECV_LITHDR_INCIDX() \
@@ -438,6 +459,8 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #else
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED()
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED()
+#define GRPC_STATS_INC_ARENA_POOL_HITS()
+#define GRPC_STATS_INC_ARENA_POOL_MISSES()
 #define GRPC_STATS_INC_CQS_CREATED()
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED()
 #define GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED()
@@ -457,6 +480,10 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_SYSCALL_READ()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLERS_CREATED()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS()
+#define GRPC_STATS_INC_TCP_READ_BUFFER_SLAB_HITS()
+#define GRPC_STATS_INC_TCP_READ_BUFFER_SLAB_MISSES()
+#define GRPC_STATS_INC_TCP_BATCHED_WRITES()
+#define GRPC_STATS_INC_TCP_BATCHED_WRITE_SYSCALLS()
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES()
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL()
 #define GRPC_STATS_INC_HTTP2_OP_SEND_INITIAL_METADATA()
@@ -493,6 +520,7 @@ void grpc_stats_inc_server_cqs_checked(int value);
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_PING_RESPONSE()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_FORCE_RST_STREAM()
 #define GRPC_STATS_INC_HTTP2_SPURIOUS_WRITES_BEGUN()
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED()
 #define GRPC_STATS_INC_HPACK_RECV_INDEXED()
 #define GRPC_STATS_INC_HPACK_RECV_LITHDR_INCIDX()
 #define GRPC_STATS_INC_HPACK_RECV_LITHDR_INCIDX_V()
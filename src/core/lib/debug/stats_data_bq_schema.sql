@@ -1,5 +1,7 @@
 client_calls_created_per_iteration:FLOAT,
 server_calls_created_per_iteration:FLOAT,
+arena_pool_hits_per_iteration:FLOAT,
+arena_pool_misses_per_iteration:FLOAT,
 cqs_created_per_iteration:FLOAT,
 client_channels_created_per_iteration:FLOAT,
 client_subchannels_created_per_iteration:FLOAT,
@@ -19,6 +21,10 @@ syscall_write_per_iteration:FLOAT,
 syscall_read_per_iteration:FLOAT,
 tcp_backup_pollers_created_per_iteration:FLOAT,
 tcp_backup_poller_polls_per_iteration:FLOAT,
+tcp_read_buffer_slab_hits_per_iteration:FLOAT,
+tcp_read_buffer_slab_misses_per_iteration:FLOAT,
+tcp_batched_writes_per_iteration:FLOAT,
+tcp_batched_write_syscalls_per_iteration:FLOAT,
 http2_op_batches_per_iteration:FLOAT,
 http2_op_cancel_per_iteration:FLOAT,
 http2_op_send_initial_metadata_per_iteration:FLOAT,
@@ -55,6 +61,7 @@ http2_initiate_write_due_to_transport_flow_control_unstalled_per_iteration:FLOAT
 http2_initiate_write_due_to_ping_response_per_iteration:FLOAT,
 http2_initiate_write_due_to_force_rst_stream_per_iteration:FLOAT,
 http2_spurious_writes_begun_per_iteration:FLOAT,
+http2_writes_coalesced_per_iteration:FLOAT,
 hpack_recv_indexed_per_iteration:FLOAT,
 hpack_recv_lithdr_incidx_per_iteration:FLOAT,
 hpack_recv_lithdr_incidx_v_per_iteration:FLOAT,
@@ -0,0 +1,251 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <grpc/support/log.h>
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+namespace {
+constexpr int kMaxEpollEvents = 100;
+}  // namespace
+
+//
+// EventHandle
+//
+
+EventHandle::EventHandle(EpollPoller* poller, ThreadPool* pool)
+    : poller_(poller), pool_(pool) {}
+
+void EventHandle::Init(int fd) {
+  fd_ = fd;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = false;
+    shutdown_status_ = absl::OkStatus();
+  }
+  // The poller thread may still SetReady() this handle because of an event
+  // that was queued for its previous fd, so these must be atomic stores.
+  read_state_.store(kNotReady, std::memory_order_relaxed);
+  write_state_.store(kNotReady, std::memory_order_relaxed);
+  struct epoll_event ev;
+  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
+  ev.data.ptr = this;
+  if (epoll_ctl(poller_->epfd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+  }
+}
+
+void EventHandle::NotifyOnRead(PosixEngineClosure* on_read) {
+  NotifyOn(&read_state_, on_read);
+}
+
+void EventHandle::NotifyOnWrite(PosixEngineClosure* on_write) {
+  NotifyOn(&write_state_, on_write);
+}
+
+void EventHandle::NotifyOn(std::atomic<intptr_t>* state,
+                           PosixEngineClosure* closure) {
+  while (true) {
+    intptr_t curr = state->load(std::memory_order_acquire);
+    switch (curr) {
+      case kNotReady:
+        // Pairs with the acquire in SetReady/SetShutdown, which will pick up
+        // and schedule the closure.
+        if (state->compare_exchange_strong(curr,
+                                           reinterpret_cast<intptr_t>(closure),
+                                           std::memory_order_release)) {
+          return;
+        }
+        break;
+      case kReady:
+        if (state->compare_exchange_strong(curr, kNotReady,
+                                           std::memory_order_relaxed)) {
+          closure->SetStatus(absl::OkStatus());
+          pool_->Add(closure);
+          return;
+        }
+        break;
+      case kShutdown:
+        closure->SetStatus(shutdown_status_);
+        pool_->Add(closure);
+        return;
+      default:
+        gpr_log(GPR_ERROR,
+                "EventHandle::NotifyOn called with a previous callback still "
+                "pending");
+        abort();
+    }
+  }
+}
+
+void EventHandle::SetReady(std::atomic<intptr_t>* state) {
+  while (true) {
+    intptr_t curr = state->load(std::memory_order_acquire);
+    switch (curr) {
+      case kReady:
+      case kShutdown:
+        return;
+      case kNotReady:
+        if (state->compare_exchange_strong(curr, kReady,
+                                           std::memory_order_relaxed)) {
+          return;
+        }
+        break;
+      default:
+        if (state->compare_exchange_strong(curr, kNotReady,
+                                           std::memory_order_acq_rel)) {
+          auto* closure = reinterpret_cast<PosixEngineClosure*>(curr);
+          closure->SetStatus(absl::OkStatus());
+          pool_->Add(closure);
+          return;
+        }
+        break;
+    }
+  }
+}
+
+void EventHandle::SetShutdown(std::atomic<intptr_t>* state) {
+  // Shutdown is terminal, so a plain exchange is enough.
+  intptr_t curr = state->exchange(kShutdown, std::memory_order_acq_rel);
+  if (curr != kNotReady && curr != kReady && curr != kShutdown) {
+    auto* closure = reinterpret_cast<PosixEngineClosure*>(curr);
+    closure->SetStatus(shutdown_status_);
+    pool_->Add(closure);
+  }
+}
+
+void EventHandle::ShutdownHandle(absl::Status why) {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    if (shutdown_) return;
+    shutdown_ = true;
+    shutdown_status_ = std::move(why);
+  }
+  shutdown(fd_, SHUT_RDWR);
+  SetShutdown(&read_state_);
+  SetShutdown(&write_state_);
+}
+
+bool EventHandle::IsHandleShutdown() {
+  grpc_core::MutexLock lock(&mu_);
+  return shutdown_;
+}
+
+void EventHandle::OrphanHandle() {
+  epoll_ctl(poller_->epfd_, EPOLL_CTL_DEL, fd_, nullptr);
+  close(fd_);
+  fd_ = -1;
+  poller_->ReleaseHandle(this);
+}
+
+//
+// EpollPoller
+//
+
+EpollPoller::EpollPoller(ThreadPool* pool) : pool_(pool) {
+  epfd_ = epoll_create1(EPOLL_CLOEXEC);
+  GPR_ASSERT(epfd_ >= 0);
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  GPR_ASSERT(wakeup_fd_ >= 0);
+  struct epoll_event ev;
+  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
+  // Real handles are never null, which identifies the wakeup fd.
+  ev.data.ptr = nullptr;
+  GPR_ASSERT(epoll_ctl(epfd_, EPOLL_CTL_ADD, wakeup_fd_, &ev) == 0);
+  thread_ = grpc_core::Thread("event_engine_poller", &EpollPoller::ThreadBody,
+                              this);
+  thread_.Start();
+}
+
+EpollPoller::~EpollPoller() {
+  Shutdown();
+  close(wakeup_fd_);
+  close(epfd_);
+  grpc_core::MutexLock lock(&mu_);
+  for (EventHandle* handle : all_handles_) delete handle;
+}
+
+void EpollPoller::Shutdown() {
+  if (shutdown_.exchange(true)) return;
+  eventfd_write(wakeup_fd_, 1);
+  thread_.Join();
+}
+
+EventHandle* EpollPoller::CreateHandle(int fd) {
+  EventHandle* handle;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    handle = free_list_;
+    if (handle != nullptr) {
+      free_list_ = handle->next_free_;
+    } else {
+      handle = new EventHandle(this, pool_);
+      all_handles_.push_back(handle);
+    }
+  }
+  handle->Init(fd);
+  return handle;
+}
+
+void EpollPoller::ReleaseHandle(EventHandle* handle) {
+  grpc_core::MutexLock lock(&mu_);
+  handle->next_free_ = free_list_;
+  free_list_ = handle;
+}
+
+void EpollPoller::Loop() {
+  struct epoll_event events[kMaxEpollEvents];
+  while (!shutdown_.load(std::memory_order_relaxed)) {
+    int r = epoll_wait(epfd_, events, kMaxEpollEvents, -1);
+    if (r < 0) {
+      if (errno != EINTR) {
+        gpr_log(GPR_ERROR, "epoll_wait failed: %s", strerror(errno));
+      }
+      continue;
+    }
+    for (int i = 0; i < r; ++i) {
+      auto* handle = static_cast<EventHandle*>(events[i].data.ptr);
+      if (handle == nullptr) {
+        eventfd_t value;
+        eventfd_read(wakeup_fd_, &value);
+        continue;
+      }
+      uint32_t ev = events[i].events;
+      bool cancel = (ev & EPOLLHUP) != 0;
+      bool error = (ev & EPOLLERR) != 0;
+      bool read_ev = (ev & (EPOLLIN | EPOLLPRI)) != 0;
+      bool write_ev = (ev & EPOLLOUT) != 0;
+      if (read_ev || cancel || error) handle->SetReady(&handle->read_state_);
+      if (write_ev || cancel || error) handle->SetReady(&handle->write_state_);
+    }
+  }
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
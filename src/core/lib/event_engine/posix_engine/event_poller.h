@@ -0,0 +1,143 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EVENT_POLLER_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EVENT_POLLER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "absl/status/status.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// A reusable callback that is handed a status when it runs. Owned by whoever
+// registers it with an EventHandle; it must stay alive until it has run.
+class PosixEngineClosure final : public experimental::EventEngine::Closure {
+ public:
+  explicit PosixEngineClosure(std::function<void(absl::Status)> cb)
+      : cb_(std::move(cb)) {}
+  void SetStatus(absl::Status status) { status_ = std::move(status); }
+  void Run() override { cb_(std::move(status_)); }
+
+ private:
+  std::function<void(absl::Status)> cb_;
+  absl::Status status_;
+};
+
+class EpollPoller;
+
+// Readiness tracking for one registered file descriptor.
+//
+// Read and write readiness are each a small lock-free state machine in the
+// style of iomgr's LockfreeEvent: NotReady -> Ready when epoll reports an
+// edge, NotReady -> <closure> when a caller wants to be notified, and any
+// state -> Shutdown. A closure is scheduled on the thread pool as soon as
+// both a closure and readiness are present.
+class EventHandle {
+ public:
+  int fd() const { return fd_; }
+
+  // Schedule \a on_read once the fd is readable (possibly immediately). At
+  // most one read and one write notification may be pending at a time.
+  void NotifyOnRead(PosixEngineClosure* on_read);
+  void NotifyOnWrite(PosixEngineClosure* on_write);
+
+  // Shut the socket down and fail pending and future notifications with
+  // \a why. Only the first call has any effect.
+  void ShutdownHandle(absl::Status why);
+  bool IsHandleShutdown();
+
+  // Unregister and close the fd. The handle must not be used afterwards.
+  void OrphanHandle();
+
+ private:
+  friend class EpollPoller;
+
+  static constexpr intptr_t kNotReady = 0;
+  static constexpr intptr_t kReady = 2;
+  static constexpr intptr_t kShutdown = 1;
+
+  EventHandle(EpollPoller* poller, ThreadPool* pool);
+  void Init(int fd);
+  void NotifyOn(std::atomic<intptr_t>* state, PosixEngineClosure* closure);
+  void SetReady(std::atomic<intptr_t>* state);
+  void SetShutdown(std::atomic<intptr_t>* state);
+
+  EpollPoller* const poller_;
+  ThreadPool* const pool_;
+  int fd_ = -1;
+  std::atomic<intptr_t> read_state_{kNotReady};
+  std::atomic<intptr_t> write_state_{kNotReady};
+  grpc_core::Mutex mu_;
+  // Written once, before either state is moved to kShutdown.
+  absl::Status shutdown_status_;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  EventHandle* next_free_ = nullptr;
+};
+
+// Owns an edge-triggered epoll set and the thread that waits on it.
+//
+// Handles are recycled through a freelist and only freed when the poller is
+// destroyed, so a stale epoll event for an orphaned fd at worst produces a
+// spurious wakeup on whichever fd reuses the handle.
+class EpollPoller {
+ public:
+  explicit EpollPoller(ThreadPool* pool);
+  ~EpollPoller();
+
+  EpollPoller(const EpollPoller&) = delete;
+  EpollPoller& operator=(const EpollPoller&) = delete;
+
+  // Start tracking readiness of the nonblocking fd \a fd.
+  EventHandle* CreateHandle(int fd);
+
+  // Stop the polling thread. Handles stay valid until destruction.
+  void Shutdown();
+
+ private:
+  friend class EventHandle;
+
+  static void ThreadBody(void* arg) { static_cast<EpollPoller*>(arg)->Loop(); }
+  void Loop();
+  void ReleaseHandle(EventHandle* handle);
+
+  ThreadPool* const pool_;
+  int epfd_;
+  int wakeup_fd_;
+  std::atomic<bool> shutdown_{false};
+  grpc_core::Thread thread_;
+  grpc_core::Mutex mu_;
+  EventHandle* free_list_ ABSL_GUARDED_BY(mu_) = nullptr;
+  std::vector<EventHandle*> all_handles_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EVENT_POLLER_H
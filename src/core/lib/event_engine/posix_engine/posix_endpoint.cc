@@ -0,0 +1,333 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+
+#include "absl/strings/str_cat.h"
+#include "absl/types/variant.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EndpointConfig;
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::MemoryAllocator;
+using ::grpc_event_engine::experimental::MemoryRequest;
+using ::grpc_event_engine::experimental::SliceBuffer;
+
+namespace {
+
+// Same defaults as the iomgr TCP endpoint.
+constexpr int kDefaultReadChunkSize = 8192;
+constexpr int kDefaultMinReadChunkSize = 256;
+constexpr int kDefaultMaxReadChunkSize = 4 * 1024 * 1024;
+constexpr size_t kMaxWriteIovecs = 260;
+
+int GetConfigInt(const EndpointConfig& config, absl::string_view key,
+                 int default_value) {
+  EndpointConfig::Setting setting = config.Get(key);
+  if (absl::holds_alternative<int>(setting)) {
+    return absl::get<int>(setting);
+  }
+  return default_value;
+}
+
+absl::Status ErrnoToStatus(absl::string_view call, int err) {
+  return absl::UnavailableError(absl::StrCat(call, ": ", strerror(err)));
+}
+
+EventEngine::ResolvedAddress GetAddress(
+    int fd, int (*getter)(int, struct sockaddr*, socklen_t*)) {
+  char buf[EventEngine::ResolvedAddress::MAX_SIZE_BYTES];
+  socklen_t len = sizeof(buf);
+  if (getter(fd, reinterpret_cast<struct sockaddr*>(buf), &len) != 0) {
+    return EventEngine::ResolvedAddress();
+  }
+  return EventEngine::ResolvedAddress(reinterpret_cast<struct sockaddr*>(buf),
+                                      len);
+}
+
+}  // namespace
+
+PosixEndpointOptions PosixEndpointOptions::FromConfig(
+    const EndpointConfig& config) {
+  PosixEndpointOptions options;
+  options.min_read_chunk_size =
+      std::max(1, GetConfigInt(config, GRPC_ARG_TCP_MIN_READ_CHUNK_SIZE,
+                               kDefaultMinReadChunkSize));
+  options.max_read_chunk_size =
+      std::max(options.min_read_chunk_size,
+               GetConfigInt(config, GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE,
+                            kDefaultMaxReadChunkSize));
+  options.read_chunk_size =
+      std::min(options.max_read_chunk_size,
+               std::max(options.min_read_chunk_size,
+                        GetConfigInt(config, GRPC_ARG_TCP_READ_CHUNK_SIZE,
+                                     kDefaultReadChunkSize)));
+  return options;
+}
+
+class PosixEndpoint::Impl : public grpc_core::RefCounted<Impl> {
+ public:
+  Impl(EventHandle* handle, ThreadPool* pool, MemoryAllocator allocator,
+       const PosixEndpointOptions& options)
+      : handle_(handle),
+        pool_(pool),
+        allocator_(std::move(allocator)),
+        peer_address_(GetAddress(handle->fd(), getpeername)),
+        local_address_(GetAddress(handle->fd(), getsockname)),
+        read_closure_([this](absl::Status status) {
+          OnReadable(std::move(status));
+        }),
+        min_read_chunk_size_(options.min_read_chunk_size),
+        max_read_chunk_size_(options.max_read_chunk_size),
+        target_read_size_(options.read_chunk_size),
+        write_closure_([this](absl::Status status) {
+          OnWritable(std::move(status));
+        }) {}
+
+  ~Impl() override {
+    grpc_slice_unref_internal(spare_read_slice_);
+    handle_->OrphanHandle();
+  }
+
+  void Shutdown() {
+    handle_->ShutdownHandle(absl::CancelledError("Endpoint shutdown"));
+  }
+
+  void Read(std::function<void(absl::Status)> on_read, SliceBuffer* buffer) {
+    GPR_ASSERT(on_read_ == nullptr);
+    on_read_ = std::move(on_read);
+    incoming_ = buffer->RawSliceBuffer();
+    // Released once on_read_ has been handed off.
+    Ref().release();
+    absl::Status status;
+    if (!DoRead(&status)) {
+      handle_->NotifyOnRead(&read_closure_);
+      return;
+    }
+    auto on_read_cb = std::move(on_read_);
+    on_read_ = nullptr;
+    pool_->Add([on_read_cb, status]() { on_read_cb(status); });
+    Unref();
+  }
+
+  void Write(std::function<void(absl::Status)> on_writable, SliceBuffer* data) {
+    GPR_ASSERT(on_write_ == nullptr);
+    outgoing_ = data->RawSliceBuffer();
+    outgoing_slice_idx_ = 0;
+    outgoing_byte_idx_ = 0;
+    absl::Status status;
+    if (DoWrite(&status)) {
+      pool_->Add([on_writable, status]() { on_writable(status); });
+      return;
+    }
+    on_write_ = std::move(on_writable);
+    // Released once on_write_ has been handed off.
+    Ref().release();
+    handle_->NotifyOnWrite(&write_closure_);
+  }
+
+  const EventEngine::ResolvedAddress& peer_address() const {
+    return peer_address_;
+  }
+  const EventEngine::ResolvedAddress& local_address() const {
+    return local_address_;
+  }
+
+ private:
+  void OnReadable(absl::Status status) {
+    if (status.ok() && !DoRead(&status)) {
+      handle_->NotifyOnRead(&read_closure_);
+      return;
+    }
+    auto on_read_cb = std::move(on_read_);
+    on_read_ = nullptr;
+    on_read_cb(std::move(status));
+    Unref();
+  }
+
+  void OnWritable(absl::Status status) {
+    if (status.ok() && !DoWrite(&status)) {
+      handle_->NotifyOnWrite(&write_closure_);
+      return;
+    }
+    auto on_write_cb = std::move(on_write_);
+    on_write_ = nullptr;
+    on_write_cb(std::move(status));
+    Unref();
+  }
+
+  // Returns false if the socket had nothing to read. Otherwise sets \a status
+  // and returns true.
+  bool DoRead(absl::Status* status) {
+    // Keep the slice around across EAGAINs so that an idle endpoint doesn't
+    // allocate on every wakeup.
+    if (GRPC_SLICE_LENGTH(spare_read_slice_) <
+        static_cast<size_t>(target_read_size_)) {
+      grpc_slice_unref_internal(spare_read_slice_);
+      spare_read_slice_ = allocator_.MakeSlice(
+          MemoryRequest(min_read_chunk_size_, target_read_size_));
+    }
+    size_t capacity = GRPC_SLICE_LENGTH(spare_read_slice_);
+    struct iovec iov;
+    iov.iov_base = GRPC_SLICE_START_PTR(spare_read_slice_);
+    iov.iov_len = capacity;
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    ssize_t n;
+    do {
+      n = recvmsg(handle_->fd(), &msg, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+      *status = ErrnoToStatus("recvmsg", errno);
+      return true;
+    }
+    if (n == 0) {
+      *status = absl::UnavailableError("Socket closed");
+      return true;
+    }
+    // Hand the slice's reference over to the caller's buffer.
+    grpc_slice_buffer_add(incoming_, grpc_slice_sub_no_ref(spare_read_slice_,
+                                                           0, n));
+    spare_read_slice_ = grpc_empty_slice();
+    if (static_cast<size_t>(n) == capacity) {
+      target_read_size_ = std::min(max_read_chunk_size_, target_read_size_ * 2);
+    } else if (n < target_read_size_ / 2) {
+      target_read_size_ = std::max(min_read_chunk_size_, target_read_size_ / 2);
+    }
+    *status = absl::OkStatus();
+    return true;
+  }
+
+  // Returns false if the socket could not take all of the outstanding data.
+  // Otherwise sets \a status and returns true.
+  bool DoWrite(absl::Status* status) {
+    while (true) {
+      struct iovec iov[kMaxWriteIovecs];
+      size_t iov_count = 0;
+      for (size_t i = outgoing_slice_idx_;
+           i < outgoing_->count && iov_count < kMaxWriteIovecs; ++i) {
+        size_t offset = i == outgoing_slice_idx_ ? outgoing_byte_idx_ : 0;
+        size_t length = GRPC_SLICE_LENGTH(outgoing_->slices[i]) - offset;
+        if (length == 0) continue;
+        iov[iov_count].iov_base =
+            GRPC_SLICE_START_PTR(outgoing_->slices[i]) + offset;
+        iov[iov_count].iov_len = length;
+        ++iov_count;
+      }
+      if (iov_count == 0) {
+        *status = absl::OkStatus();
+        return true;
+      }
+      struct msghdr msg;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = iov;
+      msg.msg_iovlen = iov_count;
+      ssize_t n;
+      do {
+        n = sendmsg(handle_->fd(), &msg, MSG_NOSIGNAL);
+      } while (n < 0 && errno == EINTR);
+      if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+        *status = ErrnoToStatus("sendmsg", errno);
+        return true;
+      }
+      size_t sent = static_cast<size_t>(n);
+      while (sent > 0) {
+        size_t remaining =
+            GRPC_SLICE_LENGTH(outgoing_->slices[outgoing_slice_idx_]) -
+            outgoing_byte_idx_;
+        if (sent < remaining) {
+          outgoing_byte_idx_ += sent;
+          break;
+        }
+        sent -= remaining;
+        ++outgoing_slice_idx_;
+        outgoing_byte_idx_ = 0;
+      }
+    }
+  }
+
+  EventHandle* const handle_;
+  ThreadPool* const pool_;
+  MemoryAllocator allocator_;
+  const EventEngine::ResolvedAddress peer_address_;
+  const EventEngine::ResolvedAddress local_address_;
+
+  PosixEngineClosure read_closure_;
+  std::function<void(absl::Status)> on_read_;
+  grpc_slice_buffer* incoming_ = nullptr;
+  grpc_slice spare_read_slice_ = grpc_empty_slice();
+  int min_read_chunk_size_;
+  int max_read_chunk_size_;
+  int target_read_size_;
+
+  PosixEngineClosure write_closure_;
+  std::function<void(absl::Status)> on_write_;
+  grpc_slice_buffer* outgoing_ = nullptr;
+  size_t outgoing_slice_idx_ = 0;
+  size_t outgoing_byte_idx_ = 0;
+};
+
+PosixEndpoint::PosixEndpoint(EventHandle* handle, ThreadPool* pool,
+                             MemoryAllocator allocator,
+                             const PosixEndpointOptions& options)
+    : impl_(grpc_core::MakeRefCounted<Impl>(handle, pool, std::move(allocator),
+                                            options)) {}
+
+PosixEndpoint::~PosixEndpoint() { impl_->Shutdown(); }
+
+void PosixEndpoint::Read(std::function<void(absl::Status)> on_read,
+                         SliceBuffer* buffer) {
+  impl_->Read(std::move(on_read), buffer);
+}
+
+void PosixEndpoint::Write(std::function<void(absl::Status)> on_writable,
+                          SliceBuffer* data) {
+  impl_->Write(std::move(on_writable), data);
+}
+
+const EventEngine::ResolvedAddress& PosixEndpoint::GetPeerAddress() const {
+  return impl_->peer_address();
+}
+
+const EventEngine::ResolvedAddress& PosixEndpoint::GetLocalAddress() const {
+  return impl_->local_address();
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
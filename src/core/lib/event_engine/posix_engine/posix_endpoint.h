@@ -0,0 +1,78 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENDPOINT_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENDPOINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <memory>
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// Endpoint settings, snapshotted from an EndpointConfig.
+struct PosixEndpointOptions {
+  int read_chunk_size;
+  int min_read_chunk_size;
+  int max_read_chunk_size;
+
+  static PosixEndpointOptions FromConfig(
+      const experimental::EndpointConfig& config);
+};
+
+// A stream socket endpoint driven by an EpollPoller.
+//
+// Reads and writes are attempted directly on the calling thread first and
+// only fall back to waiting for an epoll edge on EAGAIN. Callbacks always run
+// on the thread pool, never inline from Read() or Write(). Read buffers are
+// allocated from the endpoint's MemoryAllocator.
+//
+// Destroying the endpoint shuts the socket down and fails any outstanding
+// Read/Write with CANCELLED; the fd is closed once those callbacks have run.
+class PosixEndpoint final : public experimental::EventEngine::Endpoint {
+ public:
+  // Takes ownership of \a handle.
+  PosixEndpoint(EventHandle* handle, ThreadPool* pool,
+                experimental::MemoryAllocator allocator,
+                const PosixEndpointOptions& options);
+  ~PosixEndpoint() override;
+
+  void Read(std::function<void(absl::Status)> on_read,
+            experimental::SliceBuffer* buffer) override;
+  void Write(std::function<void(absl::Status)> on_writable,
+             experimental::SliceBuffer* data) override;
+  const experimental::EventEngine::ResolvedAddress& GetPeerAddress()
+      const override;
+  const experimental::EventEngine::ResolvedAddress& GetLocalAddress()
+      const override;
+
+ private:
+  class Impl;
+  grpc_core::RefCountedPtr<Impl> impl_;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENDPOINT_H
@@ -0,0 +1,555 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <unordered_set>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+#include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+using ::grpc_event_engine::posix_engine::EpollPoller;
+using ::grpc_event_engine::posix_engine::EventHandle;
+using ::grpc_event_engine::posix_engine::PosixEndpoint;
+using ::grpc_event_engine::posix_engine::PosixEndpointOptions;
+using ::grpc_event_engine::posix_engine::PosixEngineClosure;
+using ::grpc_event_engine::posix_engine::ThreadPool;
+
+namespace {
+
+absl::Status ErrnoToStatus(absl::string_view call, int err) {
+  return absl::UnavailableError(absl::StrCat(call, ": ", strerror(err)));
+}
+
+// Create a nonblocking stream socket suitable for \a addr.
+absl::StatusOr<int> CreateSocket(const EventEngine::ResolvedAddress& addr) {
+  int family = addr.address()->sa_family;
+  int fd = socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) return ErrnoToStatus("socket", errno);
+  if (family == AF_INET || family == AF_INET6) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  }
+  return fd;
+}
+
+//
+// PosixListener
+//
+
+class PosixListener final : public EventEngine::Listener {
+ public:
+  PosixListener(ThreadPool* pool, EpollPoller* poller,
+                AcceptCallback on_accept,
+                std::function<void(absl::Status)> on_shutdown,
+                const EndpointConfig& config,
+                std::unique_ptr<MemoryAllocatorFactory> allocator_factory)
+      : state_(grpc_core::MakeRefCounted<State>(
+            pool, poller, std::move(on_accept), std::move(on_shutdown),
+            PosixEndpointOptions::FromConfig(config),
+            std::move(allocator_factory))) {}
+
+  ~PosixListener() override { state_->Shutdown(); }
+
+  absl::StatusOr<int> Bind(const EventEngine::ResolvedAddress& addr) override {
+    return state_->Bind(addr);
+  }
+
+  absl::Status Start() override { return state_->Start(); }
+
+ private:
+  // Outlives the listener until every acceptor has seen the shutdown, then
+  // reports it through on_shutdown.
+  class State : public grpc_core::RefCounted<State> {
+   public:
+    State(ThreadPool* pool, EpollPoller* poller, AcceptCallback on_accept,
+          std::function<void(absl::Status)> on_shutdown,
+          PosixEndpointOptions options,
+          std::unique_ptr<MemoryAllocatorFactory> allocator_factory)
+        : pool_(pool),
+          poller_(poller),
+          on_accept_(std::move(on_accept)),
+          on_shutdown_(std::move(on_shutdown)),
+          options_(options),
+          allocator_factory_(std::move(allocator_factory)) {}
+
+    ~State() override { on_shutdown_(absl::OkStatus()); }
+
+    absl::StatusOr<int> Bind(const EventEngine::ResolvedAddress& addr) {
+      grpc_core::MutexLock lock(&mu_);
+      if (started_) {
+        return absl::FailedPreconditionError("Listener is already started");
+      }
+      auto fd = CreateSocket(addr);
+      if (!fd.ok()) return fd.status();
+      int one = 1;
+      setsockopt(*fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+      if (bind(*fd, addr.address(), addr.size()) != 0) {
+        absl::Status status = ErrnoToStatus("bind", errno);
+        close(*fd);
+        return status;
+      }
+      if (listen(*fd, SOMAXCONN) != 0) {
+        absl::Status status = ErrnoToStatus("listen", errno);
+        close(*fd);
+        return status;
+      }
+      struct sockaddr_storage bound;
+      socklen_t len = sizeof(bound);
+      int port = 0;
+      if (getsockname(*fd, reinterpret_cast<struct sockaddr*>(&bound), &len) ==
+          0) {
+        if (bound.ss_family == AF_INET) {
+          port = ntohs(reinterpret_cast<struct sockaddr_in*>(&bound)->sin_port);
+        } else if (bound.ss_family == AF_INET6) {
+          port =
+              ntohs(reinterpret_cast<struct sockaddr_in6*>(&bound)->sin6_port);
+        }
+      }
+      acceptors_.push_back(absl::make_unique<Acceptor>(this, *fd));
+      return port;
+    }
+
+    absl::Status Start() {
+      grpc_core::MutexLock lock(&mu_);
+      if (started_) {
+        return absl::FailedPreconditionError("Listener is already started");
+      }
+      started_ = true;
+      for (auto& acceptor : acceptors_) {
+        acceptor->handle = poller_->CreateHandle(acceptor->fd);
+        // Released by the acceptor once it sees the shutdown.
+        Ref().release();
+        acceptor->handle->NotifyOnRead(&acceptor->on_acceptable);
+      }
+      return absl::OkStatus();
+    }
+
+    void Shutdown() {
+      grpc_core::MutexLock lock(&mu_);
+      for (auto& acceptor : acceptors_) {
+        if (acceptor->handle != nullptr) {
+          acceptor->handle->ShutdownHandle(
+              absl::UnavailableError("Listener shutdown"));
+        } else {
+          // Bound but never started.
+          close(acceptor->fd);
+        }
+      }
+    }
+
+   private:
+    struct Acceptor {
+      Acceptor(State* state, int fd)
+          : fd(fd), on_acceptable([state, this](absl::Status status) {
+              state->OnAcceptable(this, std::move(status));
+            }) {}
+      int fd;
+      EventHandle* handle = nullptr;
+      PosixEngineClosure on_acceptable;
+    };
+
+    void OnAcceptable(Acceptor* acceptor, absl::Status status) {
+      if (!status.ok()) {
+        acceptor->handle->OrphanHandle();
+        Unref();
+        return;
+      }
+      while (true) {
+        int fd = accept4(acceptor->fd, nullptr, nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+          if (errno == EINTR || errno == ECONNABORTED) continue;
+          // A listening socket that has been shut down fails accept with
+          // EINVAL; the re-registration below then reports the shutdown.
+          if (errno != EAGAIN && errno != EWOULDBLOCK &&
+              !acceptor->handle->IsHandleShutdown()) {
+            gpr_log(GPR_ERROR, "accept4 failed: %s", strerror(errno));
+          }
+          acceptor->handle->NotifyOnRead(&acceptor->on_acceptable);
+          return;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        // The endpoint charges its read buffers to one allocator; the
+        // application gets a separate one for everything else it allocates
+        // on behalf of the connection.
+        auto endpoint = absl::make_unique<PosixEndpoint>(
+            poller_->CreateHandle(fd), pool_,
+            allocator_factory_->CreateMemoryAllocator(), options_);
+        on_accept_(std::move(endpoint),
+                   allocator_factory_->CreateMemoryAllocator());
+      }
+    }
+
+    ThreadPool* const pool_;
+    EpollPoller* const poller_;
+    const AcceptCallback on_accept_;
+    const std::function<void(absl::Status)> on_shutdown_;
+    const PosixEndpointOptions options_;
+    const std::unique_ptr<MemoryAllocatorFactory> allocator_factory_;
+    grpc_core::Mutex mu_;
+    bool started_ ABSL_GUARDED_BY(mu_) = false;
+    std::vector<std::unique_ptr<Acceptor>> acceptors_ ABSL_GUARDED_BY(mu_);
+  };
+
+  grpc_core::RefCountedPtr<State> state_;
+};
+
+//
+// PosixDNSResolver
+//
+
+// Resolves hostnames with getaddrinfo() on the thread pool. SRV and TXT
+// lookups need a DNS client (c-ares) and are not supported.
+class PosixDNSResolver final : public EventEngine::DNSResolver {
+ public:
+  explicit PosixDNSResolver(ThreadPool* pool)
+      : pool_(pool), state_(std::make_shared<State>()) {}
+
+  LookupTaskHandle LookupHostname(LookupHostnameCallback on_resolve,
+                                  absl::string_view address,
+                                  absl::string_view default_port,
+                                  absl::Time deadline) override {
+    LookupTaskHandle handle = state_->Register();
+    std::shared_ptr<State> state = state_;
+    std::string name(address);
+    std::string port(default_port);
+    pool_->Add([state, handle, on_resolve, name, port, deadline]() {
+      auto result = BlockingResolve(name, port);
+      if (absl::Now() > deadline) {
+        result = absl::DeadlineExceededError(
+            absl::StrCat("DNS lookup for ", name, " timed out"));
+      }
+      if (state->Finish(handle)) on_resolve(std::move(result));
+    });
+    return handle;
+  }
+
+  LookupTaskHandle LookupSRV(LookupSRVCallback on_resolve,
+                             absl::string_view /* name */,
+                             absl::Time /* deadline */) override {
+    return FailUnimplemented(std::move(on_resolve));
+  }
+
+  LookupTaskHandle LookupTXT(LookupTXTCallback on_resolve,
+                             absl::string_view /* name */,
+                             absl::Time /* deadline */) override {
+    return FailUnimplemented(std::move(on_resolve));
+  }
+
+  bool CancelLookup(LookupTaskHandle handle) override {
+    return state_->Finish(handle);
+  }
+
+ private:
+  // Tracks outstanding lookups; shared with in-flight lookups so that the
+  // resolver may be destroyed before they complete.
+  class State {
+   public:
+    LookupTaskHandle Register() {
+      grpc_core::MutexLock lock(&mu_);
+      intptr_t id = next_id_++;
+      pending_.insert(id);
+      return {{id, reinterpret_cast<intptr_t>(this)}};
+    }
+    // Returns true exactly once per registered lookup: either for its
+    // completion or for its cancellation.
+    bool Finish(LookupTaskHandle handle) {
+      if (handle.key[1] != reinterpret_cast<intptr_t>(this)) return false;
+      grpc_core::MutexLock lock(&mu_);
+      return pending_.erase(handle.key[0]) > 0;
+    }
+
+   private:
+    grpc_core::Mutex mu_;
+    std::unordered_set<intptr_t> pending_ ABSL_GUARDED_BY(mu_);
+    intptr_t next_id_ ABSL_GUARDED_BY(mu_) = 1;
+  };
+
+  template <typename Callback>
+  LookupTaskHandle FailUnimplemented(Callback on_resolve) {
+    LookupTaskHandle handle = state_->Register();
+    std::shared_ptr<State> state = state_;
+    pool_->Add([state, handle, on_resolve]() {
+      if (state->Finish(handle)) {
+        on_resolve(absl::UnimplementedError(
+            "The POSIX EventEngine only resolves hostnames"));
+      }
+    });
+    return handle;
+  }
+
+  static absl::StatusOr<std::vector<EventEngine::ResolvedAddress>>
+  BlockingResolve(const std::string& name, const std::string& default_port) {
+    std::string host;
+    std::string port;
+    if (!grpc_core::SplitHostPort(name, &host, &port)) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Unparseable name: ", name));
+    }
+    if (host.empty()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("No host in name: ", name));
+    }
+    if (port.empty()) {
+      if (default_port.empty()) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("No port in name: ", name));
+      }
+      port = default_port;
+    }
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    struct addrinfo* result = nullptr;
+    int s = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+    if (s != 0) {
+      return absl::NotFoundError(
+          absl::StrCat("getaddrinfo(", name, "): ", gai_strerror(s)));
+    }
+    std::vector<EventEngine::ResolvedAddress> addresses;
+    for (struct addrinfo* resp = result; resp != nullptr;
+         resp = resp->ai_next) {
+      addresses.emplace_back(resp->ai_addr, resp->ai_addrlen);
+    }
+    freeaddrinfo(result);
+    return addresses;
+  }
+
+  ThreadPool* const pool_;
+  const std::shared_ptr<State> state_;
+};
+
+}  // namespace
+
+//
+// PosixEventEngine::AsyncConnect
+//
+
+// A pending nonblocking connect(). Exactly one of OnWritable (success or
+// failure), OnConnectTimeout and CancelConnect wins by removing the attempt
+// from pending_connects_; OnWritable always runs last and frees the object.
+class PosixEventEngine::AsyncConnect {
+ public:
+  AsyncConnect(PosixEventEngine* engine, intptr_t id, EventHandle* handle,
+               OnConnectCallback on_connect, MemoryAllocator allocator,
+               PosixEndpointOptions options)
+      : engine_(engine),
+        id_(id),
+        handle_(handle),
+        on_connect_(std::move(on_connect)),
+        allocator_(std::move(allocator)),
+        options_(options),
+        on_writable_(
+            [this](absl::Status status) { OnWritable(std::move(status)); }) {}
+
+  void Start() { handle_->NotifyOnWrite(&on_writable_); }
+
+ private:
+  friend class PosixEventEngine;
+
+  void OnWritable(absl::Status status) {
+    TaskHandle timer;
+    {
+      grpc_core::MutexLock lock(&engine_->connect_mu_);
+      if (engine_->pending_connects_.erase(id_) == 0) {
+        // Timed out or cancelled; whoever won has already dealt with
+        // on_connect_.
+        handle_->OrphanHandle();
+        delete this;
+        return;
+      }
+      timer = timer_;
+    }
+    engine_->timer_manager_.Cancel(timer);
+    if (status.ok()) {
+      int so_error = 0;
+      socklen_t len = sizeof(so_error);
+      if (getsockopt(handle_->fd(), SOL_SOCKET, SO_ERROR, &so_error, &len) !=
+          0) {
+        status = ErrnoToStatus("getsockopt", errno);
+      } else if (so_error != 0) {
+        status = ErrnoToStatus("connect", so_error);
+      }
+    }
+    absl::StatusOr<std::unique_ptr<Endpoint>> result;
+    if (status.ok()) {
+      result = absl::make_unique<PosixEndpoint>(
+          handle_, &engine_->pool_, std::move(allocator_), options_);
+    } else {
+      handle_->OrphanHandle();
+      result = std::move(status);
+    }
+    OnConnectCallback on_connect = std::move(on_connect_);
+    delete this;
+    on_connect(std::move(result));
+  }
+
+  PosixEventEngine* const engine_;
+  const intptr_t id_;
+  EventHandle* const handle_;
+  OnConnectCallback on_connect_;
+  MemoryAllocator allocator_;
+  const PosixEndpointOptions options_;
+  PosixEngineClosure on_writable_;
+  TaskHandle timer_ ABSL_GUARDED_BY(engine_->connect_mu_);
+};
+
+//
+// PosixEventEngine
+//
+
+PosixEventEngine::PosixEventEngine()
+    : poller_(&pool_), timer_manager_(&pool_) {}
+
+PosixEventEngine::~PosixEventEngine() {
+  timer_manager_.Shutdown();
+  poller_.Shutdown();
+  pool_.Quiesce();
+}
+
+absl::StatusOr<std::unique_ptr<EventEngine::Listener>>
+PosixEventEngine::CreateListener(
+    Listener::AcceptCallback on_accept,
+    std::function<void(absl::Status)> on_shutdown, const EndpointConfig& config,
+    std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory) {
+  return absl::make_unique<PosixListener>(
+      &pool_, &poller_, std::move(on_accept), std::move(on_shutdown), config,
+      std::move(memory_allocator_factory));
+}
+
+EventEngine::ConnectionHandle PosixEventEngine::Connect(
+    OnConnectCallback on_connect, const ResolvedAddress& addr,
+    const EndpointConfig& args, MemoryAllocator memory_allocator,
+    absl::Time deadline) {
+  auto fail = [this, &on_connect](absl::Status status) {
+    pool_.Add([on_connect, status]() { on_connect(status); });
+    return ConnectionHandle{{0, 0}};
+  };
+  auto fd = CreateSocket(addr);
+  if (!fd.ok()) return fail(fd.status());
+  int r;
+  do {
+    r = connect(*fd, addr.address(), addr.size());
+  } while (r < 0 && errno == EINTR);
+  // A connect() that completes immediately leaves the socket writable, so it
+  // goes through the same path as one that is still in progress.
+  if (r < 0 && errno != EINPROGRESS) {
+    absl::Status status = ErrnoToStatus("connect", errno);
+    close(*fd);
+    return fail(std::move(status));
+  }
+  AsyncConnect* ac;
+  ConnectionHandle handle;
+  {
+    grpc_core::MutexLock lock(&connect_mu_);
+    intptr_t id = next_connection_id_++;
+    ac = new AsyncConnect(this, id, poller_.CreateHandle(*fd),
+                          std::move(on_connect), std::move(memory_allocator),
+                          PosixEndpointOptions::FromConfig(args));
+    pending_connects_.emplace(id, ac);
+    ac->timer_ = timer_manager_.Schedule(
+        deadline, [this, id]() { OnConnectTimeout(id); });
+    handle = {{id, reinterpret_cast<intptr_t>(this)}};
+  }
+  ac->Start();
+  return handle;
+}
+
+void PosixEventEngine::OnConnectTimeout(intptr_t connection_id) {
+  OnConnectCallback on_connect;
+  {
+    grpc_core::MutexLock lock(&connect_mu_);
+    auto it = pending_connects_.find(connection_id);
+    if (it == pending_connects_.end()) return;
+    AsyncConnect* ac = it->second;
+    pending_connects_.erase(it);
+    on_connect = std::move(ac->on_connect_);
+    // Wakes OnWritable, which cleans up.
+    ac->handle_->ShutdownHandle(
+        absl::DeadlineExceededError("connect timed out"));
+  }
+  on_connect(absl::DeadlineExceededError("connect timed out"));
+}
+
+bool PosixEventEngine::CancelConnect(ConnectionHandle handle) {
+  if (handle.keys[1] != reinterpret_cast<intptr_t>(this)) return false;
+  TaskHandle timer;
+  {
+    grpc_core::MutexLock lock(&connect_mu_);
+    auto it = pending_connects_.find(handle.keys[0]);
+    if (it == pending_connects_.end()) return false;
+    AsyncConnect* ac = it->second;
+    pending_connects_.erase(it);
+    timer = ac->timer_;
+    // Wakes OnWritable, which cleans up without running on_connect.
+    ac->handle_->ShutdownHandle(absl::CancelledError("connect cancelled"));
+  }
+  timer_manager_.Cancel(timer);
+  return true;
+}
+
+bool PosixEventEngine::IsWorkerThread() { return pool_.IsThreadPoolThread(); }
+
+std::unique_ptr<EventEngine::DNSResolver> PosixEventEngine::GetDNSResolver() {
+  return absl::make_unique<PosixDNSResolver>(&pool_);
+}
+
+void PosixEventEngine::Run(Closure* closure) { pool_.Add(closure); }
+
+void PosixEventEngine::Run(std::function<void()> closure) {
+  pool_.Add(std::move(closure));
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAt(absl::Time when,
+                                                Closure* closure) {
+  return timer_manager_.Schedule(when, closure);
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAt(absl::Time when,
+                                                std::function<void()> closure) {
+  return timer_manager_.Schedule(when, std::move(closure));
+}
+
+bool PosixEventEngine::Cancel(TaskHandle handle) {
+  return timer_manager_.Cancel(handle);
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
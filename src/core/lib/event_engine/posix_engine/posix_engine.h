@@ -0,0 +1,88 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <memory>
+#include <unordered_map>
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+#include "src/core/lib/event_engine/posix_engine/timer_manager.h"
+#include "src/core/lib/gprpp/sync.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// A native EventEngine for Linux.
+//
+// Closures, timers and I/O completions all run on a work-stealing thread pool.
+// Socket readiness comes from a single edge-triggered epoll set with its own
+// thread, and timers from a dedicated timer thread; neither ever runs user
+// code. Nothing here depends on ExecCtx, combiners or the iomgr polling
+// engines.
+class PosixEventEngine final : public EventEngine {
+ public:
+  PosixEventEngine();
+  ~PosixEventEngine() override;
+
+  absl::StatusOr<std::unique_ptr<Listener>> CreateListener(
+      Listener::AcceptCallback on_accept,
+      std::function<void(absl::Status)> on_shutdown,
+      const EndpointConfig& config,
+      std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory)
+      override;
+  ConnectionHandle Connect(OnConnectCallback on_connect,
+                           const ResolvedAddress& addr,
+                           const EndpointConfig& args,
+                           MemoryAllocator memory_allocator,
+                           absl::Time deadline) override;
+  bool CancelConnect(ConnectionHandle handle) override;
+  bool IsWorkerThread() override;
+  std::unique_ptr<DNSResolver> GetDNSResolver() override;
+  void Run(Closure* closure) override;
+  void Run(std::function<void()> closure) override;
+  TaskHandle RunAt(absl::Time when, Closure* closure) override;
+  TaskHandle RunAt(absl::Time when, std::function<void()> closure) override;
+  bool Cancel(TaskHandle handle) override;
+
+ private:
+  class AsyncConnect;
+
+  void OnConnectTimeout(intptr_t connection_id);
+
+  // The poller and timer threads hand work to the pool, so they are stopped
+  // before it is quiesced.
+  posix_engine::ThreadPool pool_;
+  posix_engine::EpollPoller poller_;
+  posix_engine::TimerManager timer_manager_;
+
+  grpc_core::Mutex connect_mu_;
+  std::unordered_map<intptr_t, AsyncConnect*> pending_connects_
+      ABSL_GUARDED_BY(connect_mu_);
+  intptr_t next_connection_id_ ABSL_GUARDED_BY(connect_mu_) = 1;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
@@ -0,0 +1,188 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+
+#include <algorithm>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/tls.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EventEngine;
+
+namespace {
+
+// The pool (and worker index within it) that the current thread belongs to.
+GPR_THREAD_LOCAL(const ThreadPool*) g_current_pool = nullptr;
+GPR_THREAD_LOCAL(size_t) g_current_worker_index = 0;
+
+// Adapts a std::function to a self-deleting Closure.
+class FunctionClosure : public EventEngine::Closure {
+ public:
+  explicit FunctionClosure(std::function<void()> fn) : fn_(std::move(fn)) {}
+  void Run() override {
+    fn_();
+    delete this;
+  }
+
+ private:
+  std::function<void()> fn_;
+};
+
+}  // namespace
+
+class ThreadPool::Worker {
+ public:
+  Worker(ThreadPool* pool, size_t index) : pool_(pool), index_(index) {
+    thread_ = grpc_core::Thread("event_engine_worker", &Worker::ThreadBody,
+                                this);
+  }
+
+  void Start() { thread_.Start(); }
+  void Join() { thread_.Join(); }
+
+  // Push a closure onto the owner's end of the deque.
+  void Push(EventEngine::Closure* closure) {
+    grpc_core::MutexLock lock(&mu_);
+    queue_.push_back(closure);
+    pool_->pending_.fetch_add(1);
+  }
+
+  // Pop from the owner's end of the deque (most recently pushed first).
+  EventEngine::Closure* PopBack() {
+    grpc_core::MutexLock lock(&mu_);
+    if (queue_.empty()) return nullptr;
+    EventEngine::Closure* closure = queue_.back();
+    queue_.pop_back();
+    pool_->pending_.fetch_sub(1);
+    return closure;
+  }
+
+  // Pop from the thieves' end of the deque (oldest first).
+  EventEngine::Closure* PopFront() {
+    grpc_core::MutexLock lock(&mu_);
+    if (queue_.empty()) return nullptr;
+    EventEngine::Closure* closure = queue_.front();
+    queue_.pop_front();
+    pool_->pending_.fetch_sub(1);
+    return closure;
+  }
+
+ private:
+  static void ThreadBody(void* arg) { static_cast<Worker*>(arg)->Loop(); }
+
+  void Loop() {
+    g_current_pool = pool_;
+    g_current_worker_index = index_;
+    while (true) {
+      EventEngine::Closure* closure = PopBack();
+      if (closure == nullptr) closure = pool_->Steal(index_);
+      if (closure != nullptr) {
+        closure->Run();
+        continue;
+      }
+      grpc_core::MutexLock lock(&pool_->park_mu_);
+      // Advertise that we are about to park before re-checking for work, so
+      // that a concurrent Add() either sees us parked or we see its closure.
+      pool_->parked_.fetch_add(1);
+      if (pool_->pending_.load() == 0) {
+        if (pool_->shutdown_) {
+          pool_->parked_.fetch_sub(1);
+          break;
+        }
+        pool_->park_cv_.Wait(&pool_->park_mu_);
+      }
+      pool_->parked_.fetch_sub(1);
+    }
+    g_current_pool = nullptr;
+  }
+
+  ThreadPool* const pool_;
+  const size_t index_;
+  grpc_core::Mutex mu_;
+  std::deque<EventEngine::Closure*> queue_ ABSL_GUARDED_BY(mu_);
+  grpc_core::Thread thread_;
+};
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max(2u, gpr_cpu_num_cores());
+  }
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(new Worker(this, i));
+  }
+  for (auto& worker : workers_) worker->Start();
+}
+
+ThreadPool::~ThreadPool() { Quiesce(); }
+
+void ThreadPool::Quiesce() {
+  if (quiesced_) return;
+  quiesced_ = true;
+  // Joining from a worker would deadlock.
+  GPR_ASSERT(!IsThreadPoolThread());
+  {
+    grpc_core::MutexLock lock(&park_mu_);
+    shutdown_ = true;
+    park_cv_.SignalAll();
+  }
+  for (auto& worker : workers_) worker->Join();
+  GPR_ASSERT(pending_.load() == 0);
+}
+
+void ThreadPool::Add(EventEngine::Closure* closure) {
+  Push(closure);
+  WakeOne();
+}
+
+void ThreadPool::Add(std::function<void()> fn) {
+  Add(new FunctionClosure(std::move(fn)));
+}
+
+bool ThreadPool::IsThreadPoolThread() const { return g_current_pool == this; }
+
+void ThreadPool::Push(EventEngine::Closure* closure) {
+  if (IsThreadPoolThread()) {
+    workers_[g_current_worker_index]->Push(closure);
+    return;
+  }
+  workers_[next_worker_.fetch_add(1, std::memory_order_relaxed) %
+           workers_.size()]
+      ->Push(closure);
+}
+
+EventEngine::Closure* ThreadPool::Steal(size_t thief) {
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    EventEngine::Closure* closure =
+        workers_[(thief + i) % workers_.size()]->PopFront();
+    if (closure != nullptr) return closure;
+  }
+  return nullptr;
+}
+
+void ThreadPool::WakeOne() {
+  if (parked_.load() == 0) return;
+  grpc_core::MutexLock lock(&park_mu_);
+  park_cv_.Signal();
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
@@ -0,0 +1,91 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_THREAD_POOL_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_THREAD_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// A fixed-size work-stealing thread pool.
+//
+// Every worker owns a deque of closures. Closures added from a worker thread
+// are pushed onto that worker's own deque and popped LIFO for cache locality;
+// closures added from any other thread are spread round-robin across the
+// workers. A worker that runs out of local work steals FIFO from its peers
+// before parking. Closures never run inline from Add().
+//
+// Quiesce() (or destruction) runs every closure that is still queued,
+// including ones queued by closures that run during shutdown, then joins the
+// workers.
+class ThreadPool {
+ public:
+  // \a num_threads == 0 picks one worker per core (with a minimum of two).
+  explicit ThreadPool(size_t num_threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Schedule \a closure to run on some worker. The pool does not take
+  // ownership of the closure.
+  void Add(experimental::EventEngine::Closure* closure);
+  // Schedule \a fn to run on some worker.
+  void Add(std::function<void()> fn);
+
+  // Drain all queued work and join the workers. No closures may be added from
+  // outside the pool afterwards. Idempotent.
+  void Quiesce();
+
+  // True if the calling thread is one of this pool's workers.
+  bool IsThreadPoolThread() const;
+
+  size_t num_threads() const { return workers_.size(); }
+
+ private:
+  class Worker;
+
+  void Push(experimental::EventEngine::Closure* closure);
+  experimental::EventEngine::Closure* Steal(size_t thief);
+  void WakeOne();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Round-robin cursor for closures submitted from outside the pool.
+  std::atomic<size_t> next_worker_{0};
+  // Number of closures sitting in some worker deque.
+  std::atomic<size_t> pending_{0};
+  // Number of workers blocked (or about to block) on park_cv_.
+  std::atomic<size_t> parked_{0};
+  grpc_core::Mutex park_mu_;
+  grpc_core::CondVar park_cv_;
+  bool shutdown_ ABSL_GUARDED_BY(park_mu_) = false;
+  bool quiesced_ = false;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_THREAD_POOL_H
@@ -0,0 +1,113 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer_manager.h"
+
+#include <vector>
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EventEngine;
+
+TimerManager::TimerManager(ThreadPool* pool) : pool_(pool) {
+  thread_ = grpc_core::Thread("event_engine_timer", &TimerManager::ThreadBody,
+                              this);
+  thread_.Start();
+}
+
+TimerManager::~TimerManager() { Shutdown(); }
+
+void TimerManager::Shutdown() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    if (shutdown_) return;
+    shutdown_ = true;
+    timers_by_id_.clear();
+    timers_.clear();
+    cv_.Signal();
+  }
+  thread_.Join();
+}
+
+EventEngine::TaskHandle TimerManager::Schedule(absl::Time when,
+                                               EventEngine::Closure* closure) {
+  grpc_core::MutexLock lock(&mu_);
+  return Add(when, Timer{0, closure, nullptr});
+}
+
+EventEngine::TaskHandle TimerManager::Schedule(absl::Time when,
+                                               std::function<void()> fn) {
+  grpc_core::MutexLock lock(&mu_);
+  return Add(when, Timer{0, nullptr, std::move(fn)});
+}
+
+EventEngine::TaskHandle TimerManager::Add(absl::Time when, Timer timer) {
+  timer.id = next_id_++;
+  EventEngine::TaskHandle handle{{timer.id, reinterpret_cast<intptr_t>(this)}};
+  if (shutdown_) return handle;
+  // Only wake the timer thread if the new timer is now the earliest.
+  bool is_earliest = timers_.empty() || when < timers_.begin()->first;
+  auto it = timers_.emplace(when, std::move(timer));
+  timers_by_id_.emplace(handle.keys[0], it);
+  if (is_earliest) cv_.Signal();
+  return handle;
+}
+
+bool TimerManager::Cancel(EventEngine::TaskHandle handle) {
+  if (handle.keys[1] != reinterpret_cast<intptr_t>(this)) return false;
+  grpc_core::MutexLock lock(&mu_);
+  auto it = timers_by_id_.find(handle.keys[0]);
+  if (it == timers_by_id_.end()) return false;
+  timers_.erase(it->second);
+  timers_by_id_.erase(it);
+  return true;
+}
+
+void TimerManager::Loop() {
+  std::vector<Timer> expired;
+  grpc_core::MutexLock lock(&mu_);
+  while (!shutdown_) {
+    if (timers_.empty()) {
+      cv_.Wait(&mu_);
+      continue;
+    }
+    absl::Time now = absl::Now();
+    auto it = timers_.begin();
+    if (it->first > now) {
+      cv_.WaitWithDeadline(&mu_, it->first);
+      continue;
+    }
+    for (; it != timers_.end() && it->first <= now;
+         it = timers_.erase(it)) {
+      timers_by_id_.erase(it->second.id);
+      expired.push_back(std::move(it->second));
+    }
+    // Dispatch in deadline order; workers may still reorder execution.
+    mu_.Unlock();
+    for (Timer& timer : expired) {
+      if (timer.closure != nullptr) {
+        pool_->Add(timer.closure);
+      } else {
+        pool_->Add(std::move(timer.fn));
+      }
+    }
+    expired.clear();
+    mu_.Lock();
+  }
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
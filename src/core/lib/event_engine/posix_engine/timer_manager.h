@@ -0,0 +1,91 @@
+// Copyright 2021 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_MANAGER_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_MANAGER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// Runs closures at (or shortly after) a point in time.
+//
+// A single timer thread sleeps until the earliest deadline and then hands
+// every expired closure to the thread pool; closures never run on the timer
+// thread itself.
+class TimerManager {
+ public:
+  explicit TimerManager(ThreadPool* pool);
+  ~TimerManager();
+
+  TimerManager(const TimerManager&) = delete;
+  TimerManager& operator=(const TimerManager&) = delete;
+
+  // Schedule \a closure (not owned) or \a fn to be handed to the thread pool
+  // at \a when.
+  experimental::EventEngine::TaskHandle Schedule(
+      absl::Time when, experimental::EventEngine::Closure* closure);
+  experimental::EventEngine::TaskHandle Schedule(absl::Time when,
+                                                 std::function<void()> fn);
+
+  // Returns true if the timer was still pending, in which case it will never
+  // run and any std::function it held has been destroyed.
+  bool Cancel(experimental::EventEngine::TaskHandle handle);
+
+  // Stops the timer thread. Pending timers are dropped without running, and
+  // timers scheduled afterwards are dropped immediately.
+  void Shutdown();
+
+ private:
+  struct Timer {
+    intptr_t id;
+    experimental::EventEngine::Closure* closure;
+    std::function<void()> fn;
+  };
+  using TimerMap = std::multimap<absl::Time, Timer>;
+
+  static void ThreadBody(void* arg) {
+    static_cast<TimerManager*>(arg)->Loop();
+  }
+  void Loop();
+  experimental::EventEngine::TaskHandle Add(absl::Time when, Timer timer)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  ThreadPool* const pool_;
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  TimerMap timers_ ABSL_GUARDED_BY(mu_);
+  std::unordered_map<intptr_t, TimerMap::iterator> timers_by_id_
+      ABSL_GUARDED_BY(mu_);
+  intptr_t next_id_ ABSL_GUARDED_BY(mu_) = 1;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_core::Thread thread_;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_MANAGER_H
@@ -22,10 +22,12 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <new>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
@@ -52,6 +54,7 @@ void* ArenaStorage(size_t initial_size) {
 namespace grpc_core {
 
 Arena::~Arena() {
+  DestroyManagedNewObjects();
   Zone* z = last_zone_;
   while (z) {
     Zone* prev_z = z->prev;
@@ -101,4 +104,179 @@ void* Arena::AllocZone(size_t size) {
   return reinterpret_cast<char*>(z) + zone_base_size;
 }
 
+void Arena::ManagedNewObject::Link(std::atomic<ManagedNewObject*>* head) {
+  next_ = head->load(std::memory_order_relaxed);
+  while (!head->compare_exchange_weak(next_, this, std::memory_order_acq_rel,
+                                      std::memory_order_relaxed)) {
+  }
+}
+
+void Arena::DestroyManagedNewObjects() {
+  ManagedNewObject* p = managed_new_head_.exchange(nullptr,
+                                                   std::memory_order_acquire);
+  // Objects may create further managed objects while being destroyed, so
+  // keep draining until the list stays empty.
+  while (p != nullptr) {
+    while (p != nullptr) {
+      ManagedNewObject* next = p->next_;
+      p->~ManagedNewObject();
+      p = next;
+    }
+    p = managed_new_head_.exchange(nullptr, std::memory_order_acquire);
+  }
+}
+
+//
+// ArenaPool
+//
+
+constexpr size_t ArenaPool::kMinPooledSize;
+constexpr size_t ArenaPool::kMaxPooledSize;
+constexpr size_t ArenaPool::kNumClasses;
+constexpr size_t ArenaPool::kMaxPooledBytes;
+constexpr size_t ArenaPool::kMaxShards;
+
+ArenaPool::ArenaPool()
+    : num_shards_(std::min(
+          kMaxShards, static_cast<size_t>(std::max(1u, gpr_cpu_num_cores())))),
+      shards_(new Shard[num_shards_]) {
+  static_assert(kMinPooledSize << (kNumClasses - 1) == kMaxPooledSize,
+                "size classes must cover kMinPooledSize..kMaxPooledSize");
+}
+
+ArenaPool::~ArenaPool() {
+  Trim();
+  delete[] shards_;
+}
+
+int ArenaPool::SizeClass(size_t initial_size) {
+  if (initial_size < kMinPooledSize || initial_size > kMaxPooledSize) {
+    return -1;
+  }
+  int cls = 0;
+  while ((kMinPooledSize << (cls + 1)) <= initial_size) ++cls;
+  return cls;
+}
+
+ArenaPool::Shard* ArenaPool::CurrentShard() {
+  return &shards_[gpr_cpu_current_cpu() % num_shards_];
+}
+
+ArenaPool::FreeArena* ArenaPool::PopFit(Shard* shard, int cls,
+                                        size_t initial_size) {
+  if (cls >= static_cast<int>(kNumClasses)) return nullptr;
+  FreeArena* free_arena = shard->free_arenas[cls];
+  // Only look at the head of the list: reusing an arena must stay O(1), and
+  // taking one much larger than asked for would inflate the call's memory.
+  if (free_arena == nullptr || free_arena->capacity < initial_size ||
+      free_arena->capacity - initial_size > initial_size / 4) {
+    return nullptr;
+  }
+  shard->free_arenas[cls] = free_arena->next;
+  return free_arena;
+}
+
+std::pair<Arena*, void*> ArenaPool::CreateWithAlloc(size_t initial_size,
+                                                    size_t alloc_size,
+                                                    bool* reused) {
+  FreeArena* free_arena = nullptr;
+  const int cls = SizeClass(initial_size);
+  if (cls >= 0) {
+    Shard* shard = CurrentShard();
+    gpr_spinlock_lock(&shard->lock);
+    // Arenas of the same class may be smaller than initial_size; those of the
+    // next class are larger.
+    free_arena = PopFit(shard, cls, initial_size);
+    if (free_arena == nullptr) free_arena = PopFit(shard, cls + 1, initial_size);
+    if (free_arena != nullptr) {
+      ++shard->hits;
+    } else {
+      ++shard->misses;
+    }
+    gpr_spinlock_unlock(&shard->lock);
+  }
+  if (reused != nullptr) *reused = free_arena != nullptr;
+  if (free_arena == nullptr) {
+    return Arena::CreateWithAlloc(initial_size, alloc_size);
+  }
+  const size_t capacity = free_arena->capacity;
+  pooled_bytes_.fetch_sub(capacity, std::memory_order_relaxed);
+  static constexpr size_t base_size =
+      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
+  // Hand out the whole zone, so that the arena is filed under the same class
+  // when it comes back.
+  auto* arena = new (free_arena) Arena(capacity, alloc_size);
+  void* first_alloc = reinterpret_cast<char*>(arena) + base_size;
+  return std::make_pair(arena, first_alloc);
+}
+
+size_t ArenaPool::Destroy(Arena* arena, bool trim) {
+  const int cls = SizeClass(arena->initial_zone_size_);
+  if (cls < 0) return arena->Destroy();
+  if (trim) {
+    if (pooled_bytes_.load(std::memory_order_relaxed) != 0) Trim();
+    return arena->Destroy();
+  }
+  size_t size = arena->total_used_.load(std::memory_order_relaxed);
+  const size_t capacity = arena->initial_zone_size_;
+  arena->~Arena();
+  if (pooled_bytes_.fetch_add(capacity, std::memory_order_relaxed) +
+          capacity >
+      kMaxPooledBytes) {
+    pooled_bytes_.fetch_sub(capacity, std::memory_order_relaxed);
+    gpr_free_aligned(arena);
+    return size;
+  }
+  FreeArena* free_arena = new (arena) FreeArena();
+  free_arena->capacity = capacity;
+  Shard* shard = CurrentShard();
+  gpr_spinlock_lock(&shard->lock);
+  free_arena->next = shard->free_arenas[cls];
+  shard->free_arenas[cls] = free_arena;
+  gpr_spinlock_unlock(&shard->lock);
+  return size;
+}
+
+void ArenaPool::TrimShard(Shard* shard) {
+  FreeArena* to_free[kNumClasses];
+  gpr_spinlock_lock(&shard->lock);
+  for (size_t i = 0; i < kNumClasses; ++i) {
+    to_free[i] = shard->free_arenas[i];
+    shard->free_arenas[i] = nullptr;
+  }
+  gpr_spinlock_unlock(&shard->lock);
+  for (size_t i = 0; i < kNumClasses; ++i) {
+    while (to_free[i] != nullptr) {
+      FreeArena* next = to_free[i]->next;
+      pooled_bytes_.fetch_sub(to_free[i]->capacity, std::memory_order_relaxed);
+      gpr_free_aligned(to_free[i]);
+      to_free[i] = next;
+    }
+  }
+}
+
+void ArenaPool::Trim() {
+  for (size_t i = 0; i < num_shards_; ++i) TrimShard(&shards_[i]);
+}
+
+uint64_t ArenaPool::hits() const {
+  uint64_t hits = 0;
+  for (size_t i = 0; i < num_shards_; ++i) {
+    gpr_spinlock_lock(&shards_[i].lock);
+    hits += shards_[i].hits;
+    gpr_spinlock_unlock(&shards_[i].lock);
+  }
+  return hits;
+}
+
+uint64_t ArenaPool::misses() const {
+  uint64_t misses = 0;
+  for (size_t i = 0; i < num_shards_; ++i) {
+    gpr_spinlock_lock(&shards_[i].lock);
+    misses += shards_[i].misses;
+    gpr_spinlock_unlock(&shards_[i].lock);
+  }
+  return misses;
+}
+
 }  // namespace grpc_core
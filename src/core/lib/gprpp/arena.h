@@ -32,9 +32,11 @@
 #include <atomic>
 #include <memory>
 #include <new>
+#include <type_traits>
 #include <utility>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/gpr/alloc.h"
@@ -54,32 +56,91 @@ class Arena {
                                                   size_t alloc_size);
 
   // Destroy an arena, returning the total number of bytes allocated.
+  // Objects created with ManagedNew() are destroyed first, in reverse order
+  // of creation.
   size_t Destroy();
-  // Allocate \a size bytes from the arena.
-  void* Alloc(size_t size) {
+  // Allocate \a size bytes from the arena, aligned to \a alignment, which
+  // must be a power of two no larger than GPR_MAX_ALIGNMENT.
+  void* Alloc(size_t size, size_t alignment = GPR_MAX_ALIGNMENT) {
     static constexpr size_t base_size =
         GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
-    size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(size);
-    size_t begin = total_used_.fetch_add(size, std::memory_order_relaxed);
-    if (begin + size <= initial_zone_size_) {
-      return reinterpret_cast<char*>(this) + base_size + begin;
+    GPR_DEBUG_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0 &&
+                     alignment <= GPR_MAX_ALIGNMENT);
+    // The initial zone starts at a GPR_MAX_ALIGNMENT boundary, so aligning
+    // the offset aligns the address.
+    size_t begin = total_used_.load(std::memory_order_relaxed);
+    size_t aligned_begin;
+    do {
+      aligned_begin = (begin + alignment - 1) & ~(alignment - 1);
+    } while (!total_used_.compare_exchange_weak(begin, aligned_begin + size,
+                                                std::memory_order_relaxed,
+                                                std::memory_order_relaxed));
+    if (aligned_begin + size <= initial_zone_size_) {
+      return reinterpret_cast<char*>(this) + base_size + aligned_begin;
     } else {
       return AllocZone(size);
     }
   }
 
-  // TODO(roth): We currently assume that all callers need alignment of 16
-  // bytes, which may be wrong in some cases. When we have time, we should
-  // change this to instead use the alignment of the type being allocated by
-  // this method.
+  // Allocate and construct a T.  The object is aligned to alignof(T), so
+  // small objects pack tightly.  Its destructor is never run by the arena.
   template <typename T, typename... Args>
   T* New(Args&&... args) {
-    T* t = static_cast<T*>(Alloc(sizeof(T)));
+    static_assert(alignof(T) <= GPR_MAX_ALIGNMENT,
+                  "arena cannot satisfy the alignment of T");
+    T* t = static_cast<T*>(Alloc(sizeof(T), alignof(T)));
     new (t) T(std::forward<Args>(args)...);
     return t;
   }
 
+  // Like New(), but the object is destroyed when the arena is.  Trivially
+  // destructible types cost nothing extra; others carry a list link.
+  template <typename T, typename... Args>
+  T* ManagedNew(Args&&... args) {
+    return ManagedNewHelper<T, std::is_trivially_destructible<T>::value>::New(
+        this, std::forward<Args>(args)...);
+  }
+
  private:
+  friend class ArenaPool;
+
+  // Header for objects whose destructors run at arena destruction.
+  class ManagedNewObject {
+   public:
+    virtual ~ManagedNewObject() = default;
+    void Link(std::atomic<ManagedNewObject*>* head);
+
+   private:
+    friend class Arena;
+    ManagedNewObject* next_ = nullptr;
+  };
+
+  template <typename T>
+  class ManagedNewImpl final : public ManagedNewObject {
+   public:
+    template <typename... Args>
+    explicit ManagedNewImpl(Args&&... args) : t(std::forward<Args>(args)...) {}
+    T t;
+  };
+
+  template <typename T, bool kTrivial>
+  struct ManagedNewHelper {
+    template <typename... Args>
+    static T* New(Arena* arena, Args&&... args) {
+      return arena->New<T>(std::forward<Args>(args)...);
+    }
+  };
+
+  template <typename T>
+  struct ManagedNewHelper<T, false> {
+    template <typename... Args>
+    static T* New(Arena* arena, Args&&... args) {
+      auto* p = arena->New<ManagedNewImpl<T>>(std::forward<Args>(args)...);
+      p->Link(&arena->managed_new_head_);
+      return &p->t;
+    }
+  };
+
   struct Zone {
     Zone* prev;
   };
@@ -103,6 +164,7 @@ class Arena {
   ~Arena();
 
   void* AllocZone(size_t size);
+  void DestroyManagedNewObjects();
 
   // Keep track of the total used size. We use this in our call sizing
   // hysteresis.
@@ -115,6 +177,124 @@ class Arena {
   // and (2) the allocated memory. The arena itself maintains a pointer to the
   // last zone; the zone list is reverse-walked during arena destruction only.
   Zone* last_zone_ = nullptr;
+  // Most recently created ManagedNew() object; each links to the one before.
+  std::atomic<ManagedNewObject*> managed_new_head_{nullptr};
+};
+
+// Recycles the memory of arenas whose initial zone size is between
+// kMinPooledSize and kMaxPooledSize.  Destroyed arenas are kept in per-CPU
+// free lists, and later arenas created on that CPU reuse one whose zone is at
+// least as large as, and not much larger than, the requested size instead of
+// going back to malloc.  The bytes kept across all CPUs are bounded by
+// kMaxPooledBytes.
+class ArenaPool {
+ public:
+  static constexpr size_t kMinPooledSize = 1024;
+  static constexpr size_t kMaxPooledSize = 64 * 1024;
+  // Upper bound on the bytes of free arenas a pool keeps, over all CPUs.
+  static constexpr size_t kMaxPooledBytes = 256 * 1024;
+
+  ArenaPool();
+  ~ArenaPool();
+
+  ArenaPool(const ArenaPool&) = delete;
+  ArenaPool& operator=(const ArenaPool&) = delete;
+
+  // Like Arena::CreateWithAlloc().  A pooled arena is only reused if its
+  // initial zone is at most a quarter larger than \a initial_size.  If
+  // \a reused is non-null, it is set to whether the arena's memory came from
+  // the pool.
+  std::pair<Arena*, void*> CreateWithAlloc(size_t initial_size,
+                                           size_t alloc_size,
+                                           bool* reused = nullptr);
+
+  // Like Arena::Destroy(), but keeps the arena's memory for reuse if the pool
+  // has room for it.  If \a trim is true, the arena and every pooled arena
+  // are freed instead.
+  size_t Destroy(Arena* arena, bool trim);
+
+  // Frees all pooled arenas.
+  void Trim();
+
+  // Number of arenas created from pooled memory and from malloc.
+  uint64_t hits() const;
+  uint64_t misses() const;
+  // Bytes of free arenas currently kept.
+  size_t pooled_bytes() const {
+    return pooled_bytes_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Class i holds arenas of kMinPooledSize << i bytes or more, up to the
+  // next class.
+  static constexpr size_t kNumClasses = 7;
+  // Upper bound on the CPUs tracked separately, to bound the size of pools
+  // of channels that only ever see a handful of calls.
+  static constexpr size_t kMaxShards = 16;
+
+  struct FreeArena {
+    FreeArena* next;
+    // Initial zone size of the arena this memory came from.
+    size_t capacity;
+  };
+
+  // All fields are guarded by lock.
+  struct Shard {
+    gpr_spinlock lock = GPR_SPINLOCK_STATIC_INITIALIZER;
+    FreeArena* free_arenas[kNumClasses] = {};
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    // Keep shards of neighbouring CPUs off each other's cache lines.
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  // Returns the size class of arenas of \a initial_size bytes, or -1 if
+  // they are not pooled.
+  static int SizeClass(size_t initial_size);
+
+  Shard* CurrentShard();
+  // Pops the first arena of class \a cls if it can serve \a initial_size.
+  static FreeArena* PopFit(Shard* shard, int cls, size_t initial_size);
+  void TrimShard(Shard* shard);
+
+  const size_t num_shards_;
+  Shard* const shards_;
+  std::atomic<size_t> pooled_bytes_{0};
+};
+
+// Standard allocator over an arena, for containers that live no longer than
+// the arena.  Deallocation is a no-op, so containers that grow repeatedly
+// leave their old buffers behind; reserve() up front where possible.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= GPR_MAX_ALIGNMENT,
+                  "arena cannot satisfy the alignment of T");
+    return static_cast<T*>(arena_->Alloc(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T*, size_t) {}
+
+  Arena* arena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+ private:
+  Arena* arena_;
 };
 
 // Smart pointer for arenas when the final size is not required.
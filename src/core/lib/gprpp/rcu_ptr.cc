@@ -0,0 +1,100 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/rcu_ptr.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+namespace {
+
+// Beyond this many shards, readers on different CPUs share counters. That
+// costs some cache line traffic, but keeps the memory of each RcuReaders (and
+// the time Synchronize() spends scanning it) bounded on very large machines.
+constexpr size_t kMaxShards = 64;
+
+size_t NumShards() {
+  return std::min(kMaxShards,
+                  static_cast<size_t>(std::max(1u, gpr_cpu_num_cores())));
+}
+
+}  // namespace
+
+//
+// RcuReaders
+//
+
+RcuReaders::RcuReaders()
+    : num_shards_(NumShards()), shards_(new Shard[num_shards_]) {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    shards_[i].readers[0].store(0, std::memory_order_relaxed);
+    shards_[i].readers[1].store(0, std::memory_order_relaxed);
+  }
+}
+
+RcuReaders::~RcuReaders() {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    GPR_DEBUG_ASSERT(shards_[i].readers[0].load(std::memory_order_relaxed) ==
+                     0);
+    GPR_DEBUG_ASSERT(shards_[i].readers[1].load(std::memory_order_relaxed) ==
+                     0);
+  }
+  delete[] shards_;
+}
+
+RcuReaders::Token RcuReaders::Enter() {
+  // The epoch load, this increment and the reader's subsequent load of the
+  // protected pointer are all sequentially consistent with the writer's
+  // exchange of the pointer, its epoch flips and its counter loads. So either
+  // Synchronize() sees this reader, or the reader sees the new pointer.
+  const size_t parity = epoch_.load(std::memory_order_seq_cst) & 1;
+  Token token =
+      &shards_[gpr_cpu_current_cpu() % num_shards_].readers[parity];
+  token->fetch_add(1, std::memory_order_seq_cst);
+  return token;
+}
+
+void RcuReaders::Synchronize() {
+  MutexLock lock(&synchronize_mu_);
+  // A reader may load the epoch, stall, and only count itself after the
+  // epoch has been flipped, i.e. under the parity a writer is no longer
+  // waiting for. Flipping twice and draining both parities covers such
+  // readers too.
+  for (int i = 0; i < 2; ++i) {
+    const size_t old_epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    WaitForReaders(old_epoch & 1);
+  }
+}
+
+void RcuReaders::WaitForReaders(size_t parity) {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    // Read sections are short, and never block on the writer, so spin.
+    while (shards_[i].readers[parity].load(std::memory_order_acquire) != 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+}  // namespace grpc_core
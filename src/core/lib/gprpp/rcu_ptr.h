@@ -0,0 +1,157 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPRPP_RCU_PTR_H
+#define GRPC_CORE_LIB_GPRPP_RCU_PTR_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Tracks the read sections of RCU (read-copy-update) protected data, such as
+// an RcuPtr<> below.
+//
+// Readers count themselves in per-CPU counters, so read sections running on
+// different CPUs never write to the same cache line and never block. A writer
+// that has unpublished a value calls Synchronize() to wait until no read
+// section can still be using it.
+class RcuReaders {
+ public:
+  // Identifies the counter a read section was counted in.
+  typedef std::atomic<intptr_t>* Token;
+
+  RcuReaders();
+  ~RcuReaders();
+
+  RcuReaders(const RcuReaders&) = delete;
+  RcuReaders& operator=(const RcuReaders&) = delete;
+
+  // Starts a read section. Must be paired with Leave(), possibly on another
+  // thread or CPU.
+  Token Enter();
+  // Ends the read section that returned token.
+  void Leave(Token token) { token->fetch_sub(1, std::memory_order_release); }
+
+  // Waits until every read section that started before the call has ended.
+  // Must not be called from inside a read section. Concurrent calls are
+  // serialized.
+  void Synchronize();
+
+  // A read section that lasts as long as the object, for data that is not
+  // behind a single RcuPtr<>.
+  class ReadSection {
+   public:
+    explicit ReadSection(RcuReaders* readers)
+        : readers_(readers), token_(readers->Enter()) {}
+    ~ReadSection() { readers_->Leave(token_); }
+
+    ReadSection(const ReadSection&) = delete;
+    ReadSection& operator=(const ReadSection&) = delete;
+
+   private:
+    RcuReaders* readers_;
+    Token token_;
+  };
+
+ private:
+  struct Shard {
+    // Read sections counted by epoch parity.
+    std::atomic<intptr_t> readers[2];
+    // Keep shards of neighbouring CPUs off each other's cache lines.
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  // Waits for the read sections counted with the given epoch parity.
+  void WaitForReaders(size_t parity);
+
+  const size_t num_shards_;
+  Shard* const shards_;
+  std::atomic<size_t> epoch_{0};
+  Mutex synchronize_mu_;
+};
+
+// A pointer to an object owned by the RcuPtr, which readers may use without
+// taking a lock while writers replace it.
+//
+// Readers access the object through a ReadLock, and the object they see stays
+// alive until the ReadLock is destroyed. Writers publish a new object with
+// Exchange(), which returns the old one; once Synchronize() returns, readers
+// are done with it and it may be destroyed. Writers must be serialized by the
+// caller.
+template <typename T>
+class RcuPtr {
+ public:
+  RcuPtr() = default;
+  explicit RcuPtr(std::unique_ptr<T> value) : value_(value.release()) {}
+  ~RcuPtr() { delete value_.load(std::memory_order_relaxed); }
+
+  RcuPtr(const RcuPtr&) = delete;
+  RcuPtr& operator=(const RcuPtr&) = delete;
+
+  class ReadLock {
+   public:
+    explicit ReadLock(const RcuPtr* ptr)
+        : readers_(&ptr->readers_),
+          token_(readers_->Enter()),
+          value_(ptr->value_.load(std::memory_order_seq_cst)) {}
+    ~ReadLock() { readers_->Leave(token_); }
+
+    ReadLock(const ReadLock&) = delete;
+    ReadLock& operator=(const ReadLock&) = delete;
+
+    T* get() const { return value_; }
+    T* operator->() const { return value_; }
+
+   private:
+    RcuReaders* readers_;
+    RcuReaders::Token token_;
+    T* value_;
+  };
+
+  // Publishes value and returns the previously published object, which
+  // readers may keep using until Synchronize() returns.
+  std::unique_ptr<T> Exchange(std::unique_ptr<T> value) {
+    return std::unique_ptr<T>(
+        value_.exchange(value.release(), std::memory_order_seq_cst));
+  }
+
+  // Waits until no reader can still be using an object replaced by an earlier
+  // Exchange().
+  void Synchronize() { readers_.Synchronize(); }
+
+  // Returns the published object without starting a read section. Only for
+  // writers, and for code holding the lock under which writers publish and
+  // that is done with the object before releasing it.
+  T* get() const { return value_.load(std::memory_order_acquire); }
+
+ private:
+  mutable RcuReaders readers_;
+  std::atomic<T*> value_{nullptr};
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_GPRPP_RCU_PTR_H */
@@ -152,6 +152,9 @@ struct grpc_fd {
 
   struct grpc_fd* freelist_next;
 
+  /* Set once the fd's endpoint batches its writes */
+  gpr_atm write_batching;
+
   grpc_iomgr_object iomgr_object;
 
   /* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
@@ -350,6 +353,7 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
   new_fd->error_closure->InitEvent();
 
   new_fd->freelist_next = nullptr;
+  gpr_atm_no_barrier_store(&new_fd->write_batching, 0);
 
   std::string fd_name = absl::StrCat(name, " fd=", fd);
   grpc_iomgr_register_object(&new_fd->iomgr_object, fd_name.c_str());
@@ -441,6 +445,10 @@ static bool fd_is_shutdown(grpc_fd* fd) {
   return fd->read_closure->IsShutdown();
 }
 
+static void fd_set_write_batching(grpc_fd* fd) {
+  gpr_atm_no_barrier_store(&fd->write_batching, 1);
+}
+
 static void fd_notify_on_read(grpc_fd* fd, grpc_closure* closure) {
   fd->read_closure->NotifyOn(closure);
 }
@@ -651,10 +659,24 @@ static int poll_deadline_to_millis_timeout(grpc_millis millis) {
   }
 }
 
+/* Whether an event with the given data pointer is for an fd whose endpoint
+   batches its writes. The fd may have been orphaned since the event was
+   reported, but it stays allocated on the free list, so a stale flag only
+   makes a round end a little early or late. */
+static bool event_batches_writes(void* data_ptr) {
+  if (data_ptr == &global_wakeup_fd) return false;
+  grpc_fd* fd = reinterpret_cast<grpc_fd*>(
+      reinterpret_cast<intptr_t>(data_ptr) & ~static_cast<intptr_t>(1));
+  return gpr_atm_no_barrier_load(&fd->write_batching) != 0;
+}
+
 /* Process the epoll events found by do_epoll_wait() function.
    - g_epoll_set.cursor points to the index of the first event to be processed
    - This function then processes up-to MAX_EPOLL_EVENTS_PER_ITERATION and
      updates the g_epoll_set.cursor
+   - It then carries on through the events of fds whose endpoints batch their
+     writes, so that the writes they trigger are sent together when
+     end_worker() flushes them
 
    NOTE ON SYNCRHONIZATION: Similar to do_epoll_wait(), this function is only
    called by g_active_poller thread. So there is no need for synchronization
@@ -666,12 +688,14 @@ static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
   grpc_error_handle error = GRPC_ERROR_NONE;
   long num_events = gpr_atm_acq_load(&g_epoll_set.num_events);
   long cursor = gpr_atm_acq_load(&g_epoll_set.cursor);
-  for (int idx = 0;
-       (idx < MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION) && cursor != num_events;
-       idx++) {
-    long c = cursor++;
-    struct epoll_event* ev = &g_epoll_set.events[c];
+  for (int idx = 0; cursor != num_events; idx++) {
+    struct epoll_event* ev = &g_epoll_set.events[cursor];
     void* data_ptr = ev->data.ptr;
+    if (idx >= MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION &&
+        !event_batches_writes(data_ptr)) {
+      break;
+    }
+    cursor++;
 
     if (data_ptr == &global_wakeup_fd) {
       append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
@@ -955,7 +979,7 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
       gpr_cv_signal(&worker->next->cv);
       if (grpc_core::ExecCtx::Get()->HasWork()) {
         gpr_mu_unlock(&pollset->mu);
-        grpc_core::ExecCtx::Get()->Flush();
+        grpc_fd_flush_exec_ctx_batching_writes();
         gpr_mu_lock(&pollset->mu);
       }
     } else {
@@ -986,12 +1010,12 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
         found_worker = check_neighborhood_for_available_poller(neighborhood);
         gpr_mu_unlock(&neighborhood->mu);
       }
-      grpc_core::ExecCtx::Get()->Flush();
+      grpc_fd_flush_exec_ctx_batching_writes();
       gpr_mu_lock(&pollset->mu);
     }
   } else if (grpc_core::ExecCtx::Get()->HasWork()) {
     gpr_mu_unlock(&pollset->mu);
-    grpc_core::ExecCtx::Get()->Flush();
+    grpc_fd_flush_exec_ctx_batching_writes();
     gpr_mu_lock(&pollset->mu);
   }
   if (worker->initialized_cv) {
@@ -1283,6 +1307,7 @@ static const grpc_event_engine_vtable vtable = {
     fd_become_writable,
     fd_has_errors,
     fd_is_shutdown,
+    fd_set_write_batching,
 
     pollset_init,
     pollset_shutdown,
@@ -1594,6 +1594,7 @@ static const grpc_event_engine_vtable vtable = {
     fd_become_writable,
     fd_has_errors,
     fd_is_shutdown,
+    nullptr, /* fd_set_write_batching */
 
     pollset_init,
     pollset_shutdown,
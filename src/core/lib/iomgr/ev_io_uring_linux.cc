@@ -0,0 +1,1750 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_IO_URING
+#include <linux/io_uring.h>
+#endif
+
+/* This polling engine is only relevant on linux kernels supporting io_uring
+   with multishot poll requests (5.13+), and only when the kernel headers we are
+   built against know about them.
+
+   Only readiness notification goes through the ring: each grpc_fd has a
+   multishot IORING_OP_POLL_ADD in place of its epoll registration, and the
+   engine otherwise behaves like epoll1. The data path is unchanged: tcp_posix
+   and the TCP server still call recvmsg(), sendmsg() and accept4() once per
+   socket when notified. The one exception is write batching
+   (GRPC_ARG_TCP_WRITE_BATCHING_ENABLED), whose sends go through a separate
+   ring with any polling engine; see grpc_io_uring_sendmsg_batch(). */
+#if defined(GRPC_LINUX_IO_URING) && defined(GRPC_LINUX_EPOLL) && \
+    defined(IORING_POLL_ADD_MULTI) && defined(IORING_ENTER_EXT_ARG)
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/iomgr/block_annotate.h"
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/iomgr/lockfree_event.h"
+#include "src/core/lib/iomgr/wakeup_fd_posix.h"
+#include "src/core/lib/profiling/timers.h"
+
+static grpc_wakeup_fd global_wakeup_fd;
+
+/*******************************************************************************
+ * Singleton io_uring related fields
+ */
+
+#define URING_SQ_ENTRIES 1024
+#define MAX_URING_EVENTS 100
+#define MAX_URING_EVENTS_HANDLED_PER_ITERATION 1
+
+/* Readiness events requested for every fd. POLLERR and POLLHUP are always
+   reported by the kernel. */
+#define URING_POLL_MASK (POLLIN | POLLPRI | POLLOUT)
+
+/* user_data layout for fd poll requests:
+     bit  0      : track_err
+     bits 1..47  : grpc_fd pointer (which is at least 2-byte aligned)
+     bits 48..63 : generation of the grpc_fd when the request was armed
+   grpc_fd structures are never freed while the engine is alive (they are kept
+   in a freelist), so a stale completion can always be decoded safely and is
+   discarded once its generation no longer matches. */
+#define URING_FD_PTR_MASK ((static_cast<uint64_t>(1) << 48) - 2)
+#define URING_FD_GEN_SHIFT 48
+
+/* Tags for requests that are not fd polls */
+static char g_uring_ignore_tag;
+
+/* NOTE ON SYNCHRONIZATION:
+ * - The completion queue and the events/num_events/cursor fields are only
+ *   touched by the designated poller, so they need no locks. num_events and
+ *   cursor are atomic to provide memory visibility guarantees only, exactly as
+ *   in the epoll1 engine.
+ * - The submission queue may be filled from any thread (fd creation, fd
+ *   orphaning and re-arming by the poller) and is protected by sq_mu. Entries
+ *   that are queued but not yet submitted are picked up by the next
+ *   io_uring_enter() from any thread, so a single syscall typically both
+ *   submits all re-arms of the previous round and waits for new completions.
+ */
+typedef struct uring_set {
+  int ring_fd;
+
+  /* Ring memory */
+  void* sq_ring_ptr;
+  size_t sq_ring_sz;
+  void* cq_ring_ptr;
+  size_t cq_ring_sz;
+  struct io_uring_sqe* sqes;
+  size_t sqes_sz;
+
+  /* Submission queue */
+  unsigned* sq_khead;
+  unsigned* sq_ktail;
+  unsigned sq_ring_mask;
+  unsigned sq_ring_entries;
+  unsigned* sq_array;
+  gpr_mu sq_mu;
+
+  /* Completion queue */
+  unsigned* cq_khead;
+  unsigned* cq_ktail;
+  unsigned cq_ring_mask;
+  struct io_uring_cqe* cqes;
+
+  /* The completions reaped after the last call to io_uring_enter() */
+  struct io_uring_cqe events[MAX_URING_EVENTS];
+
+  /* The number of completions after the last call to io_uring_enter() */
+  gpr_atm num_events;
+
+  /* Index of the first completion in events that has to be processed. This
+   * field is only valid if num_events > 0 */
+  gpr_atm cursor;
+} uring_set;
+
+/* The global singleton io_uring instance */
+static uring_set g_uring_set;
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params* p) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags, void* arg, size_t argsz) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, arg, argsz));
+}
+
+static void uring_set_unmap(uring_set* set) {
+  if (set->sqes != nullptr) {
+    munmap(set->sqes, set->sqes_sz);
+    set->sqes = nullptr;
+  }
+  if (set->sq_ring_ptr != nullptr) {
+    munmap(set->sq_ring_ptr, set->sq_ring_sz);
+    set->sq_ring_ptr = nullptr;
+  }
+  set->cq_ring_ptr = nullptr;
+}
+
+/* Must be called *only* once per set */
+static bool uring_set_init(uring_set* set, unsigned entries) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  set->ring_fd = sys_io_uring_setup(entries, &params);
+  if (set->ring_fd < 0) {
+    gpr_log(GPR_ERROR, "io_uring_setup unavailable: %s", strerror(errno));
+    return false;
+  }
+  /* Multishot poll (5.13) postdates all of these features; checking them here
+     lets us bail out early on older kernels. The multishot support itself is
+     probed in pollset_global_init(). */
+  const uint32_t required_features =
+      IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+  if ((params.features & required_features) != required_features) {
+    gpr_log(GPR_ERROR, "io_uring lacks required features (have 0x%x)",
+            params.features);
+    close(set->ring_fd);
+    set->ring_fd = -1;
+    return false;
+  }
+
+  set->sq_ring_sz =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  set->cq_ring_sz =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  /* With IORING_FEAT_SINGLE_MMAP both rings share a single mapping */
+  set->sq_ring_sz =
+      std::max(set->sq_ring_sz, set->cq_ring_sz);
+  set->sq_ring_ptr =
+      mmap(nullptr, set->sq_ring_sz, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, set->ring_fd, IORING_OFF_SQ_RING);
+  if (set->sq_ring_ptr == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "io_uring ring mmap failed: %s", strerror(errno));
+    set->sq_ring_ptr = nullptr;
+    close(set->ring_fd);
+    set->ring_fd = -1;
+    return false;
+  }
+  set->cq_ring_ptr = set->sq_ring_ptr;
+  set->sqes_sz = params.sq_entries * sizeof(struct io_uring_sqe);
+  set->sqes = static_cast<struct io_uring_sqe*>(
+      mmap(nullptr, set->sqes_sz, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, set->ring_fd, IORING_OFF_SQES));
+  if (set->sqes == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "io_uring sqes mmap failed: %s", strerror(errno));
+    set->sqes = nullptr;
+    uring_set_unmap(set);
+    close(set->ring_fd);
+    set->ring_fd = -1;
+    return false;
+  }
+
+  char* sq = static_cast<char*>(set->sq_ring_ptr);
+  set->sq_khead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  set->sq_ktail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  set->sq_ring_mask =
+      *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  set->sq_ring_entries =
+      *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+  set->sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+  char* cq = static_cast<char*>(set->cq_ring_ptr);
+  set->cq_khead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  set->cq_ktail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  set->cq_ring_mask =
+      *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  set->cqes =
+      reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  gpr_mu_init(&set->sq_mu);
+  gpr_log(GPR_INFO, "grpc io_uring fd: %d (sq=%u cq=%u)", set->ring_fd,
+          params.sq_entries, params.cq_entries);
+  gpr_atm_no_barrier_store(&set->num_events, 0);
+  gpr_atm_no_barrier_store(&set->cursor, 0);
+  return true;
+}
+
+/* uring_set_init() MUST be called before calling this. */
+static void uring_set_shutdown(uring_set* set) {
+  if (set->ring_fd >= 0) {
+    uring_set_unmap(set);
+    close(set->ring_fd);
+    set->ring_fd = -1;
+    gpr_mu_destroy(&set->sq_mu);
+  }
+}
+
+/* Number of queued submission entries not yet consumed by the kernel */
+static unsigned uring_sq_pending(uring_set* set) {
+  return __atomic_load_n(set->sq_ktail, __ATOMIC_ACQUIRE) -
+         __atomic_load_n(set->sq_khead, __ATOMIC_ACQUIRE);
+}
+
+/* Hands every queued submission entry to the kernel without waiting for
+   completions. */
+static int uring_submit(uring_set* set) {
+  int r;
+  do {
+    r = sys_io_uring_enter(set->ring_fd, uring_sq_pending(set), 0, 0, nullptr,
+                           0);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0) {
+    gpr_log(GPR_ERROR, "io_uring_enter(submit) failed: %s", strerror(errno));
+  }
+  return r;
+}
+
+/* Returns a zeroed submission entry. sq_mu must be held; the entry becomes
+   visible to the kernel at the next uring_sq_commit(). */
+static struct io_uring_sqe* uring_get_sqe(uring_set* set, unsigned* tail) {
+  *tail = *set->sq_ktail;
+  while (*tail - __atomic_load_n(set->sq_khead, __ATOMIC_ACQUIRE) >=
+         set->sq_ring_entries) {
+    /* The submission ring is full: flush it before queueing more */
+    if (uring_submit(set) < 0) return nullptr;
+  }
+  unsigned idx = *tail & set->sq_ring_mask;
+  struct io_uring_sqe* sqe = &set->sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  set->sq_array[idx] = idx;
+  return sqe;
+}
+
+static void uring_sq_commit(uring_set* set, unsigned tail) {
+  __atomic_store_n(set->sq_ktail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/* Queues a multishot poll request for fd. If submit_now is false the request
+   is submitted by the next io_uring_enter() call (usually the designated
+   poller's). */
+static void uring_poll_add(int fd, uint64_t user_data, bool submit_now) {
+  gpr_mu_lock(&g_uring_set.sq_mu);
+  unsigned tail;
+  struct io_uring_sqe* sqe = uring_get_sqe(&g_uring_set, &tail);
+  if (sqe != nullptr) {
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = URING_POLL_MASK;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->user_data = user_data;
+    uring_sq_commit(&g_uring_set, tail);
+    if (submit_now) uring_submit(&g_uring_set);
+  }
+  gpr_mu_unlock(&g_uring_set.sq_mu);
+}
+
+/* Cancels the poll request(s) previously armed with user_data and submits the
+   cancellation right away: the kernel keeps a reference on the file for as long
+   as a poll request is armed. */
+static void uring_poll_remove(uint64_t user_data) {
+  gpr_mu_lock(&g_uring_set.sq_mu);
+  unsigned tail;
+  struct io_uring_sqe* sqe = uring_get_sqe(&g_uring_set, &tail);
+  if (sqe != nullptr) {
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = user_data;
+    sqe->user_data = reinterpret_cast<uint64_t>(&g_uring_ignore_tag);
+    uring_sq_commit(&g_uring_set, tail);
+    uring_submit(&g_uring_set);
+  }
+  gpr_mu_unlock(&g_uring_set.sq_mu);
+}
+
+/* Moves up to MAX_URING_EVENTS completions into g_uring_set.events. Only called
+   by the designated poller. */
+static int uring_reap_completions() {
+  unsigned head = *g_uring_set.cq_khead;
+  unsigned tail = __atomic_load_n(g_uring_set.cq_ktail, __ATOMIC_ACQUIRE);
+  int n = 0;
+  while (head != tail && n < MAX_URING_EVENTS) {
+    g_uring_set.events[n++] =
+        g_uring_set.cqes[head & g_uring_set.cq_ring_mask];
+    head++;
+  }
+  __atomic_store_n(g_uring_set.cq_khead, head, __ATOMIC_RELEASE);
+  return n;
+}
+
+/*******************************************************************************
+ * Fd Declarations
+ */
+
+/* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
+struct grpc_fork_fd_list {
+  grpc_fd* fd;
+  grpc_fd* next;
+  grpc_fd* prev;
+};
+
+struct grpc_fd {
+  int fd;
+  bool track_err;
+
+  /* Bumped every time the fd is orphaned so that completions for a previous
+     incarnation of this (freelisted) structure can be told apart */
+  gpr_atm generation;
+
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> read_closure;
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> write_closure;
+  grpc_core::ManualConstructor<grpc_core::LockfreeEvent> error_closure;
+
+  struct grpc_fd* freelist_next;
+
+  /* Set once the fd's endpoint batches its writes */
+  gpr_atm write_batching;
+
+  grpc_iomgr_object iomgr_object;
+
+  /* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
+  grpc_fork_fd_list* fork_fd_list;
+};
+
+static void fd_global_init(void);
+static void fd_global_shutdown(void);
+
+/*******************************************************************************
+ * Pollset Declarations
+ */
+
+typedef enum { UNKICKED, KICKED, DESIGNATED_POLLER } kick_state;
+
+static const char* kick_state_string(kick_state st) {
+  switch (st) {
+    case UNKICKED:
+      return "UNKICKED";
+    case KICKED:
+      return "KICKED";
+    case DESIGNATED_POLLER:
+      return "DESIGNATED_POLLER";
+  }
+  GPR_UNREACHABLE_CODE(return "UNKNOWN");
+}
+
+struct grpc_pollset_worker {
+  kick_state state;
+  int kick_state_mutator;  // which line of code last changed kick state
+  bool initialized_cv;
+  grpc_pollset_worker* next;
+  grpc_pollset_worker* prev;
+  gpr_cv cv;
+  grpc_closure_list schedule_on_end_work;
+};
+
+#define SET_KICK_STATE(worker, kick_state)   \
+  do {                                       \
+    (worker)->state = (kick_state);          \
+    (worker)->kick_state_mutator = __LINE__; \
+  } while (false)
+
+#define MAX_NEIGHBORHOODS 1024u
+
+typedef struct pollset_neighborhood {
+  union {
+    char pad[GPR_CACHELINE_SIZE];
+    struct {
+      gpr_mu mu;
+      grpc_pollset* active_root;
+    };
+  };
+} pollset_neighborhood;
+
+struct grpc_pollset {
+  gpr_mu mu;
+  pollset_neighborhood* neighborhood;
+  bool reassigning_neighborhood;
+  grpc_pollset_worker* root_worker;
+  bool kicked_without_poller;
+
+  /* Set to true if the pollset is observed to have no workers available to
+     poll */
+  bool seen_inactive;
+  bool shutting_down;             /* Is the pollset shutting down ? */
+  grpc_closure* shutdown_closure; /* Called after shutdown is complete */
+
+  /* Number of workers who are *about-to* attach themselves to the pollset
+   * worker list */
+  int begin_refs;
+
+  grpc_pollset* next;
+  grpc_pollset* prev;
+};
+
+/*******************************************************************************
+ * Pollset-set Declarations
+ */
+
+struct grpc_pollset_set {
+  char unused;
+};
+
+/*******************************************************************************
+ * Common helpers
+ */
+
+static bool append_error(grpc_error_handle* composite, grpc_error_handle error,
+                         const char* desc) {
+  if (error == GRPC_ERROR_NONE) return true;
+  if (*composite == GRPC_ERROR_NONE) {
+    *composite = GRPC_ERROR_CREATE_FROM_COPIED_STRING(desc);
+  }
+  *composite = grpc_error_add_child(*composite, error);
+  return false;
+}
+
+/*******************************************************************************
+ * Fd Definitions
+ */
+
+/* As in the epoll1 engine, grpc_fd structures are freelisted rather than freed
+ * so that completions racing with fd orphaning never touch freed memory. In
+ * the worst case losing this race becomes a spurious notification on a reused
+ * fd, and the generation stamped into each request's user_data suppresses even
+ * that for requests armed before the fd was orphaned. */
+
+static grpc_fd* fd_freelist = nullptr;
+static gpr_mu fd_freelist_mu;
+
+/* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
+static grpc_fd* fork_fd_list_head = nullptr;
+static gpr_mu fork_fd_list_mu;
+
+static void fd_global_init(void) { gpr_mu_init(&fd_freelist_mu); }
+
+static void fd_global_shutdown(void) {
+  gpr_mu_lock(&fd_freelist_mu);
+  gpr_mu_unlock(&fd_freelist_mu);
+  while (fd_freelist != nullptr) {
+    grpc_fd* fd = fd_freelist;
+    fd_freelist = fd_freelist->freelist_next;
+    gpr_free(fd);
+  }
+  gpr_mu_destroy(&fd_freelist_mu);
+}
+
+static void fork_fd_list_add_grpc_fd(grpc_fd* fd) {
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_lock(&fork_fd_list_mu);
+    fd->fork_fd_list =
+        static_cast<grpc_fork_fd_list*>(gpr_malloc(sizeof(grpc_fork_fd_list)));
+    fd->fork_fd_list->next = fork_fd_list_head;
+    fd->fork_fd_list->prev = nullptr;
+    if (fork_fd_list_head != nullptr) {
+      fork_fd_list_head->fork_fd_list->prev = fd;
+    }
+    fork_fd_list_head = fd;
+    gpr_mu_unlock(&fork_fd_list_mu);
+  }
+}
+
+static void fork_fd_list_remove_grpc_fd(grpc_fd* fd) {
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_lock(&fork_fd_list_mu);
+    if (fork_fd_list_head == fd) {
+      fork_fd_list_head = fd->fork_fd_list->next;
+    }
+    if (fd->fork_fd_list->prev != nullptr) {
+      fd->fork_fd_list->prev->fork_fd_list->next = fd->fork_fd_list->next;
+    }
+    if (fd->fork_fd_list->next != nullptr) {
+      fd->fork_fd_list->next->fork_fd_list->prev = fd->fork_fd_list->prev;
+    }
+    gpr_free(fd->fork_fd_list);
+    gpr_mu_unlock(&fork_fd_list_mu);
+  }
+}
+
+static uint64_t fd_user_data(grpc_fd* fd) {
+  uint64_t ptr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(fd));
+  GPR_DEBUG_ASSERT((ptr & ~URING_FD_PTR_MASK) == 0);
+  uint64_t gen =
+      static_cast<uint64_t>(gpr_atm_no_barrier_load(&fd->generation)) & 0xffff;
+  return ptr | (gen << URING_FD_GEN_SHIFT) | (fd->track_err ? 1 : 0);
+}
+
+static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
+  grpc_fd* new_fd = nullptr;
+
+  gpr_mu_lock(&fd_freelist_mu);
+  if (fd_freelist != nullptr) {
+    new_fd = fd_freelist;
+    fd_freelist = fd_freelist->freelist_next;
+  }
+  gpr_mu_unlock(&fd_freelist_mu);
+
+  if (new_fd == nullptr) {
+    new_fd = static_cast<grpc_fd*>(gpr_malloc(sizeof(grpc_fd)));
+    gpr_atm_no_barrier_store(&new_fd->generation, 0);
+    new_fd->read_closure.Init();
+    new_fd->write_closure.Init();
+    new_fd->error_closure.Init();
+  }
+  new_fd->fd = fd;
+  new_fd->track_err = track_err;
+  new_fd->read_closure->InitEvent();
+  new_fd->write_closure->InitEvent();
+  new_fd->error_closure->InitEvent();
+
+  new_fd->freelist_next = nullptr;
+  gpr_atm_no_barrier_store(&new_fd->write_batching, 0);
+
+  std::string fd_name = absl::StrCat(name, " fd=", fd);
+  grpc_iomgr_register_object(&new_fd->iomgr_object, fd_name.c_str());
+  fork_fd_list_add_grpc_fd(new_fd);
+#ifndef NDEBUG
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_fd_refcount)) {
+    gpr_log(GPR_DEBUG, "FD %d %p create %s", fd, new_fd, fd_name.c_str());
+  }
+#endif
+
+  /* Submitted immediately: the designated poller may be blocked in
+     io_uring_enter() and would not pick the request up until its next round */
+  uring_poll_add(fd, fd_user_data(new_fd), true);
+
+  return new_fd;
+}
+
+static int fd_wrapped_fd(grpc_fd* fd) { return fd->fd; }
+
+/* if 'releasing_fd' is true, it means that we are going to detach the internal
+ * fd from grpc_fd structure (i.e which means we should not be calling
+ * shutdown() syscall on that fd) */
+static void fd_shutdown_internal(grpc_fd* fd, grpc_error_handle why,
+                                 bool releasing_fd) {
+  if (fd->read_closure->SetShutdown(GRPC_ERROR_REF(why))) {
+    if (!releasing_fd) {
+      shutdown(fd->fd, SHUT_RDWR);
+    }
+    fd->write_closure->SetShutdown(GRPC_ERROR_REF(why));
+    fd->error_closure->SetShutdown(GRPC_ERROR_REF(why));
+  }
+  GRPC_ERROR_UNREF(why);
+}
+
+/* Might be called multiple times */
+static void fd_shutdown(grpc_fd* fd, grpc_error_handle why) {
+  fd_shutdown_internal(fd, why, false);
+}
+
+static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
+                      const char* reason) {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  bool is_release_fd = (release_fd != nullptr);
+
+  if (!fd->read_closure->IsShutdown()) {
+    fd_shutdown_internal(fd, GRPC_ERROR_CREATE_FROM_COPIED_STRING(reason),
+                         is_release_fd);
+  }
+
+  /* Unlike an epoll registration, an armed poll request pins the underlying
+     file: it has to be cancelled before the fd is closed or released, even if
+     the fd was shut down earlier. Removing a request that the kernel already
+     terminated is harmless (-ENOENT). */
+  uring_poll_remove(fd_user_data(fd));
+  gpr_atm_no_barrier_fetch_add(&fd->generation, 1);
+
+  /* If release_fd is not NULL, we should be relinquishing control of the file
+     descriptor fd->fd (but we still own the grpc_fd structure). */
+  if (is_release_fd) {
+    *release_fd = fd->fd;
+  } else {
+    close(fd->fd);
+  }
+
+  grpc_core::ExecCtx::Run(DEBUG_LOCATION, on_done, GRPC_ERROR_REF(error));
+
+  grpc_iomgr_unregister_object(&fd->iomgr_object);
+  fork_fd_list_remove_grpc_fd(fd);
+  fd->read_closure->DestroyEvent();
+  fd->write_closure->DestroyEvent();
+  fd->error_closure->DestroyEvent();
+
+  gpr_mu_lock(&fd_freelist_mu);
+  fd->freelist_next = fd_freelist;
+  fd_freelist = fd;
+  gpr_mu_unlock(&fd_freelist_mu);
+}
+
+static bool fd_is_shutdown(grpc_fd* fd) {
+  return fd->read_closure->IsShutdown();
+}
+
+static void fd_set_write_batching(grpc_fd* fd) {
+  gpr_atm_no_barrier_store(&fd->write_batching, 1);
+}
+
+static void fd_notify_on_read(grpc_fd* fd, grpc_closure* closure) {
+  fd->read_closure->NotifyOn(closure);
+}
+
+static void fd_notify_on_write(grpc_fd* fd, grpc_closure* closure) {
+  fd->write_closure->NotifyOn(closure);
+}
+
+static void fd_notify_on_error(grpc_fd* fd, grpc_closure* closure) {
+  fd->error_closure->NotifyOn(closure);
+}
+
+static void fd_become_readable(grpc_fd* fd) { fd->read_closure->SetReady(); }
+
+static void fd_become_writable(grpc_fd* fd) { fd->write_closure->SetReady(); }
+
+static void fd_has_errors(grpc_fd* fd) { fd->error_closure->SetReady(); }
+
+/*******************************************************************************
+ * Pollset Definitions
+ */
+
+static GPR_THREAD_LOCAL(grpc_pollset*) g_current_thread_pollset;
+static GPR_THREAD_LOCAL(grpc_pollset_worker*) g_current_thread_worker;
+
+/* The designated poller */
+static gpr_atm g_active_poller;
+
+static pollset_neighborhood* g_neighborhoods;
+static size_t g_num_neighborhoods;
+
+/* Return true if first in list */
+static bool worker_insert(grpc_pollset* pollset, grpc_pollset_worker* worker) {
+  if (pollset->root_worker == nullptr) {
+    pollset->root_worker = worker;
+    worker->next = worker->prev = worker;
+    return true;
+  } else {
+    worker->next = pollset->root_worker;
+    worker->prev = worker->next->prev;
+    worker->next->prev = worker;
+    worker->prev->next = worker;
+    return false;
+  }
+}
+
+/* Return true if last in list */
+typedef enum { EMPTIED, NEW_ROOT, REMOVED } worker_remove_result;
+
+static worker_remove_result worker_remove(grpc_pollset* pollset,
+                                          grpc_pollset_worker* worker) {
+  if (worker == pollset->root_worker) {
+    if (worker == worker->next) {
+      pollset->root_worker = nullptr;
+      return EMPTIED;
+    } else {
+      pollset->root_worker = worker->next;
+      worker->prev->next = worker->next;
+      worker->next->prev = worker->prev;
+      return NEW_ROOT;
+    }
+  } else {
+    worker->prev->next = worker->next;
+    worker->next->prev = worker->prev;
+    return REMOVED;
+  }
+}
+
+static size_t choose_neighborhood(void) {
+  return static_cast<size_t>(gpr_cpu_current_cpu()) % g_num_neighborhoods;
+}
+
+/* Arms the global wakeup fd and checks that the kernel accepts multishot poll
+   requests: older kernels reject IORING_POLL_ADD_MULTI with -EINVAL. The
+   request stays armed afterwards. */
+static grpc_error_handle arm_and_probe_global_wakeup_fd(void) {
+  uring_poll_add(global_wakeup_fd.read_fd,
+                 reinterpret_cast<uint64_t>(&global_wakeup_fd), true);
+  grpc_error_handle err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+  if (err != GRPC_ERROR_NONE) return err;
+  int r;
+  do {
+    r = sys_io_uring_enter(g_uring_set.ring_fd, 0, 1, IORING_ENTER_GETEVENTS,
+                           nullptr, 0);
+  } while (r < 0 && errno == EINTR);
+  if (r < 0) return GRPC_OS_ERROR(errno, "io_uring_enter");
+  int n = uring_reap_completions();
+  for (int i = 0; i < n; i++) {
+    const struct io_uring_cqe* cqe = &g_uring_set.events[i];
+    if (cqe->user_data != reinterpret_cast<uint64_t>(&global_wakeup_fd)) {
+      continue;
+    }
+    if (cqe->res < 0) {
+      return GRPC_OS_ERROR(-cqe->res, "io_uring multishot poll");
+    }
+    if ((cqe->flags & IORING_CQE_F_MORE) == 0) {
+      return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "io_uring multishot poll terminated unexpectedly");
+    }
+  }
+  return grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd);
+}
+
+static grpc_error_handle pollset_global_init(void) {
+  gpr_atm_no_barrier_store(&g_active_poller, 0);
+  global_wakeup_fd.read_fd = -1;
+  grpc_error_handle err = grpc_wakeup_fd_init(&global_wakeup_fd);
+  if (err != GRPC_ERROR_NONE) return err;
+  err = arm_and_probe_global_wakeup_fd();
+  if (err != GRPC_ERROR_NONE) return err;
+  g_num_neighborhoods =
+      grpc_core::Clamp(gpr_cpu_num_cores(), 1u, MAX_NEIGHBORHOODS);
+  g_neighborhoods = static_cast<pollset_neighborhood*>(
+      gpr_zalloc(sizeof(*g_neighborhoods) * g_num_neighborhoods));
+  for (size_t i = 0; i < g_num_neighborhoods; i++) {
+    gpr_mu_init(&g_neighborhoods[i].mu);
+  }
+  return GRPC_ERROR_NONE;
+}
+
+static void pollset_global_shutdown(void) {
+  if (global_wakeup_fd.read_fd != -1) grpc_wakeup_fd_destroy(&global_wakeup_fd);
+  for (size_t i = 0; i < g_num_neighborhoods; i++) {
+    gpr_mu_destroy(&g_neighborhoods[i].mu);
+  }
+  gpr_free(g_neighborhoods);
+  g_neighborhoods = nullptr;
+  g_num_neighborhoods = 0;
+}
+
+static void pollset_init(grpc_pollset* pollset, gpr_mu** mu) {
+  gpr_mu_init(&pollset->mu);
+  *mu = &pollset->mu;
+  pollset->neighborhood = &g_neighborhoods[choose_neighborhood()];
+  pollset->reassigning_neighborhood = false;
+  pollset->root_worker = nullptr;
+  pollset->kicked_without_poller = false;
+  pollset->seen_inactive = true;
+  pollset->shutting_down = false;
+  pollset->shutdown_closure = nullptr;
+  pollset->begin_refs = 0;
+  pollset->next = pollset->prev = nullptr;
+}
+
+static void pollset_destroy(grpc_pollset* pollset) {
+  gpr_mu_lock(&pollset->mu);
+  if (!pollset->seen_inactive) {
+    pollset_neighborhood* neighborhood = pollset->neighborhood;
+    gpr_mu_unlock(&pollset->mu);
+  retry_lock_neighborhood:
+    gpr_mu_lock(&neighborhood->mu);
+    gpr_mu_lock(&pollset->mu);
+    if (!pollset->seen_inactive) {
+      if (pollset->neighborhood != neighborhood) {
+        gpr_mu_unlock(&neighborhood->mu);
+        neighborhood = pollset->neighborhood;
+        gpr_mu_unlock(&pollset->mu);
+        goto retry_lock_neighborhood;
+      }
+      pollset->prev->next = pollset->next;
+      pollset->next->prev = pollset->prev;
+      if (pollset == pollset->neighborhood->active_root) {
+        pollset->neighborhood->active_root =
+            pollset->next == pollset ? nullptr : pollset->next;
+      }
+    }
+    gpr_mu_unlock(&pollset->neighborhood->mu);
+  }
+  gpr_mu_unlock(&pollset->mu);
+  gpr_mu_destroy(&pollset->mu);
+}
+
+static grpc_error_handle pollset_kick_all(grpc_pollset* pollset) {
+  GPR_TIMER_SCOPE("pollset_kick_all", 0);
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  if (pollset->root_worker != nullptr) {
+    grpc_pollset_worker* worker = pollset->root_worker;
+    do {
+      GRPC_STATS_INC_POLLSET_KICK();
+      switch (worker->state) {
+        case KICKED:
+          GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+          break;
+        case UNKICKED:
+          SET_KICK_STATE(worker, KICKED);
+          if (worker->initialized_cv) {
+            GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+            gpr_cv_signal(&worker->cv);
+          }
+          break;
+        case DESIGNATED_POLLER:
+          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+          SET_KICK_STATE(worker, KICKED);
+          append_error(&error, grpc_wakeup_fd_wakeup(&global_wakeup_fd),
+                       "pollset_kick_all");
+          break;
+      }
+
+      worker = worker->next;
+    } while (worker != pollset->root_worker);
+  }
+  return error;
+}
+
+static void pollset_maybe_finish_shutdown(grpc_pollset* pollset) {
+  if (pollset->shutdown_closure != nullptr && pollset->root_worker == nullptr &&
+      pollset->begin_refs == 0) {
+    GPR_TIMER_MARK("pollset_finish_shutdown", 0);
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, pollset->shutdown_closure,
+                            GRPC_ERROR_NONE);
+    pollset->shutdown_closure = nullptr;
+  }
+}
+
+static void pollset_shutdown(grpc_pollset* pollset, grpc_closure* closure) {
+  GPR_TIMER_SCOPE("pollset_shutdown", 0);
+  GPR_ASSERT(pollset->shutdown_closure == nullptr);
+  GPR_ASSERT(!pollset->shutting_down);
+  pollset->shutdown_closure = closure;
+  pollset->shutting_down = true;
+  GRPC_LOG_IF_ERROR("pollset_shutdown", pollset_kick_all(pollset));
+  pollset_maybe_finish_shutdown(pollset);
+}
+
+static int poll_deadline_to_millis_timeout(grpc_millis millis) {
+  if (millis == GRPC_MILLIS_INF_FUTURE) return -1;
+  grpc_millis delta = millis - grpc_core::ExecCtx::Get()->Now();
+  if (delta > INT_MAX) {
+    return INT_MAX;
+  } else if (delta < 0) {
+    return 0;
+  } else {
+    return static_cast<int>(delta);
+  }
+}
+
+/* Whether a completion with the given user_data is for an fd whose endpoint
+   batches its writes. As in epoll1, a stale fd stays allocated on the free
+   list, so a stale flag only makes a round end a little early or late. */
+static bool cqe_batches_writes(uint64_t user_data) {
+  if (user_data == reinterpret_cast<uint64_t>(&g_uring_ignore_tag) ||
+      user_data == reinterpret_cast<uint64_t>(&global_wakeup_fd)) {
+    return false;
+  }
+  grpc_fd* fd = reinterpret_cast<grpc_fd*>(
+      static_cast<uintptr_t>(user_data & URING_FD_PTR_MASK));
+  return gpr_atm_no_barrier_load(&fd->write_batching) != 0;
+}
+
+/* Process the completions found by do_uring_wait() function.
+   - g_uring_set.cursor points to the index of the first completion to be
+     processed
+   - This function then processes up-to MAX_URING_EVENTS_HANDLED_PER_ITERATION,
+     then carries on through the completions of fds whose endpoints batch their
+     writes (as in epoll1), and updates the g_uring_set.cursor
+   - Multishot requests that were terminated by the kernel (no
+     IORING_CQE_F_MORE) are re-armed; the re-arm is queued rather than submitted
+     so that it rides along with the next io_uring_enter().
+
+   NOTE ON SYNCRHONIZATION: Similar to do_uring_wait(), this function is only
+   called by g_active_poller thread. So there is no need for synchronization
+   when accessing fields in g_uring_set */
+static grpc_error_handle process_uring_events(grpc_pollset* /*pollset*/) {
+  GPR_TIMER_SCOPE("process_uring_events", 0);
+
+  static const char* err_desc = "process_events";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  long num_events = gpr_atm_acq_load(&g_uring_set.num_events);
+  long cursor = gpr_atm_acq_load(&g_uring_set.cursor);
+  for (int idx = 0; cursor != num_events; idx++) {
+    const struct io_uring_cqe* cqe = &g_uring_set.events[cursor];
+    const uint64_t user_data = cqe->user_data;
+    if (idx >= MAX_URING_EVENTS_HANDLED_PER_ITERATION &&
+        !cqe_batches_writes(user_data)) {
+      break;
+    }
+    cursor++;
+    const bool more = (cqe->flags & IORING_CQE_F_MORE) != 0;
+
+    if (user_data == reinterpret_cast<uint64_t>(&g_uring_ignore_tag)) {
+      continue;
+    }
+    if (user_data == reinterpret_cast<uint64_t>(&global_wakeup_fd)) {
+      append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
+                   err_desc);
+      if (!more) {
+        uring_poll_add(global_wakeup_fd.read_fd, user_data, false);
+      }
+      continue;
+    }
+
+    grpc_fd* fd = reinterpret_cast<grpc_fd*>(
+        static_cast<uintptr_t>(user_data & URING_FD_PTR_MASK));
+    bool track_err = (user_data & 1) != 0;
+    uint64_t gen = user_data >> URING_FD_GEN_SHIFT;
+    if (cqe->res == -ECANCELED ||
+        gen != (static_cast<uint64_t>(gpr_atm_no_barrier_load(
+                    &fd->generation)) &
+                0xffff)) {
+      /* Request for a previous incarnation of this grpc_fd */
+      continue;
+    }
+    uint32_t revents = cqe->res < 0 ? static_cast<uint32_t>(POLLERR)
+                                    : static_cast<uint32_t>(cqe->res);
+    bool cancel = (revents & POLLHUP) != 0;
+    bool has_error = (revents & POLLERR) != 0;
+    bool read_ev = (revents & (POLLIN | POLLPRI)) != 0;
+    bool write_ev = (revents & POLLOUT) != 0;
+    bool err_fallback = has_error && !track_err;
+
+    if (has_error && !err_fallback) {
+      fd_has_errors(fd);
+    }
+
+    if (read_ev || cancel || err_fallback) {
+      fd_become_readable(fd);
+    }
+
+    if (write_ev || cancel || err_fallback) {
+      fd_become_writable(fd);
+    }
+
+    if (!more && cqe->res >= 0 && !fd->read_closure->IsShutdown()) {
+      uring_poll_add(fd->fd, user_data, false);
+    }
+  }
+  gpr_atm_rel_store(&g_uring_set.cursor, cursor);
+  return error;
+}
+
+/* Submits any queued requests, waits for completions and stores them in
+   g_uring_set.events. This does not "process" any of the completions yet; that
+   is done in process_uring_events().
+
+   NOTE ON SYNCHRONIZATION: At any point of time, only the g_active_poller
+   (i.e the designated poller thread) will be calling this function. So there is
+   no need for any synchronization when accesing fields in g_uring_set */
+static grpc_error_handle do_uring_wait(grpc_pollset* ps, grpc_millis deadline) {
+  GPR_TIMER_SCOPE("do_uring_wait", 0);
+
+  int r;
+  int timeout = poll_deadline_to_millis_timeout(deadline);
+  struct __kernel_timespec ts;
+  struct io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  if (timeout >= 0) {
+    ts.tv_sec = timeout / GPR_MS_PER_SEC;
+    ts.tv_nsec = (timeout % GPR_MS_PER_SEC) * GPR_NS_PER_MS;
+    arg.ts = reinterpret_cast<uint64_t>(&ts);
+  }
+  if (timeout != 0) {
+    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  }
+  do {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    r = sys_io_uring_enter(g_uring_set.ring_fd, uring_sq_pending(&g_uring_set),
+                           timeout == 0 ? 0 : 1,
+                           IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg,
+                           sizeof(arg));
+  } while (r < 0 && errno == EINTR);
+  if (timeout != 0) {
+    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  }
+
+  /* ETIME just means the deadline passed; EBUSY/EAGAIN mean the kernel could
+     not take more submissions until completions are reaped, which happens
+     right below. */
+  if (r < 0 && errno != ETIME && errno != EBUSY && errno != EAGAIN) {
+    return GRPC_OS_ERROR(errno, "io_uring_enter");
+  }
+
+  int n = uring_reap_completions();
+  GRPC_STATS_INC_POLL_EVENTS_RETURNED(n);
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "ps: %p poll got %d events", ps, n);
+  }
+
+  gpr_atm_rel_store(&g_uring_set.num_events, n);
+  gpr_atm_rel_store(&g_uring_set.cursor, 0);
+
+  return GRPC_ERROR_NONE;
+}
+
+static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
+                         grpc_pollset_worker** worker_hdl,
+                         grpc_millis deadline) {
+  GPR_TIMER_SCOPE("begin_worker", 0);
+  if (worker_hdl != nullptr) *worker_hdl = worker;
+  worker->initialized_cv = false;
+  SET_KICK_STATE(worker, UNKICKED);
+  worker->schedule_on_end_work = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
+  pollset->begin_refs++;
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "PS:%p BEGIN_STARTS:%p", pollset, worker);
+  }
+
+  if (pollset->seen_inactive) {
+    // pollset has been observed to be inactive, we need to move back to the
+    // active list
+    bool is_reassigning = false;
+    if (!pollset->reassigning_neighborhood) {
+      is_reassigning = true;
+      pollset->reassigning_neighborhood = true;
+      pollset->neighborhood = &g_neighborhoods[choose_neighborhood()];
+    }
+    pollset_neighborhood* neighborhood = pollset->neighborhood;
+    gpr_mu_unlock(&pollset->mu);
+  // pollset unlocked: state may change (even worker->kick_state)
+  retry_lock_neighborhood:
+    gpr_mu_lock(&neighborhood->mu);
+    gpr_mu_lock(&pollset->mu);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, "PS:%p BEGIN_REORG:%p kick_state=%s is_reassigning=%d",
+              pollset, worker, kick_state_string(worker->state),
+              is_reassigning);
+    }
+    if (pollset->seen_inactive) {
+      if (neighborhood != pollset->neighborhood) {
+        gpr_mu_unlock(&neighborhood->mu);
+        neighborhood = pollset->neighborhood;
+        gpr_mu_unlock(&pollset->mu);
+        goto retry_lock_neighborhood;
+      }
+
+      /* In the brief time we released the pollset locks above, the worker MAY
+         have been kicked. In this case, the worker should get out of this
+         pollset ASAP and hence this should neither add the pollset to
+         neighborhood nor mark the pollset as active. */
+      if (worker->state == UNKICKED) {
+        pollset->seen_inactive = false;
+        if (neighborhood->active_root == nullptr) {
+          neighborhood->active_root = pollset->next = pollset->prev = pollset;
+          /* Make this the designated poller if there isn't one already */
+          if (worker->state == UNKICKED &&
+              gpr_atm_no_barrier_cas(&g_active_poller, 0,
+                                     reinterpret_cast<gpr_atm>(worker))) {
+            SET_KICK_STATE(worker, DESIGNATED_POLLER);
+          }
+        } else {
+          pollset->next = neighborhood->active_root;
+          pollset->prev = pollset->next->prev;
+          pollset->next->prev = pollset->prev->next = pollset;
+        }
+      }
+    }
+    if (is_reassigning) {
+      GPR_ASSERT(pollset->reassigning_neighborhood);
+      pollset->reassigning_neighborhood = false;
+    }
+    gpr_mu_unlock(&neighborhood->mu);
+  }
+
+  worker_insert(pollset, worker);
+  pollset->begin_refs--;
+  if (worker->state == UNKICKED && !pollset->kicked_without_poller) {
+    GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
+    worker->initialized_cv = true;
+    gpr_cv_init(&worker->cv);
+    while (worker->state == UNKICKED && !pollset->shutting_down) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+        gpr_log(GPR_INFO, "PS:%p BEGIN_WAIT:%p kick_state=%s shutdown=%d",
+                pollset, worker, kick_state_string(worker->state),
+                pollset->shutting_down);
+      }
+
+      if (gpr_cv_wait(&worker->cv, &pollset->mu,
+                      grpc_millis_to_timespec(deadline, GPR_CLOCK_MONOTONIC)) &&
+          worker->state == UNKICKED) {
+        /* If gpr_cv_wait returns true (i.e a timeout), pretend that the worker
+           received a kick */
+        SET_KICK_STATE(worker, KICKED);
+      }
+    }
+    grpc_core::ExecCtx::Get()->InvalidateNow();
+  }
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO,
+            "PS:%p BEGIN_DONE:%p kick_state=%s shutdown=%d "
+            "kicked_without_poller: %d",
+            pollset, worker, kick_state_string(worker->state),
+            pollset->shutting_down, pollset->kicked_without_poller);
+  }
+
+  if (pollset->kicked_without_poller) {
+    pollset->kicked_without_poller = false;
+    return false;
+  }
+
+  return worker->state == DESIGNATED_POLLER && !pollset->shutting_down;
+}
+
+static bool check_neighborhood_for_available_poller(
+    pollset_neighborhood* neighborhood) {
+  GPR_TIMER_SCOPE("check_neighborhood_for_available_poller", 0);
+  bool found_worker = false;
+  do {
+    grpc_pollset* inspect = neighborhood->active_root;
+    if (inspect == nullptr) {
+      break;
+    }
+    gpr_mu_lock(&inspect->mu);
+    GPR_ASSERT(!inspect->seen_inactive);
+    grpc_pollset_worker* inspect_worker = inspect->root_worker;
+    if (inspect_worker != nullptr) {
+      do {
+        switch (inspect_worker->state) {
+          case UNKICKED:
+            if (gpr_atm_no_barrier_cas(
+                    &g_active_poller, 0,
+                    reinterpret_cast<gpr_atm>(inspect_worker))) {
+              if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+                gpr_log(GPR_INFO, " .. choose next poller to be %p",
+                        inspect_worker);
+              }
+              SET_KICK_STATE(inspect_worker, DESIGNATED_POLLER);
+              if (inspect_worker->initialized_cv) {
+                GPR_TIMER_MARK("signal worker", 0);
+                GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+                gpr_cv_signal(&inspect_worker->cv);
+              }
+            } else {
+              if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+                gpr_log(GPR_INFO, " .. beaten to choose next poller");
+              }
+            }
+            // even if we didn't win the cas, there's a worker, we can stop
+            found_worker = true;
+            break;
+          case KICKED:
+            break;
+          case DESIGNATED_POLLER:
+            found_worker = true;  // ok, so someone else found the worker, but
+                                  // we'll accept that
+            break;
+        }
+        inspect_worker = inspect_worker->next;
+      } while (!found_worker && inspect_worker != inspect->root_worker);
+    }
+    if (!found_worker) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+        gpr_log(GPR_INFO, " .. mark pollset %p inactive", inspect);
+      }
+      inspect->seen_inactive = true;
+      if (inspect == neighborhood->active_root) {
+        neighborhood->active_root =
+            inspect->next == inspect ? nullptr : inspect->next;
+      }
+      inspect->next->prev = inspect->prev;
+      inspect->prev->next = inspect->next;
+      inspect->next = inspect->prev = nullptr;
+    }
+    gpr_mu_unlock(&inspect->mu);
+  } while (!found_worker);
+  return found_worker;
+}
+
+static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
+                       grpc_pollset_worker** worker_hdl) {
+  GPR_TIMER_SCOPE("end_worker", 0);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "PS:%p END_WORKER:%p", pollset, worker);
+  }
+  if (worker_hdl != nullptr) *worker_hdl = nullptr;
+  /* Make sure we appear kicked */
+  SET_KICK_STATE(worker, KICKED);
+  grpc_closure_list_move(&worker->schedule_on_end_work,
+                         grpc_core::ExecCtx::Get()->closure_list());
+  if (gpr_atm_no_barrier_load(&g_active_poller) ==
+      reinterpret_cast<gpr_atm>(worker)) {
+    if (worker->next != worker && worker->next->state == UNKICKED) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+        gpr_log(GPR_INFO, " .. choose next poller to be peer %p", worker);
+      }
+      GPR_ASSERT(worker->next->initialized_cv);
+      gpr_atm_no_barrier_store(&g_active_poller, (gpr_atm)worker->next);
+      SET_KICK_STATE(worker->next, DESIGNATED_POLLER);
+      GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+      gpr_cv_signal(&worker->next->cv);
+      if (grpc_core::ExecCtx::Get()->HasWork()) {
+        gpr_mu_unlock(&pollset->mu);
+        grpc_fd_flush_exec_ctx_batching_writes();
+        gpr_mu_lock(&pollset->mu);
+      }
+    } else {
+      gpr_atm_no_barrier_store(&g_active_poller, 0);
+      size_t poller_neighborhood_idx =
+          static_cast<size_t>(pollset->neighborhood - g_neighborhoods);
+      gpr_mu_unlock(&pollset->mu);
+      bool found_worker = false;
+      bool scan_state[MAX_NEIGHBORHOODS];
+      for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
+        pollset_neighborhood* neighborhood =
+            &g_neighborhoods[(poller_neighborhood_idx + i) %
+                             g_num_neighborhoods];
+        if (gpr_mu_trylock(&neighborhood->mu)) {
+          found_worker = check_neighborhood_for_available_poller(neighborhood);
+          gpr_mu_unlock(&neighborhood->mu);
+          scan_state[i] = true;
+        } else {
+          scan_state[i] = false;
+        }
+      }
+      for (size_t i = 0; !found_worker && i < g_num_neighborhoods; i++) {
+        if (scan_state[i]) continue;
+        pollset_neighborhood* neighborhood =
+            &g_neighborhoods[(poller_neighborhood_idx + i) %
+                             g_num_neighborhoods];
+        gpr_mu_lock(&neighborhood->mu);
+        found_worker = check_neighborhood_for_available_poller(neighborhood);
+        gpr_mu_unlock(&neighborhood->mu);
+      }
+      grpc_fd_flush_exec_ctx_batching_writes();
+      gpr_mu_lock(&pollset->mu);
+    }
+  } else if (grpc_core::ExecCtx::Get()->HasWork()) {
+    gpr_mu_unlock(&pollset->mu);
+    grpc_fd_flush_exec_ctx_batching_writes();
+    gpr_mu_lock(&pollset->mu);
+  }
+  if (worker->initialized_cv) {
+    gpr_cv_destroy(&worker->cv);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, " .. remove worker");
+  }
+  if (EMPTIED == worker_remove(pollset, worker)) {
+    pollset_maybe_finish_shutdown(pollset);
+  }
+  GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
+}
+
+/* pollset->po.mu lock must be held by the caller before calling this.
+   The function pollset_work() may temporarily release the lock (pollset->po.mu)
+   during the course of its execution but it will always re-acquire the lock and
+   ensure that it is held by the time the function returns */
+static grpc_error_handle pollset_work(grpc_pollset* ps,
+                                      grpc_pollset_worker** worker_hdl,
+                                      grpc_millis deadline) {
+  GPR_TIMER_SCOPE("pollset_work", 0);
+  grpc_pollset_worker worker;
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  static const char* err_desc = "pollset_work";
+  if (ps->kicked_without_poller) {
+    ps->kicked_without_poller = false;
+    return GRPC_ERROR_NONE;
+  }
+
+  if (begin_worker(ps, &worker, worker_hdl, deadline)) {
+    g_current_thread_pollset = ps;
+    g_current_thread_worker = &worker;
+    GPR_ASSERT(!ps->shutting_down);
+    GPR_ASSERT(!ps->seen_inactive);
+
+    gpr_mu_unlock(&ps->mu); /* unlock */
+    /* As in the epoll1 engine, completions left over from a previous
+       io_uring_enter() are processed before entering the kernel again, so that
+       the handling of a large batch is spread across pollers. */
+    if (gpr_atm_acq_load(&g_uring_set.cursor) ==
+        gpr_atm_acq_load(&g_uring_set.num_events)) {
+      append_error(&error, do_uring_wait(ps, deadline), err_desc);
+    }
+    append_error(&error, process_uring_events(ps), err_desc);
+
+    gpr_mu_lock(&ps->mu); /* lock */
+
+    g_current_thread_worker = nullptr;
+  } else {
+    g_current_thread_pollset = ps;
+  }
+  end_worker(ps, &worker, worker_hdl);
+
+  g_current_thread_pollset = nullptr;
+  return error;
+}
+
+static grpc_error_handle pollset_kick(grpc_pollset* pollset,
+                                      grpc_pollset_worker* specific_worker) {
+  GPR_TIMER_SCOPE("pollset_kick", 0);
+  GRPC_STATS_INC_POLLSET_KICK();
+  grpc_error_handle ret_err = GRPC_ERROR_NONE;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+    std::vector<std::string> log;
+    log.push_back(absl::StrFormat(
+        "PS:%p KICK:%p curps=%p curworker=%p root=%p", pollset, specific_worker,
+        static_cast<void*>(g_current_thread_pollset),
+        static_cast<void*>(g_current_thread_worker), pollset->root_worker));
+    if (pollset->root_worker != nullptr) {
+      log.push_back(absl::StrFormat(
+          " {kick_state=%s next=%p {kick_state=%s}}",
+          kick_state_string(pollset->root_worker->state),
+          pollset->root_worker->next,
+          kick_state_string(pollset->root_worker->next->state)));
+    }
+    if (specific_worker != nullptr) {
+      log.push_back(absl::StrFormat(" worker_kick_state=%s",
+                                    kick_state_string(specific_worker->state)));
+    }
+    gpr_log(GPR_DEBUG, "%s", absl::StrJoin(log, "").c_str());
+  }
+
+  if (specific_worker == nullptr) {
+    if (g_current_thread_pollset != pollset) {
+      grpc_pollset_worker* root_worker = pollset->root_worker;
+      if (root_worker == nullptr) {
+        GRPC_STATS_INC_POLLSET_KICKED_WITHOUT_POLLER();
+        pollset->kicked_without_poller = true;
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. kicked_without_poller");
+        }
+        goto done;
+      }
+      grpc_pollset_worker* next_worker = root_worker->next;
+      if (root_worker->state == KICKED) {
+        GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. already kicked %p", root_worker);
+        }
+        SET_KICK_STATE(root_worker, KICKED);
+        goto done;
+      } else if (next_worker->state == KICKED) {
+        GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. already kicked %p", next_worker);
+        }
+        SET_KICK_STATE(next_worker, KICKED);
+        goto done;
+      } else if (root_worker == next_worker &&  // only try and wake up a poller
+                                                // if there is no next worker
+                 root_worker ==
+                     reinterpret_cast<grpc_pollset_worker*>(
+                         gpr_atm_no_barrier_load(&g_active_poller))) {
+        GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. kicked %p", root_worker);
+        }
+        SET_KICK_STATE(root_worker, KICKED);
+        ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+        goto done;
+      } else if (next_worker->state == UNKICKED) {
+        GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+          gpr_log(GPR_INFO, " .. kicked %p", next_worker);
+        }
+        GPR_ASSERT(next_worker->initialized_cv);
+        SET_KICK_STATE(next_worker, KICKED);
+        gpr_cv_signal(&next_worker->cv);
+        goto done;
+      } else if (next_worker->state == DESIGNATED_POLLER) {
+        if (root_worker->state != DESIGNATED_POLLER) {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+            gpr_log(
+                GPR_INFO,
+                " .. kicked root non-poller %p (initialized_cv=%d) (poller=%p)",
+                root_worker, root_worker->initialized_cv, next_worker);
+          }
+          SET_KICK_STATE(root_worker, KICKED);
+          if (root_worker->initialized_cv) {
+            GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+            gpr_cv_signal(&root_worker->cv);
+          }
+          goto done;
+        } else {
+          GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+            gpr_log(GPR_INFO, " .. non-root poller %p (root=%p)", next_worker,
+                    root_worker);
+          }
+          SET_KICK_STATE(next_worker, KICKED);
+          ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+          goto done;
+        }
+      } else {
+        GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+        GPR_ASSERT(next_worker->state == KICKED);
+        SET_KICK_STATE(next_worker, KICKED);
+        goto done;
+      }
+    } else {
+      GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD();
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+        gpr_log(GPR_INFO, " .. kicked while waking up");
+      }
+      goto done;
+    }
+
+    GPR_UNREACHABLE_CODE(goto done);
+  }
+
+  if (specific_worker->state == KICKED) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. specific worker already kicked");
+    }
+    goto done;
+  } else if (g_current_thread_worker == specific_worker) {
+    GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. mark %p kicked", specific_worker);
+    }
+    SET_KICK_STATE(specific_worker, KICKED);
+    goto done;
+  } else if (specific_worker ==
+             reinterpret_cast<grpc_pollset_worker*>(
+                 gpr_atm_no_barrier_load(&g_active_poller))) {
+    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. kick active poller");
+    }
+    SET_KICK_STATE(specific_worker, KICKED);
+    ret_err = grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+    goto done;
+  } else if (specific_worker->initialized_cv) {
+    GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. kick waiting worker");
+    }
+    SET_KICK_STATE(specific_worker, KICKED);
+    gpr_cv_signal(&specific_worker->cv);
+    goto done;
+  } else {
+    GRPC_STATS_INC_POLLSET_KICKED_AGAIN();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
+      gpr_log(GPR_INFO, " .. kick non-waiting worker");
+    }
+    SET_KICK_STATE(specific_worker, KICKED);
+    goto done;
+  }
+done:
+  return ret_err;
+}
+
+static void pollset_add_fd(grpc_pollset* /*pollset*/, grpc_fd* /*fd*/) {}
+
+/*******************************************************************************
+ * Pollset-set Definitions
+ */
+
+static grpc_pollset_set* pollset_set_create(void) {
+  return reinterpret_cast<grpc_pollset_set*>(static_cast<intptr_t>(0xdeafbeef));
+}
+
+static void pollset_set_destroy(grpc_pollset_set* /*pss*/) {}
+
+static void pollset_set_add_fd(grpc_pollset_set* /*pss*/, grpc_fd* /*fd*/) {}
+
+static void pollset_set_del_fd(grpc_pollset_set* /*pss*/, grpc_fd* /*fd*/) {}
+
+static void pollset_set_add_pollset(grpc_pollset_set* /*pss*/,
+                                    grpc_pollset* /*ps*/) {}
+
+static void pollset_set_del_pollset(grpc_pollset_set* /*pss*/,
+                                    grpc_pollset* /*ps*/) {}
+
+static void pollset_set_add_pollset_set(grpc_pollset_set* /*bag*/,
+                                        grpc_pollset_set* /*item*/) {}
+
+static void pollset_set_del_pollset_set(grpc_pollset_set* /*bag*/,
+                                        grpc_pollset_set* /*item*/) {}
+
+/*******************************************************************************
+ * Event engine binding
+ */
+
+static bool is_any_background_poller_thread(void) { return false; }
+
+static void shutdown_background_closure(void) {}
+
+static bool add_closure_to_background_poller(grpc_closure* /*closure*/,
+                                             grpc_error_handle /*error*/) {
+  return false;
+}
+
+static void shutdown_engine(void) {
+  fd_global_shutdown();
+  pollset_global_shutdown();
+  uring_set_shutdown(&g_uring_set);
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_destroy(&fork_fd_list_mu);
+    grpc_core::Fork::SetResetChildPollingEngineFunc(nullptr);
+  }
+}
+
+static const grpc_event_engine_vtable vtable = {
+    sizeof(grpc_pollset),
+    true,
+    false,
+
+    fd_create,
+    fd_wrapped_fd,
+    fd_orphan,
+    fd_shutdown,
+    fd_notify_on_read,
+    fd_notify_on_write,
+    fd_notify_on_error,
+    fd_become_readable,
+    fd_become_writable,
+    fd_has_errors,
+    fd_is_shutdown,
+    fd_set_write_batching,
+
+    pollset_init,
+    pollset_shutdown,
+    pollset_destroy,
+    pollset_work,
+    pollset_kick,
+    pollset_add_fd,
+
+    pollset_set_create,
+    pollset_set_destroy,
+    pollset_set_add_pollset,
+    pollset_set_del_pollset,
+    pollset_set_add_pollset_set,
+    pollset_set_del_pollset_set,
+    pollset_set_add_fd,
+    pollset_set_del_fd,
+
+    is_any_background_poller_thread,
+    shutdown_background_closure,
+    shutdown_engine,
+    add_closure_to_background_poller,
+};
+
+/* Called by the child process's post-fork handler to close open fds, including
+ * the global io_uring fd. This allows gRPC to shutdown in the child process
+ * without interfering with connections or RPCs ongoing in the parent. */
+static void reset_event_manager_on_fork() {
+  gpr_mu_lock(&fork_fd_list_mu);
+  while (fork_fd_list_head != nullptr) {
+    close(fork_fd_list_head->fd);
+    fork_fd_list_head->fd = -1;
+    fork_fd_list_head = fork_fd_list_head->fork_fd_list->next;
+  }
+  gpr_mu_unlock(&fork_fd_list_mu);
+  shutdown_engine();
+  grpc_init_io_uring_linux(true);
+}
+
+/* io_uring is frequently disabled by seccomp profiles and sysctls, and its
+ * behavior under heavy load is still less battle tested than epoll's, so this
+ * engine is never picked implicitly: it has to be requested by name. */
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(
+    bool explicit_request) {
+  if (!explicit_request) {
+    return nullptr;
+  }
+
+  if (!grpc_has_wakeup_fd()) {
+    gpr_log(GPR_ERROR, "Skipping io_uring because of no wakeup fd.");
+    return nullptr;
+  }
+
+  if (!uring_set_init(&g_uring_set, URING_SQ_ENTRIES)) {
+    return nullptr;
+  }
+
+  fd_global_init();
+
+  if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
+    fd_global_shutdown();
+    pollset_global_shutdown();
+    uring_set_shutdown(&g_uring_set);
+    return nullptr;
+  }
+
+  if (grpc_core::Fork::Enabled()) {
+    gpr_mu_init(&fork_fd_list_mu);
+    grpc_core::Fork::SetResetChildPollingEngineFunc(
+        reset_event_manager_on_fork);
+  }
+  return &vtable;
+}
+
+/*******************************************************************************
+ * Batched sends
+ */
+
+/* Writes batched by grpc_fd_flush_exec_ctx_batching_writes() go through a ring
+   of their own rather than the poller's: the submitting thread reaps their
+   completions straight away, so they must never reach a designated poller.
+   This ring does not depend on the io_uring polling engine being in use. */
+#define URING_SEND_ENTRIES 256
+
+static uring_set g_uring_send_set;
+static gpr_once g_uring_send_once = GPR_ONCE_INIT;
+static bool g_uring_send_available = false;
+
+static void uring_send_set_init() {
+  g_uring_send_available =
+      uring_set_init(&g_uring_send_set, URING_SEND_ENTRIES);
+}
+
+/* Stores the result of every completed send in its op and returns the number
+   of completions reaped. sq_mu must be held. */
+static unsigned uring_send_reap(uring_set* set) {
+  unsigned head = *set->cq_khead;
+  unsigned tail = __atomic_load_n(set->cq_ktail, __ATOMIC_ACQUIRE);
+  unsigned n = 0;
+  for (; head != tail; head++, n++) {
+    const struct io_uring_cqe* cqe = &set->cqes[head & set->cq_ring_mask];
+    grpc_fd_sendmsg_op* op = reinterpret_cast<grpc_fd_sendmsg_op*>(
+        static_cast<uintptr_t>(cqe->user_data));
+    op->result = cqe->res < 0 ? -1 : cqe->res;
+    op->err = cqe->res < 0 ? -cqe->res : 0;
+  }
+  __atomic_store_n(set->cq_khead, head, __ATOMIC_RELEASE);
+  return n;
+}
+
+size_t grpc_io_uring_sendmsg_batch(grpc_fd_sendmsg_op* ops, size_t* syscalls) {
+  *syscalls = 0;
+  /* A forked child would share the ring memory with its parent */
+  if (grpc_core::Fork::Enabled()) return 0;
+  gpr_once_init(&g_uring_send_once, uring_send_set_init);
+  if (!g_uring_send_available) return 0;
+
+  uring_set* set = &g_uring_send_set;
+  size_t done = 0;
+  gpr_mu_lock(&set->sq_mu);
+  while (ops != nullptr) {
+    unsigned queued = 0;
+    for (grpc_fd_sendmsg_op* op = ops;
+         op != nullptr && queued < set->sq_ring_entries; op = op->next) {
+      unsigned tail;
+      struct io_uring_sqe* sqe = uring_get_sqe(set, &tail);
+      sqe->opcode = IORING_OP_SENDMSG;
+      sqe->fd = op->fd;
+      sqe->addr = reinterpret_cast<uint64_t>(op->msg);
+      sqe->len = 1;
+      /* MSG_DONTWAIT fails a send to a full socket with EAGAIN instead of
+         parking it until the socket drains, so every send completes within
+         the io_uring_enter() that submits it. */
+      sqe->msg_flags = static_cast<uint32_t>(op->flags | MSG_DONTWAIT);
+      sqe->user_data = reinterpret_cast<uint64_t>(op);
+      uring_sq_commit(set, tail);
+      queued++;
+    }
+    const unsigned chunk = queued;
+    unsigned submitted = 0;
+    unsigned completed = 0;
+    while (completed < queued) {
+      int r = sys_io_uring_enter(set->ring_fd, queued - submitted,
+                                 queued - completed, IORING_ENTER_GETEVENTS,
+                                 nullptr, 0);
+      ++*syscalls;
+      if (r >= 0) {
+        submitted += static_cast<unsigned>(r);
+      } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY &&
+                 submitted < queued) {
+        /* The kernel refused the remaining sends: take them back and leave
+           them to the caller. The kernel consumes requests in order, so they
+           are exactly the ops past the submitted ones. */
+        gpr_log(GPR_ERROR, "io_uring_enter(sendmsg) failed: %s",
+                strerror(errno));
+        __atomic_store_n(set->sq_ktail,
+                         __atomic_load_n(set->sq_khead, __ATOMIC_ACQUIRE),
+                         __ATOMIC_RELEASE);
+        queued = submitted;
+      }
+      completed += uring_send_reap(set);
+    }
+    done += queued;
+    for (unsigned i = 0; i < queued; i++) ops = ops->next;
+    if (queued < chunk) break;
+  }
+  gpr_mu_unlock(&set->sq_mu);
+  return done;
+}
+
+#else /* defined(GRPC_LINUX_IO_URING) && defined(IORING_POLL_ADD_MULTI) ... */
+#if defined(GRPC_POSIX_SOCKET_EV_IO_URING)
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
+/* If io_uring (or a recent enough version of its uapi header) is not
+ * available, return NULL */
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(
+    bool /*explicit_request*/) {
+  return nullptr;
+}
+
+size_t grpc_io_uring_sendmsg_batch(grpc_fd_sendmsg_op* /*ops*/,
+                                   size_t* syscalls) {
+  *syscalls = 0;
+  return 0;
+}
+#endif /* defined(GRPC_POSIX_SOCKET_EV_IO_URING) */
+#endif /* !(defined(GRPC_LINUX_IO_URING) && defined(IORING_POLL_ADD_MULTI)) */
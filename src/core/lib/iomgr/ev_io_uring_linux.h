@@ -0,0 +1,41 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_EV_IO_URING_LINUX_H
+#define GRPC_CORE_LIB_IOMGR_EV_IO_URING_LINUX_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/port.h"
+
+// a polling engine that utilizes a singleton io_uring instance with multishot
+// poll requests and turnstile polling. Only used when explicitly requested via
+// GRPC_POLL_STRATEGY=io_uring. It replaces epoll_wait() and epoll_ctl() only:
+// endpoints still read, write and accept with their own syscalls.
+
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(bool explicit_request);
+
+// Sends the list of batched writes starting at ops through a dedicated
+// io_uring, whichever polling engine is in use. Returns how many ops from the
+// head of the list were sent (the caller sends the rest itself, so 0 means
+// io_uring is unavailable) and stores the number of io_uring_enter() calls
+// made in *syscalls.
+size_t grpc_io_uring_sendmsg_batch(grpc_fd_sendmsg_op* ops, size_t* syscalls);
+
+#endif /* GRPC_CORE_LIB_IOMGR_EV_IO_URING_LINUX_H */
@@ -1364,6 +1364,7 @@ static const grpc_event_engine_vtable vtable = {
     fd_set_writable,
     fd_set_error,
     fd_is_shutdown,
+    nullptr, /* fd_set_write_batching */
 
     pollset_init,
     pollset_shutdown,
@@ -22,17 +22,22 @@
 
 #ifdef GRPC_POSIX_SOCKET_EV
 
+#include <errno.h>
 #include <string.h>
+#include <sys/socket.h>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
 #include "src/core/lib/iomgr/ev_epollex_linux.h"
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
 #include "src/core/lib/iomgr/ev_poll_posix.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/internal_errqueue.h"
@@ -126,12 +131,19 @@ const grpc_event_engine_vtable* init_non_polling(bool explicit_request) {
 // environment variable if that variable is set (which should be a
 // comma-separated list of one or more event engine names)
 static event_engine_factory g_factories[] = {
-    {ENGINE_HEAD_CUSTOM, nullptr},        {ENGINE_HEAD_CUSTOM, nullptr},
-    {ENGINE_HEAD_CUSTOM, nullptr},        {ENGINE_HEAD_CUSTOM, nullptr},
-    {"epollex", grpc_init_epollex_linux}, {"epoll1", grpc_init_epoll1_linux},
-    {"poll", grpc_init_poll_posix},       {"none", init_non_polling},
-    {ENGINE_TAIL_CUSTOM, nullptr},        {ENGINE_TAIL_CUSTOM, nullptr},
-    {ENGINE_TAIL_CUSTOM, nullptr},        {ENGINE_TAIL_CUSTOM, nullptr},
+    {ENGINE_HEAD_CUSTOM, nullptr},
+    {ENGINE_HEAD_CUSTOM, nullptr},
+    {ENGINE_HEAD_CUSTOM, nullptr},
+    {ENGINE_HEAD_CUSTOM, nullptr},
+    {"epollex", grpc_init_epollex_linux},
+    {"epoll1", grpc_init_epoll1_linux},
+    {"poll", grpc_init_poll_posix},
+    {"io_uring", grpc_init_io_uring_linux},
+    {"none", init_non_polling},
+    {ENGINE_TAIL_CUSTOM, nullptr},
+    {ENGINE_TAIL_CUSTOM, nullptr},
+    {ENGINE_TAIL_CUSTOM, nullptr},
+    {ENGINE_TAIL_CUSTOM, nullptr},
 };
 
 static void add(const char* beg, const char* end, char*** ss, size_t* ns) {
@@ -414,4 +426,89 @@ void grpc_shutdown_background_closure(void) {
   g_event_engine->shutdown_background_closure();
 }
 
+/*******************************************************************************
+ * Batched writes
+ */
+
+typedef struct fd_write_batch {
+  grpc_fd_sendmsg_op* head;
+  grpc_fd_sendmsg_op* tail;
+  size_t count;
+} fd_write_batch;
+
+/* The batch of the poller round running on this thread, if any */
+static GPR_THREAD_LOCAL(fd_write_batch*) g_write_batch;
+
+void grpc_fd_set_write_batching(grpc_fd* fd) {
+  if (g_event_engine->fd_set_write_batching != nullptr) {
+    g_event_engine->fd_set_write_batching(fd);
+  }
+}
+
+bool grpc_fd_queue_sendmsg(grpc_fd_sendmsg_op* op) {
+  fd_write_batch* batch = g_write_batch;
+  if (batch == nullptr) return false;
+  op->next = nullptr;
+  if (batch->tail == nullptr) {
+    batch->head = op;
+  } else {
+    batch->tail->next = op;
+  }
+  batch->tail = op;
+  batch->count++;
+  return true;
+}
+
+/* Sends every write queued on batch and schedules their on_done closures.
+   Returns false if there was nothing to send. */
+static bool fd_write_batch_send(fd_write_batch* batch) {
+  grpc_fd_sendmsg_op* op = batch->head;
+  if (op == nullptr) return false;
+  size_t count = batch->count;
+  batch->head = batch->tail = nullptr;
+  batch->count = 0;
+
+  size_t syscalls = 0;
+  size_t sent = 0;
+  /* A lone write gains nothing from going through io_uring */
+  if (count > 1) sent = grpc_io_uring_sendmsg_batch(op, &syscalls);
+  for (size_t i = 0; i < syscalls; i++) {
+    GRPC_STATS_INC_SYSCALL_WRITE();
+  }
+  while (op != nullptr) {
+    /* on_done may queue op again, so step past it before scheduling */
+    grpc_fd_sendmsg_op* next = op->next;
+    if (sent > 0) {
+      sent--;
+    } else {
+      GRPC_STATS_INC_SYSCALL_WRITE();
+      syscalls++;
+      do {
+        op->result = sendmsg(op->fd, op->msg, op->flags);
+      } while (op->result < 0 && errno == EINTR);
+      op->err = op->result < 0 ? errno : 0;
+    }
+    GRPC_STATS_INC_TCP_BATCHED_WRITES();
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, op->on_done, GRPC_ERROR_NONE);
+    op = next;
+  }
+  for (size_t i = 0; i < syscalls; i++) {
+    GRPC_STATS_INC_TCP_BATCHED_WRITE_SYSCALLS();
+  }
+  return true;
+}
+
+void grpc_fd_flush_exec_ctx_batching_writes(void) {
+  /* A nested flush (a closure polling for something) sends whatever the outer
+     one has queued so far too: it may be what the closure waits on. */
+  fd_write_batch batch = {nullptr, nullptr, 0};
+  fd_write_batch* outer = g_write_batch;
+  fd_write_batch* current = outer == nullptr ? &batch : outer;
+  g_write_batch = current;
+  do {
+    grpc_core::ExecCtx::Get()->Flush();
+  } while (fd_write_batch_send(current));
+  g_write_batch = outer;
+}
+
 #endif  // GRPC_POSIX_SOCKET_EV
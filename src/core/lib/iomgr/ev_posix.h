@@ -22,6 +22,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <poll.h>
+#include <sys/types.h>
 
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/global_config.h"
@@ -60,6 +61,8 @@ typedef struct grpc_event_engine_vtable {
   void (*fd_set_writable)(grpc_fd* fd);
   void (*fd_set_error)(grpc_fd* fd);
   bool (*fd_is_shutdown)(grpc_fd* fd);
+  /* Null for engines that do not group the events of batching fds */
+  void (*fd_set_write_batching)(grpc_fd* fd);
 
   void (*pollset_init)(grpc_pollset* pollset, gpr_mu** mu);
   void (*pollset_shutdown)(grpc_pollset* pollset, grpc_closure* closure);
@@ -200,6 +203,40 @@ bool grpc_add_closure_to_background_poller(grpc_closure* closure,
 /* Shut down all the closures registered in the background poller. */
 void grpc_shutdown_background_closure();
 
+/* Batched writes.
+   While a poller thread runs the closures of one polling round, endpoints may
+   queue their sendmsg() calls instead of issuing them one at a time. Once the
+   round's closures have run, everything queued is sent with as few syscalls
+   as the platform allows (one io_uring submission where available), each
+   op's result is filled in and its on_done closure is scheduled. */
+typedef struct grpc_fd_sendmsg_op {
+  int fd;
+  /* Must stay valid until on_done runs */
+  struct msghdr* msg;
+  int flags;
+  /* Filled in before on_done is scheduled: the sendmsg() return value, and
+     errno when it is negative */
+  ssize_t result;
+  int err;
+  grpc_closure* on_done;
+  struct grpc_fd_sendmsg_op* next;
+} grpc_fd_sendmsg_op;
+
+/* Queues op on the calling thread's write batch. Returns false, without
+   taking op, if the calling thread is not batching writes. */
+bool grpc_fd_queue_sendmsg(grpc_fd_sendmsg_op* op);
+
+/* Called by endpoints that batch their writes on fd. Pollers handle the
+   events of such fds in one go, rather than spreading them across worker
+   threads, so that the writes they trigger share a batch. Events of other fds
+   are handed out as usual. */
+void grpc_fd_set_write_batching(grpc_fd* fd);
+
+/* Flushes the current ExecCtx, batching the writes issued by its closures.
+   Used by polling engines in place of ExecCtx::Flush() once a round of events
+   has been queued. */
+void grpc_fd_flush_exec_ctx_batching_writes();
+
 /* override to allow tests to hook poll() usage */
 typedef int (*grpc_poll_function_type)(struct pollfd*, nfds_t, int);
 extern grpc_poll_function_type grpc_poll_function;
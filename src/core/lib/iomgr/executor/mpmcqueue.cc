@@ -20,6 +20,8 @@
 
 #include "src/core/lib/iomgr/executor/mpmcqueue.h"
 
+#include <thread>
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_thread_pool_trace(false, "thread_pool");
@@ -179,4 +181,195 @@ void InfLenFIFOQueue::RemoveWaiter(Waiter* waiter) {
 
 InfLenFIFOQueue::Waiter* InfLenFIFOQueue::TopWaiter() { return waiters_.next; }
 
+//
+// LockFreeFIFOQueue
+//
+
+constexpr size_t LockFreeFIFOQueue::kShift;
+constexpr size_t LockFreeFIFOQueue::kHasNext;
+constexpr size_t LockFreeFIFOQueue::kLap;
+constexpr size_t LockFreeFIFOQueue::kBlockCap;
+constexpr uintptr_t LockFreeFIFOQueue::kWrite;
+constexpr uintptr_t LockFreeFIFOQueue::kRead;
+constexpr uintptr_t LockFreeFIFOQueue::kDestroy;
+
+LockFreeFIFOQueue::Block* LockFreeFIFOQueue::Block::WaitNext() {
+  while (true) {
+    Block* block = next.load(std::memory_order_acquire);
+    if (block != nullptr) return block;
+    std::this_thread::yield();
+  }
+}
+
+void LockFreeFIFOQueue::Block::Destroy(Block* block, size_t start) {
+  // The reader of the last slot is the one that starts destruction, so it
+  // need not be checked.
+  for (size_t i = start; i < kBlockCap - 1; ++i) {
+    Slot& slot = block->slots[i];
+    if ((slot.state.load(std::memory_order_acquire) & kRead) == 0 &&
+        (slot.state.fetch_or(kDestroy, std::memory_order_acq_rel) & kRead) ==
+            0) {
+      return;
+    }
+  }
+  delete block;
+}
+
+LockFreeFIFOQueue::~LockFreeFIFOQueue() {
+  GPR_ASSERT(count_.load(std::memory_order_relaxed) == 0);
+  // Only the block holding the head index can remain.
+  delete head_.block.load(std::memory_order_relaxed);
+}
+
+void LockFreeFIFOQueue::Put(void* elem) {
+  count_.fetch_add(1, std::memory_order_relaxed);
+  Push(elem);
+  // Pairs with Get(): either it sees the element, or we see it sleeping.
+  if (num_sleepers_.load(std::memory_order_seq_cst) > 0) {
+    MutexLock lock(&mu_);
+    cv_.Signal();
+  }
+}
+
+void* LockFreeFIFOQueue::Get(gpr_timespec* wait_time) {
+  void* elem;
+  if (TryPop(&elem)) {
+    count_.fetch_sub(1, std::memory_order_relaxed);
+    return elem;
+  }
+  gpr_timespec start_time;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace) && wait_time != nullptr) {
+    start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  }
+  {
+    MutexLock lock(&mu_);
+    num_sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    while (!TryPop(&elem)) {
+      cv_.Wait(&mu_);
+    }
+    num_sleepers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace) && wait_time != nullptr) {
+    *wait_time = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_time);
+  }
+  count_.fetch_sub(1, std::memory_order_relaxed);
+  return elem;
+}
+
+void LockFreeFIFOQueue::Push(void* elem) {
+  size_t tail = tail_.index.load(std::memory_order_acquire);
+  Block* block = tail_.block.load(std::memory_order_acquire);
+  Block* next_block = nullptr;
+  while (true) {
+    const size_t offset = (tail >> kShift) % kLap;
+    // Another producer filled the block and is installing the next one.
+    if (offset == kBlockCap) {
+      std::this_thread::yield();
+      tail = tail_.index.load(std::memory_order_acquire);
+      block = tail_.block.load(std::memory_order_acquire);
+      continue;
+    }
+    // If we are about to fill the block, allocate the next one in advance so
+    // that other producers wait as briefly as possible.
+    if (offset + 1 == kBlockCap && next_block == nullptr) {
+      next_block = new Block();
+    }
+    // The very first Put() installs the first block.
+    if (block == nullptr) {
+      Block* new_block = new Block();
+      if (tail_.block.compare_exchange_strong(block, new_block,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+        head_.block.store(new_block, std::memory_order_release);
+        block = new_block;
+      } else {
+        delete new_block;
+        tail = tail_.index.load(std::memory_order_acquire);
+        block = tail_.block.load(std::memory_order_acquire);
+        continue;
+      }
+    }
+    const size_t new_tail = tail + (1 << kShift);
+    if (tail_.index.compare_exchange_weak(tail, new_tail,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_acquire)) {
+      // We claimed the last slot of the block: install the next one.
+      if (offset + 1 == kBlockCap) {
+        const size_t next_index = new_tail + (1 << kShift);
+        tail_.block.store(next_block, std::memory_order_release);
+        tail_.index.store(next_index, std::memory_order_release);
+        block->next.store(next_block, std::memory_order_release);
+        next_block = nullptr;
+      }
+      Slot& slot = block->slots[offset];
+      slot.elem = elem;
+      slot.state.fetch_or(kWrite, std::memory_order_release);
+      delete next_block;
+      return;
+    }
+    block = tail_.block.load(std::memory_order_acquire);
+  }
+}
+
+bool LockFreeFIFOQueue::TryPop(void** elem) {
+  size_t head = head_.index.load(std::memory_order_acquire);
+  Block* block = head_.block.load(std::memory_order_acquire);
+  while (true) {
+    const size_t offset = (head >> kShift) % kLap;
+    // Another consumer emptied the block and is moving to the next one.
+    if (offset == kBlockCap) {
+      std::this_thread::yield();
+      head = head_.index.load(std::memory_order_acquire);
+      block = head_.block.load(std::memory_order_acquire);
+      continue;
+    }
+    size_t new_head = head + (1 << kShift);
+    if ((new_head & kHasNext) == 0) {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const size_t tail = tail_.index.load(std::memory_order_relaxed);
+      // Queue is empty.
+      if ((head >> kShift) == (tail >> kShift)) return false;
+      // Head and tail are in different blocks.
+      if ((head >> kShift) / kLap != (tail >> kShift) / kLap) {
+        new_head |= kHasNext;
+      }
+    }
+    // The first block is still being installed.
+    if (block == nullptr) {
+      std::this_thread::yield();
+      head = head_.index.load(std::memory_order_acquire);
+      block = head_.block.load(std::memory_order_acquire);
+      continue;
+    }
+    if (head_.index.compare_exchange_weak(head, new_head,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_acquire)) {
+      // We claimed the last slot of the block: move on to the next one.
+      if (offset + 1 == kBlockCap) {
+        Block* next = block->WaitNext();
+        size_t next_index = (new_head & ~kHasNext) + (1 << kShift);
+        if (next->next.load(std::memory_order_relaxed) != nullptr) {
+          next_index |= kHasNext;
+        }
+        head_.block.store(next, std::memory_order_release);
+        head_.index.store(next_index, std::memory_order_release);
+      }
+      // Wait for the producer that claimed the slot to write it.
+      Slot& slot = block->slots[offset];
+      while ((slot.state.load(std::memory_order_acquire) & kWrite) == 0) {
+        std::this_thread::yield();
+      }
+      *elem = slot.elem;
+      if (offset + 1 == kBlockCap) {
+        Block::Destroy(block, 0);
+      } else if ((slot.state.fetch_or(kRead, std::memory_order_acq_rel) &
+                  kDestroy) != 0) {
+        Block::Destroy(block, offset + 1);
+      }
+      return true;
+    }
+    block = head_.block.load(std::memory_order_acquire);
+  }
+}
+
 }  // namespace grpc_core
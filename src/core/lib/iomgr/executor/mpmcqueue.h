@@ -21,6 +21,9 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <atomic>
 
 #include "src/core/lib/debug/stats.h"
@@ -166,6 +169,87 @@ class InfLenFIFOQueue : public MPMCQueueInterface {
   Node* AllocateNodes(int num);
 };
 
+// An unbounded MPMC queue built from a linked list of fixed-size blocks of
+// slots. Put() and Get() claim slots with atomic operations on the tail and
+// head indices, so producers and consumers never serialize on a lock. The
+// mutex is only taken by consumers going to sleep on an empty queue, and by
+// producers when there is a sleeping consumer to wake up. Each block is freed
+// by the last consumer to leave it.
+class LockFreeFIFOQueue : public MPMCQueueInterface {
+ public:
+  LockFreeFIFOQueue() {}
+
+  // Releases all resources held by the queue. The queue must be empty, and no
+  // one waits on it.
+  ~LockFreeFIFOQueue() override;
+
+  // Puts elem into queue immediately at the end of queue. Since the queue has
+  // infinite length, this routine will never block and should never fail.
+  void Put(void* elem) override;
+
+  // Removes the oldest element from the queue and returns it.
+  // This routine will cause the thread to block if queue is currently empty.
+  // Argument wait_time should be passed in when trace flag turning on (for
+  // collecting stats info purpose.)
+  void* Get(gpr_timespec* wait_time) override;
+
+  // Returns number of elements in queue currently.
+  // There might be concurrently add/remove on queue, so count might change
+  // quickly.
+  int count() const override { return count_.load(std::memory_order_relaxed); }
+
+ private:
+  // Indices advance by 1 << kShift per slot; the lowest bit of the head index
+  // records that the head block is not the last one.
+  static constexpr size_t kShift = 1;
+  static constexpr size_t kHasNext = 1;
+  // Each lap of indices covers one block, plus one index that marks the block
+  // as full while the next one is being installed.
+  static constexpr size_t kLap = 64;
+  static constexpr size_t kBlockCap = kLap - 1;
+
+  // Slot states.
+  static constexpr uintptr_t kWrite = 1;    // Element has been written
+  static constexpr uintptr_t kRead = 2;     // Element has been read
+  static constexpr uintptr_t kDestroy = 4;  // Block is being destroyed
+
+  struct Slot {
+    void* elem = nullptr;
+    std::atomic<uintptr_t> state{0};
+  };
+
+  struct Block {
+    std::atomic<Block*> next{nullptr};
+    Slot slots[kBlockCap];
+
+    // Waits until the next block has been installed, and returns it.
+    Block* WaitNext();
+    // Frees block once every slot from start on has been read. If a slot is
+    // still being read, its reader finishes destruction instead.
+    static void Destroy(Block* block, size_t start);
+  };
+
+  struct Position {
+    std::atomic<size_t> index{0};
+    std::atomic<Block*> block{nullptr};
+  };
+
+  void Push(void* elem);
+  // Removes the oldest element into *elem. Returns false if queue is empty.
+  bool TryPop(void** elem);
+
+  // Keep consumers and producers off each other's cache lines.
+  Position head_;
+  char head_padding_[GPR_CACHELINE_SIZE];
+  Position tail_;
+  char tail_padding_[GPR_CACHELINE_SIZE];
+
+  std::atomic<int> count_{0};         // Number of elements in queue
+  std::atomic<int> num_sleepers_{0};  // Number of consumers waiting on cv_
+  Mutex mu_;
+  CondVar cv_;
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_MPMCQUEUE_H */
@@ -53,7 +53,14 @@ void ThreadPool::SharedThreadPoolConstructor() {
   // Create at least 1 worker thread.
   if (num_threads_ <= 0) num_threads_ = 1;
 
-  queue_ = new InfLenFIFOQueue();
+  switch (queue_type_) {
+    case ThreadPoolQueueType::kLocked:
+      queue_ = new InfLenFIFOQueue();
+      break;
+    case ThreadPoolQueueType::kLockFree:
+      queue_ = new LockFreeFIFOQueue();
+      break;
+  }
   threads_ = static_cast<ThreadPoolWorker**>(
       gpr_zalloc(num_threads_ * sizeof(ThreadPoolWorker*)));
   for (int i = 0; i < num_threads_; ++i) {
@@ -90,10 +97,12 @@ ThreadPool::ThreadPool(int num_threads, const char* thd_name)
 }
 
 ThreadPool::ThreadPool(int num_threads, const char* thd_name,
-                       const Thread::Options& thread_options)
+                       const Thread::Options& thread_options,
+                       ThreadPoolQueueType queue_type)
     : num_threads_(num_threads),
       thd_name_(thd_name),
-      thread_options_(thread_options) {
+      thread_options_(thread_options),
+      queue_type_(queue_type) {
   if (thread_options_.stack_size() == 0) {
     thread_options_.set_stack_size(DefaultStackSize());
   }
@@ -91,6 +91,15 @@ class ThreadPoolWorker {
   int index_;                  // Index in thread pool
 };
 
+// Implementation of the closure queue shared by the workers of a ThreadPool.
+enum class ThreadPoolQueueType {
+  // InfLenFIFOQueue: a single mutex protects the queue.
+  kLocked,
+  // LockFreeFIFOQueue: producers and consumers only contend on atomics, and
+  // take a lock only to sleep on, or wake a worker from, an empty queue.
+  kLockFree,
+};
+
 // A fixed size thread pool implementation of abstract thread pool interface.
 // In this implementation, the number of threads in pool is fixed, but the
 // capacity of closure queue is unlimited.
@@ -112,8 +121,10 @@ class ThreadPool : public ThreadPoolInterface {
   // value 0, default ThreadPool stack size will be used. The current default
   // stack size of this implementation is 1952K for mobile platform and 64K for
   // all others.
+  // queue_type selects the implementation of the closure queue.
   ThreadPool(int num_threads, const char* thd_name,
-             const Thread::Options& thread_options);
+             const Thread::Options& thread_options,
+             ThreadPoolQueueType queue_type = ThreadPoolQueueType::kLocked);
 
   // Waits for all pending closures to complete, then shuts down thread pool.
   ~ThreadPool() override;
@@ -131,6 +142,7 @@ class ThreadPool : public ThreadPoolInterface {
   int num_threads_ = 0;
   const char* thd_name_ = nullptr;
   Thread::Options thread_options_;
+  ThreadPoolQueueType queue_type_ = ThreadPoolQueueType::kLocked;
   ThreadPoolWorker** threads_ = nullptr;  // Array of worker threads
   MPMCQueueInterface* queue_ = nullptr;   // Closure queue
 
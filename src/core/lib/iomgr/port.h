@@ -52,6 +52,10 @@
 /* Linux has TCP_INQ support since 4.18, but it is safe to set
    the socket option on older kernels. */
 #define GRPC_HAVE_TCP_INQ 1
+/* Linux has TCP_ZEROCOPY_RECEIVE support since 4.18 (5.3 for the extended
+   struct used here); older kernels reject the socket option at runtime and
+   reads fall back to copying. */
+#define GRPC_HAVE_TCP_ZEROCOPY_RECEIVE 1
 #ifdef LINUX_VERSION_CODE
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
 #define GRPC_LINUX_ERRQUEUE 1
@@ -81,6 +85,13 @@
 #define GRPC_LINUX_TCP_H 1
 #endif /* __GLIBC_PREREQ(2, 17) */
 #endif
+#ifdef __has_include
+#if __has_include(<linux/io_uring.h>)
+/* Only the kernel uapi header is needed; the engine talks to the kernel through
+   raw syscalls, so liburing is not required. */
+#define GRPC_LINUX_IO_URING 1
+#endif
+#endif
 #ifndef __GLIBC__
 #define GRPC_LINUX_EPOLL 1
 #define GRPC_LINUX_EPOLL_CREATE1 1
@@ -110,6 +121,7 @@
 #define GRPC_POSIX_SOCKET_EV 1
 #define GRPC_POSIX_SOCKET_EV_EPOLL1 1
 #define GRPC_POSIX_SOCKET_EV_EPOLLEX 1
+#define GRPC_POSIX_SOCKET_EV_IO_URING 1
 #define GRPC_POSIX_SOCKET_EV_POLL 1
 #define GRPC_POSIX_SOCKET_IF_NAMETOINDEX 1
 #define GRPC_POSIX_SOCKET_RESOLVE_ADDRESS 1
@@ -198,6 +210,7 @@
 #define GRPC_POSIX_SOCKET_EV_EPOLLEX 1
 #define GRPC_POSIX_SOCKET_EV_POLL 1
 #define GRPC_POSIX_SOCKET_EV_EPOLL1 1
+#define GRPC_POSIX_SOCKET_EV_IO_URING 1
 #define GRPC_POSIX_SOCKET_IF_NAMETOINDEX 1
 #define GRPC_POSIX_SOCKET_IOMGR 1
 #define GRPC_POSIX_SOCKET_RESOLVE_ADDRESS 1
@@ -31,9 +31,12 @@
 
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -185,6 +188,18 @@ struct grpc_resource_quota {
   /* Roots of all resource user lists */
   grpc_resource_user* roots[GRPC_RULIST_COUNT];
 
+  /* Bytes of freed read buffers that the ru_slab holds for reuse on behalf of
+     this quota. They stay charged to the quota until the slab hands them out
+     again or drains them. */
+  gpr_atm slab_cached_bytes;
+  /* Part of slab_cached_bytes currently taken out of free_pool. Only touched
+     under the combiner. */
+  int64_t slab_charged_bytes;
+  /* Is rq_slab_sync scheduled? */
+  gpr_atm slab_sync_scheduled;
+  /* Closure around rq_slab_sync */
+  grpc_closure rq_slab_sync_closure;
+
   std::string name;
 };
 
@@ -276,6 +291,7 @@ static bool rq_alloc(grpc_resource_quota* resource_quota);
 static bool rq_reclaim_from_per_user_free_pool(
     grpc_resource_quota* resource_quota);
 static bool rq_reclaim(grpc_resource_quota* resource_quota, bool destructive);
+static void ru_slab_drain();
 
 static void rq_step(void* rq, grpc_error_handle /*error*/) {
   grpc_resource_quota* resource_quota = static_cast<grpc_resource_quota*>(rq);
@@ -284,6 +300,14 @@ static void rq_step(void* rq, grpc_error_handle /*error*/) {
     if (rq_alloc(resource_quota)) goto done;
   } while (rq_reclaim_from_per_user_free_pool(resource_quota));
 
+  /* Recycled read buffers are the cheapest memory to give back: draining the
+     slab returns them to their quotas through rq_slab_sync, which steps this
+     quota again. */
+  if (gpr_atm_no_barrier_load(&resource_quota->slab_cached_bytes) > 0) {
+    ru_slab_drain();
+    goto done;
+  }
+
   if (!rq_reclaim(resource_quota, false)) {
     rq_reclaim(resource_quota, true);
   }
@@ -435,6 +459,220 @@ static bool rq_reclaim(grpc_resource_quota* resource_quota, bool destructive) {
   return true;
 }
 
+/*******************************************************************************
+ * ru_slab: recycles the memory of ru_slices of the usual read buffer sizes
+ */
+
+/* Slice lengths the slab recycles are the powers of two from 256 bytes to
+   64KiB. Freed slices of those lengths are kept in per-CPU free lists of
+   bounded size instead of being returned to malloc, so that endpoints reading
+   into them do not churn the heap.
+
+   A cached block stays charged to the quota of the slice it came from (see
+   rq_slab_sync), so it counts towards that quota's memory pressure, and the
+   quota drains the slab before it asks resource users to reclaim memory. */
+#define RU_SLAB_MIN_LOG2 8
+#define RU_SLAB_MAX_LOG2 16
+#define RU_SLAB_CLASSES (RU_SLAB_MAX_LOG2 - RU_SLAB_MIN_LOG2 + 1)
+/* Bytes of free slices each CPU keeps per length */
+#define RU_SLAB_CACHE_BYTES_PER_CLASS (128 * 1024)
+/* Bytes of free slices kept by the whole process */
+#define RU_SLAB_MAX_CACHED_BYTES (4 * 1024 * 1024)
+/* Freed slices are not cached once their quota is this full */
+#define RU_SLAB_MAX_MEMORY_PRESSURE 0.8
+
+/* Brings free_pool in line with slab_cached_bytes. REQUIRES: in the quota
+   combiner */
+static void rq_slab_sync(void* rq, grpc_error_handle /*error*/) {
+  grpc_resource_quota* resource_quota = static_cast<grpc_resource_quota*>(rq);
+  gpr_atm_no_barrier_store(&resource_quota->slab_sync_scheduled, 0);
+  int64_t delta =
+      static_cast<int64_t>(
+          gpr_atm_no_barrier_load(&resource_quota->slab_cached_bytes)) -
+      resource_quota->slab_charged_bytes;
+  if (delta != 0) {
+    resource_quota->slab_charged_bytes += delta;
+    resource_quota->free_pool -= delta;
+    rq_update_estimate(resource_quota);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+      gpr_log(GPR_INFO,
+              "RQ %s: slab holds %" PRId64 " bytes; rq_free_pool -> %" PRId64,
+              resource_quota->name.c_str(), resource_quota->slab_charged_bytes,
+              resource_quota->free_pool);
+    }
+    if (delta < 0 &&
+        !rulist_empty(resource_quota, GRPC_RULIST_AWAITING_ALLOCATION)) {
+      rq_step_sched(resource_quota);
+    }
+  }
+  grpc_resource_quota_unref_internal(resource_quota);
+}
+
+/* Adds \a delta to the bytes the slab holds for \a resource_quota, and
+   schedules the matching free_pool update. Updates are batched: at most one
+   rq_slab_sync is scheduled at a time. */
+static void rq_slab_adjust(grpc_resource_quota* resource_quota, gpr_atm delta) {
+  gpr_atm_full_fetch_add(&resource_quota->slab_cached_bytes, delta);
+  if (gpr_atm_full_cas(&resource_quota->slab_sync_scheduled, 0, 1)) {
+    grpc_resource_quota_ref_internal(resource_quota);
+    resource_quota->combiner->Run(&resource_quota->rq_slab_sync_closure,
+                                  GRPC_ERROR_NONE);
+  }
+}
+
+namespace {
+
+struct ru_slab_free_block {
+  ru_slab_free_block* next;
+  /* The quota the block is charged to; the block holds a ref to it */
+  grpc_resource_quota* resource_quota;
+};
+
+struct ru_slab_shard {
+  gpr_mu mu;
+  ru_slab_free_block* free_blocks[RU_SLAB_CLASSES];
+  size_t free_count[RU_SLAB_CLASSES];
+  /* keep shards of neighbouring CPUs off each other's cache lines */
+  char padding[GPR_CACHELINE_SIZE];
+};
+
+gpr_once g_ru_slab_once = GPR_ONCE_INIT;
+/* Never freed: slices may outlive grpc_shutdown */
+ru_slab_shard* g_ru_slab_shards;
+size_t g_ru_slab_num_shards;
+/* Bytes cached over all shards */
+gpr_atm g_ru_slab_cached_bytes;
+
+void ru_slab_init() {
+  g_ru_slab_num_shards = std::max(1u, gpr_cpu_num_cores());
+  g_ru_slab_shards = new ru_slab_shard[g_ru_slab_num_shards];
+  for (size_t i = 0; i < g_ru_slab_num_shards; i++) {
+    ru_slab_shard* shard = &g_ru_slab_shards[i];
+    gpr_mu_init(&shard->mu);
+    for (size_t j = 0; j < RU_SLAB_CLASSES; j++) {
+      shard->free_blocks[j] = nullptr;
+      shard->free_count[j] = 0;
+    }
+  }
+}
+
+ru_slab_shard* ru_slab_current_shard() {
+  gpr_once_init(&g_ru_slab_once, ru_slab_init);
+  return &g_ru_slab_shards[gpr_cpu_current_cpu() % g_ru_slab_num_shards];
+}
+
+/* Returns the slab class of slices of \a length bytes, or -1 if the slab does
+   not recycle them. */
+int ru_slab_class(size_t length) {
+  if (length < (size_t(1) << RU_SLAB_MIN_LOG2) ||
+      length > (size_t(1) << RU_SLAB_MAX_LOG2) ||
+      (length & (length - 1)) != 0) {
+    return -1;
+  }
+  int cls = 0;
+  while ((size_t(1) << (RU_SLAB_MIN_LOG2 + cls)) < length) cls++;
+  return cls;
+}
+
+/* Rounds a read buffer length up to the next length the slab recycles, if
+   there is one. */
+size_t ru_slab_round_up(size_t length) {
+  for (int log2 = RU_SLAB_MIN_LOG2; log2 <= RU_SLAB_MAX_LOG2; log2++) {
+    if (length <= (size_t(1) << log2)) return size_t(1) << log2;
+  }
+  return length;
+}
+
+/* Gives a block taken out of the slab back to its quota. */
+void ru_slab_release_charge(ru_slab_free_block* block, size_t length) {
+  gpr_atm_no_barrier_fetch_add(&g_ru_slab_cached_bytes,
+                               -static_cast<gpr_atm>(length));
+  rq_slab_adjust(block->resource_quota, -static_cast<gpr_atm>(length));
+  grpc_resource_quota_unref_internal(block->resource_quota);
+}
+
+/* Allocates \a block_size bytes for a slice of \a length bytes, reusing a
+   recycled block if the current CPU has one. */
+void* ru_slab_alloc(size_t block_size, size_t length) {
+  int cls = ru_slab_class(length);
+  if (cls >= 0) {
+    ru_slab_shard* shard = ru_slab_current_shard();
+    gpr_mu_lock(&shard->mu);
+    ru_slab_free_block* block = shard->free_blocks[cls];
+    if (block != nullptr) {
+      shard->free_blocks[cls] = block->next;
+      shard->free_count[cls]--;
+    }
+    gpr_mu_unlock(&shard->mu);
+    if (block != nullptr) {
+      GRPC_STATS_INC_TCP_READ_BUFFER_SLAB_HITS();
+      ru_slab_release_charge(block, length);
+      return block;
+    }
+    GRPC_STATS_INC_TCP_READ_BUFFER_SLAB_MISSES();
+  }
+  return gpr_malloc(block_size);
+}
+
+/* Releases a block from ru_slab_alloc, keeping it for reuse if the current
+   CPU has room for it. Takes ownership of a ref to \a resource_quota, the
+   quota the block's slice was charged to. */
+void ru_slab_free(void* p, size_t length, grpc_resource_quota* resource_quota) {
+  int cls = ru_slab_class(length);
+  if (cls >= 0 &&
+      grpc_resource_quota_get_memory_pressure(resource_quota) <=
+          RU_SLAB_MAX_MEMORY_PRESSURE &&
+      gpr_atm_no_barrier_load(&g_ru_slab_cached_bytes) +
+              static_cast<gpr_atm>(length) <=
+          RU_SLAB_MAX_CACHED_BYTES) {
+    ru_slab_shard* shard = ru_slab_current_shard();
+    gpr_mu_lock(&shard->mu);
+    if (shard->free_count[cls] * length < RU_SLAB_CACHE_BYTES_PER_CLASS) {
+      ru_slab_free_block* block = static_cast<ru_slab_free_block*>(p);
+      block->next = shard->free_blocks[cls];
+      block->resource_quota = resource_quota;
+      shard->free_blocks[cls] = block;
+      shard->free_count[cls]++;
+      p = nullptr;
+    }
+    gpr_mu_unlock(&shard->mu);
+    if (p == nullptr) {
+      gpr_atm_no_barrier_fetch_add(&g_ru_slab_cached_bytes,
+                                   static_cast<gpr_atm>(length));
+      rq_slab_adjust(resource_quota, static_cast<gpr_atm>(length));
+      return;
+    }
+  }
+  gpr_free(p);
+  grpc_resource_quota_unref_internal(resource_quota);
+}
+
+}  // namespace
+
+/* Frees every block cached on any CPU and gives it back to its quota. */
+static void ru_slab_drain() {
+  if (gpr_atm_no_barrier_load(&g_ru_slab_cached_bytes) == 0) return;
+  for (size_t i = 0; i < g_ru_slab_num_shards; i++) {
+    ru_slab_shard* shard = &g_ru_slab_shards[i];
+    ru_slab_free_block* blocks[RU_SLAB_CLASSES];
+    gpr_mu_lock(&shard->mu);
+    for (size_t cls = 0; cls < RU_SLAB_CLASSES; cls++) {
+      blocks[cls] = shard->free_blocks[cls];
+      shard->free_blocks[cls] = nullptr;
+      shard->free_count[cls] = 0;
+    }
+    gpr_mu_unlock(&shard->mu);
+    for (size_t cls = 0; cls < RU_SLAB_CLASSES; cls++) {
+      while (blocks[cls] != nullptr) {
+        ru_slab_free_block* block = blocks[cls];
+        blocks[cls] = block->next;
+        ru_slab_release_charge(block, size_t(1) << (RU_SLAB_MIN_LOG2 + cls));
+        gpr_free(block);
+      }
+    }
+  }
+}
+
 /*******************************************************************************
  * ru_slice: a slice implementation that is backed by a grpc_resource_user
  */
@@ -445,8 +683,11 @@ class RuSliceRefcount {
  public:
   static void Destroy(void* p) {
     auto* rc = static_cast<RuSliceRefcount*>(p);
+    const size_t size = rc->size_;
+    grpc_resource_quota* resource_quota = grpc_resource_quota_ref_internal(
+        rc->resource_user_->resource_quota);
     rc->~RuSliceRefcount();
-    gpr_free(rc);
+    ru_slab_free(rc, size, resource_quota);
   }
   RuSliceRefcount(grpc_resource_user* resource_user, size_t size)
       : base_(grpc_slice_refcount::Type::REGULAR, &refs_, Destroy, this,
@@ -471,7 +712,7 @@ class RuSliceRefcount {
 static grpc_slice ru_slice_create(grpc_resource_user* resource_user,
                                   size_t size) {
   auto* rc = static_cast<grpc_core::RuSliceRefcount*>(
-      gpr_malloc(sizeof(grpc_core::RuSliceRefcount) + size));
+      ru_slab_alloc(sizeof(grpc_core::RuSliceRefcount) + size, size));
   new (rc) grpc_core::RuSliceRefcount(resource_user, size);
   grpc_slice slice;
 
@@ -676,6 +917,11 @@ grpc_resource_quota* grpc_resource_quota_create(const char* name) {
   for (int i = 0; i < GRPC_RULIST_COUNT; i++) {
     resource_quota->roots[i] = nullptr;
   }
+  gpr_atm_no_barrier_store(&resource_quota->slab_cached_bytes, 0);
+  resource_quota->slab_charged_bytes = 0;
+  gpr_atm_no_barrier_store(&resource_quota->slab_sync_scheduled, 0);
+  GRPC_CLOSURE_INIT(&resource_quota->rq_slab_sync_closure, rq_slab_sync,
+                    resource_quota, nullptr);
   return resource_quota;
 }
 
@@ -1041,6 +1287,13 @@ static size_t grpc_slice_allocator_adjust_allocation_length(
                                             slice_allocator->max_length)) +
        255) &
       ~static_cast<size_t>(255);
+  // Without memory pressure, round up further to a length the slab recycles,
+  // as long as that adds at most a quarter to the read buffer.
+  size_t slab_length = ru_slab_round_up(target);
+  if (pressure <= 0.8 && slab_length <= slice_allocator->max_length &&
+      slab_length - target <= target / 4) {
+    target = slab_length;
+  }
   // Don't use more than 1/16th of the overall resource quota for a single
   // read alloc
   size_t rqmax = grpc_resource_quota_peek_size(
@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -70,6 +71,10 @@
 #define TCP_CM_INQ TCP_INQ
 #endif
 
+#ifndef TCP_ZEROCOPY_RECEIVE
+#define TCP_ZEROCOPY_RECEIVE 35
+#endif
+
 #ifdef GRPC_HAVE_MSG_NOSIGNAL
 #define SENDMSG_FLAGS MSG_NOSIGNAL
 #else
@@ -91,8 +96,25 @@ typedef GRPC_MSG_IOVLEN_TYPE msg_iovlen_type;
 typedef size_t msg_iovlen_type;
 #endif
 
+#define READ_SIZE_HISTORY 8
+
 extern grpc_core::TraceFlag grpc_tcp_trace;
 
+#ifdef GRPC_HAVE_TCP_ZEROCOPY_RECEIVE
+/* Prefix of the kernel's struct tcp_zerocopy_receive, up to the inq field.
+   Defined here since older library headers lack the struct or the inq field.
+   Stopping before the err field keeps the kernel from consuming a pending
+   socket error, which is left for recvmsg to report. */
+struct grpc_tcp_zerocopy_receive {
+  uint64_t address;        /* in: address of mapping */
+  uint32_t length;         /* in/out: number of bytes to map/mapped */
+  uint32_t recv_skip_hint; /* out: amount of bytes to skip */
+  uint32_t inq;            /* out: amount of bytes in read queue */
+};
+#define GRPC_TCP_ZEROCOPY_RECEIVE_LEN \
+  (offsetof(grpc_tcp_zerocopy_receive, inq) + sizeof(uint32_t))
+#endif /* GRPC_HAVE_TCP_ZEROCOPY_RECEIVE */
+
 namespace grpc_core {
 
 class TcpZerocopySendRecord {
@@ -364,6 +386,9 @@ struct grpc_tcp {
   bool is_first_read;
   double target_length;
   double bytes_read_this_round;
+  /* Bytes read by each of the last READ_SIZE_HISTORY read rounds */
+  size_t recent_read_sizes[READ_SIZE_HISTORY];
+  size_t recent_read_index;
   grpc_core::RefCount refcount;
   gpr_atm shutdown_count;
 
@@ -377,10 +402,27 @@ struct grpc_tcp {
   int inq;          /* bytes pending on the socket from the last read. */
   bool inq_capable; /* cache whether kernel supports inq */
 
+  /* Map reads of at least rx_zerocopy_threshold pending bytes with
+     TCP_ZEROCOPY_RECEIVE. Cleared if the kernel cannot do so. */
+  bool rx_zerocopy_enabled;
+  int rx_zerocopy_threshold;
+  /* Reads left to copy before trying to map again, after attempts that found
+     no page aligned data at the head of the receive queue. */
+  int rx_zerocopy_skip_reads;
+  int rx_zerocopy_backoff;
+
   grpc_slice_buffer* outgoing_buffer;
   /* byte within outgoing_buffer->slices[0] to write next */
   size_t outgoing_byte_idx;
 
+  /* Queue writes on the write batch of the poller thread issuing them, if
+     any (see grpc_fd_queue_sendmsg). batched_iov holds the first
+     MAX_BATCHED_WRITE_IOVEC slices of the write in flight. */
+  bool write_batching_enabled;
+  grpc_fd_sendmsg_op batched_write;
+  struct msghdr batched_msg;
+  struct iovec* batched_iov;
+
   grpc_closure* read_cb;
   grpc_closure* write_cb;
   grpc_closure* release_fd_cb;
@@ -388,6 +430,7 @@ struct grpc_tcp {
 
   grpc_closure read_done_closure;
   grpc_closure write_done_closure;
+  grpc_closure batched_write_done_closure;
   grpc_closure error_closure;
 
   std::string peer_string;
@@ -571,16 +614,27 @@ static void add_to_estimate(grpc_tcp* tcp, size_t bytes) {
 }
 
 static void finish_estimate(grpc_tcp* tcp) {
+  tcp->recent_read_sizes[tcp->recent_read_index++ % READ_SIZE_HISTORY] =
+      static_cast<size_t>(tcp->bytes_read_this_round);
   /* If we read >80% of the target buffer in one read loop, increase the size
      of the target buffer to either the amount read, or twice its previous
-     value */
+     value. Otherwise size it for the largest of the recent read loops, with
+     enough headroom that a loop of the same size does not count as full, so
+     that a connection that stops receiving bursts soon stops holding the
+     large buffers they needed. */
   if (tcp->bytes_read_this_round > tcp->target_length * 0.8) {
     tcp->target_length =
         std::max(2 * tcp->target_length, tcp->bytes_read_this_round);
   } else {
-    tcp->target_length =
-        0.99 * tcp->target_length + 0.01 * tcp->bytes_read_this_round;
+    size_t recent_max = 0;
+    for (size_t bytes : tcp->recent_read_sizes) {
+      recent_max = std::max(recent_max, bytes);
+    }
+    tcp->target_length = std::max(1.5 * static_cast<double>(recent_max),
+                                  static_cast<double>(tcp->min_read_chunk_size));
   }
+  tcp->target_length = std::min(
+      tcp->target_length, static_cast<double>(tcp->max_read_chunk_size));
   tcp->bytes_read_this_round = 0;
 }
 
@@ -597,6 +651,8 @@ static grpc_error_handle tcp_annotate_error(grpc_error_handle src_error,
 
 static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error_handle error);
 static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error_handle error);
+static void tcp_handle_batched_write(void* arg /* grpc_tcp */,
+                                     grpc_error_handle error);
 
 static void tcp_shutdown(grpc_endpoint* ep, grpc_error_handle why) {
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
@@ -609,6 +665,7 @@ static void tcp_free(grpc_tcp* tcp) {
                  "tcp_unref_orphan");
   grpc_slice_buffer_destroy_internal(&tcp->last_read_buffer);
   grpc_slice_allocator_destroy(tcp->slice_allocator);
+  gpr_free(tcp->batched_iov);
   /* The lock is not really necessary here, since all refs have been released */
   gpr_mu_lock(&tcp->tb_mu);
   grpc_core::TracedBuffer::Shutdown(
@@ -680,6 +737,105 @@ static void call_read_cb(grpc_tcp* tcp, grpc_error_handle error) {
   grpc_core::Closure::Run(DEBUG_LOCATION, cb, error);
 }
 
+#ifdef GRPC_HAVE_TCP_ZEROCOPY_RECEIVE
+#define MAX_RX_ZEROCOPY_BACKOFF 64
+
+static void unmap_received_pages(void* p, size_t len) { munmap(p, len); }
+
+/* Receives from the head of the receive queue into \a out, mapping page
+   aligned data into slices that unmap it on release instead of copying it.
+   Bytes in front of the next page aligned data (the kernel's recv_skip_hint)
+   are copied before mapping again. Returns the number of bytes received; the
+   caller copies whatever is left as usual. */
+static size_t tcp_zerocopy_receive(grpc_tcp* tcp, grpc_slice_buffer* out) {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t received = 0;
+  bool mapped_last = true;
+  while (true) {
+    size_t length = std::min<size_t>(tcp->inq, tcp->max_read_chunk_size);
+    length -= length % page_size;
+    if (length == 0) {
+      break;
+    }
+    void* addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, tcp->fd, 0);
+    if (addr == MAP_FAILED) {
+      gpr_log(GPR_DEBUG, "cannot mmap receive queue fd=%d errno=%d", tcp->fd,
+              errno);
+      tcp->rx_zerocopy_enabled = false;
+      break;
+    }
+    grpc_tcp_zerocopy_receive zc;
+    memset(&zc, 0, sizeof(zc));
+    zc.address = reinterpret_cast<uintptr_t>(addr);
+    zc.length = static_cast<uint32_t>(length);
+    socklen_t zc_len = GRPC_TCP_ZEROCOPY_RECEIVE_LEN;
+    int err;
+    do {
+      GPR_TIMER_SCOPE("zerocopy_receive", 0);
+      GRPC_STATS_INC_SYSCALL_READ();
+      err = getsockopt(tcp->fd, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc,
+                       &zc_len);
+    } while (err < 0 && errno == EINTR);
+    if (err < 0) {
+      /* Kernels before 5.3 reject the struct size: copy from now on. */
+      gpr_log(GPR_DEBUG, "cannot zerocopy receive fd=%d errno=%d", tcp->fd,
+              errno);
+      munmap(addr, length);
+      tcp->rx_zerocopy_enabled = false;
+      break;
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+      gpr_log(GPR_INFO, "TCP:%p zerocopy_receive mapped %u of %zu, skip %u",
+              tcp, zc.length, length, zc.recv_skip_hint);
+    }
+    tcp->inq = static_cast<int>(zc.inq);
+    if (zc.length > 0) {
+      if (zc.length < length) {
+        munmap(static_cast<char*>(addr) + zc.length, length - zc.length);
+      }
+      grpc_slice_buffer_add(
+          out, grpc_slice_new_with_len(addr, zc.length, unmap_received_pages));
+      received += zc.length;
+      tcp->rx_zerocopy_backoff = 0;
+    } else {
+      munmap(addr, length);
+      if (!mapped_last || zc.recv_skip_hint == 0) {
+        /* Nothing is page aligned, even after skipping ahead, as with loopback
+           or a NIC that does not split headers. Back off, so that such
+           connections do not pay for the attempts on every read. */
+        tcp->rx_zerocopy_backoff = std::min(
+            std::max(2 * tcp->rx_zerocopy_backoff, 1), MAX_RX_ZEROCOPY_BACKOFF);
+        tcp->rx_zerocopy_skip_reads = tcp->rx_zerocopy_backoff;
+        break;
+      }
+    }
+    mapped_last = zc.length > 0;
+    if (zc.recv_skip_hint == 0 || tcp->inq < tcp->rx_zerocopy_threshold) {
+      break;
+    }
+    grpc_slice skipped = GRPC_SLICE_MALLOC(zc.recv_skip_hint);
+    ssize_t read_bytes;
+    do {
+      GPR_TIMER_SCOPE("recv", 0);
+      GRPC_STATS_INC_SYSCALL_READ();
+      read_bytes = recv(tcp->fd, GRPC_SLICE_START_PTR(skipped),
+                        GRPC_SLICE_LENGTH(skipped), 0);
+    } while (read_bytes < 0 && errno == EINTR);
+    if (read_bytes <= 0) {
+      /* Leave errors and end of stream for the copying read to report. */
+      grpc_slice_unref_internal(skipped);
+      tcp->inq = 1;
+      break;
+    }
+    GRPC_SLICE_SET_LENGTH(skipped, read_bytes);
+    grpc_slice_buffer_add(out, skipped);
+    received += read_bytes;
+    tcp->inq -= std::min<int>(tcp->inq, read_bytes);
+  }
+  return received;
+}
+#endif /* GRPC_HAVE_TCP_ZEROCOPY_RECEIVE */
+
 #define MAX_READ_IOVEC 4
 static void tcp_do_read(grpc_tcp* tcp) {
   GPR_TIMER_SCOPE("tcp_do_read", 0);
@@ -701,7 +857,30 @@ static void tcp_do_read(grpc_tcp* tcp) {
     iov[i].iov_len = GRPC_SLICE_LENGTH(tcp->incoming_buffer->slices[i]);
   }
 
-  do {
+  /* Bytes received into zerocopy_buffer, which precede the bytes read into
+     incoming_buffer. */
+  size_t zerocopy_bytes = 0;
+  grpc_slice_buffer zerocopy_buffer;
+#ifdef GRPC_HAVE_TCP_ZEROCOPY_RECEIVE
+  if (tcp->rx_zerocopy_enabled && tcp->inq >= tcp->rx_zerocopy_threshold) {
+    if (tcp->rx_zerocopy_skip_reads > 0) {
+      tcp->rx_zerocopy_skip_reads--;
+    } else {
+      grpc_slice_buffer_init(&zerocopy_buffer);
+      zerocopy_bytes = tcp_zerocopy_receive(tcp, &zerocopy_buffer);
+      if (zerocopy_bytes > 0) {
+        GRPC_STATS_INC_TCP_READ_SIZE(zerocopy_bytes);
+        add_to_estimate(tcp, zerocopy_bytes);
+      } else {
+        grpc_slice_buffer_destroy_internal(&zerocopy_buffer);
+      }
+    }
+  }
+#endif /* GRPC_HAVE_TCP_ZEROCOPY_RECEIVE */
+
+  /* Copy whatever could not be mapped: the loop only exits through its
+     breaks and returns. */
+  while (zerocopy_bytes == 0 || tcp->inq != 0) {
     /* Assume there is something on the queue. If we receive TCP_INQ from
      * kernel, we will update this value, otherwise, we have to assume there is
      * always something to read until we get EAGAIN. */
@@ -731,7 +910,7 @@ static void tcp_do_read(grpc_tcp* tcp) {
 
     /* We have read something in previous reads. We need to deliver those
      * bytes to the upper layer. */
-    if (read_bytes <= 0 && total_read_bytes > 0) {
+    if (read_bytes <= 0 && total_read_bytes + zerocopy_bytes > 0) {
       tcp->inq = 1;
       break;
     }
@@ -811,18 +990,23 @@ static void tcp_do_read(grpc_tcp* tcp) {
       ++j;
     }
     iov_len = j;
-  } while (true);
+  }
 
   if (tcp->inq == 0) {
     finish_estimate(tcp);
   }
 
-  GPR_DEBUG_ASSERT(total_read_bytes > 0);
+  GPR_DEBUG_ASSERT(total_read_bytes + zerocopy_bytes > 0);
   if (total_read_bytes < tcp->incoming_buffer->length) {
     grpc_slice_buffer_trim_end(tcp->incoming_buffer,
                                tcp->incoming_buffer->length - total_read_bytes,
                                &tcp->last_read_buffer);
   }
+  if (zerocopy_bytes > 0) {
+    grpc_slice_buffer_move_into(tcp->incoming_buffer, &zerocopy_buffer);
+    grpc_slice_buffer_swap(tcp->incoming_buffer, &zerocopy_buffer);
+    grpc_slice_buffer_destroy_internal(&zerocopy_buffer);
+  }
   call_read_cb(tcp, GRPC_ERROR_NONE);
   TCP_UNREF(tcp, "read");
 }
@@ -1261,6 +1445,13 @@ void tcp_shutdown_buffer_list(grpc_tcp* tcp) {
 #else
 #define MAX_WRITE_IOVEC 260
 #endif
+/* Batched writes carry fewer slices so that every endpoint can keep its iovec
+   array around; whatever does not fit is written by tcp_flush() afterwards. */
+#if MAX_WRITE_IOVEC < 64
+#define MAX_BATCHED_WRITE_IOVEC MAX_WRITE_IOVEC
+#else
+#define MAX_BATCHED_WRITE_IOVEC 64
+#endif
 msg_iovlen_type TcpZerocopySendRecord::PopulateIovs(size_t* unwind_slice_idx,
                                                     size_t* unwind_byte_idx,
                                                     size_t* sending_length,
@@ -1542,6 +1733,73 @@ static void tcp_handle_write(void* arg /* grpc_tcp */,
   }
 }
 
+/* Queues the head of outgoing_buffer on the calling poller thread's write
+   batch. Returns false if the thread is not batching writes. */
+static bool tcp_queue_batched_write(grpc_tcp* tcp) {
+  size_t iov_size;
+  size_t sending_length = 0;
+  for (iov_size = 0; iov_size != tcp->outgoing_buffer->count &&
+                     iov_size != MAX_BATCHED_WRITE_IOVEC;
+       iov_size++) {
+    grpc_slice& slice = tcp->outgoing_buffer->slices[iov_size];
+    tcp->batched_iov[iov_size].iov_base = GRPC_SLICE_START_PTR(slice);
+    tcp->batched_iov[iov_size].iov_len = GRPC_SLICE_LENGTH(slice);
+    sending_length += GRPC_SLICE_LENGTH(slice);
+  }
+  memset(&tcp->batched_msg, 0, sizeof(tcp->batched_msg));
+  tcp->batched_msg.msg_iov = tcp->batched_iov;
+  tcp->batched_msg.msg_iovlen = static_cast<msg_iovlen_type>(iov_size);
+  tcp->batched_write.fd = tcp->fd;
+  tcp->batched_write.msg = &tcp->batched_msg;
+  tcp->batched_write.flags = SENDMSG_FLAGS;
+  tcp->batched_write.on_done = &tcp->batched_write_done_closure;
+  if (!grpc_fd_queue_sendmsg(&tcp->batched_write)) return false;
+  GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
+  GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
+  return true;
+}
+
+/* Runs once the poller has sent a write queued by tcp_queue_batched_write() */
+static void tcp_handle_batched_write(void* arg /* grpc_tcp */,
+                                     grpc_error_handle /*error*/) {
+  grpc_tcp* tcp = static_cast<grpc_tcp*>(arg);
+  const grpc_fd_sendmsg_op& op = tcp->batched_write;
+  if (op.result < 0 && op.err != EAGAIN) {
+    grpc_error_handle error =
+        tcp_annotate_error(GRPC_OS_ERROR(op.err, "sendmsg"), tcp);
+    grpc_slice_buffer_reset_and_unref_internal(tcp->outgoing_buffer);
+    tcp_handle_write(tcp, error);
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  if (op.result > 0) {
+    tcp->bytes_counter += op.result;
+    size_t trailing = static_cast<size_t>(op.result);
+    while (trailing > 0) {
+      size_t slice_length = GRPC_SLICE_LENGTH(tcp->outgoing_buffer->slices[0]);
+      if (slice_length > trailing) {
+        tcp->outgoing_byte_idx = trailing;
+        break;
+      }
+      trailing -= slice_length;
+      grpc_slice_buffer_remove_first(tcp->outgoing_buffer);
+    }
+  }
+  if (tcp->outgoing_buffer->length == 0) {
+    grpc_closure* cb = tcp->write_cb;
+    tcp->write_cb = nullptr;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+      gpr_log(GPR_INFO, "write: batched");
+    }
+    grpc_core::Closure::Run(DEBUG_LOCATION, cb, GRPC_ERROR_NONE);
+    TCP_UNREF(tcp, "write");
+    return;
+  }
+  // The socket only took part of the write (or the write did not fit in one
+  // batched sendmsg): finish it as an ordinary write.
+  tcp_handle_write(tcp, GRPC_ERROR_NONE);
+}
+
 static void tcp_write(grpc_endpoint* ep, grpc_slice_buffer* buf,
                       grpc_closure* cb, void* arg) {
   GPR_TIMER_SCOPE("tcp_write", 0);
@@ -1588,6 +1846,15 @@ static void tcp_write(grpc_endpoint* ep, grpc_slice_buffer* buf,
     GPR_ASSERT(grpc_event_engine_can_track_errors());
   }
 
+  // Timestamped and zerocopy writes need their own sendmsg flags and error
+  // queue handling, so only plain writes are batched.
+  if (tcp->write_batching_enabled && zerocopy_send_record == nullptr &&
+      arg == nullptr && tcp_queue_batched_write(tcp)) {
+    TCP_REF(tcp, "write");
+    tcp->write_cb = cb;
+    return;
+  }
+
   bool flush_result =
       zerocopy_send_record != nullptr
           ? tcp_flush_zerocopy(tcp, zerocopy_send_record, &error)
@@ -1676,6 +1943,12 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
   bool tcp_tx_zerocopy_enabled = kZerocpTxEnabledDefault;
+  static constexpr bool kZerocpRxEnabledDefault = false;
+  static constexpr int kZerocpRxDefaultRecvBytesThreshold = 64 * 1024;
+  bool tcp_rx_zerocopy_enabled = kZerocpRxEnabledDefault;
+  int tcp_rx_zerocopy_recv_bytes_thresh = kZerocpRxDefaultRecvBytesThreshold;
+  static constexpr bool kWriteBatchingEnabledDefault = false;
+  bool tcp_write_batching_enabled = kWriteBatchingEnabledDefault;
   int tcp_tx_zerocopy_send_bytes_thresh =
       grpc_core::TcpZerocopySendCtx::kDefaultSendBytesThreshold;
   int tcp_tx_zerocopy_max_simult_sends =
@@ -1714,6 +1987,20 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
             grpc_core::TcpZerocopySendCtx::kDefaultMaxSends, 0, INT_MAX};
         tcp_tx_zerocopy_max_simult_sends =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED)) {
+        tcp_rx_zerocopy_enabled = grpc_channel_arg_get_bool(
+            &channel_args->args[i], kZerocpRxEnabledDefault);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {kZerocpRxDefaultRecvBytesThreshold, 1,
+                                        INT_MAX};
+        tcp_rx_zerocopy_recv_bytes_thresh =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_WRITE_BATCHING_ENABLED)) {
+        tcp_write_batching_enabled = grpc_channel_arg_get_bool(
+            &channel_args->args[i], kWriteBatchingEnabledDefault);
       }
     }
   }
@@ -1750,6 +2037,11 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   tcp->min_read_chunk_size = tcp_min_read_chunk_size;
   tcp->max_read_chunk_size = tcp_max_read_chunk_size;
   tcp->bytes_read_this_round = 0;
+  /* Until there is a history, size reads for the configured chunk size */
+  for (size_t& bytes : tcp->recent_read_sizes) {
+    bytes = static_cast<size_t>(tcp_read_chunk_size) / 2;
+  }
+  tcp->recent_read_index = 0;
   /* Will be set to false by the very first endpoint read function */
   tcp->is_first_read = true;
   tcp->bytes_counter = -1;
@@ -1801,6 +2093,21 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
 #else
   tcp->inq_capable = false;
 #endif /* GRPC_HAVE_TCP_INQ */
+  /* Zerocopy receive sizes its mappings by the pending bytes reported by
+     inq. */
+  tcp->rx_zerocopy_enabled = tcp_rx_zerocopy_enabled && tcp->inq_capable;
+  tcp->rx_zerocopy_threshold = tcp_rx_zerocopy_recv_bytes_thresh;
+  tcp->rx_zerocopy_skip_reads = 0;
+  tcp->rx_zerocopy_backoff = 0;
+  tcp->write_batching_enabled = tcp_write_batching_enabled;
+  if (tcp_write_batching_enabled) grpc_fd_set_write_batching(em_fd);
+  tcp->batched_iov =
+      tcp_write_batching_enabled
+          ? static_cast<struct iovec*>(gpr_malloc(
+                MAX_BATCHED_WRITE_IOVEC * sizeof(*tcp->batched_iov)))
+          : nullptr;
+  GRPC_CLOSURE_INIT(&tcp->batched_write_done_closure, tcp_handle_batched_write,
+                    tcp, grpc_schedule_on_exec_ctx);
   /* Start being notified on errors if event engine can track errors. */
   if (grpc_event_engine_can_track_errors()) {
     /* Grab a ref to tcp so that we can safely access the tcp struct when
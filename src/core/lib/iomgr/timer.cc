@@ -20,14 +20,37 @@
 
 #include "src/core/lib/iomgr/timer.h"
 
+#include <string.h>
+
+#include <grpc/support/log.h>
+
 #include "src/core/lib/iomgr/timer_manager.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_timer_impl, "heap",
+    "Selects the timer implementation used by the built-in iomgr platforms: "
+    "'heap' (sharded timer heaps) or 'wheel' (per-CPU hierarchical timer "
+    "wheels).")
+
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
 grpc_timer_vtable* grpc_timer_impl;
 
 void grpc_set_timer_impl(grpc_timer_vtable* vtable) {
   grpc_timer_impl = vtable;
 }
 
+grpc_timer_vtable* grpc_builtin_timer_impl() {
+  grpc_core::UniquePtr<char> value = GPR_GLOBAL_CONFIG_GET(grpc_timer_impl);
+  if (strcmp(value.get(), "wheel") == 0) return &grpc_wheel_timer_vtable;
+  if (strcmp(value.get(), "heap") != 0) {
+    gpr_log(GPR_ERROR, "Unknown timer implementation '%s', using 'heap'",
+            value.get());
+  }
+  return &grpc_generic_timer_vtable;
+}
+
 void grpc_timer_init(grpc_timer* timer, grpc_millis deadline,
                      grpc_closure* closure) {
   grpc_timer_impl->init(timer, deadline, closure);
@@ -24,13 +24,17 @@
 #include <grpc/event_engine/event_engine.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/port.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_timer_impl);
+
 typedef struct grpc_timer {
   grpc_millis deadline;
   // Uninitialized if not using heap, or INVALID_HEAP_INDEX if not in heap.
+  // The timer wheel uses it to record the wheel and slot holding the timer.
   uint32_t heap_index;
   bool pending;
   struct grpc_timer* next;
@@ -128,4 +132,9 @@ void grpc_kick_poller(void);
 /* Sets the timer implementation */
 void grpc_set_timer_impl(grpc_timer_vtable* vtable);
 
+/* Returns the built-in timer implementation selected by GRPC_TIMER_IMPL, for
+   iomgr platforms that do not bring their own timers: the sharded timer heap
+   ("heap", the default) or the hierarchical timer wheel ("wheel"). */
+grpc_timer_vtable* grpc_builtin_timer_impl();
+
 #endif /* GRPC_CORE_LIB_IOMGR_TIMER_H */
@@ -0,0 +1,508 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+
+/* A hierarchical timing wheel (Varghese & Lauck), as an alternative to the
+ * sharded heap in timer_generic.cc.
+ *
+ * Level 0 has one slot per millisecond for the next 256ms. Each of the three
+ * levels above it has 64 slots, each slot spanning one full revolution of the
+ * level below, so the wheel covers 2^26ms (about 18.6 hours); later deadlines
+ * are parked in the last level and re-filed as time approaches them. Timers
+ * are filed by their absolute deadline, so arming and cancelling are O(1)
+ * list operations. When level 0 wraps around, the current slot of the level
+ * above is "cascaded": its timers are re-filed into lower levels.
+ *
+ * Most deadline timers are cancelled long before they would fire, so they
+ * never take part in a cascade.
+ *
+ * There is one wheel per CPU; a timer is armed on the wheel of the CPU that
+ * arms it, and records its wheel (and slot) in heap_index so that it can be
+ * cancelled without searching. */
+
+#define LEVEL0_BITS 8
+#define LEVELN_BITS 6
+#define NUM_LEVELS 4
+#define LEVEL0_SLOTS (1 << LEVEL0_BITS)
+#define LEVELN_SLOTS (1 << LEVELN_BITS)
+#define NUM_SLOTS (LEVEL0_SLOTS + (NUM_LEVELS - 1) * LEVELN_SLOTS)
+/* Timers further out than this are parked in the last level. */
+#define MAX_DELTA \
+  ((int64_t(1) << (LEVEL0_BITS + (NUM_LEVELS - 1) * LEVELN_BITS)) - 1)
+#define MAX_WHEELS 32
+/* heap_index of a timer that was never filed on a wheel. */
+#define INVALID_HEAP_INDEX 0xffffffffu
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+struct timer_wheel {
+  gpr_mu mu;
+  /* The first millisecond that has not been processed yet. */
+  grpc_millis current;
+  /* Number of timers filed in this wheel. */
+  size_t count;
+  /* Lower bound on the deadline of the earliest timer in this wheel. Only
+     lowered by timer_init, and only raised by the checker. */
+  std::atomic<grpc_millis> min_deadline;
+  /* One bit per slot, set iff the slot is non-empty. */
+  uint64_t occupied[NUM_SLOTS / 64];
+  /* List heads. Slots [0, LEVEL0_SLOTS) are level 0, followed by
+     LEVELN_SLOTS slots for each higher level. */
+  grpc_timer slots[NUM_SLOTS];
+};
+
+static size_t g_num_wheels;
+static timer_wheel* g_wheels;
+
+/* Allow only one run_some_expired_timers at once */
+static gpr_spinlock g_checker_mu;
+/* Serializes updates to g_min_timer against the checker */
+static gpr_mu g_mu;
+/* The deadline of the next timer due across all wheels */
+static std::atomic<grpc_millis> g_min_timer;
+static bool g_initialized;
+
+/* Thread local variable that stores the deadline of the next timer the thread
+ * has last-seen (see timer_generic.cc). */
+static GPR_THREAD_LOCAL(grpc_millis) g_last_seen_min_timer;
+
+static int level_shift(int level) {
+  return level == 0 ? 0 : LEVEL0_BITS + (level - 1) * LEVELN_BITS;
+}
+
+static size_t level_base(int level) {
+  return level == 0 ? 0 : LEVEL0_SLOTS + (level - 1) * LEVELN_SLOTS;
+}
+
+static size_t level_slots(int level) {
+  return level == 0 ? LEVEL0_SLOTS : LEVELN_SLOTS;
+}
+
+static size_t level_index(int level, grpc_millis t) {
+  return static_cast<size_t>(static_cast<uint64_t>(t) >> level_shift(level)) &
+         (level_slots(level) - 1);
+}
+
+static void set_bit(timer_wheel* w, size_t slot) {
+  w->occupied[slot / 64] |= uint64_t(1) << (slot % 64);
+}
+
+static void clear_bit(timer_wheel* w, size_t slot) {
+  w->occupied[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+}
+
+/* Returns the first occupied slot in [base + from, base + to) of a level, or
+   base + to if there is none. */
+static size_t find_occupied(const timer_wheel* w, size_t base, size_t from,
+                            size_t to) {
+  for (size_t i = base + from; i < base + to;) {
+    uint64_t bits = w->occupied[i / 64] >> (i % 64);
+    if (bits != 0) {
+      size_t found = i + grpc_core::BitCount((bits & (~bits + 1)) - 1);
+      return std::min(found, base + to);
+    }
+    i = (i / 64 + 1) * 64;
+  }
+  return base + to;
+}
+
+static void list_join(grpc_timer* head, grpc_timer* timer) {
+  timer->next = head;
+  timer->prev = head->prev;
+  timer->next->prev = timer->prev->next = timer;
+}
+
+static void list_remove(grpc_timer* timer) {
+  timer->next->prev = timer->prev;
+  timer->prev->next = timer->next;
+}
+
+/* Files a timer into the slot matching its deadline, relative to
+   w->current. REQUIRES: w->mu locked */
+static void file_timer(timer_wheel* w, grpc_timer* timer) {
+  grpc_millis deadline = std::max(timer->deadline, w->current);
+  int64_t delta = std::min<int64_t>(deadline - w->current, MAX_DELTA);
+  deadline = w->current + delta;
+  int level = 0;
+  while (level < NUM_LEVELS - 1 &&
+         delta >= (int64_t(1) << level_shift(level + 1))) {
+    ++level;
+  }
+  size_t slot = level_base(level) + level_index(level, deadline);
+  timer->heap_index =
+      static_cast<uint32_t>((w - g_wheels) * NUM_SLOTS + slot);
+  list_join(&w->slots[slot], timer);
+  set_bit(w, slot);
+}
+
+/* REQUIRES: w->mu locked */
+static void unfile_timer(timer_wheel* w, grpc_timer* timer) {
+  size_t slot = timer->heap_index % NUM_SLOTS;
+  list_remove(timer);
+  if (w->slots[slot].next == &w->slots[slot]) clear_bit(w, slot);
+}
+
+/* Detaches the timers in slot and returns them as a null-terminated list
+   linked through 'next'. REQUIRES: w->mu locked */
+static grpc_timer* take_slot(timer_wheel* w, size_t slot) {
+  grpc_timer* head = &w->slots[slot];
+  if (head->next == head) return nullptr;
+  grpc_timer* first = head->next;
+  head->prev->next = nullptr;
+  head->next = head->prev = head;
+  clear_bit(w, slot);
+  return first;
+}
+
+/* Re-files the timers of the higher-level slots that come due in the level-0
+   revolution starting at w->current. REQUIRES: w->mu locked */
+static void cascade(timer_wheel* w) {
+  for (int level = 1; level < NUM_LEVELS; ++level) {
+    size_t index = level_index(level, w->current);
+    grpc_timer* timer = take_slot(w, level_base(level) + index);
+    while (timer != nullptr) {
+      grpc_timer* next = timer->next;
+      file_timer(w, timer);
+      timer = next;
+    }
+    /* Only continue upwards if this level wrapped around as well. */
+    if (index != 0) break;
+  }
+}
+
+/* Runs every timer in a level-0 slot with the given error.
+   REQUIRES: w->mu locked */
+static size_t fire_slot(timer_wheel* w, size_t slot, grpc_error_handle error) {
+  size_t n = 0;
+  grpc_timer* timer = take_slot(w, slot);
+  while (timer != nullptr) {
+    grpc_timer* next = timer->next;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+      gpr_log(GPR_INFO, "TIMER %p: FIRE %" PRId64 "ms late", timer,
+              w->current - timer->deadline);
+    }
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_REF(error));
+    ++n;
+    timer = next;
+  }
+  w->count -= n;
+  return n;
+}
+
+/* Runs every timer in the wheel, regardless of its deadline.
+   REQUIRES: w->mu locked */
+static size_t fire_all(timer_wheel* w, grpc_error_handle error) {
+  size_t n = 0;
+  for (size_t slot = 0; slot < NUM_SLOTS; ++slot) {
+    n += fire_slot(w, slot, error);
+  }
+  return n;
+}
+
+/* Returns a lower bound on the next deadline in the wheel: the exact deadline
+   of the first level-0 timer, or the next time a higher level must be
+   cascaded, whichever comes first. REQUIRES: w->mu locked */
+static grpc_millis compute_min_deadline(timer_wheel* w) {
+  if (w->count == 0) return GRPC_MILLIS_INF_FUTURE;
+  grpc_millis min_deadline = GRPC_MILLIS_INF_FUTURE;
+  for (int level = 0; level < NUM_LEVELS; ++level) {
+    size_t base = level_base(level);
+    size_t slots = level_slots(level);
+    size_t current = level_index(level, w->current);
+    /* Level 0 timers are due at current + offset. In higher levels the
+       current slot has already been cascaded, unless w->current is the
+       (unprocessed) start of its revolution, so a timer found there belongs
+       to the next revolution. */
+    int shift = level_shift(level);
+    bool cascade_pending =
+        (w->current & ((grpc_millis(1) << shift) - 1)) == 0;
+    size_t start = level == 0 || cascade_pending ? current : current + 1;
+    size_t found = find_occupied(w, base, start, slots);
+    if (found == base + slots) {
+      found = find_occupied(w, base, 0, start);
+      if (found == base + start) continue;
+      found += slots;
+    }
+    grpc_millis offset = static_cast<grpc_millis>(found - base - current);
+    grpc_millis due;
+    if (level == 0) {
+      due = w->current + offset;
+    } else {
+      due = ((w->current >> shift) + offset) << shift;
+    }
+    min_deadline = std::min(min_deadline, due);
+  }
+  return min_deadline;
+}
+
+/* Runs all timers due at or before now. REQUIRES: w->mu locked */
+static size_t advance(timer_wheel* w, grpc_millis now,
+                      grpc_error_handle error) {
+  size_t n = 0;
+  while (w->count > 0 && w->current <= now) {
+    if (level_index(0, w->current) == 0) cascade(w);
+    n += fire_slot(w, level_index(0, w->current), error);
+    /* Jump straight to the next level-0 timer or cascade, whichever comes
+       first: nothing happens in between. */
+    w->current = std::min(now + 1, compute_min_deadline(w));
+  }
+  w->current = std::max(w->current, now + 1);
+  return n;
+}
+
+static void timer_list_init() {
+  g_num_wheels = grpc_core::Clamp(gpr_cpu_num_cores(), 1u,
+                                  static_cast<unsigned>(MAX_WHEELS));
+  g_wheels = new timer_wheel[g_num_wheels];
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  for (size_t i = 0; i < g_num_wheels; i++) {
+    timer_wheel* w = &g_wheels[i];
+    gpr_mu_init(&w->mu);
+    w->current = now;
+    w->count = 0;
+    w->min_deadline.store(GRPC_MILLIS_INF_FUTURE, std::memory_order_relaxed);
+    memset(w->occupied, 0, sizeof(w->occupied));
+    for (size_t slot = 0; slot < NUM_SLOTS; slot++) {
+      w->slots[slot].next = w->slots[slot].prev = &w->slots[slot];
+    }
+  }
+  g_checker_mu = GPR_SPINLOCK_INITIALIZER;
+  gpr_mu_init(&g_mu);
+  g_min_timer.store(GRPC_MILLIS_INF_FUTURE, std::memory_order_relaxed);
+  g_last_seen_min_timer = 0;
+  g_initialized = true;
+}
+
+static void timer_list_shutdown() {
+  grpc_error_handle error =
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown");
+  for (size_t i = 0; i < g_num_wheels; i++) {
+    timer_wheel* w = &g_wheels[i];
+    gpr_mu_lock(&w->mu);
+    fire_all(w, error);
+    gpr_mu_unlock(&w->mu);
+    gpr_mu_destroy(&w->mu);
+  }
+  GRPC_ERROR_UNREF(error);
+  gpr_mu_destroy(&g_mu);
+  delete[] g_wheels;
+  g_wheels = nullptr;
+  g_initialized = false;
+}
+
+static void timer_init(grpc_timer* timer, grpc_millis deadline,
+                       grpc_closure* closure) {
+  timer->closure = closure;
+  timer->deadline = deadline;
+
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline, grpc_core::ExecCtx::Get()->Now(), closure,
+            closure->cb);
+  }
+
+  if (!g_initialized) {
+    timer->pending = false;
+    timer->heap_index = INVALID_HEAP_INDEX;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  if (deadline <= now) {
+    timer->pending = false;
+    timer->heap_index = INVALID_HEAP_INDEX;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
+    return;
+  }
+
+  timer_wheel* w = &g_wheels[gpr_cpu_current_cpu() % g_num_wheels];
+  gpr_mu_lock(&w->mu);
+  timer->pending = true;
+  if (w->count == 0) {
+    /* Nothing to run in the gap, so skip it rather than walk it later. */
+    w->current = std::max(w->current, now);
+  }
+  file_timer(w, timer);
+  w->count++;
+  bool is_first_timer =
+      deadline < w->min_deadline.load(std::memory_order_relaxed);
+  if (is_first_timer) {
+    w->min_deadline.store(deadline, std::memory_order_relaxed);
+  }
+  gpr_mu_unlock(&w->mu);
+
+  /* As in timer_generic.cc, the global minimum is lowered outside the wheel
+     lock. The checker holds g_mu while it recomputes the minimum, so this
+     either happens after it (and wins) or before it (and is seen by it). */
+  if (is_first_timer) {
+    gpr_mu_lock(&g_mu);
+    if (deadline < g_min_timer.load(std::memory_order_relaxed)) {
+      g_min_timer.store(deadline, std::memory_order_relaxed);
+      grpc_kick_poller();
+    }
+    gpr_mu_unlock(&g_mu);
+  }
+}
+
+static void timer_consume_kick(void) {
+  /* Force re-evaluation of last seen min */
+  g_last_seen_min_timer = 0;
+}
+
+static void timer_cancel(grpc_timer* timer) {
+  if (!g_initialized) {
+    /* must have already been cancelled, also the wheel mutex is invalid */
+    return;
+  }
+  if (timer->heap_index == INVALID_HEAP_INDEX) {
+    /* Ran as soon as it was set: it never reached a wheel. */
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+      gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=false", timer);
+    }
+    return;
+  }
+
+  timer_wheel* w = &g_wheels[timer->heap_index / NUM_SLOTS];
+  gpr_mu_lock(&w->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+
+  if (timer->pending) {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+    timer->pending = false;
+    unfile_timer(w, timer);
+    w->count--;
+  }
+  gpr_mu_unlock(&w->mu);
+}
+
+static grpc_timer_check_result run_some_expired_timers(
+    grpc_millis now, grpc_millis* next, grpc_error_handle error) {
+  grpc_timer_check_result result = GRPC_TIMERS_NOT_CHECKED;
+  grpc_millis min_timer = g_min_timer.load(std::memory_order_relaxed);
+  g_last_seen_min_timer = min_timer;
+
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    GRPC_ERROR_UNREF(error);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (gpr_spinlock_trylock(&g_checker_mu)) {
+    gpr_mu_lock(&g_mu);
+    result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+    grpc_millis new_min_timer = GRPC_MILLIS_INF_FUTURE;
+    for (size_t i = 0; i < g_num_wheels; i++) {
+      timer_wheel* w = &g_wheels[i];
+      if (w->min_deadline.load(std::memory_order_relaxed) > now) {
+        new_min_timer = std::min(
+            new_min_timer, w->min_deadline.load(std::memory_order_relaxed));
+        continue;
+      }
+      gpr_mu_lock(&w->mu);
+      size_t n = now == GRPC_MILLIS_INF_FUTURE ? fire_all(w, error)
+                                               : advance(w, now, error);
+      grpc_millis min_deadline = compute_min_deadline(w);
+      w->min_deadline.store(min_deadline, std::memory_order_relaxed);
+      gpr_mu_unlock(&w->mu);
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+        gpr_log(GPR_INFO,
+                "  .. wheel[%" PRIdPTR "] popped %" PRIdPTR
+                ", min_deadline --> %" PRId64,
+                i, n, min_deadline);
+      }
+      if (n > 0) result = GRPC_TIMERS_FIRED;
+      new_min_timer = std::min(new_min_timer, min_deadline);
+    }
+    if (next != nullptr) *next = std::min(*next, new_min_timer);
+    g_min_timer.store(new_min_timer, std::memory_order_relaxed);
+    gpr_mu_unlock(&g_mu);
+    gpr_spinlock_unlock(&g_checker_mu);
+  }
+
+  GRPC_ERROR_UNREF(error);
+
+  return result;
+}
+
+static grpc_timer_check_result timer_check(grpc_millis* next) {
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+
+  /* fetch from a thread-local first: this avoids contention on a globally
+     mutable cacheline in the common case */
+  grpc_millis min_timer = g_last_seen_min_timer;
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+      gpr_log(GPR_INFO, "TIMER CHECK SKIP: now=%" PRId64 " min_timer=%" PRId64,
+              now, min_timer);
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  grpc_error_handle shutdown_error =
+      now != GRPC_MILLIS_INF_FUTURE
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK BEGIN: now=%" PRId64 " min=%" PRId64, now,
+            min_timer);
+  }
+  grpc_timer_check_result r =
+      run_some_expired_timers(now, next, shutdown_error);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK END: r=%d", r);
+  }
+  return r;
+}
+
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
@@ -16,6 +16,8 @@
 
 #include "src/core/lib/resource_quota/memory_quota.h"
 
+#include <grpc/support/cpu.h>
+
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/promise/exec_ctx_wakeup_scheduler.h"
 #include "src/core/lib/promise/loop.h"
@@ -31,6 +33,12 @@ static constexpr size_t kMaxReplenishBytes = 1024 * 1024;
 // Minimum number of bytes an allocator will request from a quota in one step.
 static constexpr size_t kMinReplenishBytes = 4096;
 
+// Maximum number of bytes each CPU caches for a quota.
+static constexpr size_t kMaxCachedBytesPerShard = 256 * 1024;
+
+// The caches of all CPUs together hold at most this fraction of the quota.
+static constexpr size_t kCacheSlackDivisor = 16;
+
 //
 // Reclaimer
 //
@@ -287,6 +295,10 @@ void MemoryOwner::Rebind(MemoryQuota* quota) {
 // BasicMemoryQuota
 //
 
+BasicMemoryQuota::BasicMemoryQuota()
+    : num_shards_(std::max(1u, gpr_cpu_num_cores())),
+      shards_(new CacheShard[num_shards_]) {}
+
 class BasicMemoryQuota::WaitForSweepPromise {
  public:
   WaitForSweepPromise(std::shared_ptr<BasicMemoryQuota> memory_quota,
@@ -321,6 +333,12 @@ void BasicMemoryQuota::Start() {
         if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
           return Pending{};
         }
+        // Reservations cached on other CPUs are free too: collect them
+        // before asking anyone to give memory back.
+        self->DrainCaches();
+        if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
+          return Pending{};
+        }
         return 0;
       },
       [self]() {
@@ -361,10 +379,11 @@ void BasicMemoryQuota::SetSize(size_t new_size) {
   size_t old_size = quota_size_.exchange(new_size, std::memory_order_relaxed);
   if (old_size < new_size) {
     // We're growing the quota.
-    Return(new_size - old_size);
+    ReturnToQuota(new_size - old_size);
   } else {
-    // We're shrinking the quota.
-    Take(old_size - new_size);
+    // We're shrinking the quota, and so the bound on cached bytes.
+    TakeFromQuota(old_size - new_size);
+    DrainCaches();
   }
 }
 
@@ -372,6 +391,34 @@ void BasicMemoryQuota::Take(size_t amount) {
   // If there's a request for nothing, then do nothing!
   if (amount == 0) return;
   GPR_DEBUG_ASSERT(amount <= std::numeric_limits<intptr_t>::max());
+  const size_t max_cached = MaxCachedBytesPerShard();
+  if (amount <= max_cached) {
+    // Serve the request from this CPU's cache if we can.
+    CacheShard* shard = CurrentShard();
+    size_t cached = shard->cached_bytes.load(std::memory_order_relaxed);
+    while (cached >= amount) {
+      if (shard->cached_bytes.compare_exchange_weak(
+              cached, cached - amount, std::memory_order_relaxed,
+              std::memory_order_relaxed)) {
+        return;
+      }
+    }
+    // Otherwise refill the cache along with this request, unless the quota is
+    // close enough to its limit that caching could push it into overcommit.
+    const size_t refill = max_cached / 2;
+    const intptr_t free = free_bytes_.load(std::memory_order_relaxed);
+    if (free > 0 &&
+        static_cast<size_t>(free) > amount + refill + MaxCachedBytes()) {
+      TakeFromQuota(amount + refill);
+      if (!AddToCache(shard, refill, max_cached)) ReturnToQuota(refill);
+      return;
+    }
+  }
+  TakeFromQuota(amount);
+}
+
+void BasicMemoryQuota::TakeFromQuota(size_t amount) {
+  if (amount == 0) return;
   // Grab memory from the quota.
   auto prior = free_bytes_.fetch_sub(amount, std::memory_order_acq_rel);
   // If we push into overcommit, awake the reclaimer.
@@ -391,9 +438,61 @@ void BasicMemoryQuota::FinishReclamation(uint64_t token) {
 }
 
 void BasicMemoryQuota::Return(size_t amount) {
+  if (amount == 0) return;
+  const size_t max_cached = MaxCachedBytesPerShard();
+  if (amount <= max_cached && AddToCache(CurrentShard(), amount, max_cached)) {
+    return;
+  }
+  ReturnToQuota(amount);
+}
+
+void BasicMemoryQuota::ReturnToQuota(size_t amount) {
   free_bytes_.fetch_add(amount, std::memory_order_relaxed);
 }
 
+BasicMemoryQuota::CacheShard* BasicMemoryQuota::CurrentShard() {
+  return &shards_[gpr_cpu_current_cpu() % num_shards_];
+}
+
+size_t BasicMemoryQuota::MaxCachedBytesPerShard() const {
+  return std::min(kMaxCachedBytesPerShard,
+                  quota_size_.load(std::memory_order_relaxed) /
+                      (kCacheSlackDivisor * num_shards_));
+}
+
+size_t BasicMemoryQuota::MaxCachedBytes() const {
+  return MaxCachedBytesPerShard() * num_shards_;
+}
+
+bool BasicMemoryQuota::AddToCache(CacheShard* shard, size_t amount,
+                                  size_t max_cached) {
+  size_t cached = shard->cached_bytes.load(std::memory_order_relaxed);
+  while (cached + amount <= max_cached) {
+    if (shard->cached_bytes.compare_exchange_weak(cached, cached + amount,
+                                                  std::memory_order_relaxed,
+                                                  std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void BasicMemoryQuota::DrainCaches() {
+  size_t drained = 0;
+  for (size_t i = 0; i < num_shards_; i++) {
+    drained += shards_[i].cached_bytes.exchange(0, std::memory_order_relaxed);
+  }
+  ReturnToQuota(drained);
+}
+
+size_t BasicMemoryQuota::CachedBytes() const {
+  size_t cached = 0;
+  for (size_t i = 0; i < num_shards_; i++) {
+    cached += shards_[i].cached_bytes.load(std::memory_order_relaxed);
+  }
+  return cached;
+}
+
 size_t BasicMemoryQuota::InstantaneousPressure() const {
   double free = free_bytes_.load();
   if (free < 0) free = 0;
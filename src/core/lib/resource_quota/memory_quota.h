@@ -170,6 +170,8 @@ class ReclaimerQueue {
 class BasicMemoryQuota final
     : public std::enable_shared_from_this<BasicMemoryQuota> {
  public:
+  BasicMemoryQuota();
+
   // Start the reclamation activity.
   void Start();
   // Stop the reclamation activity.
@@ -189,6 +191,14 @@ class BasicMemoryQuota final
   void Return(size_t amount);
   // Instantaneous memory pressure approximation.
   size_t InstantaneousPressure() const;
+  // Return the reservations cached on every CPU to the quota.
+  void DrainCaches();
+  // Bytes currently cached on all CPUs: taken from the quota, but not yet
+  // handed out by Take().
+  size_t CachedBytes() const;
+  // Upper bound on CachedBytes(), and so on how far the quota may
+  // overestimate its usage.
+  size_t MaxCachedBytes() const;
   // Cancel a reclaimer
   ReclamationFunction CancelReclaimer(
       size_t reclaimer, typename ReclaimerQueue::Index index,
@@ -209,6 +219,22 @@ class BasicMemoryQuota final
 
   static constexpr intptr_t kInitialSize = std::numeric_limits<intptr_t>::max();
 
+  // Reservations taken from free_bytes_ in bulk, so that most calls to Take()
+  // and Return() only touch memory local to the current CPU.
+  struct CacheShard {
+    std::atomic<size_t> cached_bytes{0};
+    // Keep shards of neighbouring CPUs off each other's cache lines.
+    char padding[GPR_CACHELINE_SIZE];
+  };
+
+  CacheShard* CurrentShard();
+  size_t MaxCachedBytesPerShard() const;
+  // Add amount to shard's cache, if it fits under max_cached.
+  static bool AddToCache(CacheShard* shard, size_t amount, size_t max_cached);
+  // Take() and Return() against free_bytes_ directly.
+  void TakeFromQuota(size_t amount);
+  void ReturnToQuota(size_t amount);
+
   // The amount of memory that's free in this quota.
   // We use intptr_t as a reasonable proxy for ssize_t that's portable.
   // We allow arbitrary overcommit and so this must allow negative values.
@@ -228,6 +254,9 @@ class BasicMemoryQuota final
   // We also increment this counter on completion of a sweep, as an indicator
   // that the wait has ended.
   std::atomic<uint64_t> reclamation_counter_{0};
+  // Per-CPU reservation caches.
+  const size_t num_shards_;
+  std::unique_ptr<CacheShard[]> shards_;
 };
 
 // MemoryAllocatorImpl grants the owner the ability to allocate memory from an
@@ -23,10 +23,13 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/b64_simd.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 /* --- Constants. --- */
@@ -79,6 +82,9 @@ void grpc_base64_encode_core(char* result, const void* vdata, size_t data_size,
   const unsigned char* data = static_cast<const unsigned char*>(vdata);
   const char* base64_chars =
       url_safe ? base64_url_safe_chars : base64_url_unsafe_chars;
+  const grpc_core::Base64Alphabet alphabet =
+      url_safe ? grpc_core::Base64Alphabet::kUrlSafe
+               : grpc_core::Base64Alphabet::kStandard;
   const size_t result_projected_size =
       grpc_base64_estimate_encoded_size(data_size, multiline);
 
@@ -86,18 +92,36 @@ void grpc_base64_encode_core(char* result, const void* vdata, size_t data_size,
   size_t num_blocks = 0;
   size_t i = 0;
 
-  /* Encode each block. */
   while (data_size >= 3) {
-    *current++ = base64_chars[(data[i] >> 2) & 0x3F];
-    *current++ =
-        base64_chars[((data[i] & 0x03) << 4) | ((data[i + 1] >> 4) & 0x0F)];
-    *current++ =
-        base64_chars[((data[i + 1] & 0x0F) << 2) | ((data[i + 2] >> 6) & 0x03)];
-    *current++ = base64_chars[data[i + 2] & 0x3F];
+    /* Encode up to the end of the line, in bulk where the CPU allows. */
+    size_t run = data_size;
+    if (multiline) {
+      run = std::min(run,
+                     3 * (GRPC_BASE64_MULTILINE_NUM_BLOCKS - num_blocks));
+    }
+    const size_t bulk =
+        grpc_core::Base64EncodeBulk(data + i, run, current, alphabet);
+    current += bulk / 3 * 4;
+    data_size -= bulk;
+    i += bulk;
+    run -= bulk;
+    num_blocks += bulk / 3;
+
+    /* Encode each remaining block. */
+    for (; run >= 3; run -= 3) {
+      *current++ = base64_chars[(data[i] >> 2) & 0x3F];
+      *current++ =
+          base64_chars[((data[i] & 0x03) << 4) | ((data[i + 1] >> 4) & 0x0F)];
+      *current++ = base64_chars[((data[i + 1] & 0x0F) << 2) |
+                                ((data[i + 2] >> 6) & 0x03)];
+      *current++ = base64_chars[data[i + 2] & 0x3F];
 
-    data_size -= 3;
-    i += 3;
-    if (multiline && (++num_blocks == GRPC_BASE64_MULTILINE_NUM_BLOCKS)) {
+      data_size -= 3;
+      i += 3;
+      num_blocks++;
+    }
+
+    if (multiline && num_blocks == GRPC_BASE64_MULTILINE_NUM_BLOCKS) {
       *current++ = '\r';
       *current++ = '\n';
       num_blocks = 0;
@@ -192,11 +216,27 @@ grpc_slice grpc_base64_decode_with_len(const char* b64, size_t b64_len,
                                        int url_safe) {
   grpc_slice result = GRPC_SLICE_MALLOC(b64_len);
   unsigned char* current = GRPC_SLICE_START_PTR(result);
+  const size_t result_capacity = b64_len;
+  const grpc_core::Base64Alphabet alphabet =
+      url_safe ? grpc_core::Base64Alphabet::kUrlSafe
+               : grpc_core::Base64Alphabet::kStandard;
   size_t result_size = 0;
   unsigned char codes[4];
   size_t num_codes = 0;
 
-  while (b64_len--) {
+  while (b64_len > 0) {
+    if (num_codes == 0) {
+      /* Decode whole groups in bulk where the CPU allows, up to the next line
+         break, padding or invalid character. */
+      const size_t bulk = grpc_core::Base64DecodeBulk(
+          reinterpret_cast<const uint8_t*>(b64), b64_len,
+          current + result_size, result_capacity - result_size, alphabet);
+      b64 += bulk;
+      b64_len -= bulk;
+      result_size += bulk / 4 * 3;
+      if (b64_len == 0) break;
+    }
+    b64_len--;
     unsigned char c = static_cast<unsigned char>(*b64++);
     signed char code;
     if (c >= GPR_ARRAY_SIZE(base64_bytes)) continue;
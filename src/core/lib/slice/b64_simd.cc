@@ -0,0 +1,322 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/slice/b64_simd.h"
+
+#include <atomic>
+
+/* The kernels are compiled for their instruction set with target attributes
+   and picked at runtime, so the library itself keeps the baseline ISA. */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GRPC_BASE64_X86_SIMD
+#include <immintrin.h>
+#define GRPC_BASE64_SSE41 __attribute__((target("sse4.1")))
+#define GRPC_BASE64_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+std::atomic<int> g_limit{static_cast<int>(Base64Simd::kAvx2)};
+
+Base64Simd Detect() {
+#ifdef GRPC_BASE64_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return Base64Simd::kAvx2;
+  if (__builtin_cpu_supports("sse4.1")) return Base64Simd::kSse41;
+#endif
+  return Base64Simd::kNone;
+}
+
+Base64Simd ActiveLevel() {
+  const Base64Simd supported = Base64SimdSupported();
+  const Base64Simd limit =
+      static_cast<Base64Simd>(g_limit.load(std::memory_order_relaxed));
+  return limit < supported ? limit : supported;
+}
+
+#ifdef GRPC_BASE64_X86_SIMD
+
+enum class EncodeOutput { kStandard, kUrlSafe, kSextets };
+
+constexpr char B(int v) { return static_cast<char>(v); }
+
+/* Encoding follows Wojciech Mula's pshufb/multiply scheme: each 32 bit lane
+   gathers the 3 bytes of one group, and two multiplies move its four 6 bit
+   fields into the four bytes of the lane, in output order. */
+GRPC_BASE64_SSE41 inline __m128i SplitLanes128(__m128i in) {
+  in = _mm_shuffle_epi8(
+      in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+/* Per 6 bit value, the offset that turns it into its character, indexed by
+   the value's range: 0 for 26-51, 1-10 for digits, 11 and 12 for the last two
+   characters and 13 for A-Z. */
+template <EncodeOutput kOutput>
+GRPC_BASE64_SSE41 inline __m128i EncodeOffsets128() {
+  const char c62 = kOutput == EncodeOutput::kUrlSafe ? '-' : '+';
+  const char c63 = kOutput == EncodeOutput::kUrlSafe ? '_' : '/';
+  return _mm_setr_epi8(B('a' - 26), B('0' - 52), B('0' - 52), B('0' - 52),
+                       B('0' - 52), B('0' - 52), B('0' - 52), B('0' - 52),
+                       B('0' - 52), B('0' - 52), B('0' - 52), B(c62 - 62),
+                       B(c63 - 63), 'A', 0, 0);
+}
+
+template <EncodeOutput kOutput>
+GRPC_BASE64_SSE41 inline __m128i Encode128(__m128i in) {
+  const __m128i values = SplitLanes128(in);
+  if (kOutput == EncodeOutput::kSextets) return values;
+  __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+  const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), values);
+  range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+  return _mm_add_epi8(
+      values, _mm_shuffle_epi8(EncodeOffsets128<kOutput>(), range));
+}
+
+template <EncodeOutput kOutput>
+GRPC_BASE64_SSE41 size_t EncodeSse41(const uint8_t* in, size_t in_len,
+                                     uint8_t* out) {
+  size_t consumed = 0;
+  /* 16 bytes are loaded to encode 12 */
+  while (in_len - consumed >= 16) {
+    const __m128i chars = Encode128<kOutput>(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + consumed)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+    consumed += 12;
+    out += 16;
+  }
+  return consumed;
+}
+
+template <EncodeOutput kOutput>
+GRPC_BASE64_AVX2 size_t EncodeAvx2(const uint8_t* in, size_t in_len,
+                                   uint8_t* out) {
+  size_t consumed = 0;
+  const __m256i shuffle = _mm256_setr_epi8(
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4,
+      7, 6, 8, 7, 10, 9, 11, 10);
+  const __m256i offsets =
+      _mm256_broadcastsi128_si256(EncodeOffsets128<kOutput>());
+  /* Each 128 bit lane encodes 12 bytes, the upper one loaded from 12 bytes
+     in, so 28 bytes are loaded to encode 24 */
+  while (in_len - consumed >= 28) {
+    const uint8_t* p = in + consumed;
+    __m256i v = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12)), 1);
+    v = _mm256_shuffle_epi8(v, shuffle);
+    const __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    __m256i values = _mm256_or_si256(t1, t3);
+    if (kOutput != EncodeOutput::kSextets) {
+      __m256i range = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+      const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), values);
+      range =
+          _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+      values = _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, range));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), values);
+    consumed += 24;
+    out += 32;
+  }
+  /* The 16 byte steps are not VEX encoded, so clear the upper halves first to
+     avoid the AVX-SSE transition penalty */
+  _mm256_zeroupper();
+  return consumed + EncodeSse41<kOutput>(in + consumed, in_len - consumed, out);
+}
+
+/* Decoding follows Wojciech Mula's pshufb bitmask scheme. A character is
+   valid if the bit for its high nibble is set in the mask looked up by its
+   low nibble; its value is the character plus an offset looked up by the
+   high nibble, except for the one character (63) whose high nibble is shared
+   with characters needing a different offset. Then two multiply-adds pack
+   each group of four 6 bit values into 3 bytes. */
+struct DecodeTables128 {
+  __m128i offsets;
+  __m128i masks;
+  __m128i bits;
+  __m128i c63;
+  __m128i c63_offset;
+};
+
+GRPC_BASE64_SSE41 inline DecodeTables128
+MakeDecodeTables128(Base64Alphabet alphabet) {
+  const bool url_safe = alphabet == Base64Alphabet::kUrlSafe;
+  DecodeTables128 t;
+  t.offsets = _mm_setr_epi8(0, 0, url_safe ? 17 : 19, 4, -65, -65, -71, -71, 0,
+                            0, 0, 0, 0, 0, 0, 0);
+  t.masks = _mm_setr_epi8(B(0xa8), B(0xf8), B(0xf8), B(0xf8), B(0xf8),
+                          B(0xf8), B(0xf8), B(0xf8), B(0xf8), B(0xf8),
+                          B(0xf0), B(url_safe ? 0x50 : 0x54), B(0x50),
+                          B(url_safe ? 0x54 : 0x50), B(0x50),
+                          B(url_safe ? 0x70 : 0x54));
+  t.bits = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, B(0x80), 0,
+                         0, 0, 0, 0, 0, 0, 0);
+  t.c63 = _mm_set1_epi8(url_safe ? '_' : '/');
+  t.c63_offset = _mm_set1_epi8(url_safe ? 63 - '_' : 63 - '/');
+  return t;
+}
+
+GRPC_BASE64_SSE41 size_t DecodeSse41(const uint8_t* in, size_t in_len,
+                                     uint8_t* out, size_t out_len,
+                                     Base64Alphabet alphabet) {
+  const DecodeTables128 t = MakeDecodeTables128(alphabet);
+  const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                     -1, -1, -1, -1);
+  size_t consumed = 0;
+  size_t produced = 0;
+  /* 16 bytes are stored to produce 12 */
+  while (in_len - consumed >= 16 && out_len - produced >= 16) {
+    const __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + consumed));
+    const __m128i hi =
+        _mm_and_si128(_mm_srli_epi32(chars, 4), _mm_set1_epi8(0x0f));
+    const __m128i lo = _mm_and_si128(chars, _mm_set1_epi8(0x0f));
+    const __m128i valid = _mm_and_si128(_mm_shuffle_epi8(t.masks, lo),
+                                        _mm_shuffle_epi8(t.bits, hi));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(valid, _mm_setzero_si128())) != 0) {
+      break;
+    }
+    const __m128i offsets =
+        _mm_blendv_epi8(_mm_shuffle_epi8(t.offsets, hi), t.c63_offset,
+                        _mm_cmpeq_epi8(chars, t.c63));
+    const __m128i values = _mm_add_epi8(chars, offsets);
+    const __m128i merged = _mm_madd_epi16(
+        _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)),
+        _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + produced),
+                     _mm_shuffle_epi8(merged, pack));
+    consumed += 16;
+    produced += 12;
+  }
+  return consumed;
+}
+
+GRPC_BASE64_AVX2 size_t DecodeAvx2(const uint8_t* in, size_t in_len,
+                                   uint8_t* out, size_t out_len,
+                                   Base64Alphabet alphabet) {
+  const DecodeTables128 t = MakeDecodeTables128(alphabet);
+  const __m256i offset_table = _mm256_broadcastsi128_si256(t.offsets);
+  const __m256i mask_table = _mm256_broadcastsi128_si256(t.masks);
+  const __m256i bit_table = _mm256_broadcastsi128_si256(t.bits);
+  const __m256i c63 = _mm256_broadcastsi128_si256(t.c63);
+  const __m256i c63_offset = _mm256_broadcastsi128_si256(t.c63_offset);
+  const __m256i pack = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4,
+      10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m256i join = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+  size_t consumed = 0;
+  size_t produced = 0;
+  /* 32 bytes are stored to produce 24 */
+  while (in_len - consumed >= 32 && out_len - produced >= 32) {
+    const __m256i chars =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + consumed));
+    const __m256i hi =
+        _mm256_and_si256(_mm256_srli_epi32(chars, 4), _mm256_set1_epi8(0x0f));
+    const __m256i lo = _mm256_and_si256(chars, _mm256_set1_epi8(0x0f));
+    const __m256i valid = _mm256_and_si256(_mm256_shuffle_epi8(mask_table, lo),
+                                           _mm256_shuffle_epi8(bit_table, hi));
+    if (_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(valid, _mm256_setzero_si256())) != 0) {
+      break;
+    }
+    const __m256i offsets =
+        _mm256_blendv_epi8(_mm256_shuffle_epi8(offset_table, hi), c63_offset,
+                           _mm256_cmpeq_epi8(chars, c63));
+    const __m256i values = _mm256_add_epi8(chars, offsets);
+    const __m256i merged = _mm256_madd_epi16(
+        _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+        _mm256_set1_epi32(0x00011000));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(out + produced),
+        _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, pack), join));
+    consumed += 32;
+    produced += 24;
+  }
+  /* Finish with 16 byte steps, which also retries the half of a step that
+     stopped on an invalid character */
+  _mm256_zeroupper();
+  return consumed + DecodeSse41(in + consumed, in_len - consumed,
+                                out + produced, out_len - produced, alphabet);
+}
+
+#endif /* GRPC_BASE64_X86_SIMD */
+
+template <EncodeOutput kOutput>
+size_t EncodeBulk(const uint8_t* in, size_t in_len, uint8_t* out) {
+  switch (ActiveLevel()) {
+#ifdef GRPC_BASE64_X86_SIMD
+    case Base64Simd::kAvx2:
+      return EncodeAvx2<kOutput>(in, in_len, out);
+    case Base64Simd::kSse41:
+      return EncodeSse41<kOutput>(in, in_len, out);
+#endif
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+Base64Simd Base64SimdSupported() {
+  static const Base64Simd supported = Detect();
+  return supported;
+}
+
+void Base64SimdSetLimit(Base64Simd level) {
+  g_limit.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+size_t Base64EncodeBulk(const uint8_t* in, size_t in_len, char* out,
+                        Base64Alphabet alphabet) {
+  uint8_t* out_bytes = reinterpret_cast<uint8_t*>(out);
+  return alphabet == Base64Alphabet::kUrlSafe
+             ? EncodeBulk<EncodeOutput::kUrlSafe>(in, in_len, out_bytes)
+             : EncodeBulk<EncodeOutput::kStandard>(in, in_len, out_bytes);
+}
+
+size_t Base64SplitBulk(const uint8_t* in, size_t in_len, uint8_t* out) {
+  return EncodeBulk<EncodeOutput::kSextets>(in, in_len, out);
+}
+
+size_t Base64DecodeBulk(const uint8_t* in, size_t in_len, uint8_t* out,
+                        size_t out_len, Base64Alphabet alphabet) {
+  switch (ActiveLevel()) {
+#ifdef GRPC_BASE64_X86_SIMD
+    case Base64Simd::kAvx2:
+      return DecodeAvx2(in, in_len, out, out_len, alphabet);
+    case Base64Simd::kSse41:
+      return DecodeSse41(in, in_len, out, out_len, alphabet);
+#endif
+    default:
+      return 0;
+  }
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,81 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_SLICE_B64_SIMD_H
+#define GRPC_CORE_LIB_SLICE_B64_SIMD_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Vectorized bulk base64 kernels shared by the base64 helpers in b64.cc and
+   the chttp2 binary metadata encoder and decoder.
+
+   Each function processes as much of its input as the kernel for the running
+   CPU can handle in whole vector steps and returns how much it consumed; the
+   caller's scalar loop finishes the rest, including the tail, padding and
+   error reporting. Where no kernel is available (non-x86 builds, or a CPU
+   without SSE4.1) they consume nothing. */
+
+namespace grpc_core {
+
+enum class Base64Alphabet {
+  kStandard, /* RFC 4648 section 4: "+/" */
+  kUrlSafe,  /* RFC 4648 section 5: "-_" */
+};
+
+/* Instruction sets the kernels are written for, in increasing order. */
+enum class Base64Simd {
+  kNone,
+  kSse41,
+  kAvx2,
+};
+
+/* The best kernel set the running CPU supports. */
+Base64Simd Base64SimdSupported();
+
+/* Restricts the kernels in use to at most |level| (and at most what the CPU
+   supports). For tests and benchmarks comparing kernels against each other
+   and against the scalar code. */
+void Base64SimdSetLimit(Base64Simd level);
+
+/* Encodes whole 3 byte groups from the start of |in|. Writes 4 characters of
+   |alphabet| to |out| per group and returns the number of input bytes
+   consumed, a multiple of 3. May read, but never consumes, up to 4 bytes past
+   what it consumes, always within |in_len|. */
+size_t Base64EncodeBulk(const uint8_t* in, size_t in_len, char* out,
+                        Base64Alphabet alphabet);
+
+/* Same as Base64EncodeBulk, but writes the 6 bit value of each output symbol
+   (0-63) rather than its character, for encoders that map symbols on their own
+   (e.g. straight to HPACK Huffman codes). */
+size_t Base64SplitBulk(const uint8_t* in, size_t in_len, uint8_t* out);
+
+/* Decodes whole 4 character groups from the start of |in|, writing 3 bytes to
+   |out| per group. Stops before the first vector step that contains anything
+   but characters of |alphabet| (padding, line breaks or invalid input) or that
+   could write past |out_len|; the kernels store whole vectors, so up to 8
+   bytes past what they produce may be overwritten. Returns the number of
+   characters consumed, a multiple of 4. */
+size_t Base64DecodeBulk(const uint8_t* in, size_t in_len, uint8_t* out,
+                        size_t out_len, Base64Alphabet alphabet);
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_SLICE_B64_SIMD_H */
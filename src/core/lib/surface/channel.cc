@@ -97,6 +97,12 @@ grpc_channel* grpc_channel_create_with_builder(
   channel->preallocated_bytes = preallocated_bytes;
   channel->is_client = grpc_channel_stack_type_is_client(channel_stack_type);
   channel->registration_table.Init();
+  channel->arena_pool.Init();
+  channel->arena_pool_quota =
+      resource_user != nullptr
+          ? grpc_resource_quota_ref_internal(
+                grpc_resource_user_quota(resource_user))
+          : grpc_resource_quota_from_channel_args(args, /*create=*/false);
 
   gpr_atm_no_barrier_store(
       &channel->call_size_estimate,
@@ -329,6 +335,33 @@ void grpc_channel_update_call_size_estimate(grpc_channel* channel,
   }
 }
 
+/* Memory pressure above which call arenas are freed instead of pooled */
+#define ARENA_POOL_TRIM_PRESSURE 0.8
+
+std::pair<grpc_core::Arena*, void*> grpc_channel_create_call_arena(
+    grpc_channel* channel, size_t initial_size, size_t alloc_size) {
+  bool reused = false;
+  std::pair<grpc_core::Arena*, void*> arena_with_alloc =
+      channel->arena_pool->CreateWithAlloc(initial_size, alloc_size, &reused);
+  if (reused) {
+    GRPC_STATS_INC_ARENA_POOL_HITS();
+  } else if (initial_size >= grpc_core::ArenaPool::kMinPooledSize &&
+             initial_size <= grpc_core::ArenaPool::kMaxPooledSize) {
+    GRPC_STATS_INC_ARENA_POOL_MISSES();
+  }
+  return arena_with_alloc;
+}
+
+void grpc_channel_destroy_call_arena(grpc_channel* channel,
+                                     grpc_core::Arena* arena) {
+  const bool trim =
+      channel->arena_pool_quota != nullptr &&
+      grpc_resource_quota_get_memory_pressure(channel->arena_pool_quota) >
+          ARENA_POOL_TRIM_PRESSURE;
+  grpc_channel_update_call_size_estimate(
+      channel, channel->arena_pool->Destroy(arena, trim));
+}
+
 char* grpc_channel_get_target(grpc_channel* channel) {
   GRPC_API_TRACE("grpc_channel_get_target(channel=%p)", 1, (channel));
   return gpr_strdup(channel->target);
@@ -504,6 +537,10 @@ static void destroy_channel(void* arg, grpc_error_handle /*error*/) {
   }
   grpc_channel_stack_destroy(CHANNEL_STACK_FROM_CHANNEL(channel));
   channel->registration_table.Destroy();
+  channel->arena_pool.Destroy();
+  if (channel->arena_pool_quota != nullptr) {
+    grpc_resource_quota_unref_internal(channel->arena_pool_quota);
+  }
   if (channel->resource_user != nullptr) {
     if (channel->preallocated_bytes > 0) {
       grpc_resource_user_free(channel->resource_user,
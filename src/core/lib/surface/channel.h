@@ -22,10 +22,12 @@
 #include <grpc/support/port_platform.h>
 
 #include <map>
+#include <utility>
 
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gprpp/arena.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 #include "src/core/lib/transport/metadata.h"
@@ -79,6 +81,16 @@ grpc_core::channelz::ChannelNode* grpc_channel_get_channelz_node(
 size_t grpc_channel_get_call_size_estimate(grpc_channel* channel);
 void grpc_channel_update_call_size_estimate(grpc_channel* channel, size_t size);
 
+/** Creates the arena for a call on \a channel, with \a initial_size bytes in
+    the first zone and an initial allocation of \a alloc_size bytes, reusing
+    the memory of earlier calls' arenas when possible. */
+std::pair<grpc_core::Arena*, void*> grpc_channel_create_call_arena(
+    grpc_channel* channel, size_t initial_size, size_t alloc_size);
+/** Destroys an arena from grpc_channel_create_call_arena(), and updates the
+    call size estimate with the bytes it allocated. */
+void grpc_channel_destroy_call_arena(grpc_channel* channel,
+                                     grpc_core::Arena* arena);
+
 namespace grpc_core {
 
 struct RegisteredCall {
@@ -112,6 +124,11 @@ struct grpc_channel {
   grpc_resource_user* resource_user;
   size_t preallocated_bytes;
 
+  // Recycles call arenas.  It keeps at most ArenaPool::kMaxPooledBytes, and
+  // is emptied when arena_pool_quota, if any, is under memory pressure.
+  grpc_core::ManualConstructor<grpc_core::ArenaPool> arena_pool;
+  grpc_resource_quota* arena_pool_quota;
+
   // TODO(vjpai): Once the grpc_channel is allocated via new rather than malloc,
   //              expand the members of the CallRegistrationTable directly into
   //              the grpc_channel. For now it is kept separate so that all the
@@ -26,6 +26,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 namespace grpc_core {
@@ -96,6 +97,56 @@ void ByteStreamCache::Destroy() {
   }
 }
 
+bool ByteStreamCache::Fill() {
+  while (underlying_stream_ != nullptr) {
+    if (cache_buffer_.length == length_) {
+      underlying_stream_.reset();
+      break;
+    }
+    if (!UnderlyingNext(length_ - cache_buffer_.length,
+                        /*on_complete=*/nullptr)) {
+      return false;
+    }
+    grpc_slice slice;
+    grpc_error_handle error = underlying_stream_->Pull(&slice);
+    if (error != GRPC_ERROR_NONE) {
+      // Leave the error for the CachingByteStreams to report.
+      GRPC_ERROR_UNREF(error);
+      return false;
+    }
+    grpc_slice_buffer_add_indexed(&cache_buffer_, slice);
+  }
+  return true;
+}
+
+bool ByteStreamCache::UnderlyingNext(size_t max_size_hint,
+                                     grpc_closure* on_complete) {
+  if (!next_pending_) {
+    GRPC_CLOSURE_INIT(&on_next_done_, OnUnderlyingNextDone, this,
+                      grpc_schedule_on_exec_ctx);
+    if (underlying_stream_->Next(max_size_hint, &on_next_done_)) return true;
+    next_pending_ = true;
+  }
+  if (on_complete != nullptr) {
+    grpc_closure_list_append(&next_waiters_, on_complete, GRPC_ERROR_NONE);
+  }
+  return false;
+}
+
+void ByteStreamCache::OnUnderlyingNextDone(void* arg,
+                                           grpc_error_handle error) {
+  ByteStreamCache* cache = static_cast<ByteStreamCache*>(arg);
+  cache->next_pending_ = false;
+  // Whichever waiter pulls first caches the data for the others.
+  grpc_closure* closure = cache->next_waiters_.head;
+  cache->next_waiters_ = GRPC_CLOSURE_LIST_INIT;
+  while (closure != nullptr) {
+    grpc_closure* next = closure->next_data.next;
+    ExecCtx::Run(DEBUG_LOCATION, closure, GRPC_ERROR_REF(error));
+    closure = next;
+  }
+}
+
 //
 // ByteStreamCache::CachingByteStream
 //
@@ -118,7 +169,7 @@ bool ByteStreamCache::CachingByteStream::Next(size_t max_size_hint,
   if (shutdown_error_ != GRPC_ERROR_NONE) return true;
   if (cursor_ < cache_->cache_buffer_.count) return true;
   GPR_ASSERT(cache_->underlying_stream_ != nullptr);
-  return cache_->underlying_stream_->Next(max_size_hint, on_complete);
+  return cache_->UnderlyingNext(max_size_hint, on_complete);
 }
 
 grpc_error_handle ByteStreamCache::CachingByteStream::Pull(grpc_slice* slice) {
@@ -134,8 +185,10 @@ grpc_error_handle ByteStreamCache::CachingByteStream::Pull(grpc_slice* slice) {
   GPR_ASSERT(cache_->underlying_stream_ != nullptr);
   grpc_error_handle error = cache_->underlying_stream_->Pull(slice);
   if (error == GRPC_ERROR_NONE) {
-    grpc_slice_buffer_add(&cache_->cache_buffer_,
-                          grpc_slice_ref_internal(*slice));
+    // Keep each slice as its own entry, so that replays hand out refs to
+    // the original slices and the cursor stays in step with the cache.
+    grpc_slice_buffer_add_indexed(&cache_->cache_buffer_,
+                                  grpc_slice_ref_internal(*slice));
     ++cursor_;
     offset_ += GRPC_SLICE_LENGTH(*slice);
     // Orphan the underlying stream if it's been drained.
@@ -116,9 +116,11 @@ class SliceBufferByteStream : public ByteStream {
 // return whatever is in the backing buffer before continuing to read the
 // underlying stream.
 //
-// NOTE: No synchronization is done, so it is not safe to have multiple
-// CachingByteStreams simultaneously drawing from the same underlying
-// ByteStreamCache at the same time.
+// NOTE: No synchronization is done, so CachingByteStreams drawing from
+// the same ByteStreamCache must be serialized externally (e.g., by a call
+// combiner).  With that, any number of them may read at the same time:
+// while the underlying stream has a Next() outstanding, the others wait
+// for it rather than issuing their own.
 //
 
 class ByteStreamCache {
@@ -152,13 +154,30 @@ class ByteStreamCache {
   // Must not be destroyed while still in use by a CachingByteStream.
   void Destroy();
 
+  // Reads as much of the underlying stream into the cache as it can return
+  // without waiting, as a SliceBufferByteStream returns all of its data.
+  // Returns true if the whole stream is now cached.  Otherwise the rest is
+  // cached lazily, as CachingByteStreams read it.
+  bool Fill();
+
   grpc_slice_buffer* cache_buffer() { return &cache_buffer_; }
 
  private:
+  // Calls Next() on the underlying stream unless a call is already
+  // outstanding.  If it would block, \a on_complete, if not null, is
+  // scheduled once the outstanding call completes.
+  bool UnderlyingNext(size_t max_size_hint, grpc_closure* on_complete);
+  static void OnUnderlyingNextDone(void* arg, grpc_error_handle error);
+
   OrphanablePtr<ByteStream> underlying_stream_;
   uint32_t length_;
   uint32_t flags_;
   grpc_slice_buffer cache_buffer_;
+  // Outstanding Next() on the underlying stream, and the closures of the
+  // CachingByteStreams waiting for it.
+  bool next_pending_ = false;
+  grpc_closure on_next_done_;
+  grpc_closure_list next_waiters_ = GRPC_CLOSURE_LIST_INIT;
 };
 
 }  // namespace grpc_core
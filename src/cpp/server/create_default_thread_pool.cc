@@ -16,18 +16,35 @@
  *
  */
 
+#include <string.h>
+
 #include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/cpp/server/dynamic_thread_pool.h"
+#include "src/cpp/server/work_stealing_thread_pool.h"
 
 #ifndef GRPC_CUSTOM_DEFAULT_THREAD_POOL
 
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_cpp_thread_pool, "dynamic",
+    "Declares which thread pool implementation backs the default C++ thread "
+    "pool: 'dynamic' or 'work_stealing'.")
+
 namespace grpc {
 namespace {
 
 ThreadPoolInterface* CreateDefaultThreadPoolImpl() {
   int cores = gpr_cpu_num_cores();
   if (!cores) cores = 4;
+  grpc_core::UniquePtr<char> pool = GPR_GLOBAL_CONFIG_GET(grpc_cpp_thread_pool);
+  if (strcmp(pool.get(), "work_stealing") == 0) {
+    return new WorkStealingThreadPool(cores);
+  }
+  if (strcmp(pool.get(), "dynamic") != 0) {
+    gpr_log(GPR_ERROR, "Unknown thread pool '%s', using 'dynamic'", pool.get());
+  }
   return new DynamicThreadPool(cores);
 }
 
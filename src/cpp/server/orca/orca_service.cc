@@ -0,0 +1,243 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "google/protobuf/duration.upb.h"
+#include "upb/upb.hpp"
+#include "xds/data/orca/v3/orca_load_report.upb.h"
+#include "xds/service/orca/v3/orca.upb.h"
+
+#include <grpc/support/time.h>
+#include <grpcpp/alarm.h>
+#include <grpcpp/ext/orca_service.h>
+#include <grpcpp/impl/codegen/server_callback_handlers.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+
+#include "src/cpp/server/load_reporter/get_cpu_stats.h"
+
+namespace grpc {
+namespace experimental {
+
+namespace {
+
+constexpr char kStreamCoreMetricsMethod[] =
+    "/xds.service.orca.v3.OpenRcaService/StreamCoreMetrics";
+
+// Returns the fraction of the system's memory in use, or 0 if unknown.
+double GetMemoryUtilization() {
+#ifdef GPR_LINUX
+  FILE* fp = fopen("/proc/meminfo", "r");
+  if (fp == nullptr) return 0;
+  uint64_t total = 0, available = 0;
+  char line[256];
+  while (fgets(line, sizeof(line), fp) != nullptr) {
+    uint64_t value;
+    if (sscanf(line, "MemTotal: %" SCNu64, &value) == 1) {
+      total = value;
+    } else if (sscanf(line, "MemAvailable: %" SCNu64, &value) == 1) {
+      available = value;
+    }
+  }
+  fclose(fp);
+  if (total == 0 || available > total) return 0;
+  return static_cast<double>(total - available) / total;
+#else
+  return 0;
+#endif
+}
+
+}  // namespace
+
+//
+// OrcaService::Reactor
+//
+
+// Sends a report when the stream starts, and another every report interval
+// after the previous one has been written.  Exactly one of a write and the
+// alarm is pending at any time, so whichever completes after the stream
+// is cancelled finishes it.
+class OrcaService::Reactor : public ServerWriteReactor<ByteBuffer> {
+ public:
+  Reactor(OrcaService* service, const ByteBuffer* request)
+      : service_(service) {
+    if (!ParseRequest(request)) {
+      Finish(Status(StatusCode::INVALID_ARGUMENT,
+                    "could not parse OrcaLoadReportRequest"));
+      return;
+    }
+    SendReport();
+  }
+
+  void OnWriteDone(bool ok) override {
+    if (!ok) {
+      Finish(Status(StatusCode::UNKNOWN, "failed to write load report"));
+      return;
+    }
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (!cancelled_) {
+        // A fresh alarm each time: the previous one may still be running
+        // the callback that started this write.
+        alarm_ = absl::make_unique<Alarm>();
+        alarm_->Set(
+            gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                         gpr_time_from_millis(report_interval_ms_,
+                                              GPR_TIMESPAN)),
+            [this](bool ok) { OnAlarm(ok); });
+        return;
+      }
+    }
+    Finish(Status::CANCELLED);
+  }
+
+  void OnCancel() override {
+    grpc::internal::MutexLock lock(&mu_);
+    cancelled_ = true;
+    if (alarm_ != nullptr) alarm_->Cancel();
+  }
+
+  void OnDone() override { delete this; }
+
+ private:
+  bool ParseRequest(const ByteBuffer* request) {
+    Slice slice;
+    if (!request->DumpToSingleSlice(&slice).ok()) return false;
+    upb::Arena arena;
+    xds_service_orca_v3_OrcaLoadReportRequest* msg =
+        xds_service_orca_v3_OrcaLoadReportRequest_parse(
+            reinterpret_cast<const char*>(slice.begin()), slice.size(),
+            arena.ptr());
+    if (msg == nullptr) return false;
+    int64_t interval_ms = 0;
+    const google_protobuf_Duration* interval =
+        xds_service_orca_v3_OrcaLoadReportRequest_report_interval(msg);
+    if (interval != nullptr) {
+      interval_ms = google_protobuf_Duration_seconds(interval) * GPR_MS_PER_SEC +
+                    google_protobuf_Duration_nanos(interval) / GPR_NS_PER_MS;
+    }
+    report_interval_ms_ =
+        std::max(interval_ms, service_->min_report_interval_ms_);
+    return true;
+  }
+
+  void SendReport() {
+    std::string report = service_->GetSerializedLoadReport();
+    Slice slice(report.data(), report.size());
+    response_ = ByteBuffer(&slice, 1);
+    StartWrite(&response_);
+  }
+
+  void OnAlarm(bool ok) {
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      if (cancelled_) ok = false;
+    }
+    if (!ok) {
+      Finish(Status::CANCELLED);
+      return;
+    }
+    SendReport();
+  }
+
+  OrcaService* service_;
+  int64_t report_interval_ms_ = 0;
+  ByteBuffer response_;
+
+  grpc::internal::Mutex mu_;
+  bool cancelled_ ABSL_GUARDED_BY(mu_) = false;
+  std::unique_ptr<Alarm> alarm_ ABSL_GUARDED_BY(mu_);
+};
+
+//
+// OrcaService
+//
+
+OrcaService::OrcaService(OrcaService::Options options)
+    : min_report_interval_ms_(options.min_report_interval_ms) {
+  AddMethod(new internal::RpcServiceMethod(
+      kStreamCoreMetricsMethod, internal::RpcMethod::SERVER_STREAMING,
+      nullptr));
+  MarkMethodCallback(
+      0, new internal::CallbackServerStreamingHandler<ByteBuffer, ByteBuffer>(
+             [this](CallbackServerContext* /*context*/,
+                    const ByteBuffer* request) {
+               return new Reactor(this, request);
+             }));
+}
+
+void OrcaService::SetRequestsPerSecond(uint64_t requests_per_second) {
+  grpc::internal::MutexLock lock(&mu_);
+  requests_per_second_ = requests_per_second;
+}
+
+void OrcaService::SetNamedUtilization(const std::string& name,
+                                      double utilization) {
+  grpc::internal::MutexLock lock(&mu_);
+  named_utilization_[name] = utilization;
+}
+
+void OrcaService::DeleteNamedUtilization(const std::string& name) {
+  grpc::internal::MutexLock lock(&mu_);
+  named_utilization_.erase(name);
+}
+
+std::string OrcaService::GetSerializedLoadReport() {
+  const std::pair<uint64_t, uint64_t> cpu_stats =
+      load_reporter::GetCpuStatsImpl();
+  const double mem_utilization = GetMemoryUtilization();
+  upb::Arena arena;
+  xds_data_orca_v3_OrcaLoadReport* report =
+      xds_data_orca_v3_OrcaLoadReport_new(arena.ptr());
+  grpc::internal::MutexLock lock(&mu_);
+  // The counters are cumulative, so the utilization is taken over the time
+  // since the previous sample, from whichever stream took it.
+  if (cpu_stats.second > last_cpu_total_ &&
+      cpu_stats.first >= last_cpu_busy_) {
+    cpu_utilization_ =
+        static_cast<double>(cpu_stats.first - last_cpu_busy_) /
+        (cpu_stats.second - last_cpu_total_);
+    last_cpu_busy_ = cpu_stats.first;
+    last_cpu_total_ = cpu_stats.second;
+  }
+  xds_data_orca_v3_OrcaLoadReport_set_cpu_utilization(report,
+                                                      cpu_utilization_);
+  xds_data_orca_v3_OrcaLoadReport_set_mem_utilization(report,
+                                                      mem_utilization);
+  xds_data_orca_v3_OrcaLoadReport_set_rps(report, requests_per_second_);
+  for (const auto& p : named_utilization_) {
+    xds_data_orca_v3_OrcaLoadReport_utilization_set(
+        report, upb_strview_make(p.first.data(), p.first.size()), p.second,
+        arena.ptr());
+  }
+  size_t length;
+  char* buf =
+      xds_data_orca_v3_OrcaLoadReport_serialize(report, arena.ptr(), &length);
+  return std::string(buf, length);
+}
+
+}  // namespace experimental
+}  // namespace grpc
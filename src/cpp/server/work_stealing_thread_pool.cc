@@ -0,0 +1,251 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/cpp/server/work_stealing_thread_pool.h"
+
+#include <thread>
+
+#include "absl/time/time.h"
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+namespace grpc {
+
+ABSL_CONST_INIT GPR_THREAD_LOCAL(WorkStealingThreadPool::Worker*)
+    WorkStealingThreadPool::current_worker_ = nullptr;
+
+WorkStealingThreadPool::Helper::Helper(WorkStealingThreadPool* pool)
+    : pool_(pool),
+      thd_(
+          "grpcpp_ws_pool_helper",
+          [](void* arg) { static_cast<Helper*>(arg)->ThreadFunc(); }, this) {
+  thd_.Start();
+}
+
+WorkStealingThreadPool::Helper::~Helper() { thd_.Join(); }
+
+void WorkStealingThreadPool::Helper::ThreadFunc() {
+  const size_t index = gpr_cpu_current_cpu() % pool_->workers_.size();
+  std::function<void()> callback;
+  // StartHelper() counted us as searching, so that Add() calls made while we
+  // start up do not start more helpers.
+  bool searching = true;
+  for (;;) {
+    if (pool_->FindWork(nullptr, index, searching, &callback)) {
+      callback();
+      callback = nullptr;
+    } else if (!pool_->Park(/*with_timeout=*/true)) {
+      break;
+    }
+    searching = false;
+  }
+  grpc_core::MutexLock lock(&pool_->helpers_mu_);
+  pool_->num_helpers_--;
+  // The next StartHelper() or the destructor joins us.
+  pool_->dead_helpers_.push_back(this);
+  if (pool_->shutdown_.load() && pool_->num_helpers_ == 0) {
+    pool_->helpers_cv_.Signal();
+  }
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(int num_threads) {
+  GPR_ASSERT(num_threads > 0);
+  workers_.reserve(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    workers_.emplace_back(new Worker);
+    workers_.back()->pool = this;
+    workers_.back()->index = i;
+  }
+  // Start the threads only once workers_ is complete: they scan all of it.
+  for (auto& worker : workers_) {
+    worker->thd = grpc_core::Thread(
+        "grpcpp_ws_pool",
+        [](void* arg) {
+          Worker* worker = static_cast<Worker*>(arg);
+          worker->pool->ThreadFunc(worker);
+        },
+        worker.get());
+    worker->thd.Start();
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  shutdown_.store(true);
+  {
+    grpc_core::MutexLock lock(&park_mu_);
+    park_cv_.SignalAll();
+  }
+  for (auto& worker : workers_) {
+    worker->thd.Join();
+  }
+  grpc_core::MutexLock lock(&helpers_mu_);
+  while (num_helpers_ != 0) {
+    helpers_cv_.Wait(&helpers_mu_);
+  }
+  ReapHelpers(&dead_helpers_);
+}
+
+void WorkStealingThreadPool::Add(const std::function<void()>& callback) {
+  // Work added from one of our own workers stays with it; anything else goes
+  // to the worker affine to the caller's CPU so that concurrent callers on
+  // different CPUs do not contend on the same queue.
+  Worker* worker = current_worker_;
+  if (worker == nullptr || worker->pool != this) {
+    worker = workers_[gpr_cpu_current_cpu() % workers_.size()].get();
+  }
+  {
+    grpc_core::MutexLock lock(&worker->mu);
+    worker->callbacks.push_back(callback);
+    worker->size.fetch_add(1, std::memory_order_relaxed);
+    pending_.fetch_add(1);
+  }
+  // A searching worker is bound to find the callback before it parks.
+  if (num_searching_.load() == 0) WakeOrGrow();
+}
+
+WorkStealingThreadPool::Stats WorkStealingThreadPool::stats() const {
+  Stats stats;
+  stats.steals = steals_.load(std::memory_order_relaxed);
+  stats.parks = parks_.load(std::memory_order_relaxed);
+  stats.wakeups = wakeups_.load(std::memory_order_relaxed);
+  stats.helpers_started = helpers_started_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void WorkStealingThreadPool::ThreadFunc(Worker* worker) {
+  current_worker_ = worker;
+  std::function<void()> callback;
+  for (;;) {
+    if (FindWork(worker, worker->index, /*searching=*/false, &callback)) {
+      callback();
+      callback = nullptr;
+    } else if (!Park(/*with_timeout=*/false)) {
+      break;
+    }
+  }
+  current_worker_ = nullptr;
+}
+
+bool WorkStealingThreadPool::Pop(Worker* worker,
+                                 std::function<void()>* callback) {
+  if (worker->size.load(std::memory_order_relaxed) == 0) return false;
+  grpc_core::MutexLock lock(&worker->mu);
+  if (worker->callbacks.empty()) return false;
+  *callback = std::move(worker->callbacks.front());
+  worker->callbacks.pop_front();
+  worker->size.fetch_sub(1, std::memory_order_relaxed);
+  pending_.fetch_sub(1);
+  return true;
+}
+
+bool WorkStealingThreadPool::Steal(size_t index, size_t count,
+                                   std::function<void()>* callback) {
+  // Neighbouring workers serve neighbouring CPUs, which usually share a cache
+  // or a NUMA node, so try them first.
+  for (size_t i = 0; i < count; i++) {
+    if (Pop(workers_[(index + i) % workers_.size()].get(), callback)) {
+      steals_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::FindWork(Worker* worker, size_t index,
+                                      bool searching,
+                                      std::function<void()>* callback) {
+  bool found = false;
+  if (worker != nullptr && !searching) {
+    if (Pop(worker, callback)) return true;
+  }
+  if (!searching) num_searching_.fetch_add(1);
+  for (int round = 0; round < kSpinRounds && !found; round++) {
+    if (pending_.load() == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (worker != nullptr) {
+      found = Pop(worker, callback) ||
+              Steal(index + 1, workers_.size() - 1, callback);
+    } else {
+      found = Steal(index, workers_.size(), callback);
+    }
+  }
+  // The last thread to stop searching hands over to another one if there is
+  // still work left, since Add() did not wake anyone while we were searching.
+  if (num_searching_.fetch_sub(1) == 1 && found && pending_.load() != 0) {
+    WakeOrGrow();
+  }
+  return found;
+}
+
+bool WorkStealingThreadPool::Park(bool with_timeout) {
+  grpc_core::MutexLock lock(&park_mu_);
+  num_parked_.fetch_add(1);
+  // Add() publishes pending_ before reading num_parked_, and we publish
+  // num_parked_ before reading pending_, so one of us sees the other.
+  if (pending_.load() == 0 && !shutdown_.load()) {
+    parks_.fetch_add(1, std::memory_order_relaxed);
+    const absl::Time deadline =
+        with_timeout ? absl::Now() + absl::Milliseconds(kHelperIdleTimeoutMs)
+                     : absl::InfiniteFuture();
+    do {
+      if (park_cv_.WaitWithDeadline(&park_mu_, deadline)) break;
+    } while (pending_.load() == 0 && !shutdown_.load());
+  }
+  num_parked_.fetch_sub(1);
+  // Drain all the queues before honoring shutdown.
+  return pending_.load() != 0;
+}
+
+void WorkStealingThreadPool::WakeOrGrow() {
+  if (num_parked_.load() != 0) {
+    MaybeWakeOne();
+  } else {
+    // Every thread is running a callback, and some of them may be blocked.
+    StartHelper();
+  }
+}
+
+void WorkStealingThreadPool::StartHelper() {
+  grpc_core::MutexLock lock(&helpers_mu_);
+  num_helpers_++;
+  helpers_started_.fetch_add(1, std::memory_order_relaxed);
+  num_searching_.fetch_add(1);
+  new Helper(this);
+  // Also use this chance to harvest helpers that have exited.
+  if (!dead_helpers_.empty()) {
+    ReapHelpers(&dead_helpers_);
+  }
+}
+
+void WorkStealingThreadPool::ReapHelpers(std::list<Helper*>* helpers) {
+  for (auto h = helpers->begin(); h != helpers->end(); h = helpers->erase(h)) {
+    delete *h;
+  }
+}
+
+void WorkStealingThreadPool::MaybeWakeOne() {
+  if (num_parked_.load() == 0) return;
+  grpc_core::MutexLock lock(&park_mu_);
+  wakeups_.fetch_add(1, std::memory_order_relaxed);
+  park_cv_.Signal();
+}
+
+}  // namespace grpc
@@ -0,0 +1,146 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_INTERNAL_CPP_WORK_STEALING_THREAD_POOL_H
+#define GRPC_INTERNAL_CPP_WORK_STEALING_THREAD_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/cpp/server/thread_pool_interface.h"
+
+namespace grpc {
+
+// A thread pool where every worker owns a queue of callbacks.
+// Callbacks added from a worker go to that worker's own queue; callbacks added
+// from elsewhere go to the queue of the worker affine to the caller's CPU.
+// Idle workers steal from their neighbours' queues, spin for a bounded number
+// of rounds and then park. A callback only wakes a parked worker when no other
+// worker is already searching for work, so bursts of Add() calls do not wake
+// the whole pool.
+// Like DynamicThreadPool, the pool grows when a callback is added while every
+// thread is busy, so callbacks that block cannot starve the others. The extra
+// threads own no queue: they only steal, and exit once they have been idle
+// for kHelperIdleTimeout.
+class WorkStealingThreadPool final : public ThreadPoolInterface {
+ public:
+  // Counters describing the pool's scheduling behaviour since construction.
+  struct Stats {
+    // Callbacks taken from a queue owned by another worker.
+    uint64_t steals = 0;
+    // Times a worker ran out of work and blocked.
+    uint64_t parks = 0;
+    // Times new work signalled a parked worker.
+    uint64_t wakeups = 0;
+    // Extra threads started because every thread was busy.
+    uint64_t helpers_started = 0;
+  };
+
+  explicit WorkStealingThreadPool(int num_threads);
+  ~WorkStealingThreadPool() override;
+
+  void Add(const std::function<void()>& callback) override;
+
+  Stats stats() const;
+
+ private:
+  // Rounds over all the other workers' queues before an idle worker parks.
+  static constexpr int kSpinRounds = 16;
+  // How long an idle extra thread stays parked before it exits, in ms.
+  static constexpr int kHelperIdleTimeoutMs = 100;
+
+  struct Worker {
+    WorkStealingThreadPool* pool;
+    size_t index;
+    grpc_core::Mutex mu;
+    std::deque<std::function<void()>> callbacks ABSL_GUARDED_BY(mu);
+    // Approximate size of callbacks, so that thieves can skip empty queues
+    // without taking their lock.
+    std::atomic<size_t> size{0};
+    grpc_core::Thread thd;
+  };
+
+  // An extra thread, started when every thread is busy.
+  class Helper {
+   public:
+    explicit Helper(WorkStealingThreadPool* pool);
+    ~Helper();
+
+   private:
+    void ThreadFunc();
+
+    WorkStealingThreadPool* pool_;
+    grpc_core::Thread thd_;
+  };
+
+  void ThreadFunc(Worker* worker);
+  // Pops the oldest callback of the given worker's queue.
+  bool Pop(Worker* worker, std::function<void()>* callback);
+  // Takes the oldest callback of one of count workers' queues, starting at
+  // index so that the closest workers are visited first.
+  bool Steal(size_t index, size_t count, std::function<void()>* callback);
+  // Looks for work for the given worker, or for a helper if worker is null.
+  // searching is true if the caller is already counted in num_searching_.
+  bool FindWork(Worker* worker, size_t index, bool searching,
+                std::function<void()>* callback);
+  // Blocks until there is work to do. Returns false at shutdown once all the
+  // queues are drained, or when the timeout expires without work.
+  bool Park(bool with_timeout);
+  // Wakes a parked thread, or starts a helper if every thread is busy.
+  void WakeOrGrow();
+  void MaybeWakeOne();
+  void StartHelper();
+  static void ReapHelpers(std::list<Helper*>* helpers);
+
+  static GPR_THREAD_LOCAL(Worker*) current_worker_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Callbacks added but not yet taken out of a queue.
+  std::atomic<size_t> pending_{0};
+  std::atomic<int> num_searching_{0};
+  std::atomic<int> num_parked_{0};
+  std::atomic<bool> shutdown_{false};
+
+  std::atomic<uint64_t> steals_{0};
+  std::atomic<uint64_t> parks_{0};
+  std::atomic<uint64_t> wakeups_{0};
+  std::atomic<uint64_t> helpers_started_{0};
+
+  grpc_core::Mutex park_mu_;
+  grpc_core::CondVar park_cv_;
+
+  grpc_core::Mutex helpers_mu_;
+  grpc_core::CondVar helpers_cv_;
+  int num_helpers_ ABSL_GUARDED_BY(helpers_mu_) = 0;
+  std::list<Helper*> dead_helpers_ ABSL_GUARDED_BY(helpers_mu_);
+};
+
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_WORK_STEALING_THREAD_POOL_H
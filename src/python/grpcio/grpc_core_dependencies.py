@@ -38,11 +38,15 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_channel_secure.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+    'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
+    'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
     'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
+    'src/core/ext/filters/client_channel/lb_policy/pick_random.cc',
     'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
     'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
     'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
     'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
     'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/xds_cluster_impl.cc',
@@ -118,6 +122,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/transport/chttp2/transport/hpack_parser_table.cc',
     'src/core/ext/transport/chttp2/transport/hpack_utils.cc',
     'src/core/ext/transport/chttp2/transport/http2_settings.cc',
+    'src/core/ext/transport/chttp2/transport/huffman_decoder.cc',
     'src/core/ext/transport/chttp2/transport/huffsyms.cc',
     'src/core/ext/transport/chttp2/transport/parsing.cc',
     'src/core/ext/transport/chttp2/transport/stream_lists.cc',
@@ -230,6 +235,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/upb-generated/xds/core/v3/resource_locator.upb.c',
     'src/core/ext/upb-generated/xds/core/v3/resource_name.upb.c',
     'src/core/ext/upb-generated/xds/data/orca/v3/orca_load_report.upb.c',
+    'src/core/ext/upb-generated/xds/service/orca/v3/orca.upb.c',
     'src/core/ext/upb-generated/xds/type/v3/typed_struct.upb.c',
     'src/core/ext/upbdefs-generated/envoy/admin/v3/config_dump.upbdefs.c',
     'src/core/ext/upbdefs-generated/envoy/annotations/deprecation.upbdefs.c',
@@ -365,6 +371,12 @@ CORE_SOURCE_FILES = [
     'src/core/lib/event_engine/channel_args_endpoint_config.cc',
     'src/core/lib/event_engine/event_engine.cc',
     'src/core/lib/event_engine/event_engine_factory.cc',
+    'src/core/lib/event_engine/memory_allocator.cc',
+    'src/core/lib/event_engine/posix_engine/event_poller.cc',
+    'src/core/lib/event_engine/posix_engine/posix_endpoint.cc',
+    'src/core/lib/event_engine/posix_engine/posix_engine.cc',
+    'src/core/lib/event_engine/posix_engine/thread_pool.cc',
+    'src/core/lib/event_engine/posix_engine/timer_manager.cc',
     'src/core/lib/event_engine/sockaddr.cc',
     'src/core/lib/gpr/alloc.cc',
     'src/core/lib/gpr/atm.cc',
@@ -403,6 +415,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/gprpp/global_config_env.cc',
     'src/core/lib/gprpp/host_port.cc',
     'src/core/lib/gprpp/mpscq.cc',
+    'src/core/lib/gprpp/rcu_ptr.cc',
     'src/core/lib/gprpp/stat_posix.cc',
     'src/core/lib/gprpp/stat_windows.cc',
     'src/core/lib/gprpp/status_helper.cc',
@@ -428,6 +441,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/ev_apple.cc',
     'src/core/lib/iomgr/ev_epoll1_linux.cc',
     'src/core/lib/iomgr/ev_epollex_linux.cc',
+    'src/core/lib/iomgr/ev_io_uring_linux.cc',
     'src/core/lib/iomgr/ev_poll_posix.cc',
     'src/core/lib/iomgr/ev_posix.cc',
     'src/core/lib/iomgr/ev_windows.cc',
@@ -501,6 +515,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/timer_generic.cc',
     'src/core/lib/iomgr/timer_heap.cc',
     'src/core/lib/iomgr/timer_manager.cc',
+    'src/core/lib/iomgr/timer_wheel.cc',
     'src/core/lib/iomgr/unix_sockets_posix.cc',
     'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
     'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -571,6 +586,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/security/transport/tsi_error.cc',
     'src/core/lib/security/util/json_util.cc',
     'src/core/lib/slice/b64.cc',
+    'src/core/lib/slice/b64_simd.cc',
     'src/core/lib/slice/percent_encoding.cc',
     'src/core/lib/slice/slice.cc',
     'src/core/lib/slice/slice_api.cc',
@@ -0,0 +1,645 @@
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "google/protobuf/duration.upb.h"
+#include "upb/upb.hpp"
+#include "xds/data/orca/v3/orca_load_report.upb.h"
+#include "xds/service/orca/v3/orca.upb.h"
+
+#include <grpc/byte_buffer.h>
+#include <grpc/byte_buffer_reader.h>
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/filters/client_channel/backup_poller.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_utils.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/core/util/test_lb_policies.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+constexpr char kOrcaStreamMethod[] =
+    "/xds.service.orca.v3.OpenRcaService/StreamCoreMetrics";
+
+int64_t NowMillis() {
+  return gpr_time_to_millis(gpr_now(GPR_CLOCK_MONOTONIC));
+}
+
+// The load a backend reports.
+struct LoadReport {
+  double cpu_utilization = 0;
+  double mem_utilization = 0;
+  uint64_t rps = 0;
+  std::map<std::string, double> utilization;
+};
+
+// Collects the load reports that oob_backend_metric_test_lb delivers.
+class ReportCollector {
+ public:
+  void Add(const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData&
+               data) {
+    LoadReport report;
+    report.cpu_utilization = data.cpu_utilization;
+    report.mem_utilization = data.mem_utilization;
+    report.rps = data.requests_per_second;
+    for (const auto& p : data.utilization) {
+      report.utilization[std::string(p.first)] = p.second;
+    }
+    MutexLock lock(&mu_);
+    reports_.push_back(std::move(report));
+    cv_.SignalAll();
+  }
+
+  void Clear() {
+    MutexLock lock(&mu_);
+    reports_.clear();
+  }
+
+  // Waits up to 10 seconds for num_reports reports, and returns the
+  // reports received so far.
+  std::vector<LoadReport> WaitForReports(size_t num_reports) {
+    absl::Time deadline = absl::Now() + absl::Seconds(10);
+    MutexLock lock(&mu_);
+    while (reports_.size() < num_reports) {
+      if (cv_.WaitWithDeadline(&mu_, deadline)) break;
+    }
+    return reports_;
+  }
+
+ private:
+  Mutex mu_;
+  CondVar cv_;
+  std::vector<LoadReport> reports_ ABSL_GUARDED_BY(mu_);
+};
+
+ReportCollector* g_reports;
+
+// A backend that serves ORCA streams and unary calls on its own thread.
+// Each ORCA stream gets a load report as soon as the client's request
+// arrives, and then once every report interval the client asked for.
+class Backend {
+ public:
+  Backend() {
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    server_ = grpc_server_create(nullptr, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    int port = grpc_pick_unused_port_or_die();
+    GPR_ASSERT(grpc_server_add_insecure_http2_port(
+                   server_, absl::StrCat("127.0.0.1:", port).c_str()) != 0);
+    target_ = absl::StrCat("127.0.0.1:", port);
+    grpc_server_start(server_);
+    thread_ = Thread(
+        "oob_backend", [](void* arg) { static_cast<Backend*>(arg)->Serve(); },
+        this);
+    thread_.Start();
+  }
+
+  ~Backend() {
+    shutting_down_.store(true);
+    grpc_server_shutdown_and_notify(
+        server_, cq_,
+        new std::function<void(bool)>(
+            [this](bool) { grpc_completion_queue_shutdown(cq_); }));
+    grpc_server_cancel_all_calls(server_);
+    thread_.Join();
+    grpc_server_destroy(server_);
+    grpc_completion_queue_destroy(cq_);
+    for (const auto& stream : streams_) grpc_call_unref(stream->call);
+    for (const auto& call : unary_calls_) grpc_call_unref(call->call);
+  }
+
+  // The address to connect to, without the "ipv4:" scheme.
+  const std::string& target() const { return target_; }
+
+  void SetLoadReport(LoadReport report) {
+    MutexLock lock(&mu_);
+    load_report_ = std::move(report);
+  }
+
+  // Ends the next ORCA stream with status: right away for UNIMPLEMENTED,
+  // otherwise after the first load report.
+  void EndNextStreamWith(grpc_status_code status) {
+    MutexLock lock(&mu_);
+    end_next_stream_with_ = status;
+  }
+
+  // Waits up to timeout for num_streams ORCA streams to have been opened,
+  // and returns the report interval each of them asked for, in ms.
+  std::vector<int64_t> WaitForStreams(size_t num_streams,
+                                      absl::Duration timeout) {
+    absl::Time deadline = absl::Now() + timeout;
+    MutexLock lock(&mu_);
+    while (stream_intervals_.size() < num_streams) {
+      if (cv_.WaitWithDeadline(&mu_, deadline)) break;
+    }
+    return stream_intervals_;
+  }
+
+  int num_unary_calls() const { return num_unary_calls_.load(); }
+
+ private:
+  // Completion queue tags are heap-allocated callbacks, invoked with
+  // whether the operation succeeded and then deleted.
+  using Callback = std::function<void(bool)>;
+
+  struct OrcaStream {
+    grpc_call* call = nullptr;
+    grpc_byte_buffer* request = nullptr;
+    int cancelled = 0;
+    int64_t report_interval = 0;
+    int64_t next_report_time = GRPC_MILLIS_INF_FUTURE;
+    bool sending = false;
+    bool done = false;
+    // Status to end the stream with after its first report.
+    grpc_status_code end_status = GRPC_STATUS_OK;
+  };
+
+  struct UnaryCall {
+    grpc_call* call = nullptr;
+    int cancelled = 0;
+  };
+
+  void StartBatch(grpc_call* call, const grpc_op* ops, size_t num_ops,
+                  Callback on_done) {
+    GPR_ASSERT(grpc_call_start_batch(call, ops, num_ops,
+                                     new Callback(std::move(on_done)),
+                                     nullptr) == GRPC_CALL_OK);
+  }
+
+  void Serve() {
+    RequestCall();
+    while (true) {
+      grpc_event ev = grpc_completion_queue_next(
+          cq_, grpc_timeout_milliseconds_to_deadline(10), nullptr);
+      if (ev.type == GRPC_QUEUE_SHUTDOWN) break;
+      if (ev.type == GRPC_OP_COMPLETE) {
+        auto* on_done = static_cast<Callback*>(ev.tag);
+        (*on_done)(ev.success != 0);
+        delete on_done;
+      }
+      if (shutting_down_.load()) continue;
+      int64_t now = NowMillis();
+      for (const auto& stream : streams_) {
+        if (!stream->done && !stream->sending &&
+            stream->next_report_time <= now) {
+          SendReport(stream.get());
+        }
+      }
+    }
+  }
+
+  void RequestCall() {
+    grpc_call_details_init(&new_call_details_);
+    grpc_metadata_array_init(&new_call_metadata_);
+    GPR_ASSERT(grpc_server_request_call(
+                   server_, &new_call_, &new_call_details_,
+                   &new_call_metadata_, cq_, cq_,
+                   new Callback([this](bool ok) { OnCallArrived(ok); })) ==
+               GRPC_CALL_OK);
+  }
+
+  void OnCallArrived(bool ok) {
+    bool is_orca_stream =
+        StringViewFromSlice(new_call_details_.method) == kOrcaStreamMethod;
+    grpc_call_details_destroy(&new_call_details_);
+    grpc_metadata_array_destroy(&new_call_metadata_);
+    if (!ok || shutting_down_.load()) {
+      if (new_call_ != nullptr) grpc_call_unref(new_call_);
+      return;
+    }
+    if (is_orca_stream) {
+      StartOrcaStream(new_call_);
+    } else {
+      ServeUnaryCall(new_call_);
+    }
+    new_call_ = nullptr;
+    RequestCall();
+  }
+
+  void ServeUnaryCall(grpc_call* call) {
+    unary_calls_.push_back(absl::make_unique<UnaryCall>());
+    UnaryCall* unary_call = unary_calls_.back().get();
+    unary_call->call = call;
+    grpc_slice response_slice = grpc_slice_from_static_string("response");
+    grpc_byte_buffer* response =
+        grpc_raw_byte_buffer_create(&response_slice, 1);
+    grpc_op ops[4];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    ops[0].data.recv_close_on_server.cancelled = &unary_call->cancelled;
+    ops[1].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[2].op = GRPC_OP_SEND_MESSAGE;
+    ops[2].data.send_message.send_message = response;
+    ops[3].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+    ops[3].data.send_status_from_server.status = GRPC_STATUS_OK;
+    num_unary_calls_.fetch_add(1);
+    StartBatch(call, ops, GPR_ARRAY_SIZE(ops), [](bool) {});
+    grpc_byte_buffer_destroy(response);
+  }
+
+  void StartOrcaStream(grpc_call* call) {
+    streams_.push_back(absl::make_unique<OrcaStream>());
+    OrcaStream* stream = streams_.back().get();
+    stream->call = call;
+    grpc_op ops[2];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_RECV_MESSAGE;
+    ops[1].data.recv_message.recv_message = &stream->request;
+    StartBatch(call, ops, GPR_ARRAY_SIZE(ops),
+               [this, stream](bool ok) { OnOrcaRequest(stream, ok); });
+    grpc_op close_op;
+    memset(&close_op, 0, sizeof(close_op));
+    close_op.op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    close_op.data.recv_close_on_server.cancelled = &stream->cancelled;
+    StartBatch(call, &close_op, 1, [stream](bool) { stream->done = true; });
+  }
+
+  void OnOrcaRequest(OrcaStream* stream, bool ok) {
+    if (!ok || stream->request == nullptr) {
+      stream->done = true;
+      return;
+    }
+    grpc_byte_buffer_reader reader;
+    GPR_ASSERT(grpc_byte_buffer_reader_init(&reader, stream->request));
+    grpc_slice serialized_request = grpc_byte_buffer_reader_readall(&reader);
+    grpc_byte_buffer_reader_destroy(&reader);
+    grpc_byte_buffer_destroy(stream->request);
+    stream->request = nullptr;
+    upb::Arena arena;
+    const xds_service_orca_v3_OrcaLoadReportRequest* request =
+        xds_service_orca_v3_OrcaLoadReportRequest_parse(
+            reinterpret_cast<const char*>(
+                GRPC_SLICE_START_PTR(serialized_request)),
+            GRPC_SLICE_LENGTH(serialized_request), arena.ptr());
+    grpc_slice_unref(serialized_request);
+    GPR_ASSERT(request != nullptr);
+    const google_protobuf_Duration* report_interval =
+        xds_service_orca_v3_OrcaLoadReportRequest_report_interval(request);
+    if (report_interval != nullptr) {
+      stream->report_interval =
+          google_protobuf_Duration_seconds(report_interval) * GPR_MS_PER_SEC +
+          google_protobuf_Duration_nanos(report_interval) / GPR_NS_PER_MS;
+    }
+    {
+      MutexLock lock(&mu_);
+      stream_intervals_.push_back(stream->report_interval);
+      stream->end_status = end_next_stream_with_;
+      end_next_stream_with_ = GRPC_STATUS_OK;
+      cv_.SignalAll();
+    }
+    if (stream->end_status == GRPC_STATUS_UNIMPLEMENTED) {
+      EndStream(stream);
+    } else {
+      SendReport(stream);
+    }
+  }
+
+  void SendReport(OrcaStream* stream) {
+    upb::Arena arena;
+    xds_data_orca_v3_OrcaLoadReport* report =
+        xds_data_orca_v3_OrcaLoadReport_new(arena.ptr());
+    {
+      MutexLock lock(&mu_);
+      xds_data_orca_v3_OrcaLoadReport_set_cpu_utilization(
+          report, load_report_.cpu_utilization);
+      xds_data_orca_v3_OrcaLoadReport_set_mem_utilization(
+          report, load_report_.mem_utilization);
+      xds_data_orca_v3_OrcaLoadReport_set_rps(report, load_report_.rps);
+      for (const auto& p : load_report_.utilization) {
+        xds_data_orca_v3_OrcaLoadReport_utilization_set(
+            report, upb_strview_make(p.first.data(), p.first.size()),
+            p.second, arena.ptr());
+      }
+    }
+    size_t length;
+    char* serialized_report =
+        xds_data_orca_v3_OrcaLoadReport_serialize(report, arena.ptr(), &length);
+    grpc_slice report_slice =
+        grpc_slice_from_copied_buffer(serialized_report, length);
+    grpc_byte_buffer* message = grpc_raw_byte_buffer_create(&report_slice, 1);
+    grpc_slice_unref(report_slice);
+    grpc_op op;
+    memset(&op, 0, sizeof(op));
+    op.op = GRPC_OP_SEND_MESSAGE;
+    op.data.send_message.send_message = message;
+    stream->sending = true;
+    StartBatch(stream->call, &op, 1, [this, stream](bool ok) {
+      stream->sending = false;
+      if (!ok || stream->done || shutting_down_.load()) return;
+      if (stream->end_status != GRPC_STATUS_OK) {
+        EndStream(stream);
+      } else {
+        stream->next_report_time = NowMillis() + stream->report_interval;
+      }
+    });
+    grpc_byte_buffer_destroy(message);
+  }
+
+  void EndStream(OrcaStream* stream) {
+    stream->next_report_time = GRPC_MILLIS_INF_FUTURE;
+    grpc_op op;
+    memset(&op, 0, sizeof(op));
+    op.op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+    op.data.send_status_from_server.status = stream->end_status;
+    StartBatch(stream->call, &op, 1, [](bool) {});
+  }
+
+  std::string target_;
+  grpc_completion_queue* cq_;
+  grpc_server* server_;
+  Thread thread_;
+  std::atomic<bool> shutting_down_{false};
+  std::atomic<int> num_unary_calls_{0};
+
+  // Used only by the serving thread.
+  grpc_call* new_call_ = nullptr;
+  grpc_call_details new_call_details_;
+  grpc_metadata_array new_call_metadata_;
+  std::vector<std::unique_ptr<OrcaStream>> streams_;
+  std::vector<std::unique_ptr<UnaryCall>> unary_calls_;
+
+  Mutex mu_;
+  CondVar cv_;
+  LoadReport load_report_ ABSL_GUARDED_BY(mu_);
+  grpc_status_code end_next_stream_with_ ABSL_GUARDED_BY(mu_) =
+      GRPC_STATUS_OK;
+  std::vector<int64_t> stream_intervals_ ABSL_GUARDED_BY(mu_);
+};
+
+class OobBackendMetricTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    g_reports->Clear();
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+  }
+
+  void TearDown() override {
+    for (grpc_channel* channel : channels_) grpc_channel_destroy(channel);
+    backends_.clear();
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  Backend* AddBackend() {
+    backends_.push_back(absl::make_unique<Backend>());
+    return backends_.back().get();
+  }
+
+  // Creates a channel to the given backends using the LB policy config
+  // lb_config, and starts connecting it.
+  grpc_channel* CreateChannel(const std::vector<Backend*>& backends,
+                              const std::string& lb_config) {
+    std::string target = "ipv4:";
+    for (size_t i = 0; i < backends.size(); ++i) {
+      if (i > 0) target += ",";
+      target += backends[i]->target();
+    }
+    std::string service_config =
+        absl::StrCat("{\"loadBalancingConfig\": [", lb_config, "]}");
+    grpc_arg arg = grpc_channel_arg_string_create(
+        const_cast<char*>(GRPC_ARG_SERVICE_CONFIG),
+        const_cast<char*>(service_config.c_str()));
+    grpc_channel_args args = {1, &arg};
+    grpc_channel* channel =
+        grpc_insecure_channel_create(target.c_str(), &args, nullptr);
+    grpc_channel_check_connectivity_state(channel, /*try_to_connect=*/1);
+    channels_.push_back(channel);
+    return channel;
+  }
+
+  // Sends a unary call on channel and waits for it to finish.
+  void SendCall(grpc_channel* channel) {
+    grpc_call* call = grpc_channel_create_call(
+        channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_,
+        grpc_slice_from_static_string("/service/method"), nullptr,
+        grpc_timeout_seconds_to_deadline(10), nullptr);
+    grpc_slice request_slice = grpc_slice_from_static_string("request");
+    grpc_byte_buffer* request = grpc_raw_byte_buffer_create(&request_slice, 1);
+    grpc_metadata_array initial_metadata;
+    grpc_metadata_array trailing_metadata;
+    grpc_metadata_array_init(&initial_metadata);
+    grpc_metadata_array_init(&trailing_metadata);
+    grpc_byte_buffer* response = nullptr;
+    grpc_status_code status = GRPC_STATUS_UNKNOWN;
+    grpc_slice details;
+    grpc_op ops[6];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[0].flags = GRPC_INITIAL_METADATA_WAIT_FOR_READY;
+    ops[1].op = GRPC_OP_SEND_MESSAGE;
+    ops[1].data.send_message.send_message = request;
+    ops[2].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+    ops[3].op = GRPC_OP_RECV_INITIAL_METADATA;
+    ops[3].data.recv_initial_metadata.recv_initial_metadata =
+        &initial_metadata;
+    ops[4].op = GRPC_OP_RECV_MESSAGE;
+    ops[4].data.recv_message.recv_message = &response;
+    ops[5].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[5].data.recv_status_on_client.trailing_metadata = &trailing_metadata;
+    ops[5].data.recv_status_on_client.status = &status;
+    ops[5].data.recv_status_on_client.status_details = &details;
+    void* tag = reinterpret_cast<void*>(1);
+    ASSERT_EQ(grpc_call_start_batch(call, ops, GPR_ARRAY_SIZE(ops), tag,
+                                    nullptr),
+              GRPC_CALL_OK);
+    grpc_event ev = grpc_completion_queue_next(
+        cq_, grpc_timeout_seconds_to_deadline(20), nullptr);
+    EXPECT_EQ(ev.type, GRPC_OP_COMPLETE);
+    EXPECT_EQ(ev.tag, tag);
+    EXPECT_EQ(status, GRPC_STATUS_OK);
+    grpc_byte_buffer_destroy(request);
+    if (response != nullptr) grpc_byte_buffer_destroy(response);
+    grpc_metadata_array_destroy(&initial_metadata);
+    grpc_metadata_array_destroy(&trailing_metadata);
+    grpc_slice_unref(details);
+    grpc_call_unref(call);
+  }
+
+  static std::string TestLbConfig(const char* report_interval) {
+    return absl::StrCat(
+        "{\"oob_backend_metric_test_lb\": {\"reportInterval\": \"",
+        report_interval, "\"}}");
+  }
+
+  grpc_completion_queue* cq_ = nullptr;
+  std::vector<std::unique_ptr<Backend>> backends_;
+  std::vector<grpc_channel*> channels_;
+};
+
+// The producer asks for the watcher's interval, and every report the
+// backend sends reaches the watcher.
+TEST_F(OobBackendMetricTest, ReportsReachWatcher) {
+  Backend* backend = AddBackend();
+  LoadReport report;
+  report.cpu_utilization = 0.5;
+  report.mem_utilization = 0.25;
+  report.rps = 10;
+  report.utilization["foo"] = 0.75;
+  backend->SetLoadReport(report);
+  CreateChannel({backend}, TestLbConfig("0.2s"));
+  std::vector<int64_t> intervals =
+      backend->WaitForStreams(1, absl::Seconds(10));
+  ASSERT_EQ(intervals.size(), 1);
+  EXPECT_EQ(intervals[0], 200);
+  std::vector<LoadReport> reports = g_reports->WaitForReports(3);
+  ASSERT_GE(reports.size(), 3);
+  for (const LoadReport& received : reports) {
+    EXPECT_EQ(received.cpu_utilization, 0.5);
+    EXPECT_EQ(received.mem_utilization, 0.25);
+    EXPECT_EQ(received.rps, 10);
+    ASSERT_EQ(received.utilization.size(), 1);
+    EXPECT_EQ(received.utilization.at("foo"), 0.75);
+  }
+  // No other stream was opened for the later reports.
+  EXPECT_EQ(backend->WaitForStreams(2, absl::ZeroDuration()).size(), 1);
+}
+
+// Channels to the same backend share its subchannel, and so one stream,
+// which asks for the shortest interval of the watchers present.
+TEST_F(OobBackendMetricTest, SharedStreamUsesShortestInterval) {
+  Backend* backend = AddBackend();
+  CreateChannel({backend}, TestLbConfig("10s"));
+  std::vector<int64_t> intervals =
+      backend->WaitForStreams(1, absl::Seconds(10));
+  ASSERT_EQ(intervals.size(), 1);
+  EXPECT_EQ(intervals[0], 10000);
+  // A watcher with a shorter interval restarts the stream.
+  grpc_channel* channel = CreateChannel({backend}, TestLbConfig("0.5s"));
+  intervals = backend->WaitForStreams(2, absl::Seconds(10));
+  ASSERT_EQ(intervals.size(), 2);
+  EXPECT_EQ(intervals[1], 500);
+  // Once that watcher is gone, the stream goes back to the longer interval.
+  grpc_channel_destroy(channel);
+  channels_.pop_back();
+  intervals = backend->WaitForStreams(3, absl::Seconds(10));
+  ASSERT_EQ(intervals.size(), 3);
+  EXPECT_EQ(intervals[2], 10000);
+}
+
+// A stream that ends after a report is reopened right away.
+TEST_F(OobBackendMetricTest, StreamReopensAfterBackendEndsIt) {
+  Backend* backend = AddBackend();
+  backend->EndNextStreamWith(GRPC_STATUS_UNAVAILABLE);
+  CreateChannel({backend}, TestLbConfig("10s"));
+  std::vector<int64_t> intervals =
+      backend->WaitForStreams(2, absl::Seconds(10));
+  EXPECT_EQ(intervals.size(), 2);
+  // Each stream sent one report.
+  EXPECT_EQ(g_reports->WaitForReports(2).size(), 2);
+}
+
+// A backend that does not serve ORCA is not asked again.
+TEST_F(OobBackendMetricTest, UnimplementedStopsStream) {
+  Backend* backend = AddBackend();
+  backend->EndNextStreamWith(GRPC_STATUS_UNIMPLEMENTED);
+  CreateChannel({backend}, TestLbConfig("10s"));
+  EXPECT_EQ(backend->WaitForStreams(1, absl::Seconds(10)).size(), 1);
+  // The first retry would come after about a second of backoff.
+  EXPECT_EQ(backend->WaitForStreams(2, absl::Seconds(3)).size(), 1);
+}
+
+// weighted_round_robin_experimental with enableOobLoadReport weights the
+// backends by the QPS / CPU utilization of their out-of-band reports, even
+// though the backends send no load reports with their responses.
+TEST_F(OobBackendMetricTest, WeightedRoundRobinUsesOobLoadReports) {
+  const int kNumCalls = 200;
+  Backend* light = AddBackend();
+  Backend* heavy = AddBackend();
+  LoadReport report;
+  report.rps = 100;
+  report.cpu_utilization = 0.2;
+  light->SetLoadReport(report);
+  report.cpu_utilization = 0.6;
+  heavy->SetLoadReport(report);
+  // Without out-of-band reports, the backends have no weights, and calls
+  // are spread evenly.
+  grpc_channel* channel = CreateChannel(
+      {light, heavy},
+      "{\"weighted_round_robin_experimental\": {"
+      "\"blackoutPeriod\": \"0s\", \"weightUpdatePeriod\": \"0.1s\"}}");
+  for (int i = 0; i < kNumCalls; ++i) SendCall(channel);
+  EXPECT_NEAR(light->num_unary_calls(), kNumCalls / 2, kNumCalls / 20);
+  EXPECT_EQ(light->num_unary_calls() + heavy->num_unary_calls(), kNumCalls);
+  // With them, the light backend gets three times the calls.
+  channel = CreateChannel(
+      {light, heavy},
+      "{\"weighted_round_robin_experimental\": {"
+      "\"blackoutPeriod\": \"0s\", \"weightUpdatePeriod\": \"0.1s\", "
+      "\"enableOobLoadReport\": true, \"oobReportingPeriod\": \"0.1s\"}}");
+  ASSERT_EQ(light->WaitForStreams(1, absl::Seconds(10)).size(), 1);
+  ASSERT_EQ(heavy->WaitForStreams(1, absl::Seconds(10)).size(), 1);
+  // Let a few weight updates go by.
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(500));
+  const int light_before = light->num_unary_calls();
+  const int heavy_before = heavy->num_unary_calls();
+  for (int i = 0; i < kNumCalls; ++i) SendCall(channel);
+  const int light_calls = light->num_unary_calls() - light_before;
+  const int heavy_calls = heavy->num_unary_calls() - heavy_before;
+  gpr_log(GPR_INFO, "calls to light backend: %d, to heavy backend: %d",
+          light_calls, heavy_calls);
+  EXPECT_EQ(light_calls + heavy_calls, kNumCalls);
+  EXPECT_NEAR(light_calls, kNumCalls * 3 / 4, kNumCalls / 20);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(argc, argv);
+  // Nothing polls the channels while the tests wait for the backends.
+  GPR_GLOBAL_CONFIG_SET(grpc_client_channel_backup_poll_interval_ms, 1);
+  grpc_init();
+  grpc_core::testing::ReportCollector reports;
+  grpc_core::testing::g_reports = &reports;
+  grpc_core::RegisterOobBackendMetricTestLoadBalancingPolicy(
+      [](const grpc_core::LoadBalancingPolicy::BackendMetricAccessor::
+             BackendMetricData& data) {
+        grpc_core::testing::g_reports->Add(data);
+      });
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,510 @@
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/byte_buffer.h>
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+// A call attempt as seen by the fake backend.
+struct ServerCall {
+  grpc_call* call = nullptr;
+  grpc_call_details details;
+  grpc_metadata_array request_metadata;
+  int cancelled = 0;
+
+  ServerCall() {
+    grpc_call_details_init(&details);
+    grpc_metadata_array_init(&request_metadata);
+  }
+  ~ServerCall() {
+    if (call != nullptr) grpc_call_unref(call);
+    grpc_call_details_destroy(&details);
+    grpc_metadata_array_destroy(&request_metadata);
+  }
+
+  // Returns the value of the grpc-previous-rpc-attempts header, or 0 if
+  // it is absent.
+  int PreviousAttempts() const {
+    for (size_t i = 0; i < request_metadata.count; ++i) {
+      if (grpc_slice_str_cmp(request_metadata.metadata[i].key,
+                             "grpc-previous-rpc-attempts") == 0) {
+        return atoi(std::string(StringViewFromSlice(
+                                    request_metadata.metadata[i].value))
+                        .c_str());
+      }
+    }
+    return 0;
+  }
+};
+
+// A unary call as seen by the client.
+struct ClientCall {
+  grpc_call* call = nullptr;
+  grpc_metadata_array initial_metadata;
+  grpc_metadata_array trailing_metadata;
+  grpc_byte_buffer* response = nullptr;
+  grpc_status_code status = GRPC_STATUS_UNKNOWN;
+  grpc_slice details = grpc_empty_slice();
+  gpr_timespec start_time;
+
+  ClientCall() {
+    grpc_metadata_array_init(&initial_metadata);
+    grpc_metadata_array_init(&trailing_metadata);
+  }
+  ~ClientCall() {
+    if (call != nullptr) grpc_call_unref(call);
+    grpc_metadata_array_destroy(&initial_metadata);
+    grpc_metadata_array_destroy(&trailing_metadata);
+    if (response != nullptr) grpc_byte_buffer_destroy(response);
+    grpc_slice_unref(details);
+  }
+};
+
+class RetryHedgingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    server_ = grpc_server_create(nullptr, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    address_ = absl::StrCat("localhost:", grpc_pick_unused_port_or_die());
+    ASSERT_NE(grpc_server_add_insecure_http2_port(server_, address_.c_str()),
+              0);
+    grpc_server_start(server_);
+  }
+
+  void TearDown() override {
+    if (channel_ != nullptr) grpc_channel_destroy(channel_);
+    grpc_server_shutdown_and_notify(server_, cq_, Tag(1000));
+    grpc_server_cancel_all_calls(server_);
+    // A call attempt still asked for fails at shutdown.
+    bool request_failed = pending_request_ == nullptr;
+    bool shutdown = false;
+    while (!request_failed || !shutdown) {
+      grpc_event ev = grpc_completion_queue_next(
+          cq_, grpc_timeout_seconds_to_deadline(20), nullptr);
+      if (ev.type != GRPC_OP_COMPLETE) {
+        ADD_FAILURE() << "timed out waiting for server shutdown";
+        break;
+      }
+      if (ev.tag == Tag(1000)) {
+        shutdown = true;
+      } else if (ev.tag == Tag(kPendingRequestTag)) {
+        EXPECT_FALSE(ev.success);
+        request_failed = true;
+      }
+    }
+    grpc_server_destroy(server_);
+    pending_request_.reset();
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  void CreateChannel(const std::string& hedging_policy) {
+    std::string service_config = absl::StrCat(
+        "{\"methodConfig\": [ {\"name\": [ { \"service\": \"service\", "
+        "\"method\": \"method\" } ], \"hedgingPolicy\": ",
+        hedging_policy, "} ] }");
+    grpc_arg args[] = {
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1),
+        grpc_channel_arg_string_create(
+            const_cast<char*>(GRPC_ARG_SERVICE_CONFIG),
+            const_cast<char*>(service_config.c_str())),
+    };
+    grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+    channel_ =
+        grpc_insecure_channel_create(address_.c_str(), &channel_args, nullptr);
+  }
+
+  // Starts a unary call, whose completion is signalled with tag.
+  void StartCall(ClientCall* call, intptr_t tag) {
+    call->start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+    call->call = grpc_channel_create_call(
+        channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_,
+        grpc_slice_from_static_string("/service/method"), nullptr,
+        grpc_timeout_seconds_to_deadline(30), nullptr);
+    grpc_slice request_slice = grpc_slice_from_static_string("request");
+    grpc_byte_buffer* request = grpc_raw_byte_buffer_create(&request_slice, 1);
+    grpc_op ops[6];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_SEND_MESSAGE;
+    ops[1].data.send_message.send_message = request;
+    ops[2].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+    ops[3].op = GRPC_OP_RECV_INITIAL_METADATA;
+    ops[3].data.recv_initial_metadata.recv_initial_metadata =
+        &call->initial_metadata;
+    ops[4].op = GRPC_OP_RECV_MESSAGE;
+    ops[4].data.recv_message.recv_message = &call->response;
+    ops[5].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[5].data.recv_status_on_client.trailing_metadata =
+        &call->trailing_metadata;
+    ops[5].data.recv_status_on_client.status = &call->status;
+    ops[5].data.recv_status_on_client.status_details = &call->details;
+    EXPECT_EQ(grpc_call_start_batch(call->call, ops, GPR_ARRAY_SIZE(ops),
+                                    Tag(tag), nullptr),
+              GRPC_CALL_OK);
+    grpc_byte_buffer_destroy(request);
+  }
+
+  // Returns the time in milliseconds since call was started.
+  static int64_t ElapsedMillis(const ClientCall& call) {
+    return gpr_time_to_millis(
+        gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), call.start_time));
+  }
+
+  // Waits for the next call attempt to reach the backend.
+  void RequestCall(ServerCall* call, intptr_t tag) {
+    RequestCallAsync(call, tag);
+    WaitForTag(tag);
+  }
+
+  // Asks for the next call attempt to reach the backend.  Its arrival is
+  // signalled with tag.
+  void RequestCallAsync(ServerCall* call, intptr_t tag) {
+    EXPECT_EQ(grpc_server_request_call(server_, &call->call, &call->details,
+                                       &call->request_metadata, cq_, cq_,
+                                       Tag(tag)),
+              GRPC_CALL_OK);
+  }
+
+  // Finishes the call attempt with status, and a response if it is OK.
+  // Completion of the attempt is signalled with tag.
+  void FinishCall(ServerCall* call, grpc_status_code status, intptr_t tag) {
+    grpc_slice response_slice = grpc_slice_from_static_string("response");
+    grpc_byte_buffer* response =
+        grpc_raw_byte_buffer_create(&response_slice, 1);
+    grpc_slice status_details = grpc_slice_from_static_string("xyz");
+    grpc_op ops[4];
+    memset(ops, 0, sizeof(ops));
+    grpc_op* op = ops;
+    op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    op->data.recv_close_on_server.cancelled = &call->cancelled;
+    ++op;
+    op->op = GRPC_OP_SEND_INITIAL_METADATA;
+    ++op;
+    if (status == GRPC_STATUS_OK) {
+      op->op = GRPC_OP_SEND_MESSAGE;
+      op->data.send_message.send_message = response;
+      ++op;
+    }
+    op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+    op->data.send_status_from_server.status = status;
+    op->data.send_status_from_server.status_details = &status_details;
+    ++op;
+    EXPECT_EQ(grpc_call_start_batch(call->call, ops,
+                                    static_cast<size_t>(op - ops), Tag(tag),
+                                    nullptr),
+              GRPC_CALL_OK);
+    grpc_byte_buffer_destroy(response);
+  }
+
+  // Waits for the call attempt to be cancelled by the client.
+  void WaitForCancellation(ServerCall* call, intptr_t tag) {
+    StartWaitForCancellation(call, tag);
+    WaitForTag(tag);
+  }
+
+  // Starts waiting for the call attempt to be cancelled by the client.
+  // Completion is signalled with tag.
+  void StartWaitForCancellation(ServerCall* call, intptr_t tag) {
+    grpc_op op;
+    memset(&op, 0, sizeof(op));
+    op.op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    op.data.recv_close_on_server.cancelled = &call->cancelled;
+    EXPECT_EQ(grpc_call_start_batch(call->call, &op, 1, Tag(tag), nullptr),
+              GRPC_CALL_OK);
+  }
+
+  struct LatencySummary {
+    int64_t p50;
+    int64_t p90;
+    int64_t p99;
+  };
+
+  static LatencySummary Summarize(std::vector<int64_t> latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](size_t p) {
+      return latencies[(latencies.size() * p - 1) / 100];
+    };
+    return {percentile(50), percentile(90), percentile(99)};
+  }
+
+  // Runs num_calls unary calls, one after the other, against a backend that
+  // answers each attempt with OK right away, except for one attempt in
+  // slow_one_in, picked with rng, which it answers after slow_millis.
+  // Returns the latency of each call, in milliseconds.
+  std::vector<int64_t> RunCallsAgainstSlowBackend(int num_calls,
+                                                  int slow_one_in,
+                                                  int64_t slow_millis,
+                                                  std::mt19937* rng) {
+    const intptr_t kClientTag = 1;
+    const intptr_t kRequestTag = kPendingRequestTag;
+    // Completion of the ops on attempt i uses tag kAttemptTag + i.
+    const intptr_t kAttemptTag = 10;
+    struct Attempt {
+      std::unique_ptr<ServerCall> call;
+      gpr_timespec respond_at;
+      bool answered = false;
+    };
+    std::vector<int64_t> latencies;
+    if (pending_request_ == nullptr) {
+      pending_request_ = absl::make_unique<ServerCall>();
+      RequestCallAsync(pending_request_.get(), kRequestTag);
+    }
+    for (int i = 0; i < num_calls; ++i) {
+      ClientCall client_call;
+      StartCall(&client_call, kClientTag);
+      std::vector<Attempt> attempts;
+      bool client_done = false;
+      size_t attempts_in_flight = 0;
+      while (!client_done || attempts_in_flight > 0) {
+        gpr_timespec deadline = grpc_timeout_seconds_to_deadline(20);
+        for (const Attempt& attempt : attempts) {
+          if (!attempt.answered) {
+            deadline = gpr_time_min(deadline, attempt.respond_at);
+          }
+        }
+        grpc_event ev = grpc_completion_queue_next(cq_, deadline, nullptr);
+        const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+        bool answered_any = false;
+        for (size_t j = 0; j < attempts.size(); ++j) {
+          if (!attempts[j].answered &&
+              gpr_time_cmp(now, attempts[j].respond_at) >= 0) {
+            attempts[j].answered = true;
+            answered_any = true;
+            FinishCall(attempts[j].call.get(), GRPC_STATUS_OK,
+                       kAttemptTag + j);
+          }
+        }
+        if (ev.type != GRPC_OP_COMPLETE) {
+          if (!answered_any) {
+            ADD_FAILURE() << "timed out waiting for call " << i;
+            return latencies;
+          }
+          continue;
+        }
+        const intptr_t tag = reinterpret_cast<intptr_t>(ev.tag);
+        if (tag == kClientTag) {
+          EXPECT_TRUE(ev.success);
+          EXPECT_EQ(client_call.status, GRPC_STATUS_OK);
+          latencies.push_back(ElapsedMillis(client_call));
+          client_done = true;
+          // The client has cancelled the attempts it did not commit to.
+          for (size_t j = 0; j < attempts.size(); ++j) {
+            if (attempts[j].answered) continue;
+            attempts[j].answered = true;
+            StartWaitForCancellation(attempts[j].call.get(), kAttemptTag + j);
+          }
+        } else if (tag == kRequestTag) {
+          EXPECT_TRUE(ev.success);
+          Attempt attempt;
+          attempt.call = std::move(pending_request_);
+          const bool slow = (*rng)() % slow_one_in == 0;
+          attempt.respond_at = gpr_time_add(
+              now, gpr_time_from_millis(slow ? slow_millis : 0, GPR_TIMESPAN));
+          // An attempt that arrives once the call is over is only waited
+          // for.
+          if (client_done) {
+            attempt.answered = true;
+            StartWaitForCancellation(attempt.call.get(),
+                                     kAttemptTag + attempts.size());
+          }
+          attempts.push_back(std::move(attempt));
+          ++attempts_in_flight;
+          pending_request_ = absl::make_unique<ServerCall>();
+          RequestCallAsync(pending_request_.get(), kRequestTag);
+        } else {
+          // The ops on an attempt completed.  They may have failed if the
+          // client cancelled the attempt first.
+          --attempts_in_flight;
+        }
+      }
+    }
+    return latencies;
+  }
+
+  // Drives the completion queue until an event with the given tag is
+  // seen, remembering any other events for later calls.
+  void WaitForTag(intptr_t tag) {
+    gpr_timespec deadline = grpc_timeout_seconds_to_deadline(20);
+    while (seen_tags_.erase(Tag(tag)) == 0) {
+      grpc_event ev = grpc_completion_queue_next(cq_, deadline, nullptr);
+      if (ev.type != GRPC_OP_COMPLETE) {
+        ADD_FAILURE() << "timed out waiting for tag " << tag;
+        return;
+      }
+      EXPECT_TRUE(ev.success) << "tag " << reinterpret_cast<intptr_t>(ev.tag);
+      seen_tags_[ev.tag] = true;
+    }
+  }
+
+  std::string address_;
+  grpc_completion_queue* cq_ = nullptr;
+  grpc_server* server_ = nullptr;
+  grpc_channel* channel_ = nullptr;
+  std::map<void*, bool> seen_tags_;
+  // The call attempt asked for by RunCallsAgainstSlowBackend(), if any,
+  // and the tag that signals its arrival.
+  static constexpr intptr_t kPendingRequestTag = 2;
+  std::unique_ptr<ServerCall> pending_request_;
+};
+
+// The backend never answers the first attempt, so the call completes
+// only because of the hedged attempt, and the first one is cancelled.
+TEST_F(RetryHedgingTest, HedgedAttemptWins) {
+  CreateChannel(
+      "{ \"maxAttempts\": 2, \"hedgingDelay\": \"0.1s\", "
+      "\"nonFatalStatusCodes\": [ \"UNAVAILABLE\" ] }");
+  ClientCall client_call;
+  StartCall(&client_call, 1);
+  ServerCall first_attempt;
+  RequestCall(&first_attempt, 101);
+  EXPECT_EQ(first_attempt.PreviousAttempts(), 0);
+  ServerCall second_attempt;
+  RequestCall(&second_attempt, 102);
+  EXPECT_EQ(second_attempt.PreviousAttempts(), 1);
+  FinishCall(&second_attempt, GRPC_STATUS_OK, 103);
+  WaitForTag(103);
+  WaitForTag(1);
+  EXPECT_EQ(client_call.status, GRPC_STATUS_OK);
+  ASSERT_NE(client_call.response, nullptr);
+  EXPECT_EQ(second_attempt.cancelled, 0);
+  WaitForCancellation(&first_attempt, 104);
+  EXPECT_EQ(first_attempt.cancelled, 1);
+}
+
+// A non-fatal status starts the next attempt right away, without waiting
+// out the hedging delay.
+TEST_F(RetryHedgingTest, NonFatalStatusStartsNextAttempt) {
+  CreateChannel(
+      "{ \"maxAttempts\": 2, \"hedgingDelay\": \"10s\", "
+      "\"nonFatalStatusCodes\": [ \"UNAVAILABLE\" ] }");
+  ClientCall client_call;
+  StartCall(&client_call, 1);
+  ServerCall first_attempt;
+  RequestCall(&first_attempt, 101);
+  FinishCall(&first_attempt, GRPC_STATUS_UNAVAILABLE, 102);
+  WaitForTag(102);
+  ServerCall second_attempt;
+  RequestCall(&second_attempt, 103);
+  EXPECT_EQ(second_attempt.PreviousAttempts(), 1);
+  FinishCall(&second_attempt, GRPC_STATUS_OK, 104);
+  WaitForTag(104);
+  WaitForTag(1);
+  EXPECT_EQ(client_call.status, GRPC_STATUS_OK);
+  EXPECT_LT(ElapsedMillis(client_call), 5000);
+}
+
+// A fatal status is returned to the application without starting any more
+// attempts.
+TEST_F(RetryHedgingTest, FatalStatusCommits) {
+  CreateChannel(
+      "{ \"maxAttempts\": 3, \"hedgingDelay\": \"10s\", "
+      "\"nonFatalStatusCodes\": [ \"UNAVAILABLE\" ] }");
+  ClientCall client_call;
+  StartCall(&client_call, 1);
+  ServerCall first_attempt;
+  RequestCall(&first_attempt, 101);
+  FinishCall(&first_attempt, GRPC_STATUS_INVALID_ARGUMENT, 102);
+  WaitForTag(102);
+  WaitForTag(1);
+  EXPECT_EQ(client_call.status, GRPC_STATUS_INVALID_ARGUMENT);
+  EXPECT_LT(ElapsedMillis(client_call), 5000);
+}
+
+// Compares call latency with and without hedging against a backend that
+// answers most attempts right away, but one attempt in kSlowOneIn, picked
+// at random, only after kSlowMillis.  The backend does not know which
+// attempt of a call it is serving.
+TEST_F(RetryHedgingTest, HedgingCutsTailLatencyOfSlowBackend) {
+  const int kNumCalls = 50;
+  const int kSlowOneIn = 5;
+  const int64_t kSlowMillis = 500;
+  // Without hedging in practice: the next attempt would start after the
+  // call's deadline.
+  CreateChannel(
+      "{ \"maxAttempts\": 2, \"hedgingDelay\": \"100s\", "
+      "\"nonFatalStatusCodes\": [ \"UNAVAILABLE\" ] }");
+  std::mt19937 rng(1);
+  const LatencySummary unhedged = Summarize(
+      RunCallsAgainstSlowBackend(kNumCalls, kSlowOneIn, kSlowMillis, &rng));
+  grpc_channel_destroy(channel_);
+  CreateChannel(
+      "{ \"maxAttempts\": 2, \"hedgingDelay\": \"0.05s\", "
+      "\"nonFatalStatusCodes\": [ \"UNAVAILABLE\" ] }");
+  const LatencySummary hedged = Summarize(
+      RunCallsAgainstSlowBackend(kNumCalls, kSlowOneIn, kSlowMillis, &rng));
+  gpr_log(GPR_INFO,
+          "call latency without hedging: p50=%" PRId64 "ms p90=%" PRId64
+          "ms p99=%" PRId64 "ms",
+          unhedged.p50, unhedged.p90, unhedged.p99);
+  gpr_log(GPR_INFO,
+          "call latency with hedging: p50=%" PRId64 "ms p90=%" PRId64
+          "ms p99=%" PRId64 "ms",
+          hedged.p50, hedged.p90, hedged.p99);
+  // One attempt in five is slow, so without hedging the 90th percentile is
+  // a slow attempt.  With hedging, a call is only slow if both of its
+  // attempts are, which is one call in 25.
+  EXPECT_GE(unhedged.p90, kSlowMillis);
+  EXPECT_LT(hedged.p90, kSlowMillis);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,217 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+std::vector<RingHashTable::Endpoint> MakeEndpoints(size_t count) {
+  std::vector<RingHashTable::Endpoint> endpoints(count);
+  for (size_t i = 0; i < count; ++i) {
+    endpoints[i].address = absl::StrCat("10.0.", i / 256, ".", i % 256, ":443");
+  }
+  return endpoints;
+}
+
+void ExpectSameTable(const RingHashTable& expected,
+                     const RingHashTable& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected.endpoint(i), actual.endpoint(i)) << "slot " << i;
+  }
+  std::mt19937_64 rng(1);
+  for (int i = 0; i < 1000; ++i) {
+    const uint64_t hash = rng();
+    ASSERT_EQ(expected.FindSlot(hash), actual.FindSlot(hash));
+  }
+}
+
+TEST(RingHashTableTest, UpdateRingMatchesBuildRing) {
+  std::mt19937 rng(1);
+  std::vector<RingHashTable::Endpoint> endpoints = MakeEndpoints(100);
+  RingHashTable ring = RingHashTable::BuildRing(endpoints, 4096, 8388608);
+  size_t next_address = endpoints.size();
+  for (int round = 0; round < 50; ++round) {
+    // Remove, add and reweight a few endpoints, as an EDS update would.
+    const size_t changes = 1 + rng() % 3;
+    for (size_t i = 0; i < changes; ++i) {
+      endpoints.erase(endpoints.begin() + rng() % endpoints.size());
+      RingHashTable::Endpoint added;
+      added.address = absl::StrCat("10.1.0.", next_address++, ":443");
+      endpoints.insert(endpoints.begin() + rng() % endpoints.size(), added);
+      endpoints[rng() % endpoints.size()].weight = 1 + rng() % 4;
+    }
+    RingHashTable updated =
+        RingHashTable::UpdateRing(ring, endpoints, 4096, 8388608);
+    ExpectSameTable(RingHashTable::BuildRing(endpoints, 4096, 8388608),
+                    updated);
+    ring = std::move(updated);
+  }
+}
+
+TEST(RingHashTableTest, UpdateRingWithDuplicateAddresses) {
+  std::vector<RingHashTable::Endpoint> endpoints = MakeEndpoints(10);
+  RingHashTable ring = RingHashTable::BuildRing(endpoints, 1024, 8388608);
+  endpoints.push_back(endpoints[3]);
+  ExpectSameTable(RingHashTable::BuildRing(endpoints, 1024, 8388608),
+                  RingHashTable::UpdateRing(ring, endpoints, 1024, 8388608));
+}
+
+TEST(RingHashTableTest, MaglevTableFollowsWeights) {
+  std::vector<RingHashTable::Endpoint> endpoints = MakeEndpoints(10);
+  endpoints[0].weight = 3;
+  RingHashTable table = RingHashTable::BuildMaglev(endpoints, 65537);
+  ASSERT_EQ(table.size(), 65537u);
+  std::vector<size_t> slots(endpoints.size());
+  for (size_t i = 0; i < table.size(); ++i) ++slots[table.endpoint(i)];
+  for (size_t i = 1; i < endpoints.size(); ++i) {
+    EXPECT_NEAR(static_cast<double>(slots[0]) / slots[i], 3, 0.1);
+  }
+}
+
+TEST(RingHashTableTest, MaglevTableIsMostlyStable) {
+  std::vector<RingHashTable::Endpoint> endpoints = MakeEndpoints(100);
+  RingHashTable table = RingHashTable::BuildMaglev(endpoints, 65537);
+  endpoints.erase(endpoints.begin() + 50);
+  RingHashTable updated = RingHashTable::BuildMaglev(endpoints, 65537);
+  // Besides the removed endpoint's slots, few slots change hands.
+  size_t moved = 0;
+  for (size_t i = 0; i < table.size(); ++i) {
+    const uint32_t before = table.endpoint(i);
+    if (before == 50) continue;
+    const uint32_t after = updated.endpoint(i);
+    if (before != (after < 50 ? after : after + 1)) ++moved;
+  }
+  EXPECT_LT(moved, table.size() / 50);
+}
+
+// Picks a slot for hash the way the ring_hash picker does when loads are
+// bounded and every endpoint is READY, and counts the call as in flight.
+size_t PickWithBoundedLoads(const RingHashTable& table, uint64_t hash,
+                            uint32_t hash_balance_factor,
+                            std::vector<intptr_t>* calls_in_flight) {
+  intptr_t total = 0;
+  for (intptr_t calls : *calls_in_flight) total += calls;
+  const intptr_t capacity = RingHashEndpointCapacity(
+      hash_balance_factor, total, calls_in_flight->size());
+  const size_t first_slot = table.FindSlot(hash);
+  size_t slot = table.FindSlotFrom(first_slot, [&](uint32_t index) {
+    return (*calls_in_flight)[index] < capacity;
+  });
+  if (slot == table.size()) slot = first_slot;
+  ++(*calls_in_flight)[table.endpoint(slot)];
+  return slot;
+}
+
+std::vector<RingHashTable> MakeRingAndMaglevTables(
+    const std::vector<RingHashTable::Endpoint>& endpoints) {
+  std::vector<RingHashTable> tables;
+  tables.push_back(RingHashTable::BuildRing(endpoints, 1024, 8388608));
+  tables.push_back(RingHashTable::BuildMaglev(endpoints, 65537));
+  return tables;
+}
+
+TEST(RingHashTableTest, EndpointCapacity) {
+  // 150% of (9 + 1) calls over 4 endpoints, rounded up.
+  EXPECT_EQ(RingHashEndpointCapacity(150, 9, 4), 4);
+  // Every endpoint may take at least one call.
+  EXPECT_EQ(RingHashEndpointCapacity(100, 0, 10), 1);
+  // Counts read while calls finish concurrently may be negative.
+  EXPECT_EQ(RingHashEndpointCapacity(125, -3, 2), 1);
+}
+
+TEST(RingHashTableTest, PickSpillsFromOverloadedEndpoint) {
+  std::vector<RingHashTable::Endpoint> endpoints = MakeEndpoints(4);
+  for (const RingHashTable& table : MakeRingAndMaglevTables(endpoints)) {
+    const uint64_t hash = 12345;
+    const size_t first_slot = table.FindSlot(hash);
+    const uint32_t overloaded = table.endpoint(first_slot);
+    // The endpoint the hash maps to has all 2 calls in flight, over the
+    // bound of ceil(1.25 * 3 / 4) = 1.
+    std::vector<intptr_t> calls_in_flight(endpoints.size(), 0);
+    calls_in_flight[overloaded] = 2;
+    const size_t slot =
+        PickWithBoundedLoads(table, hash, 125, &calls_in_flight);
+    // The pick goes to the next endpoint in the table instead.
+    const size_t next_slot = table.FindSlotFrom(
+        first_slot, [&](uint32_t index) { return index != overloaded; });
+    EXPECT_EQ(slot, next_slot);
+    EXPECT_NE(table.endpoint(slot), overloaded);
+    EXPECT_EQ(calls_in_flight[table.endpoint(slot)], 1);
+  }
+}
+
+TEST(RingHashTableTest, HotKeyStaysWithinLoadBound) {
+  constexpr int kCalls = 1000;
+  constexpr uint32_t kBalanceFactor = 125;
+  std::vector<RingHashTable::Endpoint> endpoints = MakeEndpoints(10);
+  for (const RingHashTable& table : MakeRingAndMaglevTables(endpoints)) {
+    std::vector<intptr_t> calls_in_flight(endpoints.size(), 0);
+    // Every call has the same hash, as for a single hot key.
+    for (int i = 0; i < kCalls; ++i) {
+      PickWithBoundedLoads(table, 42, kBalanceFactor, &calls_in_flight);
+    }
+    const intptr_t bound =
+        RingHashEndpointCapacity(kBalanceFactor, kCalls - 1, endpoints.size());
+    size_t endpoints_used = 0;
+    for (size_t i = 0; i < endpoints.size(); ++i) {
+      EXPECT_LE(calls_in_flight[i], bound) << "endpoint " << i;
+      if (calls_in_flight[i] > 0) ++endpoints_used;
+    }
+    // The key's own endpoint filled up, and the rest spilled over.
+    EXPECT_EQ(calls_in_flight[table.endpoint(table.FindSlot(42))], bound);
+    EXPECT_GE(endpoints_used, kCalls / bound);
+  }
+}
+
+TEST(RingHashTableTest, UnboundedPicksFollowTheTable) {
+  std::vector<RingHashTable::Endpoint> endpoints = MakeEndpoints(10);
+  RingHashTable maglev = RingHashTable::BuildMaglev(endpoints, 65537);
+  std::mt19937_64 rng(1);
+  std::vector<intptr_t> calls_in_flight(endpoints.size(), 0);
+  for (int i = 0; i < 1000; ++i) {
+    const uint64_t hash = rng();
+    // A Maglev lookup indexes the table directly.
+    const size_t slot = maglev.FindSlot(hash);
+    EXPECT_EQ(slot, hash % maglev.size());
+    // With a balance factor that never binds, picks stay on that slot.
+    EXPECT_EQ(PickWithBoundedLoads(maglev, hash,
+                                   std::numeric_limits<uint32_t>::max() / 2,
+                                   &calls_in_flight),
+              slot);
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
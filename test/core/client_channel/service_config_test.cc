@@ -547,6 +547,41 @@ TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigXds) {
   EXPECT_STREQ(lb_config->name(), "xds_cluster_resolver_experimental");
 }
 
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigRingHashMaglev) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"ring_hash_experimental\":{"
+      "\"lookup_table\":\"maglev\",\"maglev_table_size\":65537,"
+      "\"hash_balance_factor\":150}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* parsed_config =
+      static_cast<grpc_core::internal::ClientChannelGlobalParsedConfig*>(
+          svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_STREQ(lb_config->name(), "ring_hash_experimental");
+}
+
+TEST_F(ClientChannelParserTest, InvalidRingHashLoadBalancingConfig) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"ring_hash_experimental\":{"
+      "\"lookup_table\":\"maglev\",\"maglev_table_size\":65536,"
+      "\"hash_balance_factor\":99}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Global Params" CHILD_ERROR_TAG
+                  "Client channel global parser" CHILD_ERROR_TAG
+                  "field:loadBalancingConfig" CHILD_ERROR_TAG
+                  "ring_hash_experimental LB policy config" CHILD_ERROR_TAG
+                  "field:maglev_table_size error: should be a prime number"
+                  ".*field:hash_balance_factor error: should be an integer "
+                  "of at least 100"));
+  GRPC_ERROR_UNREF(error);
+}
+
 TEST_F(ClientChannelParserTest, UnknownLoadBalancingConfig) {
   const char* test_json = "{\"loadBalancingConfig\": [{\"unknown\":{}}]}";
   grpc_error_handle error = GRPC_ERROR_NONE;
@@ -1446,6 +1481,123 @@ TEST_F(RetryParserTest, InvalidRetryPolicyPerAttemptRecvTimeoutBadValue) {
   GRPC_ERROR_UNREF(error);
 }
 
+TEST_F(RetryParserTest, ValidHedgingPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0.5s\",\n"
+      "      \"nonFatalStatusCodes\": [\"UNAVAILABLE\"]\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg = ServiceConfig::Create(&args, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  const auto* parsed_config =
+      static_cast<grpc_core::internal::RetryMethodConfig*>(
+          ((*vector_ptr)[0]).get());
+  ASSERT_NE(parsed_config, nullptr);
+  EXPECT_TRUE(parsed_config->hedging());
+  EXPECT_EQ(parsed_config->max_attempts(), 3);
+  EXPECT_EQ(parsed_config->hedging_delay(), 500);
+  EXPECT_TRUE(parsed_config->non_fatal_status_codes().Contains(
+      GRPC_STATUS_UNAVAILABLE));
+  EXPECT_FALSE(
+      parsed_config->non_fatal_status_codes().Contains(GRPC_STATUS_ABORTED));
+}
+
+TEST_F(RetryParserTest, HedgingPolicyIgnoredWhenHedgingDisabled) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfig::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  EXPECT_EQ(((*vector_ptr)[0]).get(), nullptr);
+}
+
+TEST_F(RetryParserTest, InvalidHedgingPolicyMaxAttempts) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 1,\n"
+      "      \"hedgingDelay\": \"1s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg = ServiceConfig::Create(&args, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Method Params" CHILD_ERROR_TAG "methodConfig" CHILD_ERROR_TAG
+                  "hedgingPolicy" CHILD_ERROR_TAG
+                  "field:maxAttempts error:should be at least 2"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(RetryParserTest, InvalidHedgingPolicyWithRetryPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"retryPolicy\": {\n"
+      "      \"maxAttempts\": 2,\n"
+      "      \"initialBackoff\": \"1s\",\n"
+      "      \"maxBackoff\": \"120s\",\n"
+      "      \"backoffMultiplier\": 1.6,\n"
+      "      \"retryableStatusCodes\": [\"ABORTED\"]\n"
+      "    },\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 2\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg = ServiceConfig::Create(&args, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Method Params" CHILD_ERROR_TAG "methodConfig" CHILD_ERROR_TAG
+                  "field:hedgingPolicy error:cannot be specified with "
+                  "retryPolicy"));
+  GRPC_ERROR_UNREF(error);
+}
+
 //
 // message_size parser tests
 //
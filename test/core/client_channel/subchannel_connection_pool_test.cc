@@ -0,0 +1,274 @@
+//
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/backup_poller.h"
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/surface/channel.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+gpr_timespec Deadline(int seconds) {
+  return grpc_timeout_seconds_to_deadline(seconds);
+}
+
+class SubchannelConnectionPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    server_ = grpc_server_create(nullptr, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    // A single address, so that the channel has a single subchannel.
+    address_ = absl::StrCat("127.0.0.1:", grpc_pick_unused_port_or_die());
+    ASSERT_NE(grpc_server_add_insecure_http2_port(server_, address_.c_str()),
+              0);
+    grpc_server_start(server_);
+  }
+
+  void TearDown() override {
+    for (grpc_call* call : calls_) grpc_call_unref(call);
+    if (channel_ != nullptr) grpc_channel_destroy(channel_);
+    grpc_server_shutdown_and_notify(server_, cq_, Tag(1000));
+    grpc_server_cancel_all_calls(server_);
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_server_destroy(server_);
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  void CreateChannel(std::vector<grpc_arg> args) {
+    grpc_channel_args channel_args = {args.size(), args.data()};
+    channel_ = grpc_insecure_channel_create(
+        absl::StrCat("ipv4:", address_).c_str(), &channel_args, nullptr);
+  }
+
+  // Starts a call that stays open until the test ends.
+  void StartCall() {
+    grpc_call* call = grpc_channel_create_call(
+        channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_,
+        grpc_slice_from_static_string("/foo"), nullptr, Deadline(30), nullptr);
+    grpc_op op;
+    memset(&op, 0, sizeof(op));
+    op.op = GRPC_OP_SEND_INITIAL_METADATA;
+    ASSERT_EQ(grpc_call_start_batch(call, &op, 1, Tag(calls_.size() + 1),
+                                    nullptr),
+              GRPC_CALL_OK);
+    calls_.push_back(call);
+    grpc_event ev = grpc_completion_queue_next(cq_, Deadline(10), nullptr);
+    ASSERT_EQ(ev.type, GRPC_OP_COMPLETE);
+    ASSERT_EQ(ev.tag, Tag(calls_.size()));
+    ASSERT_TRUE(ev.success);
+  }
+
+  // Cancels and releases the calls started so far, and lets the channel
+  // notice that they are gone.
+  void FinishCalls() {
+    for (grpc_call* call : calls_) {
+      grpc_call_cancel(call, nullptr);
+      grpc_call_unref(call);
+    }
+    calls_.clear();
+    grpc_completion_queue_next(cq_, grpc_timeout_milliseconds_to_deadline(100),
+                               nullptr);
+  }
+
+  // Returns the number of sockets the channel's subchannel reports in
+  // channelz.
+  size_t NumSubchannelSockets() { return SubchannelSocketIds().size(); }
+
+  // Returns the channelz ids of the sockets of the channel's subchannel.
+  std::vector<intptr_t> SubchannelSocketIds() {
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    Json channel_json = Json::Parse(
+        grpc_channel_get_channelz_node(channel_)->RenderJsonString(), &error);
+    EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+    const Json::Object& channel = channel_json.object_value();
+    auto subchannel_refs = channel.find("subchannelRef");
+    if (subchannel_refs == channel.end()) return {};
+    EXPECT_EQ(subchannel_refs->second.array_value().size(), 1);
+    const Json::Object& subchannel_ref =
+        subchannel_refs->second.array_value()[0].object_value();
+    char* subchannel_str = grpc_channelz_get_subchannel(
+        strtol(subchannel_ref.at("subchannelId").string_value().c_str(),
+               nullptr, 10));
+    Json json = Json::Parse(subchannel_str, &error);
+    gpr_free(subchannel_str);
+    EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+    const Json::Object& subchannel =
+        json.object_value().at("subchannel").object_value();
+    auto socket_refs = subchannel.find("socketRef");
+    if (socket_refs == subchannel.end()) return {};
+    std::vector<intptr_t> ids;
+    for (const Json& socket_ref : socket_refs->second.array_value()) {
+      ids.push_back(strtol(
+          socket_ref.object_value().at("socketId").string_value().c_str(),
+          nullptr, 10));
+    }
+    return ids;
+  }
+
+  // Returns the number of streams started on the given socket.
+  int64_t StreamsStarted(intptr_t socket_id) {
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    char* socket_str = grpc_channelz_get_socket(socket_id);
+    Json json = Json::Parse(socket_str, &error);
+    gpr_free(socket_str);
+    EXPECT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+    const Json::Object& data = json.object_value()
+                                   .at("socket")
+                                   .object_value()
+                                   .at("data")
+                                   .object_value();
+    auto streams_started = data.find("streamsStarted");
+    if (streams_started == data.end()) return 0;
+    return strtoll(streams_started->second.string_value().c_str(), nullptr,
+                   10);
+  }
+
+  // Drives the channel until its subchannel reports the given number of
+  // sockets.
+  bool WaitForSubchannelSockets(size_t expected) {
+    gpr_timespec deadline = Deadline(10);
+    while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+      if (NumSubchannelSockets() == expected) return true;
+      grpc_completion_queue_next(cq_, grpc_timeout_milliseconds_to_deadline(10),
+                                 nullptr);
+    }
+    return NumSubchannelSockets() == expected;
+  }
+
+  std::string address_;
+  grpc_completion_queue* cq_ = nullptr;
+  grpc_server* server_ = nullptr;
+  grpc_channel* channel_ = nullptr;
+  std::vector<grpc_call*> calls_;
+};
+
+TEST_F(SubchannelConnectionPoolTest, SingleConnectionByDefault) {
+  CreateChannel({});
+  StartCall();
+  StartCall();
+  StartCall();
+  EXPECT_TRUE(WaitForSubchannelSockets(1));
+}
+
+TEST_F(SubchannelConnectionPoolTest, OpensMinConnections) {
+  CreateChannel({
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_MIN_CONNECTIONS), 3),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS), 3),
+  });
+  StartCall();
+  EXPECT_TRUE(WaitForSubchannelSockets(3));
+}
+
+TEST_F(SubchannelConnectionPoolTest, AddsConnectionsUpToMax) {
+  CreateChannel({
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS), 2),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_TARGET_CALLS_PER_CONNECTION),
+          1),
+  });
+  StartCall();
+  EXPECT_TRUE(WaitForSubchannelSockets(1));
+  StartCall();
+  EXPECT_TRUE(WaitForSubchannelSockets(2));
+  StartCall();
+  StartCall();
+  EXPECT_TRUE(WaitForSubchannelSockets(2));
+}
+
+TEST_F(SubchannelConnectionPoolTest, SpreadsCallsOverConnections) {
+  CreateChannel({
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_MIN_CONNECTIONS), 3),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS), 3),
+  });
+  grpc_channel_check_connectivity_state(channel_, /*try_to_connect=*/1);
+  ASSERT_TRUE(WaitForSubchannelSockets(3));
+  for (int i = 0; i < 6; ++i) StartCall();
+  std::vector<intptr_t> sockets = SubchannelSocketIds();
+  ASSERT_EQ(sockets.size(), 3);
+  for (intptr_t socket : sockets) {
+    EXPECT_EQ(StreamsStarted(socket), 2) << "socket " << socket;
+  }
+}
+
+TEST_F(SubchannelConnectionPoolTest, ShrinksWhenCallsFinish) {
+  CreateChannel({
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS), 3),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_TARGET_CALLS_PER_CONNECTION),
+          2),
+  });
+  // The second call fills the first connection, and the fourth the second.
+  StartCall();
+  StartCall();
+  ASSERT_TRUE(WaitForSubchannelSockets(2));
+  StartCall();
+  StartCall();
+  ASSERT_TRUE(WaitForSubchannelSockets(3));
+  FinishCalls();
+  // Each call picked while the calls fit on half of the other connections
+  // closes one idle connection.
+  StartCall();
+  EXPECT_TRUE(WaitForSubchannelSockets(2));
+  FinishCalls();
+  StartCall();
+  EXPECT_TRUE(WaitForSubchannelSockets(1));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(argc, argv);
+  // Connections are added while no call is waiting on the channel, so only
+  // the backup poller drives them.
+  GPR_GLOBAL_CONFIG_SET(grpc_client_channel_backup_poll_interval_ms, 1);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
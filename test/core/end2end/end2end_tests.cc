@@ -81,6 +81,10 @@ extern void filter_status_code(grpc_end2end_test_config config);
 extern void filter_status_code_pre_init(void);
 extern void graceful_server_shutdown(grpc_end2end_test_config config);
 extern void graceful_server_shutdown_pre_init(void);
+extern void hedging_server_pushback(grpc_end2end_test_config config);
+extern void hedging_server_pushback_pre_init(void);
+extern void hedging_throttled(grpc_end2end_test_config config);
+extern void hedging_throttled_pre_init(void);
 extern void high_initial_seqno(grpc_end2end_test_config config);
 extern void high_initial_seqno_pre_init(void);
 extern void hpack_size(grpc_end2end_test_config config);
@@ -239,6 +243,8 @@ void grpc_end2end_tests_pre_init(void) {
   filter_latency_pre_init();
   filter_status_code_pre_init();
   graceful_server_shutdown_pre_init();
+  hedging_server_pushback_pre_init();
+  hedging_throttled_pre_init();
   high_initial_seqno_pre_init();
   hpack_size_pre_init();
   idempotent_request_pre_init();
@@ -339,6 +345,8 @@ void grpc_end2end_tests(int argc, char **argv,
     filter_latency(config);
     filter_status_code(config);
     graceful_server_shutdown(config);
+    hedging_server_pushback(config);
+    hedging_throttled(config);
     high_initial_seqno(config);
     hpack_size(config);
     idempotent_request(config);
@@ -511,6 +519,14 @@ void grpc_end2end_tests(int argc, char **argv,
       graceful_server_shutdown(config);
       continue;
     }
+    if (0 == strcmp("hedging_server_pushback", argv[i])) {
+      hedging_server_pushback(config);
+      continue;
+    }
+    if (0 == strcmp("hedging_throttled", argv[i])) {
+      hedging_throttled(config);
+      continue;
+    }
     if (0 == strcmp("high_initial_seqno", argv[i])) {
       high_initial_seqno(config);
       continue;
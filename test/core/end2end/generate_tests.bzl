@@ -248,6 +248,8 @@ END2END_TESTS = {
     "filter_init_fails": _test_options(),
     "filter_context": _test_options(),
     "graceful_server_shutdown": _test_options(exclude_inproc = True),
+    "hedging_server_pushback": _test_options(needs_client_channel = True),
+    "hedging_throttled": _test_options(needs_client_channel = True),
     "hpack_size": _test_options(
         proxyable = False,
         traceable = False,
@@ -0,0 +1,37 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/iomgr/port.h"
+#include "test/core/event_engine/test_suite/event_engine_test.h"
+#include "test/core/util/test_config.h"
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+#ifdef GRPC_LINUX_EPOLL
+  SetEventEngineFactory([]() {
+    return absl::make_unique<
+        grpc_event_engine::experimental::PosixEventEngine>();
+  });
+  return RUN_ALL_TESTS();
+#else
+  // The POSIX EventEngine needs epoll.
+  return 0;
+#endif
+}
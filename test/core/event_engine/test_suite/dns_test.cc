@@ -0,0 +1,98 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/sockaddr.h"
+#include "test/core/event_engine/test_suite/event_engine_test.h"
+
+using ::grpc_event_engine::experimental::EventEngine;
+
+class EventEngineDNSTest : public EventEngineTest {
+ protected:
+  using Addresses = std::vector<EventEngine::ResolvedAddress>;
+
+  absl::StatusOr<Addresses> Resolve(EventEngine::DNSResolver* resolver,
+                                    absl::string_view address,
+                                    absl::string_view default_port) {
+    absl::StatusOr<Addresses> result;
+    grpc_core::MutexLock lock(&mu_);
+    resolver->LookupHostname(
+        [this, &result](absl::StatusOr<Addresses> addresses) {
+          grpc_core::MutexLock lock(&mu_);
+          result = std::move(addresses);
+          signaled_ = true;
+          cv_.Signal();
+        },
+        address, default_port, absl::Now() + absl::Seconds(30));
+    while (!signaled_) cv_.Wait(&mu_);
+    signaled_ = false;
+    return result;
+  }
+
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  bool signaled_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+TEST_F(EventEngineDNSTest, ResolvesLocalhost) {
+  auto engine = this->NewEventEngine();
+  auto resolver = engine->GetDNSResolver();
+  auto result = Resolve(resolver.get(), "localhost:443", "");
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_FALSE(result->empty());
+}
+
+TEST_F(EventEngineDNSTest, ResolvesIpv4LiteralWithDefaultPort) {
+  auto engine = this->NewEventEngine();
+  auto resolver = engine->GetDNSResolver();
+  auto result = Resolve(resolver.get(), "127.0.0.1", "80");
+  ASSERT_TRUE(result.ok()) << result.status();
+  ASSERT_EQ(result->size(), 1u);
+  const auto* addr =
+      reinterpret_cast<const grpc_sockaddr_in*>((*result)[0].address());
+  EXPECT_EQ(addr->sin_family, GRPC_AF_INET);
+  EXPECT_EQ(ntohs(addr->sin_port), 80);
+}
+
+TEST_F(EventEngineDNSTest, MissingPortIsAnError) {
+  auto engine = this->NewEventEngine();
+  auto resolver = engine->GetDNSResolver();
+  EXPECT_FALSE(Resolve(resolver.get(), "localhost", "").ok());
+}
+
+TEST_F(EventEngineDNSTest, CancelledLookupDoesNotRunCallback) {
+  std::atomic<bool> ran{false};
+  bool cancelled;
+  {
+    auto engine = this->NewEventEngine();
+    auto resolver = engine->GetDNSResolver();
+    auto handle = resolver->LookupHostname(
+        [&ran](absl::StatusOr<Addresses> /* addresses */) { ran = true; },
+        "localhost:443", "", absl::Now() + absl::Seconds(30));
+    cancelled = resolver->CancelLookup(handle);
+  }
+  // The engine is deleted, and all closures should have been flushed.
+  // A successful cancellation means the callback never runs; otherwise the
+  // lookup had already completed.
+  EXPECT_NE(cancelled, ran.load());
+}
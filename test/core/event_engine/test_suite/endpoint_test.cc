@@ -0,0 +1,273 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/slice_buffer.h>
+
+#include "src/core/lib/event_engine/channel_args_endpoint_config.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/sockaddr.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "test/core/event_engine/test_suite/event_engine_test.h"
+
+namespace {
+
+using ::grpc_event_engine::experimental::ChannelArgsEndpointConfig;
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::MemoryAllocator;
+using ::grpc_event_engine::experimental::SliceBuffer;
+
+EventEngine::ResolvedAddress LoopbackAddress(int port) {
+  grpc_sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = GRPC_AF_INET;
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  return EventEngine::ResolvedAddress(
+      reinterpret_cast<const grpc_sockaddr*>(&addr), sizeof(addr));
+}
+
+// A one-shot value that one thread sets and another waits for.
+template <typename T>
+class OneShot {
+ public:
+  void Set(T value) {
+    grpc_core::MutexLock lock(&mu_);
+    value_ = absl::make_unique<T>(std::move(value));
+    cv_.Signal();
+  }
+  T Get() {
+    grpc_core::MutexLock lock(&mu_);
+    while (value_ == nullptr) {
+      GPR_ASSERT(!cv_.WaitWithTimeout(&mu_, absl::Seconds(30)));
+    }
+    return std::move(*value_);
+  }
+
+ private:
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  std::unique_ptr<T> value_ ABSL_GUARDED_BY(mu_);
+};
+
+class EventEngineEndpointTest : public EventEngineTest {
+ protected:
+  void SetUp() override {
+    engine_ = NewEventEngine();
+    grpc_slice_buffer_init(&scratch_);
+  }
+
+  void TearDown() override {
+    grpc_slice_buffer_destroy(&scratch_);
+    engine_.reset();
+  }
+
+  // Create a started listener on an ephemeral loopback port that hands
+  // accepted endpoints to \a accepted.
+  std::unique_ptr<EventEngine::Listener> StartListener(
+      OneShot<std::unique_ptr<EventEngine::Endpoint>>* accepted,
+      OneShot<absl::Status>* shutdown, int* port) {
+    ChannelArgsEndpointConfig config(nullptr);
+    auto listener = engine_->CreateListener(
+        [accepted](std::unique_ptr<EventEngine::Endpoint> ep,
+                   MemoryAllocator /* allocator */) {
+          accepted->Set(std::move(ep));
+        },
+        [shutdown](absl::Status status) { shutdown->Set(status); }, config,
+        absl::make_unique<grpc_core::MemoryQuota>());
+    GPR_ASSERT(listener.ok());
+    auto bound_port = (*listener)->Bind(LoopbackAddress(0));
+    GPR_ASSERT(bound_port.ok());
+    *port = *bound_port;
+    GPR_ASSERT((*listener)->Start().ok());
+    return std::move(*listener);
+  }
+
+  absl::StatusOr<std::unique_ptr<EventEngine::Endpoint>> ConnectTo(int port) {
+    OneShot<absl::StatusOr<std::unique_ptr<EventEngine::Endpoint>>> connected;
+    ChannelArgsEndpointConfig config(nullptr);
+    engine_->Connect(
+        [&connected](
+            absl::StatusOr<std::unique_ptr<EventEngine::Endpoint>> ep) {
+          connected.Set(std::move(ep));
+        },
+        LoopbackAddress(port), config, memory_quota_.CreateMemoryAllocator(),
+        absl::Now() + absl::Seconds(10));
+    return connected.Get();
+  }
+
+  absl::Status WriteAll(EventEngine::Endpoint* ep, const std::string& data) {
+    grpc_slice_buffer buf;
+    grpc_slice_buffer_init(&buf);
+    grpc_slice_buffer_add(
+        &buf, grpc_slice_from_copied_buffer(data.data(), data.size()));
+    SliceBuffer slice_buffer(&buf);
+    OneShot<absl::Status> written;
+    ep->Write([&written](absl::Status status) { written.Set(status); },
+              &slice_buffer);
+    absl::Status status = written.Get();
+    grpc_slice_buffer_destroy(&buf);
+    return status;
+  }
+
+  // Read until \a length bytes have arrived or a read fails.
+  absl::StatusOr<std::string> ReadExactly(EventEngine::Endpoint* ep,
+                                          size_t length) {
+    std::string result;
+    while (result.size() < length) {
+      grpc_slice_buffer_reset_and_unref(&scratch_);
+      SliceBuffer slice_buffer(&scratch_);
+      OneShot<absl::Status> read;
+      ep->Read([&read](absl::Status status) { read.Set(status); },
+               &slice_buffer);
+      absl::Status status = read.Get();
+      if (!status.ok()) return status;
+      for (size_t i = 0; i < scratch_.count; ++i) {
+        const grpc_slice& slice = scratch_.slices[i];
+        result.append(
+            reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+            GRPC_SLICE_LENGTH(slice));
+      }
+    }
+    return result;
+  }
+
+  std::unique_ptr<EventEngine> engine_;
+  grpc_core::MemoryQuota memory_quota_;
+  grpc_slice_buffer scratch_;
+};
+
+TEST_F(EventEngineEndpointTest, ListenerReportsShutdown) {
+  OneShot<std::unique_ptr<EventEngine::Endpoint>> accepted;
+  OneShot<absl::Status> shutdown;
+  int port;
+  auto listener = StartListener(&accepted, &shutdown, &port);
+  EXPECT_GT(port, 0);
+  listener.reset();
+  EXPECT_TRUE(shutdown.Get().ok());
+}
+
+TEST_F(EventEngineEndpointTest, ConnectToClosedPortFails) {
+  int port;
+  {
+    OneShot<std::unique_ptr<EventEngine::Endpoint>> accepted;
+    OneShot<absl::Status> shutdown;
+    auto listener = StartListener(&accepted, &shutdown, &port);
+    listener.reset();
+    EXPECT_TRUE(shutdown.Get().ok());
+  }
+  EXPECT_FALSE(ConnectTo(port).ok());
+}
+
+TEST_F(EventEngineEndpointTest, ClientServerRoundTrip) {
+  OneShot<std::unique_ptr<EventEngine::Endpoint>> accepted;
+  OneShot<absl::Status> shutdown;
+  int port;
+  auto listener = StartListener(&accepted, &shutdown, &port);
+  auto client = ConnectTo(port);
+  ASSERT_TRUE(client.ok()) << client.status();
+  auto server = accepted.Get();
+  ASSERT_NE(server, nullptr);
+  const std::string request = "ping";
+  ASSERT_TRUE(WriteAll(client->get(), request).ok());
+  auto received = ReadExactly(server.get(), request.size());
+  ASSERT_TRUE(received.ok()) << received.status();
+  EXPECT_EQ(*received, request);
+  const std::string response = "pong";
+  ASSERT_TRUE(WriteAll(server.get(), response).ok());
+  received = ReadExactly(client->get(), response.size());
+  ASSERT_TRUE(received.ok()) << received.status();
+  EXPECT_EQ(*received, response);
+  client->reset();
+  server.reset();
+  listener.reset();
+  EXPECT_TRUE(shutdown.Get().ok());
+}
+
+TEST_F(EventEngineEndpointTest, LargeWriteIsDeliveredIntact) {
+  OneShot<std::unique_ptr<EventEngine::Endpoint>> accepted;
+  OneShot<absl::Status> shutdown;
+  int port;
+  auto listener = StartListener(&accepted, &shutdown, &port);
+  auto client = ConnectTo(port);
+  ASSERT_TRUE(client.ok()) << client.status();
+  auto server = accepted.Get();
+  // Larger than the socket buffers, so the write has to wait for the reader.
+  std::string payload(16 * 1024 * 1024, '\0');
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<char>(i % 251);
+  }
+  OneShot<absl::Status> written;
+  grpc_slice_buffer buf;
+  grpc_slice_buffer_init(&buf);
+  grpc_slice_buffer_add(
+      &buf, grpc_slice_from_copied_buffer(payload.data(), payload.size()));
+  SliceBuffer slice_buffer(&buf);
+  (*client)->Write([&written](absl::Status status) { written.Set(status); },
+                   &slice_buffer);
+  auto received = ReadExactly(server.get(), payload.size());
+  ASSERT_TRUE(received.ok()) << received.status();
+  EXPECT_TRUE(*received == payload);
+  EXPECT_TRUE(written.Get().ok());
+  grpc_slice_buffer_destroy(&buf);
+  client->reset();
+  server.reset();
+  listener.reset();
+  EXPECT_TRUE(shutdown.Get().ok());
+}
+
+TEST_F(EventEngineEndpointTest, DestroyingEndpointFailsPendingRead) {
+  OneShot<std::unique_ptr<EventEngine::Endpoint>> accepted;
+  OneShot<absl::Status> shutdown;
+  int port;
+  auto listener = StartListener(&accepted, &shutdown, &port);
+  auto client = ConnectTo(port);
+  ASSERT_TRUE(client.ok()) << client.status();
+  auto server = accepted.Get();
+  SliceBuffer slice_buffer(&scratch_);
+  OneShot<absl::Status> read;
+  server->Read([&read](absl::Status status) { read.Set(status); },
+               &slice_buffer);
+  server.reset();
+  EXPECT_FALSE(read.Get().ok());
+  client->reset();
+  listener.reset();
+  EXPECT_TRUE(shutdown.Get().ok());
+}
+
+TEST_F(EventEngineEndpointTest, PeerCloseFailsRead) {
+  OneShot<std::unique_ptr<EventEngine::Endpoint>> accepted;
+  OneShot<absl::Status> shutdown;
+  int port;
+  auto listener = StartListener(&accepted, &shutdown, &port);
+  auto client = ConnectTo(port);
+  ASSERT_TRUE(client.ok()) << client.status();
+  auto server = accepted.Get();
+  client->reset();
+  EXPECT_FALSE(ReadExactly(server.get(), 1).ok());
+  server.reset();
+  listener.reset();
+  EXPECT_TRUE(shutdown.Get().ok());
+}
+
+}  // namespace
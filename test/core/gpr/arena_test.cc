@@ -21,6 +21,9 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <string>
+#include <vector>
+
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 
@@ -115,6 +118,137 @@ static void concurrent_test(void) {
   args.arena->Destroy();
 }
 
+static void pool_test(void) {
+  gpr_log(GPR_DEBUG, "pool_test");
+
+  grpc_core::ArenaPool pool;
+  const size_t kIterations = 1000;
+  for (size_t i = 0; i < kIterations; i++) {
+    std::pair<Arena*, void*> arena_with_alloc = pool.CreateWithAlloc(3000, 64);
+    memset(arena_with_alloc.second, 1, 64);
+    // Spill into an extra zone every few calls; it must be freed on reuse.
+    memset(arena_with_alloc.first->Alloc(i % 4 == 0 ? 8192 : 128), 1, 128);
+    GPR_ASSERT(pool.Destroy(arena_with_alloc.first, /*trim=*/false) >= 192);
+  }
+  GPR_ASSERT(pool.hits() + pool.misses() == kIterations);
+  // Threads may migrate between CPUs, but most arenas should be reused.
+  GPR_ASSERT(pool.hits() > 0);
+  // Trimming empties every CPU's free lists.
+  pool.Trim();
+  GPR_ASSERT(pool.pooled_bytes() == 0);
+  uint64_t misses = pool.misses();
+  bool reused = true;
+  Arena* arena = pool.CreateWithAlloc(3000, 64, &reused).first;
+  GPR_ASSERT(!reused);
+  GPR_ASSERT(pool.misses() == misses + 1);
+  pool.Destroy(arena, /*trim=*/false);
+  GPR_ASSERT(pool.pooled_bytes() == 3000);
+  // Sizes are not rounded up, and much larger pooled arenas are not handed
+  // out for small requests.
+  arena = pool.CreateWithAlloc(2000, 64, &reused).first;
+  GPR_ASSERT(!reused);
+  pool.Destroy(arena, /*trim=*/true);
+  GPR_ASSERT(pool.pooled_bytes() == 0);
+  // The pool keeps no more than kMaxPooledBytes, however many arenas are
+  // destroyed at once.
+  std::vector<Arena*> arenas;
+  for (size_t i = 0; i < 2 * grpc_core::ArenaPool::kMaxPooledBytes /
+                             grpc_core::ArenaPool::kMaxPooledSize;
+       i++) {
+    arenas.push_back(
+        pool.CreateWithAlloc(grpc_core::ArenaPool::kMaxPooledSize, 64).first);
+  }
+  for (Arena* a : arenas) pool.Destroy(a, /*trim=*/false);
+  GPR_ASSERT(pool.pooled_bytes() == grpc_core::ArenaPool::kMaxPooledBytes);
+  pool.Trim();
+  misses = pool.misses();
+  // Arenas larger than the largest size class bypass the pool.
+  arena = pool.CreateWithAlloc(grpc_core::ArenaPool::kMaxPooledSize + 1, 64,
+                               &reused)
+              .first;
+  GPR_ASSERT(!reused);
+  GPR_ASSERT(pool.misses() == misses);
+  pool.Destroy(arena, /*trim=*/false);
+  GPR_ASSERT(pool.pooled_bytes() == 0);
+}
+
+static void packing_test(void) {
+  gpr_log(GPR_DEBUG, "packing_test");
+
+  // Small objects are aligned to their own alignment, not to 16 bytes.
+  Arena* a = Arena::Create(1024);
+  char* c1 = a->New<char>('a');
+  char* c2 = a->New<char>('b');
+  GPR_ASSERT(c2 == c1 + 1);
+  uint32_t* i1 = a->New<uint32_t>(1);
+  GPR_ASSERT(reinterpret_cast<intptr_t>(i1) % alignof(uint32_t) == 0);
+  GPR_ASSERT(reinterpret_cast<char*>(i1) - c2 < 8);
+  // The default alignment is still 16 bytes.
+  void* p = a->Alloc(3);
+  GPR_ASSERT(((intptr_t)p & 0xf) == 0);
+  char* s = static_cast<char*>(a->Alloc(5, 1));
+  GPR_ASSERT(s == static_cast<char*>(p) + 3);
+  GPR_ASSERT(a->Destroy() == 24);
+
+  // Objects larger than the initial zone are aligned too.
+  a = Arena::Create(16);
+  a->New<char>();
+  uint64_t* big = a->New<uint64_t>(1);
+  GPR_ASSERT(reinterpret_cast<intptr_t>(big) % alignof(uint64_t) == 0);
+  a->Destroy();
+}
+
+static int destroyed[3];
+static int destroy_count;
+
+struct Tracked {
+  explicit Tracked(int i) : index(i) {}
+  ~Tracked() { destroyed[index] = ++destroy_count; }
+  int index;
+};
+
+static void managed_new_test(void) {
+  gpr_log(GPR_DEBUG, "managed_new_test");
+
+  memset(destroyed, 0, sizeof(destroyed));
+  destroy_count = 0;
+  Arena* a = Arena::Create(1024);
+  for (int i = 0; i < 3; i++) {
+    GPR_ASSERT(a->ManagedNew<Tracked>(i)->index == i);
+  }
+  // Trivially destructible objects take no extra space.
+  uint8_t* byte = a->ManagedNew<uint8_t>(7);
+  uint8_t* next = a->New<uint8_t>(8);
+  GPR_ASSERT(next == byte + 1);
+  GPR_ASSERT(destroyed[0] == 0);
+  a->Destroy();
+  // Destructors run in reverse order of construction.
+  GPR_ASSERT(destroyed[2] == 1);
+  GPR_ASSERT(destroyed[1] == 2);
+  GPR_ASSERT(destroyed[0] == 3);
+
+  // Pooled arenas run destructors before their memory is recycled.
+  memset(destroyed, 0, sizeof(destroyed));
+  grpc_core::ArenaPool pool;
+  a = pool.CreateWithAlloc(1024, 0).first;
+  a->ManagedNew<Tracked>(1);
+  pool.Destroy(a, /*trim=*/false);
+  GPR_ASSERT(destroyed[1] != 0);
+
+  // Containers can keep their storage in the arena.
+  a = Arena::Create(1024);
+  std::vector<std::string, grpc_core::ArenaAllocator<std::string>>* strings =
+      a->ManagedNew<
+          std::vector<std::string, grpc_core::ArenaAllocator<std::string>>>(
+          grpc_core::ArenaAllocator<std::string>(a));
+  strings->reserve(4);
+  for (int i = 0; i < 4; i++) {
+    strings->push_back(std::string(64, static_cast<char>('a' + i)));
+  }
+  GPR_ASSERT((*strings)[3][63] == 'd');
+  a->Destroy();
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(argc, argv);
 
@@ -126,6 +260,9 @@ int main(int argc, char* argv[]) {
   TEST(1_inc, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
   TEST(6_123, 6, 1, 2, 3);
   concurrent_test();
+  pool_test();
+  packing_test();
+  managed_new_test();
 
   return 0;
 }
@@ -0,0 +1,131 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/gprpp/rcu_ptr.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+struct Value {
+  explicit Value(int v) : value(v) {}
+  int value;
+  std::atomic<bool> destroyed{false};
+};
+
+TEST(RcuPtrTest, ReadersSeePublishedValue) {
+  RcuPtr<Value> ptr;
+  {
+    RcuPtr<Value>::ReadLock value(&ptr);
+    EXPECT_EQ(value.get(), nullptr);
+  }
+  EXPECT_EQ(ptr.Exchange(absl::make_unique<Value>(1)), nullptr);
+  {
+    RcuPtr<Value>::ReadLock value(&ptr);
+    EXPECT_EQ(value->value, 1);
+  }
+  std::unique_ptr<Value> old = ptr.Exchange(absl::make_unique<Value>(2));
+  ASSERT_NE(old, nullptr);
+  EXPECT_EQ(old->value, 1);
+  ptr.Synchronize();
+  EXPECT_EQ(ptr.get()->value, 2);
+}
+
+TEST(RcuPtrTest, SynchronizeWaitsForReadSections) {
+  RcuPtr<Value> ptr(absl::make_unique<Value>(1));
+  std::atomic<bool> reading{false};
+  std::atomic<bool> finish_reading{false};
+  std::atomic<bool> synchronized{false};
+  std::thread reader([&]() {
+    RcuPtr<Value>::ReadLock value(&ptr);
+    reading.store(true);
+    while (!finish_reading.load()) {
+      std::this_thread::yield();
+    }
+    EXPECT_FALSE(synchronized.load());
+    EXPECT_EQ(value->value, 1);
+  });
+  while (!reading.load()) {
+    std::this_thread::yield();
+  }
+  std::unique_ptr<Value> old = ptr.Exchange(absl::make_unique<Value>(2));
+  std::thread writer([&]() {
+    ptr.Synchronize();
+    synchronized.store(true);
+  });
+  // Give the writer a chance to (wrongly) return early.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(synchronized.load());
+  finish_reading.store(true);
+  writer.join();
+  reader.join();
+  EXPECT_TRUE(synchronized.load());
+}
+
+TEST(RcuPtrTest, ReadersNeverSeeReclaimedValues) {
+  constexpr int kNumReaders = 8;
+  constexpr int kNumUpdates = 20000;
+  RcuPtr<Value> ptr(absl::make_unique<Value>(0));
+  std::atomic<bool> done{false};
+  std::atomic<int> bad_reads{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < kNumReaders; ++i) {
+    readers.emplace_back([&]() {
+      int last_value = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        RcuPtr<Value>::ReadLock value(&ptr);
+        if (value->destroyed.load(std::memory_order_relaxed) ||
+            value->value < last_value) {
+          bad_reads.fetch_add(1);
+        }
+        last_value = value->value;
+      }
+    });
+  }
+  for (int i = 1; i <= kNumUpdates; ++i) {
+    std::unique_ptr<Value> old = ptr.Exchange(absl::make_unique<Value>(i));
+    ptr.Synchronize();
+    // Readers are done with the old value, so marking it (as destroying it
+    // would) must go unnoticed.
+    old->destroyed.store(true, std::memory_order_relaxed);
+  }
+  done.store(true);
+  for (auto& reader : readers) reader.join();
+  EXPECT_EQ(bad_reads.load(), 0);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -38,7 +38,7 @@ struct WorkItem {
 // produced items on destructing.
 class ProducerThread {
  public:
-  ProducerThread(grpc_core::InfLenFIFOQueue* queue, int start_index,
+  ProducerThread(grpc_core::MPMCQueueInterface* queue, int start_index,
                  int num_items)
       : start_index_(start_index), num_items_(num_items), queue_(queue) {
     items_ = nullptr;
@@ -68,7 +68,7 @@ class ProducerThread {
 
   int start_index_;
   int num_items_;
-  grpc_core::InfLenFIFOQueue* queue_;
+  grpc_core::MPMCQueueInterface* queue_;
   grpc_core::Thread thd_;
   WorkItem** items_;
 };
@@ -76,7 +76,8 @@ class ProducerThread {
 // Thread to pull out items from queue
 class ConsumerThread {
  public:
-  explicit ConsumerThread(grpc_core::InfLenFIFOQueue* queue) : queue_(queue) {
+  explicit ConsumerThread(grpc_core::MPMCQueueInterface* queue)
+      : queue_(queue) {
     thd_ = grpc_core::Thread(
         "mpmcq_test_consumer_thd",
         [](void* th) { static_cast<ConsumerThread*>(th)->Run(); }, this);
@@ -100,13 +101,13 @@ class ConsumerThread {
 
     gpr_log(GPR_DEBUG, "ConsumerThread: %d times of Get() called.", count);
   }
-  grpc_core::InfLenFIFOQueue* queue_;
+  grpc_core::MPMCQueueInterface* queue_;
   grpc_core::Thread thd_;
 };
 
-static void test_FIFO(void) {
+static void test_FIFO(grpc_core::MPMCQueueInterface* large_queue_ptr) {
   gpr_log(GPR_INFO, "test_FIFO");
-  grpc_core::InfLenFIFOQueue large_queue;
+  grpc_core::MPMCQueueInterface& large_queue = *large_queue_ptr;
   for (int i = 0; i < TEST_NUM_ITEMS; ++i) {
     large_queue.Put(static_cast<void*>(new WorkItem(i)));
   }
@@ -118,6 +119,29 @@ static void test_FIFO(void) {
   }
 }
 
+// Puts and gets in bursts that leave the queue empty at, and just around, block
+// boundaries.
+static void test_interleaved(grpc_core::MPMCQueueInterface* queue) {
+  gpr_log(GPR_INFO, "test_interleaved");
+  int next_put = 0;
+  int next_get = 0;
+  for (int burst = 1; burst < 200; ++burst) {
+    for (int i = 0; i < burst; ++i) {
+      queue->Put(static_cast<void*>(new WorkItem(next_put++)));
+    }
+    GPR_ASSERT(queue->count() == burst);
+    for (int i = 0; i < burst; ++i) {
+      WorkItem* item = static_cast<WorkItem*>(queue->Get(nullptr));
+      GPR_ASSERT(item->index == next_get++);
+      delete item;
+    }
+    GPR_ASSERT(queue->count() == 0);
+  }
+  // nullptr is a valid element.
+  queue->Put(nullptr);
+  GPR_ASSERT(queue->Get(nullptr) == nullptr);
+}
+
 // Test if queue's behavior of expanding is correct. (Only does expansion when
 // it gets full, and each time expands to doubled size).
 static void test_space_efficiency(void) {
@@ -169,11 +193,11 @@ static void test_space_efficiency(void) {
   gpr_log(GPR_DEBUG, "Done.");
 }
 
-static void test_many_thread(void) {
+static void test_many_thread(grpc_core::MPMCQueueInterface* queue_ptr) {
   gpr_log(GPR_INFO, "test_many_thread");
   const int num_producer_threads = 10;
   const int num_consumer_threads = 20;
-  grpc_core::InfLenFIFOQueue queue;
+  grpc_core::MPMCQueueInterface& queue = *queue_ptr;
   ProducerThread** producer_threads = new ProducerThread*[num_producer_threads];
   ConsumerThread** consumer_threads = new ConsumerThread*[num_consumer_threads];
 
@@ -219,9 +243,18 @@ static void test_many_thread(void) {
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
-  test_FIFO();
+  {
+    grpc_core::InfLenFIFOQueue queue;
+    test_FIFO(&queue);
+    test_many_thread(&queue);
+  }
   test_space_efficiency();
-  test_many_thread();
+  {
+    grpc_core::LockFreeFIFOQueue queue;
+    test_FIFO(&queue);
+    test_interleaved(&queue);
+    test_many_thread(&queue);
+  }
   grpc_shutdown();
   return 0;
 }
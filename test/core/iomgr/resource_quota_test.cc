@@ -825,6 +825,90 @@ static void test_slice_allocator_capped_allocation() {
   }
 }
 
+static void test_slice_allocator_recycles_read_buffers() {
+  gpr_log(GPR_INFO, "** test_slice_allocator_recycles_read_buffers **");
+  grpc_resource_quota* resource_quota =
+      grpc_resource_quota_create("test_slice_allocator_recycles_read_buffers");
+  grpc_resource_quota_resize(resource_quota, 1024 * 1024);
+  grpc_slice_allocator* slice_allocator =
+      grpc_slice_allocator_create(resource_quota, "reader");
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+  for (int i = 0; i < 100; i++) {
+    {
+      // Read buffers close below a length the slab recycles are rounded up
+      // to it. The first allocation waits for the quota, later ones are served
+      // inline from memory the allocator already holds.
+      grpc_core::ExecCtx exec_ctx;
+      GPR_ASSERT(grpc_slice_allocator_allocate(
+                     slice_allocator, 7000, 2,
+                     grpc_slice_allocator_intent::kReadBuffer, &buffer,
+                     [](void*, grpc_error_handle) {}, nullptr) == (i > 0));
+    }
+    GPR_ASSERT(buffer.count == 2);
+    for (size_t j = 0; j < buffer.count; j++) {
+      GPR_ASSERT(grpc_refcounted_slice_length(buffer.slices[j]) == 8192);
+      memset(GRPC_SLICE_START_PTR(buffer.slices[j]), i, 8192);
+    }
+    grpc_core::ExecCtx exec_ctx;
+    grpc_slice_buffer_reset_and_unref_internal(&buffer);
+  }
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_slice_allocator_destroy(slice_allocator);
+    grpc_resource_quota_unref(resource_quota);
+    grpc_slice_buffer_destroy_internal(&buffer);
+  }
+}
+
+static void test_slice_allocator_recycled_buffers_stay_charged() {
+  gpr_log(GPR_INFO,
+          "** test_slice_allocator_recycled_buffers_stay_charged **");
+  grpc_resource_quota* resource_quota = grpc_resource_quota_create(
+      "test_slice_allocator_recycled_buffers_stay_charged");
+  grpc_resource_quota_resize(resource_quota, 64 * 1024);
+  grpc_slice_allocator* slice_allocator =
+      grpc_slice_allocator_create(resource_quota, "reader");
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+  {
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(!grpc_slice_allocator_allocate(
+        slice_allocator, 8192, 2, grpc_slice_allocator_intent::kReadBuffer,
+        &buffer, set_event_cb, &ev));
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               nullptr);
+  }
+  {
+    // Recycled buffers count towards the quota once their allocator is gone.
+    grpc_core::ExecCtx exec_ctx;
+    grpc_slice_buffer_reset_and_unref_internal(&buffer);
+    grpc_slice_allocator_destroy(slice_allocator);
+  }
+  GPR_ASSERT(grpc_resource_quota_get_memory_pressure(resource_quota) >= 0.25);
+  // The whole quota is only available once the slab gives them back.
+  grpc_resource_user* usr = grpc_resource_user_create(resource_quota, "usr");
+  {
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(!grpc_resource_user_alloc(usr, 64 * 1024, set_event(&ev)));
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               nullptr);
+  }
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_resource_user_free(usr, 64 * 1024);
+    grpc_resource_quota_unref(resource_quota);
+    grpc_slice_buffer_destroy_internal(&buffer);
+  }
+  destroy_user(usr);
+}
+
 static void test_one_slice_deleted_late(void) {
   gpr_log(GPR_INFO, "** test_one_slice_deleted_late **");
   grpc_resource_quota* q =
@@ -1015,6 +1099,8 @@ int main(int argc, char** argv) {
   test_one_slice_through_slice_allocator_factory();
   test_slice_allocator_pressure_adjusted_allocation();
   test_slice_allocator_capped_allocation();
+  test_slice_allocator_recycles_read_buffers();
+  test_slice_allocator_recycled_buffers_stay_charged();
   gpr_mu_destroy(&g_mu);
   gpr_cv_destroy(&g_cv);
 
@@ -473,6 +473,95 @@ static void write_test(size_t num_bytes, size_t slice_size,
   gpr_free(slices);
 }
 
+#define BATCHED_WRITE_ENDPOINTS 4
+
+struct batched_write_state {
+  grpc_endpoint* eps[BATCHED_WRITE_ENDPOINTS];
+  grpc_slice_buffer outgoing[BATCHED_WRITE_ENDPOINTS];
+  struct write_socket_state states[BATCHED_WRITE_ENDPOINTS];
+  grpc_closure write_done_closures[BATCHED_WRITE_ENDPOINTS];
+};
+
+static void start_batched_writes(void* arg /* batched_write_state */,
+                                 grpc_error_handle /*error*/) {
+  struct batched_write_state* state =
+      static_cast<struct batched_write_state*>(arg);
+  for (int i = 0; i < BATCHED_WRITE_ENDPOINTS; i++) {
+    grpc_endpoint_write(state->eps[i], &state->outgoing[i],
+                        &state->write_done_closures[i], nullptr);
+  }
+}
+
+/* Write to several sockets from a closure run by a write batching flush, as a
+   poller does, then drain them directly. Writes that do not complete within
+   the batch finish as ordinary writes while the sockets are drained. */
+static void batched_write_test(size_t num_bytes, size_t slice_size) {
+  int sv[BATCHED_WRITE_ENDPOINTS][2];
+  struct batched_write_state state;
+  grpc_slice* slices[BATCHED_WRITE_ENDPOINTS];
+  grpc_closure start_closure;
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO,
+          "Start batched write test with %" PRIuPTR
+          " bytes, slice size %" PRIuPTR,
+          num_bytes, slice_size);
+
+  grpc_arg a[1];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_WRITE_BATCHING_ENABLED);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = 1;
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  for (int i = 0; i < BATCHED_WRITE_ENDPOINTS; i++) {
+    create_sockets(sv[i]);
+    state.eps[i] =
+        grpc_tcp_create(grpc_fd_create(sv[i][1], "batched_write_test", false),
+                        &args, "test", grpc_slice_allocator_create_unlimited());
+    grpc_endpoint_add_to_pollset(state.eps[i], g_pollset);
+    state.states[i].ep = state.eps[i];
+    state.states[i].write_done = 0;
+    size_t num_blocks;
+    uint8_t current_data = 0;
+    slices[i] =
+        allocate_blocks(num_bytes, slice_size, &num_blocks, &current_data);
+    grpc_slice_buffer_init(&state.outgoing[i]);
+    grpc_slice_buffer_addn(&state.outgoing[i], slices[i], num_blocks);
+    GRPC_CLOSURE_INIT(&state.write_done_closures[i], write_done,
+                      &state.states[i], grpc_schedule_on_exec_ctx);
+  }
+
+  grpc_core::ExecCtx::Run(
+      DEBUG_LOCATION,
+      GRPC_CLOSURE_INIT(&start_closure, start_batched_writes, &state,
+                        grpc_schedule_on_exec_ctx),
+      GRPC_ERROR_NONE);
+  grpc_fd_flush_exec_ctx_batching_writes();
+  for (int i = 0; i < BATCHED_WRITE_ENDPOINTS; i++) {
+    drain_socket_blocking(sv[i][0], num_bytes, num_bytes);
+  }
+  gpr_mu_lock(g_mu);
+  for (int i = 0; i < BATCHED_WRITE_ENDPOINTS; i++) {
+    while (!state.states[i].write_done) {
+      grpc_pollset_worker* worker = nullptr;
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+      gpr_mu_unlock(g_mu);
+      exec_ctx.Flush();
+      gpr_mu_lock(g_mu);
+    }
+  }
+  gpr_mu_unlock(g_mu);
+
+  for (int i = 0; i < BATCHED_WRITE_ENDPOINTS; i++) {
+    grpc_slice_buffer_destroy_internal(&state.outgoing[i]);
+    grpc_endpoint_destroy(state.eps[i]);
+    close(sv[i][0]);
+    gpr_free(slices[i]);
+  }
+}
+
 void on_fd_released(void* arg, grpc_error_handle /*errors*/) {
   int* done = static_cast<int*>(arg);
   *done = 1;
@@ -585,6 +674,10 @@ void run_tests(void) {
     write_test(40320, i, true);
   }
 
+  batched_write_test(100, 8192);
+  batched_write_test(100000, 1);
+  batched_write_test(2000000, 8192);
+
   release_fd_test(100, 8192);
 }
 
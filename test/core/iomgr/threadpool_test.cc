@@ -65,10 +65,17 @@ class SimpleFunctorForAdd : public grpc_completion_queue_functor {
   std::atomic<int> count_{0};
 };
 
-static void test_add(void) {
+static grpc_core::ThreadPool* make_pool(
+    int num_threads, const char* name,
+    grpc_core::ThreadPoolQueueType queue_type) {
+  return new grpc_core::ThreadPool(num_threads, name,
+                                   grpc_core::Thread::Options(), queue_type);
+}
+
+static void test_add(grpc_core::ThreadPoolQueueType queue_type) {
   gpr_log(GPR_INFO, "test_add");
   grpc_core::ThreadPool* pool =
-      new grpc_core::ThreadPool(kSmallThreadPoolSize, "test_add");
+      make_pool(kSmallThreadPoolSize, "test_add", queue_type);
 
   SimpleFunctorForAdd* functor = new SimpleFunctorForAdd();
   for (int i = 0; i < kThreadSmallIter; ++i) {
@@ -107,11 +114,11 @@ class WorkThread {
   grpc_core::Thread thd_;
 };
 
-static void test_multi_add(void) {
+static void test_multi_add(grpc_core::ThreadPoolQueueType queue_type) {
   gpr_log(GPR_INFO, "test_multi_add");
   const int num_work_thds = 10;
   grpc_core::ThreadPool* pool =
-      new grpc_core::ThreadPool(kLargeThreadPoolSize, "test_multi_add");
+      make_pool(kLargeThreadPoolSize, "test_multi_add", queue_type);
   SimpleFunctorForAdd* functor = new SimpleFunctorForAdd();
   WorkThread** work_thds = static_cast<WorkThread**>(
       gpr_zalloc(sizeof(WorkThread*) * num_work_thds));
@@ -155,11 +162,11 @@ class SimpleFunctorCheckForAdd : public grpc_completion_queue_functor {
   int* count_;
 };
 
-static void test_one_thread_FIFO(void) {
+static void test_one_thread_FIFO(grpc_core::ThreadPoolQueueType queue_type) {
   gpr_log(GPR_INFO, "test_one_thread_FIFO");
   int counter = 0;
   grpc_core::ThreadPool* pool =
-      new grpc_core::ThreadPool(1, "test_one_thread_FIFO");
+      make_pool(1, "test_one_thread_FIFO", queue_type);
   SimpleFunctorCheckForAdd** check_functors =
       static_cast<SimpleFunctorCheckForAdd**>(
           gpr_zalloc(sizeof(SimpleFunctorCheckForAdd*) * kThreadSmallIter));
@@ -181,9 +188,12 @@ int main(int argc, char** argv) {
   grpc_init();
   test_size_zero();
   test_constructor_option();
-  test_add();
-  test_multi_add();
-  test_one_thread_FIFO();
+  for (auto queue_type : {grpc_core::ThreadPoolQueueType::kLocked,
+                          grpc_core::ThreadPoolQueueType::kLockFree}) {
+    test_add(queue_type);
+    test_multi_add(queue_type);
+    test_one_thread_FIFO(queue_type);
+  }
   grpc_shutdown();
   return 0;
 }
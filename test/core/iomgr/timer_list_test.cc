@@ -27,6 +27,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "test/core/util/test_config.h"
@@ -218,7 +219,72 @@ void long_running_service_cleanup_test(void) {
   GPR_ASSERT(1 == cb_called[3][0]);
 }
 
-int main(int argc, char** argv) {
+/* Timers spread over every level of the timer wheel, and beyond its range,
+   fire once their deadline is reached and not before. */
+void multi_level_test(void) {
+  static const int64_t kDeadlines[] = {
+      1,     255,     256,     257,       1000,     16383,
+      16384, 1048575, 1048576, 3600000,   67108864, kMillisIn25Days};
+  constexpr size_t kNumTimers = GPR_ARRAY_SIZE(kDeadlines);
+  grpc_timer timers[kNumTimers];
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "multi_level_test");
+
+  grpc_timer_list_init();
+  memset(cb_called, 0, sizeof(cb_called));
+
+  grpc_millis start = grpc_core::ExecCtx::Get()->Now();
+  for (size_t i = 0; i < kNumTimers; i++) {
+    grpc_timer_init(
+        &timers[i], start + kDeadlines[i],
+        GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)i, grpc_schedule_on_exec_ctx));
+  }
+
+  for (size_t i = 0; i < kNumTimers; i++) {
+    grpc_millis next = GRPC_MILLIS_INF_FUTURE;
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(start + kDeadlines[i] - 1);
+    grpc_timer_check(&next);
+    grpc_core::ExecCtx::Get()->Flush();
+    /* The hint may be early, but never later than the next deadline. */
+    GPR_ASSERT(next <= start + kDeadlines[i]);
+    GPR_ASSERT(cb_called[i][1] == 0);
+
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(start + kDeadlines[i]);
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+    for (size_t j = 0; j < kNumTimers; j++) {
+      GPR_ASSERT(cb_called[j][1] == (j <= i));
+      GPR_ASSERT(cb_called[j][0] == 0);
+    }
+  }
+
+  grpc_timer_list_shutdown();
+}
+
+/* Cancelling a timer that ran as soon as it was set is a no-op. */
+void cancel_expired_test(void) {
+  grpc_timer timer;
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "cancel_expired_test");
+
+  grpc_timer_list_init();
+  memset(cb_called, 0, sizeof(cb_called));
+
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_timer_init(
+      &timer, now,
+      GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)0, grpc_schedule_on_exec_ctx));
+  grpc_timer_cancel(&timer);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(1 == cb_called[0][1]);
+  GPR_ASSERT(0 == cb_called[0][0]);
+
+  grpc_timer_list_shutdown();
+}
+
+static void run_tests(int argc, char** argv) {
   /* Tests with default g_start_time */
   {
     grpc::testing::TestEnvironment env(argc, argv);
@@ -229,6 +295,8 @@ int main(int argc, char** argv) {
     gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
     add_test();
     destruction_test();
+    multi_level_test();
+    cancel_expired_test();
     grpc_iomgr_platform_shutdown();
   }
   grpc_core::ExecCtx::GlobalShutdown();
@@ -251,10 +319,18 @@ int main(int argc, char** argv) {
     long_running_service_cleanup_test();
     add_test();
     destruction_test();
+    multi_level_test();
     grpc_iomgr_platform_shutdown();
   }
   grpc_core::ExecCtx::GlobalShutdown();
+}
 
+int main(int argc, char** argv) {
+  for (const char* impl : {"heap", "wheel"}) {
+    GPR_GLOBAL_CONFIG_SET(grpc_timer_impl, impl);
+    gpr_log(GPR_INFO, "timer implementation: %s", impl);
+    run_tests(argc, argv);
+  }
   return 0;
 }
 
@@ -14,6 +14,9 @@
 
 #include "src/core/lib/resource_quota/memory_quota.h"
 
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "absl/synchronization/notification.h"
@@ -178,6 +181,83 @@ TEST(MemoryQuotaTest, ContainerAllocator) {
   }
 }
 
+TEST(MemoryQuotaTest, CachedBytesStayWithinSlack) {
+  constexpr size_t kQuotaSize = 16 * 1024 * 1024;
+  auto memory_quota = std::make_shared<BasicMemoryQuota>();
+  memory_quota->SetSize(kQuotaSize);
+  const size_t max_cached = memory_quota->MaxCachedBytes();
+  EXPECT_GT(max_cached, 0);
+  EXPECT_LE(max_cached, kQuotaSize / 16);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&memory_quota, max_cached, t]() {
+      std::vector<size_t> taken;
+      for (int i = 0; i < 10000; i++) {
+        size_t amount = 1 + (i * 7919 + t * 104729) % 8192;
+        memory_quota->Take(amount);
+        taken.push_back(amount);
+        if (taken.size() == 16) {
+          for (size_t n : taken) memory_quota->Return(n);
+          taken.clear();
+          EXPECT_LE(memory_quota->CachedBytes(), max_cached);
+        }
+      }
+      for (size_t n : taken) memory_quota->Return(n);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_LE(memory_quota->CachedBytes(), max_cached);
+  memory_quota->DrainCaches();
+  EXPECT_EQ(memory_quota->CachedBytes(), 0);
+  // Shrinking the quota shrinks the bound on the caches.
+  memory_quota->SetSize(kQuotaSize / 4);
+  EXPECT_LE(memory_quota->MaxCachedBytes(), kQuotaSize / 64);
+}
+
+TEST(MemoryQuotaTest, LimitEnforcedWithCachedReservations) {
+  constexpr size_t kQuotaSize = 1024 * 1024;
+  ExecCtx exec_ctx;
+
+  MemoryQuota memory_quota;
+  memory_quota.SetSize(kQuotaSize);
+  // Churn through allocators on a few threads, leaving reservations cached
+  // on whichever CPUs those threads ran.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&memory_quota]() {
+      ExecCtx exec_ctx;
+      for (int i = 0; i < 100; i++) {
+        auto memory_allocator = memory_quota.CreateMemoryAllocator();
+        auto object = memory_allocator.MakeUnique<Sized<4096>>();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  // Half of the quota is available, whatever is cached.
+  auto memory_allocator = memory_quota.CreateMemoryOwner();
+  auto object =
+      memory_allocator.allocator()->MakeUnique<Sized<kQuotaSize / 2>>();
+  bool reclaimed = false;
+  auto checker = CallChecker::Make();
+  memory_allocator.PostReclaimer(
+      ReclamationPass::kDestructive,
+      [&object, &reclaimed, checker](absl::optional<ReclamationSweep> sweep) {
+        checker->Called();
+        EXPECT_TRUE(sweep.has_value());
+        reclaimed = true;
+        object.reset();
+      });
+  exec_ctx.Flush();
+  EXPECT_FALSE(reclaimed);
+  // Going over the quota still triggers reclamation.
+  auto object2 =
+      memory_allocator.allocator()->MakeUnique<Sized<kQuotaSize / 2>>();
+  exec_ctx.Flush();
+  EXPECT_TRUE(reclaimed);
+  EXPECT_EQ(object.get(), nullptr);
+}
+
 }  // namespace testing
 }  // namespace grpc_core
 
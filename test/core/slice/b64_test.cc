@@ -26,6 +26,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/b64_simd.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/test_config.h"
 
@@ -201,6 +202,49 @@ static void test_unpadded_decode(void) {
   GPR_ASSERT(GRPC_SLICE_IS_EMPTY(decoded));
 }
 
+/* Every kernel the CPU supports must produce exactly what the scalar code
+   does, across lengths that end mid vector and line, and must leave invalid
+   characters for the scalar code to reject. */
+static void test_simd_matches_scalar(int url_safe, int multiline) {
+  const grpc_core::Base64Simd levels[] = {grpc_core::Base64Simd::kSse41,
+                                          grpc_core::Base64Simd::kAvx2};
+  unsigned char orig[400];
+  uint32_t seed = 1;
+  for (size_t i = 0; i < sizeof(orig); i++) {
+    seed = seed * 1103515245 + 12345;
+    orig[i] = static_cast<unsigned char>(seed >> 16);
+  }
+  grpc_core::ExecCtx exec_ctx;
+  for (grpc_core::Base64Simd level : levels) {
+    if (level > grpc_core::Base64SimdSupported()) continue;
+    for (size_t len = 0; len <= sizeof(orig); len++) {
+      grpc_core::Base64SimdSetLimit(grpc_core::Base64Simd::kNone);
+      char* expected = grpc_base64_encode(orig, len, url_safe, multiline);
+      grpc_core::Base64SimdSetLimit(level);
+      char* b64 = grpc_base64_encode(orig, len, url_safe, multiline);
+      GPR_ASSERT(strcmp(expected, b64) == 0);
+      grpc_slice decoded = grpc_base64_decode(b64, url_safe);
+      GPR_ASSERT(GRPC_SLICE_LENGTH(decoded) == len);
+      GPR_ASSERT(buffers_are_equal(orig, GRPC_SLICE_START_PTR(decoded), len));
+      grpc_slice_unref_internal(decoded);
+      if (len == sizeof(orig)) {
+        const size_t b64_len = strlen(b64);
+        for (size_t i = 0; i < b64_len; i++) {
+          const char saved = b64[i];
+          if (saved == '\r' || saved == '\n' || saved == '=') continue;
+          b64[i] = url_safe ? '+' : '-';
+          decoded = grpc_base64_decode(b64, url_safe);
+          GPR_ASSERT(GRPC_SLICE_IS_EMPTY(decoded));
+          b64[i] = saved;
+        }
+      }
+      gpr_free(expected);
+      gpr_free(b64);
+    }
+  }
+  grpc_core::Base64SimdSetLimit(grpc_core::Base64Simd::kAvx2);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -215,6 +259,10 @@ int main(int argc, char** argv) {
   test_url_safe_unsafe_mismatch_failure();
   test_rfc4648_test_vectors();
   test_unpadded_decode();
+  test_simd_matches_scalar(0, 0);
+  test_simd_matches_scalar(0, 1);
+  test_simd_matches_scalar(1, 0);
+  test_simd_matches_scalar(1, 1);
   grpc_shutdown();
   return 0;
 }
@@ -241,6 +241,143 @@ TEST(CachingByteStream, SharedCache) {
   cache.Destroy();
 }
 
+TEST(CachingByteStream, ReplaySharesSlices) {
+  grpc_core::ExecCtx exec_ctx;
+  // Mix refcounted slices with inlined ones, which must not be merged.
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+  grpc_slice input[] = {
+      grpc_slice_malloc(1024),
+      grpc_slice_from_copied_string("foo"),
+      grpc_slice_from_copied_string("bar"),
+      grpc_slice_malloc(1024),
+  };
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(input); ++i) {
+    grpc_slice_buffer_add_indexed(&buffer, grpc_slice_ref_internal(input[i]));
+  }
+  SliceBufferByteStream underlying_stream(&buffer, 0);
+  grpc_slice_buffer_destroy_internal(&buffer);
+  ByteStreamCache cache((OrphanablePtr<ByteStream>(&underlying_stream)));
+  ByteStreamCache::CachingByteStream stream(&cache);
+  grpc_closure closure;
+  GRPC_CLOSURE_INIT(&closure, NotCalledClosure, nullptr,
+                    grpc_schedule_on_exec_ctx);
+  // Read the stream twice.  Both reads must see the original slices.
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t i = 0; i < GPR_ARRAY_SIZE(input); ++i) {
+      EXPECT_TRUE(stream.Next(~(size_t)0, &closure));
+      grpc_slice output;
+      grpc_error_handle error = stream.Pull(&output);
+      EXPECT_TRUE(error == GRPC_ERROR_NONE);
+      EXPECT_TRUE(grpc_slice_eq(input[i], output));
+      if (input[i].refcount != nullptr) {
+        EXPECT_EQ(GRPC_SLICE_START_PTR(input[i]), GRPC_SLICE_START_PTR(output));
+      }
+      grpc_slice_unref_internal(output);
+    }
+    stream.Reset();
+  }
+  EXPECT_EQ(cache.cache_buffer()->count, GPR_ARRAY_SIZE(input));
+  // Clean up.
+  stream.Orphan();
+  cache.Destroy();
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(input); ++i) {
+    grpc_slice_unref_internal(input[i]);
+  }
+}
+
+// A byte stream whose data only becomes available when MakeReady() is
+// called, like a stream fed by the network.
+class AsyncByteStream : public ByteStream {
+ public:
+  AsyncByteStream(grpc_slice* slices, size_t count, uint32_t length)
+      : ByteStream(length, 0), slices_(slices), count_(count) {}
+
+  void Orphan() override {}
+
+  bool Next(size_t /*max_size_hint*/, grpc_closure* on_complete) override {
+    if (ready_) return true;
+    ++next_calls_;
+    on_complete_ = on_complete;
+    return false;
+  }
+
+  grpc_error_handle Pull(grpc_slice* slice) override {
+    GPR_ASSERT(ready_ && cursor_ < count_);
+    *slice = grpc_slice_ref_internal(slices_[cursor_++]);
+    return GRPC_ERROR_NONE;
+  }
+
+  void Shutdown(grpc_error_handle error) override { GRPC_ERROR_UNREF(error); }
+
+  void MakeReady() {
+    ready_ = true;
+    ExecCtx::Run(DEBUG_LOCATION, on_complete_, GRPC_ERROR_NONE);
+    on_complete_ = nullptr;
+  }
+
+  int next_calls() const { return next_calls_; }
+
+ private:
+  grpc_slice* slices_;
+  size_t count_;
+  size_t cursor_ = 0;
+  bool ready_ = false;
+  int next_calls_ = 0;
+  grpc_closure* on_complete_ = nullptr;
+};
+
+void CountingClosure(void* arg, grpc_error_handle error) {
+  EXPECT_EQ(error, GRPC_ERROR_NONE);
+  ++*static_cast<int*>(arg);
+}
+
+TEST(CachingByteStream, FillWithAsyncUnderlyingStream) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice input[] = {
+      grpc_slice_from_static_string("foo"),
+      grpc_slice_from_static_string("bar"),
+  };
+  AsyncByteStream underlying_stream(input, GPR_ARRAY_SIZE(input), 6);
+  ByteStreamCache cache((OrphanablePtr<ByteStream>(&underlying_stream)));
+  // Nothing is available yet, so the cache is left to fill lazily.
+  EXPECT_FALSE(cache.Fill());
+  ByteStreamCache::CachingByteStream stream1(&cache);
+  ByteStreamCache::CachingByteStream stream2(&cache);
+  int called1 = 0;
+  int called2 = 0;
+  grpc_closure closure1;
+  grpc_closure closure2;
+  GRPC_CLOSURE_INIT(&closure1, CountingClosure, &called1,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&closure2, CountingClosure, &called2,
+                    grpc_schedule_on_exec_ctx);
+  // Both streams wait on the Next() that Fill() left outstanding.
+  EXPECT_FALSE(stream1.Next(~(size_t)0, &closure1));
+  EXPECT_FALSE(stream2.Next(~(size_t)0, &closure2));
+  EXPECT_EQ(underlying_stream.next_calls(), 1);
+  underlying_stream.MakeReady();
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(called1, 1);
+  EXPECT_EQ(called2, 1);
+  // Each stream sees every slice, whichever pulled it first.
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(input); ++i) {
+    for (auto* stream : {&stream2, &stream1}) {
+      EXPECT_TRUE(stream->Next(~(size_t)0, &closure1));
+      grpc_slice output;
+      grpc_error_handle error = stream->Pull(&output);
+      EXPECT_TRUE(error == GRPC_ERROR_NONE);
+      EXPECT_TRUE(grpc_slice_eq(input[i], output));
+      grpc_slice_unref_internal(output);
+    }
+  }
+  EXPECT_EQ(underlying_stream.next_calls(), 1);
+  // Clean up.
+  stream1.Orphan();
+  stream2.Orphan();
+  cache.Destroy();
+}
+
 }  // namespace
 }  // namespace grpc_core
 
@@ -20,6 +20,8 @@
 
 #include <string.h>
 
+#include <string>
+
 /* This is here for grpc_is_binary_header
  * TODO(murgatroid99): Remove this
  */
@@ -27,7 +29,11 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
+#include "src/core/ext/transport/chttp2/transport/huffman_decoder.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/b64_simd.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "test/core/util/test_config.h"
 
@@ -92,6 +98,62 @@ static void expect_combined_equiv(const char* s, size_t len, int line) {
 #define EXPECT_COMBINED_EQUIV(x) \
   expect_combined_equiv(x, sizeof(x) - 1, __LINE__)
 
+static void expect_huffman_round_trip(const char* s, size_t len, int line) {
+  grpc_slice input = grpc_slice_from_copied_buffer(s, len);
+  grpc_slice compressed = grpc_chttp2_huffman_compress(input);
+  std::string decoded;
+  grpc_core::HuffmanDecoder::Decode(
+      GRPC_SLICE_START_PTR(compressed), GRPC_SLICE_LENGTH(compressed),
+      [&decoded](uint8_t c) { decoded.push_back(static_cast<char>(c)); });
+  if (decoded != std::string(s, len)) {
+    char* t = grpc_dump_slice(input, GPR_DUMP_HEX | GPR_DUMP_ASCII);
+    gpr_log(GPR_ERROR, "FAILED:%d: huffman round trip of %s", line, t);
+    gpr_free(t);
+    all_ok = 0;
+  }
+  grpc_slice_unref(input);
+  grpc_slice_unref(compressed);
+}
+
+#define EXPECT_HUFFMAN_ROUND_TRIP(x) \
+  expect_huffman_round_trip(x, sizeof(x) - 1, __LINE__)
+
+/* Encodes and decodes binary headers of every length up to 600 bytes with
+   each vector kernel the CPU supports, comparing against the scalar code. */
+static void expect_simd_matches_scalar() {
+  const grpc_core::Base64Simd levels[] = {grpc_core::Base64Simd::kSse41,
+                                          grpc_core::Base64Simd::kAvx2};
+  std::string all;
+  uint32_t seed = 1;
+  for (int i = 0; i < 600; i++) {
+    seed = seed * 1103515245 + 12345;
+    all.push_back(static_cast<char>(seed >> 16));
+  }
+  grpc_core::ExecCtx exec_ctx;
+  for (grpc_core::Base64Simd level : levels) {
+    if (level > grpc_core::Base64SimdSupported()) continue;
+    for (size_t len = 0; len <= all.size(); len++) {
+      grpc_slice input = grpc_slice_from_copied_buffer(all.data(), len);
+      grpc_core::Base64SimdSetLimit(grpc_core::Base64Simd::kNone);
+      grpc_slice base64 = grpc_chttp2_base64_encode(input);
+      grpc_slice huff = grpc_chttp2_base64_encode_and_huffman_compress(input);
+      grpc_core::Base64SimdSetLimit(level);
+      expect_slice_eq(grpc_slice_ref(base64), grpc_chttp2_base64_encode(input),
+                      "simd base64", __LINE__);
+      expect_slice_eq(grpc_slice_ref(huff),
+                      grpc_chttp2_base64_encode_and_huffman_compress(input),
+                      "simd base64 and huffman", __LINE__);
+      expect_slice_eq(grpc_slice_ref(input),
+                      grpc_chttp2_base64_decode_with_length(base64, len),
+                      "simd base64 decode", __LINE__);
+      grpc_slice_unref(input);
+      grpc_slice_unref(base64);
+      grpc_slice_unref(huff);
+    }
+  }
+  grpc_core::Base64SimdSetLimit(grpc_core::Base64Simd::kAvx2);
+}
+
 static void expect_binary_header(const char* hdr, int binary) {
   if (grpc_is_binary_header(grpc_slice_from_static_string(hdr)) != binary) {
     gpr_log(GPR_ERROR, "FAILED: expected header '%s' to be %s", hdr,
@@ -170,6 +232,28 @@ int main(int argc, char** argv) {
       "\xe0\xe1\xe2\xe3\xe4\xe5\xe6\xe7\xe8\xe9\xea\xeb\xec\xed\xee\xef"
       "\xf0\xf1\xf2\xf3\xf4\xf5\xf6\xf7\xf8\xf9\xfa\xfb\xfc\xfd\xfe\xff");
 
+  /* Decoding must undo encoding, including codes longer than a table lookup
+     and every possible amount of trailing padding */
+  EXPECT_HUFFMAN_ROUND_TRIP("");
+  EXPECT_HUFFMAN_ROUND_TRIP("a");
+  EXPECT_HUFFMAN_ROUND_TRIP("www.example.com");
+  EXPECT_HUFFMAN_ROUND_TRIP("Mon, 21 Oct 2013 20:13:21 GMT");
+  EXPECT_HUFFMAN_ROUND_TRIP("\x00\x01\xfe\xff\x7f\x80\x0a\x0d\x16");
+  {
+    std::string all;
+    for (int i = 0; i < 256; i++) {
+      all.push_back(static_cast<char>(i));
+      expect_huffman_round_trip(all.data(), all.size(), __LINE__);
+    }
+    for (int i = 255; i >= 0; i--) {
+      all.push_back(static_cast<char>(i));
+      all.push_back('e');
+    }
+    expect_huffman_round_trip(all.data(), all.size(), __LINE__);
+  }
+
+  expect_simd_matches_scalar();
+
   expect_binary_header("foo-bin", 1);
   expect_binary_header("foo-bar", 0);
   expect_binary_header("-bin", 0);
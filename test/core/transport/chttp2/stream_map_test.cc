@@ -73,12 +73,13 @@ static void test_basic_add_find(uint32_t n) {
 static void verify_for_each(void* user_data, uint32_t stream_id, void* ptr) {
   uint32_t* for_each_check = static_cast<uint32_t*>(user_data);
   GPR_ASSERT(ptr);
-  GPR_ASSERT(*for_each_check == stream_id);
-  *for_each_check += 2;
+  GPR_ASSERT((void*)(uintptr_t)stream_id == ptr);
+  GPR_ASSERT(stream_id & 1);
+  ++*for_each_check;
 }
 
 static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n) {
-  uint32_t for_each_check = 1;
+  uint32_t for_each_check = 0;
   uint32_t i;
   size_t got;
 
@@ -94,11 +95,7 @@ static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n) {
   }
 
   grpc_chttp2_stream_map_for_each(map, verify_for_each, &for_each_check);
-  if (n & 1) {
-    GPR_ASSERT(for_each_check == n + 2);
-  } else {
-    GPR_ASSERT(for_each_check == n + 1);
-  }
+  GPR_ASSERT(for_each_check == (n + 1) / 2);
 }
 
 /* add a bunch of keys, delete the even ones, and make sure the map is
@@ -167,6 +164,50 @@ static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+/* for_each callback that deletes the visited entry, deletes the entry after
+   it, and adds a new entry every other step */
+struct mutate_args {
+  grpc_chttp2_stream_map* map;
+  uint32_t next_key;
+  uint32_t visited;
+};
+
+static void mutate_for_each(void* user_data, uint32_t stream_id, void* ptr) {
+  mutate_args* args = static_cast<mutate_args*>(user_data);
+  GPR_ASSERT((void*)(uintptr_t)stream_id == ptr);
+  args->visited++;
+  GPR_ASSERT(ptr == grpc_chttp2_stream_map_delete(args->map, stream_id));
+  grpc_chttp2_stream_map_delete(args->map, stream_id + 2);
+  if ((args->visited & 1) == 0 && args->next_key < 1000000) {
+    grpc_chttp2_stream_map_add(args->map, args->next_key,
+                               (void*)(uintptr_t)args->next_key);
+    args->next_key += 2;
+  }
+}
+
+/* add and delete entries from inside for_each, using only odd keys like a
+   server transport does */
+static void test_for_each_mutating(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+
+  LOG_TEST("test_for_each_mutating");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, 2 * i - 1,
+                               reinterpret_cast<void*>(2 * i - 1));
+  }
+  mutate_args args = {&map, 2 * n + 1, 0};
+  grpc_chttp2_stream_map_for_each(&map, mutate_for_each, &args);
+  /* every entry was either visited or deleted by its predecessor, including
+     those added along the way */
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_size(&map));
+  GPR_ASSERT(args.visited >= (n + 1) / 2);
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
 int main(int argc, char** argv) {
   uint32_t n = 1;
   uint32_t prev = 1;
@@ -182,6 +223,7 @@ int main(int argc, char** argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_for_each_mutating(n);
 
     tmp = n;
     n += prev;
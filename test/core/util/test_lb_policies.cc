@@ -21,6 +21,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/lib/address_utils/parse_address.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -521,6 +522,147 @@ class FixedAddressFactory : public LoadBalancingPolicyFactory {
   }
 };
 
+//
+// OobBackendMetricTestLoadBalancingPolicy
+//
+
+constexpr char kOobBackendMetricTestLbPolicyName[] =
+    "oob_backend_metric_test_lb";
+
+class OobBackendMetricTestConfig : public LoadBalancingPolicy::Config {
+ public:
+  explicit OobBackendMetricTestConfig(grpc_millis report_interval)
+      : report_interval_(report_interval) {}
+
+  const char* name() const override {
+    return kOobBackendMetricTestLbPolicyName;
+  }
+
+  grpc_millis report_interval() const { return report_interval_; }
+
+ private:
+  grpc_millis report_interval_;
+};
+
+class OobBackendMetricTestLoadBalancingPolicy
+    : public ForwardingLoadBalancingPolicy {
+ public:
+  OobBackendMetricTestLoadBalancingPolicy(Args args,
+                                          OobBackendMetricCallback cb)
+      : ForwardingLoadBalancingPolicy(
+            absl::make_unique<Helper>(
+                RefCountedPtr<OobBackendMetricTestLoadBalancingPolicy>(this),
+                std::move(cb)),
+            std::move(args),
+            /*delegate_policy_name=*/"pick_first",
+            /*initial_refcount=*/2) {}
+
+  ~OobBackendMetricTestLoadBalancingPolicy() override = default;
+
+  const char* name() const override {
+    return kOobBackendMetricTestLbPolicyName;
+  }
+
+  void UpdateLocked(UpdateArgs args) override {
+    report_interval_ =
+        static_cast<OobBackendMetricTestConfig*>(args.config.get())
+            ->report_interval();
+    args.config.reset();
+    ForwardingLoadBalancingPolicy::UpdateLocked(std::move(args));
+  }
+
+ private:
+  class OobWatcher : public OobBackendMetricWatcher {
+   public:
+    explicit OobWatcher(OobBackendMetricCallback cb) : cb_(std::move(cb)) {}
+
+    void OnBackendMetricReport(
+        const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData&
+            backend_metric_data) override {
+      cb_(backend_metric_data);
+    }
+
+   private:
+    OobBackendMetricCallback cb_;
+  };
+
+  class Helper : public ChannelControlHelper {
+   public:
+    Helper(RefCountedPtr<OobBackendMetricTestLoadBalancingPolicy> parent,
+           OobBackendMetricCallback cb)
+        : parent_(std::move(parent)), cb_(std::move(cb)) {}
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        ServerAddress address, const grpc_channel_args& args) override {
+      auto subchannel = parent_->channel_control_helper()->CreateSubchannel(
+          std::move(address), args);
+      if (subchannel != nullptr) {
+        subchannel->AddDataWatcher(MakeOobBackendMetricWatcher(
+            parent_->report_interval_, absl::make_unique<OobWatcher>(cb_)));
+      }
+      return subchannel;
+    }
+
+    void UpdateState(grpc_connectivity_state state, const absl::Status& status,
+                     std::unique_ptr<SubchannelPicker> picker) override {
+      parent_->channel_control_helper()->UpdateState(state, status,
+                                                     std::move(picker));
+    }
+
+    void RequestReresolution() override {
+      parent_->channel_control_helper()->RequestReresolution();
+    }
+
+    absl::string_view GetAuthority() override {
+      return parent_->channel_control_helper()->GetAuthority();
+    }
+
+    void AddTraceEvent(TraceSeverity severity,
+                       absl::string_view message) override {
+      parent_->channel_control_helper()->AddTraceEvent(severity, message);
+    }
+
+   private:
+    RefCountedPtr<OobBackendMetricTestLoadBalancingPolicy> parent_;
+    OobBackendMetricCallback cb_;
+  };
+
+  grpc_millis report_interval_ = GRPC_MILLIS_INF_FUTURE;
+};
+
+class OobBackendMetricTestFactory : public LoadBalancingPolicyFactory {
+ public:
+  explicit OobBackendMetricTestFactory(OobBackendMetricCallback cb)
+      : cb_(std::move(cb)) {}
+
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<OobBackendMetricTestLoadBalancingPolicy>(
+        std::move(args), cb_);
+  }
+
+  const char* name() const override {
+    return kOobBackendMetricTestLbPolicyName;
+  }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    std::vector<grpc_error_handle> error_list;
+    grpc_millis report_interval = 0;
+    ParseJsonObjectFieldAsDuration(json.object_value(), "reportInterval",
+                                   &report_interval, &error_list);
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "errors parsing oob_backend_metric_test_lb config", &error_list);
+      return nullptr;
+    }
+    return MakeRefCounted<OobBackendMetricTestConfig>(report_interval);
+  }
+
+ private:
+  OobBackendMetricCallback cb_;
+};
+
 }  // namespace
 
 void RegisterTestPickArgsLoadBalancingPolicy(TestPickArgsCallback cb,
@@ -546,4 +688,10 @@ void RegisterFixedAddressLoadBalancingPolicy() {
       absl::make_unique<FixedAddressFactory>());
 }
 
+void RegisterOobBackendMetricTestLoadBalancingPolicy(
+    OobBackendMetricCallback cb) {
+  LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<OobBackendMetricTestFactory>(std::move(cb)));
+}
+
 }  // namespace grpc_core
@@ -59,6 +59,16 @@ void RegisterAddressTestLoadBalancingPolicy(AddressTestCallback cb);
 // single subchannel whose address is in its configuration.
 void RegisterFixedAddressLoadBalancingPolicy();
 
+using OobBackendMetricCallback = std::function<void(
+    const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData&)>;
+
+// Registers an LB policy called "oob_backend_metric_test_lb" that delegates
+// to pick_first, asks each of its subchannels for out-of-band backend
+// metrics every "reportInterval" (from its config), and invokes cb with
+// each report received.
+void RegisterOobBackendMetricTestLoadBalancingPolicy(
+    OobBackendMetricCallback cb);
+
 }  // namespace grpc_core
 
 #endif  // GRPC_TEST_CORE_UTIL_TEST_LB_POLICIES_H
@@ -1640,6 +1640,81 @@ TEST_F(ClientLbEnd2endTest,
   EnableDefaultHealthCheckService(false);
 }
 
+TEST_F(ClientLbEnd2endTest, LeastRequest) {
+  // Start servers and send RPCs until every server has seen one.
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": "
+      "[{\"least_request_experimental\": {\"choiceCount\": 3}}]}");
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  // Check LB policy name for the channel.
+  EXPECT_EQ("least_request_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(ClientLbEnd2endTest, LeastRequestInvalidChoiceCount) {
+  StartServers(1);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  // A choice count below 2 makes the service config invalid, so RPCs fail.
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": "
+      "[{\"least_request_experimental\": {\"choiceCount\": 1}}]}");
+  CheckRpcSendFailure(stub);
+}
+
+TEST_F(ClientLbEnd2endTest, WeightedRoundRobin) {
+  const int kNumServers = 3;
+  const int kNumRpcs = 700;
+  StartServers(kNumServers);
+  // Servers 0 and 1 report a weight of 100 / 0.5 = 200, and server 2 one of
+  // 100 / 0.1 = 1000, so server 2 should get 5 in every 7 RPCs.
+  xds::data::orca::v3::OrcaLoadReport heavy_load_report;
+  heavy_load_report.set_cpu_utilization(0.5);
+  heavy_load_report.set_rps(100);
+  xds::data::orca::v3::OrcaLoadReport light_load_report;
+  light_load_report.set_cpu_utilization(0.1);
+  light_load_report.set_rps(100);
+  servers_[0]->service_.set_load_report(&heavy_load_report);
+  servers_[1]->service_.set_load_report(&heavy_load_report);
+  servers_[2]->service_.set_load_report(&light_load_report);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin_experimental\": "
+      "{\"blackoutPeriod\": \"0s\", \"weightUpdatePeriod\": \"0.1s\"}}]}");
+  // Send RPCs until every server has reported its load, then give the
+  // policy time to pick up the weights.
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(500));
+  ResetCounters();
+  for (int i = 0; i < kNumRpcs; ++i) {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  }
+  EXPECT_NEAR(servers_[0]->service_.request_count(), kNumRpcs / 7,
+              kNumRpcs / 20);
+  EXPECT_NEAR(servers_[1]->service_.request_count(), kNumRpcs / 7,
+              kNumRpcs / 20);
+  EXPECT_NEAR(servers_[2]->service_.request_count(), kNumRpcs * 5 / 7,
+              kNumRpcs / 20);
+  // Check LB policy name for the channel.
+  EXPECT_EQ("weighted_round_robin_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
 TEST_F(ClientLbEnd2endTest, ChannelIdleness) {
   // Start server.
   const int kNumServers = 1;
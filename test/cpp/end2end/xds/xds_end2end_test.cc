@@ -6521,10 +6521,10 @@ TEST_P(CdsTest, WrongEdsConfig) {
 }
 
 // Tests that CDS client should send a NACK if the lb_policy in CDS response
-// is other than ROUND_ROBIN.
+// is not one we support.
 TEST_P(CdsTest, WrongLbPolicy) {
   auto cluster = default_cluster_;
-  cluster.set_lb_policy(Cluster::LEAST_REQUEST);
+  cluster.set_lb_policy(Cluster::RANDOM);
   balancers_[0]->ads_service()->SetCdsResource(cluster);
   SetNextResolution({});
   SetNextResolutionForLbChannelAllBalancers();
@@ -6552,6 +6552,46 @@ TEST_P(CdsTest, WrongLrsServer) {
               ::testing::HasSubstr("LRS ConfigSource is not self."));
 }
 
+// Tests that the least request policy sends RPCs to all of the backends.
+TEST_P(CdsTest, LeastRequest) {
+  auto cluster = default_cluster_;
+  cluster.set_lb_policy(Cluster::LEAST_REQUEST);
+  cluster.mutable_least_request_lb_config()->mutable_choice_count()->set_value(
+      3);
+  balancers_[0]->ads_service()->SetCdsResource(cluster);
+  SetNextResolution({});
+  SetNextResolutionForLbChannelAllBalancers();
+  EdsResourceArgs args({
+      {"locality0", CreateEndpointsForBackends()},
+  });
+  balancers_[0]->ads_service()->SetEdsResource(
+      BuildEdsResource(args, DefaultEdsServiceName()));
+  WaitForAllBackends();
+  CheckRpcSendOk(100);
+  for (size_t i = 0; i < backends_.size(); ++i) {
+    EXPECT_GT(backends_[i]->backend_service()->request_count(), 0)
+        << "backend " << i;
+  }
+}
+
+// Tests that CDS client should send a NACK if the least request config has
+// a choice count below 2.
+TEST_P(CdsTest, LeastRequestInvalidChoiceCount) {
+  auto cluster = default_cluster_;
+  cluster.set_lb_policy(Cluster::LEAST_REQUEST);
+  cluster.mutable_least_request_lb_config()->mutable_choice_count()->set_value(
+      1);
+  balancers_[0]->ads_service()->SetCdsResource(cluster);
+  SetNextResolution({});
+  SetNextResolutionForLbChannelAllBalancers();
+  ASSERT_TRUE(WaitForCdsNack()) << "timed out waiting for NACK";
+  const auto response_state =
+      balancers_[0]->ads_service()->cds_response_state();
+  EXPECT_EQ(response_state.state, AdsServiceImpl::ResponseState::NACKED);
+  EXPECT_THAT(response_state.error_message,
+              ::testing::HasSubstr("choice_count must be at least 2."));
+}
+
 // Tests that ring hash policy that hashes using channel id ensures all RPCs
 // to go 1 particular backend.
 TEST_P(CdsTest, RingHashChannelIdHashing) {
@@ -18,6 +18,8 @@
 
 /* Benchmark arenas */
 
+#include <algorithm>
+
 #include <benchmark/benchmark.h>
 
 #include "src/core/lib/gprpp/arena.h"
@@ -26,6 +28,7 @@
 #include "test/cpp/util/test_config.h"
 
 using grpc_core::Arena;
+using grpc_core::ArenaPool;
 
 static void BM_Arena_NoOp(benchmark::State& state) {
   for (auto _ : state) {
@@ -61,6 +64,50 @@ static void BM_Arena_Batch(benchmark::State& state) {
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
+// Simulates the arena traffic of a call: an arena sized by the call size
+// estimate, the call object allocated with it, and a few more allocations
+// for filters and metadata before it is destroyed.
+static void DoCallArenaAllocs(Arena* a) {
+  for (int i = 0; i < 8; i++) {
+    a->Alloc(256);
+  }
+}
+
+static void BM_Arena_CallLifecycle(benchmark::State& state) {
+  for (auto _ : state) {
+    Arena* a = Arena::CreateWithAlloc(state.range(0), 1024).first;
+    DoCallArenaAllocs(a);
+    a->Destroy();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Arena_CallLifecycle)
+    ->RangeMultiplier(4)
+    ->Range(4 * 1024, 64 * 1024)
+    ->ThreadRange(1, 8);
+
+static void BM_ArenaPool_CallLifecycle(benchmark::State& state) {
+  // Shared by all threads of the benchmark, like the pool of a channel.
+  static ArenaPool* pool = new ArenaPool();
+  const uint64_t hits_before = pool->hits();
+  const uint64_t misses_before = pool->misses();
+  for (auto _ : state) {
+    Arena* a = pool->CreateWithAlloc(state.range(0), 1024).first;
+    DoCallArenaAllocs(a);
+    pool->Destroy(a, /*trim=*/false);
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    const double hits = pool->hits() - hits_before;
+    const double misses = pool->misses() - misses_before;
+    state.counters["reuse_rate"] = hits / std::max(1.0, hits + misses);
+  }
+}
+BENCHMARK(BM_ArenaPool_CallLifecycle)
+    ->RangeMultiplier(4)
+    ->Range(4 * 1024, 64 * 1024)
+    ->ThreadRange(1, 8);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
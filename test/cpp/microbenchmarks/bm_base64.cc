@@ -0,0 +1,165 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks for base64 coding of binary ("-bin") metadata, from small
+   tracing contexts to large serialized auth tokens, with each set of vector
+   kernels the CPU supports and with the scalar code */
+
+#include <stdint.h>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/alloc.h>
+
+#include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
+#include "src/core/lib/slice/b64.h"
+#include "src/core/lib/slice/b64_simd.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+static grpc_slice random_slice(size_t length) {
+  grpc_slice slice = GRPC_SLICE_MALLOC(length);
+  uint32_t seed = 1;
+  for (size_t i = 0; i < length; i++) {
+    seed = seed * 1103515245 + 12345;
+    GRPC_SLICE_START_PTR(slice)[i] = static_cast<uint8_t>(seed >> 16);
+  }
+  return slice;
+}
+
+// Runs the benchmark with the kernels limited to |level|, or skips it if the
+// CPU does not support them.
+static bool use_level(benchmark::State& state, grpc_core::Base64Simd level) {
+  if (level > grpc_core::Base64SimdSupported()) {
+    state.SkipWithError("not supported by this CPU");
+    return false;
+  }
+  grpc_core::Base64SimdSetLimit(level);
+  return true;
+}
+
+template <grpc_core::Base64Simd kLevel>
+static void BM_Chttp2Base64Encode(benchmark::State& state) {
+  TrackCounters track_counters;
+  if (!use_level(state, kLevel)) return;
+  grpc_slice input = random_slice(state.range(0));
+  for (auto _ : state) {
+    grpc_slice_unref(grpc_chttp2_base64_encode(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+
+template <grpc_core::Base64Simd kLevel>
+static void BM_Chttp2Base64EncodeAndHuffmanCompress(benchmark::State& state) {
+  TrackCounters track_counters;
+  if (!use_level(state, kLevel)) return;
+  grpc_slice input = random_slice(state.range(0));
+  for (auto _ : state) {
+    grpc_slice_unref(grpc_chttp2_base64_encode_and_huffman_compress(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+
+template <grpc_core::Base64Simd kLevel>
+static void BM_Chttp2Base64Decode(benchmark::State& state) {
+  TrackCounters track_counters;
+  if (!use_level(state, kLevel)) return;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice input = random_slice(state.range(0));
+  grpc_slice encoded = grpc_chttp2_base64_encode(input);
+  for (auto _ : state) {
+    grpc_slice_unref_internal(
+        grpc_chttp2_base64_decode_with_length(encoded, state.range(0)));
+  }
+  grpc_slice_unref_internal(input);
+  grpc_slice_unref_internal(encoded);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+
+template <grpc_core::Base64Simd kLevel>
+static void BM_Base64Encode(benchmark::State& state) {
+  TrackCounters track_counters;
+  if (!use_level(state, kLevel)) return;
+  grpc_slice input = random_slice(state.range(0));
+  for (auto _ : state) {
+    gpr_free(grpc_base64_encode(GRPC_SLICE_START_PTR(input),
+                                GRPC_SLICE_LENGTH(input), 0, 0));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+
+template <grpc_core::Base64Simd kLevel>
+static void BM_Base64Decode(benchmark::State& state) {
+  TrackCounters track_counters;
+  if (!use_level(state, kLevel)) return;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice input = random_slice(state.range(0));
+  char* encoded = grpc_base64_encode(GRPC_SLICE_START_PTR(input),
+                                     GRPC_SLICE_LENGTH(input), 0, 0);
+  for (auto _ : state) {
+    grpc_slice_unref_internal(grpc_base64_decode(encoded, 0));
+  }
+  gpr_free(encoded);
+  grpc_slice_unref_internal(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+
+static void SweepSizes(benchmark::internal::Benchmark* b) {
+  for (int size = 64; size <= 16384; size *= 4) {
+    b->Arg(size);
+  }
+}
+
+#define BENCHMARK_LEVELS(name)                                          \
+  BENCHMARK_TEMPLATE(name, grpc_core::Base64Simd::kNone)                \
+      ->Apply(SweepSizes);                                              \
+  BENCHMARK_TEMPLATE(name, grpc_core::Base64Simd::kSse41)               \
+      ->Apply(SweepSizes);                                              \
+  BENCHMARK_TEMPLATE(name, grpc_core::Base64Simd::kAvx2)->Apply(SweepSizes)
+
+BENCHMARK_LEVELS(BM_Chttp2Base64Encode);
+BENCHMARK_LEVELS(BM_Chttp2Base64EncodeAndHuffmanCompress);
+BENCHMARK_LEVELS(BM_Chttp2Base64Decode);
+BENCHMARK_LEVELS(BM_Base64Encode);
+BENCHMARK_LEVELS(BM_Base64Decode);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -21,6 +21,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <sstream>
 
 #include <benchmark/benchmark.h>
@@ -116,6 +117,10 @@ static void BM_CallCreateDestroy(benchmark::State& state) {
         deadline, nullptr));
   }
   grpc_completion_queue_destroy(cq);
+  // Report how many call arenas were recycled from the channel's arena pool.
+  const double hits = fixture.channel()->arena_pool->hits();
+  const double misses = fixture.channel()->arena_pool->misses();
+  state.counters["arena_reuse_rate"] = hits / std::max(1.0, hits + misses);
   track_counters.Finish(state);
 }
 
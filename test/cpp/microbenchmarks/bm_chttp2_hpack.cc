@@ -22,12 +22,14 @@
 
 #include <memory>
 #include <sstream>
+#include <string>
 
 #include <benchmark/benchmark.h>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -430,6 +432,12 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    SingleNonInternedBinaryElem<100, true>)
     ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
+                   SingleNonInternedBinaryElem<1024, false>)
+    ->Args({0, 16384});
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
+                   SingleNonInternedBinaryElem<8192, false>)
+    ->Args({0, 16384});
 // test with a tiny frame size, to highlight continuation costs
 BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader, SingleNonInternedElem)
     ->Args({0, 1});
@@ -801,6 +809,97 @@ class RepresentativeServerTrailingMetadata {
   }
 };
 
+// Append a huffman coded string literal (RFC 7541 section 5.2) to out.
+static void AppendHuffmanString(const std::string& s,
+                                std::vector<uint8_t>* out) {
+  grpc_slice raw = grpc_slice_from_copied_buffer(s.data(), s.size());
+  grpc_slice huff = grpc_chttp2_huffman_compress(raw);
+  size_t length = GRPC_SLICE_LENGTH(huff);
+  if (length < 127) {
+    out->push_back(static_cast<uint8_t>(0x80 | length));
+  } else {
+    out->push_back(0xff);
+    length -= 127;
+    while (length >= 128) {
+      out->push_back(static_cast<uint8_t>(0x80 | (length & 0x7f)));
+      length >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(length));
+  }
+  out->insert(out->end(), GRPC_SLICE_START_PTR(huff), GRPC_SLICE_END_PTR(huff));
+  grpc_slice_unref(huff);
+  grpc_slice_unref(raw);
+}
+
+// A huffman coded literal header without indexing.
+static void AppendHuffmanHeader(const std::string& key,
+                                const std::string& value,
+                                std::vector<uint8_t>* out) {
+  out->push_back(0x00);
+  AppendHuffmanString(key, out);
+  AppendHuffmanString(value, out);
+}
+
+// A bearer token of kLength characters, as carried in authorization headers.
+template <int kLength>
+class HuffmanAuthorizationElem {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    static const char kTokenChars[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string token = "Bearer ";
+    for (int i = 0; i < kLength; i++) {
+      token.push_back(kTokenChars[(i * 37 + i / 7) % 64]);
+    }
+    std::vector<uint8_t> v;
+    AppendHuffmanHeader("authorization", token, &v);
+    return {MakeSlice(v)};
+  }
+};
+
+// Several large custom headers, none of which are worth indexing.
+class HuffmanCustomHeaders {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    std::vector<uint8_t> v;
+    AppendHuffmanHeader("x-request-id", "3f2b8c4e-9a1d-4e7b-8c2f-5d6a7b8c9d0e",
+                        &v);
+    AppendHuffmanHeader("x-forwarded-for",
+                        "203.0.113.195, 70.41.3.18, 150.172.238.178", &v);
+    AppendHuffmanHeader(
+        "user-agent",
+        "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like "
+        "Gecko) Chrome/96.0.4664.45 Safari/537.36 grpc-c++/1.43.0",
+        &v);
+    AppendHuffmanHeader(
+        "cookie",
+        "session=MTYzODM2NTQ2MHxEdi1CQkFFQ180SUFBUkFCRUFBQVJfLUNBQUVHYzNSeWFXNW"
+        "5EQW9BQ0hWelpYSnVZVzFsQm5OMGNtbHVad3dKQUFkbmRXVnpkQT09fM9Xg; "
+        "theme=dark; locale=en-US",
+        &v);
+    AppendHuffmanHeader("x-b3-traceid", "80f198ee56343ba864fe8b2a57d3eff7",
+                        &v);
+    return {MakeSlice(v)};
+  }
+};
+
+// Non-ASCII values, whose codes are too long for a single table lookup.
+class HuffmanLongCodes {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    std::string value;
+    for (int i = 0; i < 256; i++) {
+      value.push_back(static_cast<char>(0x80 + (i * 13) % 128));
+    }
+    std::vector<uint8_t> v;
+    AppendHuffmanHeader("x-utf8-value", value, &v);
+    return {MakeSlice(v)};
+  }
+};
+
 // Send the same deadline repeatedly
 class SameDeadline {
  public:
@@ -848,6 +947,10 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeServerInitialMetadata);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, SameDeadline);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, HuffmanAuthorizationElem<64>);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, HuffmanAuthorizationElem<1024>);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, HuffmanCustomHeaders);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, HuffmanLongCodes);
 
 }  // namespace hpack_parser_fixtures
 
@@ -0,0 +1,143 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks for the chttp2 stream map, sized up to the 10k concurrent
+   streams a busy transport may carry */
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+static void* value(uint32_t id) {
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(id));
+}
+
+// Client initiated stream ids, as a server transport sees them: odd and
+// increasing.
+static uint32_t stream_id(uint32_t n) { return 2 * n + 1; }
+
+static void fill(grpc_chttp2_stream_map* map, uint32_t streams) {
+  grpc_chttp2_stream_map_init(map, 8);
+  for (uint32_t i = 0; i < streams; i++) {
+    grpc_chttp2_stream_map_add(map, stream_id(i), value(stream_id(i)));
+  }
+}
+
+// Look up a stream for each incoming frame, spread across all live streams.
+static void BM_StreamMapFind(benchmark::State& state) {
+  TrackCounters track_counters;
+  const uint32_t streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  fill(&map, streams);
+  uint32_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_find(&map, stream_id(next)));
+    // visit streams out of order, as frames of concurrent streams interleave
+    next = (next + 7919) % streams;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapFind)->Arg(1)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Close the oldest stream and open a new one, keeping the number of live
+// streams constant.
+static void BM_StreamMapChurn(benchmark::State& state) {
+  TrackCounters track_counters;
+  const uint32_t streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  fill(&map, streams);
+  uint32_t oldest = 0;
+  for (auto _ : state) {
+    grpc_chttp2_stream_map_delete(&map, stream_id(oldest));
+    grpc_chttp2_stream_map_add(&map, stream_id(oldest + streams),
+                               value(stream_id(oldest + streams)));
+    oldest++;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapChurn)->Arg(1)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Close streams in random order while keeping the map full, as when calls of
+// varying length share the transport.
+static void BM_StreamMapRandomChurn(benchmark::State& state) {
+  TrackCounters track_counters;
+  const uint32_t streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  fill(&map, streams);
+  std::vector<uint32_t> live(streams);
+  for (uint32_t i = 0; i < streams; i++) live[i] = stream_id(i);
+  uint32_t next = streams;
+  uint32_t seed = 1;
+  for (auto _ : state) {
+    seed = seed * 1103515245 + 12345;
+    uint32_t& slot = live[(seed >> 8) % streams];
+    grpc_chttp2_stream_map_delete(&map, slot);
+    slot = stream_id(next++);
+    grpc_chttp2_stream_map_add(&map, slot, value(slot));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapRandomChurn)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Visit every stream, as a settings change or transport close does.
+static void BM_StreamMapForEach(benchmark::State& state) {
+  TrackCounters track_counters;
+  const uint32_t streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  fill(&map, streams);
+  size_t visited = 0;
+  for (auto _ : state) {
+    grpc_chttp2_stream_map_for_each(
+        &map,
+        [](void* user_data, uint32_t /*key*/, void* /*value*/) {
+          ++*static_cast<size_t*>(user_data);
+        },
+        &visited);
+  }
+  GPR_ASSERT(visited == static_cast<size_t>(state.iterations()) * streams);
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(visited);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapForEach)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
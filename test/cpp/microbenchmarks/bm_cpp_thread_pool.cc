@@ -0,0 +1,130 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the C++ thread pools behind CreateDefaultThreadPool() */
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/cpu.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/cpp/server/dynamic_thread_pool.h"
+#include "src/cpp/server/work_stealing_thread_pool.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// Counts callbacks down to zero, and lets the benchmark wait for zero.
+class BurstCounter {
+ public:
+  explicit BurstCounter(int n) : count_(n) {}
+
+  void Done() {
+    grpc_core::MutexLock lock(&mu_);
+    if (--count_ == 0) cv_.Signal();
+  }
+
+  void Wait() {
+    grpc_core::MutexLock lock(&mu_);
+    while (count_ != 0) cv_.Wait(&mu_);
+  }
+
+ private:
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  int count_;
+};
+
+static int PoolSize() {
+  int cores = gpr_cpu_num_cores();
+  return cores == 0 ? 4 : cores;
+}
+
+// Bursts of range(0) callbacks added from outside the pool, the way requests
+// arrive at a server that has been idle.
+template <class Pool>
+static void BM_ThreadPoolBurst(benchmark::State& state) {
+  const int burst = state.range(0);
+  Pool pool(PoolSize());
+  for (auto _ : state) {
+    BurstCounter counter(burst);
+    for (int i = 0; i < burst; i++) {
+      pool.Add([&counter] { counter.Done(); });
+    }
+    counter.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * burst);
+}
+BENCHMARK_TEMPLATE(BM_ThreadPoolBurst, DynamicThreadPool)
+    ->RangeMultiplier(8)
+    ->Range(1, 4096)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ThreadPoolBurst, WorkStealingThreadPool)
+    ->RangeMultiplier(8)
+    ->Range(1, 4096)
+    ->UseRealTime();
+
+// Every callback added from outside the pool adds range(0) more from inside
+// it, the way a handler fans work out.
+template <class Pool>
+static void BM_ThreadPoolFanOut(benchmark::State& state) {
+  const int fan_out = state.range(0);
+  const int width = PoolSize();
+  Pool pool(width);
+  for (auto _ : state) {
+    BurstCounter counter(width * fan_out);
+    for (int i = 0; i < width; i++) {
+      pool.Add([&pool, &counter, fan_out] {
+        for (int j = 0; j < fan_out; j++) {
+          pool.Add([&counter] { counter.Done(); });
+        }
+      });
+    }
+    counter.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * width * fan_out);
+}
+BENCHMARK_TEMPLATE(BM_ThreadPoolFanOut, DynamicThreadPool)
+    ->RangeMultiplier(8)
+    ->Range(1, 512)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ThreadPoolFanOut, WorkStealingThreadPool)
+    ->RangeMultiplier(8)
+    ->Range(1, 512)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
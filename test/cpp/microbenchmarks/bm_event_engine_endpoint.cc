@@ -0,0 +1,312 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Ping-pong latency of the native POSIX EventEngine endpoints, compared with
+// the iomgr endpoints that the iomgr-backed EventEngine wraps.
+
+#include <string.h>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/grpc.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/channel_args_endpoint_config.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/sockaddr.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+void FillSliceBuffer(grpc_slice_buffer* buf, size_t size) {
+  grpc_slice slice = grpc_slice_malloc(size);
+  memset(GRPC_SLICE_START_PTR(slice), 'a', size);
+  grpc_slice_buffer_add(buf, slice);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// iomgr endpoints
+//
+
+class IomgrFixture {
+ public:
+  IomgrFixture() {
+    grpc_core::ExecCtx exec_ctx;
+    pollset_ = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(pollset_, &mu_);
+    pair_ = grpc_iomgr_create_endpoint_pair("bm_event_engine_endpoint",
+                                            nullptr);
+    grpc_endpoint_add_to_pollset(pair_.client, pollset_);
+    grpc_endpoint_add_to_pollset(pair_.server, pollset_);
+  }
+
+  ~IomgrFixture() {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_endpoint_shutdown(pair_.client, GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                             "benchmark done"));
+    grpc_endpoint_shutdown(pair_.server, GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                             "benchmark done"));
+    grpc_endpoint_destroy(pair_.client);
+    grpc_endpoint_destroy(pair_.server);
+    grpc_closure done;
+    GRPC_CLOSURE_INIT(&done, DestroyPollset, pollset_,
+                      grpc_schedule_on_exec_ctx);
+    gpr_mu_lock(mu_);
+    grpc_pollset_shutdown(pollset_, &done);
+    gpr_mu_unlock(mu_);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_free(pollset_);
+  }
+
+  // Write \a size bytes on \a from and wait until they have all been read
+  // from \a to.
+  void Send(grpc_endpoint* from, grpc_endpoint* to, size_t size) {
+    grpc_slice_buffer out;
+    grpc_slice_buffer_init(&out);
+    FillSliceBuffer(&out, size);
+    bool written = false;
+    grpc_closure on_write;
+    GRPC_CLOSURE_INIT(&on_write, SetDone, &written, grpc_schedule_on_exec_ctx);
+    grpc_endpoint_write(from, &out, &on_write, nullptr);
+    size_t received = 0;
+    grpc_slice_buffer in;
+    grpc_slice_buffer_init(&in);
+    while (received < size) {
+      bool read = false;
+      grpc_closure on_read;
+      GRPC_CLOSURE_INIT(&on_read, SetDone, &read, grpc_schedule_on_exec_ctx);
+      grpc_endpoint_read(to, &in, &on_read, /*urgent=*/false);
+      PollUntil(&read);
+      received += in.length;
+      grpc_slice_buffer_reset_and_unref_internal(&in);
+    }
+    PollUntil(&written);
+    grpc_slice_buffer_destroy_internal(&in);
+    grpc_slice_buffer_destroy_internal(&out);
+  }
+
+  grpc_endpoint* client() { return pair_.client; }
+  grpc_endpoint* server() { return pair_.server; }
+
+ private:
+  static void SetDone(void* arg, grpc_error_handle error) {
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    *static_cast<bool*>(arg) = true;
+  }
+
+  static void DestroyPollset(void* arg, grpc_error_handle /*error*/) {
+    grpc_pollset_destroy(static_cast<grpc_pollset*>(arg));
+  }
+
+  void PollUntil(bool* done) {
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(mu_);
+    while (!*done) {
+      grpc_pollset_worker* worker = nullptr;
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "pollset_work",
+          grpc_pollset_work(pollset_, &worker, GRPC_MILLIS_INF_FUTURE)));
+      gpr_mu_unlock(mu_);
+      grpc_core::ExecCtx::Get()->Flush();
+      gpr_mu_lock(mu_);
+    }
+    gpr_mu_unlock(mu_);
+  }
+
+  grpc_pollset* pollset_;
+  gpr_mu* mu_;
+  grpc_endpoint_pair pair_;
+};
+
+static void BM_IomgrEndpointPingPong(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t size = state.range(0);
+  IomgrFixture fixture;
+  grpc_core::ExecCtx exec_ctx;
+  for (auto _ : state) {
+    fixture.Send(fixture.client(), fixture.server(), size);
+    fixture.Send(fixture.server(), fixture.client(), size);
+  }
+  state.SetBytesProcessed(state.iterations() * size * 2);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_IomgrEndpointPingPong)->Range(1, 1024 * 1024);
+
+////////////////////////////////////////////////////////////////////////////////
+// POSIX EventEngine endpoints
+//
+
+#ifdef GRPC_LINUX_EPOLL
+
+using ::grpc_event_engine::experimental::ChannelArgsEndpointConfig;
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::MemoryAllocator;
+using ::grpc_event_engine::experimental::PosixEventEngine;
+using ::grpc_event_engine::experimental::SliceBuffer;
+
+// Blocks the benchmark thread until a callback on the engine's pool fires.
+class Notification {
+ public:
+  void Notify() {
+    grpc_core::MutexLock lock(&mu_);
+    done_ = true;
+    cv_.Signal();
+  }
+  void Wait() {
+    grpc_core::MutexLock lock(&mu_);
+    while (!done_) cv_.Wait(&mu_);
+    done_ = false;
+  }
+
+ private:
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  bool done_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+class PosixEngineFixture {
+ public:
+  PosixEngineFixture() {
+    ChannelArgsEndpointConfig config(nullptr);
+    auto listener = engine_.CreateListener(
+        [this](std::unique_ptr<EventEngine::Endpoint> ep,
+               MemoryAllocator /*allocator*/) {
+          server_ = std::move(ep);
+          accepted_.Notify();
+        },
+        [](absl::Status /*status*/) {}, config,
+        absl::make_unique<grpc_core::MemoryQuota>());
+    GPR_ASSERT(listener.ok());
+    listener_ = std::move(*listener);
+    grpc_sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = GRPC_AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    auto port = listener_->Bind(EventEngine::ResolvedAddress(
+        reinterpret_cast<const grpc_sockaddr*>(&addr), sizeof(addr)));
+    GPR_ASSERT(port.ok());
+    GPR_ASSERT(listener_->Start().ok());
+    addr.sin_port = htons(static_cast<uint16_t>(*port));
+    Notification connected;
+    engine_.Connect(
+        [this, &connected](
+            absl::StatusOr<std::unique_ptr<EventEngine::Endpoint>> ep) {
+          GPR_ASSERT(ep.ok());
+          client_ = std::move(*ep);
+          connected.Notify();
+        },
+        EventEngine::ResolvedAddress(
+            reinterpret_cast<const grpc_sockaddr*>(&addr), sizeof(addr)),
+        config, memory_quota_.CreateMemoryAllocator(),
+        absl::InfiniteFuture());
+    connected.Wait();
+    accepted_.Wait();
+  }
+
+  ~PosixEngineFixture() {
+    client_.reset();
+    server_.reset();
+    listener_.reset();
+  }
+
+  // Write \a size bytes on \a from and wait until they have all been read
+  // from \a to.
+  void Send(EventEngine::Endpoint* from, EventEngine::Endpoint* to,
+            size_t size) {
+    grpc_slice_buffer out;
+    grpc_slice_buffer_init(&out);
+    FillSliceBuffer(&out, size);
+    SliceBuffer out_buffer(&out);
+    Notification written;
+    from->Write(
+        [&written](absl::Status status) {
+          GPR_ASSERT(status.ok());
+          written.Notify();
+        },
+        &out_buffer);
+    size_t received = 0;
+    grpc_slice_buffer in;
+    grpc_slice_buffer_init(&in);
+    SliceBuffer in_buffer(&in);
+    while (received < size) {
+      Notification read;
+      to->Read(
+          [&read](absl::Status status) {
+            GPR_ASSERT(status.ok());
+            read.Notify();
+          },
+          &in_buffer);
+      read.Wait();
+      received += in.length;
+      grpc_slice_buffer_reset_and_unref(&in);
+    }
+    written.Wait();
+    grpc_slice_buffer_destroy(&in);
+    grpc_slice_buffer_destroy(&out);
+  }
+
+  EventEngine::Endpoint* client() { return client_.get(); }
+  EventEngine::Endpoint* server() { return server_.get(); }
+
+ private:
+  PosixEventEngine engine_;
+  grpc_core::MemoryQuota memory_quota_;
+  std::unique_ptr<EventEngine::Listener> listener_;
+  Notification accepted_;
+  std::unique_ptr<EventEngine::Endpoint> client_;
+  std::unique_ptr<EventEngine::Endpoint> server_;
+};
+
+static void BM_PosixEventEngineEndpointPingPong(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t size = state.range(0);
+  PosixEngineFixture fixture;
+  for (auto _ : state) {
+    fixture.Send(fixture.client(), fixture.server(), size);
+    fixture.Send(fixture.server(), fixture.client(), size);
+  }
+  state.SetBytesProcessed(state.iterations() * size * 2);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_PosixEventEngineEndpointPingPong)->Range(1, 1024 * 1024);
+
+#endif  // GRPC_LINUX_EPOLL
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
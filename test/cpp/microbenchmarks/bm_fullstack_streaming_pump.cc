@@ -25,6 +25,32 @@
 namespace grpc {
 namespace testing {
 
+/*******************************************************************************
+ * FIXTURES
+ */
+
+class RxZerocopyConfiguration : public FixtureConfiguration {
+ public:
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetInt(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED, 1);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    b->AddChannelArgument(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED, 1);
+  }
+};
+
+// TCP with TCP_ZEROCOPY_RECEIVE reads. Over loopback the kernel hands over
+// data that is not page aligned, so this measures the cost of the fallback to
+// copying; compare the cpu_s/GB labels against TCP to see it.
+class RxZerocopyTCP : public TCP {
+ public:
+  explicit RxZerocopyTCP(Service* service)
+      : TCP(service, RxZerocopyConfiguration()) {}
+};
+
 /*******************************************************************************
  * CONFIGURATIONS
  */
@@ -45,6 +71,10 @@ BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, InProcess)
     ->Range(0, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, InProcessCHTTP2)
     ->Range(0, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, RxZerocopyTCP)
+    ->Range(1024 * 1024, 128 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, RxZerocopyTCP)
+    ->Range(1024 * 1024, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinTCP)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinUDS)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinInProcess)->Arg(0);
@@ -0,0 +1,210 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark many concurrent unary calls sharing one connection, with and
+   without HTTP2 write coalescing. Each iteration is one completed call, so with
+   GRPC_COLLECT_STATS the syscall_write/iter counter reads as writes per call.
+   Call latency percentiles are added to the label. */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_format.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/profiling/timers.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+/*******************************************************************************
+ * FIXTURES
+ */
+
+template <int kBudgetUs>
+class CoalescingConfiguration : public FixtureConfiguration {
+ public:
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetInt(GRPC_ARG_HTTP2_WRITE_COALESCING_BUDGET_US, kBudgetUs);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    b->AddChannelArgument(GRPC_ARG_HTTP2_WRITE_COALESCING_BUDGET_US, kBudgetUs);
+  }
+};
+
+template <int kBudgetUs>
+class CoalescingTCP : public TCP {
+ public:
+  explicit CoalescingTCP(Service* service)
+      : TCP(service, CoalescingConfiguration<kBudgetUs>()) {}
+};
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+// Tags carry the slot index and which of a slot's operations completed.
+enum TagKind { kServerRequested = 0, kServerFinished = 1, kClientFinished = 2 };
+static void* tag(intptr_t slot, TagKind kind) {
+  return reinterpret_cast<void*>((slot << 2) | kind);
+}
+
+template <class Fixture>
+static void BM_UnaryConcurrency(benchmark::State& state) {
+  EchoTestService::AsyncService service;
+  const int concurrency = state.range(0);
+  struct ServerEnv {
+    ServerContext ctx;
+    EchoRequest recv_request;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer;
+    ServerEnv() : response_writer(&ctx) {}
+  };
+  struct ClientEnv {
+    ClientContext ctx;
+    EchoResponse recv_response;
+    Status recv_status;
+    std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader;
+    gpr_timespec start;
+  };
+  // Declared before the fixture: shutting the fixture down completes the
+  // outstanding server requests, which still refer to these.
+  std::vector<std::unique_ptr<ServerEnv>> server_env(concurrency);
+  std::vector<std::unique_ptr<ClientEnv>> client_env(concurrency);
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(fixture->channel()));
+  EchoRequest send_request;
+  EchoResponse send_response;
+  send_request.set_message(std::string(64, 'a'));
+  send_response.set_message(std::string(64, 'a'));
+
+  auto request_call = [&](int slot) {
+    server_env[slot].reset(new ServerEnv);
+    service.RequestEcho(&server_env[slot]->ctx, &server_env[slot]->recv_request,
+                        &server_env[slot]->response_writer, fixture->cq(),
+                        fixture->cq(), tag(slot, kServerRequested));
+  };
+  auto start_call = [&](int slot) {
+    client_env[slot].reset(new ClientEnv);
+    ClientEnv* env = client_env[slot].get();
+    env->start = gpr_now(GPR_CLOCK_MONOTONIC);
+    env->response_reader =
+        stub->AsyncEcho(&env->ctx, send_request, fixture->cq());
+    env->response_reader->Finish(&env->recv_response, &env->recv_status,
+                                 tag(slot, kClientFinished));
+  };
+  // Processes completions until one client call finishes, and returns its
+  // latency in microseconds.
+  auto next_call_done = [&]() {
+    while (true) {
+      void* t;
+      bool ok;
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      GPR_ASSERT(ok);
+      const intptr_t slot = reinterpret_cast<intptr_t>(t) >> 2;
+      switch (reinterpret_cast<intptr_t>(t) & 3) {
+        case kServerRequested:
+          server_env[slot]->response_writer.Finish(
+              send_response, Status::OK, tag(slot, kServerFinished));
+          break;
+        case kServerFinished:
+          request_call(slot);
+          break;
+        case kClientFinished: {
+          GPR_ASSERT(client_env[slot]->recv_status.ok());
+          gpr_timespec elapsed = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC),
+                                              client_env[slot]->start);
+          client_env[slot].reset();
+          return std::make_pair(slot, gpr_timespec_to_micros(elapsed));
+        }
+      }
+    }
+  };
+
+  for (int i = 0; i < concurrency; i++) {
+    request_call(i);
+    start_call(i);
+  }
+  std::vector<double> latencies_us;
+  for (auto _ : state) {
+    GPR_TIMER_SCOPE("BenchmarkCycle", 0);
+    auto done = next_call_done();
+    latencies_us.push_back(done.second);
+    start_call(done.first);
+  }
+  for (int i = 0; i < concurrency; i++) {
+    next_call_done();
+  }
+
+  std::sort(latencies_us.begin(), latencies_us.end());
+  auto percentile = [&latencies_us](double p) {
+    if (latencies_us.empty()) return 0.0;
+    return latencies_us[static_cast<size_t>(p * (latencies_us.size() - 1))];
+  };
+  fixture->AddLabel(
+      absl::StrFormat("latency_us-median:%.1f latency_us-99p:%.1f",
+                      percentile(0.5), percentile(0.99)));
+  fixture->Finish(state);
+  fixture.reset();
+  state.SetItemsProcessed(state.iterations());
+}
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+static void SweepConcurrency(benchmark::internal::Benchmark* b) {
+  for (int i = 1; i <= 256; i *= 4) {
+    b->Arg(i);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_UnaryConcurrency, TCP)->Apply(SweepConcurrency);
+BENCHMARK_TEMPLATE(BM_UnaryConcurrency, CoalescingTCP<20>)
+    ->Apply(SweepConcurrency);
+BENCHMARK_TEMPLATE(BM_UnaryConcurrency, CoalescingTCP<100>)
+    ->Apply(SweepConcurrency);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark blocking unary calls issued from 1 to 64 threads that all share one
+   channel, to show how the per-call work in the client channel (name
+   resolution results, LB picks) scales with the number of calling threads. */
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/callback_test_service.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+template <class Fixture>
+static void BM_UnaryThreads(benchmark::State& state) {
+  // Shared by all of the benchmark's threads. Thread 0 sets them up before,
+  // and tears them down after, the benchmark loop, which all threads enter and
+  // leave together.
+  static CallbackStreamingTestService* service;
+  static Fixture* fixture;
+  static EchoTestService::Stub* stub;
+  if (state.thread_index() == 0) {
+    service = new CallbackStreamingTestService;
+    fixture = new Fixture(service);
+    stub = EchoTestService::NewStub(fixture->channel()).release();
+  }
+  EchoRequest send_request;
+  send_request.set_message(std::string(64, 'a'));
+  for (auto _ : state) {
+    ClientContext context;
+    EchoResponse recv_response;
+    GPR_ASSERT(stub->Echo(&context, send_request, &recv_response).ok());
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    fixture->Finish(state);
+    delete stub;
+    delete fixture;
+    delete service;
+  }
+}
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+BENCHMARK_TEMPLATE(BM_UnaryThreads, TCP)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_UnaryThreads, UDS)->ThreadRange(1, 64)->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
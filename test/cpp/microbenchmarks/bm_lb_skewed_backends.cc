@@ -0,0 +1,258 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the latency of unary calls spread by an LB policy over backends
+   of which one is much slower than the others, to show how much of the tail
+   latency a policy that looks at calls in flight (least_request) avoids
+   compared to one that does not (round_robin). */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#include <grpcpp/alarm.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/channel_arguments.h>
+#include <grpcpp/support/slice.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+constexpr int kNumBackends = 4;
+// Service time of the slow backend and of the others.
+constexpr int kSlowBackendDelayMs = 20;
+constexpr int kFastBackendDelayMs = 1;
+// Calls kept in flight by the client, and calls completed per iteration.
+// Each iteration drains the calls in flight, so it should be long enough for
+// the client to spend most of it in a steady state.
+constexpr int kCallsInFlight = 16;
+constexpr int kCallsPerIteration = 256;
+
+// A generic service that echoes each unary request after a fixed delay,
+// standing in for a backend with a given cost per request.
+class DelayedEchoService : public CallbackGenericService {
+ public:
+  explicit DelayedEchoService(int delay_ms) : delay_ms_(delay_ms) {}
+
+  ServerGenericBidiReactor* CreateReactor(
+      GenericCallbackServerContext* /*context*/) override {
+    return new Reactor(delay_ms_);
+  }
+
+ private:
+  class Reactor : public ServerGenericBidiReactor {
+   public:
+    explicit Reactor(int delay_ms) : delay_ms_(delay_ms) {
+      StartRead(&request_);
+    }
+
+    void OnReadDone(bool ok) override {
+      if (!ok) {
+        Finish(Status::OK);
+        return;
+      }
+      alarm_.Set(gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                              gpr_time_from_millis(delay_ms_, GPR_TIMESPAN)),
+                 [this](bool /*ok*/) {
+                   StartWriteAndFinish(&request_, WriteOptions(), Status::OK);
+                 });
+    }
+
+    void OnDone() override { delete this; }
+
+   private:
+    const int delay_ms_;
+    ByteBuffer request_;
+    Alarm alarm_;
+  };
+
+  const int delay_ms_;
+};
+
+// Keeps a fixed number of unary calls in flight on a stub and records the
+// latency of each.
+class ClosedLoopCaller {
+ public:
+  explicit ClosedLoopCaller(GenericStub* stub) : stub_(stub) {
+    Slice slice("x", 1);
+    request_ = ByteBuffer(&slice, 1);
+  }
+
+  // Runs until count calls have completed, and returns their latencies in
+  // microseconds.
+  std::vector<double> Run(int64_t count) {
+    {
+      grpc_core::MutexLock lock(&mu_);
+      remaining_ = count;
+      latencies_us_.clear();
+      latencies_us_.reserve(count);
+    }
+    for (int i = 0; i < kCallsInFlight && i < count; ++i) {
+      {
+        grpc_core::MutexLock lock(&mu_);
+        --remaining_;
+      }
+      StartCall();
+    }
+    grpc_core::MutexLock lock(&mu_);
+    while (static_cast<int64_t>(latencies_us_.size()) < count) {
+      cv_.Wait(&mu_);
+    }
+    return std::move(latencies_us_);
+  }
+
+ private:
+  struct Call {
+    ClientContext context;
+    ByteBuffer response;
+    gpr_timespec start;
+  };
+
+  void StartCall() {
+    Call* call = new Call;
+    call->start = gpr_now(GPR_CLOCK_MONOTONIC);
+    stub_->UnaryCall(&call->context, "/bm.Echo/Echo", StubOptions(),
+                     &request_, &call->response, [this, call](Status status) {
+                       GPR_ASSERT(status.ok());
+                       OnCallDone(call);
+                     });
+  }
+
+  void OnCallDone(Call* call) {
+    const double latency_us = gpr_timespec_to_micros(
+        gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), call->start));
+    delete call;
+    bool start_another;
+    {
+      grpc_core::MutexLock lock(&mu_);
+      latencies_us_.push_back(latency_us);
+      // Decide before signalling: once the last latency is in, Run() may
+      // return and this caller be destroyed.
+      start_another = remaining_ > 0;
+      if (start_another) --remaining_;
+      cv_.Signal();
+    }
+    if (start_another) StartCall();
+  }
+
+  GenericStub* stub_;
+  // A tiny message is enough: the backends' delays dominate.
+  ByteBuffer request_;
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  int64_t remaining_ ABSL_GUARDED_BY(mu_) = 0;
+  std::vector<double> latencies_us_ ABSL_GUARDED_BY(mu_);
+};
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+static double Percentile(std::vector<double>* values, double percentile) {
+  const size_t index = std::min(
+      values->size() - 1, static_cast<size_t>(values->size() * percentile));
+  std::nth_element(values->begin(), values->begin() + index, values->end());
+  return (*values)[index];
+}
+
+static void BM_SkewedBackends(benchmark::State& state,
+                              const char* lb_policy) {
+  std::vector<std::unique_ptr<DelayedEchoService>> services;
+  std::vector<std::unique_ptr<Server>> servers;
+  std::vector<std::string> addresses;
+  for (int i = 0; i < kNumBackends; ++i) {
+    services.push_back(absl::make_unique<DelayedEchoService>(
+        i == 0 ? kSlowBackendDelayMs : kFastBackendDelayMs));
+    int port;
+    ServerBuilder builder;
+    builder.AddListeningPort("127.0.0.1:0", InsecureServerCredentials(),
+                             &port);
+    builder.RegisterCallbackGenericService(services.back().get());
+    servers.push_back(builder.BuildAndStart());
+    addresses.push_back(absl::StrCat("127.0.0.1:", port));
+  }
+  ChannelArguments args;
+  args.SetServiceConfigJSON(absl::StrCat(
+      "{\"loadBalancingConfig\":[{\"", lb_policy, "\":{}}]}"));
+  std::shared_ptr<Channel> channel = CreateCustomChannel(
+      absl::StrCat("ipv4:", absl::StrJoin(addresses, ",")),
+      InsecureChannelCredentials(), args);
+  GenericStub stub(channel);
+  ClosedLoopCaller caller(&stub);
+  // Let every subchannel connect before measuring.
+  caller.Run(kNumBackends * kCallsInFlight);
+  std::vector<double> latencies_us;
+  for (auto _ : state) {
+    std::vector<double> batch = caller.Run(kCallsPerIteration);
+    latencies_us.insert(latencies_us.end(), batch.begin(), batch.end());
+  }
+  state.SetItemsProcessed(state.iterations() * kCallsPerIteration);
+  if (!latencies_us.empty()) {
+    state.counters["p50_us"] = Percentile(&latencies_us, 0.5);
+    state.counters["p90_us"] = Percentile(&latencies_us, 0.9);
+    state.counters["p99_us"] = Percentile(&latencies_us, 0.99);
+  }
+  for (auto& server : servers) server->Shutdown();
+}
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+BENCHMARK_CAPTURE(BM_SkewedBackends, round_robin, "round_robin")
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_SkewedBackends, least_request,
+                  "least_request_experimental")
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
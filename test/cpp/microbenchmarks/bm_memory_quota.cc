@@ -0,0 +1,90 @@
+// Copyright 2021 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark memory quotas shared by many threads
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+using grpc_core::MemoryAllocator;
+using grpc_core::MemoryQuota;
+using grpc_core::MemoryRequest;
+
+// Quotas shared by all threads of a benchmark.  range(0) is the quota size in
+// MiB, or 0 for an unlimited quota.
+static MemoryQuota* GetQuota(benchmark::State& state) {
+  static MemoryQuota* unlimited = new MemoryQuota();
+  static MemoryQuota* limited = [] {
+    auto* quota = new MemoryQuota();
+    quota->SetSize(64 * 1024 * 1024);
+    return quota;
+  }();
+  GPR_ASSERT(state.range(0) == 0 || state.range(0) == 64);
+  return state.range(0) == 0 ? unlimited : limited;
+}
+
+// An allocator per call: every creation and destruction takes from and
+// returns to the quota.
+static void BM_AllocatorCreateDestroy(benchmark::State& state) {
+  MemoryQuota* memory_quota = GetQuota(state);
+  grpc_core::ExecCtx exec_ctx;
+  for (auto _ : state) {
+    MemoryAllocator allocator = memory_quota->CreateMemoryAllocator();
+    allocator.Release(allocator.Reserve(MemoryRequest(1024)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AllocatorCreateDestroy)
+    ->Arg(0)
+    ->Arg(64)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+// An allocator per connection: read buffers are allocated from it, and the
+// allocator replenishes from the quota as needed.
+static void BM_AllocatorMakeSlice(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  MemoryAllocator allocator = GetQuota(state)->CreateMemoryAllocator();
+  for (auto _ : state) {
+    grpc_slice_unref_internal(allocator.MakeSlice(MemoryRequest(1024, 8192)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AllocatorMakeSlice)
+    ->Arg(0)
+    ->Arg(64)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
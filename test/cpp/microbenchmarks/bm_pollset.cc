@@ -20,6 +20,8 @@
 
 #include <string.h>
 
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include <grpc/grpc.h>
@@ -252,6 +254,75 @@ static void BM_SingleThreadPollOneFd(benchmark::State& state) {
 }
 BENCHMARK(BM_SingleThreadPollOneFd);
 
+namespace {
+struct PollManyFdsEntry {
+  grpc_wakeup_fd wakeup_fd;
+  grpc_fd* fd;
+  grpc_closure on_readable;
+  size_t* pending;
+};
+
+void OnManyFdsEntryReadable(void* arg, grpc_error_handle error) {
+  PollManyFdsEntry* entry = static_cast<PollManyFdsEntry*>(arg);
+  if (error != GRPC_ERROR_NONE) return;  // fd orphaned
+  GRPC_ERROR_UNREF(grpc_wakeup_fd_consume_wakeup(&entry->wakeup_fd));
+  --*entry->pending;
+  grpc_fd_notify_on_read(entry->fd, &entry->on_readable);
+}
+}  // namespace
+
+// Every iteration makes all of the fds readable at once and polls until each of
+// them has been serviced: this measures how well the poller amortizes its
+// syscalls over many ready sockets (compare the @poller=epoll1 and
+// @poller=io_uring variants of this benchmark).
+static void BM_SingleThreadPollManyFds(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t nfds = static_cast<size_t>(state.range(0));
+  size_t ps_sz = grpc_pollset_size();
+  grpc_pollset* ps = static_cast<grpc_pollset*>(gpr_zalloc(ps_sz));
+  gpr_mu* mu;
+  grpc_pollset_init(ps, &mu);
+  grpc_core::ExecCtx exec_ctx;
+  size_t pending = 0;
+  std::vector<PollManyFdsEntry> entries(nfds);
+  for (PollManyFdsEntry& entry : entries) {
+    GRPC_ERROR_UNREF(grpc_wakeup_fd_init(&entry.wakeup_fd));
+    entry.fd = grpc_fd_create(entry.wakeup_fd.read_fd, "wakeup_read", false);
+    entry.pending = &pending;
+    GRPC_CLOSURE_INIT(&entry.on_readable, OnManyFdsEntryReadable, &entry,
+                      grpc_schedule_on_exec_ctx);
+    grpc_pollset_add_fd(ps, entry.fd);
+    grpc_fd_notify_on_read(entry.fd, &entry.on_readable);
+  }
+  gpr_mu_lock(mu);
+  for (auto _ : state) {
+    for (PollManyFdsEntry& entry : entries) {
+      GRPC_ERROR_UNREF(grpc_wakeup_fd_wakeup(&entry.wakeup_fd));
+    }
+    pending = nfds;
+    while (pending > 0) {
+      GRPC_ERROR_UNREF(grpc_pollset_work(ps, nullptr, GRPC_MILLIS_INF_FUTURE));
+    }
+  }
+  for (PollManyFdsEntry& entry : entries) {
+    grpc_fd_orphan(entry.fd, nullptr, nullptr, "done");
+    entry.wakeup_fd.read_fd = 0;
+  }
+  grpc_closure shutdown_ps_closure;
+  GRPC_CLOSURE_INIT(&shutdown_ps_closure, shutdown_ps, ps,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(ps, &shutdown_ps_closure);
+  gpr_mu_unlock(mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  for (PollManyFdsEntry& entry : entries) {
+    grpc_wakeup_fd_destroy(&entry.wakeup_fd);
+  }
+  gpr_free(ps);
+  state.SetItemsProcessed(state.iterations() * nfds);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SingleThreadPollManyFds)->Range(1, 1024);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -0,0 +1,178 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks for the ring_hash LB policy's lookup tables: the time to
+   build a ketama ring or a Maglev table for large numbers of backends, to
+   update a ring after a small change, and to look up a request hash in
+   each */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+static std::vector<grpc_core::RingHashTable::Endpoint> MakeEndpoints(
+    int64_t count) {
+  std::vector<grpc_core::RingHashTable::Endpoint> endpoints(count);
+  for (int64_t i = 0; i < count; ++i) {
+    endpoints[i].address = absl::StrCat("10.", i / 65536, ".", i / 256 % 256,
+                                        ".", i % 256, ":443");
+  }
+  return endpoints;
+}
+
+static std::vector<uint64_t> MakeHashes() {
+  std::vector<uint64_t> hashes(4096);
+  uint64_t seed = 88172645463325252ull;
+  for (uint64_t& hash : hashes) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    hash = seed;
+  }
+  return hashes;
+}
+
+// Reports the share of slots held by the busiest endpoint relative to the
+// average. Every slot of a Maglev table takes the same share of hashes, so
+// this is how much more load that endpoint takes than a perfect split would
+// give it; on a ring, the points' shares vary instead of their numbers.
+static void ReportImbalance(benchmark::State& state,
+                            const grpc_core::RingHashTable& table,
+                            size_t num_endpoints) {
+  std::vector<size_t> slots(num_endpoints);
+  for (size_t i = 0; i < table.size(); ++i) ++slots[table.endpoint(i)];
+  const size_t max_slots = *std::max_element(slots.begin(), slots.end());
+  state.counters["max_over_avg"] =
+      static_cast<double>(max_slots) * num_endpoints / table.size();
+}
+
+// Args: number of endpoints, min_ring_size.
+static void RingArgs(benchmark::internal::Benchmark* b) {
+  for (int num_endpoints : {1000, 10000}) {
+    for (int min_ring_size : {1024, 1 << 20}) {
+      b->Args({num_endpoints, min_ring_size});
+    }
+  }
+}
+
+// Args: number of endpoints, Maglev table size.
+static void MaglevArgs(benchmark::internal::Benchmark* b) {
+  for (int num_endpoints : {1000, 10000}) {
+    for (int table_size : {65537, 1000003}) {
+      b->Args({num_endpoints, table_size});
+    }
+  }
+}
+
+static void BM_BuildRing(benchmark::State& state) {
+  auto endpoints = MakeEndpoints(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grpc_core::RingHashTable::BuildRing(
+        endpoints, state.range(1), 8388608));
+  }
+  state.counters["slots"] =
+      grpc_core::RingHashTable::BuildRing(endpoints, state.range(1), 8388608)
+          .size();
+}
+BENCHMARK(BM_BuildRing)->Unit(benchmark::kMillisecond)->Apply(RingArgs);
+
+// Rebuilds a ring for 5000 endpoints after one is replaced, from scratch
+// or from the previous ring.
+// Args: whether to update the previous ring, min_ring_size.
+static void BM_RebuildRingAfterOneChange(benchmark::State& state) {
+  auto endpoints = MakeEndpoints(5000);
+  const grpc_core::RingHashTable ring =
+      grpc_core::RingHashTable::BuildRing(endpoints, state.range(1), 8388608);
+  endpoints[2500].address = "192.168.0.1:443";
+  for (auto _ : state) {
+    if (state.range(0)) {
+      benchmark::DoNotOptimize(grpc_core::RingHashTable::UpdateRing(
+          ring, endpoints, state.range(1), 8388608));
+    } else {
+      benchmark::DoNotOptimize(grpc_core::RingHashTable::BuildRing(
+          endpoints, state.range(1), 8388608));
+    }
+  }
+}
+BENCHMARK(BM_RebuildRingAfterOneChange)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({0, 1024})
+    ->Args({1, 1024})
+    ->Args({0, 1 << 20})
+    ->Args({1, 1 << 20});
+
+static void BM_BuildMaglev(benchmark::State& state) {
+  auto endpoints = MakeEndpoints(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        grpc_core::RingHashTable::BuildMaglev(endpoints, state.range(1)));
+  }
+  state.counters["slots"] = state.range(1);
+  ReportImbalance(
+      state, grpc_core::RingHashTable::BuildMaglev(endpoints, state.range(1)),
+      endpoints.size());
+}
+BENCHMARK(BM_BuildMaglev)->Unit(benchmark::kMillisecond)->Apply(MaglevArgs);
+
+static void RunLookups(benchmark::State& state,
+                       const grpc_core::RingHashTable& table) {
+  const std::vector<uint64_t> hashes = MakeHashes();
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        table.endpoint(table.FindSlot(hashes[i++ % hashes.size()])));
+  }
+}
+
+static void BM_FindSlotRing(benchmark::State& state) {
+  RunLookups(state, grpc_core::RingHashTable::BuildRing(
+                        MakeEndpoints(state.range(0)), state.range(1),
+                        8388608));
+}
+BENCHMARK(BM_FindSlotRing)->Apply(RingArgs);
+
+static void BM_FindSlotMaglev(benchmark::State& state) {
+  RunLookups(state, grpc_core::RingHashTable::BuildMaglev(
+                        MakeEndpoints(state.range(0)), state.range(1)));
+}
+BENCHMARK(BM_FindSlotMaglev)->Apply(MaglevArgs);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
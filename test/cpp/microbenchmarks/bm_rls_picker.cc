@@ -0,0 +1,451 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark picks of the RLS LB policy's picker from several threads at once,
+   once the keys being picked are in the policy's cache, which is the case for
+   almost every pick of a busy channel. */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "upb/upb.hpp"
+
+#include <grpc/support/alloc.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/env.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/security/credentials/credentials.h"
+#include "src/proto/grpc/lookup/v1/rls.upb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+using grpc_core::LoadBalancingPolicy;
+
+constexpr char kReadyLbPolicyName[] = "bm_ready";
+// Requests are sent to one of this many targets, each with its own child
+// policy.
+constexpr int kNumTargets = 16;
+
+// An RLS server that routes each request to a target picked by its key.
+class RouteLookupService : public CallbackGenericService {
+ public:
+  ServerGenericBidiReactor* CreateReactor(
+      GenericCallbackServerContext* /*context*/) override {
+    return new Reactor;
+  }
+
+ private:
+  class Reactor : public ServerGenericBidiReactor {
+   public:
+    Reactor() { StartRead(&request_); }
+
+    void OnReadDone(bool ok) override {
+      if (!ok) {
+        Finish(Status::OK);
+        return;
+      }
+      std::vector<Slice> slices;
+      GPR_ASSERT(request_.Dump(&slices).ok());
+      std::string serialized;
+      for (const Slice& slice : slices) {
+        serialized.append(reinterpret_cast<const char*>(slice.begin()),
+                          slice.size());
+      }
+      upb::Arena arena;
+      grpc_lookup_v1_RouteLookupRequest* request =
+          grpc_lookup_v1_RouteLookupRequest_parse(
+              serialized.data(), serialized.size(), arena.ptr());
+      GPR_ASSERT(request != nullptr);
+      upb_strview key;
+      GPR_ASSERT(grpc_lookup_v1_RouteLookupRequest_key_map_get(
+          request, upb_strview_makez("k"), &key));
+      const size_t key_hash =
+          std::hash<std::string>()(std::string(key.data, key.size));
+      const std::string target =
+          absl::StrCat("target-", key_hash % kNumTargets);
+      grpc_lookup_v1_RouteLookupResponse* response =
+          grpc_lookup_v1_RouteLookupResponse_new(arena.ptr());
+      grpc_lookup_v1_RouteLookupResponse_add_targets(
+          response, upb_strview_make(target.data(), target.size()),
+          arena.ptr());
+      size_t length;
+      char* buf = grpc_lookup_v1_RouteLookupResponse_serialize(
+          response, arena.ptr(), &length);
+      Slice slice(buf, length);
+      response_ = ByteBuffer(&slice, 1);
+      StartWriteAndFinish(&response_, WriteOptions(), Status::OK);
+    }
+
+    void OnDone() override { delete this; }
+
+   private:
+    ByteBuffer request_;
+    ByteBuffer response_;
+  };
+};
+
+// A child policy that is READY as soon as it gets an update, and completes
+// every pick.  Only the RLS policy's own cost is left to measure.
+class ReadyLb : public LoadBalancingPolicy {
+ public:
+  explicit ReadyLb(Args args) : LoadBalancingPolicy(std::move(args)) {}
+
+  const char* name() const override { return kReadyLbPolicyName; }
+
+  void UpdateLocked(UpdateArgs /*args*/) override {
+    channel_control_helper()->UpdateState(GRPC_CHANNEL_READY, absl::Status(),
+                                          absl::make_unique<Picker>());
+  }
+
+  void ResetBackoffLocked() override {}
+
+ private:
+  class Picker : public SubchannelPicker {
+   public:
+    PickResult Pick(PickArgs /*args*/) override {
+      return PickResult::Complete(nullptr);
+    }
+  };
+
+  void ShutdownLocked() override {}
+};
+
+class ReadyLbConfig : public LoadBalancingPolicy::Config {
+ public:
+  const char* name() const override { return kReadyLbPolicyName; }
+};
+
+class ReadyLbFactory : public grpc_core::LoadBalancingPolicyFactory {
+ public:
+  grpc_core::OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return grpc_core::MakeOrphanable<ReadyLb>(std::move(args));
+  }
+
+  const char* name() const override { return kReadyLbPolicyName; }
+
+  grpc_core::RefCountedPtr<LoadBalancingPolicy::Config>
+  ParseLoadBalancingConfig(const grpc_core::Json& /*json*/,
+                           grpc_error_handle* /*error*/) const override {
+    return grpc_core::MakeRefCounted<ReadyLbConfig>();
+  }
+};
+
+// Request metadata holding only the header that the RLS key is built from.
+class KeyMetadata : public LoadBalancingPolicy::MetadataInterface {
+ public:
+  explicit KeyMetadata(absl::string_view key) : key_(key) {}
+
+  void Add(absl::string_view /*key*/, absl::string_view /*value*/) override {}
+
+  std::vector<std::pair<std::string, std::string>> TestOnlyCopyToVector()
+      override {
+    return {{"key", std::string(key_)}};
+  }
+
+  absl::optional<absl::string_view> Lookup(
+      absl::string_view key, std::string* /*buffer*/) const override {
+    if (key != "key") return absl::nullopt;
+    return key_;
+  }
+
+ private:
+  absl::string_view key_;
+};
+
+class NoCallState : public LoadBalancingPolicy::CallState {
+ public:
+  // Only used to copy header data, which the RLS server does not send.
+  void* Alloc(size_t /*size*/) override { abort(); }
+
+  absl::string_view ExperimentalGetCallAttribute(
+      const char* /*key*/) override {
+    return absl::string_view();
+  }
+};
+
+// An RLS policy whose cache holds a given number of keys, as it would be
+// driven by a client channel: its pickers are kept, and its interested
+// parties are polled while picks are queued.
+class RlsPolicyFixture {
+ public:
+  explicit RlsPolicyFixture(int num_keys) {
+    int port;
+    ServerBuilder builder;
+    builder.AddListeningPort("127.0.0.1:0", InsecureServerCredentials(),
+                             &port);
+    builder.RegisterCallbackGenericService(&service_);
+    server_ = builder.BuildAndStart();
+    for (int i = 0; i < num_keys; ++i) keys_.push_back(absl::StrCat(i));
+    pollset_ = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(pollset_, &pollset_mu_);
+    grpc_core::ExecCtx exec_ctx;
+    work_serializer_ = std::make_shared<grpc_core::WorkSerializer>();
+    work_serializer_->Run(
+        [this, port]() { StartPolicyLocked(port); }, DEBUG_LOCATION);
+    exec_ctx.Flush();
+    WarmUp();
+  }
+
+  ~RlsPolicyFixture() {
+    grpc_core::ExecCtx exec_ctx;
+    work_serializer_->Run(
+        [this]() {
+          grpc_pollset_set_del_pollset(policy_->interested_parties(),
+                                       pollset_);
+          policy_.reset();
+        },
+        DEBUG_LOCATION);
+    {
+      grpc_core::MutexLock lock(&mu_);
+      picker_.reset();
+    }
+    grpc_closure shutdown_closure;
+    GRPC_CLOSURE_INIT(
+        &shutdown_closure,
+        [](void* pollset, grpc_error_handle /*error*/) {
+          grpc_pollset_destroy(static_cast<grpc_pollset*>(pollset));
+        },
+        pollset_, grpc_schedule_on_exec_ctx);
+    gpr_mu_lock(pollset_mu_);
+    grpc_pollset_shutdown(pollset_, &shutdown_closure);
+    gpr_mu_unlock(pollset_mu_);
+    exec_ctx.Flush();
+    gpr_free(pollset_);
+    server_->Shutdown();
+  }
+
+  const std::vector<std::string>& keys() const { return keys_; }
+
+  std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker() {
+    grpc_core::MutexLock lock(&mu_);
+    return picker_;
+  }
+
+ private:
+  class Helper : public LoadBalancingPolicy::ChannelControlHelper {
+   public:
+    explicit Helper(RlsPolicyFixture* fixture) : fixture_(fixture) {}
+
+    grpc_core::RefCountedPtr<grpc_core::SubchannelInterface> CreateSubchannel(
+        grpc_core::ServerAddress /*address*/,
+        const grpc_channel_args& /*args*/) override {
+      return nullptr;
+    }
+
+    void UpdateState(grpc_connectivity_state /*state*/,
+                     const absl::Status& /*status*/,
+                     std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>
+                         picker) override {
+      grpc_core::MutexLock lock(&fixture_->mu_);
+      fixture_->picker_ = std::move(picker);
+    }
+
+    void RequestReresolution() override {}
+
+    absl::string_view GetAuthority() override { return "bm.test"; }
+
+    void AddTraceEvent(TraceSeverity /*severity*/,
+                       absl::string_view /*message*/) override {}
+
+   private:
+    RlsPolicyFixture* fixture_;
+  };
+
+  void StartPolicyLocked(int port) {
+    grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+    grpc_arg args_to_add[] = {
+        grpc_channel_arg_string_create(const_cast<char*>(GRPC_ARG_SERVER_URI),
+                                       const_cast<char*>("dns:///bm.test")),
+        grpc_channel_credentials_to_arg(creds),
+    };
+    grpc_channel_args args = {GPR_ARRAY_SIZE(args_to_add), args_to_add};
+    LoadBalancingPolicy::Args lb_args;
+    lb_args.work_serializer = work_serializer_;
+    lb_args.channel_control_helper = absl::make_unique<Helper>(this);
+    lb_args.args = &args;
+    policy_ = grpc_core::LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
+        "rls", std::move(lb_args));
+    GPR_ASSERT(policy_ != nullptr);
+    grpc_pollset_set_add_pollset(policy_->interested_parties(), pollset_);
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    grpc_core::Json json = grpc_core::Json::Parse(
+        absl::StrCat(
+            "[{\"rls\":{"
+            "  \"routeLookupConfig\":{"
+            "    \"grpcKeybuilders\":[{"
+            "      \"names\":[{\"service\":\"bm.Echo\"}],"
+            "      \"headers\":[{\"key\":\"k\",\"names\":[\"key\"]}]"
+            "    }],"
+            "    \"lookupService\":\"ipv4:127.0.0.1:",
+            port,
+            "\","
+            "    \"cacheSizeBytes\":104857600"
+            "  },"
+            "  \"childPolicy\":[{\"",
+            kReadyLbPolicyName,
+            "\":{}}],"
+            "  \"childPolicyConfigTargetFieldName\":\"target\""
+            "}}]"),
+        &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    LoadBalancingPolicy::UpdateArgs update_args;
+    update_args.config =
+        grpc_core::LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
+            json, &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    update_args.args = grpc_channel_args_copy(&args);
+    policy_->UpdateLocked(std::move(update_args));
+    grpc_channel_credentials_release(creds);
+  }
+
+  // Picks the keys a few at a time, polling for the RLS responses until
+  // every pick of the batch completes.  Larger batches would get the RLS
+  // requests throttled, since none of them has succeeded yet.
+  void WarmUp() {
+    constexpr size_t kBatchSize = 8;
+    grpc_core::ExecCtx exec_ctx;
+    NoCallState call_state;
+    for (size_t begin = 0; begin < keys_.size(); begin += kBatchSize) {
+      const size_t end = std::min(keys_.size(), begin + kBatchSize);
+      for (;;) {
+        std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker =
+            this->picker();
+        size_t num_completed = 0;
+        for (size_t i = begin; i < end; ++i) {
+          KeyMetadata metadata(keys_[i]);
+          LoadBalancingPolicy::PickResult result =
+              picker->Pick({"/bm.Echo/Echo", &metadata, &call_state});
+          if (absl::holds_alternative<
+                  LoadBalancingPolicy::PickResult::Complete>(result.result)) {
+            ++num_completed;
+          }
+        }
+        if (num_completed == end - begin) break;
+        exec_ctx.Flush();
+        gpr_mu_lock(pollset_mu_);
+        GRPC_LOG_IF_ERROR(
+            "pollset_work",
+            grpc_pollset_work(pollset_, nullptr,
+                              grpc_core::ExecCtx::Get()->Now() + 100));
+        gpr_mu_unlock(pollset_mu_);
+        exec_ctx.Flush();
+        exec_ctx.InvalidateNow();
+      }
+    }
+  }
+
+  RouteLookupService service_;
+  std::unique_ptr<Server> server_;
+  std::vector<std::string> keys_;
+  grpc_pollset* pollset_;
+  gpr_mu* pollset_mu_;
+  std::shared_ptr<grpc_core::WorkSerializer> work_serializer_;
+  grpc_core::OrphanablePtr<LoadBalancingPolicy> policy_;
+  grpc_core::Mutex mu_;
+  std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
+      ABSL_GUARDED_BY(mu_);
+};
+
+/*******************************************************************************
+ * BENCHMARKING KERNELS
+ */
+
+// Args: number of keys in the cache.
+static void BM_RlsPickCached(benchmark::State& state) {
+  // Shared by all of the benchmark's threads. Thread 0 sets it up before, and
+  // tears it down after, the benchmark loop, which all threads enter and
+  // leave together.
+  static RlsPolicyFixture* fixture;
+  if (state.thread_index() == 0) {
+    fixture = new RlsPolicyFixture(state.range(0));
+  }
+  grpc_core::ExecCtx exec_ctx;
+  NoCallState call_state;
+  // Only set up once the loop starts, when thread 0 is done setting up.
+  std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker;
+  const std::vector<std::string>* keys = nullptr;
+  // Start the threads on different keys.
+  size_t i = state.thread_index() * 7919;
+  for (auto _ : state) {
+    if (GPR_UNLIKELY(picker == nullptr)) {
+      picker = fixture->picker();
+      keys = &fixture->keys();
+    }
+    KeyMetadata metadata((*keys)[i++ % keys->size()]);
+    LoadBalancingPolicy::PickResult result =
+        picker->Pick({"/bm.Echo/Echo", &metadata, &call_state});
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+  picker.reset();
+  if (state.thread_index() == 0) {
+    delete fixture;
+  }
+}
+BENCHMARK(BM_RlsPickCached)
+    ->Arg(16)
+    ->Arg(4096)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  // The RLS policy is registered only when enabled at initialization.
+  gpr_setenv("GRPC_EXPERIMENTAL_ENABLE_RLS_LB_POLICY", "true");
+  grpc::testing::TestEnvironment env(argc, argv);
+  LibraryInitializer libInit;
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          absl::make_unique<grpc::testing::ReadyLbFactory>());
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -179,6 +179,50 @@ BENCHMARK(BM_ThreadPoolExternalAdd)
     ->RangePair(524288, 524288, 1, 1024)
     ->ThreadRange(1, 256);  // Concurrent external thread(s) up to 256
 
+// Performs the scenario of 1-64 external producer threads adding closures into
+// a pool of 1-64 consumer threads, with each implementation of the closure
+// queue.
+// First argument is the number of consumers (pool size), second argument is
+// the ThreadPoolQueueType.
+static void BM_ThreadPoolProducerConsumer(benchmark::State& state) {
+  static grpc_core::ThreadPool* producer_consumer_pool = nullptr;
+  const int kNumItems = 65536;
+  int thread_idx = state.thread_index();
+  // Setup for each run of test.
+  if (thread_idx == 0) {
+    producer_consumer_pool = new grpc_core::ThreadPool(
+        state.range(0), "bm_producer_consumer", grpc_core::Thread::Options(),
+        static_cast<grpc_core::ThreadPoolQueueType>(state.range(1)));
+  }
+  const int num_iterations = kNumItems / state.threads();
+  while (state.KeepRunningBatch(num_iterations)) {
+    BlockingCounter counter(num_iterations);
+    for (int i = 0; i < num_iterations; ++i) {
+      producer_consumer_pool->Add(new SuicideFunctorForAdd(&counter));
+    }
+    counter.Wait();
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  // Teardown at the end of each test run.
+  if (thread_idx == 0) {
+    delete producer_consumer_pool;
+  }
+}
+
+static void ProducerConsumerArgs(benchmark::internal::Benchmark* b) {
+  for (auto queue_type : {grpc_core::ThreadPoolQueueType::kLocked,
+                          grpc_core::ThreadPoolQueueType::kLockFree}) {
+    for (int num_consumers = 1; num_consumers <= 64; num_consumers *= 4) {
+      b->Args({num_consumers, static_cast<int>(queue_type)});
+    }
+  }
+}
+BENCHMARK(BM_ThreadPoolProducerConsumer)
+    ->Apply(ProducerConsumerArgs)
+    ->ThreadRange(1, 64)  // Concurrent producer thread(s) up to 64
+    ->UseRealTime();
+
 // Functor (closure) that adds itself into pool repeatedly. By adding self, the
 // overhead would be low and can measure the time of add more accurately.
 class AddSelfFunctor : public grpc_completion_queue_functor {
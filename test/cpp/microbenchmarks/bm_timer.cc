@@ -104,6 +104,75 @@ BENCHMARK(BM_TimerBatch)
     ->Args({/*check=*/true, /*reverse=*/true})
     ->ThreadRange(1, 128);
 
+// The scenarios below arm timers with realistic deadlines and cancel almost
+// all of them before they fire, which is what call deadlines look like. Run
+// with GRPC_TIMER_IMPL=wheel to compare the timer wheel with the heap.
+
+// Keeps state.range(0) timers in flight: each iteration arms a new timer and
+// cancels the oldest one.
+static void BM_ArmCancelWithManyPending(benchmark::State& state) {
+  const size_t pending = state.range(0);
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  state.SetLabel(GPR_GLOBAL_CONFIG_GET(grpc_timer_impl).get());
+  std::vector<TimerClosure> timer_closures(pending);
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  auto arm = [&timer_closures, now](size_t i, size_t n) {
+    TimerClosure* timer_closure = &timer_closures[i % timer_closures.size()];
+    GRPC_CLOSURE_INIT(
+        &timer_closure->closure,
+        [](void* /*args*/, grpc_error_handle /*err*/) {}, nullptr,
+        grpc_schedule_on_exec_ctx);
+    // Spread deadlines over 10s..70s out, like a mix of call deadlines.
+    grpc_timer_init(&timer_closure->timer, now + 10000 + (n * 7919) % 60000,
+                    &timer_closure->closure);
+  };
+  for (size_t i = 0; i < pending; i++) arm(i, i);
+  exec_ctx.Flush();
+  size_t n = pending;
+  for (auto _ : state) {
+    grpc_timer_cancel(&timer_closures[n % pending].timer);
+    arm(n, n);
+    n++;
+    exec_ctx.Flush();
+  }
+  for (auto& timer_closure : timer_closures) {
+    grpc_timer_cancel(&timer_closure.timer);
+  }
+  exec_ctx.Flush();
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ArmCancelWithManyPending)->Range(1024, 512 * 1024);
+
+// Many threads arming and cancelling their own short-lived timers at once.
+static void BM_ArmCancelContended(benchmark::State& state) {
+  constexpr int kTimerCount = 64;
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  state.SetLabel(GPR_GLOBAL_CONFIG_GET(grpc_timer_impl).get());
+  std::vector<TimerClosure> timer_closures(kTimerCount);
+  for (auto& timer_closure : timer_closures) {
+    GRPC_CLOSURE_INIT(
+        &timer_closure.closure,
+        [](void* /*args*/, grpc_error_handle /*err*/) {}, nullptr,
+        grpc_schedule_on_exec_ctx);
+  }
+  for (auto _ : state) {
+    const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+    for (int i = 0; i < kTimerCount; i++) {
+      grpc_timer_init(&timer_closures[i].timer, now + 5000 + i,
+                      &timer_closures[i].closure);
+    }
+    for (int i = 0; i < kTimerCount; i++) {
+      grpc_timer_cancel(&timer_closures[i].timer);
+    }
+    exec_ctx.Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * kTimerCount);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ArmCancelContended)->ThreadRange(1, 64);
+
 }  // namespace testing
 }  // namespace grpc
 
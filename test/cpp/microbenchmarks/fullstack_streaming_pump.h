@@ -21,10 +21,14 @@
 #ifndef TEST_CPP_MICROBENCHMARKS_FULLSTACK_STREAMING_PUMP_H
 #define TEST_CPP_MICROBENCHMARKS_FULLSTACK_STREAMING_PUMP_H
 
+#include <sys/resource.h>
+
 #include <sstream>
 
 #include <benchmark/benchmark.h>
 
+#include "absl/strings/str_format.h"
+
 #include "src/core/lib/profiling/timers.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/cpp/microbenchmarks/fullstack_context_mutators.h"
@@ -39,6 +43,22 @@ namespace testing {
 
 static void* tag(intptr_t x) { return reinterpret_cast<void*>(x); }
 
+// CPU time used by the process so far, which includes both ends of the stream.
+static double ProcessCpuSeconds() {
+  struct rusage usage;
+  GPR_ASSERT(getrusage(RUSAGE_SELF, &usage) == 0);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+         (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+static void AddCpuPerGbLabel(BaseFixture* fixture, double cpu_seconds,
+                             double bytes) {
+  if (bytes > 0) {
+    fixture->AddLabel(
+        absl::StrFormat("cpu_s/GB:%.3f", cpu_seconds / (bytes * 1e-9)));
+  }
+}
+
 template <class Fixture>
 static void BM_PumpStreamClientToServer(benchmark::State& state) {
   EchoTestService::AsyncService service;
@@ -69,6 +89,7 @@ static void BM_PumpStreamClientToServer(benchmark::State& state) {
       need_tags &= ~(1 << i);
     }
     response_rw.Read(&recv_request, tag(0));
+    const double cpu_start = ProcessCpuSeconds();
     for (auto _ : state) {
       GPR_TIMER_SCOPE("BenchmarkCycle", 0);
       request_rw->Write(send_request, tag(1));
@@ -83,6 +104,8 @@ static void BM_PumpStreamClientToServer(benchmark::State& state) {
         }
       }
     }
+    AddCpuPerGbLabel(fixture.get(), ProcessCpuSeconds() - cpu_start,
+                     static_cast<double>(state.range(0)) * state.iterations());
     request_rw->WritesDone(tag(1));
     need_tags = (1 << 0) | (1 << 1);
     while (need_tags) {
@@ -138,6 +161,7 @@ static void BM_PumpStreamServerToClient(benchmark::State& state) {
       need_tags &= ~(1 << i);
     }
     request_rw->Read(&recv_response, tag(0));
+    const double cpu_start = ProcessCpuSeconds();
     for (auto _ : state) {
       GPR_TIMER_SCOPE("BenchmarkCycle", 0);
       response_rw.Write(send_response, tag(1));
@@ -152,6 +176,8 @@ static void BM_PumpStreamServerToClient(benchmark::State& state) {
         }
       }
     }
+    AddCpuPerGbLabel(fixture.get(), ProcessCpuSeconds() - cpu_start,
+                     static_cast<double>(state.range(0)) * state.iterations());
     response_rw.Finish(Status::OK, tag(1));
     need_tags = (1 << 0) | (1 << 1);
     while (need_tags) {
@@ -0,0 +1,142 @@
+/*
+ *
+ * Copyright 2021 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/cpp/server/work_stealing_thread_pool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace {
+
+// Counts down from n, and lets a test wait for zero.
+class Latch {
+ public:
+  explicit Latch(int n) : count_(n) {}
+
+  void CountDown() {
+    grpc_core::MutexLock lock(&mu_);
+    if (--count_ == 0) cv_.SignalAll();
+  }
+
+  void Wait() {
+    grpc_core::MutexLock lock(&mu_);
+    while (count_ != 0) cv_.Wait(&mu_);
+  }
+
+ private:
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  int count_;
+};
+
+TEST(WorkStealingThreadPoolTest, RunsCallbacksFromManyThreads) {
+  constexpr int kThreads = 8;
+  constexpr int kCallbacksPerThread = 1000;
+  WorkStealingThreadPool pool(4);
+  Latch latch(kThreads * kCallbacksPerThread);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&pool, &latch] {
+      for (int j = 0; j < kCallbacksPerThread; j++) {
+        pool.Add([&latch] { latch.CountDown(); });
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  latch.Wait();
+}
+
+TEST(WorkStealingThreadPoolTest, RunsCallbacksAddedFromWorkers) {
+  constexpr int kFanOut = 100;
+  WorkStealingThreadPool pool(4);
+  Latch latch(kFanOut * kFanOut);
+  for (int i = 0; i < kFanOut; i++) {
+    pool.Add([&pool, &latch] {
+      for (int j = 0; j < kFanOut; j++) {
+        pool.Add([&latch] { latch.CountDown(); });
+      }
+    });
+  }
+  latch.Wait();
+}
+
+TEST(WorkStealingThreadPoolTest, WakesParkedWorkers) {
+  constexpr int kRounds = 10;
+  WorkStealingThreadPool pool(1);
+  for (int i = 0; i < kRounds; i++) {
+    // Let the worker run out of work and park.
+    while (pool.stats().parks < static_cast<uint64_t>(i + 1)) {
+      std::this_thread::yield();
+    }
+    Latch latch(1);
+    pool.Add([&latch] { latch.CountDown(); });
+    latch.Wait();
+  }
+  EXPECT_EQ(pool.stats().wakeups, kRounds);
+  EXPECT_EQ(pool.stats().steals, 0);
+}
+
+TEST(WorkStealingThreadPoolTest, GrowsWhenAllThreadsBlock) {
+  constexpr int kBlocked = 4;
+  WorkStealingThreadPool pool(1);
+  Latch blocked(kBlocked);
+  Latch unblock(1);
+  // Each callback waits for all the others to start, which only happens if
+  // the pool grows past its single worker.
+  for (int i = 0; i < kBlocked; i++) {
+    pool.Add([&blocked, &unblock] {
+      blocked.CountDown();
+      unblock.Wait();
+    });
+  }
+  blocked.Wait();
+  // A callback added while every thread is blocked still runs.
+  Latch ran(1);
+  pool.Add([&ran] { ran.CountDown(); });
+  ran.Wait();
+  unblock.CountDown();
+  EXPECT_GE(pool.stats().helpers_started, kBlocked);
+}
+
+TEST(WorkStealingThreadPoolTest, DrainsCallbacksOnDestruction) {
+  constexpr int kCallbacks = 1000;
+  std::atomic<int> ran{0};
+  {
+    WorkStealingThreadPool pool(2);
+    for (int i = 0; i < kCallbacks; i++) {
+      pool.Add([&ran] { ran.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(ran.load(), kCallbacks);
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
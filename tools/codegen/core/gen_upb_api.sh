@@ -149,6 +149,7 @@ proto_files=( \
   "xds/core/v3/resource_name.proto" \
   "xds/core/v3/resource.proto" \
   "xds/data/orca/v3/orca_load_report.proto" \
+  "xds/service/orca/v3/orca.proto" \
   "xds/type/v3/typed_struct.proto")
 
 INCLUDE_OPTIONS="-I=$PWD/third_party/xds \
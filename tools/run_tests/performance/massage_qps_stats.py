@@ -33,6 +33,10 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_calls_created"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_calls_created")
+            stats["core_arena_pool_hits"] = massage_qps_stats_helpers.counter(
+                core_stats, "arena_pool_hits")
+            stats["core_arena_pool_misses"] = massage_qps_stats_helpers.counter(
+                core_stats, "arena_pool_misses")
             stats["core_cqs_created"] = massage_qps_stats_helpers.counter(
                 core_stats, "cqs_created")
             stats[
@@ -83,6 +87,18 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_tcp_backup_poller_polls"] = massage_qps_stats_helpers.counter(
                     core_stats, "tcp_backup_poller_polls")
+            stats[
+                "core_tcp_read_buffer_slab_hits"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_read_buffer_slab_hits")
+            stats[
+                "core_tcp_read_buffer_slab_misses"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_read_buffer_slab_misses")
+            stats[
+                "core_tcp_batched_writes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_batched_writes")
+            stats[
+                "core_tcp_batched_write_syscalls"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_batched_write_syscalls")
             stats["core_http2_op_batches"] = massage_qps_stats_helpers.counter(
                 core_stats, "http2_op_batches")
             stats["core_http2_op_cancel"] = massage_qps_stats_helpers.counter(
@@ -199,6 +215,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_spurious_writes_begun"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_spurious_writes_begun")
+            stats[
+                "core_http2_writes_coalesced"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_writes_coalesced")
             stats[
                 "core_hpack_recv_indexed"] = massage_qps_stats_helpers.counter(
                     core_stats, "hpack_recv_indexed")